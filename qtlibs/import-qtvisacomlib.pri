@@ -3,18 +3,20 @@
 #
 # SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
 
-!win32-msvc* {
-    error("The lib qtvisacomlib can only be built with MSVC \
-           Therefore the project $${basename(_PRO_FILE_)} is unavailabe for other systems or \
-           compiler")
-}
-
 IMPORTER_ROOT = $$absolute_path(.)
 QTUTILITIES = $$absolute_path($$IMPORTER_ROOT/../qtutilities)
 QTLIBS = $$absolute_path($$IMPORTER_ROOT)
 
 DEFINES *= IMPORT_QTVISACOMLIB
 
+# The lib is built without visa when it isn't built with MSVC and the 3rd party; in that case, only
+# the TCPIP socket and the SCPI simulator are available
+!win32-msvc* | !exists($$QTLIBS/qtvisacomlib/3rdparty/include/visa.h) {
+    DEFINES *= QTVISACOMLIB_NO_VISA
+}
+
+QT *= network
+
 DEPENDPATH *= $$QTLIBS/qtvisacomlib
 INCLUDEPATH *= $$QTLIBS/qtvisacomlib
 INCLUDEPATH *= $$QTLIBS
@@ -30,6 +30,10 @@ CONFIG += c++17
 # In order to do so, uncomment the following line.
 #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
+# The CAN inputs and outputs tracing can be removed from the build, see CanTracer.
+# In order to do so, uncomment the following line.
+#DEFINES += QTPEAKCANLIB_NO_TRACE
+
 LIB_PATH = $$absolute_path(.)
 QTLIB_PATH = $$absolute_path(..)
 ROOT = $$absolute_path(../..)
@@ -63,11 +67,76 @@ HEADERS *= $$LIB_PATH/src/candevice/candeviceintf.hpp
 SOURCES *= $$LIB_PATH/src/candevice/candeviceintf.cpp
 HEADERS *= $$LIB_PATH/src/candevice/candevicethread.hpp
 SOURCES *= $$LIB_PATH/src/candevice/candevicethread.cpp
+HEADERS *= $$LIB_PATH/src/canlibconstants.hpp
 HEADERS *= $$LIB_PATH/src/canmanager.hpp
 SOURCES *= $$LIB_PATH/src/canmanager.cpp
 HEADERS *= $$LIB_PATH/src/definescan.hpp
 
+# Capture
+HEADERS *= $$LIB_PATH/src/capture/cancaptureascexporter.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancaptureascexporter.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturefilewriter.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturefilewriter.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancaptureformat.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancaptureformat.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturereader.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturereader.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturerecorder.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturerecorder.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturereplayconfig.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturereplayconfig.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturereplayer.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturereplayer.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturereplaythread.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturereplaythread.cpp
+HEADERS *= $$LIB_PATH/src/capture/cancapturewritethread.hpp
+SOURCES *= $$LIB_PATH/src/capture/cancapturewritethread.cpp
+HEADERS *= $$LIB_PATH/src/capture/cantriggercapture.hpp
+SOURCES *= $$LIB_PATH/src/capture/cantriggercapture.cpp
+
+# Acceptance filter
+HEADERS *= $$LIB_PATH/src/filter/canacceptancefilter.hpp
+SOURCES *= $$LIB_PATH/src/filter/canacceptancefilter.cpp
+HEADERS *= $$LIB_PATH/src/filter/canacceptancetable.hpp
+SOURCES *= $$LIB_PATH/src/filter/canacceptancetable.cpp
+HEADERS *= $$LIB_PATH/src/filter/canrxfilter.hpp
+SOURCES *= $$LIB_PATH/src/filter/canrxfilter.cpp
+
+# Gateway
+HEADERS *= $$LIB_PATH/src/gateway/cangateway.hpp
+SOURCES *= $$LIB_PATH/src/gateway/cangateway.cpp
+HEADERS *= $$LIB_PATH/src/gateway/cangatewayroute.hpp
+SOURCES *= $$LIB_PATH/src/gateway/cangatewayroute.cpp
+HEADERS *= $$LIB_PATH/src/gateway/cangatewaystats.hpp
+SOURCES *= $$LIB_PATH/src/gateway/cangatewaystats.cpp
+HEADERS *= $$LIB_PATH/src/gateway/cangatewaytable.hpp
+SOURCES *= $$LIB_PATH/src/gateway/cangatewaytable.cpp
+
+# ISO-TP
+HEADERS *= $$LIB_PATH/src/isotp/isotpchannel.hpp
+SOURCES *= $$LIB_PATH/src/isotp/isotpchannel.cpp
+HEADERS *= $$LIB_PATH/src/isotp/isotpchannelintf.hpp
+SOURCES *= $$LIB_PATH/src/isotp/isotpchannelintf.cpp
+HEADERS *= $$LIB_PATH/src/isotp/isotpconfig.hpp
+SOURCES *= $$LIB_PATH/src/isotp/isotpconfig.cpp
+
+# Merged stream
+HEADERS *= $$LIB_PATH/src/merge/canchannelframe.hpp
+SOURCES *= $$LIB_PATH/src/merge/canchannelframe.cpp
+HEADERS *= $$LIB_PATH/src/merge/canmergedstream.hpp
+SOURCES *= $$LIB_PATH/src/merge/canmergedstream.cpp
+
+# Metrics
+HEADERS *= $$LIB_PATH/src/metrics/canbusmetrics.hpp
+SOURCES *= $$LIB_PATH/src/metrics/canbusmetrics.cpp
+HEADERS *= $$LIB_PATH/src/metrics/canbusmetricssnapshot.hpp
+SOURCES *= $$LIB_PATH/src/metrics/canbusmetricssnapshot.cpp
+HEADERS *= $$LIB_PATH/src/metrics/canbusmetricsstats.hpp
+SOURCES *= $$LIB_PATH/src/metrics/canbusmetricsstats.cpp
+
 # Models
+HEADERS *= $$LIB_PATH/src/models/canbusevent.hpp
+SOURCES *= $$LIB_PATH/src/models/canbusevent.cpp
 HEADERS *= $$LIB_PATH/src/models/candeviceconfig.hpp
 SOURCES *= $$LIB_PATH/src/models/candeviceconfig.cpp
 HEADERS *= $$LIB_PATH/src/models/candeviceconfigdetails.hpp
@@ -87,17 +156,60 @@ HEADERS *= $$LIB_PATH/src/pcanapi/pcanbaudrate.hpp
 SOURCES *= $$LIB_PATH/src/pcanapi/pcanbaudrate.cpp
 HEADERS *= $$LIB_PATH/src/pcanapi/pcanbusitf.hpp
 SOURCES *= $$LIB_PATH/src/pcanapi/pcanbusitf.cpp
+HEADERS *= $$LIB_PATH/src/pcanapi/pcanframeconverter.hpp
+SOURCES *= $$LIB_PATH/src/pcanapi/pcanframeconverter.cpp
 HEADERS *= $$LIB_PATH/src/pcanapi/pcanframedlc.hpp
-SOURCES *= $$LIB_PATH/src/pcanapi/pcanframedlc.cpp
 HEADERS *= $$LIB_PATH/src/pcanapi/pcanreader.hpp
 SOURCES *= $$LIB_PATH/src/pcanapi/pcanreader.cpp
 HEADERS *= $$LIB_PATH/src/pcanapi/pcanreadthread.hpp
 SOURCES *= $$LIB_PATH/src/pcanapi/pcanreadthread.cpp
 
+# Pipelined requests
+HEADERS *= $$LIB_PATH/src/requests/canrequesthandle.hpp
+SOURCES *= $$LIB_PATH/src/requests/canrequesthandle.cpp
+HEADERS *= $$LIB_PATH/src/requests/canrequestpipeline.hpp
+SOURCES *= $$LIB_PATH/src/requests/canrequestpipeline.cpp
+HEADERS *= $$LIB_PATH/src/requests/canrequeststatus.hpp
+SOURCES *= $$LIB_PATH/src/requests/canrequeststatus.cpp
+
+# Received frames rings
+HEADERS *= $$LIB_PATH/src/rxring/canframering.hpp
+SOURCES *= $$LIB_PATH/src/rxring/canframering.cpp
+HEADERS *= $$LIB_PATH/src/rxring/canframeringstats.hpp
+SOURCES *= $$LIB_PATH/src/rxring/canframeringstats.cpp
+HEADERS *= $$LIB_PATH/src/rxring/canringoverflowpolicy.hpp
+SOURCES *= $$LIB_PATH/src/rxring/canringoverflowpolicy.cpp
+
+# Cyclic scheduler
+HEADERS *= $$LIB_PATH/src/scheduler/cancyclicentry.hpp
+SOURCES *= $$LIB_PATH/src/scheduler/cancyclicentry.cpp
+HEADERS *= $$LIB_PATH/src/scheduler/cancyclicentrystats.hpp
+SOURCES *= $$LIB_PATH/src/scheduler/cancyclicentrystats.cpp
+HEADERS *= $$LIB_PATH/src/scheduler/cancyclicscheduler.hpp
+SOURCES *= $$LIB_PATH/src/scheduler/cancyclicscheduler.cpp
+HEADERS *= $$LIB_PATH/src/scheduler/cancyclicschedulerthread.hpp
+SOURCES *= $$LIB_PATH/src/scheduler/cancyclicschedulerthread.cpp
+
+# Trace
+HEADERS *= $$LIB_PATH/src/trace/cantracedecoder.hpp
+SOURCES *= $$LIB_PATH/src/trace/cantracedecoder.cpp
+HEADERS *= $$LIB_PATH/src/trace/cantracer.hpp
+SOURCES *= $$LIB_PATH/src/trace/cantracer.cpp
+HEADERS *= $$LIB_PATH/src/trace/cantracering.hpp
+SOURCES *= $$LIB_PATH/src/trace/cantracering.cpp
+
+# Transmit queue
+HEADERS *= $$LIB_PATH/src/txqueue/cantxqueue.hpp
+SOURCES *= $$LIB_PATH/src/txqueue/cantxqueue.cpp
+HEADERS *= $$LIB_PATH/src/txqueue/cantxqueueconfig.hpp
+SOURCES *= $$LIB_PATH/src/txqueue/cantxqueueconfig.cpp
+
 include($$QT_UTILITIES/definesutility/definesutility.pri)
 include($$QT_UTILITIES/byteutility/byteutility.pri)
+include($$QT_UTILITIES/collectionutility/collectionutility.pri)
 include($$QT_UTILITIES/handlerutility/handlerutility.pri)
 include($$QT_UTILITIES/numberutility/numberutility.pri)
+include($$QT_UTILITIES/statisticsutility/statisticsutility.pri)
 include($$QT_UTILITIES/waitutility/waitutility.pri)
 include($$QT_UTILITIES/threadutility/threadutility.pri)
 
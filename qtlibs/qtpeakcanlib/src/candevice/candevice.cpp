@@ -10,21 +10,52 @@
 #include "definesutility/definesutility.hpp"
 #include "waitutility/waithelper.hpp"
 
+#include "src/filter/canacceptancetable.hpp"
+#include "src/filter/canrxfilter.hpp"
+#include "src/gateway/cangateway.hpp"
+#include "src/gateway/cangatewaytable.hpp"
+#include "src/isotp/isotpchannel.hpp"
+#include "src/metrics/canbusmetrics.hpp"
 #include "src/models/candeviceconfig.hpp"
 #include "src/models/expectedcanframemask.hpp"
 #include "src/pcanapi/pcanapi.hpp"
 #include "src/pcanapi/pcanreadthread.hpp"
+#include "src/requests/canrequesthandle.hpp"
+#include "src/requests/canrequestpipeline.hpp"
+#include "src/rxring/canframering.hpp"
+#include "src/txqueue/cantxqueue.hpp"
 
 
 CanDevice::CanDevice(const CanDeviceConfig &config, QObject *parent)
     : QObject{parent},
-    _config{config}
+    _config{config},
+    _readerRing{QSharedPointer<CanFrameRing>::create(config.getRxRingCapacity(),
+                                                     config.getRxOverflowPolicy())},
+    _dispatchRing{QSharedPointer<CanFrameRing>::create(config.getRxRingCapacity(),
+                                                       config.getRxOverflowPolicy())},
+    _busMetrics{QSharedPointer<CanBusMetrics>::create(config)},
+    _rxFilter{QSharedPointer<CanRxFilter>::create()},
+    _gateway{QSharedPointer<CanGateway>::create()},
+    _txQueue{new CanTxQueue(config.getCanBusItf(),
+                            config.isCanFd(),
+                            config.getTxQueueConfig(),
+                            _busMetrics,
+                            this)},
+    _requestPipeline{new CanRequestPipeline(*this, config.getMaxInFlightRequestsByIdNb(), this)}
 {
+    connect(_txQueue, &CanTxQueue::batchWritten, this, &CanDevice::batchWritten);
+    connect(_requestPipeline,   &CanRequestPipeline::requestFinished,
+            this,               &CanDevice::requestFinished);
 }
 
 CanDevice::~CanDevice()
 {
     unInitialize();
+
+    // The pipeline releases the expected ids of its remaining requests when it's destroyed, it
+    // has to be done before the device members are destroyed
+    delete _requestPipeline;
+    _requestPipeline = nullptr;
 }
 
 bool CanDevice::initialize()
@@ -45,9 +76,29 @@ bool CanDevice::initialize()
         RETURN_IF_FALSE(PCanApi::initializeCan(_config));
     }
 
-    _readThread = new PCanReadThread(_config.getCanBusItf(), _config.isCanFd());
+    // After the initialization, the driver filter is open; it's set before starting to read
+    _channelInitialized = true;
+    _driverFilterRanges = {};
+    if(!updateAcceptanceFilter(true))
+    {
+        qWarning() << "A problem occurred when tried to set the acceptance filter of the CAN "
+                   << "device: " << _config.getCanBusItfName() << ", the frames are filtered by "
+                   << "the read thread";
+    }
+
+    // The frames which stay in the ring come from a previous session
+    _readerRing->clear();
+    _readThread = new PCanReadThread(_config.getCanBusItf(),
+                                     _config.isCanFd(),
+                                     _readerRing,
+                                     _busMetrics,
+                                     _rxFilter,
+                                     _gateway);
 
-    connect(_readThread, &PCanReadThread::framesReceived, this, &CanDevice::framesReceived);
+    connect(_readThread, &PCanReadThread::framesAvailable,
+            this,        &CanDevice::onReaderFramesAvailable);
+    connect(_readThread, &PCanReadThread::busEventOccurred,
+            this,        &CanDevice::busEventOccurred);
 
     if(!_readThread->startThreadAndWaitToBeReady())
     {
@@ -70,10 +121,15 @@ bool CanDevice::unInitialize()
         return true;
     }
 
+    // The waiting batches can't be written anymore, and the pending requests won't be answered
+    _txQueue->clear();
+    _requestPipeline->cancelAll();
+
     // This will waits the read thread to leave properly
     _readThread->stopAndDeleteThread();
     _readThread = nullptr;
 
+    _channelInitialized = false;
     RETURN_IF_FALSE(PCanApi::unInitializeCan(_config.getCanBusItf()));
 
     qDebug() << "The CAN device: " << _config.getCanBusItfName() << ", is uninitialized";
@@ -120,6 +176,177 @@ bool CanDevice::setParamBusOffAutoReset(bool autoReset)
     return PCanApi::setParamBusOffAutoReset(_config.getCanBusItf(), autoReset);
 }
 
+bool CanDevice::getRxRingsStats(CanFrameRingStats *readerRingStats,
+                                CanFrameRingStats *dispatchRingStats)
+{
+    if(readerRingStats == nullptr || dispatchRingStats == nullptr)
+    {
+        qWarning() << "We can't get the received frames rings stats, for CAN bus intf: "
+                   << _config.getCanBusItfName() << ", because one of the stats param pointer is "
+                   << "nullptr";
+        return false;
+    }
+
+    *readerRingStats = _readerRing->getStats();
+    *dispatchRingStats = _dispatchRing->getStats();
+    return true;
+}
+
+bool CanDevice::resetRxRingsStats()
+{
+    _readerRing->resetStats();
+    _dispatchRing->resetStats();
+    return true;
+}
+
+IsoTpChannel *CanDevice::createIsoTpChannel(const IsoTpConfig &config)
+{
+    if(!config.isValid())
+    {
+        qWarning() << "The ISO-TP config isn't valid, we can't create the channel on the CAN bus "
+                   << "intf: " << _config.getCanBusItfName();
+        return nullptr;
+    }
+
+    if(config.isCanFd() && !_config.isCanFd())
+    {
+        qWarning() << "The ISO-TP channel needs CAN FD, but the CAN bus intf: "
+                   << _config.getCanBusItfName() << ", isn't configured for CAN FD";
+        return nullptr;
+    }
+
+    for(auto citer = _isoTpChannels.cbegin(); citer != _isoTpChannels.cend(); ++citer)
+    {
+        const IsoTpConfig &channelConfig = (*citer)->getConfig();
+
+        if(channelConfig.getRxId() == config.getRxId() &&
+           channelConfig.isExtendedIds() == config.isExtendedIds())
+        {
+            qWarning() << "An ISO-TP channel already receives its frames on the id: "
+                       << config.getRxId() << ", on the CAN bus intf: "
+                       << _config.getCanBusItfName();
+            return nullptr;
+        }
+    }
+
+    IsoTpChannel *channel = new IsoTpChannel(config, *this, this);
+    _isoTpChannels.append(channel);
+
+    updateAcceptanceFilter(false);
+
+    return channel;
+}
+
+bool CanDevice::deleteIsoTpChannel(IsoTpChannel *channel)
+{
+    if(!_isoTpChannels.removeOne(channel))
+    {
+        qWarning() << "The ISO-TP channel to delete isn't known by the CAN bus intf: "
+                   << _config.getCanBusItfName();
+        return false;
+    }
+
+    delete channel;
+
+    updateAcceptanceFilter(true);
+    return true;
+}
+
+bool CanDevice::setGatewayTable(const QSharedPointer<const CanGatewayTable> &table)
+{
+    const bool hadRoutes = !_gatewayTable.isNull();
+    _gatewayTable = table;
+
+    // The driver filter is expanded before the routes are applied, the first routed frames can't
+    // be missed
+    bool success = updateAcceptanceFilter(false);
+    _gateway->setTable(table);
+
+    if(hadRoutes)
+    {
+        // The ids of the previous routes may be useless now
+        success &= updateAcceptanceFilter(true);
+    }
+
+    return success;
+}
+
+bool CanDevice::addAcceptanceSubscription(quint64 subscriptionId,
+                                          const CanAcceptanceFilter &filter)
+{
+    if(!filter.isValid())
+    {
+        qWarning() << "The acceptance filter of the subscription: " << subscriptionId
+                   << ", isn't valid, we can't add it to the CAN bus intf: "
+                   << _config.getCanBusItfName();
+        return false;
+    }
+
+    if(!_config.isAcceptanceFilterEnabled())
+    {
+        qInfo() << "The acceptance filter isn't enabled on the CAN bus intf: "
+                << _config.getCanBusItfName() << ", all the frames are already received";
+    }
+
+    _acceptanceSubscriptions.insert(subscriptionId, filter);
+    return updateAcceptanceFilter(false);
+}
+
+bool CanDevice::removeAcceptanceSubscription(quint64 subscriptionId)
+{
+    if(_acceptanceSubscriptions.remove(subscriptionId) == 0)
+    {
+        qWarning() << "The acceptance subscription: " << subscriptionId << ", isn't known by the "
+                   << "CAN bus intf: " << _config.getCanBusItfName();
+        return false;
+    }
+
+    return updateAcceptanceFilter(true);
+}
+
+void CanDevice::acquireExpectedIds(const QVector<ExpectedCanFrameMask> &expectedFrameMasks)
+{
+    bool newIds = false;
+
+    for(auto citer = expectedFrameMasks.cbegin(); citer != expectedFrameMasks.cend(); ++citer)
+    {
+        int &usersNb = _expectedIdsUsersNb[citer->getReceivedMsgId()];
+        newIds |= (usersNb == 0);
+        ++usersNb;
+    }
+
+    if(newIds)
+    {
+        // The filter is updated before the request is written, the answer can't be missed
+        updateAcceptanceFilter(false);
+    }
+}
+
+void CanDevice::releaseExpectedIds(const QVector<ExpectedCanFrameMask> &expectedFrameMasks)
+{
+    bool removedIds = false;
+
+    for(auto citer = expectedFrameMasks.cbegin(); citer != expectedFrameMasks.cend(); ++citer)
+    {
+        auto iter = _expectedIdsUsersNb.find(citer->getReceivedMsgId());
+        if(iter == _expectedIdsUsersNb.end())
+        {
+            continue;
+        }
+
+        if(--iter.value() <= 0)
+        {
+            _expectedIdsUsersNb.erase(iter);
+            removedIds = true;
+        }
+    }
+
+    if(removedIds)
+    {
+        updateAcceptanceFilter(false);
+    }
+}
+
 bool CanDevice::write(const QCanBusFrame &frame)
 {
     if(_readThread == nullptr)
@@ -130,12 +357,52 @@ bool CanDevice::write(const QCanBusFrame &frame)
         return false;
     }
 
-    if(_config.isCanFd())
+    const bool success = _config.isCanFd() ?
+                             PCanApi::writeCanFdMsgProcess(_config.getCanBusItf(), frame) :
+                             PCanApi::writeCanMsgProcess(_config.getCanBusItf(), frame);
+
+    if(!success)
     {
-        return PCanApi::writeCanFdMsgProcess(_config.getCanBusItf(), frame);
+        _busMetrics->addTxError();
+        return false;
+    }
+
+    _busMetrics->addTxFrame(frame);
+    return true;
+}
+
+bool CanDevice::writeBatch(const QVector<QCanBusFrame> &frames, quint64 batchId)
+{
+    if(_readThread == nullptr)
+    {
+        qWarning() << "We can't write the batch: " << batchId << ", for CAN bus intf: "
+                   << _config.getCanBusItfName() << ", because the can device hasn't been "
+                   << "initialized";
+        emit batchWritten(batchId, false);
+        return false;
+    }
+
+    _txQueue->enqueue(frames, batchId);
+    return true;
+}
+
+bool CanDevice::sendRequest(const CanRequestHandle &handle,
+                            const QCanBusFrame &frame,
+                            const ExpectedCanFrameMask &expectedFrameMask,
+                            int timeoutInMs)
+{
+    if(_readThread == nullptr)
+    {
+        qWarning() << "We can't send the request: " << frame.toString() << ", for CAN bus intf: "
+                   << _config.getCanBusItfName() << ", because the can device hasn't been "
+                   << "initialized";
+        CanRequestHandle(handle).finish(CanRequestStatus::WriteFailed);
+        emit requestFinished(handle.getRequestId(), false);
+        return false;
     }
 
-    return PCanApi::writeCanMsgProcess(_config.getCanBusItf(), frame);
+    _requestPipeline->enqueue(handle, frame, expectedFrameMask, timeoutInMs);
+    return true;
 }
 
 QVector<QCanBusFrame> CanDevice::writeAndWaitAnswer(const QCanBusFrame &frame,
@@ -296,8 +563,10 @@ QVector<QCanBusFrame> CanDevice::waitFrameAndProcessIfNeeded(
     QVector<ExpectedCanFrameMask> waitingFrames(expectedFrameMasks);
     QVector<QCanBusFrame> foundFrames;
 
-    auto waitingConn = connect(_readThread,
-                               &PCanReadThread::framesReceived,
+    acquireExpectedIds(expectedFrameMasks);
+
+    auto waitingConn = connect(this,
+                               &CanDevice::framesReceived,
                                this,
                                [&foundFrames, &waitingFrames, areWeWaitingForAllMsgIds](
                                    const QVector<QCanBusFrame> &frames)
@@ -337,6 +606,7 @@ QVector<QCanBusFrame> CanDevice::waitFrameAndProcessIfNeeded(
     if(process != nullptr && !(*process)())
     {
         disconnect(waitingConn);
+        releaseExpectedIds(expectedFrameMasks);
         return {};
     }
 
@@ -345,9 +615,161 @@ QVector<QCanBusFrame> CanDevice::waitFrameAndProcessIfNeeded(
         qWarning() << "A problem occurred when waiting for the received of a specific CAN message "
                    << "after processing";
         disconnect(waitingConn);
+        releaseExpectedIds(expectedFrameMasks);
         return {};
     }
 
     disconnect(waitingConn);
+    releaseExpectedIds(expectedFrameMasks);
     return foundFrames;
 }
+
+bool CanDevice::updateAcceptanceFilter(bool narrowDriverFilter)
+{
+    if(!_config.isAcceptanceFilterEnabled())
+    {
+        return true;
+    }
+
+    CanAcceptanceFilter filter;
+
+    for(auto citer = _acceptanceSubscriptions.cbegin();
+        citer != _acceptanceSubscriptions.cend();
+        ++citer)
+    {
+        filter.merge(citer.value());
+    }
+
+    for(auto citer = _isoTpChannels.cbegin(); citer != _isoTpChannels.cend(); ++citer)
+    {
+        const IsoTpConfig &channelConfig = (*citer)->getConfig();
+        filter.addId(channelConfig.getRxId(), channelConfig.isExtendedIds());
+    }
+
+    if(!_gatewayTable.isNull())
+    {
+        filter.merge(_gatewayTable->getMatchFilter());
+    }
+
+    // The expected frames don't precise the id format, both are accepted
+    const quint32 maxStandardId = CanAcceptanceFilter::getMaxId(false);
+    for(auto citer = _expectedIdsUsersNb.cbegin(); citer != _expectedIdsUsersNb.cend(); ++citer)
+    {
+        filter.addId(citer.key(), true);
+
+        if(citer.key() <= maxStandardId)
+        {
+            filter.addId(citer.key(), false);
+        }
+    }
+
+    const QSharedPointer<const CanAcceptanceTable> table(new CanAcceptanceTable(filter));
+
+    bool success = true;
+    if(_channelInitialized)
+    {
+        // The driver filter is expanded before the read thread table, to not lose frames
+        success = applyDriverFilter(*table, narrowDriverFilter);
+    }
+
+    _rxFilter->setTable(table);
+    return success;
+}
+
+bool CanDevice::applyDriverFilter(const CanAcceptanceTable &table, bool narrowDriverFilter)
+{
+    const PCanBusItf::Enum canBusItf = _config.getCanBusItf();
+
+    std::array<DriverFilterRange, 2> wantedRanges{};
+    for(int formatIdx = 0; formatIdx < static_cast<int>(wantedRanges.size()); ++formatIdx)
+    {
+        DriverFilterRange &wanted = wantedRanges[formatIdx];
+        const DriverFilterRange &current = _driverFilterRanges[formatIdx];
+
+        wanted.used = table.getIdsHull((formatIdx != 0), wanted.firstId, wanted.lastId);
+
+        if(!narrowDriverFilter && current.used)
+        {
+            // The driver filter can only be expanded, the current range is kept
+            wanted.firstId = wanted.used ? qMin(wanted.firstId, current.firstId) : current.firstId;
+            wanted.lastId = wanted.used ? qMax(wanted.lastId, current.lastId) : current.lastId;
+            wanted.used = true;
+        }
+    }
+
+    bool sameRanges = true;
+    for(int formatIdx = 0; formatIdx < static_cast<int>(wantedRanges.size()); ++formatIdx)
+    {
+        const DriverFilterRange &wanted = wantedRanges.at(formatIdx);
+        const DriverFilterRange &current = _driverFilterRanges.at(formatIdx);
+
+        sameRanges &= (wanted.used == current.used) &&
+                      (!wanted.used ||
+                       (wanted.firstId == current.firstId && wanted.lastId == current.lastId));
+    }
+
+    if(sameRanges)
+    {
+        return true;
+    }
+
+    bool success = !narrowDriverFilter || PCanApi::setMessageFilterOpen(canBusItf, false);
+
+    for(int formatIdx = 0;
+        success && formatIdx < static_cast<int>(wantedRanges.size());
+        ++formatIdx)
+    {
+        const DriverFilterRange &wanted = wantedRanges.at(formatIdx);
+        if(wanted.used)
+        {
+            success = PCanApi::expandMessageFilter(canBusItf,
+                                                   wanted.firstId,
+                                                   wanted.lastId,
+                                                   (formatIdx != 0));
+        }
+    }
+
+    if(!success)
+    {
+        // We don't know the state of the driver filter, it's opened to not lose any frame
+        PCanApi::setMessageFilterOpen(canBusItf, true);
+
+        for(int formatIdx = 0; formatIdx < static_cast<int>(wantedRanges.size()); ++formatIdx)
+        {
+            DriverFilterRange &range = _driverFilterRanges[formatIdx];
+            range.used = true;
+            range.firstId = 0;
+            range.lastId = CanAcceptanceFilter::getMaxId(formatIdx != 0);
+        }
+
+        return false;
+    }
+
+    _driverFilterRanges = wantedRanges;
+    return true;
+}
+
+void CanDevice::onReaderFramesAvailable()
+{
+    // The notification is disarmed before draining, the frames pushed while draining will raise a
+    // new notification
+    _readerRing->disarmNotification();
+
+    QVector<QCanBusFrame> frames;
+    if(_readerRing->popAll(frames) == 0)
+    {
+        return;
+    }
+
+    emit framesReceived(frames);
+
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        _dispatchRing->push(*citer);
+    }
+
+    if(_dispatchRing->armNotification())
+    {
+        emit framesAvailable();
+    }
+}
@@ -6,22 +6,61 @@
 
 #include <QObject>
 
+#include <array>
+
 #include <QCanBusDevice>
 #include <QCanBusFrame>
+#include <QHash>
+#include <QSharedPointer>
 
+#include "src/filter/canacceptancefilter.hpp"
+#include "src/models/canbusevent.hpp"
 #include "src/models/candeviceconfig.hpp"
 
+class CanAcceptanceTable;
+class CanBusMetrics;
+class CanFrameRing;
+class CanFrameRingStats;
+class CanGateway;
+class CanGatewayTable;
+class CanRequestHandle;
+class CanRequestPipeline;
+class CanRxFilter;
+class CanTxQueue;
 class ExpectedCanFrameMask;
+class IsoTpChannel;
+class IsoTpConfig;
 class PCanReadThread;
 
 
 /** @brief This class represents a device which communicates through CAN
     @note The object lives a dedicated Thread
-    @note The reading of messages is also done in another dedicated Thread */
+    @note The reading of messages is also done in another dedicated Thread
+    @note The received frames are passed from the read thread to this device through a bounded
+          ring, and from this device to the @ref CanDeviceIntf through another one. Therefore, if
+          one of the consumer threads stalls, the memory used doesn't grow without bound.
+    @note If the acceptance filter is enabled in the config, the frames received are filtered
+          with the union of the acceptance subscriptions, the ISO-TP channels ids and the ids
+          expected by the pending waits and requests. The filter is pushed down to the PEAK driver
+          (one ids range by format) and applied exactly by the read thread. */
 class CanDevice : public QObject
 {
     Q_OBJECT
 
+    private:
+        /** @brief A range of ids configured in the message filter of the PEAK driver */
+        struct DriverFilterRange
+        {
+            /** @brief True if the range is used, false if no id of this format is accepted */
+            bool used{false};
+
+            /** @brief The first id of the range */
+            quint32 firstId{0};
+
+            /** @brief The last id of the range (included) */
+            quint32 lastId{0};
+        };
+
     public:
         /** @brief Class constructor
             @param config The CAN device config linked to this device
@@ -63,11 +102,115 @@ class CanDevice : public QObject
             @return True if no problem occurred */
         bool setParamBusOffAutoReset(bool autoReset);
 
+        /** @brief Get the ring where the received frames are pushed for the @ref CanDeviceIntf
+            @note The ring is created with the device and never changes; therefore, this can be
+                  called from any thread.
+            @note The caller has to be the only consumer of the ring, and has to drain it when
+                  @ref framesAvailable is emitted */
+        const QSharedPointer<CanFrameRing> &getDispatchRing() const { return _dispatchRing; }
+
+        /** @brief Get the live metrics of the bus
+            @note The metrics are created with the device and never change; therefore, this can be
+                  called from any thread. The metrics object is thread safe. */
+        const QSharedPointer<CanBusMetrics> &getBusMetrics() const { return _busMetrics; }
+
+        /** @brief Get the acceptance filter applied by the read thread
+            @note The filter is created with the device and never changes; therefore, this can be
+                  called from any thread. The filter object is thread safe. */
+        const QSharedPointer<CanRxFilter> &getRxFilter() const { return _rxFilter; }
+
+        /** @brief Get the gateway applied by the read thread
+            @note The gateway is created with the device and never changes; therefore, this can be
+                  called from any thread. The gateway object is thread safe. */
+        const QSharedPointer<CanGateway> &getGateway() const { return _gateway; }
+
+        /** @brief Set the gateway table applied by the read thread
+            @note The routed ids are added to the acceptance filter, to pass through the driver
+                  filter
+            @param table The table to apply, null to forward nothing
+            @return True if no problem occurred */
+        bool setGatewayTable(const QSharedPointer<const CanGatewayTable> &table);
+
+        /** @brief Add an acceptance subscription: the frames accepted by the filter given are
+                   received
+            @note This has no effect if the acceptance filter isn't enabled in the config
+            @param subscriptionId The id of the subscription
+            @param filter The filter of the subscription
+            @return True if no problem occurred */
+        bool addAcceptanceSubscription(quint64 subscriptionId, const CanAcceptanceFilter &filter);
+
+        /** @brief Remove an acceptance subscription
+            @param subscriptionId The id of the subscription to remove
+            @return True if no problem occurred */
+        bool removeAcceptanceSubscription(quint64 subscriptionId);
+
+        /** @brief Accept the ids of the expected frames given, until they are released
+            @note This is used by the waiting methods and the pipelined requests, the ids are
+                  counted: an id is accepted while one of its users hasn't released it
+            @param expectedFrameMasks The expected frames to accept */
+        void acquireExpectedIds(const QVector<ExpectedCanFrameMask> &expectedFrameMasks);
+
+        /** @brief Release the ids of the expected frames given
+            @note To not reconfigure the PEAK driver at each request, the driver filter isn't
+                  narrowed: the read thread filters the released ids
+            @param expectedFrameMasks The expected frames to release */
+        void releaseExpectedIds(const QVector<ExpectedCanFrameMask> &expectedFrameMasks);
+
+        /** @brief Get the statistics of the received frames rings
+            @note The parameters are pointers to be used with the @ref ThreadConcurrentRun::run
+                  method
+            @param readerRingStats The stats of the ring between the read thread and the device
+            @param dispatchRingStats The stats of the ring between the device and its interface
+            @return True if no problem occurred */
+        bool getRxRingsStats(CanFrameRingStats *readerRingStats,
+                             CanFrameRingStats *dispatchRingStats);
+
+        /** @brief Reset the statistics of the received frames rings
+            @return True if no problem occurred */
+        bool resetRxRingsStats();
+
+        /** @brief Create an ISO-TP channel on the device
+            @note The channel lives in the device thread and is owned by the device
+            @note Several channels can be created on the device, but each one has to receive its
+                  frames on its own id
+            @param config The channel config
+            @return The channel created or nullptr if a problem occurred */
+        IsoTpChannel *createIsoTpChannel(const IsoTpConfig &config);
+
+        /** @brief Delete an ISO-TP channel of the device
+            @param channel The channel to delete
+            @return True if no problem occurred */
+        bool deleteIsoTpChannel(IsoTpChannel *channel);
+
         /** @brief Write a CAN bus frame
             @param frame The frame to write
             @return True if no problem occurred */
         bool write(const QCanBusFrame &frame);
 
+        /** @brief Add a batch of frames to the device transmit queue
+            @note The frames are written in order, with the pacing configured in
+                  @ref CanDeviceConfig::getTxQueueConfig. When the driver transmit queue is full,
+                  the writing is retried.
+            @note The end of the batch writing is notified with @ref batchWritten
+            @note The frames written with @ref write don't go through the transmit queue
+            @param frames The frames to write
+            @param batchId The id of the batch, given back with @ref batchWritten
+            @return True if the batch has been queued */
+        bool writeBatch(const QVector<QCanBusFrame> &frames, quint64 batchId);
+
+        /** @brief Send a pipelined request: the request is written and its answer is waited
+                   without blocking the device thread
+            @note The request end is notified through the handle and with @ref requestFinished
+            @param handle The handle of the request
+            @param frame The request frame to write
+            @param expectedFrameMask The information which describes the expected answer
+            @param timeoutInMs The request timeout, -1 to wait forever
+            @return True if the request has been added to the pipeline */
+        bool sendRequest(const CanRequestHandle &handle,
+                         const QCanBusFrame &frame,
+                         const ExpectedCanFrameMask &expectedFrameMask,
+                         int timeoutInMs);
+
         /** @brief Write a CAN bus frame and wait for an answer
             @note The method begins to listen before the writting of message; therefore, if the
                   answer is sent before the writing, you may receive this answer.
@@ -237,7 +380,32 @@ class CanDevice : public QObject
             const QVector<quint32> &answersIds,
             int timeoutInMs = -1);
 
+    private slots:
+        /** @brief Called when frames are available in the read thread ring
+            @note The method drains the ring, emits @ref framesReceived for the waiting methods and
+                  forwards the frames to the dispatch ring */
+        void onReaderFramesAvailable();
+
     private:
+        /** @brief Compute the acceptance table from the subscriptions, the ISO-TP channels, the
+                   expected ids and the gateway routes, and apply it to the PEAK driver and to the
+                   read thread
+            @note This does nothing if the acceptance filter isn't enabled in the config
+            @param narrowDriverFilter If false, the driver filter is only expanded: no frame can
+                                      be lost while it's updated. If true, the driver filter is
+                                      closed and set again if its ranges have changed.
+            @return True if no problem occurred */
+        bool updateAcceptanceFilter(bool narrowDriverFilter);
+
+        /** @brief Apply the acceptance table given to the message filter of the PEAK driver
+            @note The driver only manages one range by ids format, the hull of the accepted ids is
+                  used. If a problem occurs, the driver filter is opened and only the read thread
+                  filters the frames.
+            @param table The table to apply
+            @param narrowDriverFilter See @ref updateAcceptanceFilter
+            @return True if no problem occurred */
+        bool applyDriverFilter(const CanAcceptanceTable &table, bool narrowDriverFilter);
+
         /** @brief Write and wait for CAN messages
             @note The method begins to listen before the write method; therefore, if one of
                   the expected messages is sent before the writing, you may receive this message.
@@ -285,10 +453,44 @@ class CanDevice : public QObject
 
     signals:
         /** @brief Emitted when frames are received
+            @note The signal is emitted in the device thread
             @param frames The received frames */
         void framesReceived(const QVector<QCanBusFrame> &frames);
 
+        /** @brief Emitted when new frames are available in the dispatch ring
+            @note The notification is coalesced: it's only emitted once until the consumer drains
+                  the ring
+            @see getDispatchRing */
+        void framesAvailable();
+
+        /** @brief Emitted when a bus event is notified by the read thread
+            @param event The bus event */
+        void busEventOccurred(CanBusEvent::Enum event);
+
+        /** @brief Emitted when a batch writing is finished
+            @param batchId The id of the batch
+            @param success True if all the frames of the batch have been written */
+        void batchWritten(quint64 batchId, bool success);
+
+        /** @brief Emitted when a pipelined request is finished
+            @param requestId The id of the request
+            @param success True if the request has been answered */
+        void requestFinished(quint64 requestId, bool success);
+
     private:
         CanDeviceConfig _config;
         PCanReadThread *_readThread{nullptr};
+        QSharedPointer<CanFrameRing> _readerRing;
+        QSharedPointer<CanFrameRing> _dispatchRing;
+        QSharedPointer<CanBusMetrics> _busMetrics;
+        QSharedPointer<CanRxFilter> _rxFilter;
+        QSharedPointer<CanGateway> _gateway;
+        QSharedPointer<const CanGatewayTable> _gatewayTable;
+        QHash<quint64, CanAcceptanceFilter> _acceptanceSubscriptions;
+        QHash<quint32, int> _expectedIdsUsersNb;
+        std::array<DriverFilterRange, 2> _driverFilterRanges{};
+        bool _channelInitialized{false};
+        CanTxQueue *_txQueue{nullptr};
+        CanRequestPipeline *_requestPipeline{nullptr};
+        QVector<IsoTpChannel*> _isoTpChannels;
 };
@@ -4,12 +4,24 @@
 
 #include "candeviceintf.hpp"
 
+#include <limits>
+
 #include "definesutility/definesutility.hpp"
 #include "threadutility/concurrent/threadconcurrentrun.hpp"
 
 #include "src/candevice/candevice.hpp"
 #include "src/candevice/candevicethread.hpp"
+#include "src/canmanager.hpp"
+#include "src/filter/canrxfilter.hpp"
+#include "src/gateway/cangateway.hpp"
+#include "src/gateway/cangatewaystats.hpp"
+#include "src/gateway/cangatewaytable.hpp"
+#include "src/isotp/isotpchannel.hpp"
+#include "src/isotp/isotpchannelintf.hpp"
+#include "src/metrics/canbusmetrics.hpp"
+#include "src/metrics/canbusmetricssnapshot.hpp"
 #include "src/models/expectedcanframemask.hpp"
+#include "src/rxring/canframering.hpp"
 
 
 CanDeviceIntf::CanDeviceIntf(const CanDeviceConfig &config, QObject *parent)
@@ -23,6 +35,13 @@ CanDeviceIntf::~CanDeviceIntf()
 {
     // We first unitialize the device before stopping and deleting the thread
     unInitialize();
+
+    if(!_dispatchRing.isNull())
+    {
+        // No one will drain the ring anymore, the device mustn't block on it
+        _dispatchRing->cancelPendingPush();
+    }
+
     _canDeviceThread->stopAndDeleteThread();
 }
 
@@ -37,9 +56,24 @@ bool CanDeviceIntf::initDevice()
         return false;
     }
 
-    connect(device, &CanDevice::framesReceived,
-            this,   &CanDeviceIntf::framesReceived, Qt::UniqueConnection);
-    
+    // The ring is created with the device and never changes, it can be got from this thread
+    _dispatchRing = device->getDispatchRing();
+    _dispatchRing->resumePendingPush();
+
+    // As the ring, the metrics are created with the device and never change
+    _busMetrics = device->getBusMetrics();
+    _rxFilter = device->getRxFilter();
+    _gateway = device->getGateway();
+
+    connect(device, &CanDevice::framesAvailable,
+            this,   &CanDeviceIntf::onFramesAvailable, Qt::UniqueConnection);
+    connect(device, &CanDevice::batchWritten,
+            this,   &CanDeviceIntf::batchWritten, Qt::UniqueConnection);
+    connect(device, &CanDevice::busEventOccurred,
+            this,   &CanDeviceIntf::busEventOccurred, Qt::UniqueConnection);
+    connect(device, &CanDevice::requestFinished,
+            this,   &CanDeviceIntf::requestFinished, Qt::UniqueConnection);
+
     return ThreadConcurrentRun::run(*device, &CanDevice::initialize);
 }
 
@@ -54,7 +88,7 @@ bool CanDeviceIntf::unInitialize()
 
     RETURN_IF_FALSE(ThreadConcurrentRun::run(*device, &CanDevice::unInitialize));
 
-    disconnect(device, &CanDevice::framesReceived, this, &CanDeviceIntf::framesReceived);
+    disconnect(device, &CanDevice::framesAvailable, this, &CanDeviceIntf::onFramesAvailable);
 
     return true;
 }
@@ -98,6 +132,211 @@ bool CanDeviceIntf::setParamBusOffAutoReset(bool autoReset)
     return ThreadConcurrentRun::run(*device, &CanDevice::setParamBusOffAutoReset, autoReset);
 }
 
+bool CanDeviceIntf::getRxRingsStats(CanFrameRingStats &readerRingStats,
+                                    CanFrameRingStats &dispatchRingStats)
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("get the received frames rings "
+                                                                 "stats"));
+
+    if(device == nullptr)
+    {
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*device,
+                                    &CanDevice::getRxRingsStats,
+                                    &readerRingStats,
+                                    &dispatchRingStats);
+}
+
+bool CanDeviceIntf::resetRxRingsStats()
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("reset the received frames rings "
+                                                                 "stats"));
+
+    if(device == nullptr)
+    {
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*device, &CanDevice::resetRxRingsStats);
+}
+
+bool CanDeviceIntf::getBusMetrics(CanBusMetricsSnapshot &snapshot)
+{
+    if(_busMetrics.isNull())
+    {
+        qWarning() << "Failed to get the bus metrics of the CAN device: "
+                   << _config.getCanBusItfName() << ", the device has never been initialized";
+        return false;
+    }
+
+    snapshot = _busMetrics->takeSnapshot();
+    return true;
+}
+
+bool CanDeviceIntf::resetBusMetrics()
+{
+    if(_busMetrics.isNull())
+    {
+        qWarning() << "Failed to reset the bus metrics of the CAN device: "
+                   << _config.getCanBusItfName() << ", the device has never been initialized";
+        return false;
+    }
+
+    _busMetrics->reset();
+    return true;
+}
+
+quint64 CanDeviceIntf::addAcceptanceSubscription(const CanAcceptanceFilter &filter)
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("add an acceptance "
+                                                                 "subscription"));
+
+    if(device == nullptr)
+    {
+        return 0;
+    }
+
+    const quint64 subscriptionId = _nextSubscriptionId++;
+
+    if(!ThreadConcurrentRun::run(*device,
+                                 &CanDevice::addAcceptanceSubscription,
+                                 subscriptionId,
+                                 filter))
+    {
+        return 0;
+    }
+
+    return subscriptionId;
+}
+
+bool CanDeviceIntf::removeAcceptanceSubscription(quint64 subscriptionId)
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("remove an acceptance "
+                                                                 "subscription"));
+
+    if(device == nullptr)
+    {
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*device,
+                                    &CanDevice::removeAcceptanceSubscription,
+                                    subscriptionId);
+}
+
+bool CanDeviceIntf::getRejectedFramesNb(quint64 &rejectedFramesNb)
+{
+    if(_rxFilter.isNull())
+    {
+        qWarning() << "Failed to get the rejected frames number of the CAN device: "
+                   << _config.getCanBusItfName() << ", the device has never been initialized";
+        return false;
+    }
+
+    rejectedFramesNb = _rxFilter->getRejectedFramesNb();
+    return true;
+}
+
+bool CanDeviceIntf::setGatewayRoutes(const QVector<CanGatewayRoute> &routes)
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("set the gateway routes"));
+
+    if(device == nullptr)
+    {
+        return false;
+    }
+
+    if(routes.length() > std::numeric_limits<qint16>::max())
+    {
+        qWarning() << "Too many gateway routes: " << routes.length() << ", are given to the CAN "
+                   << "bus intf: " << _config.getCanBusItfName();
+        return false;
+    }
+
+    // The targets are resolved here to not access the CAN manager from the device thread
+    QHash<PCanBusItf::Enum, bool> targetsCanFd;
+    QHash<PCanBusItf::Enum, QSharedPointer<CanBusMetrics>> targetsMetrics;
+    for(auto citer = routes.cbegin(); citer != routes.cend(); ++citer)
+    {
+        const PCanBusItf::Enum target = citer->getTargetCanBusItf();
+
+        if(!citer->isValid() || target == getCanIntfKey())
+        {
+            qWarning() << "A gateway route of the CAN bus intf: " << _config.getCanBusItfName()
+                       << ", isn't valid, target: " << PCanBusItf::toString(target);
+            return false;
+        }
+
+        if(targetsCanFd.contains(target))
+        {
+            continue;
+        }
+
+        const QSharedPointer<CanDeviceIntf> targetIntf = CanManager::getInstance().getCanIntf(
+            target);
+        if(targetIntf.isNull())
+        {
+            qWarning() << "The target: " << PCanBusItf::toString(target) << ", of a gateway "
+                       << "route of the CAN bus intf: " << _config.getCanBusItfName()
+                       << ", doesn't exist";
+            return false;
+        }
+
+        targetsCanFd.insert(target, targetIntf->getConfig().isCanFd());
+
+        // The metrics are null if the target hasn't been initialized yet
+        if(!targetIntf->_busMetrics.isNull())
+        {
+            targetsMetrics.insert(target, targetIntf->_busMetrics);
+        }
+    }
+
+    QSharedPointer<const CanGatewayTable> table;
+    if(!routes.isEmpty())
+    {
+        table = QSharedPointer<const CanGatewayTable>(
+            new CanGatewayTable(routes, targetsCanFd, targetsMetrics));
+    }
+
+    return ThreadConcurrentRun::run(*device, &CanDevice::setGatewayTable, table);
+}
+
+bool CanDeviceIntf::getGatewayStats(CanGatewayStats &stats)
+{
+    if(_gateway.isNull())
+    {
+        qWarning() << "Failed to get the gateway stats of the CAN device: "
+                   << _config.getCanBusItfName() << ", the device has never been initialized";
+        return false;
+    }
+
+    stats = _gateway->getStats();
+    return true;
+}
+
+IsoTpChannelIntf *CanDeviceIntf::createIsoTpChannel(const IsoTpConfig &config, QObject *parent)
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("create an ISO-TP channel"));
+
+    if(device == nullptr)
+    {
+        return nullptr;
+    }
+
+    IsoTpChannel *channel = ThreadConcurrentRun::run(*device,
+                                                     &CanDevice::createIsoTpChannel,
+                                                     config);
+
+    if(channel == nullptr)
+    {
+        return nullptr;
+    }
+
+    return new IsoTpChannelIntf(*device, *channel, parent);
+}
+
 bool CanDeviceIntf::write(const QCanBusFrame &frame)
 {
     CanDevice *device = accessDeviceThroughThread(QStringLiteral("write a frame"));
@@ -110,6 +349,61 @@ bool CanDeviceIntf::write(const QCanBusFrame &frame)
     return ThreadConcurrentRun::run(*device, &CanDevice::write, frame);
 }
 
+quint64 CanDeviceIntf::writeBatch(const QVector<QCanBusFrame> &frames)
+{
+    if(frames.isEmpty())
+    {
+        qWarning() << "We can't write an empty batch of frames";
+        return 0;
+    }
+
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("write a batch of frames"));
+
+    if(device == nullptr)
+    {
+        return 0;
+    }
+
+    const quint64 batchId = _nextBatchId++;
+
+    // We don't wait for the device thread: the writing may be long and its end is notified
+    QMetaObject::invokeMethod(device,
+                              [device, frames, batchId]()
+                              {
+                                  device->writeBatch(frames, batchId);
+                              },
+                              Qt::QueuedConnection);
+
+    return batchId;
+}
+
+CanRequestHandle CanDeviceIntf::sendRequest(const QCanBusFrame &frame,
+                                            const ExpectedCanFrameMask &expectedFrameMask,
+                                            int timeoutInMs)
+{
+    CanDevice *device = accessDeviceThroughThread(QStringLiteral("send a pipelined request"));
+
+    if(device == nullptr)
+    {
+        return CanRequestHandle();
+    }
+
+    const CanRequestHandle handle(_nextRequestId++);
+
+    // We don't wait for the device thread: the answer is given through the handle
+    QMetaObject::invokeMethod(device,
+                              [device, handle, frame, expectedFrameMask, timeoutInMs]()
+                              {
+                                  device->sendRequest(handle,
+                                                      frame,
+                                                      expectedFrameMask,
+                                                      timeoutInMs);
+                              },
+                              Qt::QueuedConnection);
+
+    return handle;
+}
+
 QVector<QCanBusFrame> CanDeviceIntf::writeAndWaitAnswer(
     const QCanBusFrame &frame,
     const ExpectedCanFrameMask &expectedFrameMask,
@@ -329,6 +623,31 @@ QVector<QCanBusFrame> CanDeviceIntf::waitAllTheCanMsgsByIds(const QVector<quint3
                                     timeoutInMs);
 }
 
+void CanDeviceIntf::onFramesAvailable()
+{
+    if(_dispatchRing.isNull())
+    {
+        return;
+    }
+
+    // The notification is disarmed before draining, the frames pushed while draining will raise a
+    // new notification
+    _dispatchRing->disarmNotification();
+
+    QVector<QCanBusFrame> frames;
+    if(_dispatchRing->popAll(frames) == 0)
+    {
+        return;
+    }
+
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        _busMetrics->addDeliveredFrame(*citer);
+    }
+
+    emit framesReceived(frames);
+}
+
 CanDevice *CanDeviceIntf::accessDeviceThroughThread(const QString &action) const
 {
     if(!_canDeviceThread->isValid())
@@ -6,14 +6,30 @@
 
 #include <QObject>
 
+#include <atomic>
+
 #include <QCanBusFrame>
+#include <QSharedPointer>
 
 #include "src/definescan.hpp"
+#include "src/filter/canacceptancefilter.hpp"
+#include "src/gateway/cangatewayroute.hpp"
+#include "src/models/canbusevent.hpp"
 #include "src/models/candeviceconfig.hpp"
+#include "src/requests/canrequesthandle.hpp"
 
+class CanBusMetrics;
+class CanBusMetricsSnapshot;
 class CanDevice;
 class CanDeviceThread;
+class CanFrameRing;
+class CanFrameRingStats;
+class CanGateway;
+class CanGatewayStats;
+class CanRxFilter;
 class ExpectedCanFrameMask;
+class IsoTpChannelIntf;
+class IsoTpConfig;
 class QCanBusDevice;
 
 
@@ -78,6 +94,123 @@ class CAN_EXPORT CanDeviceIntf : public QObject
             @return True if no problem occurred */
         bool setParamBusOffAutoReset(bool autoReset);
 
+        /** @brief Get the statistics of the rings used to pass the received frames between
+                   threads
+            @note Those values are useful to size the rings capacity, see
+                  @ref CanDeviceConfig::setRxRingCapacity
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param readerRingStats The stats of the ring between the read thread and the device
+                                   thread
+            @param dispatchRingStats The stats of the ring between the device thread and this
+                                     interface thread
+            @return True if no problem occurred */
+        bool getRxRingsStats(CanFrameRingStats &readerRingStats,
+                             CanFrameRingStats &dispatchRingStats);
+
+        /** @brief Reset the statistics of the rings used to pass the received frames between
+                   threads
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @return True if no problem occurred */
+        bool resetRxRingsStats();
+
+        /** @brief Get the live metrics of the CAN bus: frames rates, bus load, errors and delivery
+                   latency
+            @note The method doesn't go through the device thread, it only reads atomic counters;
+                  therefore, it can be called often.
+            @note The rates and the bus load are computed since the previous call, see
+                  @ref CanBusMetricsSnapshot. To export the metrics in the process statistics, see
+                  @ref CanBusMetricsStats::update
+            @note The device has to be initialized once before calling this method
+            @param snapshot The metrics got
+            @return True if no problem occurred */
+        bool getBusMetrics(CanBusMetricsSnapshot &snapshot);
+
+        /** @brief Reset the live metrics of the CAN bus
+            @note The device has to be initialized once before calling this method
+            @return True if no problem occurred */
+        bool resetBusMetrics();
+
+        /** @brief Subscribe to the frames accepted by the filter given
+            @note If the acceptance filter is enabled in the config (see
+                  @ref CanDeviceConfig::setAcceptanceFilterEnabled), the device only receives the
+                  frames accepted by the active subscriptions, the ISO-TP channels and the pending
+                  waits and requests. The filter is updated each time a subscription is added or
+                  removed.
+            @note The filter is pushed down to the PEAK driver, as one ids range by format, and
+                  applied exactly in the read thread, before converting the frames
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param filter The filter of the subscription
+            @return The id of the subscription, 0 if a problem occurred */
+        quint64 addAcceptanceSubscription(const CanAcceptanceFilter &filter);
+
+        /** @brief Remove a subscription added with @ref addAcceptanceSubscription
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param subscriptionId The id of the subscription to remove
+            @return True if no problem occurred */
+        bool removeAcceptanceSubscription(quint64 subscriptionId);
+
+        /** @brief Get the number of frames rejected by the read thread acceptance filter
+            @note The frames rejected by the PEAK driver filter aren't counted
+            @note The method doesn't go through the device thread, it only reads an atomic counter
+            @note The device has to be initialized once before calling this method
+            @param rejectedFramesNb The number of rejected frames
+            @return True if no problem occurred */
+        bool getRejectedFramesNb(quint64 &rejectedFramesNb);
+
+        /** @brief Set the gateway routes of the device: the frames received which match a route
+                   are written on its target device, by the read thread of this device
+            @note The frames are forwarded before the acceptance filtering and without being
+                  converted; the forwarding doesn't wait for the device or the caller threads
+            @note The previous routes are replaced, give an empty list to remove all the routes
+            @note The target devices have to be created with the @ref CanManager. They have to be
+                  initialized to receive the frames, else the frames are counted as failed.
+            @note The frames written by the gateway don't go through the transmit queue of the
+                  target device, but they are counted in its bus metrics (as written frames or
+                  transmit errors). The target has to be initialized before setting the routes
+                  for its metrics to count them.
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param routes The routes to apply, when several routes match a frame, the first one
+                          is used
+            @return True if no problem occurred */
+        bool setGatewayRoutes(const QVector<CanGatewayRoute> &routes);
+
+        /** @brief Get the statistics of the gateway, with the forwarding latency
+            @note The method doesn't go through the device thread, it only reads atomic counters
+            @note The device has to be initialized once before calling this method
+            @param stats The gateway statistics
+            @return True if no problem occurred */
+        bool getGatewayStats(CanGatewayStats &stats);
+
+        /** @brief Create an ISO-TP channel on the CAN device
+            @note The segmentation and reassembly of the messages are done in the device thread
+            @note Several channels can be created on the same device, but each one has to receive
+                  its frames on its own id
+            @note The device has to be initialized before calling this method
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param config The channel config
+            @param parent The parent of the channel interface
+            @return The interface of the channel created or nullptr if a problem occurred. When
+                    the interface is deleted, the channel is removed from the device */
+        IsoTpChannelIntf *createIsoTpChannel(const IsoTpConfig &config, QObject *parent = nullptr);
+
         /** @brief Write a CAN bus frame
             @note The method is threadsafe
             @warning The method is called in another thread, it means that the event loop of the
@@ -87,6 +220,41 @@ class CAN_EXPORT CanDeviceIntf : public QObject
             @return True if no problem occurred */
         bool write(const QCanBusFrame &frame);
 
+        /** @brief Write a batch of frames through the device transmit queue
+            @note The method doesn't wait: the batch is queued in the device thread and the end of
+                  its writing is notified with @ref batchWritten. Therefore, the id returned is
+                  always known before the notification.
+            @note The frames are written in order, with the pacing configured in
+                  @ref CanDeviceConfig::getTxQueueConfig; when the driver transmit queue is full,
+                  the writing is retried.
+            @note The method is threadsafe
+            @param frames The frames to write
+            @return The id of the batch, 0 if a problem occurred */
+        quint64 writeBatch(const QVector<QCanBusFrame> &frames);
+
+        /** @brief Send a pipelined request: write a CAN bus frame and wait for its answer without
+                   blocking
+            @note The method doesn't wait: the request is added to the device pipeline and the
+                  handle returned is finished when the answer is received, when the timeout
+                  raises or when the writing fails. The end is also notified with
+                  @ref requestFinished.
+            @note Several requests can be in flight at the same time; therefore, talking to
+                  several nodes takes about one round trip instead of one by node. The number of
+                  requests in flight with the same request frame id is bounded, see
+                  @ref CanDeviceConfig::setMaxInFlightRequestsByIdNb
+            @note The answer is correlated to the request thanks to the expected frame mask: the
+                  id and, if given, the mask have to match. If several requests in flight expect
+                  the same answer, the oldest one gets it.
+            @note The method is threadsafe
+            @param frame The request frame to write
+            @param expectedFrameMask The information which describes the expected answer
+            @param timeoutInMs The request timeout, it starts when the method is called; -1 to
+                               wait forever
+            @return The handle of the request, invalid if a problem occurred */
+        CanRequestHandle sendRequest(const QCanBusFrame &frame,
+                                     const ExpectedCanFrameMask &expectedFrameMask,
+                                     int timeoutInMs);
+
         /** @brief Write a CAN bus frame and wait for an answer
             @note The method begins to listen before the writting of message; therefore, if the
                   answer is sent before the writing, you may receive this answer.
@@ -309,6 +477,27 @@ class CAN_EXPORT CanDeviceIntf : public QObject
             @param frames The received frames */
         void framesReceived(const QVector<QCanBusFrame> &frames);
 
+        /** @brief Emitted when a bus event occurred: an error frame has been received or the bus
+                   state has changed (error warning, error passive or bus off)
+            @note The error frames are only received if they are enabled in the PEAK driver
+            @param event The bus event */
+        void busEventOccurred(CanBusEvent::Enum event);
+
+        /** @brief Emitted when a batch writing is finished
+            @param batchId The id of the batch, returned by @ref writeBatch
+            @param success True if all the frames of the batch have been written */
+        void batchWritten(quint64 batchId, bool success);
+
+        /** @brief Emitted when a pipelined request is finished
+            @param requestId The id of the request, see @ref CanRequestHandle::getRequestId
+            @param success True if the request has been answered */
+        void requestFinished(quint64 requestId, bool success);
+
+    private slots:
+        /** @brief Called when frames are available in the dispatch ring of the device
+            @note The method drains the ring and emits @ref framesReceived */
+        void onFramesAvailable();
+
     private:
         /** @brief Useful method to access the @ref CanDevice contains in the @ref CanDeviceThread
             @note The method ensures the linked thread to be ready.
@@ -322,4 +511,11 @@ class CAN_EXPORT CanDeviceIntf : public QObject
         CanDeviceConfig _config;
 
         CanDeviceThread *_canDeviceThread{nullptr};
+        QSharedPointer<CanFrameRing> _dispatchRing;
+        QSharedPointer<CanBusMetrics> _busMetrics;
+        QSharedPointer<CanRxFilter> _rxFilter;
+        QSharedPointer<CanGateway> _gateway;
+        std::atomic<quint64> _nextBatchId{1};
+        std::atomic<quint64> _nextRequestId{1};
+        std::atomic<quint64> _nextSubscriptionId{1};
 };
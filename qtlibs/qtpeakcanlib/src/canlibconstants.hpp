@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+/** @brief This namespace contains the PEAK CAN lib constants */
+namespace CanLibConstants
+{
+    /** @brief The coefficients to convert the durations between the time units */
+    namespace Time
+    {
+        /** @brief The number of nanoseconds in a microsecond */
+        constexpr const qint64 MicroToNanoCoeff = 1000;
+
+        /** @brief The number of microseconds in a millisecond */
+        constexpr const qint64 MilliToMicroCoeff = 1000;
+
+        /** @brief The number of nanoseconds in a millisecond */
+        constexpr const qint64 MilliToNanoCoeff = MilliToMicroCoeff * MicroToNanoCoeff;
+
+        /** @brief The number of microseconds in a second */
+        constexpr const qint64 SecondToMicroCoeff = 1000000;
+
+        /** @brief The number of nanoseconds in a second */
+        constexpr const qint64 SecondToNanoCoeff = SecondToMicroCoeff * MicroToNanoCoeff;
+    }
+}
@@ -13,6 +13,10 @@
 #include "threadutility/concurrent/threadconcurrentrun.hpp"
 
 #include "src/candevice/candeviceintf.hpp"
+#include "src/gateway/cangatewayroute.hpp"
+#include "src/merge/canchannelframe.hpp"
+#include "src/merge/canmergedstream.hpp"
+#include "src/models/canbusevent.hpp"
 #include "src/models/candeviceconfig.hpp"
 #include "src/pcanapi/pcanapi.hpp"
 
@@ -38,6 +42,32 @@ QSharedPointer<CanDeviceIntf> CanManager::createOrGetCanIntf(const CanDeviceConf
     return ThreadConcurrentRun::run(*this, &CanManager::createOrGetCanIntfPriv, config);
 }
 
+QSharedPointer<CanMergedStream> CanManager::createMergedStream(
+    const QVector<PCanBusItf::Enum> &canIntfKeys,
+    int reorderWindowInMs)
+{
+    QSharedPointer<CanMergedStream> stream(new CanMergedStream(), &QObject::deleteLater);
+    stream->setReorderWindowInMs(reorderWindowInMs);
+
+    for(auto citer = canIntfKeys.cbegin(); citer != canIntfKeys.cend(); ++citer)
+    {
+        const QSharedPointer<CanDeviceIntf> canIntf = getCanIntf(*citer);
+        if(canIntf.isNull())
+        {
+            qWarning() << "The can interface: " << PCanBusItf::toString(*citer) << ", doesn't "
+                       << "exist, it can't be merged";
+            return {};
+        }
+
+        if(!stream->attach(canIntf))
+        {
+            return {};
+        }
+    }
+
+    return stream;
+}
+
 QSharedPointer<CanDeviceIntf> CanManager::getCanIntfPriv(PCanBusItf::Enum canIntfKey)
 {
     return getHandler(canIntfKey);
@@ -106,4 +136,9 @@ void CanManager::registerMetaTypes()
 {
     qRegisterMetaType<CanDeviceConfig>();
     qRegisterMetaType<QVector<QCanBusFrame>>("QVector<QCanBusFrame>");
+    qRegisterMetaType<CanGatewayRoute>();
+    qRegisterMetaType<QVector<CanGatewayRoute>>("QVector<CanGatewayRoute>");
+    qRegisterMetaType<CanChannelFrame>();
+    qRegisterMetaType<QVector<CanChannelFrame>>("QVector<CanChannelFrame>");
+    qRegisterMetaType<CanBusEvent::Enum>();
 }
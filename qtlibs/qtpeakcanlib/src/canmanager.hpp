@@ -14,6 +14,7 @@
 
 class CanDeviceConfig;
 class CanDeviceIntf;
+class CanMergedStream;
 
 
 /** @brief This class manages the @ref CanDeviceIntf creation and getting */
@@ -53,6 +54,19 @@ class CAN_EXPORT CanManager : public QObject,
             @return The CanDeviceIntf created or a nullptr */
         QSharedPointer<CanDeviceIntf> createOrGetCanIntf(const CanDeviceConfig &config);
 
+        /** @brief Create a stream which merges the frames received by the CAN device interfaces
+                   given, ordered by hardware timestamp
+            @note The CanDeviceIntf have to be created before in order to be merged
+            @note The stream is created in the caller thread
+            @note This method is thread safe but required an event loop in the caller method
+            @param canIntfKeys The CAN interface keys of the devices to merge
+            @param reorderWindowInMs The reorder window of the stream, see
+                                     @ref CanMergedStream::setReorderWindowInMs
+            @return The CanMergedStream created or a nullptr */
+        QSharedPointer<CanMergedStream> createMergedStream(
+            const QVector<PCanBusItf::Enum> &canIntfKeys,
+            int reorderWindowInMs = DefaultReorderWindowInMs);
+
     private:
         /** @brief Get a @ref CanDeviceIntf thanks to its CAN interface key
             @note The CanDeviceIntf has to be created before in order to be got by this method
@@ -94,6 +108,9 @@ class CAN_EXPORT CanManager : public QObject,
         /** @brief This is the timeout used for the mutex try lock */
         static const constexpr int MutexTimeoutInMs = 1000;
 
+        /** @brief The default reorder window of the merged streams */
+        static const constexpr int DefaultReorderWindowInMs = 20;
+
     private:
         static CanManager *_instance;
 };
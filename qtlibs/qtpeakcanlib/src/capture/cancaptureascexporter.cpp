@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancaptureascexporter.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QFile>
+#include <QLocale>
+#include <QTextStream>
+
+#include "definesutility/definesutility.hpp"
+
+#include "src/canlibconstants.hpp"
+#include "src/capture/cancapturereader.hpp"
+#include "src/pcanapi/pcanframedlc.hpp"
+
+
+CanCaptureAscExporter::CanCaptureAscExporter()
+{
+}
+
+bool CanCaptureAscExporter::exportToAsc(const QStringList &captureFilesPaths,
+                                        const QString &ascFilePath)
+{
+    if(captureFilesPaths.isEmpty())
+    {
+        qWarning() << "There is no CAN capture file to export in ASC";
+        return false;
+    }
+
+    QFile ascFile(ascFilePath);
+    if(!ascFile.open(QIODevice::WriteOnly | QIODevice::Truncate | QIODevice::Text))
+    {
+        qWarning() << "A problem occurred when tried to open the ASC file: " << ascFilePath
+                   << ", error: " << ascFile.errorString();
+        return false;
+    }
+
+    QTextStream stream(&ascFile);
+    CanCaptureReader reader;
+    QHash<PCanBusItf::Enum, int> channelsNb;
+    bool firstFrameFound = false;
+    quint64 firstTimestampInUs = 0;
+
+    for(auto fileIter = captureFilesPaths.cbegin();
+        fileIter != captureFilesPaths.cend();
+        ++fileIter)
+    {
+        RETURN_IF_FALSE(reader.open(*fileIter));
+
+        if(fileIter == captureFilesPaths.cbegin())
+        {
+            const QString date = QLocale::c().toString(
+                QDateTime::fromMSecsSinceEpoch(reader.getStartDateTimeInMs()), DateFormat);
+
+            stream << "date " << date << "\n"
+                   << "base hex  timestamps absolute\n"
+                   << "internal events logged\n"
+                   << "Begin Triggerblock " << date << "\n"
+                   << "   0.000000 Start of measurement\n";
+        }
+
+        while(!reader.atEnd())
+        {
+            QVector<CanCaptureFormat::CapturedFrame> frames;
+            RETURN_IF_FALSE(reader.readNextChunk(frames));
+
+            for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+            {
+                const quint64 timestampInUs = CanCaptureFormat::getTimestampInUs(citer->frame);
+
+                if(!firstFrameFound)
+                {
+                    firstTimestampInUs = timestampInUs;
+                    firstFrameFound = true;
+                }
+
+                if(!channelsNb.contains(citer->channel))
+                {
+                    const int channelNb = channelsNb.count() + 1;
+                    channelsNb.insert(citer->channel, channelNb);
+                    stream << "// channel " << channelNb << ": "
+                           << PCanBusItf::toString(citer->channel) << "\n";
+                }
+
+                writeFrame(*citer,
+                           channelsNb.value(citer->channel),
+                           (timestampInUs >= firstTimestampInUs) ?
+                               (timestampInUs - firstTimestampInUs) : 0,
+                           stream);
+            }
+        }
+    }
+
+    stream << "End TriggerBlock\n";
+    stream.flush();
+
+    if(stream.status() != QTextStream::Ok)
+    {
+        qWarning() << "A problem occurred when tried to write the ASC file: " << ascFilePath;
+        return false;
+    }
+
+    return true;
+}
+
+void CanCaptureAscExporter::writeFrame(const CanCaptureFormat::CapturedFrame &capturedFrame,
+                                       int channelNb,
+                                       quint64 relativeTimestampInUs,
+                                       QTextStream &stream)
+{
+    const QCanBusFrame &frame = capturedFrame.frame;
+
+    const quint64 secondToMicroCoeff = CanLibConstants::Time::SecondToMicroCoeff;
+    const QString time = QString("%1.%2").arg(relativeTimestampInUs / secondToMicroCoeff, 4)
+                                         .arg(relativeTimestampInUs % secondToMicroCoeff, 6, 10,
+                                              QChar('0'));
+
+    if(frame.frameType() == QCanBusFrame::ErrorFrame)
+    {
+        stream << time << " " << channelNb << "  ErrorFrame\n";
+        return;
+    }
+
+    QString id = QString::number(frame.frameId(), 16).toUpper();
+    if(frame.hasExtendedFrameFormat())
+    {
+        id.append('x');
+    }
+
+    const QByteArray payload = frame.payload();
+    const QString data = QString::fromLatin1(payload.toHex(' ').toUpper());
+
+    if(frame.hasFlexibleDataRateFormat())
+    {
+        quint32 flags = FdEdlFlag;
+        if(frame.hasBitrateSwitch())
+        {
+            flags |= FdBrsFlag;
+        }
+
+        if(frame.hasErrorStateIndicator())
+        {
+            flags |= FdEsiFlag;
+        }
+
+        const PCanFrameDlc::Enum dlc = PCanFrameDlc::parseFromSize(payload.size());
+
+        stream << time << " CANFD " << QString::number(channelNb).rightJustified(3) << " Rx "
+               << id.rightJustified(12) << "  " << (frame.hasBitrateSwitch() ? 1 : 0) << " "
+               << (frame.hasErrorStateIndicator() ? 1 : 0) << " "
+               << QString::number(PCanFrameDlc::toByte(dlc), 16) << " "
+               << QString::number(payload.size()).rightJustified(2) << " " << data
+               << " 0 0 " << QString::number(flags, 16) << " 0 0 0 0 0\n";
+        return;
+    }
+
+    stream << time << " " << channelNb << "  " << id.leftJustified(15) << " Rx   ";
+
+    if(frame.frameType() == QCanBusFrame::RemoteRequestFrame)
+    {
+        stream << "r\n";
+        return;
+    }
+
+    stream << "d " << payload.size();
+    if(!data.isEmpty())
+    {
+        stream << " " << data;
+    }
+
+    stream << "\n";
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QHash>
+#include <QStringList>
+
+#include "src/capture/cancaptureformat.hpp"
+#include "src/definescan.hpp"
+
+class QTextStream;
+
+
+/** @brief This class exports the CAN capture files to the ASC text format (from Vector), which
+           can be read by the most common CAN analysis tools
+    @note The CAN bus interfaces are numbered in the order of their first appearance in the
+          capture, the matching is written in comments at the beginning of the file */
+class CAN_EXPORT CanCaptureAscExporter
+{
+    private:
+        /** @brief Private class constructor */
+        explicit CanCaptureAscExporter();
+
+    public:
+        /** @brief Export the capture files given to an ASC file
+            @note The timestamps are written relatively to the first frame of the first file
+            @param captureFilesPaths The capture files to export, in order of recording
+            @param ascFilePath The path of the ASC file to write
+            @return True if no problem occurred */
+        static bool exportToAsc(const QStringList &captureFilesPaths, const QString &ascFilePath);
+
+    private:
+        /** @brief Write a captured frame in the ASC format
+            @param capturedFrame The frame to write
+            @param channelNb The ASC channel number of the frame
+            @param relativeTimestampInUs The frame timestamp, relatively to the first frame
+            @param stream The stream where to write the line */
+        static void writeFrame(const CanCaptureFormat::CapturedFrame &capturedFrame,
+                               int channelNb,
+                               quint64 relativeTimestampInUs,
+                               QTextStream &stream);
+
+    private:
+        /** @brief The date format used in the ASC header */
+        static const constexpr char* DateFormat = "ddd MMM dd hh:mm:ss.zzz ap yyyy";
+
+        /** @brief The ASC flag for the FD frames (extended data length) */
+        static const constexpr quint32 FdEdlFlag = 0x1000;
+
+        /** @brief The ASC flag for the FD frames with bitrate switch */
+        static const constexpr quint32 FdBrsFlag = 0x2000;
+
+        /** @brief The ASC flag for the FD frames with error state indicator */
+        static const constexpr quint32 FdEsiFlag = 0x4000;
+};
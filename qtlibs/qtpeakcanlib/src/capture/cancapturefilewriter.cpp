@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturefilewriter.hpp"
+
+#include <QDebug>
+#include <QFile>
+
+#include "src/capture/cancapturereader.hpp"
+
+
+CanCaptureFileWriter::CanCaptureFileWriter(QObject *parent)
+    : QObject{parent}
+{
+}
+
+bool CanCaptureFileWriter::writeCaptureFile(const QString &filePath,
+                                            const QByteArray &records,
+                                            const CanCaptureFormat::ChunkHeader &chunkHeader,
+                                            qint64 startDateTimeInMs)
+{
+    QFile captureFile(filePath);
+    QFile indexFile(CanCaptureReader::getIndexFilePath(filePath));
+
+    if(!captureFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+       !indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "A problem occurred when tried to open the CAN capture file: " << filePath
+                   << ", error: " << captureFile.errorString() << ", index error: "
+                   << indexFile.errorString();
+        emit captureFileWritten(filePath, false);
+        return false;
+    }
+
+    CanCaptureFormat::ChunkHeader header = chunkHeader;
+    header.recordsSize = static_cast<quint32>(records.size());
+    header.fileOffset = CanCaptureFormat::FileHeaderSize;
+
+    const QByteArray fileHeader = CanCaptureFormat::buildFileHeader(startDateTimeInMs);
+    const QByteArray indexFileHeader = CanCaptureFormat::buildIndexFileHeader(startDateTimeInMs);
+    const QByteArray chunkHeaderData = CanCaptureFormat::buildChunkHeader(header);
+    const QByteArray indexEntry = CanCaptureFormat::buildIndexEntry(header);
+
+    const bool success = (captureFile.write(fileHeader) == fileHeader.size()) &&
+                         (captureFile.write(chunkHeaderData) == chunkHeaderData.size()) &&
+                         (captureFile.write(records) == records.size()) &&
+                         (indexFile.write(indexFileHeader) == indexFileHeader.size()) &&
+                         (indexFile.write(indexEntry) == indexEntry.size());
+
+    if(!success)
+    {
+        qWarning() << "A problem occurred when tried to write the CAN capture file: " << filePath
+                   << ", error: " << captureFile.errorString() << ", index error: "
+                   << indexFile.errorString();
+    }
+
+    captureFile.close();
+    indexFile.close();
+
+    emit captureFileWritten(filePath, success);
+    return success;
+}
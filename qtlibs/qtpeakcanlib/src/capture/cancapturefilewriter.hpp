@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "src/capture/cancaptureformat.hpp"
+
+
+/** @brief This class writes whole capture files, made of one chunk, and their index files
+    @note The writer is used by the @ref CanTriggerCapture, in a dedicated thread, to not block
+          the capture while the files are written */
+class CanCaptureFileWriter : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit CanCaptureFileWriter(QObject *parent = nullptr);
+
+    public:
+        /** @brief Write a capture file made of the records given, and its index file
+            @param filePath The path of the capture file to write
+            @param records The records of the capture file, see @ref CanCaptureFormat
+            @param chunkHeader The header of the chunk containing the records; the file offset is
+                               set by the method
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return True if no problem occurred */
+        bool writeCaptureFile(const QString &filePath,
+                              const QByteArray &records,
+                              const CanCaptureFormat::ChunkHeader &chunkHeader,
+                              qint64 startDateTimeInMs);
+
+    signals:
+        /** @brief Emitted when a capture file has been written
+            @param filePath The path of the capture file
+            @param success True if no problem occurred */
+        void captureFileWritten(const QString &filePath, bool success);
+};
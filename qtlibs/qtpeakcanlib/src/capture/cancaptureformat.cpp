@@ -0,0 +1,255 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancaptureformat.hpp"
+
+#include <cstring>
+
+#include <QDebug>
+#include <QtEndian>
+
+
+CanCaptureFormat::CanCaptureFormat()
+{
+}
+
+QByteArray CanCaptureFormat::buildFileHeader(qint64 startDateTimeInMs)
+{
+    return buildHeader(FileMagic, startDateTimeInMs);
+}
+
+QByteArray CanCaptureFormat::buildIndexFileHeader(qint64 startDateTimeInMs)
+{
+    return buildHeader(IndexFileMagic, startDateTimeInMs);
+}
+
+bool CanCaptureFormat::parseFileHeader(const QByteArray &data, qint64 &startDateTimeInMs)
+{
+    return parseHeader(data, FileMagic, startDateTimeInMs);
+}
+
+bool CanCaptureFormat::parseIndexFileHeader(const QByteArray &data, qint64 &startDateTimeInMs)
+{
+    return parseHeader(data, IndexFileMagic, startDateTimeInMs);
+}
+
+QByteArray CanCaptureFormat::buildChunkHeader(const ChunkHeader &header)
+{
+    QByteArray data(ChunkHeaderSize, Qt::Uninitialized);
+    char *raw = data.data();
+
+    qToLittleEndian<quint32>(ChunkMagic, raw);
+    qToLittleEndian<quint32>(header.framesNb, raw + 4);
+    qToLittleEndian<quint32>(header.recordsSize, raw + 8);
+    qToLittleEndian<quint64>(header.firstTimestampInUs, raw + 12);
+    qToLittleEndian<quint64>(header.lastTimestampInUs, raw + 20);
+
+    return data;
+}
+
+bool CanCaptureFormat::parseChunkHeader(const QByteArray &data, ChunkHeader &header)
+{
+    if(data.size() < ChunkHeaderSize)
+    {
+        qWarning() << "The chunk header is truncated, we can't parse it";
+        return false;
+    }
+
+    const char *raw = data.constData();
+
+    if(qFromLittleEndian<quint32>(raw) != ChunkMagic)
+    {
+        qWarning() << "The chunk header magic isn't the one expected, the capture file may be "
+                   << "corrupted";
+        return false;
+    }
+
+    header.framesNb = qFromLittleEndian<quint32>(raw + 4);
+    header.recordsSize = qFromLittleEndian<quint32>(raw + 8);
+    header.firstTimestampInUs = qFromLittleEndian<quint64>(raw + 12);
+    header.lastTimestampInUs = qFromLittleEndian<quint64>(raw + 20);
+
+    return true;
+}
+
+QByteArray CanCaptureFormat::buildIndexEntry(const ChunkHeader &entry)
+{
+    QByteArray data(IndexEntrySize, Qt::Uninitialized);
+    char *raw = data.data();
+
+    qToLittleEndian<quint64>(entry.fileOffset, raw);
+    qToLittleEndian<quint32>(entry.framesNb, raw + 8);
+    qToLittleEndian<quint64>(entry.firstTimestampInUs, raw + 12);
+    qToLittleEndian<quint64>(entry.lastTimestampInUs, raw + 20);
+
+    return data;
+}
+
+bool CanCaptureFormat::parseIndexEntry(const QByteArray &data, ChunkHeader &entry)
+{
+    if(data.size() < IndexEntrySize)
+    {
+        qWarning() << "The index entry is truncated, we can't parse it";
+        return false;
+    }
+
+    const char *raw = data.constData();
+
+    entry.fileOffset = qFromLittleEndian<quint64>(raw);
+    entry.framesNb = qFromLittleEndian<quint32>(raw + 8);
+    entry.firstTimestampInUs = qFromLittleEndian<quint64>(raw + 12);
+    entry.lastTimestampInUs = qFromLittleEndian<quint64>(raw + 20);
+
+    return true;
+}
+
+void CanCaptureFormat::appendRecord(PCanBusItf::Enum channel,
+                                    const QCanBusFrame &frame,
+                                    QByteArray &buffer)
+{
+    const int recordOffset = buffer.size();
+
+    buffer.resize(recordOffset + getRecordSize(frame));
+    writeRecord(channel, frame, buffer.data() + recordOffset);
+}
+
+int CanCaptureFormat::writeRecord(PCanBusItf::Enum channel, const QCanBusFrame &frame, char *raw)
+{
+    const QByteArray payload = frame.payload();
+
+    quint8 flags = 0;
+    if(frame.hasExtendedFrameFormat())
+    {
+        flags |= ExtendedFlag;
+    }
+
+    if(frame.hasFlexibleDataRateFormat())
+    {
+        flags |= FdFlag;
+    }
+
+    if(frame.hasBitrateSwitch())
+    {
+        flags |= BrsFlag;
+    }
+
+    if(frame.hasErrorStateIndicator())
+    {
+        flags |= EsiFlag;
+    }
+
+    if(frame.frameType() == QCanBusFrame::RemoteRequestFrame)
+    {
+        flags |= RtrFlag;
+    }
+    else if(frame.frameType() == QCanBusFrame::ErrorFrame)
+    {
+        flags |= ErrorFlag;
+    }
+
+    qToLittleEndian<quint64>(getTimestampInUs(frame), raw);
+    qToLittleEndian<quint32>(frame.frameId(), raw + 8);
+    raw[12] = static_cast<char>(flags);
+    raw[13] = static_cast<char>(channel);
+    raw[14] = static_cast<char>(payload.size());
+
+    memcpy(raw + RecordHeaderSize, payload.constData(), static_cast<size_t>(payload.size()));
+
+    return RecordHeaderSize + payload.size();
+}
+
+bool CanCaptureFormat::parseRecord(const QByteArray &buffer,
+                                   int &offset,
+                                   CapturedFrame &capturedFrame)
+{
+    if(buffer.size() < (offset + RecordHeaderSize))
+    {
+        qWarning() << "The record header is truncated, we can't parse it";
+        return false;
+    }
+
+    const char *raw = buffer.constData() + offset;
+    const int length = static_cast<quint8>(raw[14]);
+
+    if(buffer.size() < (offset + RecordHeaderSize + length))
+    {
+        qWarning() << "The record payload is truncated, we can't parse it";
+        return false;
+    }
+
+    const quint64 timestampInUs = qFromLittleEndian<quint64>(raw);
+    const quint32 frameId = qFromLittleEndian<quint32>(raw + 8);
+    const quint8 flags = static_cast<quint8>(raw[12]);
+    const quint8 channel = static_cast<quint8>(raw[13]);
+
+    QCanBusFrame &frame = capturedFrame.frame;
+    frame = QCanBusFrame(frameId, QByteArray(raw + RecordHeaderSize, length));
+    frame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(
+                                                            static_cast<qint64>(timestampInUs)));
+    frame.setExtendedFrameFormat(flags & ExtendedFlag);
+    frame.setFlexibleDataRateFormat(flags & FdFlag);
+    frame.setBitrateSwitch(flags & BrsFlag);
+    frame.setErrorStateIndicator(flags & EsiFlag);
+
+    if(flags & RtrFlag)
+    {
+        frame.setFrameType(QCanBusFrame::RemoteRequestFrame);
+    }
+    else if(flags & ErrorFlag)
+    {
+        frame.setFrameType(QCanBusFrame::ErrorFrame);
+    }
+
+    capturedFrame.channel = PCanBusItf::parseFromUShort(channel);
+
+    offset += RecordHeaderSize + length;
+    return true;
+}
+
+quint64 CanCaptureFormat::getTimestampInUs(const QCanBusFrame &frame)
+{
+    const QCanBusFrame::TimeStamp timeStamp = frame.timeStamp();
+    return static_cast<quint64>((timeStamp.seconds() * 1000000) + timeStamp.microSeconds());
+}
+
+QByteArray CanCaptureFormat::buildHeader(quint32 magic, qint64 startDateTimeInMs)
+{
+    QByteArray data(FileHeaderSize, '\0');
+    char *raw = data.data();
+
+    qToLittleEndian<quint32>(magic, raw);
+    qToLittleEndian<quint16>(FormatVersion, raw + 4);
+    qToLittleEndian<qint64>(startDateTimeInMs, raw + 8);
+
+    return data;
+}
+
+bool CanCaptureFormat::parseHeader(const QByteArray &data,
+                                   quint32 expectedMagic,
+                                   qint64 &startDateTimeInMs)
+{
+    if(data.size() < FileHeaderSize)
+    {
+        qWarning() << "The capture file header is truncated, we can't parse it";
+        return false;
+    }
+
+    const char *raw = data.constData();
+
+    if(qFromLittleEndian<quint32>(raw) != expectedMagic)
+    {
+        qWarning() << "The file magic isn't the one expected, this isn't a CAN capture file";
+        return false;
+    }
+
+    const quint16 version = qFromLittleEndian<quint16>(raw + 4);
+    if(version != FormatVersion)
+    {
+        qWarning() << "The CAN capture file version: " << version << ", isn't supported";
+        return false;
+    }
+
+    startDateTimeInMs = qFromLittleEndian<qint64>(raw + 8);
+    return true;
+}
@@ -0,0 +1,216 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+#include <QCanBusFrame>
+
+#include "src/definescan.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+
+
+/** @brief This class describes the binary format of the CAN capture files and contains the
+           methods to encode and decode its elements
+    @note A capture file contains a file header followed by chunks. Each chunk has a header and
+          contains a list of records, one record by frame. All the numbers are little endian.
+          - File header: magic (u32), version (u16), reserved (u16), start date time in ms since
+            epoch (i64)
+          - Chunk header: magic (u32), frames number (u32), records size in bytes (u32), first
+            frame timestamp in us (u64), last frame timestamp in us (u64)
+          - Record: timestamp in us (u64), frame id (u32), flags (u8), channel (u8), payload
+            length (u8), payload
+    @note An index file is written alongside each capture file. It contains a file header (with
+          a different magic) followed by one entry for each chunk: chunk offset in the capture
+          file (u64), frames number (u32), first frame timestamp in us (u64), last frame
+          timestamp in us (u64) */
+class CAN_EXPORT CanCaptureFormat
+{
+    private:
+        /** @brief Private class constructor */
+        explicit CanCaptureFormat();
+
+    public:
+        /** @brief This is a frame read from a capture file, with the channel it has been received
+                   from */
+        struct CapturedFrame
+        {
+            /** @brief The CAN bus interface where the frame has been received */
+            PCanBusItf::Enum channel{PCanBusItf::Unknown};
+
+            /** @brief The captured frame, with its hardware timestamp */
+            QCanBusFrame frame{};
+        };
+
+        /** @brief This is the header of a chunk, or an entry of the index file */
+        struct ChunkHeader
+        {
+            /** @brief The number of frames contained in the chunk */
+            quint32 framesNb{0};
+
+            /** @brief The size of the chunk records in bytes (the chunk header isn't included) */
+            quint32 recordsSize{0};
+
+            /** @brief The timestamp of the first frame of the chunk, in us */
+            quint64 firstTimestampInUs{0};
+
+            /** @brief The timestamp of the last frame of the chunk, in us */
+            quint64 lastTimestampInUs{0};
+
+            /** @brief The offset of the chunk in the capture file
+                @note This is only used in the index file */
+            quint64 fileOffset{0};
+        };
+
+    public:
+        /** @brief Build the header of a capture file
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return The header built */
+        static QByteArray buildFileHeader(qint64 startDateTimeInMs);
+
+        /** @brief Build the header of an index file
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return The header built */
+        static QByteArray buildIndexFileHeader(qint64 startDateTimeInMs);
+
+        /** @brief Parse the header of a capture file
+            @param data The data to parse, it has to contain at least @ref FileHeaderSize bytes
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return True if no problem occurred */
+        static bool parseFileHeader(const QByteArray &data, qint64 &startDateTimeInMs);
+
+        /** @brief Parse the header of an index file
+            @param data The data to parse, it has to contain at least @ref FileHeaderSize bytes
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return True if no problem occurred */
+        static bool parseIndexFileHeader(const QByteArray &data, qint64 &startDateTimeInMs);
+
+        /** @brief Build a chunk header
+            @param header The chunk header information
+            @return The header built */
+        static QByteArray buildChunkHeader(const ChunkHeader &header);
+
+        /** @brief Parse a chunk header
+            @param data The data to parse, it has to contain at least @ref ChunkHeaderSize bytes
+            @param header The chunk header parsed
+            @return True if no problem occurred */
+        static bool parseChunkHeader(const QByteArray &data, ChunkHeader &header);
+
+        /** @brief Build an index entry
+            @param entry The index entry information
+            @return The entry built */
+        static QByteArray buildIndexEntry(const ChunkHeader &entry);
+
+        /** @brief Parse an index entry
+            @param data The data to parse, it has to contain at least @ref IndexEntrySize bytes
+            @param entry The index entry parsed
+            @return True if no problem occurred */
+        static bool parseIndexEntry(const QByteArray &data, ChunkHeader &entry);
+
+        /** @brief Append the record of a frame to the buffer given
+            @param channel The CAN bus interface where the frame has been received
+            @param frame The frame to record
+            @param buffer The buffer where the record is appended */
+        static void appendRecord(PCanBusItf::Enum channel,
+                                 const QCanBusFrame &frame,
+                                 QByteArray &buffer);
+
+        /** @brief Write the record of a frame at the position given
+            @note The position has to be able to contain @ref getRecordSize bytes
+            @param channel The CAN bus interface where the frame has been received
+            @param frame The frame to record
+            @param raw The position where the record is written
+            @return The size of the record written */
+        static int writeRecord(PCanBusItf::Enum channel, const QCanBusFrame &frame, char *raw);
+
+        /** @brief Get the size of the record of a frame
+            @param frame The frame to record
+            @return The record size */
+        static int getRecordSize(const QCanBusFrame &frame)
+        { return RecordHeaderSize + frame.payload().size(); }
+
+        /** @brief Parse a record from the buffer given
+            @param buffer The buffer which contains the records
+            @param offset The offset of the record in the buffer, it's updated to the offset of the
+                          next record
+            @param capturedFrame The frame parsed
+            @return True if no problem occurred */
+        static bool parseRecord(const QByteArray &buffer,
+                                int &offset,
+                                CapturedFrame &capturedFrame);
+
+        /** @brief Get the timestamp of the frame given, in us
+            @param frame The frame to get the timestamp from
+            @return The frame timestamp in us */
+        static quint64 getTimestampInUs(const QCanBusFrame &frame);
+
+    public:
+        /** @brief The extension of the capture files */
+        static const constexpr char* FileExtension = "cancap";
+
+        /** @brief The extension of the index files */
+        static const constexpr char* IndexFileExtension = "cancapidx";
+
+        /** @brief The size of the capture and index files headers */
+        static const constexpr int FileHeaderSize = 16;
+
+        /** @brief The size of a chunk header */
+        static const constexpr int ChunkHeaderSize = 28;
+
+        /** @brief The size of an index entry */
+        static const constexpr int IndexEntrySize = 28;
+
+        /** @brief The size of a record without its payload */
+        static const constexpr int RecordHeaderSize = 15;
+
+        /** @brief The max size of a record, with a CAN FD payload of 64 bytes */
+        static const constexpr int MaxRecordSize = RecordHeaderSize + 64;
+
+    private:
+        /** @brief Build the header of a capture or index file
+            @param magic The magic of the file
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return The header built */
+        static QByteArray buildHeader(quint32 magic, qint64 startDateTimeInMs);
+
+        /** @brief Parse the header of a capture or index file
+            @param data The data to parse
+            @param expectedMagic The expected magic of the file
+            @param startDateTimeInMs The date time of the capture start, in ms since epoch
+            @return True if no problem occurred */
+        static bool parseHeader(const QByteArray &data,
+                                quint32 expectedMagic,
+                                qint64 &startDateTimeInMs);
+
+    private:
+        /** @brief The magic of the capture files: "ACAP" */
+        static const constexpr quint32 FileMagic = 0x50414341;
+
+        /** @brief The magic of the index files: "AIDX" */
+        static const constexpr quint32 IndexFileMagic = 0x58444941;
+
+        /** @brief The magic of the chunks: "CHNK" */
+        static const constexpr quint32 ChunkMagic = 0x4B4E4843;
+
+        /** @brief The current version of the format */
+        static const constexpr quint16 FormatVersion = 1;
+
+        /** @brief The record flag for the extended frames */
+        static const constexpr quint8 ExtendedFlag = 0x01;
+
+        /** @brief The record flag for the FD frames */
+        static const constexpr quint8 FdFlag = 0x02;
+
+        /** @brief The record flag for the FD frames with bitrate switch */
+        static const constexpr quint8 BrsFlag = 0x04;
+
+        /** @brief The record flag for the FD frames with error state indicator */
+        static const constexpr quint8 EsiFlag = 0x08;
+
+        /** @brief The record flag for the remote request frames */
+        static const constexpr quint8 RtrFlag = 0x10;
+
+        /** @brief The record flag for the error frames */
+        static const constexpr quint8 ErrorFlag = 0x20;
+};
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturereader.hpp"
+
+#include <QDebug>
+#include <QDir>
+#include <QFileInfo>
+
+#include "definesutility/definesutility.hpp"
+
+
+CanCaptureReader::CanCaptureReader()
+{
+}
+
+CanCaptureReader::~CanCaptureReader()
+{
+    close();
+}
+
+bool CanCaptureReader::open(const QString &filePath)
+{
+    close();
+
+    _file.setFileName(filePath);
+
+    if(!_file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "A problem occurred when tried to open the CAN capture file: " << filePath
+                   << ", error: " << _file.errorString();
+        return false;
+    }
+
+    if(!CanCaptureFormat::parseFileHeader(_file.read(CanCaptureFormat::FileHeaderSize),
+                                          _startDateTimeInMs))
+    {
+        qWarning() << "The file: " << filePath << ", isn't a valid CAN capture file";
+        close();
+        return false;
+    }
+
+    return true;
+}
+
+void CanCaptureReader::close()
+{
+    if(_file.isOpen())
+    {
+        _file.close();
+    }
+
+    _startDateTimeInMs = 0;
+}
+
+bool CanCaptureReader::readNextChunk(QVector<CanCaptureFormat::CapturedFrame> &frames)
+{
+    if(!_file.isOpen())
+    {
+        qWarning() << "Can't read the next chunk, no CAN capture file is opened";
+        return false;
+    }
+
+    if(_file.atEnd())
+    {
+        // Nothing more to read
+        return true;
+    }
+
+    CanCaptureFormat::ChunkHeader header;
+    const QByteArray headerData = _file.read(CanCaptureFormat::ChunkHeaderSize);
+    RETURN_IF_FALSE(CanCaptureFormat::parseChunkHeader(headerData, header));
+
+    const QByteArray records = _file.read(header.recordsSize);
+    if(records.size() != static_cast<int>(header.recordsSize))
+    {
+        qWarning() << "The last chunk of the CAN capture file: " << _file.fileName()
+                   << ", is truncated; the capture may have been interrupted";
+        return false;
+    }
+
+    frames.reserve(frames.size() + static_cast<int>(header.framesNb));
+
+    int offset = 0;
+    CanCaptureFormat::CapturedFrame capturedFrame;
+    for(quint32 idx = 0; idx < header.framesNb; ++idx)
+    {
+        RETURN_IF_FALSE(CanCaptureFormat::parseRecord(records, offset, capturedFrame));
+        frames.append(capturedFrame);
+    }
+
+    return true;
+}
+
+bool CanCaptureReader::seekToTimestamp(quint64 timestampInUs)
+{
+    if(!_file.isOpen())
+    {
+        qWarning() << "Can't seek to timestamp, no CAN capture file is opened";
+        return false;
+    }
+
+    QVector<CanCaptureFormat::ChunkHeader> indexEntries;
+    if(loadIndex(indexEntries))
+    {
+        for(auto citer = indexEntries.cbegin(); citer != indexEntries.cend(); ++citer)
+        {
+            if(citer->lastTimestampInUs >= timestampInUs)
+            {
+                return _file.seek(static_cast<qint64>(citer->fileOffset));
+            }
+        }
+
+        return _file.seek(_file.size());
+    }
+
+    // No index, we go through the chunks headers
+    RETURN_IF_FALSE(_file.seek(CanCaptureFormat::FileHeaderSize));
+
+    while(!_file.atEnd())
+    {
+        const qint64 chunkOffset = _file.pos();
+
+        CanCaptureFormat::ChunkHeader header;
+        const QByteArray headerData = _file.read(CanCaptureFormat::ChunkHeaderSize);
+        RETURN_IF_FALSE(CanCaptureFormat::parseChunkHeader(headerData, header));
+
+        if(header.lastTimestampInUs >= timestampInUs)
+        {
+            return _file.seek(chunkOffset);
+        }
+
+        RETURN_IF_FALSE(_file.seek(_file.pos() + header.recordsSize));
+    }
+
+    return true;
+}
+
+QStringList CanCaptureReader::findCaptureFiles(const QString &basePath)
+{
+    const QFileInfo baseInfo(basePath);
+    const QDir dir = baseInfo.absoluteDir();
+
+    const QString nameFilter = QString("%1_*.%2").arg(baseInfo.fileName(),
+                                                       CanCaptureFormat::FileExtension);
+
+    QStringList filesPaths;
+    const QStringList fileNames = dir.entryList({ nameFilter }, QDir::Files, QDir::Name);
+    for(auto citer = fileNames.cbegin(); citer != fileNames.cend(); ++citer)
+    {
+        filesPaths.append(dir.absoluteFilePath(*citer));
+    }
+
+    return filesPaths;
+}
+
+QString CanCaptureReader::getIndexFilePath(const QString &captureFilePath)
+{
+    const QFileInfo captureInfo(captureFilePath);
+    return captureInfo.absoluteDir().absoluteFilePath(
+        QString("%1.%2").arg(captureInfo.completeBaseName(), CanCaptureFormat::IndexFileExtension));
+}
+
+bool CanCaptureReader::loadIndex(QVector<CanCaptureFormat::ChunkHeader> &indexEntries) const
+{
+    QFile indexFile(getIndexFilePath(_file.fileName()));
+
+    if(!indexFile.exists() || !indexFile.open(QIODevice::ReadOnly))
+    {
+        return false;
+    }
+
+    qint64 startDateTimeInMs = 0;
+    const QByteArray headerData = indexFile.read(CanCaptureFormat::FileHeaderSize);
+    RETURN_IF_FALSE(CanCaptureFormat::parseIndexFileHeader(headerData, startDateTimeInMs));
+
+    while(!indexFile.atEnd())
+    {
+        CanCaptureFormat::ChunkHeader entry;
+        const QByteArray entryData = indexFile.read(CanCaptureFormat::IndexEntrySize);
+        RETURN_IF_FALSE(CanCaptureFormat::parseIndexEntry(entryData, entry));
+        indexEntries.append(entry);
+    }
+
+    return true;
+}
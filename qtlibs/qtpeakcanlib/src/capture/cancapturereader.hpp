@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QFile>
+#include <QVector>
+
+#include "src/capture/cancaptureformat.hpp"
+#include "src/definescan.hpp"
+
+
+/** @brief This class reads the CAN capture files, chunk by chunk
+    @note The file is streamed: only one chunk is loaded in memory at a time
+    @see CanCaptureFormat */
+class CAN_EXPORT CanCaptureReader
+{
+    public:
+        /** @brief Class constructor */
+        explicit CanCaptureReader();
+
+        /** @brief Class destructor */
+        virtual ~CanCaptureReader();
+
+    public:
+        /** @brief Open the capture file given and read its header
+            @note If a file is already opened, it's closed before
+            @param filePath The path of the capture file to open
+            @return True if no problem occurred */
+        bool open(const QString &filePath);
+
+        /** @brief Close the capture file */
+        void close();
+
+        /** @brief Test if a capture file is opened */
+        bool isOpen() const { return _file.isOpen(); }
+
+        /** @brief Test if all the chunks of the capture file have been read */
+        bool atEnd() const { return _file.atEnd(); }
+
+        /** @brief Get the date time of the capture start, in ms since epoch */
+        qint64 getStartDateTimeInMs() const { return _startDateTimeInMs; }
+
+        /** @brief Read the next chunk of the capture file
+            @param frames The frames of the chunk are appended to this vector
+            @return True if no problem occurred */
+        bool readNextChunk(QVector<CanCaptureFormat::CapturedFrame> &frames);
+
+        /** @brief Move the reading position to the first chunk which contains frames received at,
+                   or after, the timestamp given
+            @note The method uses the index file linked to the capture file, if it doesn't exist
+                  the chunks headers are read one by one
+            @param timestampInUs The timestamp to seek
+            @return True if no problem occurred */
+        bool seekToTimestamp(quint64 timestampInUs);
+
+    public:
+        /** @brief Find the capture files generated from the base path given, when the recorder
+                   has rotated files
+            @param basePath The base path given to the recorder
+            @return The capture files paths sorted by order of recording */
+        static QStringList findCaptureFiles(const QString &basePath);
+
+        /** @brief Get the path of the index file linked to the capture file given
+            @param captureFilePath The path of the capture file
+            @return The index file path */
+        static QString getIndexFilePath(const QString &captureFilePath);
+
+    private:
+        /** @brief Load the index file linked to the current capture file
+            @param indexEntries The entries read from the index file
+            @return True if no problem occurred */
+        bool loadIndex(QVector<CanCaptureFormat::ChunkHeader> &indexEntries) const;
+
+    private:
+        QFile _file;
+        qint64 _startDateTimeInMs{0};
+};
@@ -0,0 +1,292 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturerecorder.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QTimer>
+
+#include "definesutility/definesutility.hpp"
+
+#include "src/candevice/candeviceintf.hpp"
+#include "src/canlibconstants.hpp"
+#include "src/capture/cancapturereader.hpp"
+
+
+CanCaptureRecorder::CanCaptureRecorder(QObject *parent)
+    : QObject{parent},
+    _flushTimer{new QTimer(this)}
+{
+    _flushTimer->setInterval(_flushIntervalInMs);
+    connect(_flushTimer, &QTimer::timeout, this, &CanCaptureRecorder::flushChunk);
+}
+
+CanCaptureRecorder::~CanCaptureRecorder()
+{
+    stop();
+}
+
+void CanCaptureRecorder::setMaxFramesNbByChunk(int maxFramesNbByChunk)
+{
+    if(maxFramesNbByChunk <= 0)
+    {
+        qWarning() << "The max number of frames by chunk: " << maxFramesNbByChunk << ", has to be "
+                   << "positive, we keep the current value: " << _maxFramesNbByChunk;
+        return;
+    }
+
+    _maxFramesNbByChunk = maxFramesNbByChunk;
+}
+
+void CanCaptureRecorder::setFlushIntervalInMs(int flushIntervalInMs)
+{
+    _flushIntervalInMs = qMax(0, flushIntervalInMs);
+    _flushTimer->setInterval(_flushIntervalInMs);
+
+    if(_flushIntervalInMs == 0)
+    {
+        _flushTimer->stop();
+    }
+    else if(isRecording())
+    {
+        _flushTimer->start();
+    }
+}
+
+bool CanCaptureRecorder::attach(CanDeviceIntf &canDeviceIntf)
+{
+    if(_attachedDevices.contains(&canDeviceIntf))
+    {
+        qInfo() << "The CAN device: " << canDeviceIntf.getConfig().getCanBusItfName()
+                << ", is already attached to the recorder";
+        return true;
+    }
+
+    const PCanBusItf::Enum channel = canDeviceIntf.getCanIntfKey();
+
+    _attachedDevices.insert(&canDeviceIntf,
+                            connect(&canDeviceIntf, &CanDeviceIntf::framesReceived,
+                                    this, [this, channel](const QVector<QCanBusFrame> &frames)
+                                    {
+                                        recordFrames(channel, frames);
+                                    }));
+    return true;
+}
+
+void CanCaptureRecorder::detach(CanDeviceIntf &canDeviceIntf)
+{
+    if(!_attachedDevices.contains(&canDeviceIntf))
+    {
+        return;
+    }
+
+    disconnect(_attachedDevices.take(&canDeviceIntf));
+}
+
+bool CanCaptureRecorder::start(const QString &basePath)
+{
+    if(isRecording())
+    {
+        qWarning() << "The CAN recorder is already recording in: " << _basePath << ", stop it "
+                   << "before starting a new record";
+        return false;
+    }
+
+    _basePath = basePath;
+    _fileIndex = 0;
+    _captureFilesPaths.clear();
+    _recordedFramesNb = 0;
+    _chunkRecords.clear();
+    _chunkHeader = {};
+
+    RETURN_IF_FALSE(openNextFile());
+
+    if(_flushIntervalInMs > 0)
+    {
+        _flushTimer->start();
+    }
+
+    return true;
+}
+
+bool CanCaptureRecorder::stop()
+{
+    if(!isRecording())
+    {
+        return true;
+    }
+
+    _flushTimer->stop();
+
+    const bool success = flushChunk();
+    closeCurrentFile();
+
+    return success;
+}
+
+void CanCaptureRecorder::recordFrames(PCanBusItf::Enum channel,
+                                      const QVector<QCanBusFrame> &frames)
+{
+    if(!isRecording())
+    {
+        return;
+    }
+
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        appendToChunk(channel, *citer);
+    }
+
+    _recordedFramesNb += static_cast<quint64>(frames.size());
+}
+
+void CanCaptureRecorder::recordChannelFrames(const QVector<CanChannelFrame> &frames)
+{
+    if(!isRecording())
+    {
+        return;
+    }
+
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        appendToChunk(citer->getChannel(), citer->getFrame());
+    }
+
+    _recordedFramesNb += static_cast<quint64>(frames.size());
+}
+
+bool CanCaptureRecorder::flushChunk()
+{
+    if(!isRecording() || _chunkHeader.framesNb == 0)
+    {
+        // Nothing to write
+        return true;
+    }
+
+    if(isRotationNeeded())
+    {
+        closeCurrentFile();
+        RETURN_IF_FALSE(openNextFile());
+    }
+
+    _chunkHeader.recordsSize = static_cast<quint32>(_chunkRecords.size());
+    _chunkHeader.fileOffset = static_cast<quint64>(_captureFile.pos());
+
+    const QByteArray chunkHeader = CanCaptureFormat::buildChunkHeader(_chunkHeader);
+    const QByteArray indexEntry = CanCaptureFormat::buildIndexEntry(_chunkHeader);
+
+    const bool success = (_captureFile.write(chunkHeader) == chunkHeader.size()) &&
+                         (_captureFile.write(_chunkRecords) == _chunkRecords.size()) &&
+                         (_indexFile.write(indexEntry) == indexEntry.size());
+
+    if(!success)
+    {
+        qWarning() << "A problem occurred when tried to write a chunk in the CAN capture file: "
+                   << _captureFile.fileName() << ", error: " << _captureFile.errorString();
+    }
+
+    if(!_fileHasFrames)
+    {
+        _fileFirstTimestampInUs = _chunkHeader.firstTimestampInUs;
+        _fileHasFrames = true;
+    }
+
+    _captureFile.flush();
+    _indexFile.flush();
+
+    _chunkRecords.clear();
+    _chunkHeader = {};
+
+    return success;
+}
+
+void CanCaptureRecorder::appendToChunk(PCanBusItf::Enum channel, const QCanBusFrame &frame)
+{
+    const quint64 timestampInUs = CanCaptureFormat::getTimestampInUs(frame);
+
+    if(_chunkHeader.framesNb == 0)
+    {
+        _chunkHeader.firstTimestampInUs = timestampInUs;
+    }
+
+    _chunkHeader.lastTimestampInUs = timestampInUs;
+    ++_chunkHeader.framesNb;
+
+    CanCaptureFormat::appendRecord(channel, frame, _chunkRecords);
+
+    if(static_cast<int>(_chunkHeader.framesNb) >= _maxFramesNbByChunk)
+    {
+        flushChunk();
+    }
+}
+
+bool CanCaptureRecorder::openNextFile()
+{
+    const QString filePath = QString("%1_%2.%3").arg(_basePath)
+                                                .arg(_fileIndex, FileIndexDigitsNb, 10, QChar('0'))
+                                                .arg(CanCaptureFormat::FileExtension);
+    ++_fileIndex;
+
+    _captureFile.setFileName(filePath);
+    _indexFile.setFileName(CanCaptureReader::getIndexFilePath(filePath));
+
+    if(!_captureFile.open(QIODevice::WriteOnly | QIODevice::Truncate) ||
+       !_indexFile.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "A problem occurred when tried to open the CAN capture file: " << filePath
+                   << ", error: " << _captureFile.errorString() << ", index error: "
+                   << _indexFile.errorString();
+        _captureFile.close();
+        _indexFile.close();
+        return false;
+    }
+
+    const qint64 startDateTimeInMs = QDateTime::currentMSecsSinceEpoch();
+    _captureFile.write(CanCaptureFormat::buildFileHeader(startDateTimeInMs));
+    _indexFile.write(CanCaptureFormat::buildIndexFileHeader(startDateTimeInMs));
+
+    _fileHasFrames = false;
+    _fileFirstTimestampInUs = 0;
+    _captureFilesPaths.append(filePath);
+
+    return true;
+}
+
+void CanCaptureRecorder::closeCurrentFile()
+{
+    if(!_captureFile.isOpen())
+    {
+        return;
+    }
+
+    const QString filePath = _captureFile.fileName();
+
+    _captureFile.close();
+    _indexFile.close();
+
+    emit captureFileClosed(filePath);
+}
+
+bool CanCaptureRecorder::isRotationNeeded() const
+{
+    if(!_fileHasFrames)
+    {
+        // We don't rotate empty files, even if the chunk is bigger than the max size
+        return false;
+    }
+
+    if(_maxFileSizeInBytes > 0 &&
+       (_captureFile.size() + CanCaptureFormat::ChunkHeaderSize + _chunkRecords.size()) >
+                                                                            _maxFileSizeInBytes)
+    {
+        return true;
+    }
+
+    return (_maxFileDurationInMs > 0 &&
+            _chunkHeader.lastTimestampInUs >
+                (_fileFirstTimestampInUs +
+                 (static_cast<quint64>(_maxFileDurationInMs) *
+                  CanLibConstants::Time::MilliToMicroCoeff)));
+}
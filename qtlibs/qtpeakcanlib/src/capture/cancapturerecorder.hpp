@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QCanBusFrame>
+#include <QFile>
+#include <QHash>
+
+#include "src/capture/cancaptureformat.hpp"
+#include "src/definescan.hpp"
+#include "src/merge/canchannelframe.hpp"
+
+class CanDeviceIntf;
+class QTimer;
+
+
+/** @brief This class records the frames received by one or several CAN devices in binary capture
+           files
+    @note The frames are recorded with their hardware timestamps and the CAN bus interface they
+          have been received from.
+    @note The frames are grouped by chunks before being written; a chunk is written when it
+          contains @ref getMaxFramesNbByChunk frames or when the flush interval expires.
+    @note If a max file size or a max file duration is set, the recorder rotates the files:
+          the files are named: "<basePath>_<fileIndex>.cancap". An index file is written beside
+          each capture file.
+    @note The recording is done in the recorder thread; to not slow down the thread of the
+          @ref CanDeviceIntf, you may move the recorder to a dedicated thread.
+    @see CanCaptureFormat */
+class CAN_EXPORT CanCaptureRecorder : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit CanCaptureRecorder(QObject *parent = nullptr);
+
+        /** @brief Class destructor
+            @note If the record is in progress, it's stopped */
+        virtual ~CanCaptureRecorder() override;
+
+    public:
+        /** @brief Get the max number of frames contained in a chunk */
+        int getMaxFramesNbByChunk() const { return _maxFramesNbByChunk; }
+
+        /** @brief Set the max number of frames contained in a chunk
+            @param maxFramesNbByChunk The max number of frames to set */
+        void setMaxFramesNbByChunk(int maxFramesNbByChunk);
+
+        /** @brief Get the interval between two flushes of the current chunk, in ms */
+        int getFlushIntervalInMs() const { return _flushIntervalInMs; }
+
+        /** @brief Set the interval between two flushes of the current chunk
+            @param flushIntervalInMs The interval to set in ms, if equals to 0, the chunk is only
+                                     written when it's full */
+        void setFlushIntervalInMs(int flushIntervalInMs);
+
+        /** @brief Get the max size of a capture file, in bytes */
+        qint64 getMaxFileSizeInBytes() const { return _maxFileSizeInBytes; }
+
+        /** @brief Set the max size of a capture file
+            @param maxFileSizeInBytes The max size to set in bytes, if equals to 0, the file isn't
+                                      rotated because of its size */
+        void setMaxFileSizeInBytes(qint64 maxFileSizeInBytes)
+        { _maxFileSizeInBytes = maxFileSizeInBytes; }
+
+        /** @brief Get the max duration of a capture file, in ms */
+        qint64 getMaxFileDurationInMs() const { return _maxFileDurationInMs; }
+
+        /** @brief Set the max duration of a capture file
+            @note The duration is computed from the frames timestamps
+            @param maxFileDurationInMs The max duration to set in ms, if equals to 0, the file
+                                       isn't rotated because of its duration */
+        void setMaxFileDurationInMs(qint64 maxFileDurationInMs)
+        { _maxFileDurationInMs = maxFileDurationInMs; }
+
+        /** @brief Attach the recorder to the CAN device interface given
+            @note The frames received by the device are recorded when the record is in progress
+            @param canDeviceIntf The CAN device interface to attach to
+            @return True if no problem occurred */
+        bool attach(CanDeviceIntf &canDeviceIntf);
+
+        /** @brief Detach the recorder from the CAN device interface given
+            @param canDeviceIntf The CAN device interface to detach from */
+        void detach(CanDeviceIntf &canDeviceIntf);
+
+        /** @brief Start the record
+            @param basePath The base path of the capture files, without extension
+            @return True if no problem occurred */
+        bool start(const QString &basePath);
+
+        /** @brief Stop the record
+            @note The current chunk is written before closing the files
+            @return True if no problem occurred */
+        bool stop();
+
+        /** @brief Test if the record is in progress */
+        bool isRecording() const { return _captureFile.isOpen(); }
+
+        /** @brief Get the paths of the capture files written since the record start */
+        const QStringList &getCaptureFilesPaths() const { return _captureFilesPaths; }
+
+        /** @brief Get the number of frames recorded since the record start */
+        quint64 getRecordedFramesNb() const { return _recordedFramesNb; }
+
+    public slots:
+        /** @brief Record the frames given
+            @note This is called when frames are received by an attached device, but you may also
+                  call it to record frames from another source
+            @param channel The CAN bus interface where the frames have been received
+            @param frames The frames to record */
+        void recordFrames(PCanBusItf::Enum channel, const QVector<QCanBusFrame> &frames);
+
+        /** @brief Record the frames given, tagged with their channel
+            @note This is useful to record the frames given by a @ref CanMergedStream: the frames
+                  of all the channels are recorded in the timestamps order
+            @param frames The frames to record */
+        void recordChannelFrames(const QVector<CanChannelFrame> &frames);
+
+        /** @brief Write the current chunk in the capture file
+            @return True if no problem occurred */
+        bool flushChunk();
+
+    signals:
+        /** @brief Emitted when a capture file has been closed because of a rotation or because
+                   the record has been stopped
+            @param filePath The path of the capture file closed */
+        void captureFileClosed(const QString &filePath);
+
+    private:
+        /** @brief Add a frame to the current chunk and write the chunk if it's full
+            @param channel The CAN bus interface where the frame has been received
+            @param frame The frame to record */
+        void appendToChunk(PCanBusItf::Enum channel, const QCanBusFrame &frame);
+
+        /** @brief Open a new capture file, and its index file
+            @return True if no problem occurred */
+        bool openNextFile();
+
+        /** @brief Close the current capture file, and its index file */
+        void closeCurrentFile();
+
+        /** @brief Test if the current file has to be rotated before writing the current chunk
+            @return True if the file has to be rotated */
+        bool isRotationNeeded() const;
+
+    private:
+        /** @brief The default max number of frames contained in a chunk */
+        static const constexpr int DefaultMaxFramesNbByChunk = 1024;
+
+        /** @brief The default interval between two flushes of the current chunk */
+        static const constexpr int DefaultFlushIntervalInMs = 500;
+
+        /** @brief The number of digits used to write the file index in the file name */
+        static const constexpr int FileIndexDigitsNb = 4;
+
+    private:
+        int _maxFramesNbByChunk{DefaultMaxFramesNbByChunk};
+        int _flushIntervalInMs{DefaultFlushIntervalInMs};
+        qint64 _maxFileSizeInBytes{0};
+        qint64 _maxFileDurationInMs{0};
+
+        QHash<CanDeviceIntf*, QMetaObject::Connection> _attachedDevices;
+
+        QString _basePath;
+        int _fileIndex{0};
+        QFile _captureFile;
+        QFile _indexFile;
+        QStringList _captureFilesPaths;
+        quint64 _fileFirstTimestampInUs{0};
+        bool _fileHasFrames{false};
+
+        QByteArray _chunkRecords;
+        CanCaptureFormat::ChunkHeader _chunkHeader;
+        QTimer *_flushTimer{nullptr};
+
+        quint64 _recordedFramesNb{0};
+};
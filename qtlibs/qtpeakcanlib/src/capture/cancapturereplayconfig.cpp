@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturereplayconfig.hpp"
+
+#include "src/candevice/candeviceintf.hpp"
+
+
+CanCaptureReplayConfig::CanCaptureReplayConfig()
+{
+}
+
+void CanCaptureReplayConfig::addChannelRoute(PCanBusItf::Enum capturedChannel,
+                                             const CanDeviceIntf &target)
+{
+    ChannelRoute route;
+    route.targetChannel = target.getCanIntfKey();
+    route.isTargetCanFd = target.getConfig().isCanFd();
+
+    addChannelRoute(capturedChannel, route);
+}
+
+bool CanCaptureReplayConfig::isValid() const
+{
+    return !_captureFilesPaths.isEmpty() && (_speedFactor > 0.0) && !_channelRoutes.isEmpty();
+}
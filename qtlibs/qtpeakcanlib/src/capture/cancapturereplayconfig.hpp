@@ -0,0 +1,100 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QHash>
+#include <QSet>
+#include <QStringList>
+
+#include "src/definescan.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+
+class CanDeviceIntf;
+
+
+/** @brief This is the config of a CAN capture replay
+    @see CanCaptureReplayThread */
+class CAN_EXPORT CanCaptureReplayConfig
+{
+    public:
+        /** @brief Describes where the frames captured on a channel are replayed */
+        struct ChannelRoute
+        {
+            /** @brief The CAN bus interface where the frames are written */
+            PCanBusItf::Enum targetChannel{PCanBusItf::Unknown};
+
+            /** @brief True if the target channel has been initialized for CAN FD */
+            bool isTargetCanFd{false};
+        };
+
+    public:
+        /** @brief Class constructor */
+        explicit CanCaptureReplayConfig();
+
+    public:
+        /** @brief Get the capture files to replay, in order of recording */
+        const QStringList &getCaptureFilesPaths() const { return _captureFilesPaths; }
+
+        /** @brief Set the capture files to replay
+            @see CanCaptureReader::findCaptureFiles
+            @param captureFilesPaths The capture files paths, in order of recording */
+        void setCaptureFilesPaths(const QStringList &captureFilesPaths)
+        { _captureFilesPaths = captureFilesPaths; }
+
+        /** @brief Get the replay speed factor */
+        double getSpeedFactor() const { return _speedFactor; }
+
+        /** @brief Set the replay speed factor
+            @note If equals to 2.0, the inter-frame gaps are divided by two
+            @param speedFactor The speed factor to set, it has to be strictly positive */
+        void setSpeedFactor(double speedFactor) { _speedFactor = speedFactor; }
+
+        /** @brief Get the ids of the frames to replay, if empty all the frames are replayed */
+        const QSet<quint32> &getIdsFilter() const { return _idsFilter; }
+
+        /** @brief Set the ids of the frames to replay
+            @param idsFilter The ids to replay, if empty all the frames are replayed */
+        void setIdsFilter(const QSet<quint32> &idsFilter) { _idsFilter = idsFilter; }
+
+        /** @brief Say if the replay restarts from the beginning when it reaches the end */
+        bool isLoop() const { return _loop; }
+
+        /** @brief Set if the replay restarts from the beginning when it reaches the end
+            @param loop True to loop */
+        void setLoop(bool loop) { _loop = loop; }
+
+        /** @brief Get the channels routes */
+        const QHash<PCanBusItf::Enum, ChannelRoute> &getChannelRoutes() const
+        { return _channelRoutes; }
+
+        /** @brief Replay the frames captured on the channel given, through the CAN device given
+            @note The frames captured on channels without route aren't replayed
+            @note The CAN device has to be initialized before starting the replay
+            @param capturedChannel The channel where the frames have been captured
+            @param target The CAN device where the frames are written */
+        void addChannelRoute(PCanBusItf::Enum capturedChannel, const CanDeviceIntf &target);
+
+        /** @brief Replay the frames captured on the channel given, through the CAN bus interface
+                   given
+            @param capturedChannel The channel where the frames have been captured
+            @param route The route to the CAN bus interface where the frames are written */
+        void addChannelRoute(PCanBusItf::Enum capturedChannel, const ChannelRoute &route)
+        { _channelRoutes.insert(capturedChannel, route); }
+
+        /** @brief Test if the config is valid
+            @return True if the config is valid */
+        bool isValid() const;
+
+    private:
+        /** @brief The default replay speed factor */
+        static const constexpr double DefaultSpeedFactor = 1.0;
+
+    private:
+        QStringList _captureFilesPaths;
+        double _speedFactor{DefaultSpeedFactor};
+        QSet<quint32> _idsFilter;
+        bool _loop{false};
+        QHash<PCanBusItf::Enum, ChannelRoute> _channelRoutes;
+};
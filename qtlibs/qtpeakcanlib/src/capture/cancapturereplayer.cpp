@@ -0,0 +1,253 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturereplayer.hpp"
+
+#include <QDebug>
+#include <QMutex>
+#include <QThread>
+
+#include "definesutility/definesutility.hpp"
+
+#include "src/canlibconstants.hpp"
+#include "src/capture/cancapturereader.hpp"
+#include "src/pcanapi/pcanapi.hpp"
+
+
+CanCaptureReplayer::CanCaptureReplayer(const CanCaptureReplayConfig &config, QObject *parent)
+    : QObject{parent},
+    _config{config},
+    _replayMutex{new QMutex()}
+{
+}
+
+CanCaptureReplayer::~CanCaptureReplayer()
+{
+    waitForProcessEnd();
+
+    delete _replayMutex;
+    _replayMutex = nullptr;
+}
+
+bool CanCaptureReplayer::waitForProcessEnd(int timeoutInMs)
+{
+    if(_replayMutex == nullptr)
+    {
+        return true;
+    }
+
+    if(!_replayMutex->tryLock(timeoutInMs))
+    {
+        qWarning() << "The CAN capture replay is still in progress and the timeout has raised, "
+                   << "we abandon the waiting";
+        return false;
+    }
+
+    _replayMutex->unlock();
+    return true;
+}
+
+void CanCaptureReplayer::cancelReplay()
+{
+    _cancel = true;
+}
+
+void CanCaptureReplayer::replay()
+{
+    if(_replayMutex == nullptr || !_replayMutex->tryLock())
+    {
+        qWarning() << "We are already replaying a CAN capture or the object is destroyed";
+        return;
+    }
+
+    bool success = _config.isValid();
+    if(!success)
+    {
+        qWarning() << "The CAN capture replay config isn't valid, we can't replay it";
+    }
+
+    _timer.start();
+
+    while(success && !_cancel)
+    {
+        // The time reference is taken again at each loop
+        _firstFrameFound = false;
+
+        success = replayFilesOnce();
+
+        if(!_config.isLoop())
+        {
+            break;
+        }
+    }
+
+    if(_droppedFramesNb > 0)
+    {
+        qWarning() << "The driver transmit queue stayed full, " << _droppedFramesNb
+                   << " frames haven't been replayed";
+    }
+
+    _replayMutex->unlock();
+
+    emit replayEnded(success, _sentFramesNb);
+}
+
+bool CanCaptureReplayer::replayFilesOnce()
+{
+    CanCaptureReader reader;
+    const QStringList &filesPaths = _config.getCaptureFilesPaths();
+
+    for(auto fileIter = filesPaths.cbegin(); fileIter != filesPaths.cend() && !_cancel; ++fileIter)
+    {
+        RETURN_IF_FALSE(reader.open(*fileIter));
+
+        while(!reader.atEnd() && !_cancel)
+        {
+            QVector<CanCaptureFormat::CapturedFrame> frames;
+            RETURN_IF_FALSE(reader.readNextChunk(frames));
+
+            for(auto citer = frames.cbegin(); citer != frames.cend() && !_cancel; ++citer)
+            {
+                RETURN_IF_FALSE(replayFrame(*citer));
+            }
+        }
+    }
+
+    return true;
+}
+
+bool CanCaptureReplayer::replayFrame(const CanCaptureFormat::CapturedFrame &capturedFrame)
+{
+    const QHash<PCanBusItf::Enum, CanCaptureReplayConfig::ChannelRoute> &routes =
+        _config.getChannelRoutes();
+
+    auto routeIter = routes.constFind(capturedFrame.channel);
+    if(routeIter == routes.cend())
+    {
+        // The channel isn't replayed
+        return true;
+    }
+
+    const QSet<quint32> &idsFilter = _config.getIdsFilter();
+    if(!idsFilter.isEmpty() && !idsFilter.contains(capturedFrame.frame.frameId()))
+    {
+        return true;
+    }
+
+    if(capturedFrame.frame.hasFlexibleDataRateFormat() && !routeIter->isTargetCanFd)
+    {
+        qWarning() << "The captured frame: " << capturedFrame.frame.toString() << ", is a CAN FD "
+                   << "frame but the target channel: "
+                   << PCanBusItf::toString(routeIter->targetChannel) << ", isn't a CAN FD one; "
+                   << "we skip it";
+        return true;
+    }
+
+    const quint64 timestampInUs = CanCaptureFormat::getTimestampInUs(capturedFrame.frame);
+
+    if(!_firstFrameFound)
+    {
+        _firstFrameFound = true;
+        _firstTimestampInUs = timestampInUs;
+        _startTimeInNs = _timer.nsecsElapsed();
+    }
+
+    const quint64 gapInUs = (timestampInUs >= _firstTimestampInUs) ?
+                                (timestampInUs - _firstTimestampInUs) : 0;
+
+    const qint64 targetTimeInNs = _startTimeInNs + static_cast<qint64>(
+        (static_cast<double>(gapInUs) * CanLibConstants::Time::MicroToNanoCoeff) /
+        _config.getSpeedFactor());
+
+    if(!waitUntil(targetTimeInNs))
+    {
+        // The replay has been cancelled
+        return true;
+    }
+
+    bool dropped = false;
+    if(!writeFrame(*routeIter, capturedFrame.frame, dropped))
+    {
+        qWarning() << "A problem occurred when tried to replay the frame: "
+                   << capturedFrame.frame.toString() << ", on the channel: "
+                   << PCanBusItf::toString(routeIter->targetChannel);
+        return false;
+    }
+
+    if(dropped)
+    {
+        ++_droppedFramesNb;
+        return true;
+    }
+
+    ++_sentFramesNb;
+    return true;
+}
+
+bool CanCaptureReplayer::writeFrame(const CanCaptureReplayConfig::ChannelRoute &route,
+                                    const QCanBusFrame &frame,
+                                    bool &dropped)
+{
+    dropped = false;
+    qint64 queueFullStartInNs = -1;
+
+    while(true)
+    {
+        bool txQueueFull = false;
+        const bool success = route.isTargetCanFd ?
+            PCanApi::writeCanFdMsgProcess(route.targetChannel, frame, &txQueueFull) :
+            PCanApi::writeCanMsgProcess(route.targetChannel, frame, &txQueueFull);
+
+        if(success || !txQueueFull)
+        {
+            return success;
+        }
+
+        // The driver queue is full, we let the bus drain it before retrying
+        const qint64 nowInNs = _timer.nsecsElapsed();
+        if(queueFullStartInNs < 0)
+        {
+            queueFullStartInNs = nowInNs;
+        }
+        else if(_cancel || (nowInNs - queueFullStartInNs) > QueueFullTimeoutInNs)
+        {
+            dropped = true;
+            return true;
+        }
+
+        QThread::usleep(QueueFullRetryDelayInUs);
+    }
+}
+
+bool CanCaptureReplayer::waitUntil(qint64 targetTimeInNs)
+{
+    qint64 remainingInNs = targetTimeInNs - _timer.nsecsElapsed();
+
+    while(remainingInNs > ActiveWaitThresholdInNs)
+    {
+        if(_cancel)
+        {
+            return false;
+        }
+
+        const qint64 sleepInNs = qMin(remainingInNs - ActiveWaitThresholdInNs,
+                                      MaxSleepDurationInNs);
+        QThread::usleep(static_cast<unsigned long>(sleepInNs /
+                                                   CanLibConstants::Time::MicroToNanoCoeff));
+
+        remainingInNs = targetTimeInNs - _timer.nsecsElapsed();
+    }
+
+    while(_timer.nsecsElapsed() < targetTimeInNs)
+    {
+        if(_cancel)
+        {
+            return false;
+        }
+
+        QThread::yieldCurrentThread();
+    }
+
+    return true;
+}
@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <atomic>
+
+#include <QElapsedTimer>
+
+#include "src/capture/cancaptureformat.hpp"
+#include "src/capture/cancapturereplayconfig.hpp"
+
+class QMutex;
+
+
+/** @brief This class replays CAN capture files, reproducing the inter-frame gaps
+    @note The replay process is blocking, the object has to live in a dedicated thread, see
+          @ref CanCaptureReplayThread
+    @note The frames are written with the PEAK CAN lib, as @ref CanDevice::write does; the lib is
+          thread safe and this avoids to go through the device thread for each frame.
+    @note To reach a sub-millisecond accuracy, the replayer sleeps until the next frame is close,
+          then it actively waits for it.
+    @note When the driver transmit queue is full, the writing of the frame is retried for a short
+          time; if the queue stays full, the frame is dropped and the replay goes on.
+    @note You can only call @ref replay once. */
+class CanCaptureReplayer : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param config The replay config
+            @param parent The class parent */
+        explicit CanCaptureReplayer(const CanCaptureReplayConfig &config,
+                                    QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanCaptureReplayer() override;
+
+    public:
+        /** @brief Wait for the replay process end
+            @param timeoutInMs The waiting timeout
+            @return True if the process is ended, false if the timeout raised before the end of
+                    process */
+        bool waitForProcessEnd(int timeoutInMs = -1);
+
+        /** @brief This cancels the current replay process
+            @note This can be called from any thread */
+        void cancelReplay();
+
+    public slots:
+        /** @brief This method starts the replay process */
+        void replay();
+
+    signals:
+        /** @brief Emitted when the replay process is ended
+            @param success True if no problem occurred
+            @param sentFramesNb The number of frames written */
+        void replayEnded(bool success, quint64 sentFramesNb);
+
+    private:
+        /** @brief Replay all the capture files once
+            @return True if no problem occurred */
+        bool replayFilesOnce();
+
+        /** @brief Replay the captured frame given, when its time has come
+            @param capturedFrame The frame to replay
+            @return True if no problem occurred */
+        bool replayFrame(const CanCaptureFormat::CapturedFrame &capturedFrame);
+
+        /** @brief Wait until the elapsed timer reaches the time given
+            @param targetTimeInNs The time to reach, relatively to the elapsed timer start
+            @return True if the time has been reached, false if the replay has been cancelled */
+        bool waitUntil(qint64 targetTimeInNs);
+
+        /** @brief Write the frame given on the target channel, retrying while the driver
+                   transmit queue is full
+            @param route The route of the frame channel
+            @param frame The frame to write
+            @param dropped Set to true if the frame has been dropped because the transmit queue
+                           stayed full, or because the replay has been cancelled
+            @return True if no problem occurred */
+        bool writeFrame(const CanCaptureReplayConfig::ChannelRoute &route,
+                        const QCanBusFrame &frame,
+                        bool &dropped);
+
+    private:
+        /** @brief Under this remaining time, the replayer actively waits for the next frame
+            @note On Windows, the sleep resolution is around 15.6 ms */
+#ifdef Q_OS_WIN
+        static const constexpr qint64 ActiveWaitThresholdInNs = 16000000;
+#else
+        static const constexpr qint64 ActiveWaitThresholdInNs = 2000000;
+#endif
+
+        /** @brief The max duration of a sleep, to stay responsive to cancellation */
+        static const constexpr qint64 MaxSleepDurationInNs = 50000000;
+
+        /** @brief The delay between two writings of a frame, when the driver transmit queue is
+                   full */
+        static const constexpr unsigned long QueueFullRetryDelayInUs = 100;
+
+        /** @brief The max time spent retrying to write a frame in a full transmit queue */
+        static const constexpr qint64 QueueFullTimeoutInNs = 100000000;
+
+    private:
+        CanCaptureReplayConfig _config;
+        std::atomic_bool _cancel{false};
+        QMutex *_replayMutex{nullptr};
+
+        QElapsedTimer _timer;
+        bool _firstFrameFound{false};
+        quint64 _firstTimestampInUs{0};
+        qint64 _startTimeInNs{0};
+        quint64 _sentFramesNb{0};
+        quint64 _droppedFramesNb{0};
+};
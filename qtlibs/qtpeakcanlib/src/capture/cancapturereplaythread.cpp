@@ -0,0 +1,47 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturereplaythread.hpp"
+
+#include <QTimer>
+
+#include "src/capture/cancapturereplayer.hpp"
+
+
+CanCaptureReplayThread::CanCaptureReplayThread(const CanCaptureReplayConfig &config,
+                                               QObject *parent)
+    : BaseThread{parent},
+    _config{config}
+{
+}
+
+CanCaptureReplayThread::~CanCaptureReplayThread()
+{
+}
+
+bool CanCaptureReplayThread::stopThread()
+{
+    if(_replayer != nullptr)
+    {
+        _replayer->cancelReplay();
+        _replayer->waitForProcessEnd();
+
+        QTimer::singleShot(0, _replayer, &CanCaptureReplayer::deleteLater);
+        _replayer = nullptr;
+    }
+
+    return BaseThread::stopThread();
+}
+
+void CanCaptureReplayThread::run()
+{
+    _replayer = new CanCaptureReplayer(_config);
+
+    connect(_replayer,  &CanCaptureReplayer::replayEnded,
+            this,       &CanCaptureReplayThread::replayEnded);
+    connect(this,       &CanCaptureReplayThread::ready,
+            _replayer,  &CanCaptureReplayer::replay, Qt::QueuedConnection);
+
+    BaseThread::run();
+}
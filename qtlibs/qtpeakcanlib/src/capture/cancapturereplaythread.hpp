@@ -0,0 +1,55 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+#include <QObject>
+
+#include "src/capture/cancapturereplayconfig.hpp"
+#include "src/definescan.hpp"
+
+class CanCaptureReplayer;
+
+
+/** @brief This is the thread used to replay CAN capture files
+    @note The replay starts as soon as the thread is ready; therefore, you only have to call
+          @ref startThreadAndWaitToBeReady to start it.
+    @note The replay has its own thread because the process is blocking, to reproduce the
+          inter-frame gaps accurately */
+class CAN_EXPORT CanCaptureReplayThread : public BaseThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param config The replay config
+            @param parent The class parent */
+        explicit CanCaptureReplayThread(const CanCaptureReplayConfig &config,
+                                        QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanCaptureReplayThread() override;
+
+    public slots:
+        /** @brief Call to stop the thread
+            @note If the replay is in progress, it's cancelled
+            @return True if no problem occurs */
+        virtual bool stopThread() override;
+
+    protected:
+        /** @copydoc BaseThread::run */
+        virtual void run() override;
+
+    signals:
+        /** @brief Emitted when the replay process is ended
+            @param success True if no problem occurred
+            @param sentFramesNb The number of frames written */
+        void replayEnded(bool success, quint64 sentFramesNb);
+
+    private:
+        CanCaptureReplayConfig _config;
+        CanCaptureReplayer *_replayer{nullptr};
+};
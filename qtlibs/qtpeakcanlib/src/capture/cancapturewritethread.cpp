@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancapturewritethread.hpp"
+
+#include <QTimer>
+
+#include "src/capture/cancapturefilewriter.hpp"
+
+
+CanCaptureWriteThread::CanCaptureWriteThread(QObject *parent)
+    : BaseThread{parent}
+{
+}
+
+CanCaptureWriteThread::~CanCaptureWriteThread()
+{
+}
+
+bool CanCaptureWriteThread::stopThread()
+{
+    if(_writer != nullptr)
+    {
+        // The writings are queued events, this waits for the already queued ones to be done
+        if(isRunning() && QThread::currentThread() != this)
+        {
+            QMetaObject::invokeMethod(_writer, []() {}, Qt::BlockingQueuedConnection);
+        }
+
+        QTimer::singleShot(0, _writer, &CanCaptureFileWriter::deleteLater);
+        _writer = nullptr;
+    }
+
+    return BaseThread::stopThread();
+}
+
+void CanCaptureWriteThread::run()
+{
+    _writer = new CanCaptureFileWriter();
+
+    BaseThread::run();
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+#include <QObject>
+
+class CanCaptureFileWriter;
+
+
+/** @brief This is the thread used to write the capture files without blocking the capture */
+class CanCaptureWriteThread : public BaseThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The class parent */
+        explicit CanCaptureWriteThread(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanCaptureWriteThread() override;
+
+    public:
+        /** @brief Access the @ref CanCaptureFileWriter created in the thread
+            @warning The writer is created in the run of this thread; therefore, the caller of
+                     this method and the object pointer you got with this method aren't in the same
+                     thread */
+        CanCaptureFileWriter *accessWriter() const { return _writer; }
+
+    public slots:
+        /** @brief Call to stop the thread
+            @note The writings already asked are done before stopping the thread
+            @return True if no problem occurs */
+        virtual bool stopThread() override;
+
+    protected:
+        /** @copydoc BaseThread::run */
+        virtual void run() override;
+
+    private:
+        CanCaptureFileWriter *_writer{nullptr};
+};
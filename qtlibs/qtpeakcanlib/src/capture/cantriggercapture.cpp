@@ -0,0 +1,351 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cantriggercapture.hpp"
+
+#include <QDateTime>
+#include <QDebug>
+#include <QTimer>
+
+#include <limits>
+
+#include "src/candevice/candeviceintf.hpp"
+#include "src/canlibconstants.hpp"
+#include "src/capture/cancaptureformat.hpp"
+#include "src/capture/cancapturefilewriter.hpp"
+#include "src/capture/cancapturewritethread.hpp"
+
+
+CanTriggerCapture::CanTriggerCapture(QObject *parent)
+    : QObject{parent},
+    _postTriggerTimer{new QTimer(this)}
+{
+    _postTriggerTimer->setSingleShot(true);
+    _postTriggerTimer->setInterval(_postTriggerInMs);
+    connect(_postTriggerTimer, &QTimer::timeout, this, &CanTriggerCapture::onPostTriggerTimeout);
+}
+
+CanTriggerCapture::~CanTriggerCapture()
+{
+    disarm();
+
+    if(_writeThread != nullptr)
+    {
+        _writeThread->stopAndDeleteThread();
+        _writeThread = nullptr;
+    }
+}
+
+bool CanTriggerCapture::setRingCapacity(int ringCapacity)
+{
+    if(isArmed())
+    {
+        qWarning() << "The ring capacity of the trigger capture can't be changed while the "
+                   << "capture is armed";
+        return false;
+    }
+
+    if(ringCapacity <= 0)
+    {
+        qWarning() << "The ring capacity: " << ringCapacity << ", of the trigger capture has to "
+                   << "be positive";
+        return false;
+    }
+
+    if(ringCapacity > (std::numeric_limits<int>::max() / CanCaptureFormat::MaxRecordSize))
+    {
+        qWarning() << "The ring capacity: " << ringCapacity << ", of the trigger capture is too "
+                   << "big, the ring can't be allocated";
+        return false;
+    }
+
+    _ringCapacity = ringCapacity;
+    return true;
+}
+
+void CanTriggerCapture::setPostTriggerInMs(int postTriggerInMs)
+{
+    _postTriggerInMs = qMax(0, postTriggerInMs);
+    _postTriggerTimer->setInterval(_postTriggerInMs);
+}
+
+bool CanTriggerCapture::attach(CanDeviceIntf &canDeviceIntf)
+{
+    if(_attachedDevices.contains(&canDeviceIntf))
+    {
+        qInfo() << "The CAN device: " << canDeviceIntf.getConfig().getCanBusItfName()
+                << ", is already attached to the trigger capture";
+        return true;
+    }
+
+    const PCanBusItf::Enum channel = canDeviceIntf.getCanIntfKey();
+
+    QVector<QMetaObject::Connection> connections;
+    connections.append(connect(&canDeviceIntf, &CanDeviceIntf::framesReceived,
+                               this, [this, channel](const QVector<QCanBusFrame> &frames)
+                               {
+                                   addFrames(channel, frames);
+                               }));
+    connections.append(connect(&canDeviceIntf, &CanDeviceIntf::busEventOccurred,
+                               this, &CanTriggerCapture::onBusEvent));
+
+    _attachedDevices.insert(&canDeviceIntf, connections);
+    return true;
+}
+
+void CanTriggerCapture::detach(CanDeviceIntf &canDeviceIntf)
+{
+    if(!_attachedDevices.contains(&canDeviceIntf))
+    {
+        return;
+    }
+
+    const QVector<QMetaObject::Connection> connections = _attachedDevices.take(&canDeviceIntf);
+    for(auto citer = connections.cbegin(); citer != connections.cend(); ++citer)
+    {
+        disconnect(*citer);
+    }
+}
+
+bool CanTriggerCapture::arm(const QString &basePath)
+{
+    if(isArmed())
+    {
+        qWarning() << "The CAN trigger capture is already armed for: " << _basePath << ", disarm "
+                   << "it before arming it again";
+        return false;
+    }
+
+    if(_writeThread == nullptr)
+    {
+        _writeThread = new CanCaptureWriteThread();
+        if(!_writeThread->startThreadAndWaitToBeReady())
+        {
+            qWarning() << "A problem occurred when tried to start the capture write thread";
+            _writeThread->stopAndDeleteThread();
+            _writeThread = nullptr;
+            return false;
+        }
+
+        connect(_writeThread->accessWriter(), &CanCaptureFileWriter::captureFileWritten,
+                this,                         &CanTriggerCapture::captureFileWritten);
+    }
+
+    // The ring is allocated once, the frames are then encoded in place
+    _ringRecords.resize(_ringCapacity * CanCaptureFormat::MaxRecordSize);
+    _ringTimestampsInUs.resize(_ringCapacity);
+    _ringRecordsSizes.resize(_ringCapacity);
+    _ringHead = 0;
+    _ringSize = 0;
+    _lastTimestampInUs = 0;
+    _windowFramesNb = 0;
+
+    _basePath = basePath;
+    _captureIndex = 0;
+    _captureFilesPaths.clear();
+    _truncatedCapturesNb = 0;
+    _armDateTimeInMs = QDateTime::currentMSecsSinceEpoch();
+
+    _state = State::Armed;
+    return true;
+}
+
+void CanTriggerCapture::disarm()
+{
+    if(_state == State::Triggered)
+    {
+        endTrigger(false);
+    }
+
+    _state = State::Disarmed;
+    _ringHead = 0;
+    _ringSize = 0;
+}
+
+void CanTriggerCapture::addFrames(PCanBusItf::Enum channel, const QVector<QCanBusFrame> &frames)
+{
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        if(_state == State::Disarmed)
+        {
+            return;
+        }
+
+        const quint64 timestampInUs = CanCaptureFormat::getTimestampInUs(*citer);
+
+        if(_state == State::Triggered)
+        {
+            const quint64 endInUs = _triggerTimestampInUs +
+                                    (static_cast<quint64>(_postTriggerInMs) *
+                                     CanLibConstants::Time::MilliToMicroCoeff);
+            if(timestampInUs > endInUs)
+            {
+                endTrigger(false);
+            }
+            else if(_windowFramesNb >= _ringCapacity)
+            {
+                // The next frame would overwrite the first frame of the window
+                endTrigger(true);
+            }
+
+            if(_state == State::Disarmed)
+            {
+                return;
+            }
+        }
+
+        storeFrame(channel, *citer);
+
+        if(_state == State::Triggered)
+        {
+            ++_windowFramesNb;
+        }
+        else if(isTriggerFrame(*citer))
+        {
+            startTrigger(timestampInUs);
+        }
+    }
+}
+
+void CanTriggerCapture::onBusEvent(CanBusEvent::Enum event)
+{
+    if(_triggerBusEvents.contains(event))
+    {
+        trigger();
+    }
+}
+
+void CanTriggerCapture::trigger()
+{
+    if(_state != State::Armed)
+    {
+        return;
+    }
+
+    startTrigger(_lastTimestampInUs);
+}
+
+void CanTriggerCapture::onPostTriggerTimeout()
+{
+    if(_state != State::Triggered)
+    {
+        return;
+    }
+
+    endTrigger(false);
+}
+
+void CanTriggerCapture::storeFrame(PCanBusItf::Enum channel, const QCanBusFrame &frame)
+{
+    char *slot = _ringRecords.data() + (_ringHead * CanCaptureFormat::MaxRecordSize);
+
+    const int recordSize = CanCaptureFormat::writeRecord(channel, frame, slot);
+
+    _ringRecordsSizes[_ringHead] = static_cast<quint8>(recordSize);
+    _lastTimestampInUs = CanCaptureFormat::getTimestampInUs(frame);
+    _ringTimestampsInUs[_ringHead] = _lastTimestampInUs;
+
+    _ringHead = (_ringHead + 1) % _ringCapacity;
+    _ringSize = qMin(_ringSize + 1, _ringCapacity);
+}
+
+bool CanTriggerCapture::isTriggerFrame(const QCanBusFrame &frame) const
+{
+    const quint32 frameId = frame.frameId();
+
+    for(auto citer = _triggerMasks.cbegin(); citer != _triggerMasks.cend(); ++citer)
+    {
+        if(citer->getReceivedMsgId() == frameId &&
+           citer->checkIfMessageReceivedIsValid(frame, true))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CanTriggerCapture::startTrigger(quint64 triggerTimestampInUs)
+{
+    const quint64 preTriggerInUs = static_cast<quint64>(_preTriggerInMs) *
+                                   CanLibConstants::Time::MilliToMicroCoeff;
+    const quint64 windowStartInUs = (triggerTimestampInUs > preTriggerInUs) ?
+                                        (triggerTimestampInUs - preTriggerInUs) :
+                                        0;
+
+    // The frames are stored in the reception order, we go back until the window start
+    _windowFramesNb = 0;
+    while(_windowFramesNb < _ringSize)
+    {
+        const int slotIdx = getSlotIdx(_ringSize - _windowFramesNb - 1);
+        if(_ringTimestampsInUs.at(slotIdx) < windowStartInUs)
+        {
+            break;
+        }
+
+        ++_windowFramesNb;
+    }
+
+    _triggerTimestampInUs = triggerTimestampInUs;
+    _state = State::Triggered;
+    _postTriggerTimer->start();
+
+    emit triggered(triggerTimestampInUs);
+}
+
+void CanTriggerCapture::endTrigger(bool truncated)
+{
+    _postTriggerTimer->stop();
+
+    if(truncated)
+    {
+        ++_truncatedCapturesNb;
+        qWarning() << "The CAN trigger capture ring is full before the end of the post-trigger "
+                   << "window, the capture: " << _captureIndex << ", is ended early";
+    }
+
+    CanCaptureFormat::ChunkHeader chunkHeader;
+    QByteArray records;
+    records.reserve(_windowFramesNb * CanCaptureFormat::MaxRecordSize);
+
+    for(int idx = _ringSize - _windowFramesNb; idx < _ringSize; ++idx)
+    {
+        const int slotIdx = getSlotIdx(idx);
+        records.append(_ringRecords.constData() + (slotIdx * CanCaptureFormat::MaxRecordSize),
+                       _ringRecordsSizes.at(slotIdx));
+
+        const quint64 timestampInUs = _ringTimestampsInUs.at(slotIdx);
+        if(chunkHeader.framesNb == 0)
+        {
+            chunkHeader.firstTimestampInUs = timestampInUs;
+        }
+
+        chunkHeader.lastTimestampInUs = timestampInUs;
+        ++chunkHeader.framesNb;
+    }
+
+    chunkHeader.recordsSize = static_cast<quint32>(records.size());
+
+    const QString filePath = QString("%1_%2.%3")
+                                 .arg(_basePath)
+                                 .arg(_captureIndex, FileIndexDigitsNb, 10, QChar('0'))
+                                 .arg(CanCaptureFormat::FileExtension);
+    ++_captureIndex;
+    _captureFilesPaths.append(filePath);
+
+    CanCaptureFileWriter *writer = _writeThread->accessWriter();
+    const qint64 startDateTimeInMs = _armDateTimeInMs;
+    QMetaObject::invokeMethod(writer,
+                              [writer, filePath, records, chunkHeader, startDateTimeInMs]()
+                              {
+                                  writer->writeCaptureFile(filePath,
+                                                           records,
+                                                           chunkHeader,
+                                                           startDateTimeInMs);
+                              },
+                              Qt::QueuedConnection);
+
+    _windowFramesNb = 0;
+    _state = _rearmedAfterTrigger ? State::Armed : State::Disarmed;
+}
@@ -0,0 +1,239 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QCanBusFrame>
+#include <QHash>
+#include <QVector>
+
+#include "src/definescan.hpp"
+#include "src/models/canbusevent.hpp"
+#include "src/models/expectedcanframemask.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+
+class CanCaptureWriteThread;
+class CanDeviceIntf;
+class QTimer;
+
+
+/** @brief This class keeps the recent frames of one or several CAN devices in a fixed-memory
+           ring, and writes the frames around a trigger in capture files (oscilloscope-style)
+    @note When the capture is armed, each frame is encoded in a slot of the ring, as a capture
+          record: there is no allocation and only one copy of the payload by frame.
+    @note When a trigger occurs (a frame which matches a trigger mask, a bus event or a manual
+          trigger), the frames of the pre-trigger window are kept, the frames are captured until
+          the end of the post-trigger window and the whole window is written in a capture file,
+          in a dedicated thread. The files are named: "<basePath>_<captureIndex>.cancap".
+    @note The ring capacity has to contain the whole window; if the ring is full before the end
+          of the post-trigger window, the capture is ended early to not lose the pre-trigger
+          frames, see @ref getTruncatedCapturesNb.
+    @note The post-trigger window is measured with the frames timestamps; if no frame is received
+          the capture is ended after the same duration measured with the host clock.
+    @see CanCaptureFormat */
+class CAN_EXPORT CanTriggerCapture : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief The state of the capture */
+        enum class State
+        {
+            Disarmed,
+            Armed,
+            Triggered
+        };
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit CanTriggerCapture(QObject *parent = nullptr);
+
+        /** @brief Class destructor
+            @note The captures already triggered and ended are written before the destruction */
+        virtual ~CanTriggerCapture() override;
+
+    public:
+        /** @brief Get the max number of frames kept in the ring */
+        int getRingCapacity() const { return _ringCapacity; }
+
+        /** @brief Set the max number of frames kept in the ring
+            @note The capacity can't be changed while the capture is armed
+            @note The ring records are allocated in one byte array: the capacity is limited to
+                  INT_MAX / @ref CanCaptureFormat::MaxRecordSize
+            @param ringCapacity The capacity to set
+            @return True if no problem occurred */
+        bool setRingCapacity(int ringCapacity);
+
+        /** @brief Get the duration kept before the trigger, in ms */
+        int getPreTriggerInMs() const { return _preTriggerInMs; }
+
+        /** @brief Set the duration kept before the trigger
+            @param preTriggerInMs The duration to set in ms */
+        void setPreTriggerInMs(int preTriggerInMs) { _preTriggerInMs = qMax(0, preTriggerInMs); }
+
+        /** @brief Get the duration captured after the trigger, in ms */
+        int getPostTriggerInMs() const { return _postTriggerInMs; }
+
+        /** @brief Set the duration captured after the trigger
+            @param postTriggerInMs The duration to set in ms */
+        void setPostTriggerInMs(int postTriggerInMs);
+
+        /** @brief Get the frames which trigger the capture */
+        const QVector<ExpectedCanFrameMask> &getTriggerMasks() const { return _triggerMasks; }
+
+        /** @brief Set the frames which trigger the capture
+            @note A frame triggers the capture if it has the expected id and if its payload matches
+                  the mask (if a mask is given) */
+        void setTriggerMasks(const QVector<ExpectedCanFrameMask> &triggerMasks)
+        { _triggerMasks = triggerMasks; }
+
+        /** @brief Get the bus events which trigger the capture */
+        const QVector<CanBusEvent::Enum> &getTriggerBusEvents() const
+        { return _triggerBusEvents; }
+
+        /** @brief Set the bus events which trigger the capture */
+        void setTriggerBusEvents(const QVector<CanBusEvent::Enum> &triggerBusEvents)
+        { _triggerBusEvents = triggerBusEvents; }
+
+        /** @brief Test if the capture is armed again after a trigger */
+        bool isRearmedAfterTrigger() const { return _rearmedAfterTrigger; }
+
+        /** @brief Set if the capture is armed again after a trigger
+            @param rearmedAfterTrigger If false, the capture is disarmed after the first window */
+        void setRearmedAfterTrigger(bool rearmedAfterTrigger)
+        { _rearmedAfterTrigger = rearmedAfterTrigger; }
+
+        /** @brief Attach the capture to the CAN device interface given
+            @note The frames and the bus events of the device are captured when the capture is
+                  armed
+            @param canDeviceIntf The CAN device interface to attach to
+            @return True if no problem occurred */
+        bool attach(CanDeviceIntf &canDeviceIntf);
+
+        /** @brief Detach the capture from the CAN device interface given
+            @param canDeviceIntf The CAN device interface to detach from */
+        void detach(CanDeviceIntf &canDeviceIntf);
+
+        /** @brief Arm the capture: the frames are kept in the ring and the triggers are watched
+            @param basePath The base path of the capture files, without extension
+            @return True if no problem occurred */
+        bool arm(const QString &basePath);
+
+        /** @brief Disarm the capture
+            @note If the capture is triggered, the window captured until now is written */
+        void disarm();
+
+        /** @brief Test if the capture is armed (or triggered) */
+        bool isArmed() const { return _state != State::Disarmed; }
+
+        /** @brief Test if the capture is triggered: the post-trigger window is in progress */
+        bool isTriggered() const { return _state == State::Triggered; }
+
+        /** @brief Get the paths of the capture files asked to be written since the capture has
+                   been armed */
+        const QStringList &getCaptureFilesPaths() const { return _captureFilesPaths; }
+
+        /** @brief Get the number of captures ended early because the ring was full */
+        quint64 getTruncatedCapturesNb() const { return _truncatedCapturesNb; }
+
+    public slots:
+        /** @brief Add frames to the ring and test the trigger conditions
+            @note This is called when frames are received by an attached device, but you may also
+                  call it to capture frames from another source
+            @param channel The CAN bus interface where the frames have been received
+            @param frames The frames to add */
+        void addFrames(PCanBusItf::Enum channel, const QVector<QCanBusFrame> &frames);
+
+        /** @brief Test if the bus event given triggers the capture
+            @param event The bus event received */
+        void onBusEvent(CanBusEvent::Enum event);
+
+        /** @brief Trigger the capture manually
+            @note The trigger timestamp is the one of the last frame added to the ring
+            @note Nothing is done if the capture isn't armed or is already triggered */
+        void trigger();
+
+    signals:
+        /** @brief Emitted when the capture is triggered
+            @param triggerTimestampInUs The timestamp of the trigger, in us */
+        void triggered(quint64 triggerTimestampInUs);
+
+        /** @brief Emitted when a capture file has been written
+            @param filePath The path of the capture file
+            @param success True if no problem occurred */
+        void captureFileWritten(const QString &filePath, bool success);
+
+    private slots:
+        /** @brief Called when the post-trigger window has elapsed with the host clock */
+        void onPostTriggerTimeout();
+
+    private:
+        /** @brief Encode the frame given in the next slot of the ring
+            @param channel The CAN bus interface where the frame has been received
+            @param frame The frame to store */
+        void storeFrame(PCanBusItf::Enum channel, const QCanBusFrame &frame);
+
+        /** @brief Test if the frame given matches one of the trigger masks
+            @param frame The frame to test
+            @return True if the frame triggers the capture */
+        bool isTriggerFrame(const QCanBusFrame &frame) const;
+
+        /** @brief Start the post-trigger window
+            @param triggerTimestampInUs The timestamp of the trigger, in us */
+        void startTrigger(quint64 triggerTimestampInUs);
+
+        /** @brief End the post-trigger window and write the window frames in a capture file
+            @param truncated True if the window is ended early because the ring is full */
+        void endTrigger(bool truncated);
+
+        /** @brief Get the index of the slot given, from the oldest slot of the ring
+            @param fromOldestIdx The position of the slot from the oldest one
+            @return The slot index */
+        int getSlotIdx(int fromOldestIdx) const
+        { return (_ringHead - _ringSize + fromOldestIdx + _ringCapacity) % _ringCapacity; }
+
+    private:
+        /** @brief The default max number of frames kept in the ring */
+        static const constexpr int DefaultRingCapacity = 65536;
+
+        /** @brief The default duration kept before and after the trigger */
+        static const constexpr int DefaultTriggerWindowInMs = 10000;
+
+        /** @brief The number of digits used to write the capture index in the file name */
+        static const constexpr int FileIndexDigitsNb = 4;
+
+    private:
+        int _ringCapacity{DefaultRingCapacity};
+        int _preTriggerInMs{DefaultTriggerWindowInMs};
+        int _postTriggerInMs{DefaultTriggerWindowInMs};
+        QVector<ExpectedCanFrameMask> _triggerMasks;
+        QVector<CanBusEvent::Enum> _triggerBusEvents;
+        bool _rearmedAfterTrigger{true};
+
+        QHash<CanDeviceIntf*, QVector<QMetaObject::Connection>> _attachedDevices;
+
+        State _state{State::Disarmed};
+        QString _basePath;
+        int _captureIndex{0};
+        QStringList _captureFilesPaths;
+        qint64 _armDateTimeInMs{0};
+
+        QByteArray _ringRecords;
+        QVector<quint64> _ringTimestampsInUs;
+        QVector<quint8> _ringRecordsSizes;
+        int _ringHead{0};
+        int _ringSize{0};
+        quint64 _lastTimestampInUs{0};
+
+        quint64 _triggerTimestampInUs{0};
+        int _windowFramesNb{0};
+        QTimer *_postTriggerTimer{nullptr};
+
+        CanCaptureWriteThread *_writeThread{nullptr};
+        quint64 _truncatedCapturesNb{0};
+};
@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canacceptancefilter.hpp"
+
+
+CanAcceptanceFilter::CanAcceptanceFilter()
+{
+}
+
+void CanAcceptanceFilter::addRange(quint32 firstId, quint32 lastId, bool extendedIds)
+{
+    IdsRange range;
+    range.firstId = firstId;
+    range.lastId = lastId;
+    range.extendedIds = extendedIds;
+    _ranges.append(range);
+}
+
+void CanAcceptanceFilter::addMask(quint32 code, quint32 mask, bool extendedIds)
+{
+    IdsMask idsMask;
+    idsMask.code = code;
+    idsMask.mask = mask;
+    idsMask.extendedIds = extendedIds;
+    _masks.append(idsMask);
+}
+
+void CanAcceptanceFilter::merge(const CanAcceptanceFilter &otherFilter)
+{
+    _ranges.append(otherFilter._ranges);
+    _masks.append(otherFilter._masks);
+}
+
+void CanAcceptanceFilter::clear()
+{
+    _ranges.clear();
+    _masks.clear();
+}
+
+bool CanAcceptanceFilter::accepts(quint32 frameId, bool extendedId) const
+{
+    for(auto citer = _ranges.cbegin(); citer != _ranges.cend(); ++citer)
+    {
+        if(citer->extendedIds == extendedId && frameId >= citer->firstId &&
+           frameId <= citer->lastId)
+        {
+            return true;
+        }
+    }
+
+    for(auto citer = _masks.cbegin(); citer != _masks.cend(); ++citer)
+    {
+        if(citer->extendedIds == extendedId &&
+           (frameId & citer->mask) == (citer->code & citer->mask))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool CanAcceptanceFilter::isValid() const
+{
+    for(auto citer = _ranges.cbegin(); citer != _ranges.cend(); ++citer)
+    {
+        if(citer->firstId > citer->lastId || citer->lastId > getMaxId(citer->extendedIds))
+        {
+            return false;
+        }
+    }
+
+    for(auto citer = _masks.cbegin(); citer != _masks.cend(); ++citer)
+    {
+        if(citer->code > getMaxId(citer->extendedIds))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
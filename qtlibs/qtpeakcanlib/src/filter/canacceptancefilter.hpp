@@ -0,0 +1,119 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QMetaType>
+#include <QVector>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This describes the CAN frames ids accepted by a subscriber of a CAN device
+    @note The filter is made of ids ranges and ids masks; a frame is accepted if it matches one
+          of them. Each rule applies either to the standard ids (11 bits) or to the extended ids
+          (29 bits).
+    @note A frame matches a mask rule if: (frameId & mask) == (code & mask)
+    @see CanDeviceIntf::addAcceptanceSubscription */
+class CAN_EXPORT CanAcceptanceFilter
+{
+    public:
+        /** @brief A range of accepted ids */
+        struct IdsRange
+        {
+            /** @brief The first id of the range */
+            quint32 firstId{0};
+
+            /** @brief The last id of the range (included) */
+            quint32 lastId{0};
+
+            /** @brief True if the range applies to the extended ids */
+            bool extendedIds{false};
+        };
+
+        /** @brief A mask of accepted ids */
+        struct IdsMask
+        {
+            /** @brief The expected bits of the id, after having applied the mask */
+            quint32 code{0};
+
+            /** @brief The bits of the id to test */
+            quint32 mask{0};
+
+            /** @brief True if the mask applies to the extended ids */
+            bool extendedIds{false};
+        };
+
+    public:
+        /** @brief Class constructor
+            @note The filter is empty: it accepts nothing */
+        explicit CanAcceptanceFilter();
+
+    public:
+        /** @brief Get the ranges of accepted ids */
+        const QVector<IdsRange> &getRanges() const { return _ranges; }
+
+        /** @brief Get the masks of accepted ids */
+        const QVector<IdsMask> &getMasks() const { return _masks; }
+
+        /** @brief Test if the filter contains no rule */
+        bool isEmpty() const { return _ranges.isEmpty() && _masks.isEmpty(); }
+
+        /** @brief Accept one id
+            @param frameId The id to accept
+            @param extendedIds True if the id is an extended one */
+        void addId(quint32 frameId, bool extendedIds = false)
+        { addRange(frameId, frameId, extendedIds); }
+
+        /** @brief Accept a range of ids
+            @param firstId The first id of the range
+            @param lastId The last id of the range (included)
+            @param extendedIds True if the range applies to the extended ids */
+        void addRange(quint32 firstId, quint32 lastId, bool extendedIds = false);
+
+        /** @brief Accept the ids which match the mask given
+            @param code The expected bits of the id, after having applied the mask
+            @param mask The bits of the id to test
+            @param extendedIds True if the mask applies to the extended ids */
+        void addMask(quint32 code, quint32 mask, bool extendedIds = false);
+
+        /** @brief Add the rules of another filter to this one
+            @param otherFilter The filter to merge */
+        void merge(const CanAcceptanceFilter &otherFilter);
+
+        /** @brief Remove all the rules */
+        void clear();
+
+        /** @brief Test if the frame id given is accepted by the filter
+            @note This goes through all the rules; on the read path, the filter is compiled to a
+                  @ref CanAcceptanceTable
+            @param frameId The frame id to test
+            @param extendedId True if the id is an extended one
+            @return True if the frame is accepted */
+        bool accepts(quint32 frameId, bool extendedId) const;
+
+        /** @brief Test if the rules are valid: the ids fit in their format and the ranges are
+                   ordered
+            @return True if the filter is valid */
+        bool isValid() const;
+
+    public:
+        /** @brief Get the max id of the format given
+            @param extendedIds True to get the max extended id */
+        static quint32 getMaxId(bool extendedIds)
+        { return extendedIds ? MaxExtendedId : MaxStandardId; }
+
+    private:
+        /** @brief The max value of a standard id */
+        static const constexpr quint32 MaxStandardId = 0x7FF;
+
+        /** @brief The max value of an extended id */
+        static const constexpr quint32 MaxExtendedId = 0x1FFFFFFF;
+
+    private:
+        QVector<IdsRange> _ranges;
+        QVector<IdsMask> _masks;
+};
+
+Q_DECLARE_METATYPE(CanAcceptanceFilter)
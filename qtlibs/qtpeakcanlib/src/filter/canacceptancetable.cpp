@@ -0,0 +1,155 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canacceptancetable.hpp"
+
+#include <algorithm>
+
+
+CanAcceptanceTable::CanAcceptanceTable(const CanAcceptanceFilter &filter)
+{
+    const QVector<CanAcceptanceFilter::IdsRange> &ranges = filter.getRanges();
+    const QVector<CanAcceptanceFilter::IdsMask> &masks = filter.getMasks();
+    const quint32 maxStandardId = CanAcceptanceFilter::getMaxId(false);
+
+    for(auto citer = ranges.cbegin(); citer != ranges.cend(); ++citer)
+    {
+        if(citer->extendedIds)
+        {
+            _extendedRanges.append(*citer);
+            continue;
+        }
+
+        const quint32 lastId = qMin(citer->lastId, maxStandardId);
+        for(quint32 frameId = citer->firstId; frameId <= lastId; ++frameId)
+        {
+            setStandardBit(frameId);
+        }
+    }
+
+    for(auto citer = masks.cbegin(); citer != masks.cend(); ++citer)
+    {
+        if(citer->extendedIds)
+        {
+            _extendedMasks.append(*citer);
+            continue;
+        }
+
+        // There are only 2048 standard ids, the masks are expanded in the bitmap
+        for(quint32 frameId = 0; frameId <= maxStandardId; ++frameId)
+        {
+            if((frameId & citer->mask) == (citer->code & citer->mask))
+            {
+                setStandardBit(frameId);
+            }
+        }
+    }
+
+    // The extended ranges are sorted and merged, to be searched by dichotomy
+    std::sort(_extendedRanges.begin(),
+              _extendedRanges.end(),
+              [](const CanAcceptanceFilter::IdsRange &first,
+                 const CanAcceptanceFilter::IdsRange &second)
+              {
+                  return first.firstId < second.firstId;
+              });
+
+    QVector<CanAcceptanceFilter::IdsRange> mergedRanges;
+    for(auto citer = _extendedRanges.cbegin(); citer != _extendedRanges.cend(); ++citer)
+    {
+        if(!mergedRanges.isEmpty() &&
+           citer->firstId <= (static_cast<quint64>(mergedRanges.last().lastId) + 1))
+        {
+            mergedRanges.last().lastId = qMax(mergedRanges.last().lastId, citer->lastId);
+            continue;
+        }
+
+        mergedRanges.append(*citer);
+    }
+
+    _extendedRanges = mergedRanges;
+}
+
+bool CanAcceptanceTable::getIdsHull(bool extendedIds, quint32 &firstId, quint32 &lastId) const
+{
+    bool found = false;
+    quint32 hullFirstId = 0;
+    quint32 hullLastId = 0;
+
+    const auto addToHull = [&found, &hullFirstId, &hullLastId](quint32 first, quint32 last)
+    {
+        hullFirstId = found ? qMin(hullFirstId, first) : first;
+        hullLastId = found ? qMax(hullLastId, last) : last;
+        found = true;
+    };
+
+    if(!extendedIds)
+    {
+        for(quint32 frameId = 0; frameId < static_cast<quint32>(StandardIdsNb); ++frameId)
+        {
+            if(accepts(frameId, false))
+            {
+                addToHull(frameId, frameId);
+            }
+        }
+    }
+    else
+    {
+        const quint32 maxExtendedId = CanAcceptanceFilter::getMaxId(true);
+
+        for(auto citer = _extendedRanges.cbegin(); citer != _extendedRanges.cend(); ++citer)
+        {
+            addToHull(citer->firstId, citer->lastId);
+        }
+
+        for(auto citer = _extendedMasks.cbegin(); citer != _extendedMasks.cend(); ++citer)
+        {
+            // The ids matching the mask are between the code with all the free bits at 0 and
+            // the code with all the free bits at 1
+            const quint32 fixedBits = (citer->code & citer->mask);
+            addToHull(fixedBits, (fixedBits | ~citer->mask) & maxExtendedId);
+        }
+    }
+
+    if(!found)
+    {
+        return false;
+    }
+
+    firstId = hullFirstId;
+    lastId = hullLastId;
+    return true;
+}
+
+bool CanAcceptanceTable::acceptsExtended(quint32 frameId) const
+{
+    auto rangeIter = std::upper_bound(_extendedRanges.cbegin(),
+                                      _extendedRanges.cend(),
+                                      frameId,
+                                      [](quint32 value, const CanAcceptanceFilter::IdsRange &range)
+                                      {
+                                          return value < range.firstId;
+                                      });
+
+    // The range found is the first one which begins after the id, the previous one may contain it
+    if(rangeIter != _extendedRanges.cbegin() && frameId <= (rangeIter - 1)->lastId)
+    {
+        return true;
+    }
+
+    for(auto citer = _extendedMasks.cbegin(); citer != _extendedMasks.cend(); ++citer)
+    {
+        if((frameId & citer->mask) == (citer->code & citer->mask))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void CanAcceptanceTable::setStandardBit(quint32 frameId)
+{
+    _standardBitmap[frameId / BitsByWord] |= (static_cast<quint64>(1) << (frameId % BitsByWord));
+}
@@ -0,0 +1,78 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <array>
+
+#include <QVector>
+
+#include "src/filter/canacceptancefilter.hpp"
+
+
+/** @brief This is the compiled form of a @ref CanAcceptanceFilter, used by the read thread to
+           test each frame before converting it
+    @note The standard ids are tested with a bitmap of 2048 bits. The extended ids are tested with
+          the ranges sorted and merged (binary search) and then with the masks.
+    @note The object is immutable once created; therefore, it can be shared between threads */
+class CanAcceptanceTable
+{
+    public:
+        /** @brief Class constructor
+            @param filter The filter to compile */
+        explicit CanAcceptanceTable(const CanAcceptanceFilter &filter);
+
+    public:
+        /** @brief Test if the frame id given is accepted
+            @param frameId The frame id to test
+            @param extendedId True if the id is an extended one
+            @return True if the frame is accepted */
+        inline bool accepts(quint32 frameId, bool extendedId) const;
+
+        /** @brief Get the smallest range which contains all the accepted ids of the format given
+            @note This is used to configure the filter of the PEAK driver, which only manages one
+                  range by format
+            @param extendedIds True to get the range of the extended ids
+            @param firstId The first id of the range
+            @param lastId The last id of the range
+            @return False if no id of this format is accepted */
+        bool getIdsHull(bool extendedIds, quint32 &firstId, quint32 &lastId) const;
+
+    private:
+        /** @brief Test if the extended frame id given is accepted
+            @param frameId The frame id to test
+            @return True if the frame is accepted */
+        bool acceptsExtended(quint32 frameId) const;
+
+        /** @brief Set the bit linked to the standard id given in the bitmap
+            @param frameId The standard id to accept */
+        void setStandardBit(quint32 frameId);
+
+    private:
+        /** @brief The number of standard ids */
+        static const constexpr int StandardIdsNb = 2048;
+
+        /** @brief The number of bits in a bitmap word */
+        static const constexpr int BitsByWord = 64;
+
+    private:
+        std::array<quint64, StandardIdsNb / BitsByWord> _standardBitmap{};
+        QVector<CanAcceptanceFilter::IdsRange> _extendedRanges;
+        QVector<CanAcceptanceFilter::IdsMask> _extendedMasks;
+};
+
+inline bool CanAcceptanceTable::accepts(quint32 frameId, bool extendedId) const
+{
+    if(extendedId)
+    {
+        return acceptsExtended(frameId);
+    }
+
+    if(frameId >= static_cast<quint32>(StandardIdsNb))
+    {
+        return false;
+    }
+
+    return (_standardBitmap[frameId / BitsByWord] >> (frameId % BitsByWord)) & 1U;
+}
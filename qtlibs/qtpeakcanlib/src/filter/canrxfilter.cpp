@@ -0,0 +1,24 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canrxfilter.hpp"
+
+#include "src/filter/canacceptancetable.hpp"
+
+
+CanRxFilter::CanRxFilter()
+{
+}
+
+QSharedPointer<const CanAcceptanceTable> CanRxFilter::getTable() const
+{
+    QMutexLocker locker(&_mutex);
+    return _table;
+}
+
+void CanRxFilter::setTable(const QSharedPointer<const CanAcceptanceTable> &table)
+{
+    QMutexLocker locker(&_mutex);
+    _table = table;
+}
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <atomic>
+
+#include <QMutex>
+#include <QSharedPointer>
+
+class CanAcceptanceTable;
+
+
+/** @brief This holds the acceptance table applied by the read thread of a CAN device
+    @note The object is shared between the device thread, which updates the table when the
+          subscriptions change, and the read thread, which gets the current table each time it's
+          woken up (and not for each frame).
+    @note The table is immutable, a new one is set at each update */
+class CanRxFilter
+{
+    public:
+        /** @brief Class constructor
+            @note No table is set: all the frames are accepted */
+        explicit CanRxFilter();
+
+    public:
+        /** @brief Get the current acceptance table
+            @return The table to apply, null if all the frames are accepted */
+        QSharedPointer<const CanAcceptanceTable> getTable() const;
+
+        /** @brief Set the acceptance table
+            @param table The table to apply, null to accept all the frames */
+        void setTable(const QSharedPointer<const CanAcceptanceTable> &table);
+
+        /** @brief Count a frame rejected by the read thread */
+        void addRejectedFrame() { _rejectedFramesNb.fetch_add(1, std::memory_order_relaxed); }
+
+        /** @brief Get the number of frames rejected by the read thread
+            @note The frames rejected by the PEAK driver filter aren't counted */
+        quint64 getRejectedFramesNb() const
+        { return _rejectedFramesNb.load(std::memory_order_relaxed); }
+
+    private:
+        mutable QMutex _mutex;
+        QSharedPointer<const CanAcceptanceTable> _table;
+        std::atomic<quint64> _rejectedFramesNb{0};
+};
@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cangateway.hpp"
+
+#include "src/canlibconstants.hpp"
+#include "src/gateway/cangatewaytable.hpp"
+
+
+CanGateway::CanGateway()
+{
+}
+
+QSharedPointer<const CanGatewayTable> CanGateway::getTable() const
+{
+    QMutexLocker locker(&_mutex);
+    return _table;
+}
+
+void CanGateway::setTable(const QSharedPointer<const CanGatewayTable> &table)
+{
+    QMutexLocker locker(&_mutex);
+    _table = table;
+}
+
+void CanGateway::addForwardedFrame(qint64 latencyInNs)
+{
+    // There is only one writer (the read thread), the min and max don't need a compare exchange
+    if(latencyInNs < _minLatencyInNs.load(std::memory_order_relaxed))
+    {
+        _minLatencyInNs.store(latencyInNs, std::memory_order_relaxed);
+    }
+
+    if(latencyInNs > _maxLatencyInNs.load(std::memory_order_relaxed))
+    {
+        _maxLatencyInNs.store(latencyInNs, std::memory_order_relaxed);
+    }
+
+    _latenciesSumInNs.fetch_add(latencyInNs, std::memory_order_relaxed);
+    _forwardedFramesNb.fetch_add(1, std::memory_order_relaxed);
+}
+
+CanGatewayStats CanGateway::getStats() const
+{
+    const quint64 forwardedFramesNb = _forwardedFramesNb.load(std::memory_order_relaxed);
+
+    qint64 minLatencyInUs = 0;
+    qint64 meanLatencyInUs = 0;
+    qint64 maxLatencyInUs = 0;
+
+    if(forwardedFramesNb > 0)
+    {
+        minLatencyInUs = _minLatencyInNs.load(std::memory_order_relaxed) /
+                         CanLibConstants::Time::MicroToNanoCoeff;
+        maxLatencyInUs = _maxLatencyInNs.load(std::memory_order_relaxed) /
+                         CanLibConstants::Time::MicroToNanoCoeff;
+        meanLatencyInUs = _latenciesSumInNs.load(std::memory_order_relaxed) /
+                          (static_cast<qint64>(forwardedFramesNb) *
+                           CanLibConstants::Time::MicroToNanoCoeff);
+    }
+
+    return CanGatewayStats(forwardedFramesNb,
+                           _failedFramesNb.load(std::memory_order_relaxed),
+                           _incompatibleFramesNb.load(std::memory_order_relaxed),
+                           minLatencyInUs,
+                           meanLatencyInUs,
+                           maxLatencyInUs);
+}
+
+void CanGateway::resetStats()
+{
+    _forwardedFramesNb.store(0, std::memory_order_relaxed);
+    _failedFramesNb.store(0, std::memory_order_relaxed);
+    _incompatibleFramesNb.store(0, std::memory_order_relaxed);
+    _latenciesSumInNs.store(0, std::memory_order_relaxed);
+    _minLatencyInNs.store(std::numeric_limits<qint64>::max(), std::memory_order_relaxed);
+    _maxLatencyInNs.store(0, std::memory_order_relaxed);
+}
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <atomic>
+#include <limits>
+
+#include <QMutex>
+#include <QSharedPointer>
+
+#include "src/gateway/cangatewaystats.hpp"
+
+class CanGatewayTable;
+
+
+/** @brief This holds the gateway table applied by the read thread of a CAN device, and the
+           forwarding statistics
+    @note The object is shared between the device thread, which updates the table when the routes
+          change, and the read thread, which gets the current table each time it's woken up (and
+          not for each frame).
+    @note The table is immutable, a new one is set at each update */
+class CanGateway
+{
+    public:
+        /** @brief Class constructor
+            @note No table is set: no frame is forwarded */
+        explicit CanGateway();
+
+    public:
+        /** @brief Get the current gateway table
+            @return The table to apply, null if no frame is forwarded */
+        QSharedPointer<const CanGatewayTable> getTable() const;
+
+        /** @brief Set the gateway table
+            @param table The table to apply, null to forward nothing */
+        void setTable(const QSharedPointer<const CanGatewayTable> &table);
+
+        /** @brief Count a frame written on the target device
+            @note This has to be called by the read thread only
+            @param latencyInNs The forwarding latency of the frame */
+        void addForwardedFrame(qint64 latencyInNs);
+
+        /** @brief Count a frame which couldn't be written on the target device */
+        void addFailedFrame() { _failedFramesNb.fetch_add(1, std::memory_order_relaxed); }
+
+        /** @brief Count a CAN FD frame which couldn't be forwarded to a classic CAN device */
+        void addIncompatibleFrame()
+        { _incompatibleFramesNb.fetch_add(1, std::memory_order_relaxed); }
+
+        /** @brief Get a snapshot of the statistics */
+        CanGatewayStats getStats() const;
+
+        /** @brief Reset the statistics */
+        void resetStats();
+
+    private:
+        mutable QMutex _mutex;
+        QSharedPointer<const CanGatewayTable> _table;
+
+        std::atomic<quint64> _forwardedFramesNb{0};
+        std::atomic<quint64> _failedFramesNb{0};
+        std::atomic<quint64> _incompatibleFramesNb{0};
+        std::atomic<qint64> _latenciesSumInNs{0};
+        std::atomic<qint64> _minLatencyInNs{std::numeric_limits<qint64>::max()};
+        std::atomic<qint64> _maxLatencyInNs{0};
+};
@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cangatewayroute.hpp"
+
+
+CanGatewayRoute::CanGatewayRoute()
+{
+}
+
+void CanGatewayRoute::setRemappedId(quint32 remappedId, bool extendedId)
+{
+    _idRemapped = true;
+    _remappedId = remappedId;
+    _remappedIdExtended = extendedId;
+}
+
+void CanGatewayRoute::clearRemappedId()
+{
+    _idRemapped = false;
+    _remappedId = 0;
+    _remappedIdExtended = false;
+}
+
+void CanGatewayRoute::setPayloadRewrite(const QByteArray &keepMask, const QByteArray &overwrite)
+{
+    _keepMask = keepMask;
+    _overwrite = overwrite;
+}
+
+bool CanGatewayRoute::isValid() const
+{
+    if(_match.isEmpty() || !_match.isValid() || _targetCanBusItf == PCanBusItf::Unknown)
+    {
+        return false;
+    }
+
+    if(_idRemapped && _remappedId > CanAcceptanceFilter::getMaxId(_remappedIdExtended))
+    {
+        return false;
+    }
+
+    return (_keepMask.length() == _overwrite.length()) && (_keepMask.length() <= MaxPayloadSize);
+}
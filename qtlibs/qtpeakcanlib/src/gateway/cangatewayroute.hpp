@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+#include <QMetaType>
+
+#include "src/definescan.hpp"
+#include "src/filter/canacceptancefilter.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+
+
+/** @brief This describes a route of the CAN gateway: the frames received by the source device
+           which match the route are written on the target device
+    @note The frame id may be remapped, and the payload bytes may be rewritten:
+          newByte = (byte & keepMask) | (overwrite & ~keepMask)
+    @see CanDeviceIntf::setGatewayRoutes */
+class CAN_EXPORT CanGatewayRoute
+{
+    public:
+        /** @brief Class constructor
+            @note The route matches nothing and has no target */
+        explicit CanGatewayRoute();
+
+    public:
+        /** @brief Get the ids matched by the route */
+        const CanAcceptanceFilter &getMatch() const { return _match; }
+
+        /** @brief Set the ids matched by the route
+            @param match The ids to route */
+        void setMatch(const CanAcceptanceFilter &match) { _match = match; }
+
+        /** @brief Get the CAN bus interface where the matching frames are written */
+        PCanBusItf::Enum getTargetCanBusItf() const { return _targetCanBusItf; }
+
+        /** @brief Set the CAN bus interface where the matching frames are written
+            @note The target device has to be created and initialized to forward the frames */
+        void setTargetCanBusItf(PCanBusItf::Enum targetCanBusItf)
+        { _targetCanBusItf = targetCanBusItf; }
+
+        /** @brief Test if the id of the forwarded frames is remapped */
+        bool isIdRemapped() const { return _idRemapped; }
+
+        /** @brief Get the id of the forwarded frames, if the id is remapped */
+        quint32 getRemappedId() const { return _remappedId; }
+
+        /** @brief Test if the remapped id is an extended one */
+        bool isRemappedIdExtended() const { return _remappedIdExtended; }
+
+        /** @brief Remap the id of the forwarded frames
+            @param remappedId The id to write on the target device
+            @param extendedId True if the remapped id is an extended one */
+        void setRemappedId(quint32 remappedId, bool extendedId = false);
+
+        /** @brief Keep the id of the forwarded frames */
+        void clearRemappedId();
+
+        /** @brief Get the mask of the payload bits to keep */
+        const QByteArray &getKeepMask() const { return _keepMask; }
+
+        /** @brief Get the bits written in the payload, where the keep mask is 0 */
+        const QByteArray &getOverwrite() const { return _overwrite; }
+
+        /** @brief Set the rewriting of the payload
+            @note The bytes after the mask length aren't modified; the payload length isn't
+                  modified
+            @param keepMask The mask of the payload bits to keep
+            @param overwrite The bits written where the keep mask is 0, it has to have the same
+                             length as the keep mask */
+        void setPayloadRewrite(const QByteArray &keepMask, const QByteArray &overwrite);
+
+        /** @brief Test if the matching frames are also given to the source device consumers */
+        bool isDeliveredLocally() const { return _deliveredLocally; }
+
+        /** @brief Set if the matching frames are also given to the source device consumers
+            @note If false, the frames are only forwarded; the source device consumers don't get
+                  them, even if they have subscribed to them */
+        void setDeliveredLocally(bool deliveredLocally) { _deliveredLocally = deliveredLocally; }
+
+        /** @brief Test if the route is valid: the match and the rewriting are valid and the
+                   target is known
+            @return True if the route is valid */
+        bool isValid() const;
+
+    private:
+        /** @brief The max payload length of a CAN FD frame */
+        static const constexpr int MaxPayloadSize = 64;
+
+    private:
+        CanAcceptanceFilter _match;
+        PCanBusItf::Enum _targetCanBusItf{PCanBusItf::Unknown};
+        bool _idRemapped{false};
+        quint32 _remappedId{0};
+        bool _remappedIdExtended{false};
+        QByteArray _keepMask;
+        QByteArray _overwrite;
+        bool _deliveredLocally{true};
+};
+
+Q_DECLARE_METATYPE(CanGatewayRoute)
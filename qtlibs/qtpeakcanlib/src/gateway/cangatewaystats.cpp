@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cangatewaystats.hpp"
+
+#include <QString>
+
+
+CanGatewayStats::CanGatewayStats(quint64 forwardedFramesNb,
+                                 quint64 failedFramesNb,
+                                 quint64 incompatibleFramesNb,
+                                 qint64 minLatencyInUs,
+                                 qint64 meanLatencyInUs,
+                                 qint64 maxLatencyInUs)
+    : _forwardedFramesNb{forwardedFramesNb},
+    _failedFramesNb{failedFramesNb},
+    _incompatibleFramesNb{incompatibleFramesNb},
+    _minLatencyInUs{minLatencyInUs},
+    _meanLatencyInUs{meanLatencyInUs},
+    _maxLatencyInUs{maxLatencyInUs}
+{
+}
+
+QString CanGatewayStats::toString() const
+{
+    return QString("forwarded: %1, failed: %2, incompatible: %3, latency (min/mean/max): "
+                   "%4/%5/%6 us")
+        .arg(_forwardedFramesNb)
+        .arg(_failedFramesNb)
+        .arg(_incompatibleFramesNb)
+        .arg(_minLatencyInUs)
+        .arg(_meanLatencyInUs)
+        .arg(_maxLatencyInUs);
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This is a snapshot of the statistics of the gateway of a CAN device
+    @note The forwarding latency is measured by the read thread of the source device, from the
+          reading of the frame to the end of its writing in the target device queue */
+class CAN_EXPORT CanGatewayStats
+{
+    public:
+        /** @brief Class constructor
+            @param forwardedFramesNb The number of frames written on the target devices
+            @param failedFramesNb The number of frames which couldn't be written on the target
+                                  devices
+            @param incompatibleFramesNb The number of CAN FD frames which couldn't be forwarded
+                                        to a classic CAN device
+            @param minLatencyInUs The min forwarding latency
+            @param meanLatencyInUs The mean forwarding latency
+            @param maxLatencyInUs The max forwarding latency */
+        explicit CanGatewayStats(quint64 forwardedFramesNb = 0,
+                                 quint64 failedFramesNb = 0,
+                                 quint64 incompatibleFramesNb = 0,
+                                 qint64 minLatencyInUs = 0,
+                                 qint64 meanLatencyInUs = 0,
+                                 qint64 maxLatencyInUs = 0);
+
+    public:
+        /** @brief Get the number of frames written on the target devices */
+        quint64 getForwardedFramesNb() const { return _forwardedFramesNb; }
+
+        /** @brief Get the number of frames which couldn't be written on the target devices
+            @note This happens if the target device isn't initialized or if its transmit queue is
+                  full */
+        quint64 getFailedFramesNb() const { return _failedFramesNb; }
+
+        /** @brief Get the number of CAN FD frames which couldn't be forwarded to a classic CAN
+                   device */
+        quint64 getIncompatibleFramesNb() const { return _incompatibleFramesNb; }
+
+        /** @brief Get the min forwarding latency in us, 0 if no frame has been forwarded */
+        qint64 getMinLatencyInUs() const { return _minLatencyInUs; }
+
+        /** @brief Get the mean forwarding latency in us, 0 if no frame has been forwarded */
+        qint64 getMeanLatencyInUs() const { return _meanLatencyInUs; }
+
+        /** @brief Get the max forwarding latency in us, 0 if no frame has been forwarded */
+        qint64 getMaxLatencyInUs() const { return _maxLatencyInUs; }
+
+        /** @brief Get a string representation of the stats, useful for logs */
+        QString toString() const;
+
+    private:
+        quint64 _forwardedFramesNb;
+        quint64 _failedFramesNb;
+        quint64 _incompatibleFramesNb;
+        qint64 _minLatencyInUs;
+        qint64 _meanLatencyInUs;
+        qint64 _maxLatencyInUs;
+};
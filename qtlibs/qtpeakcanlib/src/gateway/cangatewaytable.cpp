@@ -0,0 +1,79 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cangatewaytable.hpp"
+
+#include "src/metrics/canbusmetrics.hpp"
+
+
+CanGatewayTable::CanGatewayTable(
+    const QVector<CanGatewayRoute> &routes,
+    const QHash<PCanBusItf::Enum, bool> &targetsCanFd,
+    const QHash<PCanBusItf::Enum, QSharedPointer<CanBusMetrics>> &targetsMetrics)
+{
+    _standardRoutesIdxs.fill(NoRouteIdx);
+
+    for(auto citer = routes.cbegin(); citer != routes.cend(); ++citer)
+    {
+        Route route;
+        route.targetCanBusItf = citer->getTargetCanBusItf();
+        route.targetCanFd = targetsCanFd.value(route.targetCanBusItf, false);
+        route.targetMetrics = targetsMetrics.value(route.targetCanBusItf);
+        route.idRemapped = citer->isIdRemapped();
+        route.remappedId = citer->getRemappedId();
+        route.remappedIdExtended = citer->isRemappedIdExtended();
+        route.deliveredLocally = citer->isDeliveredLocally();
+
+        const QByteArray &keepMask = citer->getKeepMask();
+        const QByteArray &overwrite = citer->getOverwrite();
+        route.rewriteLength = qMin(keepMask.length(), static_cast<int>(route.keepMask.size()));
+        for(int idx = 0; idx < route.rewriteLength; ++idx)
+        {
+            route.keepMask[idx] = static_cast<quint8>(keepMask.at(idx));
+            route.overwrite[idx] = static_cast<quint8>(overwrite.at(idx));
+        }
+
+        _routes.append(route);
+        _routesMatches.append(CanAcceptanceTable(citer->getMatch()));
+        _matchFilter.merge(citer->getMatch());
+
+        const QVector<CanAcceptanceFilter::IdsRange> &ranges = citer->getMatch().getRanges();
+        const QVector<CanAcceptanceFilter::IdsMask> &masks = citer->getMatch().getMasks();
+        for(auto rangeIter = ranges.cbegin(); rangeIter != ranges.cend(); ++rangeIter)
+        {
+            _hasExtendedRoutes |= rangeIter->extendedIds;
+        }
+
+        for(auto maskIter = masks.cbegin(); maskIter != masks.cend(); ++maskIter)
+        {
+            _hasExtendedRoutes |= maskIter->extendedIds;
+        }
+    }
+
+    for(int frameId = 0; frameId < StandardIdsNb; ++frameId)
+    {
+        for(int routeIdx = 0; routeIdx < _routesMatches.length(); ++routeIdx)
+        {
+            if(_routesMatches.at(routeIdx).accepts(static_cast<quint32>(frameId), false))
+            {
+                // The first matching route is used
+                _standardRoutesIdxs[frameId] = static_cast<qint16>(routeIdx);
+                break;
+            }
+        }
+    }
+}
+
+const CanGatewayTable::Route *CanGatewayTable::findExtendedRoute(quint32 frameId) const
+{
+    for(int routeIdx = 0; routeIdx < _routesMatches.length(); ++routeIdx)
+    {
+        if(_routesMatches.at(routeIdx).accepts(frameId, true))
+        {
+            return &_routes.at(routeIdx);
+        }
+    }
+
+    return nullptr;
+}
@@ -0,0 +1,141 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <array>
+
+#include <QHash>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "src/filter/canacceptancefilter.hpp"
+#include "src/filter/canacceptancetable.hpp"
+#include "src/gateway/cangatewayroute.hpp"
+
+class CanBusMetrics;
+
+/** @brief This is the compiled form of the gateway routes of a CAN device, used by the read
+           thread to forward each frame before converting it
+    @note When several routes match a frame, the first one is used.
+    @note The standard ids are resolved with a table of 2048 route indexes. The extended ids are
+          tested with the compiled match of each route.
+    @note The object is immutable once created; therefore, it can be shared between threads */
+class CanGatewayTable
+{
+    public:
+        /** @brief The compiled form of a route */
+        struct Route
+        {
+            /** @brief The CAN bus interface where the frames are written */
+            PCanBusItf::Enum targetCanBusItf{PCanBusItf::Unknown};
+
+            /** @brief True if the target device communicates with CAN FD */
+            bool targetCanFd{false};
+
+            /** @brief The metrics of the target device, where the forwarded frames are counted
+                @note Null if the target device wasn't initialized when the routes were set */
+            QSharedPointer<CanBusMetrics> targetMetrics;
+
+            /** @brief True if the id of the forwarded frames is remapped */
+            bool idRemapped{false};
+
+            /** @brief The id of the forwarded frames, if the id is remapped */
+            quint32 remappedId{0};
+
+            /** @brief True if the remapped id is an extended one */
+            bool remappedIdExtended{false};
+
+            /** @brief True if the frames are also given to the source device consumers */
+            bool deliveredLocally{true};
+
+            /** @brief The number of payload bytes to rewrite */
+            int rewriteLength{0};
+
+            /** @brief The mask of the payload bits to keep */
+            std::array<quint8, 64> keepMask{};
+
+            /** @brief The bits written where the keep mask is 0 */
+            std::array<quint8, 64> overwrite{};
+
+            /** @brief Rewrite the payload given
+                @param data The payload to rewrite
+                @param length The payload length */
+            inline void rewrite(quint8 *data, int length) const;
+        };
+
+    public:
+        /** @brief Class constructor
+            @note The routes have to be valid
+            @param routes The routes to compile
+            @param targetsCanFd Say, for each target CAN bus interface, if the device communicates
+                                with CAN FD
+            @param targetsMetrics The metrics of each target CAN bus interface, a missing target
+                                  doesn't count the forwarded frames */
+        explicit CanGatewayTable(
+            const QVector<CanGatewayRoute> &routes,
+            const QHash<PCanBusItf::Enum, bool> &targetsCanFd,
+            const QHash<PCanBusItf::Enum, QSharedPointer<CanBusMetrics>> &targetsMetrics);
+
+    public:
+        /** @brief Find the route of the frame id given
+            @param frameId The frame id to route
+            @param extendedId True if the id is an extended one
+            @return The route to use, or nullptr if the frame isn't routed */
+        inline const Route *findRoute(quint32 frameId, bool extendedId) const;
+
+        /** @brief Get the ids matched by all the routes
+            @note This is used to let the routed frames pass through the driver filter */
+        const CanAcceptanceFilter &getMatchFilter() const { return _matchFilter; }
+
+        /** @brief Test if the table contains no route */
+        bool isEmpty() const { return _routes.isEmpty(); }
+
+    private:
+        /** @brief Find the route of the extended frame id given
+            @param frameId The frame id to route
+            @return The route to use, or nullptr if the frame isn't routed */
+        const Route *findExtendedRoute(quint32 frameId) const;
+
+    private:
+        /** @brief The number of standard ids */
+        static const constexpr int StandardIdsNb = 2048;
+
+        /** @brief The route index used when no route matches a standard id */
+        static const constexpr qint16 NoRouteIdx = -1;
+
+    private:
+        QVector<Route> _routes;
+        QVector<CanAcceptanceTable> _routesMatches;
+        std::array<qint16, StandardIdsNb> _standardRoutesIdxs{};
+        bool _hasExtendedRoutes{false};
+        CanAcceptanceFilter _matchFilter;
+};
+
+inline void CanGatewayTable::Route::rewrite(quint8 *data, int length) const
+{
+    const int rewrittenLength = qMin(length, rewriteLength);
+    for(int idx = 0; idx < rewrittenLength; ++idx)
+    {
+        data[idx] = static_cast<quint8>((data[idx] & keepMask[idx]) |
+                                        (overwrite[idx] & ~keepMask[idx]));
+    }
+}
+
+inline const CanGatewayTable::Route *CanGatewayTable::findRoute(quint32 frameId,
+                                                                bool extendedId) const
+{
+    if(extendedId)
+    {
+        return _hasExtendedRoutes ? findExtendedRoute(frameId) : nullptr;
+    }
+
+    if(frameId >= static_cast<quint32>(StandardIdsNb))
+    {
+        return nullptr;
+    }
+
+    const qint16 routeIdx = _standardRoutesIdxs[frameId];
+    return (routeIdx == NoRouteIdx) ? nullptr : &_routes.at(routeIdx);
+}
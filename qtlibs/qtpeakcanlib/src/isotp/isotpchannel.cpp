@@ -0,0 +1,594 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "isotpchannel.hpp"
+
+#include <QDebug>
+#include <QTimer>
+#include <QtEndian>
+
+#include "definesutility/definesutility.hpp"
+
+#include "src/candevice/candevice.hpp"
+#include "src/canlibconstants.hpp"
+#include "src/pcanapi/pcanframedlc.hpp"
+
+
+IsoTpChannel::IsoTpChannel(const IsoTpConfig &config, CanDevice &device, QObject *parent)
+    : QObject{parent},
+    _config{config},
+    _device{device},
+    _txTimer{new QTimer(this)},
+    _rxTimer{new QTimer(this)}
+{
+    _txTimer->setSingleShot(true);
+    _txTimer->setTimerType(Qt::PreciseTimer);
+    _rxTimer->setSingleShot(true);
+
+    connect(_txTimer, &QTimer::timeout, this, &IsoTpChannel::onTxTimerTimeout);
+    connect(_rxTimer, &QTimer::timeout, this, &IsoTpChannel::onRxTimerTimeout);
+
+    // The channel lives in the device thread, the frames are directly given
+    connect(&_device, &CanDevice::framesReceived, this, &IsoTpChannel::onFramesReceived);
+}
+
+IsoTpChannel::~IsoTpChannel()
+{
+}
+
+bool IsoTpChannel::send(const QByteArray &message)
+{
+    if(isSending())
+    {
+        qWarning() << "The ISO-TP channel with the tx id: " << _config.getTxId() << ", is already "
+                   << "sending a message, we can't send a new one";
+        return false;
+    }
+
+    if(message.isEmpty())
+    {
+        qWarning() << "We can't send an empty ISO-TP message";
+        return false;
+    }
+
+    const int messageLength = message.size();
+
+    if(messageLength <= getMaxSingleFrameLength())
+    {
+        QByteArray payload;
+        if(messageLength <= MaxShortSingleFrameLength)
+        {
+            payload.append(static_cast<char>(SingleFramePci | messageLength));
+        }
+        else
+        {
+            payload.append(static_cast<char>(SingleFramePci));
+            payload.append(static_cast<char>(messageLength));
+        }
+
+        payload.append(message);
+
+        RETURN_IF_FALSE(writeFrame(payload));
+
+        emit sendFinished(true);
+        return true;
+    }
+
+    QByteArray payload;
+    payload.reserve(_config.getFrameDataLength());
+
+    if(messageLength <= MaxShortFirstFrameLength)
+    {
+        const int lengthHighNibble = (messageLength >> 8) & PciLowNibbleMask;
+        payload.append(static_cast<char>(FirstFramePci | lengthHighNibble));
+        payload.append(static_cast<char>(messageLength & 0xFF));
+    }
+    else
+    {
+        char lengthBytes[sizeof(quint32)];
+        qToBigEndian(static_cast<quint32>(messageLength), lengthBytes);
+
+        payload.append(static_cast<char>(FirstFramePci));
+        payload.append('\0');
+        payload.append(lengthBytes, sizeof(quint32));
+    }
+
+    const int dataLength = _config.getFrameDataLength() - payload.size();
+    payload.append(message.constData(), dataLength);
+
+    RETURN_IF_FALSE(writeFrame(payload));
+
+    _txMessage = message;
+    _txOffset = dataLength;
+    _txSequenceNb = 1;
+    _txWaitFramesNb = 0;
+    _txWriteFailureTimer.invalidate();
+    _txState = TxState::WaitingFlowControl;
+    _txTimer->start(_config.getFlowControlTimeoutInMs());
+
+    return true;
+}
+
+bool IsoTpChannel::cancelSending()
+{
+    if(isSending())
+    {
+        finishSending(false);
+    }
+
+    return true;
+}
+
+void IsoTpChannel::onFramesReceived(const QVector<QCanBusFrame> &frames)
+{
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        if(citer->frameId() != _config.getRxId() ||
+           citer->hasExtendedFrameFormat() != _config.isExtendedIds() ||
+           citer->frameType() != QCanBusFrame::DataFrame)
+        {
+            continue;
+        }
+
+        processFrame(citer->payload());
+    }
+}
+
+void IsoTpChannel::onTxTimerTimeout()
+{
+    switch(_txState)
+    {
+        case TxState::WaitingFlowControl:
+            qWarning() << "The ISO-TP flow control hasn't been received in time on the channel "
+                       << "with the tx id: " << _config.getTxId() << ", the sending is aborted";
+            finishSending(false);
+            break;
+
+        case TxState::SendingConsecutiveFrames:
+            sendConsecutiveFrames();
+            break;
+
+        case TxState::Idle:
+            break;
+    }
+}
+
+void IsoTpChannel::onRxTimerTimeout()
+{
+    qWarning() << "The ISO-TP consecutive frame hasn't been received in time on the channel with "
+               << "the rx id: " << _config.getRxId() << ", the reception is aborted";
+    abortReception();
+}
+
+void IsoTpChannel::processFrame(const QByteArray &payload)
+{
+    if(payload.isEmpty())
+    {
+        return;
+    }
+
+    switch(static_cast<quint8>(payload.at(0)) & PciTypeMask)
+    {
+        case SingleFramePci:
+            processSingleFrame(payload);
+            break;
+
+        case FirstFramePci:
+            processFirstFrame(payload);
+            break;
+
+        case ConsecutiveFramePci:
+            processConsecutiveFrame(payload);
+            break;
+
+        case FlowControlPci:
+            processFlowControl(payload);
+            break;
+
+        default:
+            // The unknown frames are ignored, as required by the ISO 15765-2
+            break;
+    }
+}
+
+void IsoTpChannel::processSingleFrame(const QByteArray &payload)
+{
+    int length = static_cast<quint8>(payload.at(0)) & PciLowNibbleMask;
+    int offset = 1;
+
+    if(length == 0 && payload.size() > IsoTpConfig::ClassicFrameDataLength)
+    {
+        // This is a CAN FD single frame, the length is in the second byte
+        length = static_cast<quint8>(payload.at(1));
+        offset = 2;
+    }
+
+    if(length == 0 || (offset + length) > payload.size())
+    {
+        qWarning() << "The ISO-TP single frame received: " << payload.toHex() << ", isn't valid, "
+                   << "we ignore it";
+        return;
+    }
+
+    if(_rxInProgress)
+    {
+        qWarning() << "An ISO-TP single frame has been received while a segmented message was "
+                   << "received on the channel with the rx id: " << _config.getRxId() << ", the "
+                   << "current reception is aborted";
+        abortReception();
+    }
+
+    emit messageReceived(payload.mid(offset, length));
+}
+
+void IsoTpChannel::processFirstFrame(const QByteArray &payload)
+{
+    if(payload.size() < ShortFirstFramePciLength)
+    {
+        return;
+    }
+
+    quint32 length = (static_cast<quint32>(static_cast<quint8>(payload.at(0)) & PciLowNibbleMask)
+                      << 8) | static_cast<quint8>(payload.at(1));
+    int offset = ShortFirstFramePciLength;
+
+    if(length == 0)
+    {
+        if(payload.size() < LongFirstFramePciLength)
+        {
+            return;
+        }
+
+        length = qFromBigEndian<quint32>(payload.constData() + ShortFirstFramePciLength);
+        offset = LongFirstFramePciLength;
+    }
+
+    if(_rxInProgress)
+    {
+        qWarning() << "An ISO-TP first frame has been received while a segmented message was "
+                   << "received on the channel with the rx id: " << _config.getRxId() << ", the "
+                   << "current reception is aborted";
+        abortReception();
+    }
+
+    if(length > static_cast<quint32>(_config.getMaxRxMessageSize()))
+    {
+        qWarning() << "The ISO-TP message announced: " << length << " bytes, is bigger than the "
+                   << "max size: " << _config.getMaxRxMessageSize() << ", we refuse it";
+        writeFlowControl(FlowStatusOverflow);
+        return;
+    }
+
+    _rxExpectedLength = static_cast<int>(length);
+    _rxMessage.clear();
+    _rxMessage.reserve(_rxExpectedLength);
+    _rxMessage.append(payload.constData() + offset,
+                      qMin(payload.size() - offset, _rxExpectedLength));
+    _rxSequenceNb = 1;
+    _rxBlockCounter = 0;
+    _rxInProgress = true;
+
+    if(!writeFlowControl(FlowStatusContinue))
+    {
+        abortReception();
+        return;
+    }
+
+    _rxTimer->start(_config.getConsecutiveFrameTimeoutInMs());
+}
+
+void IsoTpChannel::processConsecutiveFrame(const QByteArray &payload)
+{
+    if(!_rxInProgress)
+    {
+        // The frame isn't expected, we ignore it
+        return;
+    }
+
+    const quint8 sequenceNb = static_cast<quint8>(payload.at(0)) & PciLowNibbleMask;
+    if(sequenceNb != _rxSequenceNb)
+    {
+        qWarning() << "The ISO-TP consecutive frame received has the sequence number: "
+                   << sequenceNb << ", instead of: " << _rxSequenceNb << ", the reception is "
+                   << "aborted";
+        abortReception();
+        return;
+    }
+
+    const int remainingLength = _rxExpectedLength - _rxMessage.size();
+    _rxMessage.append(payload.constData() + 1, qMin(payload.size() - 1, remainingLength));
+    _rxSequenceNb = (_rxSequenceNb + 1) & PciLowNibbleMask;
+
+    if(_rxMessage.size() >= _rxExpectedLength)
+    {
+        _rxTimer->stop();
+        _rxInProgress = false;
+
+        QByteArray message;
+        message.swap(_rxMessage);
+        emit messageReceived(message);
+        return;
+    }
+
+    const quint8 blockSize = _config.getBlockSize();
+    if(blockSize > 0 && ++_rxBlockCounter >= blockSize)
+    {
+        _rxBlockCounter = 0;
+
+        if(!writeFlowControl(FlowStatusContinue))
+        {
+            abortReception();
+            return;
+        }
+    }
+
+    _rxTimer->start(_config.getConsecutiveFrameTimeoutInMs());
+}
+
+void IsoTpChannel::processFlowControl(const QByteArray &payload)
+{
+    if(_txState != TxState::WaitingFlowControl)
+    {
+        // The flow control isn't expected, we ignore it
+        return;
+    }
+
+    if(payload.size() < 3)
+    {
+        qWarning() << "The ISO-TP flow control received: " << payload.toHex() << ", is too "
+                   << "short, we ignore it";
+        return;
+    }
+
+    const quint8 flowStatus = static_cast<quint8>(payload.at(0)) & PciLowNibbleMask;
+
+    switch(flowStatus)
+    {
+        case FlowStatusContinue:
+        {
+            const quint8 blockSize = static_cast<quint8>(payload.at(1));
+
+            _txTimer->stop();
+            _txWaitFramesNb = 0;
+            _txBlockRemainingNb = (blockSize == 0) ? -1 : blockSize;
+            _txSeparationTimeInUs = decodeSeparationTime(static_cast<quint8>(payload.at(2)));
+            _txSeparationNeeded = false;
+            _txState = TxState::SendingConsecutiveFrames;
+
+            sendConsecutiveFrames();
+            break;
+        }
+
+        case FlowStatusWait:
+            ++_txWaitFramesNb;
+
+            if(_txWaitFramesNb > _config.getMaxWaitFramesNb())
+            {
+                qWarning() << "The ISO-TP receiver has asked to wait more than: "
+                           << _config.getMaxWaitFramesNb() << " times, the sending is aborted";
+                finishSending(false);
+                break;
+            }
+
+            _txTimer->start(_config.getFlowControlTimeoutInMs());
+            break;
+
+        case FlowStatusOverflow:
+            qWarning() << "The ISO-TP receiver can't receive a message of: " << _txMessage.size()
+                       << " bytes, the sending is aborted";
+            finishSending(false);
+            break;
+
+        default:
+            qWarning() << "The ISO-TP flow status: " << flowStatus << ", isn't valid, the sending "
+                       << "is aborted";
+            finishSending(false);
+            break;
+    }
+}
+
+void IsoTpChannel::sendConsecutiveFrames()
+{
+    const int maxDataLength = _config.getFrameDataLength() - 1;
+    const qint64 separationTimeInNs = _txSeparationTimeInUs *
+                                      CanLibConstants::Time::MicroToNanoCoeff;
+    int sentFramesNb = 0;
+
+    while(_txOffset < _txMessage.size())
+    {
+        if(_txBlockRemainingNb == 0)
+        {
+            _txState = TxState::WaitingFlowControl;
+            _txTimer->start(_config.getFlowControlTimeoutInMs());
+            return;
+        }
+
+        if(sentFramesNb >= MaxFramesNbByBurst)
+        {
+            // Let the device thread process its events before continuing
+            _txTimer->start(0);
+            return;
+        }
+
+        if(_txSeparationNeeded && separationTimeInNs > 0)
+        {
+            const qint64 remainingInNs = separationTimeInNs - _txLastFrameTimer.nsecsElapsed();
+
+            if(remainingInNs > 0 &&
+               _txSeparationTimeInUs >= CanLibConstants::Time::MilliToMicroCoeff)
+            {
+                const qint64 milliToNanoCoeff = CanLibConstants::Time::MilliToNanoCoeff;
+                _txTimer->start(static_cast<int>((remainingInNs + milliToNanoCoeff - 1) /
+                                                 milliToNanoCoeff));
+                return;
+            }
+
+            while(_txLastFrameTimer.nsecsElapsed() < separationTimeInNs)
+            {
+                // Active wait, the timers resolution is too low for this separation time
+            }
+        }
+
+        const int dataLength = qMin(maxDataLength, _txMessage.size() - _txOffset);
+
+        QByteArray payload;
+        payload.reserve(dataLength + 1);
+        payload.append(static_cast<char>(ConsecutiveFramePci | _txSequenceNb));
+        payload.append(_txMessage.constData() + _txOffset, dataLength);
+
+        if(!writeFrame(payload))
+        {
+            if(!_txWriteFailureTimer.isValid())
+            {
+                _txWriteFailureTimer.start();
+            }
+            else if(_txWriteFailureTimer.hasExpired(_config.getWriteTimeoutInMs()))
+            {
+                qWarning() << "The ISO-TP consecutive frame can't be written for more than: "
+                           << _config.getWriteTimeoutInMs() << "ms, the sending is aborted";
+                finishSending(false);
+                return;
+            }
+
+            // The CAN driver transmit queue is probably full, we retry later
+            _txTimer->start(WriteRetryDelayInMs);
+            return;
+        }
+
+        _txWriteFailureTimer.invalidate();
+        _txLastFrameTimer.start();
+        _txSeparationNeeded = true;
+
+        _txOffset += dataLength;
+        _txSequenceNb = (_txSequenceNb + 1) & PciLowNibbleMask;
+
+        if(_txBlockRemainingNb > 0)
+        {
+            --_txBlockRemainingNb;
+        }
+
+        ++sentFramesNb;
+    }
+
+    finishSending(true);
+}
+
+void IsoTpChannel::finishSending(bool success)
+{
+    _txTimer->stop();
+    _txState = TxState::Idle;
+    _txMessage.clear();
+    _txWriteFailureTimer.invalidate();
+
+    emit sendFinished(success);
+}
+
+void IsoTpChannel::abortReception()
+{
+    _rxTimer->stop();
+    _rxInProgress = false;
+    _rxMessage.clear();
+
+    emit receptionFailed();
+}
+
+bool IsoTpChannel::writeFlowControl(quint8 flowStatus)
+{
+    QByteArray payload;
+    payload.append(static_cast<char>(FlowControlPci | flowStatus));
+    payload.append(static_cast<char>(_config.getBlockSize()));
+    payload.append(static_cast<char>(encodeSeparationTime(_config.getSeparationTimeInUs())));
+
+    return writeFrame(payload);
+}
+
+bool IsoTpChannel::writeFrame(const QByteArray &payload)
+{
+    int frameLength = payload.size();
+
+    if(frameLength > IsoTpConfig::ClassicFrameDataLength)
+    {
+        // The CAN FD frames have to be padded to the next valid DLC size
+        while(PCanFrameDlc::parseFromSize(frameLength) == PCanFrameDlc::Unknown)
+        {
+            ++frameLength;
+        }
+    }
+    else if(_config.isPaddingEnabled())
+    {
+        frameLength = IsoTpConfig::ClassicFrameDataLength;
+    }
+
+    QByteArray data = payload;
+    if(frameLength > data.size())
+    {
+        data.append(frameLength - data.size(), static_cast<char>(_config.getPaddingByte()));
+    }
+
+    QCanBusFrame frame(_config.getTxId(), data);
+    frame.setExtendedFrameFormat(_config.isExtendedIds());
+
+    if(_config.isCanFd())
+    {
+        frame.setFlexibleDataRateFormat(true);
+        frame.setBitrateSwitch(_config.isBitrateSwitch());
+    }
+
+    return _device.write(frame);
+}
+
+int IsoTpChannel::getMaxSingleFrameLength() const
+{
+    if(_config.getFrameDataLength() > IsoTpConfig::ClassicFrameDataLength)
+    {
+        // With CAN FD, the length is written in the second byte
+        return _config.getFrameDataLength() - 2;
+    }
+
+    return MaxShortSingleFrameLength;
+}
+
+quint8 IsoTpChannel::encodeSeparationTime(int separationTimeInUs)
+{
+    if(separationTimeInUs <= 0)
+    {
+        return 0;
+    }
+
+    if(separationTimeInUs < CanLibConstants::Time::MilliToMicroCoeff)
+    {
+        const int steps = (separationTimeInUs + SubMilliSeparationStepInUs - 1) /
+                          SubMilliSeparationStepInUs;
+
+        if((SubMilliSeparationBase + steps) <= MaxSubMilliSeparationTime)
+        {
+            return static_cast<quint8>(SubMilliSeparationBase + steps);
+        }
+
+        // Rounded up to 1 ms
+        return 1;
+    }
+
+    const int milliToMicroCoeff = static_cast<int>(CanLibConstants::Time::MilliToMicroCoeff);
+    const int separationTimeInMs = (separationTimeInUs + milliToMicroCoeff - 1) /
+                                   milliToMicroCoeff;
+
+    return static_cast<quint8>(qMin(separationTimeInMs,
+                                    static_cast<int>(MaxMilliSeparationTime)));
+}
+
+int IsoTpChannel::decodeSeparationTime(quint8 stMin)
+{
+    if(stMin <= MaxMilliSeparationTime)
+    {
+        return stMin * static_cast<int>(CanLibConstants::Time::MilliToMicroCoeff);
+    }
+
+    if(stMin > SubMilliSeparationBase && stMin <= MaxSubMilliSeparationTime)
+    {
+        return (stMin - SubMilliSeparationBase) * SubMilliSeparationStepInUs;
+    }
+
+    return MaxMilliSeparationTime * static_cast<int>(CanLibConstants::Time::MilliToMicroCoeff);
+}
@@ -0,0 +1,237 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+
+#include "src/isotp/isotpconfig.hpp"
+
+class CanDevice;
+class QTimer;
+
+
+/** @brief This class segments and reassembles the ISO-TP (ISO 15765-2) messages of a channel
+    @note The object lives in the CAN device thread: it's fed by @ref CanDevice::framesReceived
+          and writes through @ref CanDevice::write. The state machine is only driven by the
+          received frames and by timers, there is no blocking wait and no nested event loop.
+    @note The consecutive frames are sent by bursts of @ref MaxFramesNbByBurst, between two bursts
+          the device thread event loop is processed.
+    @note A separation time under 1 ms is actively waited between two frames of a burst; a longer
+          separation time is waited with a precise timer. */
+class IsoTpChannel : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief The state of the message sending */
+        enum class TxState
+        {
+            Idle,
+            WaitingFlowControl,
+            SendingConsecutiveFrames
+        };
+
+    public:
+        /** @brief Class constructor
+            @param config The channel config
+            @param device The CAN device where the frames are written and received
+            @param parent The class parent */
+        explicit IsoTpChannel(const IsoTpConfig &config,
+                              CanDevice &device,
+                              QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~IsoTpChannel() override;
+
+    public:
+        /** @brief Get the channel config */
+        const IsoTpConfig &getConfig() const { return _config; }
+
+        /** @brief Test if a message is currently sent */
+        bool isSending() const { return _txState != TxState::Idle; }
+
+        /** @brief Start the sending of a message
+            @note The method returns when the first frame is written, the end of the sending is
+                  notified with @ref sendFinished
+            @param message The message to send
+            @return True if the sending has been started */
+        bool send(const QByteArray &message);
+
+        /** @brief Cancel the current sending, if there is one
+            @note @ref sendFinished is emitted with a failure
+            @return True if no problem occurred */
+        bool cancelSending();
+
+    signals:
+        /** @brief Emitted when a full message has been received
+            @param message The message received */
+        void messageReceived(const QByteArray &message);
+
+        /** @brief Emitted when the sending of a message is finished
+            @param success True if the message has been fully sent */
+        void sendFinished(bool success);
+
+        /** @brief Emitted when the reception of a segmented message has failed (timeout, wrong
+                   sequence number, etc.) */
+        void receptionFailed();
+
+    private slots:
+        /** @brief Called when frames are received by the CAN device
+            @param frames The frames received */
+        void onFramesReceived(const QVector<QCanBusFrame> &frames);
+
+        /** @brief Called when the sending timer times out
+            @note Depending of the current state, this means that the flow control hasn't been
+                  received in time or that the next consecutive frames can be sent */
+        void onTxTimerTimeout();
+
+        /** @brief Called when the consecutive frame hasn't been received in time */
+        void onRxTimerTimeout();
+
+    private:
+        /** @brief Process a single frame received on the channel
+            @param payload The frame payload */
+        void processFrame(const QByteArray &payload);
+
+        /** @brief Process a received single frame
+            @param payload The frame payload */
+        void processSingleFrame(const QByteArray &payload);
+
+        /** @brief Process a received first frame
+            @param payload The frame payload */
+        void processFirstFrame(const QByteArray &payload);
+
+        /** @brief Process a received consecutive frame
+            @param payload The frame payload */
+        void processConsecutiveFrame(const QByteArray &payload);
+
+        /** @brief Process a received flow control frame
+            @param payload The frame payload */
+        void processFlowControl(const QByteArray &payload);
+
+        /** @brief Send the next consecutive frames, until the end of the block, the end of the
+                   burst or the end of the message */
+        void sendConsecutiveFrames();
+
+        /** @brief Finish the current sending and emit @ref sendFinished
+            @param success True if the message has been fully sent */
+        void finishSending(bool success);
+
+        /** @brief Abort the current reception and emit @ref receptionFailed */
+        void abortReception();
+
+        /** @brief Write a flow control frame
+            @param flowStatus The flow status to send
+            @return True if no problem occurred */
+        bool writeFlowControl(quint8 flowStatus);
+
+        /** @brief Build a frame from the payload given, padding it if needed, and write it
+            @param payload The frame payload
+            @return True if no problem occurred */
+        bool writeFrame(const QByteArray &payload);
+
+        /** @brief Get the max length of a message sent in a single frame */
+        int getMaxSingleFrameLength() const;
+
+    private:
+        /** @brief Encode the separation time to the ISO 15765-2 STmin byte
+            @note The value is rounded up to the next supported value
+            @param separationTimeInUs The separation time to encode
+            @return The STmin byte */
+        static quint8 encodeSeparationTime(int separationTimeInUs);
+
+        /** @brief Decode the ISO 15765-2 STmin byte
+            @note The reserved values are decoded as the max separation time, as required by the
+                  ISO 15765-2
+            @param stMin The STmin byte to decode
+            @return The separation time in us */
+        static int decodeSeparationTime(quint8 stMin);
+
+    private:
+        /** @brief The protocol control information of the single frames */
+        static const constexpr quint8 SingleFramePci = 0x00;
+
+        /** @brief The protocol control information of the first frames */
+        static const constexpr quint8 FirstFramePci = 0x10;
+
+        /** @brief The protocol control information of the consecutive frames */
+        static const constexpr quint8 ConsecutiveFramePci = 0x20;
+
+        /** @brief The protocol control information of the flow control frames */
+        static const constexpr quint8 FlowControlPci = 0x30;
+
+        /** @brief The mask of the protocol control information type */
+        static const constexpr quint8 PciTypeMask = 0xF0;
+
+        /** @brief The mask of the low nibble of the protocol control information byte */
+        static const constexpr quint8 PciLowNibbleMask = 0x0F;
+
+        /** @brief The flow status: continue to send */
+        static const constexpr quint8 FlowStatusContinue = 0x00;
+
+        /** @brief The flow status: wait */
+        static const constexpr quint8 FlowStatusWait = 0x01;
+
+        /** @brief The flow status: overflow */
+        static const constexpr quint8 FlowStatusOverflow = 0x02;
+
+        /** @brief The max single frame length with a one byte protocol control information */
+        static const constexpr int MaxShortSingleFrameLength = 7;
+
+        /** @brief The max message length which can be announced with a two bytes first frame */
+        static const constexpr int MaxShortFirstFrameLength = 0x0FFF;
+
+        /** @brief The protocol control information length of the first frames with a 32 bits
+                   message length */
+        static const constexpr int LongFirstFramePciLength = 6;
+
+        /** @brief The protocol control information length of the short first frames */
+        static const constexpr int ShortFirstFramePciLength = 2;
+
+        /** @brief The max number of consecutive frames sent before processing the event loop */
+        static const constexpr int MaxFramesNbByBurst = 64;
+
+        /** @brief The delay before retrying a write, when the CAN driver transmit queue is full */
+        static const constexpr int WriteRetryDelayInMs = 1;
+
+        /** @brief The separation time step under 1 ms */
+        static const constexpr int SubMilliSeparationStepInUs = 100;
+
+        /** @brief The first STmin value for the separation times under 1 ms (0xF1 is 100 us) */
+        static const constexpr quint8 SubMilliSeparationBase = 0xF0;
+
+        /** @brief The max STmin value expressed in ms */
+        static const constexpr quint8 MaxMilliSeparationTime = 0x7F;
+
+        /** @brief The max STmin value expressed in hundreds of us */
+        static const constexpr quint8 MaxSubMilliSeparationTime = 0xF9;
+
+    private:
+        IsoTpConfig _config;
+        CanDevice &_device;
+
+        TxState _txState{TxState::Idle};
+        QByteArray _txMessage;
+        int _txOffset{0};
+        quint8 _txSequenceNb{0};
+        int _txBlockRemainingNb{0};
+        int _txSeparationTimeInUs{0};
+        int _txWaitFramesNb{0};
+        bool _txSeparationNeeded{false};
+        QElapsedTimer _txLastFrameTimer;
+        QElapsedTimer _txWriteFailureTimer;
+        QTimer *_txTimer{nullptr};
+
+        bool _rxInProgress{false};
+        QByteArray _rxMessage;
+        int _rxExpectedLength{0};
+        quint8 _rxSequenceNb{0};
+        int _rxBlockCounter{0};
+        QTimer *_rxTimer{nullptr};
+};
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "isotpchannelintf.hpp"
+
+#include <QDebug>
+
+#include "threadutility/concurrent/threadconcurrentrun.hpp"
+#include "waitutility/waithelper.hpp"
+
+#include "src/candevice/candevice.hpp"
+#include "src/isotp/isotpchannel.hpp"
+
+
+IsoTpChannelIntf::IsoTpChannelIntf(CanDevice &device, IsoTpChannel &channel, QObject *parent)
+    : QObject{parent},
+    _config{channel.getConfig()},
+    _device{&device},
+    _channel{&channel}
+{
+    connect(&channel, &IsoTpChannel::messageReceived, this, &IsoTpChannelIntf::messageReceived);
+    connect(&channel, &IsoTpChannel::sendFinished, this, &IsoTpChannelIntf::sendFinished);
+    connect(&channel, &IsoTpChannel::receptionFailed, this, &IsoTpChannelIntf::receptionFailed);
+}
+
+IsoTpChannelIntf::~IsoTpChannelIntf()
+{
+    if(_device.isNull() || _channel.isNull())
+    {
+        // The device has been destroyed with its channels
+        return;
+    }
+
+    ThreadConcurrentRun::run(*_device, &CanDevice::deleteIsoTpChannel, _channel.data());
+}
+
+bool IsoTpChannelIntf::send(const QByteArray &message)
+{
+    if(_channel.isNull())
+    {
+        qWarning() << "We can't send the ISO-TP message, the channel has been destroyed with its "
+                   << "CAN device";
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*_channel, &IsoTpChannel::send, message);
+}
+
+bool IsoTpChannelIntf::sendAndWait(const QByteArray &message, int timeoutInMs)
+{
+    bool finished = false;
+    bool success = false;
+
+    // The connection is done before sending, the single frames are finished as soon as written
+    QMetaObject::Connection connection = connect(this, &IsoTpChannelIntf::sendFinished,
+                                                 this, [&finished, &success](bool result)
+                                                 {
+                                                     finished = true;
+                                                     success = result;
+                                                 });
+
+    if(!send(message))
+    {
+        disconnect(connection);
+        return false;
+    }
+
+    WaitHelper::pseudoWait(finished, timeoutInMs);
+
+    disconnect(connection);
+
+    if(!finished)
+    {
+        qWarning() << "The ISO-TP message hasn't been sent in: " << timeoutInMs << "ms, we cancel "
+                   << "the sending";
+        cancelSending();
+        return false;
+    }
+
+    return success;
+}
+
+bool IsoTpChannelIntf::cancelSending()
+{
+    if(_channel.isNull())
+    {
+        return true;
+    }
+
+    return ThreadConcurrentRun::run(*_channel, &IsoTpChannel::cancelSending);
+}
@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QPointer>
+
+#include "src/definescan.hpp"
+#include "src/isotp/isotpconfig.hpp"
+
+class CanDevice;
+class IsoTpChannel;
+
+
+/** @brief This is the interface to an ISO-TP channel which lives in the CAN device thread
+    @note The object is created with @ref CanDeviceIntf::createIsoTpChannel; when it's deleted,
+          the linked channel is removed from the device.
+    @note The calls of all methods in the class are thread safe. */
+class CAN_EXPORT IsoTpChannelIntf : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param device The CAN device where the channel lives
+            @param channel The channel to interface with
+            @param parent The class parent */
+        explicit IsoTpChannelIntf(CanDevice &device,
+                                  IsoTpChannel &channel,
+                                  QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~IsoTpChannelIntf() override;
+
+    public:
+        /** @brief Get the channel config */
+        const IsoTpConfig &getConfig() const { return _config; }
+
+        /** @brief Start the sending of a message
+            @note The method returns when the first frame is written, the end of the sending is
+                  notified with @ref sendFinished
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param message The message to send
+            @return True if the sending has been started */
+        bool send(const QByteArray &message);
+
+        /** @brief Send a message and wait for the end of the sending
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @param message The message to send
+            @param timeoutInMs If different of -1, the method will wait the end of the sending for
+                               this duration; the sending is cancelled if the timeout raises
+            @return True if the message has been fully sent */
+        bool sendAndWait(const QByteArray &message, int timeoutInMs = -1);
+
+        /** @brief Cancel the current sending, if there is one
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note This method ensure thread uncoupling but requires an event loop
+            @return True if no problem occurred */
+        bool cancelSending();
+
+    signals:
+        /** @brief Emitted when a full message has been received
+            @param message The message received */
+        void messageReceived(const QByteArray &message);
+
+        /** @brief Emitted when the sending of a message is finished
+            @param success True if the message has been fully sent */
+        void sendFinished(bool success);
+
+        /** @brief Emitted when the reception of a segmented message has failed */
+        void receptionFailed();
+
+    private:
+        IsoTpConfig _config;
+        QPointer<CanDevice> _device;
+        QPointer<IsoTpChannel> _channel;
+};
@@ -0,0 +1,71 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "isotpconfig.hpp"
+
+#include <QDebug>
+
+#include "src/pcanapi/pcanframedlc.hpp"
+
+
+IsoTpConfig::IsoTpConfig(quint32 txId, quint32 rxId)
+    : _txId{txId},
+    _rxId{rxId}
+{
+}
+
+void IsoTpConfig::setCanFd(bool canFd)
+{
+    _canFd = canFd;
+    _frameDataLength = canFd ? MaxFdFrameDataLength : ClassicFrameDataLength;
+}
+
+bool IsoTpConfig::isValid() const
+{
+    const quint32 maxId = _extendedIds ? MaxExtendedId : MaxStandardId;
+
+    if(_txId > maxId || _rxId > maxId || _txId == _rxId)
+    {
+        qWarning() << "The ISO-TP tx id: " << _txId << ", and rx id: " << _rxId << ", have to be "
+                   << "different and lower or equal to: " << maxId;
+        return false;
+    }
+
+    if(!_canFd && _frameDataLength != ClassicFrameDataLength)
+    {
+        qWarning() << "The ISO-TP frame data length: " << _frameDataLength << ", has to be equal "
+                   << "to: " << ClassicFrameDataLength << ", in classic CAN";
+        return false;
+    }
+
+    if(_canFd && (_frameDataLength < ClassicFrameDataLength ||
+                  PCanFrameDlc::parseFromSize(_frameDataLength) == PCanFrameDlc::Unknown))
+    {
+        qWarning() << "The ISO-TP frame data length: " << _frameDataLength << ", isn't a valid "
+                   << "CAN FD DLC size";
+        return false;
+    }
+
+    if(_separationTimeInUs < 0 || _separationTimeInUs > MaxSeparationTimeInUs)
+    {
+        qWarning() << "The ISO-TP separation time: " << _separationTimeInUs << "us, has to be "
+                   << "between 0 and: " << MaxSeparationTimeInUs << "us";
+        return false;
+    }
+
+    if(_flowControlTimeoutInMs <= 0 || _consecutiveFrameTimeoutInMs <= 0 || _writeTimeoutInMs <= 0)
+    {
+        qWarning() << "The ISO-TP timeouts have to be strictly positive";
+        return false;
+    }
+
+    if(_maxWaitFramesNb < 0 || _maxRxMessageSize <= 0)
+    {
+        qWarning() << "The ISO-TP max wait frames number: " << _maxWaitFramesNb << ", and max "
+                   << "received message size: " << _maxRxMessageSize << ", aren't valid";
+        return false;
+    }
+
+    return true;
+}
@@ -0,0 +1,200 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This is the config of an ISO-TP (ISO 15765-2) channel
+    @note A channel is defined by the id used to send the frames to the distant device and the id
+          used by the distant device to answer. */
+class CAN_EXPORT IsoTpConfig
+{
+    public:
+        /** @brief Class constructor
+            @param txId The id of the frames sent by the channel
+            @param rxId The id of the frames received by the channel */
+        explicit IsoTpConfig(quint32 txId = 0, quint32 rxId = 0);
+
+    public:
+        /** @brief Get the id of the frames sent by the channel */
+        quint32 getTxId() const { return _txId; }
+
+        /** @brief Set the id of the frames sent by the channel
+            @param txId The id to set */
+        void setTxId(quint32 txId) { _txId = txId; }
+
+        /** @brief Get the id of the frames received by the channel */
+        quint32 getRxId() const { return _rxId; }
+
+        /** @brief Set the id of the frames received by the channel
+            @param rxId The id to set */
+        void setRxId(quint32 rxId) { _rxId = rxId; }
+
+        /** @brief Say if the ids are 29 bits ids */
+        bool isExtendedIds() const { return _extendedIds; }
+
+        /** @brief Set if the ids are 29 bits ids
+            @param extendedIds True if the ids are 29 bits ids */
+        void setExtendedIds(bool extendedIds) { _extendedIds = extendedIds; }
+
+        /** @brief Say if the channel sends CAN FD frames */
+        bool isCanFd() const { return _canFd; }
+
+        /** @brief Set if the channel sends CAN FD frames
+            @note The CAN device has to be initialized for CAN FD
+            @note When the FD state changes, the frames data length is set to its max value: 8 for
+                  the classic CAN and 64 for the CAN FD
+            @param canFd True if the channel sends CAN FD frames */
+        void setCanFd(bool canFd);
+
+        /** @brief Get the data length of the sent frames (TX_DL in the ISO 15765-2) */
+        int getFrameDataLength() const { return _frameDataLength; }
+
+        /** @brief Set the data length of the sent frames (TX_DL in the ISO 15765-2)
+            @note In classic CAN, it has to be equal to 8. In CAN FD, it has to be a valid DLC size
+                  greater or equal to 8
+            @param frameDataLength The data length to set */
+        void setFrameDataLength(int frameDataLength) { _frameDataLength = frameDataLength; }
+
+        /** @brief Say if the bitrate switch is set on the sent CAN FD frames */
+        bool isBitrateSwitch() const { return _bitrateSwitch; }
+
+        /** @brief Set if the bitrate switch is set on the sent CAN FD frames
+            @param bitrateSwitch True to switch the bitrate */
+        void setBitrateSwitch(bool bitrateSwitch) { _bitrateSwitch = bitrateSwitch; }
+
+        /** @brief Get the block size sent in our flow control frames
+            @note 0 means that the sender can send all the consecutive frames without waiting for
+                  another flow control */
+        quint8 getBlockSize() const { return _blockSize; }
+
+        /** @brief Set the block size sent in our flow control frames
+            @param blockSize The block size to set, 0 means no limit */
+        void setBlockSize(quint8 blockSize) { _blockSize = blockSize; }
+
+        /** @brief Get the minimum separation time between the consecutive frames, sent in our flow
+                   control frames */
+        int getSeparationTimeInUs() const { return _separationTimeInUs; }
+
+        /** @brief Set the minimum separation time between the consecutive frames, sent in our flow
+                   control frames
+            @note The ISO 15765-2 only supports 100 us steps under 1 ms and 1 ms steps until
+                  127 ms; the value is rounded up to the next supported value
+            @param separationTimeInUs The separation time to set */
+        void setSeparationTimeInUs(int separationTimeInUs)
+        { _separationTimeInUs = separationTimeInUs; }
+
+        /** @brief Say if the sent frames are padded to the frame data length */
+        bool isPaddingEnabled() const { return _paddingEnabled; }
+
+        /** @brief Set if the sent frames are padded to the frame data length
+            @note The CAN FD frames longer than 8 bytes are always padded to the next valid DLC
+                  size
+            @param paddingEnabled True to pad the frames */
+        void setPaddingEnabled(bool paddingEnabled) { _paddingEnabled = paddingEnabled; }
+
+        /** @brief Get the byte used to pad the frames */
+        quint8 getPaddingByte() const { return _paddingByte; }
+
+        /** @brief Set the byte used to pad the frames
+            @param paddingByte The byte to set */
+        void setPaddingByte(quint8 paddingByte) { _paddingByte = paddingByte; }
+
+        /** @brief Get the timeout to wait a flow control frame (N_Bs in the ISO 15765-2) */
+        int getFlowControlTimeoutInMs() const { return _flowControlTimeoutInMs; }
+
+        /** @brief Set the timeout to wait a flow control frame (N_Bs in the ISO 15765-2)
+            @param timeoutInMs The timeout to set */
+        void setFlowControlTimeoutInMs(int timeoutInMs) { _flowControlTimeoutInMs = timeoutInMs; }
+
+        /** @brief Get the timeout to wait a consecutive frame (N_Cr in the ISO 15765-2) */
+        int getConsecutiveFrameTimeoutInMs() const { return _consecutiveFrameTimeoutInMs; }
+
+        /** @brief Set the timeout to wait a consecutive frame (N_Cr in the ISO 15765-2)
+            @param timeoutInMs The timeout to set */
+        void setConsecutiveFrameTimeoutInMs(int timeoutInMs)
+        { _consecutiveFrameTimeoutInMs = timeoutInMs; }
+
+        /** @brief Get the timeout to write a frame, when the CAN driver transmit queue is full
+                   (N_As in the ISO 15765-2) */
+        int getWriteTimeoutInMs() const { return _writeTimeoutInMs; }
+
+        /** @brief Set the timeout to write a frame, when the CAN driver transmit queue is full
+                   (N_As in the ISO 15765-2)
+            @param timeoutInMs The timeout to set */
+        void setWriteTimeoutInMs(int timeoutInMs) { _writeTimeoutInMs = timeoutInMs; }
+
+        /** @brief Get the max number of wait flow control frames accepted in a row (N_WFTmax in
+                   the ISO 15765-2) */
+        int getMaxWaitFramesNb() const { return _maxWaitFramesNb; }
+
+        /** @brief Set the max number of wait flow control frames accepted in a row (N_WFTmax in
+                   the ISO 15765-2)
+            @param maxWaitFramesNb The number to set */
+        void setMaxWaitFramesNb(int maxWaitFramesNb) { _maxWaitFramesNb = maxWaitFramesNb; }
+
+        /** @brief Get the max size of a received message, the bigger messages are refused with an
+                   overflow flow control */
+        int getMaxRxMessageSize() const { return _maxRxMessageSize; }
+
+        /** @brief Set the max size of a received message, the bigger messages are refused with an
+                   overflow flow control
+            @param maxRxMessageSize The size to set */
+        void setMaxRxMessageSize(int maxRxMessageSize) { _maxRxMessageSize = maxRxMessageSize; }
+
+        /** @brief Test if the config is valid
+            @return True if the config is valid */
+        bool isValid() const;
+
+    public:
+        /** @brief The frame data length in classic CAN */
+        static const constexpr int ClassicFrameDataLength = 8;
+
+        /** @brief The max frame data length in CAN FD */
+        static const constexpr int MaxFdFrameDataLength = 64;
+
+    private:
+        /** @brief The default padding byte, as recommended by the ISO 15765-2 */
+        static const constexpr quint8 DefaultPaddingByte = 0xCC;
+
+        /** @brief The default timeout of the N_Bs, N_Cr and N_As timers, as recommended by the
+                   ISO 15765-2 */
+        static const constexpr int DefaultTimeoutInMs = 1000;
+
+        /** @brief The default max number of wait flow control frames accepted in a row */
+        static const constexpr int DefaultMaxWaitFramesNb = 10;
+
+        /** @brief The default max size of a received message */
+        static const constexpr int DefaultMaxRxMessageSize = 16 * 1024 * 1024;
+
+        /** @brief The max separation time supported by the ISO 15765-2 */
+        static const constexpr int MaxSeparationTimeInUs = 127000;
+
+        /** @brief The max 11 bits id */
+        static const constexpr quint32 MaxStandardId = 0x7FF;
+
+        /** @brief The max 29 bits id */
+        static const constexpr quint32 MaxExtendedId = 0x1FFFFFFF;
+
+    private:
+        quint32 _txId;
+        quint32 _rxId;
+        bool _extendedIds{false};
+        bool _canFd{false};
+        int _frameDataLength{ClassicFrameDataLength};
+        bool _bitrateSwitch{false};
+        quint8 _blockSize{0};
+        int _separationTimeInUs{0};
+        bool _paddingEnabled{true};
+        quint8 _paddingByte{DefaultPaddingByte};
+        int _flowControlTimeoutInMs{DefaultTimeoutInMs};
+        int _consecutiveFrameTimeoutInMs{DefaultTimeoutInMs};
+        int _writeTimeoutInMs{DefaultTimeoutInMs};
+        int _maxWaitFramesNb{DefaultMaxWaitFramesNb};
+        int _maxRxMessageSize{DefaultMaxRxMessageSize};
+};
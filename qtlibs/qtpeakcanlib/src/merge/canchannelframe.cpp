@@ -0,0 +1,15 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canchannelframe.hpp"
+
+#include "src/capture/cancaptureformat.hpp"
+
+
+CanChannelFrame::CanChannelFrame(PCanBusItf::Enum channel, const QCanBusFrame &frame)
+    : _channel{channel},
+    _frame{frame},
+    _timestampInUs{CanCaptureFormat::getTimestampInUs(frame)}
+{
+}
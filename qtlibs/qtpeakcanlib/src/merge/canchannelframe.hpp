@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QCanBusFrame>
+#include <QMetaType>
+
+#include "src/definescan.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+
+
+/** @brief This is a CAN frame tagged with the CAN bus interface it has been received from
+    @see CanMergedStream */
+class CAN_EXPORT CanChannelFrame
+{
+    public:
+        /** @brief Class constructor
+            @param channel The CAN bus interface where the frame has been received
+            @param frame The received frame */
+        explicit CanChannelFrame(PCanBusItf::Enum channel = PCanBusItf::Unknown,
+                                 const QCanBusFrame &frame = QCanBusFrame(
+                                     QCanBusFrame::InvalidFrame));
+
+    public:
+        /** @brief Get the CAN bus interface where the frame has been received */
+        PCanBusItf::Enum getChannel() const { return _channel; }
+
+        /** @brief Get the received frame */
+        const QCanBusFrame &getFrame() const { return _frame; }
+
+        /** @brief Get the hardware timestamp of the frame in microseconds */
+        quint64 getTimestampInUs() const { return _timestampInUs; }
+
+    private:
+        PCanBusItf::Enum _channel;
+        QCanBusFrame _frame;
+        quint64 _timestampInUs;
+};
+
+Q_DECLARE_METATYPE(CanChannelFrame)
@@ -0,0 +1,302 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canmergedstream.hpp"
+
+#include <algorithm>
+#include <limits>
+
+#include <QDebug>
+#include <QTimer>
+
+#include "src/candevice/candeviceintf.hpp"
+#include "src/canlibconstants.hpp"
+
+
+CanMergedStream::CanMergedStream(QObject *parent)
+    : QObject{parent},
+    _releaseTimer{new QTimer(this)}
+{
+    _releaseTimer->setInterval(qMax(1, _reorderWindowInMs / 2));
+    connect(_releaseTimer, &QTimer::timeout, this, &CanMergedStream::onReleaseTimeout);
+}
+
+CanMergedStream::~CanMergedStream()
+{
+    for(auto iter = _queues.begin(); iter != _queues.end(); ++iter)
+    {
+        disconnect(iter->connection);
+    }
+}
+
+void CanMergedStream::setReorderWindowInMs(int reorderWindowInMs)
+{
+    _reorderWindowInMs = qMax(0, reorderWindowInMs);
+
+    // The frames are released at most half a window after they have left it
+    _releaseTimer->setInterval(qMax(1, _reorderWindowInMs / 2));
+}
+
+void CanMergedStream::setMaxPendingFramesNb(int maxPendingFramesNb)
+{
+    if(maxPendingFramesNb <= 0)
+    {
+        qWarning() << "The max number of pending frames: " << maxPendingFramesNb << ", has to be "
+                   << "positive, we keep the current value: " << _maxPendingFramesNb;
+        return;
+    }
+
+    _maxPendingFramesNb = maxPendingFramesNb;
+}
+
+bool CanMergedStream::attach(const QSharedPointer<CanDeviceIntf> &canDeviceIntf)
+{
+    if(canDeviceIntf.isNull())
+    {
+        qWarning() << "Can't attach a null CAN device interface to the merged stream";
+        return false;
+    }
+
+    const PCanBusItf::Enum channel = canDeviceIntf->getCanIntfKey();
+    ChannelQueue &queue = getOrCreateQueue(channel);
+
+    if(!queue.canDeviceIntf.isNull())
+    {
+        qInfo() << "The CAN device: " << canDeviceIntf->getConfig().getCanBusItfName()
+                << ", is already attached to the merged stream";
+        return true;
+    }
+
+    queue.canDeviceIntf = canDeviceIntf;
+    queue.connection = connect(canDeviceIntf.data(), &CanDeviceIntf::framesReceived,
+                               this, [this, channel](const QVector<QCanBusFrame> &frames)
+                               {
+                                   pushFrames(channel, frames);
+                               });
+    return true;
+}
+
+void CanMergedStream::detach(PCanBusItf::Enum channel)
+{
+    for(int idx = 0; idx < _queues.length(); ++idx)
+    {
+        ChannelQueue &queue = _queues[idx];
+        if(queue.channel != channel || !queue.attached)
+        {
+            continue;
+        }
+
+        disconnect(queue.connection);
+        queue.canDeviceIntf.clear();
+        queue.attached = false;
+
+        if(queue.frames.empty())
+        {
+            _queues.remove(idx);
+        }
+        else
+        {
+            // The channel doesn't hold the other ones anymore
+            releaseFrames(computeReleaseLimitInUs());
+            manageReleaseTimer();
+        }
+
+        return;
+    }
+}
+
+QVector<PCanBusItf::Enum> CanMergedStream::getChannels() const
+{
+    QVector<PCanBusItf::Enum> channels;
+    for(auto citer = _queues.cbegin(); citer != _queues.cend(); ++citer)
+    {
+        if(citer->attached)
+        {
+            channels.append(citer->channel);
+        }
+    }
+
+    return channels;
+}
+
+void CanMergedStream::pushFrames(PCanBusItf::Enum channel, const QVector<QCanBusFrame> &frames)
+{
+    if(frames.isEmpty())
+    {
+        return;
+    }
+
+    ChannelQueue &queue = getOrCreateQueue(channel);
+
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        const CanChannelFrame channelFrame(channel, *citer);
+        const quint64 timestampInUs = channelFrame.getTimestampInUs();
+
+        if(_hasReleased && timestampInUs < _lastReleasedTimestampInUs)
+        {
+            ++_lateFramesNb;
+        }
+
+        if(!queue.hasReceived || timestampInUs >= queue.lastTimestampInUs)
+        {
+            // This is the usual case: the driver gives the frames of a channel in order
+            queue.frames.push_back(channelFrame);
+            queue.lastTimestampInUs = timestampInUs;
+            queue.hasReceived = true;
+        }
+        else
+        {
+            const auto position = std::upper_bound(
+                queue.frames.begin(),
+                queue.frames.end(),
+                timestampInUs,
+                [](quint64 value, const CanChannelFrame &frame)
+                {
+                    return value < frame.getTimestampInUs();
+                });
+            queue.frames.insert(position, channelFrame);
+        }
+
+        if(timestampInUs > _maxTimestampInUs || !_maxTimestampClock.isValid())
+        {
+            _maxTimestampInUs = qMax(_maxTimestampInUs, timestampInUs);
+            _maxTimestampClock.start();
+        }
+    }
+
+    _pendingFramesNb += frames.length();
+
+    releaseFrames(computeReleaseLimitInUs(), _pendingFramesNb - _maxPendingFramesNb);
+    manageReleaseTimer();
+}
+
+void CanMergedStream::flush()
+{
+    releaseFrames(std::numeric_limits<quint64>::max());
+    manageReleaseTimer();
+}
+
+void CanMergedStream::onReleaseTimeout()
+{
+    releaseFrames(computeReleaseLimitInUs());
+    manageReleaseTimer();
+}
+
+CanMergedStream::ChannelQueue &CanMergedStream::getOrCreateQueue(PCanBusItf::Enum channel)
+{
+    for(auto iter = _queues.begin(); iter != _queues.end(); ++iter)
+    {
+        if(iter->channel == channel && iter->attached)
+        {
+            return *iter;
+        }
+    }
+
+    ChannelQueue queue;
+    queue.channel = channel;
+    _queues.append(queue);
+
+    return _queues.last();
+}
+
+quint64 CanMergedStream::computeReleaseLimitInUs() const
+{
+    // No attached channel can give a frame older than its last received frame
+    quint64 watermarkInUs = std::numeric_limits<quint64>::max();
+    for(auto citer = _queues.cbegin(); citer != _queues.cend(); ++citer)
+    {
+        if(!citer->attached)
+        {
+            continue;
+        }
+
+        watermarkInUs = qMin(watermarkInUs, citer->hasReceived ? citer->lastTimestampInUs : 0);
+    }
+
+    if(!_maxTimestampClock.isValid())
+    {
+        return watermarkInUs;
+    }
+
+    // The silent channels can't hold the frames longer than the reorder window
+    const quint64 nowInUs = _maxTimestampInUs +
+                            static_cast<quint64>(_maxTimestampClock.nsecsElapsed() /
+                                                 CanLibConstants::Time::MicroToNanoCoeff);
+    const quint64 windowInUs = static_cast<quint64>(_reorderWindowInMs) *
+                               CanLibConstants::Time::MilliToMicroCoeff;
+    const quint64 windowLimitInUs = (nowInUs > windowInUs) ? (nowInUs - windowInUs) : 0;
+
+    return qMax(watermarkInUs, windowLimitInUs);
+}
+
+void CanMergedStream::releaseFrames(quint64 limitInUs, int minFramesNb)
+{
+    QVector<CanChannelFrame> mergedFrames;
+
+    while(_pendingFramesNb > 0)
+    {
+        // The number of channels is small, a linear search of the oldest head is quicker than a
+        // heap
+        int oldestIdx = -1;
+        for(int idx = 0; idx < _queues.length(); ++idx)
+        {
+            const ChannelQueue &queue = _queues.at(idx);
+            if(queue.frames.empty())
+            {
+                continue;
+            }
+
+            if(oldestIdx < 0 || queue.frames.front().getTimestampInUs() <
+                                    _queues.at(oldestIdx).frames.front().getTimestampInUs())
+            {
+                oldestIdx = idx;
+            }
+        }
+
+        ChannelQueue &oldestQueue = _queues[oldestIdx];
+        if(oldestQueue.frames.front().getTimestampInUs() > limitInUs &&
+           mergedFrames.length() >= minFramesNb)
+        {
+            break;
+        }
+
+        mergedFrames.append(oldestQueue.frames.front());
+        oldestQueue.frames.pop_front();
+        --_pendingFramesNb;
+    }
+
+    // The detached channels are removed when they have nothing more to give
+    for(int idx = _queues.length() - 1; idx >= 0; --idx)
+    {
+        if(!_queues.at(idx).attached && _queues.at(idx).frames.empty())
+        {
+            _queues.remove(idx);
+        }
+    }
+
+    if(mergedFrames.isEmpty())
+    {
+        return;
+    }
+
+    _lastReleasedTimestampInUs = qMax(_lastReleasedTimestampInUs,
+                                      mergedFrames.last().getTimestampInUs());
+    _hasReleased = true;
+    _mergedFramesNb += static_cast<quint64>(mergedFrames.length());
+
+    emit framesMerged(mergedFrames);
+}
+
+void CanMergedStream::manageReleaseTimer()
+{
+    if(_pendingFramesNb == 0)
+    {
+        _releaseTimer->stop();
+    }
+    else if(!_releaseTimer->isActive())
+    {
+        _releaseTimer->start();
+    }
+}
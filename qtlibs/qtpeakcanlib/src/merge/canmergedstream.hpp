@@ -0,0 +1,182 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <deque>
+
+#include <QElapsedTimer>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "src/definescan.hpp"
+#include "src/merge/canchannelframe.hpp"
+
+class CanDeviceIntf;
+class QTimer;
+
+
+/** @brief This class merges the frames received by several CAN devices in a unique stream,
+           ordered by hardware timestamp
+    @note Each channel has its own queue, the queues are merged (k-way merge) when the frames
+          can't be overtaken anymore: a frame is released when all the channels have received a
+          more recent frame, or when the frame is older than the reorder window.
+    @note The reorder window is computed from the most recent timestamp received, increased by the
+          time elapsed since its reception; therefore a silent channel doesn't stop the stream.
+    @note A frame received after a more recent frame has been released is late: it's released with
+          the next batch and counted, see @ref getLateFramesNb. Increase the reorder window if
+          late frames are seen.
+    @note The hardware timestamps of the channels have to be given by the same clock, which is
+          the case for the channels of a same PCAN driver.
+    @note The stream works in its own thread; to not slow down the thread of the
+          @ref CanDeviceIntf, you may move the stream to a dedicated thread. */
+class CAN_EXPORT CanMergedStream : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief Contains the frames of a channel waiting to be merged */
+        struct ChannelQueue
+        {
+            /** @brief The CAN bus interface of the channel */
+            PCanBusItf::Enum channel{PCanBusItf::Unknown};
+
+            /** @brief The waiting frames, sorted by timestamp */
+            std::deque<CanChannelFrame> frames{};
+
+            /** @brief The most recent timestamp received on the channel */
+            quint64 lastTimestampInUs{0};
+
+            /** @brief True if at least one frame has been received on the channel */
+            bool hasReceived{false};
+
+            /** @brief True if the channel is still fed; a detached channel is removed when its
+                       waiting frames have been released */
+            bool attached{true};
+
+            /** @brief The attached CAN device interface, null if the channel is fed by
+                       @ref pushFrames */
+            QSharedPointer<CanDeviceIntf> canDeviceIntf{};
+
+            /** @brief The connection to the framesReceived signal of the device */
+            QMetaObject::Connection connection{};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit CanMergedStream(QObject *parent = nullptr);
+
+        /** @brief Class destructor
+            @note The waiting frames are not emitted */
+        virtual ~CanMergedStream() override;
+
+    public:
+        /** @brief Get the reorder window in ms */
+        int getReorderWindowInMs() const { return _reorderWindowInMs; }
+
+        /** @brief Set the reorder window
+            @note The greater the window is, the greater the latency of the stream is
+            @param reorderWindowInMs The reorder window to set in ms */
+        void setReorderWindowInMs(int reorderWindowInMs);
+
+        /** @brief Get the max number of frames waiting to be merged */
+        int getMaxPendingFramesNb() const { return _maxPendingFramesNb; }
+
+        /** @brief Set the max number of frames waiting to be merged
+            @note When the limit is reached, the oldest frames are released even if they are in the
+                  reorder window
+            @param maxPendingFramesNb The max number of frames to set */
+        void setMaxPendingFramesNb(int maxPendingFramesNb);
+
+        /** @brief Attach the stream to the CAN device interface given
+            @note The stream keeps a reference on the CAN device interface until it's detached
+            @param canDeviceIntf The CAN device interface to attach to
+            @return True if no problem occurred */
+        bool attach(const QSharedPointer<CanDeviceIntf> &canDeviceIntf);
+
+        /** @brief Detach the stream from the channel given
+            @note The frames of the channel already received are still merged
+            @param channel The CAN bus interface to detach from */
+        void detach(PCanBusItf::Enum channel);
+
+        /** @brief Get the channels merged by the stream */
+        QVector<PCanBusItf::Enum> getChannels() const;
+
+        /** @brief Get the number of frames waiting to be merged */
+        int getPendingFramesNb() const { return _pendingFramesNb; }
+
+        /** @brief Get the number of frames emitted by the stream */
+        quint64 getMergedFramesNb() const { return _mergedFramesNb; }
+
+        /** @brief Get the number of frames received after a more recent frame has been released */
+        quint64 getLateFramesNb() const { return _lateFramesNb; }
+
+    public slots:
+        /** @brief Add frames to the stream
+            @note This is called when frames are received by an attached device, but you may also
+                  call it to merge frames from another source (a capture replay for instance); in
+                  that case, the channel is added to the merged channels.
+            @param channel The CAN bus interface where the frames have been received
+            @param frames The frames to merge */
+        void pushFrames(PCanBusItf::Enum channel, const QVector<QCanBusFrame> &frames);
+
+        /** @brief Release all the waiting frames, whatever the reorder window */
+        void flush();
+
+    signals:
+        /** @brief Emitted when frames are released by the stream
+            @note The frames are sorted by timestamp, in the batch and between the batches (except
+                  the late frames)
+            @param frames The merged frames */
+        void framesMerged(const QVector<CanChannelFrame> &frames);
+
+    private slots:
+        /** @brief Called regularly while frames are waiting, to release the frames which have
+                   left the reorder window */
+        void onReleaseTimeout();
+
+    private:
+        /** @brief Get the queue of the channel given, the queue is created if it doesn't exist
+            @param channel The CAN bus interface of the queue
+            @return The queue of the channel */
+        ChannelQueue &getOrCreateQueue(PCanBusItf::Enum channel);
+
+        /** @brief Get the timestamp under which (included) the waiting frames can be released */
+        quint64 computeReleaseLimitInUs() const;
+
+        /** @brief Merge the waiting frames and emit them
+            @param limitInUs The frames with a timestamp lower or equal to this limit are released
+            @param minFramesNb The min number of frames to release, whatever their timestamp */
+        void releaseFrames(quint64 limitInUs, int minFramesNb = 0);
+
+        /** @brief Start or stop the release timer, depending of the waiting frames */
+        void manageReleaseTimer();
+
+    private:
+        /** @brief The default reorder window */
+        static const constexpr int DefaultReorderWindowInMs = 20;
+
+        /** @brief The default max number of frames waiting to be merged */
+        static const constexpr int DefaultMaxPendingFramesNb = 65536;
+
+    private:
+        int _reorderWindowInMs{DefaultReorderWindowInMs};
+        int _maxPendingFramesNb{DefaultMaxPendingFramesNb};
+
+        QVector<ChannelQueue> _queues;
+        int _pendingFramesNb{0};
+
+        quint64 _maxTimestampInUs{0};
+        QElapsedTimer _maxTimestampClock;
+        quint64 _lastReleasedTimestampInUs{0};
+        bool _hasReleased{false};
+
+        QTimer *_releaseTimer{nullptr};
+
+        quint64 _mergedFramesNb{0};
+        quint64 _lateFramesNb{0};
+};
@@ -0,0 +1,274 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canbusmetrics.hpp"
+
+#include <chrono>
+#include <limits>
+
+#include "src/canlibconstants.hpp"
+#include "src/models/candeviceconfig.hpp"
+#include "src/models/candeviceconfigdetails.hpp"
+#include "src/models/candevicefdconfigdetails.hpp"
+
+
+CanBusMetrics::CanBusMetrics(const CanDeviceConfig &config)
+    : _clocksOffsetInUs{std::numeric_limits<qint64>::max()},
+    _lastSnapshotTimeInUs{getHostTimeInUs()}
+{
+    computeBitrates(config);
+}
+
+void CanBusMetrics::addRxFrame(const QCanBusFrame &frame)
+{
+    _rxFramesNb.fetch_add(1, std::memory_order_relaxed);
+    _busTimeInNs.fetch_add(static_cast<quint64>(getFrameDurationInNs(frame)),
+                           std::memory_order_relaxed);
+
+    // The smallest offset observed is the closest to the real offset between the two clocks
+    const qint64 offsetInUs = getHostTimeInUs() - getHardwareTimeInUs(frame);
+    qint64 currentOffsetInUs = _clocksOffsetInUs.load(std::memory_order_relaxed);
+    while(offsetInUs < currentOffsetInUs &&
+          !_clocksOffsetInUs.compare_exchange_weak(currentOffsetInUs,
+                                                   offsetInUs,
+                                                   std::memory_order_relaxed))
+    {
+        // If the exchange fails, the current offset is updated and we test again
+    }
+}
+
+void CanBusMetrics::addRxFrame(int payloadSize,
+                               bool extendedId,
+                               bool canFd,
+                               bool bitrateSwitch,
+                               bool remoteRequest)
+{
+    _rxFramesNb.fetch_add(1, std::memory_order_relaxed);
+    _busTimeInNs.fetch_add(static_cast<quint64>(getFrameDurationInNs(payloadSize,
+                                                                     extendedId,
+                                                                     canFd,
+                                                                     bitrateSwitch,
+                                                                     remoteRequest)),
+                           std::memory_order_relaxed);
+}
+
+void CanBusMetrics::addTxFrame(const QCanBusFrame &frame)
+{
+    _txFramesNb.fetch_add(1, std::memory_order_relaxed);
+    _busTimeInNs.fetch_add(static_cast<quint64>(getFrameDurationInNs(frame)),
+                           std::memory_order_relaxed);
+}
+
+void CanBusMetrics::addTxFrame(int payloadSize,
+                               bool extendedId,
+                               bool canFd,
+                               bool bitrateSwitch,
+                               bool remoteRequest)
+{
+    _txFramesNb.fetch_add(1, std::memory_order_relaxed);
+    _busTimeInNs.fetch_add(static_cast<quint64>(getFrameDurationInNs(payloadSize,
+                                                                     extendedId,
+                                                                     canFd,
+                                                                     bitrateSwitch,
+                                                                     remoteRequest)),
+                           std::memory_order_relaxed);
+}
+
+void CanBusMetrics::addDeliveredFrame(const QCanBusFrame &frame)
+{
+    const qint64 offsetInUs = _clocksOffsetInUs.load(std::memory_order_relaxed);
+    if(offsetInUs == std::numeric_limits<qint64>::max())
+    {
+        // The frame hasn't been read by the read thread (the metrics may have been reset)
+        return;
+    }
+
+    const qint64 latencyInUs = qMax(static_cast<qint64>(0),
+                                    getHostTimeInUs() - getHardwareTimeInUs(frame) - offsetInUs);
+
+    int bucketIdx = 0;
+    while(bucketIdx < (LatencyBucketsNb - 1) && latencyInUs > LatencyUpperBoundsInUs[bucketIdx])
+    {
+        ++bucketIdx;
+    }
+
+    _latencyFramesNbs[bucketIdx].fetch_add(1, std::memory_order_relaxed);
+}
+
+CanBusMetricsSnapshot CanBusMetrics::takeSnapshot()
+{
+    QMutexLocker locker(&_snapshotMutex);
+
+    const qint64 nowInUs = getHostTimeInUs();
+    const quint64 rxFramesNb = _rxFramesNb.load(std::memory_order_relaxed);
+    const quint64 txFramesNb = _txFramesNb.load(std::memory_order_relaxed);
+    const quint64 busTimeInNs = _busTimeInNs.load(std::memory_order_relaxed);
+
+    double rxFramesPerSecond = 0.0;
+    double txFramesPerSecond = 0.0;
+    double busLoadPercent = 0.0;
+
+    const qint64 elapsedInUs = nowInUs - _lastSnapshotTimeInUs;
+    if(elapsedInUs > 0)
+    {
+        const double elapsedInS = static_cast<double>(elapsedInUs) /
+                                  CanLibConstants::Time::SecondToMicroCoeff;
+        rxFramesPerSecond = static_cast<double>(rxFramesNb - _lastRxFramesNb) / elapsedInS;
+        txFramesPerSecond = static_cast<double>(txFramesNb - _lastTxFramesNb) / elapsedInS;
+
+        // The bus time is in ns and the elapsed time in us: the ratio is multiplied by 1000,
+        // we divide by 10 to get a percentage
+        busLoadPercent = qMin(100.0,
+                              static_cast<double>(busTimeInNs - _lastBusTimeInNs) /
+                                  static_cast<double>(elapsedInUs) / 10.0);
+    }
+
+    _lastSnapshotTimeInUs = nowInUs;
+    _lastRxFramesNb = rxFramesNb;
+    _lastTxFramesNb = txFramesNb;
+    _lastBusTimeInNs = busTimeInNs;
+
+    QVector<qint64> latencyUpperBoundsInUs;
+    latencyUpperBoundsInUs.reserve(static_cast<int>(LatencyUpperBoundsInUs.size()));
+    for(qint64 upperBoundInUs : LatencyUpperBoundsInUs)
+    {
+        latencyUpperBoundsInUs.append(upperBoundInUs);
+    }
+
+    QVector<quint64> latencyFramesNbs;
+    latencyFramesNbs.reserve(LatencyBucketsNb);
+    for(const std::atomic<quint64> &framesNb : _latencyFramesNbs)
+    {
+        latencyFramesNbs.append(framesNb.load(std::memory_order_relaxed));
+    }
+
+    return CanBusMetricsSnapshot(rxFramesNb,
+                                 txFramesNb,
+                                 rxFramesPerSecond,
+                                 txFramesPerSecond,
+                                 busLoadPercent,
+                                 _overrunsNb.load(std::memory_order_relaxed),
+                                 _rxErrorsNb.load(std::memory_order_relaxed),
+                                 _txErrorsNb.load(std::memory_order_relaxed),
+                                 latencyUpperBoundsInUs,
+                                 latencyFramesNbs);
+}
+
+void CanBusMetrics::reset()
+{
+    QMutexLocker locker(&_snapshotMutex);
+
+    _rxFramesNb = 0;
+    _txFramesNb = 0;
+    _busTimeInNs = 0;
+    _overrunsNb = 0;
+    _rxErrorsNb = 0;
+    _txErrorsNb = 0;
+    _clocksOffsetInUs = std::numeric_limits<qint64>::max();
+
+    for(std::atomic<quint64> &framesNb : _latencyFramesNbs)
+    {
+        framesNb = 0;
+    }
+
+    _lastSnapshotTimeInUs = getHostTimeInUs();
+    _lastRxFramesNb = 0;
+    _lastTxFramesNb = 0;
+    _lastBusTimeInNs = 0;
+}
+
+qint64 CanBusMetrics::getFrameDurationInNs(const QCanBusFrame &frame) const
+{
+    return getFrameDurationInNs(frame.payload().size(),
+                                frame.hasExtendedFrameFormat(),
+                                frame.hasFlexibleDataRateFormat(),
+                                frame.hasBitrateSwitch(),
+                                frame.frameType() == QCanBusFrame::RemoteRequestFrame);
+}
+
+qint64 CanBusMetrics::getFrameDurationInNs(int payloadSize,
+                                           bool extendedId,
+                                           bool canFd,
+                                           bool bitrateSwitch,
+                                           bool remoteRequest) const
+{
+    if(_nominalBitrate <= 0)
+    {
+        return 0;
+    }
+
+    const qint64 dataBitsNb = remoteRequest ? 0 : (payloadSize * BitsByByte);
+
+    if(!canFd)
+    {
+        const qint64 overheadBitsNb = extendedId ? ClassicExtOverheadBitsNb :
+                                                   ClassicStdOverheadBitsNb;
+        return ((overheadBitsNb + dataBitsNb) * CanLibConstants::Time::SecondToNanoCoeff) /
+               _nominalBitrate;
+    }
+
+    const qint64 nominalBitsNb = extendedId ? FdExtNominalBitsNb : FdStdNominalBitsNb;
+    const qint64 crcBitsNb = (payloadSize >= FdLongCrcMinPayloadSize) ? FdLongCrcBitsNb :
+                                                                        FdShortCrcBitsNb;
+    const qint64 dataPhaseBitsNb = FdDataPhaseOverheadBitsNb + dataBitsNb + crcBitsNb;
+
+    // Without bitrate switch, the data phase is sent at the nominal bitrate
+    const qint64 dataPhaseBitrate = (bitrateSwitch && _dataBitrate > 0) ? _dataBitrate :
+                                                                          _nominalBitrate;
+
+    return ((nominalBitsNb * CanLibConstants::Time::SecondToNanoCoeff) / _nominalBitrate) +
+           ((dataPhaseBitsNb * CanLibConstants::Time::SecondToNanoCoeff) / dataPhaseBitrate);
+}
+
+void CanBusMetrics::computeBitrates(const CanDeviceConfig &config)
+{
+    if(!config.isValid())
+    {
+        return;
+    }
+
+    if(!config.isCanFd())
+    {
+        bool ok = false;
+        _nominalBitrate = PCanBaudRate::toRealValue(config.getDetails().getBaudRate()).toInt64(&ok);
+
+        if(!ok)
+        {
+            _nominalBitrate = 0;
+        }
+
+        _dataBitrate = _nominalBitrate;
+        return;
+    }
+
+    const CanDeviceFdConfigDetails &fdDetails = config.getFdDetails();
+    const qint64 clockInHz = static_cast<qint64>(fdDetails.getFClockInMHz()) * MegaCoeff;
+
+    // The bit time is made of the sync segment (one quantum) and the two time segments
+    const qint64 nomQuantaNb = 1 + fdDetails.getNomTseg1() + fdDetails.getNomTseg2();
+    const qint64 dataQuantaNb = 1 + fdDetails.getDataTseg1() + fdDetails.getDataTseg2();
+
+    if(fdDetails.getNomBrp() > 0)
+    {
+        _nominalBitrate = clockInHz / (fdDetails.getNomBrp() * nomQuantaNb);
+    }
+
+    if(fdDetails.getDataBrp() > 0)
+    {
+        _dataBitrate = clockInHz / (fdDetails.getDataBrp() * dataQuantaNb);
+    }
+}
+
+qint64 CanBusMetrics::getHostTimeInUs()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+qint64 CanBusMetrics::getHardwareTimeInUs(const QCanBusFrame &frame)
+{
+    const QCanBusFrame::TimeStamp timeStamp = frame.timeStamp();
+    return (timeStamp.seconds() * CanLibConstants::Time::SecondToMicroCoeff) +
+           timeStamp.microSeconds();
+}
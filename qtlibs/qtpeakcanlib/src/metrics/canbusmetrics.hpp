@@ -0,0 +1,192 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <QCanBusFrame>
+#include <QMutex>
+
+#include "src/metrics/canbusmetricssnapshot.hpp"
+
+class CanDeviceConfig;
+
+
+/** @brief This class collects the live metrics of a CAN bus
+    @note The object is shared between the read thread, the device thread and the device
+          interface thread. The collecting methods only update atomic counters and can be called
+          for each frame; the computation is done when a snapshot is taken.
+    @note The hardware timestamps of the frames and the host clock aren't synchronized. The offset
+          between them is estimated with the smallest delay observed when the frames are read;
+          therefore, the delivery latency measured is the delay added after the reading of the
+          fastest frame.
+    @note The frames written by the @ref CanCyclicScheduler don't go through the device and aren't
+          counted. The frames forwarded by the gateway of another device are counted by the read
+          thread of the source device, in the metrics of the target device
+    @note The frames received which are only forwarded by the gateway or rejected by the
+          acceptance table of the read thread are counted as received, they have used the bus */
+class CanBusMetrics
+{
+    public:
+        /** @brief Class constructor
+            @param config The config of the CAN device, used to get the bus bitrates */
+        explicit CanBusMetrics(const CanDeviceConfig &config);
+
+    public:
+        /** @brief Count a frame received from the bus
+            @note This has to be called by the read thread, as soon as the frame is read
+            @param frame The frame received, with its hardware timestamp */
+        void addRxFrame(const QCanBusFrame &frame);
+
+        /** @brief Count a frame received from the bus, from the fields of the driver message
+            @note This is used by the read thread for the frames which aren't converted to
+                  @ref QCanBusFrame; they aren't used to estimate the clocks offset
+            @param payloadSize The size of the frame payload
+            @param extendedId True if the frame has an extended id
+            @param canFd True if the frame has the CAN FD format
+            @param bitrateSwitch True if the data phase of the FD frame uses the data bitrate
+            @param remoteRequest True if the frame is a remote request */
+        void addRxFrame(int payloadSize,
+                        bool extendedId,
+                        bool canFd,
+                        bool bitrateSwitch,
+                        bool remoteRequest);
+
+        /** @brief Count a frame written on the bus
+            @param frame The frame written */
+        void addTxFrame(const QCanBusFrame &frame);
+
+        /** @brief Count a frame written on the bus, from the fields of the driver message
+            @note This is used by the gateway, which writes the driver messages without creating
+                  a @ref QCanBusFrame
+            @param payloadSize The size of the frame payload
+            @param extendedId True if the frame has an extended id
+            @param canFd True if the frame has the CAN FD format
+            @param bitrateSwitch True if the data phase of the FD frame uses the data bitrate
+            @param remoteRequest True if the frame is a remote request */
+        void addTxFrame(int payloadSize,
+                        bool extendedId,
+                        bool canFd,
+                        bool bitrateSwitch,
+                        bool remoteRequest);
+
+        /** @brief Count a receive queue overrun notified by the driver */
+        void addOverrun() { _overrunsNb.fetch_add(1, std::memory_order_relaxed); }
+
+        /** @brief Count an error returned by the driver when reading */
+        void addRxError() { _rxErrorsNb.fetch_add(1, std::memory_order_relaxed); }
+
+        /** @brief Count a frame which couldn't be written */
+        void addTxError() { _txErrorsNb.fetch_add(1, std::memory_order_relaxed); }
+
+        /** @brief Add the delivery latency of a frame to the histogram
+            @note This has to be called by the consumer, when the frame is delivered
+            @param frame The frame delivered, with its hardware timestamp */
+        void addDeliveredFrame(const QCanBusFrame &frame);
+
+        /** @brief Take a snapshot of the metrics
+            @note The rates and the bus load are computed since the previous snapshot
+            @return The snapshot taken */
+        CanBusMetricsSnapshot takeSnapshot();
+
+        /** @brief Reset all the metrics */
+        void reset();
+
+    private:
+        /** @brief Get the duration of a frame on the bus
+            @note The stuff bits aren't counted
+            @param frame The frame to get the duration of
+            @return The duration in ns, 0 if the bitrates are unknown */
+        qint64 getFrameDurationInNs(const QCanBusFrame &frame) const;
+
+        /** @brief Get the duration of a frame on the bus, from its fields
+            @note The stuff bits aren't counted
+            @param payloadSize The size of the frame payload
+            @param extendedId True if the frame has an extended id
+            @param canFd True if the frame has the CAN FD format
+            @param bitrateSwitch True if the data phase of the FD frame uses the data bitrate
+            @param remoteRequest True if the frame is a remote request
+            @return The duration in ns, 0 if the bitrates are unknown */
+        qint64 getFrameDurationInNs(int payloadSize,
+                                    bool extendedId,
+                                    bool canFd,
+                                    bool bitrateSwitch,
+                                    bool remoteRequest) const;
+
+        /** @brief Compute the bitrates of the bus from the device config
+            @param config The config of the CAN device */
+        void computeBitrates(const CanDeviceConfig &config);
+
+        /** @brief Get the current time of the host monotonic clock, in us */
+        static qint64 getHostTimeInUs();
+
+        /** @brief Get the hardware timestamp of a frame, in us */
+        static qint64 getHardwareTimeInUs(const QCanBusFrame &frame);
+
+    private:
+        /** @brief The upper bounds of the latency histogram buckets, in us */
+        static const constexpr std::array<qint64, 10> LatencyUpperBoundsInUs = {
+            100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000 };
+
+        /** @brief The number of buckets of the latency histogram, the last one has no bound */
+        static const constexpr int LatencyBucketsNb =
+            static_cast<int>(LatencyUpperBoundsInUs.size()) + 1;
+
+        /** @brief The bits sent at the nominal bitrate for a classic frame with a standard id,
+                   without the data: SOF, id, RTR, IDE, r0, DLC, CRC, delimiters, ACK, EOF and
+                   IFS */
+        static const constexpr qint64 ClassicStdOverheadBitsNb = 47;
+
+        /** @brief The bits sent at the nominal bitrate for a classic frame with an extended id,
+                   without the data */
+        static const constexpr qint64 ClassicExtOverheadBitsNb = 67;
+
+        /** @brief The bits sent at the nominal bitrate for a FD frame with a standard id: the
+                   arbitration phase, the CRC delimiter, ACK, EOF and IFS */
+        static const constexpr qint64 FdStdNominalBitsNb = 30;
+
+        /** @brief The bits sent at the nominal bitrate for a FD frame with an extended id */
+        static const constexpr qint64 FdExtNominalBitsNb = 49;
+
+        /** @brief The bits of the data phase of a FD frame, without the data and the CRC: ESI,
+                   DLC and stuff count */
+        static const constexpr qint64 FdDataPhaseOverheadBitsNb = 10;
+
+        /** @brief The CRC length of a FD frame with a payload up to 16 bytes */
+        static const constexpr qint64 FdShortCrcBitsNb = 17;
+
+        /** @brief The CRC length of a FD frame with a payload longer than 16 bytes */
+        static const constexpr qint64 FdLongCrcBitsNb = 21;
+
+        /** @brief The payload size from which the FD frames use the long CRC */
+        static const constexpr int FdLongCrcMinPayloadSize = 17;
+
+        /** @brief The number of bits in a byte */
+        static const constexpr qint64 BitsByByte = 8;
+
+        /** @brief The number of hertz in a megahertz */
+        static const constexpr qint64 MegaCoeff = 1000000;
+
+    private:
+        qint64 _nominalBitrate{0};
+        qint64 _dataBitrate{0};
+
+        std::atomic<quint64> _rxFramesNb{0};
+        std::atomic<quint64> _txFramesNb{0};
+        std::atomic<quint64> _busTimeInNs{0};
+        std::atomic<quint64> _overrunsNb{0};
+        std::atomic<quint64> _rxErrorsNb{0};
+        std::atomic<quint64> _txErrorsNb{0};
+
+        std::atomic<qint64> _clocksOffsetInUs;
+        std::array<std::atomic<quint64>, LatencyBucketsNb> _latencyFramesNbs{};
+
+        QMutex _snapshotMutex;
+        qint64 _lastSnapshotTimeInUs{0};
+        quint64 _lastRxFramesNb{0};
+        quint64 _lastTxFramesNb{0};
+        quint64 _lastBusTimeInNs{0};
+};
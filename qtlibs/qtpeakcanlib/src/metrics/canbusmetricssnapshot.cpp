@@ -0,0 +1,82 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canbusmetricssnapshot.hpp"
+
+#include <QString>
+
+#include <cmath>
+
+
+CanBusMetricsSnapshot::CanBusMetricsSnapshot(quint64 rxFramesNb,
+                                             quint64 txFramesNb,
+                                             double rxFramesPerSecond,
+                                             double txFramesPerSecond,
+                                             double busLoadPercent,
+                                             quint64 overrunsNb,
+                                             quint64 rxErrorsNb,
+                                             quint64 txErrorsNb,
+                                             const QVector<qint64> &latencyUpperBoundsInUs,
+                                             const QVector<quint64> &latencyFramesNbs)
+    : _rxFramesNb{rxFramesNb},
+    _txFramesNb{txFramesNb},
+    _rxFramesPerSecond{rxFramesPerSecond},
+    _txFramesPerSecond{txFramesPerSecond},
+    _busLoadPercent{busLoadPercent},
+    _overrunsNb{overrunsNb},
+    _rxErrorsNb{rxErrorsNb},
+    _txErrorsNb{txErrorsNb},
+    _latencyUpperBoundsInUs{latencyUpperBoundsInUs},
+    _latencyFramesNbs{latencyFramesNbs}
+{
+}
+
+qint64 CanBusMetricsSnapshot::getLatencyPercentileInUs(double percentile) const
+{
+    quint64 totalFramesNb = 0;
+    for(auto citer = _latencyFramesNbs.cbegin(); citer != _latencyFramesNbs.cend(); ++citer)
+    {
+        totalFramesNb += *citer;
+    }
+
+    if(totalFramesNb == 0)
+    {
+        return -1;
+    }
+
+    const double boundedPercentile = qBound(0.0, percentile, 100.0);
+    const quint64 targetFramesNb = qMax(
+        static_cast<quint64>(1),
+        static_cast<quint64>(std::ceil(static_cast<double>(totalFramesNb) * boundedPercentile /
+                                       100.0)));
+
+    quint64 cumulatedFramesNb = 0;
+    for(int idx = 0; idx < _latencyFramesNbs.length(); ++idx)
+    {
+        cumulatedFramesNb += _latencyFramesNbs.at(idx);
+
+        if(cumulatedFramesNb >= targetFramesNb)
+        {
+            return (idx < _latencyUpperBoundsInUs.length()) ? _latencyUpperBoundsInUs.at(idx) : -1;
+        }
+    }
+
+    return -1;
+}
+
+QString CanBusMetricsSnapshot::toString() const
+{
+    return QString("rx: %1 (%2 fps), tx: %3 (%4 fps), bus load: %5%, overruns: %6, rx errors: "
+                   "%7, tx errors: %8, latency p50: %9us, p99: %10us")
+        .arg(_rxFramesNb)
+        .arg(_rxFramesPerSecond, 0, 'f', 1)
+        .arg(_txFramesNb)
+        .arg(_txFramesPerSecond, 0, 'f', 1)
+        .arg(_busLoadPercent, 0, 'f', 1)
+        .arg(_overrunsNb)
+        .arg(_rxErrorsNb)
+        .arg(_txErrorsNb)
+        .arg(getLatencyPercentileInUs(50.0))
+        .arg(getLatencyPercentileInUs(99.0));
+}
@@ -0,0 +1,101 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+#include <QVector>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This is a snapshot of the live metrics of a CAN bus, see @ref CanBusMetrics
+    @note The rates and the bus load are computed on the period elapsed since the previous
+          snapshot; the counters are cumulated since the device creation or the last reset. */
+class CAN_EXPORT CanBusMetricsSnapshot
+{
+    public:
+        /** @brief Class constructor
+            @param rxFramesNb The number of frames received
+            @param txFramesNb The number of frames written
+            @param rxFramesPerSecond The number of frames received by second
+            @param txFramesPerSecond The number of frames written by second
+            @param busLoadPercent The estimated bus load, in percent
+            @param overrunsNb The number of receive queue overruns notified by the driver
+            @param rxErrorsNb The number of errors returned by the driver when reading
+            @param txErrorsNb The number of frames which couldn't be written
+            @param latencyUpperBoundsInUs The upper bounds of the latency histogram buckets, the
+                                          last bucket has no upper bound
+            @param latencyFramesNbs The number of frames in each bucket of the latency
+                                    histogram */
+        explicit CanBusMetricsSnapshot(quint64 rxFramesNb = 0,
+                                       quint64 txFramesNb = 0,
+                                       double rxFramesPerSecond = 0.0,
+                                       double txFramesPerSecond = 0.0,
+                                       double busLoadPercent = 0.0,
+                                       quint64 overrunsNb = 0,
+                                       quint64 rxErrorsNb = 0,
+                                       quint64 txErrorsNb = 0,
+                                       const QVector<qint64> &latencyUpperBoundsInUs = {},
+                                       const QVector<quint64> &latencyFramesNbs = {});
+
+    public:
+        /** @brief Get the number of frames received */
+        quint64 getRxFramesNb() const { return _rxFramesNb; }
+
+        /** @brief Get the number of frames written */
+        quint64 getTxFramesNb() const { return _txFramesNb; }
+
+        /** @brief Get the number of frames received by second */
+        double getRxFramesPerSecond() const { return _rxFramesPerSecond; }
+
+        /** @brief Get the number of frames written by second */
+        double getTxFramesPerSecond() const { return _txFramesPerSecond; }
+
+        /** @brief Get the estimated bus load, in percent
+            @note The load is estimated from the frames length and the bus bitrates, without the
+                  stuff bits; therefore, the real load is a little higher */
+        double getBusLoadPercent() const { return _busLoadPercent; }
+
+        /** @brief Get the number of receive queue overruns notified by the driver
+            @note Each overrun means that frames have been lost in the driver */
+        quint64 getOverrunsNb() const { return _overrunsNb; }
+
+        /** @brief Get the number of errors returned by the driver when reading */
+        quint64 getRxErrorsNb() const { return _rxErrorsNb; }
+
+        /** @brief Get the number of frames which couldn't be written */
+        quint64 getTxErrorsNb() const { return _txErrorsNb; }
+
+        /** @brief Get the upper bounds of the latency histogram buckets
+            @note The histogram has one more bucket than the bounds: the last one gets the
+                  latencies greater than the last bound */
+        const QVector<qint64> &getLatencyUpperBoundsInUs() const
+        { return _latencyUpperBoundsInUs; }
+
+        /** @brief Get the number of frames in each bucket of the latency histogram */
+        const QVector<quint64> &getLatencyFramesNbs() const { return _latencyFramesNbs; }
+
+        /** @brief Get the latency under which the percentile of frames given has been delivered
+            @note The value returned is the upper bound of the bucket, -1 if the percentile is in
+                  the last bucket or if no frame has been delivered
+            @param percentile The percentile to get, between 0 and 100 */
+        qint64 getLatencyPercentileInUs(double percentile) const;
+
+        /** @brief Get a string representation of the metrics, useful for logs */
+        QString toString() const;
+
+    private:
+        quint64 _rxFramesNb;
+        quint64 _txFramesNb;
+        double _rxFramesPerSecond;
+        double _txFramesPerSecond;
+        double _busLoadPercent;
+        quint64 _overrunsNb;
+        quint64 _rxErrorsNb;
+        quint64 _txErrorsNb;
+        QVector<qint64> _latencyUpperBoundsInUs;
+        QVector<quint64> _latencyFramesNbs;
+};
@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canbusmetricsstats.hpp"
+
+#include <limits>
+
+#include <QtMath>
+
+#include "src/metrics/canbusmetricssnapshot.hpp"
+
+
+CanBusMetricsStats::CanBusMetricsStats(const QString &canBusItfName)
+    : MixinProcessStats{QString(StatsDescription).arg(canBusItfName)}
+{
+    registerCounter(FramesCategoryKey, FramesCategoryDesc);
+    registerCounter(BusCategoryKey, BusCategoryDesc);
+    registerCounter(ErrorsCategoryKey, ErrorsCategoryDesc);
+    registerCounter(LatencyCategoryKey, LatencyCategoryDesc);
+}
+
+CanBusMetricsStats::~CanBusMetricsStats()
+{
+}
+
+void CanBusMetricsStats::update(const CanBusMetricsSnapshot &snapshot)
+{
+    CounterStatsCategory &frames = *accessCounterCategory(FramesCategoryKey);
+    setCounter(frames, RxFramesNbKey, snapshot.getRxFramesNb());
+    setCounter(frames, TxFramesNbKey, snapshot.getTxFramesNb());
+    setCounter(frames,
+               RxFramesPerSecondKey,
+               static_cast<quint64>(qRound64(snapshot.getRxFramesPerSecond())));
+    setCounter(frames,
+               TxFramesPerSecondKey,
+               static_cast<quint64>(qRound64(snapshot.getTxFramesPerSecond())));
+
+    CounterStatsCategory &bus = *accessCounterCategory(BusCategoryKey);
+    setCounter(bus,
+               BusLoadPercentKey,
+               static_cast<quint64>(qRound64(snapshot.getBusLoadPercent())));
+
+    CounterStatsCategory &errors = *accessCounterCategory(ErrorsCategoryKey);
+    setCounter(errors, OverrunsNbKey, snapshot.getOverrunsNb());
+    setCounter(errors, RxErrorsNbKey, snapshot.getRxErrorsNb());
+    setCounter(errors, TxErrorsNbKey, snapshot.getTxErrorsNb());
+
+    CounterStatsCategory &latency = *accessCounterCategory(LatencyCategoryKey);
+    const QVector<qint64> &upperBoundsInUs = snapshot.getLatencyUpperBoundsInUs();
+    const QVector<quint64> &framesNbs = snapshot.getLatencyFramesNbs();
+
+    for(int idx = 0; idx < framesNbs.length(); ++idx)
+    {
+        QString key;
+        if(idx < upperBoundsInUs.length())
+        {
+            key = QString(LatencyBucketKeyFormat).arg(upperBoundsInUs.at(idx));
+        }
+        else if(!upperBoundsInUs.isEmpty())
+        {
+            key = QString(LatencyLastBucketKeyFormat).arg(upperBoundsInUs.last());
+        }
+
+        setCounter(latency, key, framesNbs.at(idx));
+    }
+}
+
+void CanBusMetricsStats::setCounter(CounterStatsCategory &category,
+                                    const QString &key,
+                                    quint64 value)
+{
+    const quint64 maxValue = static_cast<quint64>(std::numeric_limits<int>::max());
+
+    category.getOrCreateValue(key, new CounterStatsInfo())
+        .setValue(static_cast<int>(qMin(value, maxValue)));
+}
@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "statisticsutility/mixins/mixinprocessstats.hpp"
+
+#include "src/definescan.hpp"
+
+class CanBusMetricsSnapshot;
+
+
+/** @brief This exports the metrics of a CAN bus to the statistics counters, to display them in
+           the process logs
+    @note The counters are only updated when calling @ref update; the rates and the bus load are
+          rounded to integers. */
+class CAN_EXPORT CanBusMetricsStats : public MixinProcessStats
+{
+    public:
+        /** @brief Class constructor
+            @param canBusItfName The name of the CAN bus interface, displayed in the logs */
+        explicit CanBusMetricsStats(const QString &canBusItfName);
+
+        /** @brief Class destructor */
+        virtual ~CanBusMetricsStats() override;
+
+    public:
+        /** @brief Update the statistics counters with the snapshot given
+            @param snapshot The metrics snapshot */
+        void update(const CanBusMetricsSnapshot &snapshot);
+
+        /** @brief Format the statistics to be displayed in logs */
+        QString toString() { return formatStatsToBeDisplayedInLogs(); }
+
+    private:
+        /** @brief Set the value of a counter
+            @note The value is bounded to the int max value
+            @param category The category of the counter
+            @param key The key of the counter in the category
+            @param value The value to set */
+        static void setCounter(CounterStatsCategory &category, const QString &key, quint64 value);
+
+    private:
+        static const constexpr char *StatsDescription = "CAN bus metrics of: %1";
+
+        static const constexpr char *FramesCategoryKey = "frames";
+        static const constexpr char *FramesCategoryDesc = "Frames";
+        static const constexpr char *BusCategoryKey = "bus";
+        static const constexpr char *BusCategoryDesc = "Bus";
+        static const constexpr char *ErrorsCategoryKey = "errors";
+        static const constexpr char *ErrorsCategoryDesc = "Errors";
+        static const constexpr char *LatencyCategoryKey = "latency";
+        static const constexpr char *LatencyCategoryDesc = "Delivery latency histogram";
+
+        static const constexpr char *RxFramesNbKey = "rx";
+        static const constexpr char *TxFramesNbKey = "tx";
+        static const constexpr char *RxFramesPerSecondKey = "rx fps";
+        static const constexpr char *TxFramesPerSecondKey = "tx fps";
+        static const constexpr char *BusLoadPercentKey = "load (%)";
+        static const constexpr char *OverrunsNbKey = "overruns";
+        static const constexpr char *RxErrorsNbKey = "rx errors";
+        static const constexpr char *TxErrorsNbKey = "tx errors";
+        static const constexpr char *LatencyBucketKeyFormat = "<= %1us";
+        static const constexpr char *LatencyLastBucketKeyFormat = "> %1us";
+};
@@ -0,0 +1,13 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canbusevent.hpp"
+
+#include <QMetaEnum>
+
+
+QString CanBusEvent::toString(Enum value)
+{
+    return QString::fromLatin1(QMetaEnum::fromType<Enum>().valueToKey(value)).toLower();
+}
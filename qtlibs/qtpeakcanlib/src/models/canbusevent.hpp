@@ -0,0 +1,33 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "src/definescan.hpp"
+
+
+/** @brief Describes the events of a CAN bus, notified by the read thread of a CAN device */
+class CAN_EXPORT CanBusEvent : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The bus event */
+        enum Enum {
+            ErrorFrame,     //!< @brief An error frame has been received
+            ErrorWarning,   //!< @brief An error counter has reached the warning limit
+            ErrorPassive,   //!< @brief The controller is error passive
+            BusOff,         //!< @brief The controller is bus off
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+};
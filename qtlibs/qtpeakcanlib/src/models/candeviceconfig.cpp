@@ -28,6 +28,11 @@ CanDeviceConfig::CanDeviceConfig(bool isCanFd, QObject *parent)
 
 CanDeviceConfig::CanDeviceConfig(const CanDeviceConfig &copy) :
     _canBusItf{copy._canBusItf},
+    _rxRingCapacity{copy._rxRingCapacity},
+    _rxOverflowPolicy{copy._rxOverflowPolicy},
+    _txQueueConfig{copy._txQueueConfig},
+    _maxInFlightRequestsByIdNb{copy._maxInFlightRequestsByIdNb},
+    _acceptanceFilterEnabled{copy._acceptanceFilterEnabled},
     _canConfig{nullptr},
     _canFdConfig{nullptr}
 {
@@ -79,6 +84,10 @@ void CanDeviceConfig::setCanFd(bool isCanFd)
 bool CanDeviceConfig::isValid() const
 {
     return (_canBusItf != PCanBusItf::Unknown) &&
+           (_rxRingCapacity > 0) &&
+           (_rxOverflowPolicy != CanRingOverflowPolicy::Unknown) &&
+           _txQueueConfig.isValid() &&
+           (_maxInFlightRequestsByIdNb > 0) &&
            (_canConfig != nullptr || _canFdConfig != nullptr) &&
            (_canConfig == nullptr || _canConfig->isValid()) &&
            (_canFdConfig == nullptr || _canFdConfig->isValid());
@@ -87,6 +96,11 @@ bool CanDeviceConfig::isValid() const
 CanDeviceConfig &CanDeviceConfig::operator=(const CanDeviceConfig &otherConfig)
 {
     _canBusItf  = otherConfig._canBusItf;
+    _rxRingCapacity = otherConfig._rxRingCapacity;
+    _rxOverflowPolicy = otherConfig._rxOverflowPolicy;
+    _txQueueConfig = otherConfig._txQueueConfig;
+    _maxInFlightRequestsByIdNb = otherConfig._maxInFlightRequestsByIdNb;
+    _acceptanceFilterEnabled = otherConfig._acceptanceFilterEnabled;
 
     delete _canConfig;
     if(otherConfig._canConfig != nullptr)
@@ -8,6 +8,8 @@
 
 #include "src/definescan.hpp"
 #include "src/pcanapi/pcanbusitf.hpp"
+#include "src/rxring/canringoverflowpolicy.hpp"
+#include "src/txqueue/cantxqueueconfig.hpp"
 
 class CanDeviceConfigDetails;
 class CanDeviceFdConfigDetails;
@@ -92,6 +94,63 @@ class CAN_EXPORT CanDeviceConfig : public QObject
             @return The reference to the CAN FD details */
         CanDeviceFdConfigDetails& accessFdDetails() const { return *_canFdConfig; }
 
+        /** @brief Get the capacity of the rings used to pass the received frames between threads
+            @see CanFrameRing */
+        int getRxRingCapacity() const { return _rxRingCapacity; }
+
+        /** @brief Set the capacity of the rings used to pass the received frames between threads
+            @note The value is rounded up to the next power of two by the ring
+            @param rxRingCapacity The capacity to set */
+        void setRxRingCapacity(int rxRingCapacity) { _rxRingCapacity = rxRingCapacity; }
+
+        /** @brief Get the policy to apply when a received frame is pushed in a full ring */
+        CanRingOverflowPolicy::Enum getRxOverflowPolicy() const { return _rxOverflowPolicy; }
+
+        /** @brief Set the policy to apply when a received frame is pushed in a full ring
+            @note With the Block policy, the backpressure is propagated to the PEAK driver queue,
+                  which will overrun if the consumer stalls for too long
+            @param rxOverflowPolicy The policy to set */
+        void setRxOverflowPolicy(CanRingOverflowPolicy::Enum rxOverflowPolicy)
+        { _rxOverflowPolicy = rxOverflowPolicy; }
+
+        /** @brief Get the config of the transmit queue used by the batch writing */
+        const CanTxQueueConfig &getTxQueueConfig() const { return _txQueueConfig; }
+
+        /** @brief Access the config of the transmit queue used by the batch writing */
+        CanTxQueueConfig &accessTxQueueConfig() { return _txQueueConfig; }
+
+        /** @brief Set the config of the transmit queue used by the batch writing
+            @param txQueueConfig The config to set */
+        void setTxQueueConfig(const CanTxQueueConfig &txQueueConfig)
+        { _txQueueConfig = txQueueConfig; }
+
+        /** @brief Get the max number of pipelined requests in flight with the same request frame
+                   id
+            @see CanDeviceIntf::sendRequest */
+        int getMaxInFlightRequestsByIdNb() const { return _maxInFlightRequestsByIdNb; }
+
+        /** @brief Set the max number of pipelined requests in flight with the same request frame
+                   id
+            @note Most of the ECUs process one request at a time, the default value is 1. The
+                  requests sent to different ids are always in flight at the same time.
+            @param maxInFlightRequestsByIdNb The max number to set */
+        void setMaxInFlightRequestsByIdNb(int maxInFlightRequestsByIdNb)
+        { _maxInFlightRequestsByIdNb = maxInFlightRequestsByIdNb; }
+
+        /** @brief Test if the received frames are filtered with the acceptance subscriptions
+            @see CanDeviceIntf::addAcceptanceSubscription */
+        bool isAcceptanceFilterEnabled() const { return _acceptanceFilterEnabled; }
+
+        /** @brief Set if the received frames are filtered with the acceptance subscriptions
+            @note When enabled, only the frames accepted by the subscriptions, the ISO-TP channels
+                  and the pending waits and requests are received; the other frames are dropped
+                  by the PEAK driver or by the read thread. Therefore, the listeners of
+                  @ref CanDeviceIntf::framesReceived only receive the accepted frames.
+            @note The filter is disabled by default
+            @param acceptanceFilterEnabled True to enable the filter */
+        void setAcceptanceFilterEnabled(bool acceptanceFilterEnabled)
+        { _acceptanceFilterEnabled = acceptanceFilterEnabled; }
+
         /** @brief Test if the config and the details configs are valids
             @return True if the class is valid */
         bool isValid() const;
@@ -102,8 +161,24 @@ class CAN_EXPORT CanDeviceConfig : public QObject
             @return The current object instance */
         CanDeviceConfig &operator=(const CanDeviceConfig &otherConfig);
 
+    private:
+        /** @brief The default capacity of the received frames rings */
+        static const constexpr int DefaultRxRingCapacity = 4096;
+
+        /** @brief The default policy to apply when a received frames ring is full */
+        static const constexpr CanRingOverflowPolicy::Enum DefaultRxOverflowPolicy =
+            CanRingOverflowPolicy::DropOldest;
+
+        /** @brief The default max number of pipelined requests in flight with the same id */
+        static const constexpr int DefaultMaxInFlightRequestsByIdNb = 1;
+
     private:
         PCanBusItf::Enum _canBusItf{PCanBusItf::Unknown};
+        int _rxRingCapacity{DefaultRxRingCapacity};
+        CanRingOverflowPolicy::Enum _rxOverflowPolicy{DefaultRxOverflowPolicy};
+        CanTxQueueConfig _txQueueConfig;
+        int _maxInFlightRequestsByIdNb{DefaultMaxInFlightRequestsByIdNb};
+        bool _acceptanceFilterEnabled{false};
 
         CanDeviceConfigDetails *_canConfig{nullptr};
         CanDeviceFdConfigDetails *_canFdConfig{nullptr};
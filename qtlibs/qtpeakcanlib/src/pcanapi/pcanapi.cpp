@@ -10,7 +10,9 @@
 #include "src/models/candeviceconfig.hpp"
 #include "src/models/candeviceconfigdetails.hpp"
 #include "src/models/candevicefdconfigdetails.hpp"
+#include "src/pcanapi/pcanframeconverter.hpp"
 #include "src/pcanapi/pcanframedlc.hpp"
+#include "src/trace/cantracer.hpp"
 
 #include "import_pcanbasic.hpp"
 
@@ -137,47 +139,36 @@ QString PCanApi::getErrorText(quint32 errorCode)
     return QString::fromLatin1(errorTxtData);
 }
 
-bool PCanApi::writeCanFdMsgProcess(PCanBusItf::Enum pCanBusItf, const QCanBusFrame &frame)
+bool PCanApi::writeCanFdMsgProcess(PCanBusItf::Enum pCanBusItf,
+                                   const QCanBusFrame &frame,
+                                   bool *txQueueFull)
 {
-    const QByteArray payload = frame.payload();
-    const qint32 payloadSize = payload.size();
-    const PCanFrameDlc::Enum frameDlc = PCanFrameDlc::parseFromSize(payloadSize);
-
-    if(frameDlc == PCanFrameDlc::Unknown)
+    TPCANMsgFD message = {};
+    if(!PCanFrameConverter::toCanFdMsg(frame, message))
     {
         qWarning() << "We can't write the CAN FD message, the payload size is not managed by the "
                       "DLC";
         return false;
     }
 
-    TPCANMsgFD message = {};
-    message.ID = frame.frameId();
-    message.DLC = PCanFrameDlc::toByte(frameDlc);
-    message.MSGTYPE = frame.hasExtendedFrameFormat() ? PCAN_MESSAGE_EXTENDED
-                                                     : PCAN_MESSAGE_STANDARD;
+    const TPCANStatus status = CAN_WriteFD(PCanBusItf::toTPCanHandle(pCanBusItf), &message);
 
-    if (frame.hasFlexibleDataRateFormat())
-    {
-        message.MSGTYPE |= PCAN_MESSAGE_FD;
-    }
+    CAN_TRACE_FRAME(pCanBusItf,
+                    (status == PCAN_ERROR_OK) ? CanTraceRing::Kind::TxFrame :
+                                                CanTraceRing::Kind::TxError,
+                    message.ID,
+                    message.MSGTYPE,
+                    message.DATA,
+                    PCanFrameDlc::byteToSize(message.DLC),
+                    status);
 
-    if (frame.hasBitrateSwitch())
+    if(status == PCAN_ERROR_QXMTFULL && txQueueFull != nullptr)
     {
-        message.MSGTYPE |= PCAN_MESSAGE_BRS;
-    }
-
-    if (frame.frameType() == QCanBusFrame::RemoteRequestFrame)
-    {
-        // In that case, we do not care about the payload
-        message.MSGTYPE |= PCAN_MESSAGE_RTR;
-    }
-    else
-    {
-        memcpy(message.DATA, payload.constData(), payloadSize);
+        // The caller manages the retry, this isn't an error
+        *txQueueFull = true;
+        return false;
     }
 
-    const TPCANStatus status = CAN_WriteFD(PCanBusItf::toTPCanHandle(pCanBusItf), &message);
-
     if(status != PCAN_ERROR_OK)
     {
         qWarning() << "A problem occurred when tried to write the CAN FD frame: , "
@@ -186,35 +177,39 @@ bool PCanApi::writeCanFdMsgProcess(PCanBusItf::Enum pCanBusItf, const QCanBusFra
         return false;
     }
 
-    qDebug() << "A frame has been written from FD CAN bus: " <<  PCanBusItf::toString(pCanBusItf)
-             << ", the frame: " << frame.toString();
-
     return true;
 }
 
-bool PCanApi::writeCanMsgProcess(PCanBusItf::Enum pCanBusItf, const QCanBusFrame &frame)
+bool PCanApi::writeCanMsgProcess(PCanBusItf::Enum pCanBusItf,
+                                 const QCanBusFrame &frame,
+                                 bool *txQueueFull)
 {
-    const QByteArray payload = frame.payload();
-    const qint32 payloadSize = payload.size();
-
     TPCANMsg message = {};
-    message.ID = frame.frameId();
-    message.LEN = static_cast<quint8>(payloadSize);
-    message.MSGTYPE = frame.hasExtendedFrameFormat() ? PCAN_MESSAGE_EXTENDED
-                                                     : PCAN_MESSAGE_STANDARD;
-
-    if (frame.frameType() == QCanBusFrame::RemoteRequestFrame)
-    {
-        // In that case, we do not care about the payload
-        message.MSGTYPE |= PCAN_MESSAGE_RTR;
-    }
-    else
+    if(!PCanFrameConverter::toCanMsg(frame, message))
     {
-        memcpy(message.DATA, payload.constData(), payloadSize);
+        qWarning() << "We can't write the CAN message, the payload size: "
+                   << frame.payload().size() << ", is too long for a classic CAN frame";
+        return false;
     }
 
     const TPCANStatus status = CAN_Write(PCanBusItf::toTPCanHandle(pCanBusItf), &message);
 
+    CAN_TRACE_FRAME(pCanBusItf,
+                    (status == PCAN_ERROR_OK) ? CanTraceRing::Kind::TxFrame :
+                                                CanTraceRing::Kind::TxError,
+                    message.ID,
+                    message.MSGTYPE,
+                    message.DATA,
+                    message.LEN,
+                    status);
+
+    if(status == PCAN_ERROR_QXMTFULL && txQueueFull != nullptr)
+    {
+        // The caller manages the retry, this isn't an error
+        *txQueueFull = true;
+        return false;
+    }
+
     if(status != PCAN_ERROR_OK)
     {
         qWarning() << "A problem occurred when tried to write the CAN frame: , "
@@ -223,9 +218,6 @@ bool PCanApi::writeCanMsgProcess(PCanBusItf::Enum pCanBusItf, const QCanBusFrame
         return false;
     }
 
-    qDebug() << "A frame has been written from CAN bus: " <<  PCanBusItf::toString(pCanBusItf)
-             << ", the frame: " << frame.toString();
-
     return true;
 }
 
@@ -290,6 +282,47 @@ bool PCanApi::setParamBusOffAutoReset(PCanBusItf::Enum pCanBusItf, bool autoRese
     return setBooleanParam(pCanBusItf, PCAN_BUSOFF_AUTORESET, autoReset);
 }
 
+bool PCanApi::setMessageFilterOpen(PCanBusItf::Enum pCanBusItf, bool open)
+{
+    quint32 buffer = open ? PCAN_FILTER_OPEN : PCAN_FILTER_CLOSE;
+    const TPCANStatus status = CAN_SetValue(PCanBusItf::toTPCanHandle(pCanBusItf),
+                                            PCAN_MESSAGE_FILTER,
+                                            &buffer,
+                                            sizeof(quint32));
+
+    if(status != PCAN_ERROR_OK)
+    {
+        qWarning() << "A problem occurred when tried to " << (open ? "open" : "close")
+                   << " the message filter of the attached channel: "
+                   << PCanBusItf::toString(pCanBusItf) << ", error: " << getErrorText(status);
+        return false;
+    }
+
+    return true;
+}
+
+bool PCanApi::expandMessageFilter(PCanBusItf::Enum pCanBusItf,
+                                  quint32 firstId,
+                                  quint32 lastId,
+                                  bool extendedIds)
+{
+    const TPCANStatus status = CAN_FilterMessages(PCanBusItf::toTPCanHandle(pCanBusItf),
+                                                  firstId,
+                                                  lastId,
+                                                  extendedIds ? PCAN_MODE_EXTENDED :
+                                                                PCAN_MODE_STANDARD);
+
+    if(status != PCAN_ERROR_OK)
+    {
+        qWarning() << "A problem occurred when tried to expand the message filter of the attached "
+                   << "channel: " << PCanBusItf::toString(pCanBusItf) << ", with the range: ["
+                   << firstId << ", " << lastId << "], error: " << getErrorText(status);
+        return false;
+    }
+
+    return true;
+}
+
 bool PCanApi::getBooleanParam(PCanBusItf::Enum pCanBusItf, quint8 paramType, bool &value)
 {
     quint32 buffer = PCAN_PARAMETER_OFF;
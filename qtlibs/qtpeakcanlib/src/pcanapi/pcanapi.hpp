@@ -46,15 +46,25 @@ class PCanApi
                    given
             @param pCanBusItf The CAN Bus interface key
             @param frame The frame to write
+            @param txQueueFull If not null, set to true if the writing failed because the driver
+                               transmit queue is full; in that case, no warning is logged and the
+                               caller may retry later
             @return True if no problem occurred */
-        static bool writeCanFdMsgProcess(PCanBusItf::Enum pCanBusItf, const QCanBusFrame &frame);
+        static bool writeCanFdMsgProcess(PCanBusItf::Enum pCanBusItf,
+                                         const QCanBusFrame &frame,
+                                         bool *txQueueFull = nullptr);
 
         /** @brief Write a CAN message through the CAN BUB targetted by the @ref pCanBusItf
                    given
             @param pCanBusItf The CAN Bus interface key
             @param frame The frame to write
+            @param txQueueFull If not null, set to true if the writing failed because the driver
+                               transmit queue is full; in that case, no warning is logged and the
+                               caller may retry later
             @return True if no problem occurred */
-        static bool writeCanMsgProcess(PCanBusItf::Enum pCanBusItf, const QCanBusFrame &frame);
+        static bool writeCanMsgProcess(PCanBusItf::Enum pCanBusItf,
+                                       const QCanBusFrame &frame,
+                                       bool *txQueueFull = nullptr);
 
         /** @brief Get the list of currently available devices
             @return The info list of the available devices */
@@ -77,6 +87,30 @@ class PCanApi
             @return True if no problem occurred */
         static bool setParamBusOffAutoReset(PCanBusItf::Enum pCanBusItf, bool autoReset);
 
+        /** @brief Open or close the message filter of the PEAK driver
+            @note When the filter is open, all the frames are received; when it's closed, no frame
+                  is received until the filter is expanded with @ref expandMessageFilter
+            @param pCanBusItf The CAN Bus interface key
+            @param open True to open the filter, false to close it
+            @return True if no problem occurred */
+        static bool setMessageFilterOpen(PCanBusItf::Enum pCanBusItf, bool open);
+
+        /** @brief Expand the message filter of the PEAK driver with the ids range given
+            @note From doc: The message filter will be expanded with every call to this function.
+                            If it is desired to use a narrower filter, the filter must be first
+                            closed.
+            @note The driver keeps one range by ids format: the range is expanded to contain the
+                  previous one and the new one
+            @param pCanBusItf The CAN Bus interface key
+            @param firstId The first id of the range
+            @param lastId The last id of the range (included)
+            @param extendedIds True if the range applies to the extended ids
+            @return True if no problem occurred */
+        static bool expandMessageFilter(PCanBusItf::Enum pCanBusItf,
+                                        quint32 firstId,
+                                        quint32 lastId,
+                                        bool extendedIds);
+
     private:
         /** @brief Get the value of the targetted PCAN parameter
             @param pCanBusItf The CAN Bus interface key
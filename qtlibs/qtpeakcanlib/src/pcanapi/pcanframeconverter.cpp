@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "pcanframeconverter.hpp"
+
+#include <cstring>
+
+#include "src/pcanapi/pcanframedlc.hpp"
+
+
+PCanFrameConverter::PCanFrameConverter()
+{
+}
+
+bool PCanFrameConverter::toCanMsg(const QCanBusFrame &frame, TPCANMsg &message)
+{
+    const QByteArray payload = frame.payload();
+    const int payloadSize = payload.size();
+
+    if(payloadSize > MaxClassicPayloadSize)
+    {
+        return false;
+    }
+
+    message.ID = frame.frameId();
+    message.LEN = static_cast<quint8>(payloadSize);
+    message.MSGTYPE = frame.hasExtendedFrameFormat() ? PCAN_MESSAGE_EXTENDED :
+                                                       PCAN_MESSAGE_STANDARD;
+
+    if(frame.frameType() == QCanBusFrame::RemoteRequestFrame)
+    {
+        // In that case, we do not care about the payload
+        message.MSGTYPE |= PCAN_MESSAGE_RTR;
+    }
+    else
+    {
+        memcpy(message.DATA, payload.constData(), static_cast<size_t>(payloadSize));
+    }
+
+    return true;
+}
+
+bool PCanFrameConverter::toCanFdMsg(const QCanBusFrame &frame, TPCANMsgFD &message)
+{
+    const QByteArray payload = frame.payload();
+    const int payloadSize = payload.size();
+    const PCanFrameDlc::Enum frameDlc = PCanFrameDlc::parseFromSize(payloadSize);
+
+    if(frameDlc == PCanFrameDlc::Unknown)
+    {
+        return false;
+    }
+
+    message.ID = frame.frameId();
+    message.DLC = PCanFrameDlc::toByte(frameDlc);
+    message.MSGTYPE = frame.hasExtendedFrameFormat() ? PCAN_MESSAGE_EXTENDED :
+                                                       PCAN_MESSAGE_STANDARD;
+
+    if(frame.hasFlexibleDataRateFormat())
+    {
+        message.MSGTYPE |= PCAN_MESSAGE_FD;
+    }
+
+    if(frame.hasBitrateSwitch())
+    {
+        message.MSGTYPE |= PCAN_MESSAGE_BRS;
+    }
+
+    if(frame.frameType() == QCanBusFrame::RemoteRequestFrame)
+    {
+        // In that case, we do not care about the payload
+        message.MSGTYPE |= PCAN_MESSAGE_RTR;
+    }
+    else
+    {
+        memcpy(message.DATA, payload.constData(), static_cast<size_t>(payloadSize));
+    }
+
+    return true;
+}
+
+QCanBusFrame PCanFrameConverter::fromCanMsg(const TPCANMsg &message,
+                                            const TPCANTimestamp &timestamp)
+{
+    QCanBusFrame frame(message.ID, QByteArray(reinterpret_cast<const char *>(message.DATA),
+                                              static_cast<int>(message.LEN)));
+
+    const qint64 timestampInUs = static_cast<qint64>(toMicroSeconds(timestamp));
+
+    frame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(timestampInUs));
+    frame.setExtendedFrameFormat(message.MSGTYPE & PCAN_MESSAGE_EXTENDED);
+    frame.setFrameType((message.MSGTYPE & PCAN_MESSAGE_RTR) ? QCanBusFrame::RemoteRequestFrame :
+                                                              QCanBusFrame::DataFrame);
+
+    return frame;
+}
+
+bool PCanFrameConverter::fromCanFdMsg(const TPCANMsgFD &message,
+                                      TPCANTimestampFD timestamp,
+                                      QCanBusFrame &frame)
+{
+    const qint32 size = PCanFrameDlc::byteToSize(message.DLC);
+
+    if(size == PCanFrameDlc::UnknownSize)
+    {
+        return false;
+    }
+
+    frame.setFrameId(message.ID);
+    frame.setPayload(QByteArray(reinterpret_cast<const char *>(message.DATA), size));
+    frame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(static_cast<qint64>(timestamp)));
+    frame.setExtendedFrameFormat(message.MSGTYPE & PCAN_MESSAGE_EXTENDED);
+    frame.setFrameType((message.MSGTYPE & PCAN_MESSAGE_RTR) ? QCanBusFrame::RemoteRequestFrame :
+                                                              QCanBusFrame::DataFrame);
+    frame.setFlexibleDataRateFormat(message.MSGTYPE & PCAN_MESSAGE_FD);
+    frame.setBitrateSwitch(message.MSGTYPE & PCAN_MESSAGE_BRS);
+    frame.setErrorStateIndicator(message.MSGTYPE & PCAN_MESSAGE_ESI);
+
+    return true;
+}
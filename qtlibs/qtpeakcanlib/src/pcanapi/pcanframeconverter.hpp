@@ -0,0 +1,76 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QCanBusFrame>
+
+#include "src/pcanapi/import_pcanbasic.hpp"
+
+
+/** @brief Converts the QCanBusFrame to and from the PEAK CAN lib messages
+    @note The conversions are done for each frame read or written: the payload is copied directly
+          between the frame storage and the driver message, without intermediate buffers.
+          QCanBusFrame only gives its payload by value, but the QByteArray is implicitly shared:
+          getting it doesn't copy the payload.
+    @note The class contains static methods to call */
+class PCanFrameConverter
+{
+    private:
+        /** @brief Private constructor */
+        explicit PCanFrameConverter();
+
+    public:
+        /** @brief Fill a classic CAN message from the frame given
+            @param frame The frame to convert
+            @param message The message to fill, it has to be value-initialized: the payload
+                           isn't copied for a remote request
+            @return True if no problem occurred, false if the payload is too long for a classic
+                    CAN message */
+        static bool toCanMsg(const QCanBusFrame &frame, TPCANMsg &message);
+
+        /** @brief Fill a CAN FD message from the frame given
+            @param frame The frame to convert
+            @param message The message to fill, it has to be value-initialized: the payload
+                           isn't copied for a remote request
+            @return True if no problem occurred, false if the payload size can't be represented
+                    by a DLC */
+        static bool toCanFdMsg(const QCanBusFrame &frame, TPCANMsgFD &message);
+
+        /** @brief Create a frame from a classic CAN message
+            @param message The message read
+            @param timestamp The timestamp of the message read
+            @return The frame created */
+        static QCanBusFrame fromCanMsg(const TPCANMsg &message, const TPCANTimestamp &timestamp);
+
+        /** @brief Create a frame from a CAN FD message
+            @param message The message read
+            @param timestamp The timestamp of the message read, in us
+            @param frame The frame created
+            @return True if no problem occurred, false if the message DLC is unknown */
+        static bool fromCanFdMsg(const TPCANMsgFD &message,
+                                 TPCANTimestampFD timestamp,
+                                 QCanBusFrame &frame);
+
+        /** @brief Get the timestamp of a classic CAN message in microseconds
+            @param timestamp The timestamp of the message read
+            @return The timestamp in us */
+        static quint64 toMicroSeconds(const TPCANTimestamp &timestamp)
+        {
+            return (MilliToMicroCoeff * (timestamp.millis +
+                                         (MillisOverflowCoeff * timestamp.millis_overflow))) +
+                   timestamp.micros;
+        }
+
+    public:
+        /** @brief The max payload length of a classic CAN frame */
+        static const constexpr int MaxClassicPayloadSize = 8;
+
+    private:
+        /** @brief This is the coefficient to use in order to manage the millisecond overflow */
+        static const constexpr quint64 MillisOverflowCoeff = Q_UINT64_C(0x100000000);
+
+        /** @brief This is the coefficient to use in order to transform milli to micro */
+        static const constexpr quint64 MilliToMicroCoeff = Q_UINT64_C(1000);
+};
@@ -6,7 +6,7 @@
 
 #include <QObject>
 
-#include <QHash>
+#include <array>
 
 
 /** @brief This is the CAN FD DLC representation in the PEAK Can lib */
@@ -44,29 +44,65 @@ class PCanFrameDlc : public QObject
         /** @brief Parse the frame DLC enum from the byte received or sent to the PEAK Can lib
             @param byte The byte to parse
             @return The DLC enum parsed, this returns Unknown if no match has been found */
-        static Enum parseFromByte(quint8 byte);
+        static constexpr Enum parseFromByte(quint8 byte)
+        { return (byte >= _LastValue) ? Unknown : static_cast<Enum>(byte); }
 
         /** @brief Generate the byte to send to the PEAK CAN Lib from the frame DLC enum
             @param value The value to parse
             @return The byte to send.
                     If the enum is equal to @ref _LastValue or @ref Unknown, the method returns
                     @ref Dlc0 */
-        static quint8 toByte(Enum value);
+        static constexpr quint8 toByte(Enum value)
+        { return (value >= _LastValue) ? static_cast<quint8>(Dlc0) : static_cast<quint8>(value); }
 
         /** @brief Parse the DLC from the payload size
             @param size The size to parse
             @return The DLC enum parsed, this returns Unknown if no match has been found */
-        static Enum parseFromSize(qint32 size);
+        static constexpr Enum parseFromSize(qint32 size)
+        { return (size < 0 || size > MaxSize) ? Unknown : SizesDlc[static_cast<quint32>(size)]; }
 
         /** @brief Generate the size of message payload from the DLC enum
             @param value The value to parse
             @return The linked length, if no size is found @ref UnknownSize is used */
-        static qint32 toSize(Enum value);
+        static constexpr qint32 toSize(Enum value)
+        { return (value >= _LastValue) ? UnknownSize : DlcSizes[value]; }
 
-    private:
+        /** @brief Get the payload size linked to the DLC byte received from the PEAK Can lib
+            @note This is equivalent to: toSize(parseFromByte(byte))
+            @param byte The DLC byte to parse
+            @return The linked length, if no size is found @ref UnknownSize is used */
+        static constexpr qint32 byteToSize(quint8 byte)
+        { return (byte >= _LastValue) ? UnknownSize : DlcSizes[byte]; }
+
+    public:
         /** @brief The size of an Unknown DLC */
         static const constexpr qint32 UnknownSize = -1;
 
+        /** @brief The max payload size of a CAN FD frame */
+        static const constexpr qint32 MaxSize = 64;
+
     private:
-        static const QHash<Enum, qint32> DlcSizes;
+        /** @brief The payload sizes, indexed by the DLC enum */
+        static const constexpr std::array<qint8, _LastValue> DlcSizes = {
+            0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64
+        };
+
+        /** @brief The DLC enums, indexed by the payload size */
+        static const constexpr std::array<Enum, MaxSize + 1> SizesDlc = {
+            // From 0 to 8
+            Dlc0, Dlc1, Dlc2, Dlc3, Dlc4, Dlc5, Dlc6, Dlc7, Dlc8,
+            // From 9 to 24
+            Unknown, Unknown, Unknown, Dlc12,
+            Unknown, Unknown, Unknown, Dlc16,
+            Unknown, Unknown, Unknown, Dlc20,
+            Unknown, Unknown, Unknown, Dlc24,
+            // From 25 to 32
+            Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Dlc32,
+            // From 33 to 48
+            Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown,
+            Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Dlc48,
+            // From 49 to 64
+            Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown,
+            Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Unknown, Dlc64
+        };
 };
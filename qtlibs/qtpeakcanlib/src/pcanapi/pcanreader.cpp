@@ -7,18 +7,39 @@
 #include <QDebug>
 #include <QMutex>
 
+#include <cstring>
+
+#include "src/filter/canacceptancetable.hpp"
+#include "src/filter/canrxfilter.hpp"
+#include "src/gateway/cangateway.hpp"
+#include "src/gateway/cangatewaytable.hpp"
+#include "src/metrics/canbusmetrics.hpp"
 #include "src/pcanapi/pcanapi.hpp"
+#include "src/pcanapi/pcanframeconverter.hpp"
 #include "src/pcanapi/pcanframedlc.hpp"
+#include "src/rxring/canframering.hpp"
+#include "src/trace/cantracer.hpp"
 
 #include "src/pcanapi/import_pcanbasic.hpp"
 
 
-PCanReader::PCanReader(PCanBusItf::Enum canBusItf, bool isCanFd, QObject *parent)
+PCanReader::PCanReader(PCanBusItf::Enum canBusItf,
+                       bool isCanFd,
+                       const QSharedPointer<CanFrameRing> &ring,
+                       const QSharedPointer<CanBusMetrics> &metrics,
+                       const QSharedPointer<CanRxFilter> &rxFilter,
+                       const QSharedPointer<CanGateway> &gateway,
+                       QObject *parent)
     : QObject{parent},
     _isCanFd{isCanFd},
     _canBusItf{canBusItf},
-    _readMutex{new QMutex()}
+    _readMutex{new QMutex()},
+    _ring{ring},
+    _metrics{metrics},
+    _rxFilter{rxFilter},
+    _gateway{gateway}
 {
+    _gatewayClock.start();
 }
 
 PCanReader::~PCanReader()
@@ -52,6 +73,9 @@ void PCanReader::cancelReading()
 {
     qDebug() << "Ask for read cancelling";
     _cancel = true;
+
+    // The reader may be blocked in a push, if the ring is full and its policy is Block
+    _ring->cancelPendingPush();
 }
 
 void PCanReader::readMessages()
@@ -121,20 +145,22 @@ bool PCanReader::processReceivedMessages()
 {
     TPCANStatus status = PCAN_ERROR_OK;
 
+    // The tables are got once by wake up, they may be updated by the device thread meanwhile
+    const QSharedPointer<const CanAcceptanceTable> table = _rxFilter->getTable();
+    const QSharedPointer<const CanGatewayTable> gatewayTable = _gateway->getTable();
+
     while(isItOkToContinueMessageProcessing(status) && !_cancel)
     {
-        status = _isCanFd ? processCanFdMessages() : processCanMessages();
-
-        processFramesQueueEmitting();
+        status = _isCanFd ? processCanFdMessages(table.data(), gatewayTable.data()) :
+                            processCanMessages(table.data(), gatewayTable.data());
+        countErrorStatus(status);
     }
 
-    // We send all we got before waiting for new event
-    processFramesQueueEmitting(true);
-
     return !isReadErrorFatal(status);
 }
 
-quint32 PCanReader::processCanMessages()
+quint32 PCanReader::processCanMessages(const CanAcceptanceTable *table,
+                                       const CanGatewayTable *gatewayTable)
 {
     TPCANMsg canMsg;
     TPCANTimestamp canTimeStamp;
@@ -158,35 +184,58 @@ quint32 PCanReader::processCanMessages()
         return canStatus;
     }
 
+    CAN_TRACE_FRAME(_canBusItf,
+                    CanTraceRing::Kind::RxFrame,
+                    canMsg.ID,
+                    canMsg.MSGTYPE,
+                    canMsg.DATA,
+                    canMsg.LEN,
+                    PCAN_ERROR_OK);
+
     // The following code is inspired by the message management done by Qt in their libs
     if(Q_UNLIKELY(canMsg.MSGTYPE & PCAN_MESSAGE_STATUS))
     {
         // Filter out PCAN status frames, to avoid turning them
         // into QCanBusFrame::DataFrames with random canId
+        manageBusStatus(CAN_GetStatus(PCanBusItf::toTPCanHandle(_canBusItf)));
         return PCAN_ERROR_OK;
     }
 
-    const int size = static_cast<int>(canMsg.LEN);
-    QCanBusFrame frame(canMsg.ID, QByteArray(reinterpret_cast<const char *>(canMsg.DATA), size));
-
-    const quint64 millis = canTimeStamp.millis +
-                           (MillisOverflowCoeff * canTimeStamp.millis_overflow);
+    if(Q_UNLIKELY(canMsg.MSGTYPE & PCAN_MESSAGE_ERRFRAME))
+    {
+        emit busEventOccurred(CanBusEvent::ErrorFrame);
+        return PCAN_ERROR_OK;
+    }
 
-    const quint64 micros = (MilliToMicroCoeff * millis) + canTimeStamp.micros;
-    frame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(static_cast<qint64>(micros)));
+    if(gatewayTable != nullptr &&
+       !forwardFrame(*gatewayTable,
+                     canMsg.ID,
+                     canMsg.MSGTYPE,
+                     canMsg.DATA,
+                     canMsg.LEN,
+                     _gatewayClock.nsecsElapsed()))
+    {
+        // The frame is only forwarded
+        countUnconvertedFrame(canMsg.MSGTYPE, canMsg.LEN);
+        return PCAN_ERROR_OK;
+    }
 
-    frame.setExtendedFrameFormat(canMsg.MSGTYPE & PCAN_MESSAGE_EXTENDED);
-    frame.setFrameType((canMsg.MSGTYPE & PCAN_MESSAGE_RTR) ? QCanBusFrame::RemoteRequestFrame :
-                                                             QCanBusFrame::DataFrame);
+    if(table != nullptr && !table->accepts(canMsg.ID, (canMsg.MSGTYPE & PCAN_MESSAGE_EXTENDED)))
+    {
+        // No one is interested by this frame, it's dropped before being converted
+        _rxFilter->addRejectedFrame();
+        countUnconvertedFrame(canMsg.MSGTYPE, canMsg.LEN);
+        return PCAN_ERROR_OK;
+    }
 
-    qDebug() << "A frame has been received from CAN bus: " <<  PCanBusItf::toString(_canBusItf)
-             << ", the frame: " << frame.toString();
+    const QCanBusFrame frame = PCanFrameConverter::fromCanMsg(canMsg, canTimeStamp);
 
-    _framesQueue.append(frame);
+    pushFrame(frame);
     return PCAN_ERROR_OK;
 }
 
-quint32 PCanReader::processCanFdMessages()
+quint32 PCanReader::processCanFdMessages(const CanAcceptanceTable *table,
+                                         const CanGatewayTable *gatewayTable)
 {
     TPCANMsgFD canFdMsg;
     TPCANTimestampFD canTimeStamp;
@@ -210,17 +259,53 @@ quint32 PCanReader::processCanFdMessages()
         return  canStatus;
     }
 
+    CAN_TRACE_FRAME(_canBusItf,
+                    CanTraceRing::Kind::RxFrame,
+                    canFdMsg.ID,
+                    canFdMsg.MSGTYPE,
+                    canFdMsg.DATA,
+                    PCanFrameDlc::byteToSize(canFdMsg.DLC),
+                    PCAN_ERROR_OK);
+
     // The following code is inspired by the message management done by Qt in their libs
     if(Q_UNLIKELY(canFdMsg.MSGTYPE & PCAN_MESSAGE_STATUS))
     {
         // Filter out PCAN status frames, to avoid turning them
         // into QCanBusFrame::DataFrames with random canId
+        manageBusStatus(CAN_GetStatus(PCanBusItf::toTPCanHandle(_canBusItf)));
         return PCAN_ERROR_OK;
     }
 
-    const PCanFrameDlc::Enum frameDlc = PCanFrameDlc::parseFromByte(canFdMsg.DLC);
+    if(Q_UNLIKELY(canFdMsg.MSGTYPE & PCAN_MESSAGE_ERRFRAME))
+    {
+        emit busEventOccurred(CanBusEvent::ErrorFrame);
+        return PCAN_ERROR_OK;
+    }
 
-    if(frameDlc == PCanFrameDlc::Unknown)
+    if(gatewayTable != nullptr &&
+       !forwardFrame(*gatewayTable,
+                     canFdMsg.ID,
+                     canFdMsg.MSGTYPE,
+                     canFdMsg.DATA,
+                     canFdMsg.DLC,
+                     _gatewayClock.nsecsElapsed()))
+    {
+        // The frame is only forwarded
+        countUnconvertedFrame(canFdMsg.MSGTYPE, PCanFrameDlc::byteToSize(canFdMsg.DLC));
+        return PCAN_ERROR_OK;
+    }
+
+    if(table != nullptr &&
+       !table->accepts(canFdMsg.ID, (canFdMsg.MSGTYPE & PCAN_MESSAGE_EXTENDED)))
+    {
+        // No one is interested by this frame, it's dropped before being converted
+        _rxFilter->addRejectedFrame();
+        countUnconvertedFrame(canFdMsg.MSGTYPE, PCanFrameDlc::byteToSize(canFdMsg.DLC));
+        return PCAN_ERROR_OK;
+    }
+
+    QCanBusFrame frame;
+    if(!PCanFrameConverter::fromCanFdMsg(canFdMsg, canTimeStamp, frame))
     {
         qWarning() << "A problem occurred when tried to parse the DLC value of the CAN FD message, "
                    << "we can't parse the message and we will ignore it. The CAN FD msg id is: "
@@ -228,36 +313,202 @@ quint32 PCanReader::processCanFdMessages()
         return PCAN_ERROR_OK;
     }
 
-    QCanBusFrame frame(canFdMsg.ID, QByteArray(reinterpret_cast<const char *>(canFdMsg.DATA),
-                                               PCanFrameDlc::toSize(frameDlc)));
+    pushFrame(frame);
 
-    frame.setTimeStamp(QCanBusFrame::TimeStamp::fromMicroSeconds(
-                                                                static_cast<qint64>(canTimeStamp)));
-    frame.setExtendedFrameFormat(canFdMsg.MSGTYPE & PCAN_MESSAGE_EXTENDED);
-    frame.setFrameType((canFdMsg.MSGTYPE & PCAN_MESSAGE_RTR)
-                           ? QCanBusFrame::RemoteRequestFrame : QCanBusFrame::DataFrame);
-    frame.setFlexibleDataRateFormat(canFdMsg.MSGTYPE & PCAN_MESSAGE_FD);
-    frame.setBitrateSwitch(canFdMsg.MSGTYPE & PCAN_MESSAGE_BRS);
-    frame.setErrorStateIndicator(canFdMsg.MSGTYPE & PCAN_MESSAGE_ESI);
+    return canStatus;
+}
 
-    qDebug() << "A frame has been received from FD CAN bus: " <<  PCanBusItf::toString(_canBusItf)
-             << ", the frame: " << frame.toString();
-    _framesQueue.append(frame);
+bool PCanReader::forwardFrame(const CanGatewayTable &gatewayTable,
+                              quint32 frameId,
+                              quint8 msgType,
+                              const quint8 *data,
+                              quint8 dlc,
+                              qint64 readTimeInNs)
+{
+    const CanGatewayTable::Route *route = gatewayTable.findRoute(
+        frameId,
+        (msgType & PCAN_MESSAGE_EXTENDED) != 0);
 
-    return canStatus;
+    if(route == nullptr)
+    {
+        return true;
+    }
+
+    const int length = _isCanFd ? PCanFrameDlc::byteToSize(dlc) : dlc;
+    if(length < 0)
+    {
+        // The frame will be ignored by the local processing too
+        return true;
+    }
+
+    quint32 targetId = frameId;
+    quint8 targetMsgType = msgType;
+    if(route->idRemapped)
+    {
+        targetId = route->remappedId;
+        targetMsgType = route->remappedIdExtended ?
+                            static_cast<quint8>(msgType | PCAN_MESSAGE_EXTENDED) :
+                            static_cast<quint8>(msgType & ~PCAN_MESSAGE_EXTENDED);
+    }
+
+    const quint16 targetHandle = PCanBusItf::toTPCanHandle(route->targetCanBusItf);
+    TPCANStatus status = PCAN_ERROR_OK;
+
+    if(route->targetCanFd)
+    {
+        // A classic frame is written as is on a CAN FD bus: its DLC is also its length
+        TPCANMsgFD canFdMsg;
+        canFdMsg.ID = targetId;
+        canFdMsg.MSGTYPE = targetMsgType;
+        canFdMsg.DLC = dlc;
+        memcpy(canFdMsg.DATA, data, static_cast<size_t>(length));
+        route->rewrite(canFdMsg.DATA, length);
+
+        status = CAN_WriteFD(targetHandle, &canFdMsg);
+        CAN_TRACE_FRAME(route->targetCanBusItf,
+                        (status == PCAN_ERROR_OK) ? CanTraceRing::Kind::TxFrame :
+                                                    CanTraceRing::Kind::TxError,
+                        canFdMsg.ID,
+                        canFdMsg.MSGTYPE,
+                        canFdMsg.DATA,
+                        length,
+                        status);
+    }
+    else
+    {
+        if((targetMsgType & PCAN_MESSAGE_FD) ||
+           length > PCanFrameConverter::MaxClassicPayloadSize)
+        {
+            _gateway->addIncompatibleFrame();
+            return route->deliveredLocally;
+        }
+
+        TPCANMsg canMsg;
+        canMsg.ID = targetId;
+        canMsg.MSGTYPE = static_cast<quint8>(targetMsgType &
+                                             (PCAN_MESSAGE_EXTENDED | PCAN_MESSAGE_RTR));
+        canMsg.LEN = static_cast<quint8>(length);
+        memcpy(canMsg.DATA, data, static_cast<size_t>(length));
+        route->rewrite(canMsg.DATA, length);
+
+        status = CAN_Write(targetHandle, &canMsg);
+        CAN_TRACE_FRAME(route->targetCanBusItf,
+                        (status == PCAN_ERROR_OK) ? CanTraceRing::Kind::TxFrame :
+                                                    CanTraceRing::Kind::TxError,
+                        canMsg.ID,
+                        canMsg.MSGTYPE,
+                        canMsg.DATA,
+                        canMsg.LEN,
+                        status);
+    }
+
+    if(status != PCAN_ERROR_OK)
+    {
+        // The error isn't logged for each frame, the failed frames are counted
+        _gateway->addFailedFrame();
+        if(!route->targetMetrics.isNull())
+        {
+            route->targetMetrics->addTxError();
+        }
+
+        return route->deliveredLocally;
+    }
+
+    _gateway->addForwardedFrame(_gatewayClock.nsecsElapsed() - readTimeInNs);
+
+    // The frame doesn't go through the target device, it's counted here in its metrics
+    if(!route->targetMetrics.isNull())
+    {
+        route->targetMetrics->addTxFrame(length,
+                                         (targetMsgType & PCAN_MESSAGE_EXTENDED) != 0,
+                                         (targetMsgType & PCAN_MESSAGE_FD) != 0,
+                                         (targetMsgType & PCAN_MESSAGE_BRS) != 0,
+                                         (targetMsgType & PCAN_MESSAGE_RTR) != 0);
+    }
+
+    return route->deliveredLocally;
+}
+
+void PCanReader::countUnconvertedFrame(quint8 msgType, int length)
+{
+    // An invalid DLC gives a negative length, the frame is counted without payload
+    _metrics->addRxFrame(qMax(0, length),
+                         (msgType & PCAN_MESSAGE_EXTENDED) != 0,
+                         (msgType & PCAN_MESSAGE_FD) != 0,
+                         (msgType & PCAN_MESSAGE_BRS) != 0,
+                         (msgType & PCAN_MESSAGE_RTR) != 0);
 }
 
-void PCanReader::processFramesQueueEmitting(bool forceSendAll)
+void PCanReader::pushFrame(const QCanBusFrame &frame)
 {
-    const int frameQueueSize = _framesQueue.size();
-    if(frameQueueSize == 0 || (frameQueueSize < MaxFramesNbToEmit && !forceSendAll))
+    // The frame is counted even if it's dropped by the ring, it has been received on the bus
+    _metrics->addRxFrame(frame);
+
+    if(!_ring->push(frame))
     {
-        // Nothing to do
+        // The frame has been dropped, it's counted in the ring stats
         return;
     }
 
-    emit framesReceived(_framesQueue);
-    _framesQueue.clear();
+    if(_ring->armNotification())
+    {
+        emit framesAvailable();
+    }
+}
+
+void PCanReader::countErrorStatus(quint32 errorStatus)
+{
+    if(errorStatus == PCAN_ERROR_OK || errorStatus == PCAN_ERROR_QRCVEMPTY)
+    {
+        return;
+    }
+
+    if(errorStatus == PCAN_ERROR_QOVERRUN)
+    {
+        // The reading continues, but frames have been lost in the driver
+        _metrics->addOverrun();
+        return;
+    }
+
+    _metrics->addRxError();
+    manageBusStatus(errorStatus);
+}
+
+void PCanReader::manageBusStatus(quint32 busStatus)
+{
+    CanBusEvent::Enum busState = CanBusEvent::Unknown;
+
+    // The status may contain several flags, the worst state is kept
+    if(busStatus & PCAN_ERROR_BUSOFF)
+    {
+        busState = CanBusEvent::BusOff;
+    }
+    else if(busStatus & PCAN_ERROR_BUSPASSIVE)
+    {
+        busState = CanBusEvent::ErrorPassive;
+    }
+    else if(busStatus & (PCAN_ERROR_BUSHEAVY | PCAN_ERROR_BUSLIGHT))
+    {
+        busState = CanBusEvent::ErrorWarning;
+    }
+    else if(busStatus != PCAN_ERROR_OK)
+    {
+        // This isn't a bus status, the current state is kept
+        return;
+    }
+
+    if(busState == _busState)
+    {
+        return;
+    }
+
+    _busState = busState;
+
+    if(busState != CanBusEvent::Unknown)
+    {
+        CAN_TRACE_BUS_EVENT(_canBusItf, busState);
+        emit busEventOccurred(busState);
+    }
 }
 
 bool PCanReader::isItOkToContinueMessageProcessing(quint32 errorStatus)
@@ -7,9 +7,18 @@
 #include <QObject>
 
 #include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QSharedPointer>
 
+#include "src/models/canbusevent.hpp"
 #include "src/pcanapi/pcanbusitf.hpp"
 
+class CanAcceptanceTable;
+class CanBusMetrics;
+class CanFrameRing;
+class CanGateway;
+class CanGatewayTable;
+class CanRxFilter;
 class QMutex;
 
 
@@ -25,8 +34,20 @@ class PCanReader : public QObject
         /** @brief Class constructor
             @param canBusIntf The CAN Bus interface key
             @param isCanFd Say if we use the CAN FD to read messages
+            @param ring The ring where the received frames are pushed, the reader is its producer
+            @param metrics The metrics of the bus, where the received frames and the errors are
+                           counted
+            @param rxFilter The acceptance filter to apply on the frames read, before converting
+                            them
+            @param gateway The gateway to apply on the frames read, before filtering them
             @param parent The class parent */
-        explicit PCanReader(PCanBusItf::Enum canBusItf, bool isCanFd, QObject *parent = nullptr);
+        explicit PCanReader(PCanBusItf::Enum canBusItf,
+                            bool isCanFd,
+                            const QSharedPointer<CanFrameRing> &ring,
+                            const QSharedPointer<CanBusMetrics> &metrics,
+                            const QSharedPointer<CanRxFilter> &rxFilter,
+                            const QSharedPointer<CanGateway> &gateway,
+                            QObject *parent = nullptr);
 
         /** @brief Class destructor */
         virtual ~PCanReader() override;
@@ -56,24 +77,64 @@ class PCanReader : public QObject
         bool processReceivedMessages();
 
         /** @brief The method processes the CAN message received
+            @param table The acceptance table to apply, null if all the frames are accepted
+            @param gatewayTable The gateway table to apply, null if no frame is forwarded
             @return The PEAK Can lib error code of the process */
-        quint32 processCanMessages();
+        quint32 processCanMessages(const CanAcceptanceTable *table,
+                                   const CanGatewayTable *gatewayTable);
 
         /** @brief The method processes the CAN FD message received
+            @param table The acceptance table to apply, null if all the frames are accepted
+            @param gatewayTable The gateway table to apply, null if no frame is forwarded
             @return The PEAK Can lib error code of the process */
-        quint32 processCanFdMessages();
-
-        /** @brief Helpful method to emit the frames queued in @ref _framesQueue, if the
-                   @ref MaxFramesNbToEmit limit is raised
-            @note This is useful to not emit the CAN frame one by one and not a big list if a lot is
-                  received. But to group the read frames by packets
-            @param forceSendAll The method doesn't check the number of queued frames and send all */
-        void processFramesQueueEmitting(bool forceSendAll = false);
+        quint32 processCanFdMessages(const CanAcceptanceTable *table,
+                                     const CanGatewayTable *gatewayTable);
+
+        /** @brief Forward a frame read to the target device of its route, without converting it
+            @param gatewayTable The gateway table to apply
+            @param frameId The id of the frame read
+            @param msgType The PEAK message type of the frame read
+            @param data The payload of the frame read
+            @param dlc The PEAK DLC of the frame read (for a classic frame, this is the length)
+            @param readTimeInNs The time of the reading, given by the gateway clock
+            @return True if the frame has to be delivered to the local consumers */
+        bool forwardFrame(const CanGatewayTable &gatewayTable,
+                          quint32 frameId,
+                          quint8 msgType,
+                          const quint8 *data,
+                          quint8 dlc,
+                          qint64 readTimeInNs);
+
+        /** @brief Count in the bus metrics a frame received which isn't converted, because it's
+                   only forwarded by the gateway or rejected by the acceptance table
+            @param msgType The PEAK message type of the frame read
+            @param length The payload length of the frame read */
+        void countUnconvertedFrame(quint8 msgType, int length);
+
+        /** @brief Push the frame received in the ring and notify the consumer, if no notification
+                   is already pending
+            @param frame The received frame */
+        void pushFrame(const QCanBusFrame &frame);
+
+        /** @brief Count the error status given in the bus metrics
+            @param errorStatus The error status returned by the PEAK CAN lib */
+        void countErrorStatus(quint32 errorStatus);
+
+        /** @brief Notify the bus events linked to the bus status given
+            @note A bus state is only notified when it changes
+            @param busStatus The bus status returned by the PEAK CAN lib */
+        void manageBusStatus(quint32 busStatus);
 
     signals:
-        /** @brief Emitted when new frames are received
-            @param frames The received frame */
-        void framesReceived(QVector<QCanBusFrame> frames);
+        /** @brief Emitted when new frames are available in the ring
+            @note The notification is coalesced: it's only emitted once until the consumer drains
+                  the ring */
+        void framesAvailable();
+
+        /** @brief Emitted when a bus event occurred: an error frame has been received or the bus
+                   state has changed
+            @param event The bus event */
+        void busEventOccurred(CanBusEvent::Enum event);
 
     private:
         /** @brief Test if it's ok to continue the message processing thanks to the @ref errorStatus
@@ -92,19 +153,15 @@ class PCanReader : public QObject
         /** @brief This defines the read timeout when waiting for a read event */
         static const constexpr quint32 ReadWaitingTimeoutInMs = 100;
 
-        /** @brief This is max frames number to have before emitting a signal */
-        static const constexpr int MaxFramesNbToEmit = 10;
-
-        /** @brief This is the coefficient to use in order to manage the millisecond overflow */
-        static const constexpr quint64 MillisOverflowCoeff = Q_UINT64_C(0x100000000);
-
-        /** @brief This is the coefficient to use in order to transform milli to micro */
-        static const constexpr quint64 MilliToMicroCoeff = Q_UINT64_C(1000);
-
     private:
         bool _cancel{false};
         bool _isCanFd{false};
         PCanBusItf::Enum _canBusItf;
         QMutex *_readMutex{nullptr};
-        QVector<QCanBusFrame> _framesQueue{};
+        QSharedPointer<CanFrameRing> _ring;
+        QSharedPointer<CanBusMetrics> _metrics;
+        QSharedPointer<CanRxFilter> _rxFilter;
+        QSharedPointer<CanGateway> _gateway;
+        QElapsedTimer _gatewayClock;
+        CanBusEvent::Enum _busState{CanBusEvent::Unknown};
 };
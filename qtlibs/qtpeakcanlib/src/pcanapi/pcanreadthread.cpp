@@ -7,13 +7,27 @@
 #include <QDebug>
 #include <QTimer>
 
+#include "src/filter/canrxfilter.hpp"
+#include "src/gateway/cangateway.hpp"
+#include "src/metrics/canbusmetrics.hpp"
 #include "src/pcanapi/pcanreader.hpp"
+#include "src/rxring/canframering.hpp"
 
 
-PCanReadThread::PCanReadThread(PCanBusItf::Enum canBusItf, bool isCanFd, QObject *parent)
+PCanReadThread::PCanReadThread(PCanBusItf::Enum canBusItf,
+                               bool isCanFd,
+                               const QSharedPointer<CanFrameRing> &ring,
+                               const QSharedPointer<CanBusMetrics> &metrics,
+                               const QSharedPointer<CanRxFilter> &rxFilter,
+                               const QSharedPointer<CanGateway> &gateway,
+                               QObject *parent)
     : BaseThread{parent},
     _canBusItf{canBusItf},
-    _isCanFd(isCanFd)
+    _isCanFd(isCanFd),
+    _ring{ring},
+    _metrics{metrics},
+    _rxFilter{rxFilter},
+    _gateway{gateway}
 {
 }
 
@@ -40,10 +54,13 @@ bool PCanReadThread::stopThread()
 
 void PCanReadThread::run()
 {
-    _reader = new PCanReader(_canBusItf, _isCanFd);
+    _ring->resumePendingPush();
+    _reader = new PCanReader(_canBusItf, _isCanFd, _ring, _metrics, _rxFilter, _gateway);
 
-    connect(_reader,    &PCanReader::framesReceived,
-            this,       &PCanReadThread::framesReceived);
+    connect(_reader,    &PCanReader::framesAvailable,
+            this,       &PCanReadThread::framesAvailable);
+    connect(_reader,    &PCanReader::busEventOccurred,
+            this,       &PCanReadThread::busEventOccurred);
     connect(this,    &PCanReadThread::ready,
             _reader, &PCanReader::readMessages, Qt::QueuedConnection);
 
@@ -7,9 +7,15 @@
 #include "threadutility/basethread.hpp"
 
 #include <QObject>
+#include <QSharedPointer>
 
+#include "src/models/canbusevent.hpp"
 #include "src/pcanapi/pcanapi.hpp"
 
+class CanBusMetrics;
+class CanFrameRing;
+class CanGateway;
+class CanRxFilter;
 class PCanReader;
 
 
@@ -23,9 +29,17 @@ class PCanReadThread : public BaseThread
     /** @brief Class constructor
             @param canBusIntf The CAN Bus interface key
             @param isCanFd Say if we use the CAN FD to read messages
+            @param ring The ring where the received frames are pushed
+            @param metrics The metrics of the bus, updated by the reader
+            @param rxFilter The acceptance filter applied by the reader
+            @param gateway The gateway applied by the reader, to forward frames to other devices
             @param parent The class parent */
         explicit PCanReadThread(PCanBusItf::Enum canBusItf,
                                 bool isCanFd,
+                                const QSharedPointer<CanFrameRing> &ring,
+                                const QSharedPointer<CanBusMetrics> &metrics,
+                                const QSharedPointer<CanRxFilter> &rxFilter,
+                                const QSharedPointer<CanGateway> &gateway,
                                 QObject *parent = nullptr);
 
         /** @brief Class destructor */
@@ -41,12 +55,21 @@ class PCanReadThread : public BaseThread
         virtual void run() override;
 
     signals:
-        /** @brief Emitted when new frames are received
-            @param frames The received frame */
-        void framesReceived(const QVector<QCanBusFrame> &frames);
+        /** @brief Emitted when new frames are available in the ring
+            @note The notification is coalesced: it's only emitted once until the consumer drains
+                  the ring */
+        void framesAvailable();
+
+        /** @brief Emitted when a bus event occurred
+            @param event The bus event */
+        void busEventOccurred(CanBusEvent::Enum event);
 
     private:
         PCanBusItf::Enum _canBusItf;
         bool _isCanFd;
+        QSharedPointer<CanFrameRing> _ring;
+        QSharedPointer<CanBusMetrics> _metrics;
+        QSharedPointer<CanRxFilter> _rxFilter;
+        QSharedPointer<CanGateway> _gateway;
         PCanReader *_reader{nullptr};
 };
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canrequesthandle.hpp"
+
+#include "waitutility/waithelper.hpp"
+
+
+CanRequestHandle::CanRequestHandle(quint64 requestId)
+    : _requestId{requestId},
+    _state{(requestId == 0) ? QSharedPointer<State>() : QSharedPointer<State>::create()}
+{
+}
+
+CanRequestStatus::Enum CanRequestHandle::getStatus() const
+{
+    if(_state.isNull())
+    {
+        return CanRequestStatus::Unknown;
+    }
+
+    QMutexLocker locker(&_state->mutex);
+    return _state->status;
+}
+
+bool CanRequestHandle::isFinished() const
+{
+    const CanRequestStatus::Enum status = getStatus();
+    return (status != CanRequestStatus::Pending);
+}
+
+QCanBusFrame CanRequestHandle::getAnswer() const
+{
+    if(_state.isNull())
+    {
+        return QCanBusFrame(QCanBusFrame::InvalidFrame);
+    }
+
+    QMutexLocker locker(&_state->mutex);
+    return _state->answer;
+}
+
+bool CanRequestHandle::waitForFinished(int timeoutInMs) const
+{
+    if(_state.isNull())
+    {
+        return false;
+    }
+
+    WaitHelper::pseudoWait([this]() { return isFinished(); }, timeoutInMs);
+
+    return isAnswered();
+}
+
+bool CanRequestHandle::waitForAll(const QVector<CanRequestHandle> &handles, int timeoutInMs)
+{
+    WaitHelper::pseudoWait([&handles]()
+                           {
+                               for(auto citer = handles.cbegin(); citer != handles.cend(); ++citer)
+                               {
+                                   if(!citer->isFinished())
+                                   {
+                                       return false;
+                                   }
+                               }
+
+                               return true;
+                           },
+                           timeoutInMs);
+
+    bool allAnswered = true;
+    for(auto citer = handles.cbegin(); citer != handles.cend(); ++citer)
+    {
+        allAnswered &= citer->isAnswered();
+    }
+
+    return allAnswered;
+}
+
+void CanRequestHandle::finish(CanRequestStatus::Enum status, const QCanBusFrame &answer)
+{
+    if(_state.isNull())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&_state->mutex);
+
+    if(_state->status != CanRequestStatus::Pending)
+    {
+        return;
+    }
+
+    _state->status = status;
+    _state->answer = answer;
+}
@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QCanBusFrame>
+#include <QMutex>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "src/definescan.hpp"
+#include "src/requests/canrequeststatus.hpp"
+
+
+/** @brief This is the handle of a pipelined CAN request, returned by
+           @ref CanDeviceIntf::sendRequest
+    @note The handle is like a future: it's finished by the CAN device thread when the answer is
+          received, when the timeout raises or when the request fails. The copies of the handle
+          share the same request state.
+    @note The methods are thread safe */
+class CAN_EXPORT CanRequestHandle
+{
+    friend class CanDevice;
+    friend class CanRequestPipeline;
+
+    private:
+        /** @brief The state of the request, shared between the handle copies */
+        struct State
+        {
+            /** @brief Protects the state members */
+            QMutex mutex{};
+
+            /** @brief The request status */
+            CanRequestStatus::Enum status{CanRequestStatus::Pending};
+
+            /** @brief The answer received */
+            QCanBusFrame answer{QCanBusFrame::InvalidFrame};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param requestId The id of the request, if equals to 0, the handle is invalid */
+        explicit CanRequestHandle(quint64 requestId = 0);
+
+    public:
+        /** @brief Test if the handle is linked to a request */
+        bool isValid() const { return !_state.isNull(); }
+
+        /** @brief Get the id of the request */
+        quint64 getRequestId() const { return _requestId; }
+
+        /** @brief Get the current status of the request
+            @note If the handle is invalid, this returns Unknown */
+        CanRequestStatus::Enum getStatus() const;
+
+        /** @brief Test if the request is finished, whatever the result */
+        bool isFinished() const;
+
+        /** @brief Test if the expected answer has been received */
+        bool isAnswered() const { return getStatus() == CanRequestStatus::Answered; }
+
+        /** @brief Get the answer received
+            @note If the request hasn't been answered, the frame returned is invalid */
+        QCanBusFrame getAnswer() const;
+
+        /** @brief Wait for the end of the request
+            @note The event loop of the caller thread is processed while waiting
+            @param timeoutInMs The waiting timeout, -1 to wait until the request end (the request
+                               has its own timeout)
+            @return True if the request has been answered */
+        bool waitForFinished(int timeoutInMs = -1) const;
+
+    public:
+        /** @brief Wait for the end of all the requests given
+            @note The event loop of the caller thread is processed while waiting
+            @note Because the requests are in flight at the same time, waiting for all of them
+                  takes about the time of the slowest one
+            @param handles The handles of the requests to wait for
+            @param timeoutInMs The waiting timeout, -1 to wait until the requests end
+            @return True if all the requests have been answered */
+        static bool waitForAll(const QVector<CanRequestHandle> &handles, int timeoutInMs = -1);
+
+    private:
+        /** @brief Finish the request
+            @note If the request is already finished, nothing is done
+            @param status The final status of the request
+            @param answer The answer received, if the status is Answered */
+        void finish(CanRequestStatus::Enum status,
+                    const QCanBusFrame &answer = QCanBusFrame(QCanBusFrame::InvalidFrame));
+
+    private:
+        quint64 _requestId;
+        QSharedPointer<State> _state;
+};
+
+Q_DECLARE_METATYPE(CanRequestHandle)
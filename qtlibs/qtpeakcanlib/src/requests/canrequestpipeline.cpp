@@ -0,0 +1,250 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canrequestpipeline.hpp"
+
+#include <QDebug>
+#include <QTimer>
+
+#include "src/candevice/candevice.hpp"
+
+
+CanRequestPipeline::CanRequestPipeline(CanDevice &device,
+                                       int maxInFlightRequestsByIdNb,
+                                       QObject *parent)
+    : QObject{parent},
+    _device{device},
+    _maxInFlightRequestsByIdNb{qMax(1, maxInFlightRequestsByIdNb)},
+    _timeoutTimer{new QTimer(this)}
+{
+    _timeoutTimer->setSingleShot(true);
+    connect(_timeoutTimer, &QTimer::timeout, this, &CanRequestPipeline::onTimeout);
+    connect(&_device, &CanDevice::framesReceived, this, &CanRequestPipeline::onFramesReceived);
+
+    _clock.start();
+}
+
+CanRequestPipeline::~CanRequestPipeline()
+{
+    cancelAll();
+}
+
+void CanRequestPipeline::enqueue(const CanRequestHandle &handle,
+                                 const QCanBusFrame &frame,
+                                 const ExpectedCanFrameMask &expected,
+                                 int timeoutInMs)
+{
+    Request request;
+    request.handle = handle;
+    request.frame = frame;
+    request.expected = expected;
+    request.deadlineInMs = (timeoutInMs < 0) ? -1 : (_clock.elapsed() + timeoutInMs);
+
+    const quint32 requestFrameId = frame.frameId();
+
+    // The answer id is accepted by the device filter until the request is finished
+    _device.acquireExpectedIds({ expected });
+
+    if(_inFlightNbById.value(requestFrameId, 0) < _maxInFlightRequestsByIdNb)
+    {
+        writeRequest(request);
+    }
+    else
+    {
+        _waitingRequestsById[requestFrameId].enqueue(request);
+    }
+
+    scheduleTimeoutCheck();
+}
+
+void CanRequestPipeline::cancelAll()
+{
+    _timeoutTimer->stop();
+
+    const QVector<Request> inFlightRequests = _inFlightRequests;
+    const QHash<quint32, QQueue<Request>> waitingRequestsById = _waitingRequestsById;
+
+    _inFlightRequests.clear();
+    _inFlightNbById.clear();
+    _waitingRequestsById.clear();
+
+    for(auto citer = inFlightRequests.cbegin(); citer != inFlightRequests.cend(); ++citer)
+    {
+        finishRequest(*citer, CanRequestStatus::Cancelled);
+    }
+
+    for(auto citer = waitingRequestsById.cbegin(); citer != waitingRequestsById.cend(); ++citer)
+    {
+        for(auto reqIter = citer->cbegin(); reqIter != citer->cend(); ++reqIter)
+        {
+            finishRequest(*reqIter, CanRequestStatus::Cancelled);
+        }
+    }
+}
+
+void CanRequestPipeline::onFramesReceived(const QVector<QCanBusFrame> &frames)
+{
+    if(_inFlightRequests.isEmpty())
+    {
+        return;
+    }
+
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        // The requests in flight are sorted by writing order, the oldest matching one is answered
+        for(int idx = 0; idx < _inFlightRequests.length(); ++idx)
+        {
+            const ExpectedCanFrameMask &expected = _inFlightRequests.at(idx).expected;
+
+            if(expected.getReceivedMsgId() == citer->frameId() &&
+               expected.checkIfMessageReceivedIsValid(*citer, true))
+            {
+                finishInFlightRequest(idx, CanRequestStatus::Answered, *citer);
+                break;
+            }
+        }
+    }
+
+    scheduleTimeoutCheck();
+}
+
+void CanRequestPipeline::onTimeout()
+{
+    const qint64 nowInMs = _clock.elapsed();
+
+    // The waiting requests are processed first, to not write requests which have already timed
+    // out when the in-flight windows are freed
+    for(auto iter = _waitingRequestsById.begin(); iter != _waitingRequestsById.end();)
+    {
+        QQueue<Request> &waitingRequests = iter.value();
+
+        for(int idx = waitingRequests.length() - 1; idx >= 0; --idx)
+        {
+            const qint64 deadlineInMs = waitingRequests.at(idx).deadlineInMs;
+            if(deadlineInMs >= 0 && deadlineInMs <= nowInMs)
+            {
+                finishRequest(waitingRequests.takeAt(idx), CanRequestStatus::TimedOut);
+            }
+        }
+
+        if(waitingRequests.isEmpty())
+        {
+            iter = _waitingRequestsById.erase(iter);
+        }
+        else
+        {
+            ++iter;
+        }
+    }
+
+    for(int idx = _inFlightRequests.length() - 1; idx >= 0; --idx)
+    {
+        const qint64 deadlineInMs = _inFlightRequests.at(idx).deadlineInMs;
+        if(deadlineInMs >= 0 && deadlineInMs <= nowInMs)
+        {
+            qWarning() << "The CAN request: " << _inFlightRequests.at(idx).frame.toString()
+                       << ", hasn't been answered before its timeout";
+
+            // A waiting request may be written and appended, but it can't have timed out yet
+            finishInFlightRequest(idx, CanRequestStatus::TimedOut);
+        }
+    }
+
+    scheduleTimeoutCheck();
+}
+
+void CanRequestPipeline::writeRequest(const Request &request)
+{
+    if(!_device.write(request.frame))
+    {
+        qWarning() << "A problem occurred when tried to write the CAN request: "
+                   << request.frame.toString();
+        finishRequest(request, CanRequestStatus::WriteFailed);
+        return;
+    }
+
+    _inFlightRequests.append(request);
+    ++_inFlightNbById[request.frame.frameId()];
+}
+
+void CanRequestPipeline::writeWaitingRequests(quint32 requestFrameId)
+{
+    auto iter = _waitingRequestsById.find(requestFrameId);
+
+    while(iter != _waitingRequestsById.end() &&
+          !iter->isEmpty() &&
+          _inFlightNbById.value(requestFrameId, 0) < _maxInFlightRequestsByIdNb)
+    {
+        writeRequest(iter->dequeue());
+    }
+
+    if(iter != _waitingRequestsById.end() && iter->isEmpty())
+    {
+        _waitingRequestsById.erase(iter);
+    }
+}
+
+void CanRequestPipeline::finishInFlightRequest(int inFlightIdx,
+                                               CanRequestStatus::Enum status,
+                                               const QCanBusFrame &answer)
+{
+    const Request request = _inFlightRequests.takeAt(inFlightIdx);
+    const quint32 requestFrameId = request.frame.frameId();
+
+    auto nbIter = _inFlightNbById.find(requestFrameId);
+    if(nbIter != _inFlightNbById.end() && --nbIter.value() <= 0)
+    {
+        _inFlightNbById.erase(nbIter);
+    }
+
+    finishRequest(request, status, answer);
+    writeWaitingRequests(requestFrameId);
+}
+
+void CanRequestPipeline::finishRequest(Request request,
+                                       CanRequestStatus::Enum status,
+                                       const QCanBusFrame &answer)
+{
+    _device.releaseExpectedIds({ request.expected });
+
+    request.handle.finish(status, answer);
+    emit requestFinished(request.handle.getRequestId(), (status == CanRequestStatus::Answered));
+}
+
+void CanRequestPipeline::scheduleTimeoutCheck()
+{
+    qint64 earliestDeadlineInMs = -1;
+
+    const auto updateEarliest = [&earliestDeadlineInMs](const Request &request)
+    {
+        if(request.deadlineInMs >= 0 &&
+           (earliestDeadlineInMs < 0 || request.deadlineInMs < earliestDeadlineInMs))
+        {
+            earliestDeadlineInMs = request.deadlineInMs;
+        }
+    };
+
+    for(auto citer = _inFlightRequests.cbegin(); citer != _inFlightRequests.cend(); ++citer)
+    {
+        updateEarliest(*citer);
+    }
+
+    for(auto citer = _waitingRequestsById.cbegin(); citer != _waitingRequestsById.cend(); ++citer)
+    {
+        for(auto reqIter = citer->cbegin(); reqIter != citer->cend(); ++reqIter)
+        {
+            updateEarliest(*reqIter);
+        }
+    }
+
+    if(earliestDeadlineInMs < 0)
+    {
+        _timeoutTimer->stop();
+        return;
+    }
+
+    const qint64 remainingInMs = qMax(static_cast<qint64>(0),
+                                      earliestDeadlineInMs - _clock.elapsed());
+    _timeoutTimer->start(static_cast<int>(remainingInMs));
+}
@@ -0,0 +1,137 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QQueue>
+
+#include "src/models/expectedcanframemask.hpp"
+#include "src/requests/canrequesthandle.hpp"
+
+class CanDevice;
+class QTimer;
+
+
+/** @brief This class manages the pipelined requests of a CAN device: several requests can wait
+           for their answers at the same time
+    @note The object lives in the CAN device thread, it doesn't block the thread while waiting.
+    @note The answers are correlated to the requests thanks to their @ref ExpectedCanFrameMask: a
+          received frame finishes the oldest in flight request it matches (the id and the mask,
+          if one is given).
+    @note The number of requests in flight with the same request frame id is bounded; the other
+          requests wait in a queue and are written when a previous request is finished. */
+class CanRequestPipeline : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief A request managed by the pipeline */
+        struct Request
+        {
+            /** @brief The handle to finish with the request result */
+            CanRequestHandle handle{};
+
+            /** @brief The request frame to write */
+            QCanBusFrame frame{};
+
+            /** @brief The description of the expected answer */
+            ExpectedCanFrameMask expected{0};
+
+            /** @brief The time when the request times out, relatively to the pipeline clock;
+                       -1 if it never times out */
+            qint64 deadlineInMs{-1};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param device The device used to write the requests and to receive the answers
+            @param maxInFlightRequestsByIdNb The max number of requests in flight with the same
+                                             request frame id
+            @param parent The class parent */
+        explicit CanRequestPipeline(CanDevice &device,
+                                    int maxInFlightRequestsByIdNb,
+                                    QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanRequestPipeline() override;
+
+    public:
+        /** @brief Add a request to the pipeline
+            @note The request is written at once if the in-flight window of its id isn't full
+            @note The request end is notified through its handle and with @ref requestFinished
+            @param handle The handle of the request
+            @param frame The request frame to write
+            @param expected The description of the expected answer
+            @param timeoutInMs The request timeout, it starts when the request is added; -1 to
+                               wait forever */
+        void enqueue(const CanRequestHandle &handle,
+                     const QCanBusFrame &frame,
+                     const ExpectedCanFrameMask &expected,
+                     int timeoutInMs);
+
+        /** @brief Cancel all the requests in flight and waiting */
+        void cancelAll();
+
+    signals:
+        /** @brief Emitted when a request is finished
+            @param requestId The id of the request
+            @param success True if the request has been answered */
+        void requestFinished(quint64 requestId, bool success);
+
+    private slots:
+        /** @brief Called when frames are received by the device, to find the answers of the
+                   requests in flight
+            @param frames The frames received */
+        void onFramesReceived(const QVector<QCanBusFrame> &frames);
+
+        /** @brief Called when the earliest request deadline is reached */
+        void onTimeout();
+
+    private:
+        /** @brief Write a request and add it to the requests in flight
+            @note If the writing fails, the request is finished
+            @param request The request to write */
+        void writeRequest(const Request &request);
+
+        /** @brief Write the waiting requests of the id given, while its in-flight window isn't
+                   full
+            @param requestFrameId The id of the requests to write */
+        void writeWaitingRequests(quint32 requestFrameId);
+
+        /** @brief Finish a request in flight and write the next waiting request with the same id
+            @param inFlightIdx The index of the request in @ref _inFlightRequests
+            @param status The final status of the request
+            @param answer The answer received, if the status is Answered */
+        void finishInFlightRequest(int inFlightIdx,
+                                   CanRequestStatus::Enum status,
+                                   const QCanBusFrame &answer = QCanBusFrame(
+                                       QCanBusFrame::InvalidFrame));
+
+        /** @brief Finish a request and emit @ref requestFinished
+            @param request The request to finish
+            @param status The final status of the request
+            @param answer The answer received, if the status is Answered */
+        void finishRequest(Request request,
+                           CanRequestStatus::Enum status,
+                           const QCanBusFrame &answer = QCanBusFrame(QCanBusFrame::InvalidFrame));
+
+        /** @brief Restart the timer for the earliest deadline of the requests */
+        void scheduleTimeoutCheck();
+
+    private:
+        CanDevice &_device;
+        int _maxInFlightRequestsByIdNb;
+
+        QVector<Request> _inFlightRequests;
+        QHash<quint32, int> _inFlightNbById;
+        QHash<quint32, QQueue<Request>> _waitingRequestsById;
+
+        QElapsedTimer _clock;
+        QTimer *_timeoutTimer{nullptr};
+};
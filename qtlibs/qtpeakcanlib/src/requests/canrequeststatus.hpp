@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "src/definescan.hpp"
+
+
+/** @brief Describes the status of a pipelined CAN request, see @ref CanRequestHandle */
+class CAN_EXPORT CanRequestStatus : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The request status */
+        enum Enum {
+            Pending,        //!< @brief The request is waiting to be written or to be answered
+            Answered,       //!< @brief The expected answer has been received
+            TimedOut,       //!< @brief The answer hasn't been received before the timeout
+            WriteFailed,    //!< @brief The request frame couldn't be written
+            Cancelled,      //!< @brief The request has been cancelled, the device is uninitialized
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+};
@@ -0,0 +1,232 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canframering.hpp"
+
+#include <QDebug>
+#include <QThread>
+
+
+CanFrameRing::CanFrameRing(int capacity, CanRingOverflowPolicy::Enum overflowPolicy)
+    : _mask{0},
+    _overflowPolicy{overflowPolicy}
+{
+    if(_overflowPolicy == CanRingOverflowPolicy::Unknown)
+    {
+        qWarning() << "The overflow policy given to the CAN frame ring is unknown, we use the "
+                   << "default one: " << CanRingOverflowPolicy::toString(DefaultOverflowPolicy);
+        _overflowPolicy = DefaultOverflowPolicy;
+    }
+
+    quint64 realCapacity = MinCapacity;
+    while(realCapacity < static_cast<quint64>(capacity))
+    {
+        realCapacity <<= 1;
+    }
+
+    _mask = realCapacity - 1;
+    _slots.reset(new Slot[realCapacity]);
+
+    for(quint64 idx = 0; idx < realCapacity; ++idx)
+    {
+        _slots[idx].sequence.store(idx, std::memory_order_relaxed);
+    }
+}
+
+int CanFrameRing::getSize() const
+{
+    const quint64 popPos = _popPos.load(std::memory_order_acquire);
+    const quint64 pushPos = _pushPos.load(std::memory_order_acquire);
+
+    if(pushPos <= popPos)
+    {
+        // The consumer may have claimed a slot after we read the push position
+        return 0;
+    }
+
+    return static_cast<int>(qMin(pushPos - popPos, _mask + 1));
+}
+
+bool CanFrameRing::push(const QCanBusFrame &frame)
+{
+    if(Q_LIKELY(tryPush(frame)))
+    {
+        return true;
+    }
+
+    switch(_overflowPolicy)
+    {
+        case CanRingOverflowPolicy::DropOldest:
+            while(!tryPush(frame))
+            {
+                if(getSize() <= static_cast<int>(_mask))
+                {
+                    // The ring isn't full, the consumer is popping the slot we want to write;
+                    // this only lasts the time of a frame copy
+                    QThread::yieldCurrentThread();
+                }
+                else if(tryPop(nullptr))
+                {
+                    _droppedFramesNb.fetch_add(1, std::memory_order_relaxed);
+                }
+            }
+            return true;
+
+        case CanRingOverflowPolicy::Block:
+            while(!tryPush(frame))
+            {
+                if(_pushCancelled.load(std::memory_order_relaxed))
+                {
+                    _droppedFramesNb.fetch_add(1, std::memory_order_relaxed);
+                    return false;
+                }
+
+                QThread::usleep(BlockRetryDelayInUs);
+            }
+            return true;
+
+        case CanRingOverflowPolicy::DropNewest:
+        case CanRingOverflowPolicy::Unknown:
+            break;
+    }
+
+    _droppedFramesNb.fetch_add(1, std::memory_order_relaxed);
+    return false;
+}
+
+int CanFrameRing::popAll(QVector<QCanBusFrame> &frames, int maxFramesNb)
+{
+    const int size = getSize();
+    const int toPopNb = (maxFramesNb < 0) ? size : qMin(size, maxFramesNb);
+
+    frames.reserve(frames.size() + toPopNb);
+
+    int poppedNb = 0;
+    QCanBusFrame frame;
+    while(poppedNb < toPopNb && tryPop(&frame))
+    {
+        frames.append(std::move(frame));
+        ++poppedNb;
+    }
+
+    return poppedNb;
+}
+
+void CanFrameRing::clear()
+{
+    while(tryPop(nullptr))
+    {
+    }
+}
+
+bool CanFrameRing::armNotification()
+{
+    return !_notificationArmed.exchange(true, std::memory_order_acq_rel);
+}
+
+void CanFrameRing::disarmNotification()
+{
+    _notificationArmed.exchange(false, std::memory_order_acq_rel);
+}
+
+void CanFrameRing::cancelPendingPush()
+{
+    _pushCancelled.store(true, std::memory_order_relaxed);
+}
+
+void CanFrameRing::resumePendingPush()
+{
+    _pushCancelled.store(false, std::memory_order_relaxed);
+}
+
+CanFrameRingStats CanFrameRing::getStats() const
+{
+    return CanFrameRingStats(getCapacity(),
+                             getSize(),
+                             _highWaterMark.load(std::memory_order_relaxed),
+                             _pushedFramesNb.load(std::memory_order_relaxed),
+                             _droppedFramesNb.load(std::memory_order_relaxed));
+}
+
+void CanFrameRing::resetStats()
+{
+    _highWaterMark.store(getSize(), std::memory_order_relaxed);
+    _pushedFramesNb.store(0, std::memory_order_relaxed);
+    _droppedFramesNb.store(0, std::memory_order_relaxed);
+}
+
+bool CanFrameRing::tryPush(const QCanBusFrame &frame)
+{
+    // There is only one producer, no one else modifies the push position
+    const quint64 pos = _pushPos.load(std::memory_order_relaxed);
+    Slot &slot = _slots[pos & _mask];
+
+    if(slot.sequence.load(std::memory_order_acquire) != pos)
+    {
+        // The slot hasn't been released by the consumer, the ring is full
+        return false;
+    }
+
+    slot.frame = frame;
+    slot.sequence.store(pos + 1, std::memory_order_release);
+    _pushPos.store(pos + 1, std::memory_order_release);
+
+    _pushedFramesNb.fetch_add(1, std::memory_order_relaxed);
+    updateHighWaterMark();
+    return true;
+}
+
+bool CanFrameRing::tryPop(QCanBusFrame *frame)
+{
+    quint64 pos = _popPos.load(std::memory_order_relaxed);
+    Slot *slot = nullptr;
+
+    while(true)
+    {
+        slot = &_slots[pos & _mask];
+        const quint64 sequence = slot->sequence.load(std::memory_order_acquire);
+        const qint64 diff = static_cast<qint64>(sequence - (pos + 1));
+
+        if(diff < 0)
+        {
+            // The slot hasn't been written yet, the ring is empty
+            return false;
+        }
+
+        if(diff == 0)
+        {
+            if(_popPos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed))
+            {
+                break;
+            }
+
+            // The position has been updated by the compare method, we retry with it
+        }
+        else
+        {
+            // The slot has already been popped by the other side
+            pos = _popPos.load(std::memory_order_relaxed);
+        }
+    }
+
+    if(frame != nullptr)
+    {
+        *frame = std::move(slot->frame);
+    }
+
+    // Release the payload memory now, the slot may wait a long time before being reused
+    slot->frame = QCanBusFrame();
+    slot->sequence.store(pos + _mask + 1, std::memory_order_release);
+    return true;
+}
+
+void CanFrameRing::updateHighWaterMark()
+{
+    const int size = getSize();
+
+    if(size > _highWaterMark.load(std::memory_order_relaxed))
+    {
+        _highWaterMark.store(size, std::memory_order_relaxed);
+    }
+}
@@ -0,0 +1,160 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QCanBusFrame>
+#include <QVector>
+
+#include "src/rxring/canframeringstats.hpp"
+#include "src/rxring/canringoverflowpolicy.hpp"
+
+
+/** @brief This is a bounded and lock-free ring of CAN frames, shared between one producer thread
+           and one consumer thread
+    @note The ring replaces the emitting of frames vectors between threads: if the consumer
+          thread stalls, the Qt event queue doesn't grow without bound. The ring size is
+          limited by its capacity and the @ref CanRingOverflowPolicy says what to do when it's
+          full.
+    @note The consumer is woken by a single coalesced notification: the producer calls
+          @ref armNotification after pushing and only notifies the consumer if the method returns
+          true. The consumer calls @ref disarmNotification before draining the ring.
+    @note Each slot has its own sequence number; therefore, when the @ref CanRingOverflowPolicy is
+          DropOldest, the producer can also pop the oldest frame without racing with the
+          consumer. */
+class CanFrameRing
+{
+    public:
+        /** @brief Class constructor
+            @param capacity The ring capacity, it's rounded up to the next power of two
+            @param overflowPolicy The policy to apply when a frame is pushed in a full ring */
+        explicit CanFrameRing(int capacity = DefaultCapacity,
+                              CanRingOverflowPolicy::Enum overflowPolicy = DefaultOverflowPolicy);
+
+    public:
+        /** @brief Get the ring capacity */
+        int getCapacity() const { return static_cast<int>(_mask + 1); }
+
+        /** @brief Get the overflow policy */
+        CanRingOverflowPolicy::Enum getOverflowPolicy() const { return _overflowPolicy; }
+
+        /** @brief Get the number of frames waiting in the ring
+            @note The value is only a snapshot, it may be outdated when returned */
+        int getSize() const;
+
+        /** @brief Push a frame in the ring
+            @note Only call this method from the producer thread
+            @note If the ring is full, the overflow policy is applied. With the Block policy, the
+                  method waits until there is a free place or until @ref cancelPendingPush is
+                  called.
+            @param frame The frame to push
+            @return True if the frame has been pushed, false if it has been dropped */
+        bool push(const QCanBusFrame &frame);
+
+        /** @brief Pop all the frames waiting in the ring
+            @note Only call this method from the consumer thread
+            @param frames The popped frames are appended to this vector
+            @param maxFramesNb The max number of frames to pop, if equals to -1, the method pops
+                               all the frames waiting (limited by the ring capacity)
+            @return The number of frames popped */
+        int popAll(QVector<QCanBusFrame> &frames, int maxFramesNb = -1);
+
+        /** @brief Drop all the frames waiting in the ring
+            @note Only call this method from the consumer thread */
+        void clear();
+
+        /** @brief Try to arm the coalesced notification
+            @note Only call this method from the producer thread, after having pushed frames
+            @return True if the notification wasn't armed: the caller has to notify the consumer.
+                    False if a notification is already pending */
+        bool armNotification();
+
+        /** @brief Disarm the coalesced notification
+            @note Only call this method from the consumer thread and before draining the ring;
+                  therefore, the frames pushed while draining will generate a new notification */
+        void disarmNotification();
+
+        /** @brief Make the current, and the next, blocking push return without waiting
+            @note This is useful to stop the producer thread when the policy is Block
+            @note This can be called from any thread */
+        void cancelPendingPush();
+
+        /** @brief Allow again the push to block, after a call to @ref cancelPendingPush
+            @note This can be called from any thread */
+        void resumePendingPush();
+
+        /** @brief Get a snapshot of the ring statistics */
+        CanFrameRingStats getStats() const;
+
+        /** @brief Reset the ring statistics
+            @note The high water mark is set to the current ring size */
+        void resetStats();
+
+    private:
+        /** @brief Try to push a frame in the ring, without applying the overflow policy
+            @param frame The frame to push
+            @return True if the frame has been pushed, false if the ring is full */
+        bool tryPush(const QCanBusFrame &frame);
+
+        /** @brief Try to pop the oldest frame of the ring
+            @note This may be called by the consumer and also by the producer (when the policy is
+                  DropOldest)
+            @param frame If not null, the popped frame is moved into it
+            @return True if a frame has been popped, false if the ring is empty or if the oldest
+                    frame is being popped by the other side */
+        bool tryPop(QCanBusFrame *frame);
+
+        /** @brief Update the high water mark with the current ring size
+            @note Only call this method from the producer thread */
+        void updateHighWaterMark();
+
+    public:
+        /** @brief The default ring capacity */
+        static const constexpr int DefaultCapacity = 4096;
+
+        /** @brief The default overflow policy */
+        static const constexpr CanRingOverflowPolicy::Enum DefaultOverflowPolicy =
+            CanRingOverflowPolicy::DropOldest;
+
+    private:
+        /** @brief The minimal ring capacity */
+        static const constexpr int MinCapacity = 2;
+
+        /** @brief The time to sleep between two push tries, when the policy is Block */
+        static const constexpr unsigned long BlockRetryDelayInUs = 100;
+
+        /** @brief The size used to avoid false sharing between the producer and consumer indexes
+          */
+        static const constexpr std::size_t CacheLineSize = 64;
+
+    private:
+        /** @brief This is a ring slot */
+        struct Slot
+        {
+            /** @brief The slot sequence, it says if the slot is free to be written or to be
+                       read */
+            std::atomic<quint64> sequence{0};
+
+            /** @brief The frame stored */
+            QCanBusFrame frame{};
+        };
+
+    private:
+        quint64 _mask;
+        CanRingOverflowPolicy::Enum _overflowPolicy;
+        std::unique_ptr<Slot[]> _slots;
+
+        alignas(CacheLineSize) std::atomic<quint64> _pushPos{0};
+        alignas(CacheLineSize) std::atomic<quint64> _popPos{0};
+
+        alignas(CacheLineSize) std::atomic_bool _notificationArmed{false};
+        std::atomic_bool _pushCancelled{false};
+
+        std::atomic<int> _highWaterMark{0};
+        std::atomic<quint64> _pushedFramesNb{0};
+        std::atomic<quint64> _droppedFramesNb{0};
+};
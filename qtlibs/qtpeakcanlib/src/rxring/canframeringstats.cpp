@@ -0,0 +1,31 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canframeringstats.hpp"
+
+#include <QString>
+
+
+CanFrameRingStats::CanFrameRingStats(int capacity,
+                                     int size,
+                                     int highWaterMark,
+                                     quint64 pushedFramesNb,
+                                     quint64 droppedFramesNb)
+    : _capacity{capacity},
+    _size{size},
+    _highWaterMark{highWaterMark},
+    _pushedFramesNb{pushedFramesNb},
+    _droppedFramesNb{droppedFramesNb}
+{
+}
+
+QString CanFrameRingStats::toString() const
+{
+    return QString("size: %1/%2, high water mark: %3, pushed: %4, dropped: %5")
+        .arg(_size)
+        .arg(_capacity)
+        .arg(_highWaterMark)
+        .arg(_pushedFramesNb)
+        .arg(_droppedFramesNb);
+}
@@ -0,0 +1,56 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This is a snapshot of the statistics of a @ref CanFrameRing
+    @note Those values are useful to size the ring capacity from real data */
+class CAN_EXPORT CanFrameRingStats
+{
+    public:
+        /** @brief Class constructor
+            @param capacity The ring capacity
+            @param size The number of frames waiting in the ring
+            @param highWaterMark The max number of frames which has been waiting in the ring
+            @param pushedFramesNb The number of frames successfully pushed in the ring
+            @param droppedFramesNb The number of frames dropped because the ring was full */
+        explicit CanFrameRingStats(int capacity = 0,
+                                   int size = 0,
+                                   int highWaterMark = 0,
+                                   quint64 pushedFramesNb = 0,
+                                   quint64 droppedFramesNb = 0);
+
+    public:
+        /** @brief Get the ring capacity */
+        int getCapacity() const { return _capacity; }
+
+        /** @brief Get the number of frames waiting in the ring, when the snapshot was taken */
+        int getSize() const { return _size; }
+
+        /** @brief Get the max number of frames which has been waiting in the ring */
+        int getHighWaterMark() const { return _highWaterMark; }
+
+        /** @brief Get the number of frames successfully pushed in the ring */
+        quint64 getPushedFramesNb() const { return _pushedFramesNb; }
+
+        /** @brief Get the number of frames dropped because the ring was full
+            @note Depending of the overflow policy, the dropped frames are the oldest or the
+                  newest */
+        quint64 getDroppedFramesNb() const { return _droppedFramesNb; }
+
+        /** @brief Get a string representation of the stats, useful for logs */
+        QString toString() const;
+
+    private:
+        int _capacity;
+        int _size;
+        int _highWaterMark;
+        quint64 _pushedFramesNb;
+        quint64 _droppedFramesNb;
+};
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canringoverflowpolicy.hpp"
+
+#include <QMetaEnum>
+
+
+QString CanRingOverflowPolicy::toString(Enum value)
+{
+    return QString::fromLatin1(QMetaEnum::fromType<Enum>().valueToKey(value)).toLower();
+}
+
+CanRingOverflowPolicy::Enum CanRingOverflowPolicy::parseFromString(const QString &value)
+{
+    QMetaEnum metaEnum = QMetaEnum::fromType<Enum>();
+
+    for(int idx = 0; idx < metaEnum.keyCount(); idx++)
+    {
+        QString strValue(metaEnum.key(idx));
+
+        if(strValue.toLower() == value.toLower())
+        {
+            return static_cast<Enum>(metaEnum.value(idx));
+        }
+    }
+
+    return Unknown;
+}
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "src/definescan.hpp"
+
+
+/** @brief Describes what a @ref CanFrameRing does when a frame is pushed and the ring is full */
+class CAN_EXPORT CanRingOverflowPolicy : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The overflow policies */
+        enum Enum {
+            DropOldest, //!< @brief The oldest frame not yet consumed is dropped to make room
+            DropNewest, //!< @brief The frame pushed is dropped, the ring content is kept
+            Block,      //!< @brief The producer waits until the consumer frees a place
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+
+        /** @brief Parse the enum from its string representation
+            @param value The string to parse
+            @return The enum parsed, this returns Unknown if no match has been found */
+        static Enum parseFromString(const QString &value);
+};
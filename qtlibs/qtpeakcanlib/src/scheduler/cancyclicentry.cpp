@@ -0,0 +1,18 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancyclicentry.hpp"
+
+
+CanCyclicEntry::CanCyclicEntry(const QCanBusFrame &frame, int periodInUs, int startOffsetInUs)
+    : _frame{frame},
+    _periodInUs{periodInUs},
+    _startOffsetInUs{startOffsetInUs}
+{
+}
+
+bool CanCyclicEntry::isValid() const
+{
+    return _frame.isValid() && (_periodInUs > 0) && (_startOffsetInUs >= 0);
+}
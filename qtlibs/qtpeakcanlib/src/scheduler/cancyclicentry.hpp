@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QCanBusFrame>
+
+#include <functional>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This describes a frame periodically sent by the @ref CanCyclicSchedulerThread */
+class CAN_EXPORT CanCyclicEntry
+{
+    public:
+        /** @brief The callback called just before sending the frame, to update the payload
+                   (counters, checksums, etc.)
+            @note The callback is called in the scheduler timing thread, it has to be short and
+                  thread safe
+            @param cycleNb The number of the current cycle, it starts at 0
+            @param payload The payload to send, it can be modified */
+        using PreSendCallback = std::function<void (quint64 cycleNb, QByteArray &payload)>;
+
+    public:
+        /** @brief Class constructor
+            @param frame The frame to send periodically
+            @param periodInUs The sending period
+            @param startOffsetInUs The delay before the first sending, useful to spread the
+                                   entries with the same period */
+        explicit CanCyclicEntry(const QCanBusFrame &frame = QCanBusFrame(),
+                                int periodInUs = 0,
+                                int startOffsetInUs = 0);
+
+    public:
+        /** @brief Get the frame to send periodically */
+        const QCanBusFrame &getFrame() const { return _frame; }
+
+        /** @brief Access the frame to send periodically */
+        QCanBusFrame &accessFrame() { return _frame; }
+
+        /** @brief Get the sending period */
+        int getPeriodInUs() const { return _periodInUs; }
+
+        /** @brief Get the delay before the first sending */
+        int getStartOffsetInUs() const { return _startOffsetInUs; }
+
+        /** @brief Get the callback called just before sending the frame */
+        const PreSendCallback &getPreSendCallback() const { return _preSendCallback; }
+
+        /** @brief Set the callback called just before sending the frame
+            @param preSendCallback The callback to set, it may be empty */
+        void setPreSendCallback(const PreSendCallback &preSendCallback)
+        { _preSendCallback = preSendCallback; }
+
+        /** @brief Test if the entry is valid
+            @return True if the entry is valid */
+        bool isValid() const;
+
+    private:
+        QCanBusFrame _frame;
+        int _periodInUs;
+        int _startOffsetInUs;
+        PreSendCallback _preSendCallback{nullptr};
+};
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancyclicentrystats.hpp"
+
+#include <QString>
+
+
+CanCyclicEntryStats::CanCyclicEntryStats(quint64 sentFramesNb,
+                                         quint64 missedCyclesNb,
+                                         quint64 failedWritesNb,
+                                         qint64 minJitterInUs,
+                                         qint64 maxJitterInUs,
+                                         qint64 meanJitterInUs)
+    : _sentFramesNb{sentFramesNb},
+    _missedCyclesNb{missedCyclesNb},
+    _failedWritesNb{failedWritesNb},
+    _minJitterInUs{minJitterInUs},
+    _maxJitterInUs{maxJitterInUs},
+    _meanJitterInUs{meanJitterInUs}
+{
+}
+
+QString CanCyclicEntryStats::toString() const
+{
+    return QString("sent: %1, missed cycles: %2, failed writes: %3, jitter (us) min: %4, "
+                   "max: %5, mean: %6")
+        .arg(_sentFramesNb)
+        .arg(_missedCyclesNb)
+        .arg(_failedWritesNb)
+        .arg(_minJitterInUs)
+        .arg(_maxJitterInUs)
+        .arg(_meanJitterInUs);
+}
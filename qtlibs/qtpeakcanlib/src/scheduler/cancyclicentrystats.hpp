@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This is a snapshot of the statistics of a cyclic entry
+    @note The jitter is the gap between the deadline of a cycle and the real writing of the
+          frame */
+class CAN_EXPORT CanCyclicEntryStats
+{
+    public:
+        /** @brief Class constructor
+            @param sentFramesNb The number of frames written
+            @param missedCyclesNb The number of cycles skipped because the scheduler was late
+            @param failedWritesNb The number of frames which couldn't be written
+            @param minJitterInUs The min jitter
+            @param maxJitterInUs The max jitter
+            @param meanJitterInUs The mean jitter */
+        explicit CanCyclicEntryStats(quint64 sentFramesNb = 0,
+                                     quint64 missedCyclesNb = 0,
+                                     quint64 failedWritesNb = 0,
+                                     qint64 minJitterInUs = 0,
+                                     qint64 maxJitterInUs = 0,
+                                     qint64 meanJitterInUs = 0);
+
+    public:
+        /** @brief Get the number of frames written */
+        quint64 getSentFramesNb() const { return _sentFramesNb; }
+
+        /** @brief Get the number of cycles skipped because the scheduler was late */
+        quint64 getMissedCyclesNb() const { return _missedCyclesNb; }
+
+        /** @brief Get the number of frames which couldn't be written */
+        quint64 getFailedWritesNb() const { return _failedWritesNb; }
+
+        /** @brief Get the min jitter */
+        qint64 getMinJitterInUs() const { return _minJitterInUs; }
+
+        /** @brief Get the max jitter */
+        qint64 getMaxJitterInUs() const { return _maxJitterInUs; }
+
+        /** @brief Get the mean jitter */
+        qint64 getMeanJitterInUs() const { return _meanJitterInUs; }
+
+        /** @brief Get a string representation of the stats, useful for logs */
+        QString toString() const;
+
+    private:
+        quint64 _sentFramesNb;
+        quint64 _missedCyclesNb;
+        quint64 _failedWritesNb;
+        qint64 _minJitterInUs;
+        qint64 _maxJitterInUs;
+        qint64 _meanJitterInUs;
+};
@@ -0,0 +1,308 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancyclicscheduler.hpp"
+
+#include <QDebug>
+#include <QThread>
+
+#include "src/canlibconstants.hpp"
+#include "src/pcanapi/pcanapi.hpp"
+
+
+CanCyclicScheduler::CanCyclicScheduler(PCanBusItf::Enum canBusItf, bool isCanFd, QObject *parent)
+    : QObject{parent},
+    _canBusItf{canBusItf},
+    _isCanFd{isCanFd},
+    _processMutex{new QMutex()}
+{
+    _clock.start();
+}
+
+CanCyclicScheduler::~CanCyclicScheduler()
+{
+    waitForProcessEnd();
+
+    delete _processMutex;
+    _processMutex = nullptr;
+}
+
+int CanCyclicScheduler::addEntry(const CanCyclicEntry &entry)
+{
+    if(!entry.isValid())
+    {
+        qWarning() << "The cyclic entry isn't valid, we can't add it to the scheduler of the CAN "
+                   << "bus: " << PCanBusItf::toString(_canBusItf);
+        return -1;
+    }
+
+    if(entry.getFrame().hasFlexibleDataRateFormat() && !_isCanFd)
+    {
+        qWarning() << "The cyclic entry frame: " << entry.getFrame().toString() << ", is a CAN FD "
+                   << "frame but the CAN bus: " << PCanBusItf::toString(_canBusItf) << ", isn't a "
+                   << "CAN FD one";
+        return -1;
+    }
+
+    QMutexLocker locker(&_entriesMutex);
+
+    const int entryId = _nextEntryId++;
+
+    ScheduledEntry scheduledEntry;
+    scheduledEntry.entry = entry;
+    _entries.insert(entryId, scheduledEntry);
+
+    Deadline deadline;
+    deadline.timeInNs = _clock.nsecsElapsed() +
+                        (entry.getStartOffsetInUs() * CanLibConstants::Time::MicroToNanoCoeff);
+    deadline.entryId = entryId;
+    _deadlines.push(deadline);
+
+    // The new deadline may be earlier than the one the scheduler is sleeping for
+    _entriesChanged.wakeAll();
+
+    return entryId;
+}
+
+bool CanCyclicScheduler::removeEntry(int entryId)
+{
+    QMutexLocker locker(&_entriesMutex);
+
+    if(_entries.remove(entryId) == 0)
+    {
+        qWarning() << "The cyclic entry: " << entryId << ", is unknown, we can't remove it";
+        return false;
+    }
+
+    // The deadlines of the removed entry are dropped when they reach the top of the heap
+    return true;
+}
+
+bool CanCyclicScheduler::updatePayload(int entryId, const QByteArray &payload)
+{
+    QMutexLocker locker(&_entriesMutex);
+
+    auto iter = _entries.find(entryId);
+    if(iter == _entries.end())
+    {
+        qWarning() << "The cyclic entry: " << entryId << ", is unknown, we can't update its "
+                   << "payload";
+        return false;
+    }
+
+    iter->entry.accessFrame().setPayload(payload);
+    return true;
+}
+
+bool CanCyclicScheduler::getEntryStats(int entryId, CanCyclicEntryStats &stats)
+{
+    QMutexLocker locker(&_entriesMutex);
+
+    auto citer = _entries.constFind(entryId);
+    if(citer == _entries.cend())
+    {
+        qWarning() << "The cyclic entry: " << entryId << ", is unknown, we can't get its stats";
+        return false;
+    }
+
+    const qint64 meanJitterInNs = (citer->sentFramesNb == 0) ?
+                                      0 :
+                                      (citer->jitterSumInNs /
+                                       static_cast<qint64>(citer->sentFramesNb));
+
+    stats = CanCyclicEntryStats(citer->sentFramesNb,
+                                citer->missedCyclesNb,
+                                citer->failedWritesNb,
+                                citer->minJitterInNs / CanLibConstants::Time::MicroToNanoCoeff,
+                                citer->maxJitterInNs / CanLibConstants::Time::MicroToNanoCoeff,
+                                meanJitterInNs / CanLibConstants::Time::MicroToNanoCoeff);
+    return true;
+}
+
+void CanCyclicScheduler::resetEntriesStats()
+{
+    QMutexLocker locker(&_entriesMutex);
+
+    for(auto iter = _entries.begin(); iter != _entries.end(); ++iter)
+    {
+        iter->sentFramesNb = 0;
+        iter->missedCyclesNb = 0;
+        iter->failedWritesNb = 0;
+        iter->minJitterInNs = 0;
+        iter->maxJitterInNs = 0;
+        iter->jitterSumInNs = 0;
+    }
+}
+
+bool CanCyclicScheduler::waitForProcessEnd(int timeoutInMs)
+{
+    if(_processMutex == nullptr)
+    {
+        return true;
+    }
+
+    if(!_processMutex->tryLock(timeoutInMs))
+    {
+        qWarning() << "The CAN cyclic scheduling is still in progress and the timeout has raised, "
+                   << "we abandon the waiting";
+        return false;
+    }
+
+    _processMutex->unlock();
+    return true;
+}
+
+void CanCyclicScheduler::cancelSchedule()
+{
+    _cancel = true;
+    _entriesChanged.wakeAll();
+}
+
+void CanCyclicScheduler::runSchedule()
+{
+    if(_processMutex == nullptr || !_processMutex->tryLock())
+    {
+        qWarning() << "The CAN cyclic scheduling is already running or the object is destroyed";
+        return;
+    }
+
+    _entriesMutex.lock();
+
+    while(!_cancel)
+    {
+        // The deadlines of the removed entries are dropped
+        while(!_deadlines.empty() && !_entries.contains(_deadlines.top().entryId))
+        {
+            _deadlines.pop();
+        }
+
+        if(_deadlines.empty())
+        {
+            _entriesChanged.wait(&_entriesMutex, MaxSleepDurationInMs);
+            continue;
+        }
+
+        const Deadline deadline = _deadlines.top();
+        const qint64 remainingInNs = deadline.timeInNs - _clock.nsecsElapsed();
+
+        if(remainingInNs > ActiveWaitThresholdInNs)
+        {
+            const qint64 sleepInMs = qBound(static_cast<qint64>(1),
+                                            (remainingInNs - ActiveWaitThresholdInNs) /
+                                                CanLibConstants::Time::MilliToNanoCoeff,
+                                            static_cast<qint64>(MaxSleepDurationInMs));
+
+            // If an entry is added while sleeping, we are woken up and we check the heap again
+            _entriesChanged.wait(&_entriesMutex, static_cast<unsigned long>(sleepInMs));
+            continue;
+        }
+
+        _deadlines.pop();
+        processDeadline(deadline);
+    }
+
+    _entriesMutex.unlock();
+    _processMutex->unlock();
+}
+
+void CanCyclicScheduler::processDeadline(const Deadline &deadline)
+{
+    const ScheduledEntry &scheduledEntry = _entries[deadline.entryId];
+
+    // The entry may be modified while waiting, we work on copies
+    QCanBusFrame frame = scheduledEntry.entry.getFrame();
+    const CanCyclicEntry::PreSendCallback callback = scheduledEntry.entry.getPreSendCallback();
+    const quint64 cycleNb = scheduledEntry.cycleNb;
+    const qint64 periodInNs = scheduledEntry.entry.getPeriodInUs() *
+                              CanLibConstants::Time::MicroToNanoCoeff;
+
+    _entriesMutex.unlock();
+
+    if(!activeWaitUntil(deadline.timeInNs))
+    {
+        _entriesMutex.lock();
+        return;
+    }
+
+    if(callback)
+    {
+        QByteArray payload = frame.payload();
+        callback(cycleNb, payload);
+        frame.setPayload(payload);
+    }
+
+    const qint64 jitterInNs = _clock.nsecsElapsed() - deadline.timeInNs;
+
+    bool txQueueFull = false;
+    const bool success = _isCanFd ?
+                             PCanApi::writeCanFdMsgProcess(_canBusItf, frame, &txQueueFull) :
+                             PCanApi::writeCanMsgProcess(_canBusItf, frame, &txQueueFull);
+
+    _entriesMutex.lock();
+
+    auto iter = _entries.find(deadline.entryId);
+    if(iter == _entries.end())
+    {
+        // The entry has been removed while writing
+        return;
+    }
+
+    if(success)
+    {
+        if(iter->sentFramesNb == 0)
+        {
+            iter->minJitterInNs = jitterInNs;
+            iter->maxJitterInNs = jitterInNs;
+        }
+        else
+        {
+            iter->minJitterInNs = qMin(iter->minJitterInNs, jitterInNs);
+            iter->maxJitterInNs = qMax(iter->maxJitterInNs, jitterInNs);
+        }
+
+        iter->jitterSumInNs += jitterInNs;
+        ++iter->sentFramesNb;
+    }
+    else
+    {
+        ++iter->failedWritesNb;
+    }
+
+    // The next deadline is computed from the current one, and not from the current time, to not
+    // drift
+    qint64 nextTimeInNs = deadline.timeInNs + periodInNs;
+    quint64 nextCycleNb = cycleNb + 1;
+
+    const qint64 nowInNs = _clock.nsecsElapsed();
+    if(nextTimeInNs <= nowInNs)
+    {
+        // We are late, the cycles already passed are skipped
+        const qint64 missedCyclesNb = (nowInNs - deadline.timeInNs) / periodInNs;
+        iter->missedCyclesNb += static_cast<quint64>(missedCyclesNb);
+        nextTimeInNs = deadline.timeInNs + ((missedCyclesNb + 1) * periodInNs);
+        nextCycleNb += static_cast<quint64>(missedCyclesNb);
+    }
+
+    iter->cycleNb = nextCycleNb;
+
+    Deadline nextDeadline;
+    nextDeadline.timeInNs = nextTimeInNs;
+    nextDeadline.entryId = deadline.entryId;
+    _deadlines.push(nextDeadline);
+}
+
+bool CanCyclicScheduler::activeWaitUntil(qint64 targetTimeInNs)
+{
+    while(_clock.nsecsElapsed() < targetTimeInNs)
+    {
+        if(_cancel)
+        {
+            return false;
+        }
+
+        QThread::yieldCurrentThread();
+    }
+
+    return true;
+}
@@ -0,0 +1,177 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <atomic>
+#include <functional>
+#include <queue>
+#include <vector>
+
+#include <QElapsedTimer>
+#include <QHash>
+#include <QMutex>
+#include <QWaitCondition>
+
+#include "src/pcanapi/pcanbusitf.hpp"
+#include "src/scheduler/cancyclicentry.hpp"
+#include "src/scheduler/cancyclicentrystats.hpp"
+
+
+/** @brief This class periodically writes the cyclic entries on a CAN bus interface
+    @note The scheduling process is blocking, the object has to live in a dedicated thread, see
+          @ref CanCyclicSchedulerThread
+    @note The next deadlines are kept in a min-heap. Each deadline is computed from the previous
+          one (and not from the writing time), therefore the schedule doesn't drift.
+    @note The scheduler sleeps until the next deadline is close, then it actively waits for it. The
+          sleep is interrupted when an entry is added.
+    @note The entries methods are thread safe and can be called while the schedule is running.
+    @note The frames are written with the PEAK CAN lib, as @ref CanDevice::write does; the lib is
+          thread safe and this avoids to go through the device thread for each frame. */
+class CanCyclicScheduler : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief An entry with its scheduling state and its stats */
+        struct ScheduledEntry
+        {
+            /** @brief The entry information */
+            CanCyclicEntry entry{};
+
+            /** @brief The number of the next cycle */
+            quint64 cycleNb{0};
+
+            /** @brief The number of frames written */
+            quint64 sentFramesNb{0};
+
+            /** @brief The number of cycles skipped because the scheduler was late */
+            quint64 missedCyclesNb{0};
+
+            /** @brief The number of frames which couldn't be written */
+            quint64 failedWritesNb{0};
+
+            /** @brief The min jitter, in ns */
+            qint64 minJitterInNs{0};
+
+            /** @brief The max jitter, in ns */
+            qint64 maxJitterInNs{0};
+
+            /** @brief The sum of all the jitters, in ns; it's used to compute the mean */
+            qint64 jitterSumInNs{0};
+        };
+
+        /** @brief A deadline of the heap */
+        struct Deadline
+        {
+            /** @brief The deadline, relatively to the scheduler clock */
+            qint64 timeInNs{0};
+
+            /** @brief The id of the entry to write at this deadline */
+            int entryId{0};
+
+            /** @brief Compare the deadlines, used by the min-heap */
+            bool operator>(const Deadline &other) const { return timeInNs > other.timeInNs; }
+        };
+
+    public:
+        /** @brief Class constructor
+            @param canBusItf The CAN bus interface where the frames are written
+            @param isCanFd True if the CAN bus interface has been initialized for CAN FD
+            @param parent The class parent */
+        explicit CanCyclicScheduler(PCanBusItf::Enum canBusItf,
+                                    bool isCanFd,
+                                    QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanCyclicScheduler() override;
+
+    public:
+        /** @brief Add a cyclic entry
+            @note The method is thread safe
+            @param entry The entry to add
+            @return The id of the entry added, or -1 if a problem occurred */
+        int addEntry(const CanCyclicEntry &entry);
+
+        /** @brief Remove a cyclic entry
+            @note The method is thread safe
+            @param entryId The id of the entry to remove
+            @return True if no problem occurred */
+        bool removeEntry(int entryId);
+
+        /** @brief Replace the payload of a cyclic entry
+            @note The method is thread safe; the payload is replaced atomically, a frame is never
+                  written with a partially updated payload
+            @param entryId The id of the entry to update
+            @param payload The new payload
+            @return True if no problem occurred */
+        bool updatePayload(int entryId, const QByteArray &payload);
+
+        /** @brief Get the statistics of a cyclic entry
+            @note The method is thread safe
+            @param entryId The id of the entry
+            @param stats The stats got
+            @return True if no problem occurred */
+        bool getEntryStats(int entryId, CanCyclicEntryStats &stats);
+
+        /** @brief Reset the statistics of all the entries
+            @note The method is thread safe */
+        void resetEntriesStats();
+
+        /** @brief Wait for the scheduling process end
+            @param timeoutInMs The waiting timeout
+            @return True if the process is ended, false if the timeout raised before the end of
+                    process */
+        bool waitForProcessEnd(int timeoutInMs = -1);
+
+        /** @brief This cancels the scheduling process
+            @note This can be called from any thread */
+        void cancelSchedule();
+
+    public slots:
+        /** @brief This method starts the scheduling process, it returns when the process is
+                   cancelled */
+        void runSchedule();
+
+    private:
+        /** @brief Write the frame of an entry, and update the entry stats and deadline
+            @note The entries mutex has to be locked when calling this method, it's unlocked while
+                  waiting for the deadline and writing the frame, and locked again before
+                  returning
+            @param deadline The deadline reached */
+        void processDeadline(const Deadline &deadline);
+
+        /** @brief Actively wait until the scheduler clock reaches the time given
+            @param targetTimeInNs The time to reach
+            @return True if the time has been reached, false if the process has been cancelled */
+        bool activeWaitUntil(qint64 targetTimeInNs);
+
+    private:
+        /** @brief Under this remaining time, the scheduler actively waits for the next deadline
+            @note On Windows, the sleep resolution is around 15.6 ms */
+#ifdef Q_OS_WIN
+        static const constexpr qint64 ActiveWaitThresholdInNs = 16000000;
+#else
+        static const constexpr qint64 ActiveWaitThresholdInNs = 2000000;
+#endif
+
+        /** @brief The max duration of a sleep, to stay responsive to cancellation */
+        static const constexpr int MaxSleepDurationInMs = 50;
+
+    private:
+        PCanBusItf::Enum _canBusItf;
+        bool _isCanFd;
+
+        std::atomic_bool _cancel{false};
+        QMutex *_processMutex{nullptr};
+
+        QElapsedTimer _clock;
+        QMutex _entriesMutex;
+        QWaitCondition _entriesChanged;
+        QHash<int, ScheduledEntry> _entries;
+        std::priority_queue<Deadline, std::vector<Deadline>, std::greater<Deadline>> _deadlines;
+        int _nextEntryId{1};
+};
@@ -0,0 +1,118 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cancyclicschedulerthread.hpp"
+
+#include <QDebug>
+#include <QTimer>
+
+#include "src/candevice/candeviceintf.hpp"
+#include "src/scheduler/cancyclicscheduler.hpp"
+
+
+CanCyclicSchedulerThread::CanCyclicSchedulerThread(PCanBusItf::Enum canBusItf,
+                                                   bool isCanFd,
+                                                   QObject *parent)
+    : BaseThread{parent},
+    _scheduler{new CanCyclicScheduler(canBusItf, isCanFd)}
+{
+    // The scheduler is created here to be able to add entries before starting the thread
+    _scheduler->moveToThread(this);
+}
+
+CanCyclicSchedulerThread::CanCyclicSchedulerThread(const CanDeviceIntf &canDeviceIntf,
+                                                   QObject *parent)
+    : CanCyclicSchedulerThread{canDeviceIntf.getCanIntfKey(),
+                               canDeviceIntf.getConfig().isCanFd(),
+                               parent}
+{
+}
+
+CanCyclicSchedulerThread::~CanCyclicSchedulerThread()
+{
+    // If the thread has never been started, the scheduler hasn't been deleted
+    delete _scheduler;
+}
+
+int CanCyclicSchedulerThread::addEntry(const CanCyclicEntry &entry)
+{
+    if(_scheduler == nullptr)
+    {
+        qWarning() << "The CAN cyclic scheduler thread is stopped, we can't add an entry";
+        return -1;
+    }
+
+    return _scheduler->addEntry(entry);
+}
+
+bool CanCyclicSchedulerThread::removeEntry(int entryId)
+{
+    if(_scheduler == nullptr)
+    {
+        qWarning() << "The CAN cyclic scheduler thread is stopped, we can't remove an entry";
+        return false;
+    }
+
+    return _scheduler->removeEntry(entryId);
+}
+
+bool CanCyclicSchedulerThread::updatePayload(int entryId, const QByteArray &payload)
+{
+    if(_scheduler == nullptr)
+    {
+        qWarning() << "The CAN cyclic scheduler thread is stopped, we can't update an entry";
+        return false;
+    }
+
+    return _scheduler->updatePayload(entryId, payload);
+}
+
+bool CanCyclicSchedulerThread::getEntryStats(int entryId, CanCyclicEntryStats &stats)
+{
+    if(_scheduler == nullptr)
+    {
+        qWarning() << "The CAN cyclic scheduler thread is stopped, we can't get the entry stats";
+        return false;
+    }
+
+    return _scheduler->getEntryStats(entryId, stats);
+}
+
+void CanCyclicSchedulerThread::resetEntriesStats()
+{
+    if(_scheduler != nullptr)
+    {
+        _scheduler->resetEntriesStats();
+    }
+}
+
+bool CanCyclicSchedulerThread::stopThread()
+{
+    if(_scheduler != nullptr)
+    {
+        _scheduler->cancelSchedule();
+        _scheduler->waitForProcessEnd();
+
+        if(isRunning())
+        {
+            QTimer::singleShot(0, _scheduler, &CanCyclicScheduler::deleteLater);
+        }
+        else
+        {
+            delete _scheduler;
+        }
+
+        _scheduler = nullptr;
+    }
+
+    return BaseThread::stopThread();
+}
+
+void CanCyclicSchedulerThread::run()
+{
+    connect(this,       &CanCyclicSchedulerThread::ready,
+            _scheduler, &CanCyclicScheduler::runSchedule, Qt::QueuedConnection);
+
+    BaseThread::run();
+}
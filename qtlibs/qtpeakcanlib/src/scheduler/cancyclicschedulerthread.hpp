@@ -0,0 +1,90 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+#include <QObject>
+
+#include "src/definescan.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+#include "src/scheduler/cancyclicentry.hpp"
+#include "src/scheduler/cancyclicentrystats.hpp"
+
+class CanCyclicScheduler;
+class CanDeviceIntf;
+
+
+/** @brief This is the timing thread which periodically writes frames on a CAN bus interface
+    @note The schedule starts as soon as the thread is ready; therefore, you only have to call
+          @ref startThreadAndWaitToBeReady to start it. The entries can be added before or after
+          the start.
+    @note The scheduler has its own thread because the process is blocking, to respect the
+          deadlines accurately
+    @note The calls of the entries methods are thread safe and don't wait for the timing thread */
+class CAN_EXPORT CanCyclicSchedulerThread : public BaseThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param canBusItf The CAN bus interface where the frames are written
+            @param isCanFd True if the CAN bus interface has been initialized for CAN FD
+            @param parent The class parent */
+        explicit CanCyclicSchedulerThread(PCanBusItf::Enum canBusItf,
+                                          bool isCanFd,
+                                          QObject *parent = nullptr);
+
+        /** @brief Class constructor
+            @note The CAN device has to be initialized before starting the thread
+            @param canDeviceIntf The CAN device where the frames are written
+            @param parent The class parent */
+        explicit CanCyclicSchedulerThread(const CanDeviceIntf &canDeviceIntf,
+                                          QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanCyclicSchedulerThread() override;
+
+    public:
+        /** @brief Add a cyclic entry
+            @param entry The entry to add
+            @return The id of the entry added, or -1 if a problem occurred */
+        int addEntry(const CanCyclicEntry &entry);
+
+        /** @brief Remove a cyclic entry
+            @param entryId The id of the entry to remove
+            @return True if no problem occurred */
+        bool removeEntry(int entryId);
+
+        /** @brief Replace the payload of a cyclic entry
+            @note The payload is replaced atomically, a frame is never written with a partially
+                  updated payload
+            @param entryId The id of the entry to update
+            @param payload The new payload
+            @return True if no problem occurred */
+        bool updatePayload(int entryId, const QByteArray &payload);
+
+        /** @brief Get the statistics of a cyclic entry
+            @param entryId The id of the entry
+            @param stats The stats got
+            @return True if no problem occurred */
+        bool getEntryStats(int entryId, CanCyclicEntryStats &stats);
+
+        /** @brief Reset the statistics of all the entries */
+        void resetEntriesStats();
+
+    public slots:
+        /** @brief Call to stop the thread
+            @note The schedule is cancelled
+            @return True if no problem occurs */
+        virtual bool stopThread() override;
+
+    protected:
+        /** @copydoc BaseThread::run */
+        virtual void run() override;
+
+    private:
+        CanCyclicScheduler *_scheduler{nullptr};
+};
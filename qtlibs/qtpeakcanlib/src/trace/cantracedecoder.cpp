@@ -0,0 +1,146 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cantracedecoder.hpp"
+
+#include <QByteArray>
+
+#include "src/canlibconstants.hpp"
+#include "src/models/canbusevent.hpp"
+#include "src/pcanapi/pcanapi.hpp"
+#include "src/trace/cantracer.hpp"
+
+#include "src/pcanapi/import_pcanbasic.hpp"
+
+
+CanTraceDecoder::CanTraceDecoder()
+{
+}
+
+QStringList CanTraceDecoder::decodeChannel(PCanBusItf::Enum channel)
+{
+    return decode(CanTracer::getSnapshot(channel));
+}
+
+QStringList CanTraceDecoder::decode(const QVector<CanTraceRing::Record> &records)
+{
+    QStringList lines;
+    if(records.isEmpty())
+    {
+        return lines;
+    }
+
+    lines.reserve(records.length());
+    const qint64 originTimeInNs = records.first().hostTimeInNs;
+
+    for(auto citer = records.cbegin(); citer != records.cend(); ++citer)
+    {
+        lines.append(decodeRecord(*citer, originTimeInNs));
+    }
+
+    return lines;
+}
+
+QString CanTraceDecoder::decodeRecord(const CanTraceRing::Record &record, qint64 originTimeInNs)
+{
+    const double timeInMs = static_cast<double>(record.hostTimeInNs - originTimeInNs) /
+                            static_cast<double>(CanLibConstants::Time::MilliToNanoCoeff);
+
+    QString line = QString::number(timeInMs, 'f', TimeDecimalsNb) + " " +
+                   kindToString(record.kind);
+
+    if(record.kind == CanTraceRing::Kind::BusEvent)
+    {
+        line += " " + CanBusEvent::toString(static_cast<CanBusEvent::Enum>(record.id));
+        return line;
+    }
+
+    const bool extended = ((record.msgType & PCAN_MESSAGE_EXTENDED) != 0);
+    line += " 0x" + QString::number(record.id, 16)
+                        .rightJustified(extended ? ExtendedIdDigitsNb : StandardIdDigitsNb, '0')
+                        .toUpper();
+
+    const QString flags = msgTypeToString(record.msgType);
+    if(!flags.isEmpty())
+    {
+        line += " " + flags;
+    }
+
+    line += QString(" [%1]").arg(record.length);
+
+    if(record.length > 0)
+    {
+        line += " " + QByteArray::fromRawData(reinterpret_cast<const char *>(record.data),
+                                              record.length).toHex(' ').toUpper();
+    }
+
+    if(record.kind == CanTraceRing::Kind::TxError)
+    {
+        line += ", error: " + PCanApi::getErrorText(record.status);
+    }
+
+    return line;
+}
+
+QString CanTraceDecoder::kindToString(CanTraceRing::Kind kind)
+{
+    switch(kind)
+    {
+        case CanTraceRing::Kind::RxFrame:
+            return QStringLiteral("RX");
+
+        case CanTraceRing::Kind::TxFrame:
+            return QStringLiteral("TX");
+
+        case CanTraceRing::Kind::TxError:
+            return QStringLiteral("TXERR");
+
+        case CanTraceRing::Kind::BusEvent:
+            return QStringLiteral("EVENT");
+    }
+
+    return QStringLiteral("UNKNOWN");
+}
+
+QString CanTraceDecoder::msgTypeToString(quint8 msgType)
+{
+    QStringList flags;
+
+    if(msgType & PCAN_MESSAGE_EXTENDED)
+    {
+        flags.append(QStringLiteral("EXT"));
+    }
+
+    if(msgType & PCAN_MESSAGE_RTR)
+    {
+        flags.append(QStringLiteral("RTR"));
+    }
+
+    if(msgType & PCAN_MESSAGE_FD)
+    {
+        flags.append(QStringLiteral("FD"));
+    }
+
+    if(msgType & PCAN_MESSAGE_BRS)
+    {
+        flags.append(QStringLiteral("BRS"));
+    }
+
+    if(msgType & PCAN_MESSAGE_ESI)
+    {
+        flags.append(QStringLiteral("ESI"));
+    }
+
+    if(msgType & PCAN_MESSAGE_ERRFRAME)
+    {
+        flags.append(QStringLiteral("ERRFRAME"));
+    }
+
+    if(msgType & PCAN_MESSAGE_STATUS)
+    {
+        flags.append(QStringLiteral("STATUS"));
+    }
+
+    return flags.join(' ');
+}
@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QStringList>
+#include <QVector>
+
+#include "src/definescan.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+#include "src/trace/cantracering.hpp"
+
+
+/** @brief This class renders the binary trace records in a readable text
+    @note The rendering is only done on demand, never while tracing. Each record is rendered in
+          one line: "<time in ms> <kind> <id> <flags> [<length>] <payload>"; the time is relative
+          to the first record rendered.
+    @note The class contains static methods to call */
+class CAN_EXPORT CanTraceDecoder
+{
+    private:
+        /** @brief Private class constructor */
+        explicit CanTraceDecoder();
+
+    public:
+        /** @brief Render the current records of the channel given
+            @param channel The channel to render the trace of
+            @return The rendered lines, empty if the channel has never been traced */
+        static QStringList decodeChannel(PCanBusItf::Enum channel);
+
+        /** @brief Render the records given
+            @param records The records to render, from the oldest to the newest
+            @return The rendered lines */
+        static QStringList decode(const QVector<CanTraceRing::Record> &records);
+
+        /** @brief Render a record
+            @param record The record to render
+            @param originTimeInNs The host time of the time origin, in ns
+            @return The rendered line */
+        static QString decodeRecord(const CanTraceRing::Record &record, qint64 originTimeInNs);
+
+    private:
+        /** @brief Get the string representation of the record kind */
+        static QString kindToString(CanTraceRing::Kind kind);
+
+        /** @brief Get the string representation of the message type flags */
+        static QString msgTypeToString(quint8 msgType);
+
+    private:
+        /** @brief The number of decimals written for the time in ms */
+        static const constexpr int TimeDecimalsNb = 3;
+
+        /** @brief The number of hexadecimal digits of a standard id */
+        static const constexpr int StandardIdDigitsNb = 3;
+
+        /** @brief The number of hexadecimal digits of an extended id */
+        static const constexpr int ExtendedIdDigitsNb = 8;
+};
@@ -0,0 +1,133 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cantracer.hpp"
+
+#include <chrono>
+#include <cstring>
+
+#include <QDebug>
+#include <QMutexLocker>
+
+
+std::array<std::atomic_bool, CanTracer::ChannelsNb> CanTracer::EnabledChannels = {};
+std::array<std::atomic<CanTraceRing*>, CanTracer::ChannelsNb> CanTracer::Rings = {};
+QMutex CanTracer::RingsMutex;
+
+
+CanTracer::CanTracer()
+{
+}
+
+bool CanTracer::enable(PCanBusItf::Enum channel, int capacity)
+{
+    if(channel == PCanBusItf::Unknown)
+    {
+        qWarning() << "The tracing of an unknown CAN channel can't be enabled";
+        return false;
+    }
+
+    {
+        QMutexLocker locker(&RingsMutex);
+
+        CanTraceRing *ring = Rings[channel].load(std::memory_order_relaxed);
+        if(ring == nullptr)
+        {
+            // The ring isn't deleted: a writer may still use it after the channel disabling
+            Rings[channel].store(new CanTraceRing(capacity), std::memory_order_release);
+        }
+        else if(ring->getCapacity() < capacity)
+        {
+            qInfo() << "The trace ring of the channel: " << PCanBusItf::toString(channel)
+                    << ", already exists, its capacity: " << ring->getCapacity() << ", is kept";
+        }
+    }
+
+    EnabledChannels[channel].store(true, std::memory_order_release);
+    return true;
+}
+
+void CanTracer::disable(PCanBusItf::Enum channel)
+{
+    if(channel == PCanBusItf::Unknown)
+    {
+        return;
+    }
+
+    EnabledChannels[channel].store(false, std::memory_order_relaxed);
+}
+
+QVector<CanTraceRing::Record> CanTracer::getSnapshot(PCanBusItf::Enum channel)
+{
+    const CanTraceRing *ring = getRing(channel);
+    if(ring == nullptr)
+    {
+        return {};
+    }
+
+    return ring->getSnapshot();
+}
+
+void CanTracer::clear(PCanBusItf::Enum channel)
+{
+    CanTraceRing *ring = getRing(channel);
+    if(ring == nullptr)
+    {
+        return;
+    }
+
+    ring->clear();
+}
+
+void CanTracer::traceFrame(PCanBusItf::Enum channel,
+                           CanTraceRing::Kind kind,
+                           quint32 id,
+                           quint8 msgType,
+                           const quint8 *data,
+                           int length,
+                           quint32 status)
+{
+    CanTraceRing *ring = getRing(channel);
+    if(ring == nullptr)
+    {
+        return;
+    }
+
+    CanTraceRing::Record record;
+    record.hostTimeInNs = getHostTimeInNs();
+    record.id = id;
+    record.status = status;
+    record.kind = kind;
+    record.msgType = msgType;
+    record.length = static_cast<quint8>(qBound(0, length, CanTraceRing::MaxPayloadSize));
+
+    if(data != nullptr)
+    {
+        memcpy(record.data, data, record.length);
+    }
+
+    ring->write(record);
+}
+
+void CanTracer::traceBusEvent(PCanBusItf::Enum channel, CanBusEvent::Enum event)
+{
+    CanTraceRing *ring = getRing(channel);
+    if(ring == nullptr)
+    {
+        return;
+    }
+
+    CanTraceRing::Record record;
+    record.hostTimeInNs = getHostTimeInNs();
+    record.id = static_cast<quint32>(event);
+    record.kind = CanTraceRing::Kind::BusEvent;
+
+    ring->write(record);
+}
+
+qint64 CanTracer::getHostTimeInNs()
+{
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                                    std::chrono::steady_clock::now().time_since_epoch()).count();
+}
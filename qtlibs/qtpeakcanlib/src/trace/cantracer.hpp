@@ -0,0 +1,143 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <array>
+#include <atomic>
+
+#include <QMutex>
+#include <QVector>
+
+#include "src/definescan.hpp"
+#include "src/models/canbusevent.hpp"
+#include "src/pcanapi/pcanbusitf.hpp"
+#include "src/trace/cantracering.hpp"
+
+/** @brief Trace a raw frame in the trace ring of a channel, if the tracing of the channel is
+           enabled
+    @note When the tracing is disabled, the arguments aren't evaluated: the only cost is a relaxed
+          atomic load
+    @note When QTPEAKCANLIB_NO_TRACE is defined, the macro is empty */
+#if defined(QTPEAKCANLIB_NO_TRACE)
+#   define CAN_TRACE_FRAME(channel, kind, id, msgType, data, length, status) do {} while(false)
+#else
+#   define CAN_TRACE_FRAME(channel, kind, id, msgType, data, length, status) \
+        do \
+        { \
+            if(Q_UNLIKELY(CanTracer::isEnabled(channel))) \
+            { \
+                CanTracer::traceFrame((channel), (kind), (id), (msgType), (data), (length), \
+                                      (status)); \
+            } \
+        } while(false)
+#endif
+
+/** @brief Trace a bus event in the trace ring of a channel, if the tracing of the channel is
+           enabled
+    @note When QTPEAKCANLIB_NO_TRACE is defined, the macro is empty */
+#if defined(QTPEAKCANLIB_NO_TRACE)
+#   define CAN_TRACE_BUS_EVENT(channel, event) do {} while(false)
+#else
+#   define CAN_TRACE_BUS_EVENT(channel, event) \
+        do \
+        { \
+            if(Q_UNLIKELY(CanTracer::isEnabled(channel))) \
+            { \
+                CanTracer::traceBusEvent((channel), (event)); \
+            } \
+        } while(false)
+#endif
+
+
+/** @brief This class manages the binary tracing of the CAN inputs and outputs, by channel
+    @note The frames read and written, the transmit errors and the bus events are stored as raw
+          records in a lock-free ring by channel, see @ref CanTraceRing. Nothing is formatted
+          while tracing: the rings are rendered on demand by the @ref CanTraceDecoder.
+    @note The tracing is disabled by default and enabled at runtime for each channel. A ring is
+          allocated the first time its channel is enabled and it's kept until the end of the
+          application; therefore, the records can be decoded after the tracing has been disabled.
+    @note The tracing points use the @ref CAN_TRACE_FRAME and @ref CAN_TRACE_BUS_EVENT macros.
+          If QTPEAKCANLIB_NO_TRACE is defined when building the lib, the tracing points are
+          removed and nothing is ever traced.
+    @note The class contains static methods to call */
+class CAN_EXPORT CanTracer
+{
+    private:
+        /** @brief Private class constructor */
+        explicit CanTracer();
+
+    public:
+        /** @brief Test if the tracing of the channel given is enabled
+            @note This is only a relaxed atomic load, it's called for each frame */
+        static bool isEnabled(PCanBusItf::Enum channel)
+        { return EnabledChannels[channel].load(std::memory_order_relaxed); }
+
+        /** @brief Enable the tracing of the channel given
+            @param channel The channel to trace
+            @param capacity The number of records kept for the channel; it's only used when the
+                            ring of the channel is created: the first time the channel is enabled
+            @return True if no problem occurred */
+        static bool enable(PCanBusItf::Enum channel,
+                           int capacity = CanTraceRing::DefaultCapacity);
+
+        /** @brief Disable the tracing of the channel given
+            @note The records already written are kept
+            @param channel The channel to stop tracing */
+        static void disable(PCanBusItf::Enum channel);
+
+        /** @brief Get a copy of the records of the channel given, from the oldest to the newest
+            @param channel The channel to get the records from
+            @return The records, empty if the channel has never been enabled */
+        static QVector<CanTraceRing::Record> getSnapshot(PCanBusItf::Enum channel);
+
+        /** @brief Forget the records of the channel given
+            @param channel The channel to clear */
+        static void clear(PCanBusItf::Enum channel);
+
+        /** @brief Write a frame record in the ring of the channel given
+            @note Prefer to use the @ref CAN_TRACE_FRAME macro, which tests if the channel is
+                  enabled
+            @param channel The channel where the frame has been read or written
+            @param kind The kind of the record
+            @param id The frame id
+            @param msgType The raw PCAN message type of the frame
+            @param data The frame payload
+            @param length The payload length in bytes, it's limited to
+                          @ref CanTraceRing::MaxPayloadSize
+            @param status The PCAN status of the write, for a transmit error */
+        static void traceFrame(PCanBusItf::Enum channel,
+                               CanTraceRing::Kind kind,
+                               quint32 id,
+                               quint8 msgType,
+                               const quint8 *data,
+                               int length,
+                               quint32 status);
+
+        /** @brief Write a bus event record in the ring of the channel given
+            @note Prefer to use the @ref CAN_TRACE_BUS_EVENT macro, which tests if the channel is
+                  enabled
+            @param channel The channel where the event occurred
+            @param event The bus event */
+        static void traceBusEvent(PCanBusItf::Enum channel, CanBusEvent::Enum event);
+
+    private:
+        /** @brief Get the ring of the channel given, or nullptr if the channel has never been
+                   enabled */
+        static CanTraceRing *getRing(PCanBusItf::Enum channel)
+        { return Rings[channel].load(std::memory_order_acquire); }
+
+        /** @brief Get the current time of the steady host clock, in ns */
+        static qint64 getHostTimeInNs();
+
+    private:
+        /** @brief The number of channels, the Unknown channel is included to not have to test
+                   the channel value in @ref isEnabled; it's never enabled */
+        static const constexpr int ChannelsNb = PCanBusItf::Unknown + 1;
+
+    private:
+        static std::array<std::atomic_bool, ChannelsNb> EnabledChannels;
+        static std::array<std::atomic<CanTraceRing*>, ChannelsNb> Rings;
+        static QMutex RingsMutex;
+};
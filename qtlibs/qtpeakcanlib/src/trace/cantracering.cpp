@@ -0,0 +1,75 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cantracering.hpp"
+
+
+CanTraceRing::CanTraceRing(int capacity)
+    : _mask{0}
+{
+    quint64 realCapacity = MinCapacity;
+    while(realCapacity < static_cast<quint64>(capacity))
+    {
+        realCapacity <<= 1;
+    }
+
+    _mask = realCapacity - 1;
+    _slots.reset(new Slot[realCapacity]);
+}
+
+void CanTraceRing::write(const Record &record)
+{
+    const quint64 position = _writePos.fetch_add(1, std::memory_order_relaxed);
+    Slot &slot = _slots[position & _mask];
+
+    slot.sequence.store((position * 2) + 1, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_release);
+
+    slot.record = record;
+
+    slot.sequence.store((position + 1) * 2, std::memory_order_release);
+}
+
+QVector<CanTraceRing::Record> CanTraceRing::getSnapshot() const
+{
+    const quint64 endPos = _writePos.load(std::memory_order_acquire);
+    const quint64 capacity = _mask + 1;
+    const quint64 clearPos = _clearPos.load(std::memory_order_relaxed);
+
+    quint64 startPos = (endPos > capacity) ? (endPos - capacity) : 0;
+    startPos = qMax(startPos, clearPos);
+
+    QVector<Record> records;
+    records.reserve(static_cast<int>(endPos - startPos));
+
+    for(quint64 position = startPos; position < endPos; ++position)
+    {
+        const Slot &slot = _slots[position & _mask];
+        const quint64 expectedSequence = (position + 1) * 2;
+
+        if(slot.sequence.load(std::memory_order_acquire) != expectedSequence)
+        {
+            // The record is being written or has already been overwritten
+            continue;
+        }
+
+        const Record record = slot.record;
+
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if(slot.sequence.load(std::memory_order_relaxed) != expectedSequence)
+        {
+            // The record has been overwritten while we were copying it
+            continue;
+        }
+
+        records.append(record);
+    }
+
+    return records;
+}
+
+void CanTraceRing::clear()
+{
+    _clearPos.store(_writePos.load(std::memory_order_relaxed), std::memory_order_relaxed);
+}
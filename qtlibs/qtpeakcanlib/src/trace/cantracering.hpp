@@ -0,0 +1,116 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <atomic>
+#include <memory>
+
+#include <QVector>
+
+
+/** @brief This is a lock-free ring of binary trace records, which overwrites the oldest records
+           when it's full
+    @note Several threads may write in the same ring (the read thread, the device thread, the
+          transmit queue, the gateways of other devices...): each writer claims a position and
+          fills the slot, without any lock.
+    @note The ring is read on demand with @ref getSnapshot; each slot is protected by a sequence
+          number and the records which are being overwritten while reading are skipped. */
+class CanTraceRing
+{
+    public:
+        /** @brief The max payload size of a CAN FD frame */
+        static const constexpr int MaxPayloadSize = 64;
+
+        /** @brief The default ring capacity */
+        static const constexpr int DefaultCapacity = 4096;
+
+    public:
+        /** @brief The kind of a trace record */
+        enum class Kind : quint8
+        {
+            RxFrame,
+            TxFrame,
+            TxError,
+            BusEvent
+        };
+
+        /** @brief This is a trace record, it's stored as is in the ring */
+        struct Record
+        {
+            /** @brief The time of the record, given by a steady host clock, in ns */
+            qint64 hostTimeInNs{0};
+
+            /** @brief The frame id, or the @ref CanBusEvent::Enum value for a bus event */
+            quint32 id{0};
+
+            /** @brief The PCAN status of the write, for a transmit error */
+            quint32 status{0};
+
+            /** @brief The kind of the record */
+            Kind kind{Kind::RxFrame};
+
+            /** @brief The raw PCAN message type of the frame */
+            quint8 msgType{0};
+
+            /** @brief The payload length in bytes */
+            quint8 length{0};
+
+            /** @brief The frame payload, only the @ref length first bytes are significant */
+            quint8 data[MaxPayloadSize]{};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param capacity The ring capacity, it's rounded up to the next power of two */
+        explicit CanTraceRing(int capacity = DefaultCapacity);
+
+    public:
+        /** @brief Get the ring capacity */
+        int getCapacity() const { return static_cast<int>(_mask + 1); }
+
+        /** @brief Get the number of records written since the ring creation (including the
+                   overwritten ones) */
+        quint64 getWrittenRecordsNb() const { return _writePos.load(std::memory_order_relaxed); }
+
+        /** @brief Write a record in the ring
+            @note This can be called from any thread
+            @param record The record to write */
+        void write(const Record &record);
+
+        /** @brief Get a copy of the records currently in the ring, from the oldest to the newest
+            @note This can be called from any thread, the writers aren't blocked
+            @return The records copied */
+        QVector<Record> getSnapshot() const;
+
+        /** @brief Forget all the records written until now
+            @note This can be called from any thread */
+        void clear();
+
+    private:
+        /** @brief The minimal ring capacity */
+        static const constexpr int MinCapacity = 2;
+
+        /** @brief The size used to avoid false sharing between the writers and the slots */
+        static const constexpr std::size_t CacheLineSize = 64;
+
+    private:
+        /** @brief This is a ring slot */
+        struct Slot
+        {
+            /** @brief The slot sequence: odd while the record of the position (sequence / 2) is
+                       written, even and equals to ((position + 1) * 2) when it's written */
+            std::atomic<quint64> sequence{0};
+
+            /** @brief The record stored */
+            Record record{};
+        };
+
+    private:
+        quint64 _mask;
+        std::unique_ptr<Slot[]> _slots;
+
+        alignas(CacheLineSize) std::atomic<quint64> _writePos{0};
+        std::atomic<quint64> _clearPos{0};
+};
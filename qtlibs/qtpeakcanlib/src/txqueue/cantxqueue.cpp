@@ -0,0 +1,195 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cantxqueue.hpp"
+
+#include <QDebug>
+#include <QTimer>
+
+#include "src/canlibconstants.hpp"
+#include "src/metrics/canbusmetrics.hpp"
+#include "src/pcanapi/pcanapi.hpp"
+
+
+CanTxQueue::CanTxQueue(PCanBusItf::Enum canBusItf,
+                       bool isCanFd,
+                       const CanTxQueueConfig &config,
+                       const QSharedPointer<CanBusMetrics> &metrics,
+                       QObject *parent)
+    : QObject{parent},
+    _canBusItf{canBusItf},
+    _isCanFd{isCanFd},
+    _config{config},
+    _metrics{metrics},
+    _timer{new QTimer(this)}
+{
+    _timer->setSingleShot(true);
+    _timer->setTimerType(Qt::PreciseTimer);
+    connect(_timer, &QTimer::timeout, this, &CanTxQueue::processQueue);
+
+    _clock.start();
+}
+
+CanTxQueue::~CanTxQueue()
+{
+}
+
+void CanTxQueue::enqueue(const QVector<QCanBusFrame> &frames, quint64 batchId)
+{
+    Batch batch;
+    batch.id = batchId;
+    batch.frames = frames;
+
+    _batches.enqueue(batch);
+    _pendingFramesNb += frames.size();
+
+    if(!_timer->isActive())
+    {
+        // If the timer is active, the queue is already being processed
+        processQueue();
+    }
+}
+
+void CanTxQueue::clear()
+{
+    _timer->stop();
+
+    while(!_batches.isEmpty())
+    {
+        finishFirstBatch(false);
+    }
+}
+
+void CanTxQueue::processQueue()
+{
+    int writtenFramesNb = 0;
+
+    while(!_batches.isEmpty())
+    {
+        Batch &batch = _batches.head();
+
+        if(batch.nextFrameIdx >= batch.frames.size())
+        {
+            finishFirstBatch(true);
+            continue;
+        }
+
+        if(writtenFramesNb >= MaxFramesNbByBurst)
+        {
+            // Let the device thread process its events before continuing
+            _timer->start(0);
+            return;
+        }
+
+        const QCanBusFrame &frame = batch.frames.at(batch.nextFrameIdx);
+
+        if(_config.isPacingEnabled())
+        {
+            const qint64 earliestTimeInNs = getEarliestWriteTimeInNs(frame.frameId());
+            const qint64 remainingInNs = earliestTimeInNs - _clock.nsecsElapsed();
+
+            if(remainingInNs >= CanLibConstants::Time::MilliToNanoCoeff)
+            {
+                // The timer wakes us a little early, the remaining time is actively waited
+                _timer->start(static_cast<int>(remainingInNs /
+                                               CanLibConstants::Time::MilliToNanoCoeff));
+                return;
+            }
+
+            while(_clock.nsecsElapsed() < earliestTimeInNs)
+            {
+                // Active wait, the timers resolution is too low for this gap
+            }
+        }
+
+        bool txQueueFull = false;
+        const bool success = _isCanFd ?
+                                 PCanApi::writeCanFdMsgProcess(_canBusItf, frame, &txQueueFull) :
+                                 PCanApi::writeCanMsgProcess(_canBusItf, frame, &txQueueFull);
+
+        if(!success && txQueueFull)
+        {
+            if(!_queueFullTimer.isValid())
+            {
+                _queueFullTimer.start();
+            }
+            else if(_queueFullTimer.hasExpired(_config.getQueueFullTimeoutInMs()))
+            {
+                qWarning() << "The transmit queue of the CAN bus: "
+                           << PCanBusItf::toString(_canBusItf) << ", has been full for more than: "
+                           << _config.getQueueFullTimeoutInMs() << "ms, we abandon the batch: "
+                           << batch.id;
+                finishFirstBatch(false);
+                continue;
+            }
+
+            _timer->start(QueueFullRetryDelayInMs);
+            return;
+        }
+
+        if(!success)
+        {
+            _metrics->addTxError();
+            qWarning() << "A problem occurred when tried to write the batch: " << batch.id
+                       << ", on the CAN bus: " << PCanBusItf::toString(_canBusItf)
+                       << ", we abandon it";
+            finishFirstBatch(false);
+            continue;
+        }
+
+        _queueFullTimer.invalidate();
+        _metrics->addTxFrame(frame);
+
+        if(_config.isPacingEnabled())
+        {
+            const qint64 nowInNs = _clock.nsecsElapsed();
+            _lastWriteTimeInNs = nowInNs;
+
+            if(_config.getMinGapForIdInUs(frame.frameId()) > 0)
+            {
+                _lastWriteTimesByIdInNs.insert(frame.frameId(), nowInNs);
+            }
+        }
+
+        ++batch.nextFrameIdx;
+        --_pendingFramesNb;
+        ++writtenFramesNb;
+    }
+}
+
+qint64 CanTxQueue::getEarliestWriteTimeInNs(quint32 frameId) const
+{
+    qint64 earliestTimeInNs = 0;
+
+    const int globalMinGapInUs = _config.getGlobalMinGapInUs();
+    if(globalMinGapInUs > 0 && _lastWriteTimeInNs >= 0)
+    {
+        earliestTimeInNs = _lastWriteTimeInNs +
+                           (globalMinGapInUs * CanLibConstants::Time::MicroToNanoCoeff);
+    }
+
+    const int idMinGapInUs = _config.getMinGapForIdInUs(frameId);
+    if(idMinGapInUs > 0)
+    {
+        auto citer = _lastWriteTimesByIdInNs.constFind(frameId);
+        if(citer != _lastWriteTimesByIdInNs.cend())
+        {
+            earliestTimeInNs = qMax(earliestTimeInNs,
+                                    *citer + (idMinGapInUs *
+                                              CanLibConstants::Time::MicroToNanoCoeff));
+        }
+    }
+
+    return earliestTimeInNs;
+}
+
+void CanTxQueue::finishFirstBatch(bool success)
+{
+    const Batch batch = _batches.dequeue();
+
+    _pendingFramesNb -= (batch.frames.size() - batch.nextFrameIdx);
+    _queueFullTimer.invalidate();
+
+    emit batchWritten(batch.id, success);
+}
@@ -0,0 +1,121 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QCanBusFrame>
+#include <QElapsedTimer>
+#include <QHash>
+#include <QQueue>
+#include <QSharedPointer>
+
+#include "src/pcanapi/pcanbusitf.hpp"
+#include "src/txqueue/cantxqueueconfig.hpp"
+
+class CanBusMetrics;
+class QTimer;
+
+
+/** @brief This is the transmit queue of a CAN device, it writes batches of frames in order
+    @note The object lives in the CAN device thread. The batches are written by bursts of
+          @ref MaxFramesNbByBurst frames, between two bursts the device thread event loop is
+          processed.
+    @note When the CAN driver transmit queue is full, the frame is retried later, until the
+          configured timeout. When a pacing is configured, the frames are delayed to respect the
+          minimum gaps: a gap longer than 1 ms is waited with a precise timer and the remaining
+          time is actively waited. */
+class CanTxQueue : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief A batch of frames waiting to be written */
+        struct Batch
+        {
+            /** @brief The batch id, given back with @ref batchWritten */
+            quint64 id{0};
+
+            /** @brief The frames to write */
+            QVector<QCanBusFrame> frames{};
+
+            /** @brief The index of the next frame to write */
+            int nextFrameIdx{0};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param canBusItf The CAN bus interface where the frames are written
+            @param isCanFd True if the CAN bus interface has been initialized for CAN FD
+            @param config The queue config
+            @param metrics The metrics of the bus, where the written frames are counted
+            @param parent The class parent */
+        explicit CanTxQueue(PCanBusItf::Enum canBusItf,
+                            bool isCanFd,
+                            const CanTxQueueConfig &config,
+                            const QSharedPointer<CanBusMetrics> &metrics,
+                            QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~CanTxQueue() override;
+
+    public:
+        /** @brief Add a batch of frames to write
+            @note The end of the batch writing is notified with @ref batchWritten
+            @param frames The frames to write
+            @param batchId The batch id */
+        void enqueue(const QVector<QCanBusFrame> &frames, quint64 batchId);
+
+        /** @brief Get the number of frames waiting to be written */
+        int getPendingFramesNb() const { return _pendingFramesNb; }
+
+        /** @brief Abandon all the waiting batches
+            @note @ref batchWritten is emitted with a failure for each abandoned batch */
+        void clear();
+
+    signals:
+        /** @brief Emitted when a batch writing is finished
+            @param batchId The id of the batch
+            @param success True if all the frames of the batch have been written */
+        void batchWritten(quint64 batchId, bool success);
+
+    private slots:
+        /** @brief Write the waiting frames, until the end of the burst or until a frame has to be
+                   delayed */
+        void processQueue();
+
+    private:
+        /** @brief Get the earliest time when the frame with the id given can be written,
+                   according to the pacing config
+            @param frameId The id of the frame to write
+            @return The earliest time in ns, relatively to the queue clock */
+        qint64 getEarliestWriteTimeInNs(quint32 frameId) const;
+
+        /** @brief Remove the first batch of the queue and emit @ref batchWritten
+            @param success True if all the frames of the batch have been written */
+        void finishFirstBatch(bool success);
+
+    private:
+        /** @brief The max number of frames written before processing the event loop */
+        static const constexpr int MaxFramesNbByBurst = 256;
+
+        /** @brief The delay before retrying a write, when the CAN driver transmit queue is full */
+        static const constexpr int QueueFullRetryDelayInMs = 1;
+
+    private:
+        PCanBusItf::Enum _canBusItf;
+        bool _isCanFd;
+        CanTxQueueConfig _config;
+        QSharedPointer<CanBusMetrics> _metrics;
+
+        QQueue<Batch> _batches;
+        int _pendingFramesNb{0};
+        QTimer *_timer{nullptr};
+
+        QElapsedTimer _clock;
+        QElapsedTimer _queueFullTimer;
+        qint64 _lastWriteTimeInNs{-1};
+        QHash<quint32, qint64> _lastWriteTimesByIdInNs;
+};
@@ -0,0 +1,26 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "cantxqueueconfig.hpp"
+
+
+CanTxQueueConfig::CanTxQueueConfig()
+{
+}
+
+void CanTxQueueConfig::setMinGapForIdInUs(quint32 frameId, int minGapInUs)
+{
+    if(minGapInUs <= 0)
+    {
+        _minGapsByIdInUs.remove(frameId);
+        return;
+    }
+
+    _minGapsByIdInUs.insert(frameId, minGapInUs);
+}
+
+bool CanTxQueueConfig::isValid() const
+{
+    return (_globalMinGapInUs >= 0) && (_queueFullTimeoutInMs > 0);
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QHash>
+
+#include "src/definescan.hpp"
+
+
+/** @brief This is the config of the transmit queue of a CAN device
+    @see CanTxQueue */
+class CAN_EXPORT CanTxQueueConfig
+{
+    public:
+        /** @brief Class constructor */
+        explicit CanTxQueueConfig();
+
+    public:
+        /** @brief Get the minimum gap between two written frames, whatever their ids
+            @note 0 means no pacing */
+        int getGlobalMinGapInUs() const { return _globalMinGapInUs; }
+
+        /** @brief Set the minimum gap between two written frames, whatever their ids
+            @param globalMinGapInUs The gap to set, 0 to disable the global pacing */
+        void setGlobalMinGapInUs(int globalMinGapInUs) { _globalMinGapInUs = globalMinGapInUs; }
+
+        /** @brief Get the minimum gaps between two written frames with the same id */
+        const QHash<quint32, int> &getMinGapsByIdInUs() const { return _minGapsByIdInUs; }
+
+        /** @brief Get the minimum gap between two written frames with the id given
+            @param frameId The id of the frames
+            @return The minimum gap, 0 if there is no pacing for this id */
+        int getMinGapForIdInUs(quint32 frameId) const { return _minGapsByIdInUs.value(frameId, 0); }
+
+        /** @brief Set the minimum gap between two written frames with the id given
+            @param frameId The id of the frames
+            @param minGapInUs The gap to set, 0 to disable the pacing for this id */
+        void setMinGapForIdInUs(quint32 frameId, int minGapInUs);
+
+        /** @brief Say if a pacing has been configured */
+        bool isPacingEnabled() const
+        { return _globalMinGapInUs > 0 || !_minGapsByIdInUs.isEmpty(); }
+
+        /** @brief Get the max duration of the retries, when the CAN driver transmit queue is full
+            @note After this duration, the batch is abandoned */
+        int getQueueFullTimeoutInMs() const { return _queueFullTimeoutInMs; }
+
+        /** @brief Set the max duration of the retries, when the CAN driver transmit queue is full
+            @param queueFullTimeoutInMs The timeout to set */
+        void setQueueFullTimeoutInMs(int queueFullTimeoutInMs)
+        { _queueFullTimeoutInMs = queueFullTimeoutInMs; }
+
+        /** @brief Test if the config is valid
+            @return True if the config is valid */
+        bool isValid() const;
+
+    private:
+        /** @brief The default max duration of the retries, when the driver queue is full */
+        static const constexpr int DefaultQueueFullTimeoutInMs = 1000;
+
+    private:
+        int _globalMinGapInUs{0};
+        QHash<quint32, int> _minGapsByIdInUs;
+        int _queueFullTimeoutInMs{DefaultQueueFullTimeoutInMs};
+};
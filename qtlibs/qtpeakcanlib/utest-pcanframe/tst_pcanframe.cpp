@@ -0,0 +1,203 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tst_pcanframe.hpp"
+
+#include <QCanBusFrame>
+#include <QtTest>
+
+#include "src/pcanapi/pcanframeconverter.hpp"
+#include "src/pcanapi/pcanframedlc.hpp"
+
+
+/** @brief Create a payload of the size given, filled with a counter */
+static QByteArray createPayload(int size)
+{
+    QByteArray payload(size, 0x00);
+    for(int idx = 0; idx < size; ++idx)
+    {
+        payload[idx] = static_cast<char>(idx + 1);
+    }
+
+    return payload;
+}
+
+
+PCanFrameTest::PCanFrameTest()
+{
+}
+
+PCanFrameTest::~PCanFrameTest()
+{
+}
+
+void PCanFrameTest::test_dlcsizes_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<int>("dlcByte");
+
+    const QVector<int> sizes = { 0, 1, 2, 3, 4, 5, 6, 7, 8, 12, 16, 20, 24, 32, 48, 64 };
+    for(int idx = 0; idx < sizes.length(); ++idx)
+    {
+        QTest::newRow(qPrintable(QString("Size: %1").arg(sizes.at(idx))))
+                << sizes.at(idx)
+                << idx;
+    }
+}
+
+void PCanFrameTest::test_dlcsizes()
+{
+    QFETCH(int, size);
+    QFETCH(int, dlcByte);
+
+    const PCanFrameDlc::Enum dlc = PCanFrameDlc::parseFromSize(size);
+
+    QCOMPARE(static_cast<int>(PCanFrameDlc::toByte(dlc)), dlcByte);
+    QCOMPARE(PCanFrameDlc::toSize(dlc), size);
+    QCOMPARE(PCanFrameDlc::parseFromByte(static_cast<quint8>(dlcByte)), dlc);
+    QCOMPARE(PCanFrameDlc::byteToSize(static_cast<quint8>(dlcByte)), size);
+}
+
+void PCanFrameTest::test_classicroundtrip_data()
+{
+    QTest::addColumn<quint32>("frameId");
+    QTest::addColumn<bool>("extended");
+    QTest::addColumn<QByteArray>("payload");
+
+    QTest::newRow("Standard id, empty payload")
+            << static_cast<quint32>(0x123) << false << QByteArray();
+    QTest::newRow("Standard id, 8 bytes payload")
+            << static_cast<quint32>(0x7DF) << false << createPayload(8);
+    QTest::newRow("Extended id, 3 bytes payload")
+            << static_cast<quint32>(0x18DAF110) << true << createPayload(3);
+}
+
+void PCanFrameTest::test_classicroundtrip()
+{
+    QFETCH(quint32, frameId);
+    QFETCH(bool, extended);
+    QFETCH(QByteArray, payload);
+
+    QCanBusFrame frame(frameId, payload);
+    frame.setExtendedFrameFormat(extended);
+
+    TPCANMsg message;
+    QVERIFY(PCanFrameConverter::toCanMsg(frame, message));
+    QCOMPARE(static_cast<int>(message.LEN), payload.size());
+
+    TPCANTimestamp timestamp;
+    timestamp.millis = 1234;
+    timestamp.millis_overflow = 0;
+    timestamp.micros = 567;
+
+    const QCanBusFrame converted = PCanFrameConverter::fromCanMsg(message, timestamp);
+
+    QCOMPARE(converted.frameId(), frameId);
+    QCOMPARE(converted.hasExtendedFrameFormat(), extended);
+    QCOMPARE(converted.payload(), payload);
+    QCOMPARE(converted.timeStamp().seconds(), static_cast<qint64>(1));
+    QCOMPARE(converted.timeStamp().microSeconds(), static_cast<qint64>(234567));
+}
+
+void PCanFrameTest::test_fdroundtrip_data()
+{
+    QTest::addColumn<quint32>("frameId");
+    QTest::addColumn<bool>("bitrateSwitch");
+    QTest::addColumn<QByteArray>("payload");
+
+    QTest::newRow("FD frame, 12 bytes payload")
+            << static_cast<quint32>(0x123) << false << createPayload(12);
+    QTest::newRow("FD frame with bitrate switch, 64 bytes payload")
+            << static_cast<quint32>(0x18DAF110) << true << createPayload(64);
+}
+
+void PCanFrameTest::test_fdroundtrip()
+{
+    QFETCH(quint32, frameId);
+    QFETCH(bool, bitrateSwitch);
+    QFETCH(QByteArray, payload);
+
+    QCanBusFrame frame(frameId, payload);
+    frame.setFlexibleDataRateFormat(true);
+    frame.setBitrateSwitch(bitrateSwitch);
+
+    TPCANMsgFD message;
+    QVERIFY(PCanFrameConverter::toCanFdMsg(frame, message));
+
+    QCanBusFrame converted;
+    QVERIFY(PCanFrameConverter::fromCanFdMsg(message, 42, converted));
+
+    QCOMPARE(converted.frameId(), frameId);
+    QCOMPARE(converted.payload(), payload);
+    QCOMPARE(converted.hasFlexibleDataRateFormat(), true);
+    QCOMPARE(converted.hasBitrateSwitch(), bitrateSwitch);
+    QCOMPARE(converted.timeStamp().microSeconds(), static_cast<qint64>(42));
+}
+
+void PCanFrameTest::test_wrongsizes()
+{
+    TPCANMsg message;
+    QVERIFY(!PCanFrameConverter::toCanMsg(QCanBusFrame(0x123, createPayload(9)), message));
+
+    TPCANMsgFD fdMessage;
+    QCanBusFrame fdFrame(0x123, createPayload(13));
+    fdFrame.setFlexibleDataRateFormat(true);
+    QVERIFY(!PCanFrameConverter::toCanFdMsg(fdFrame, fdMessage));
+
+    fdMessage.DLC = 0x10;
+    QCanBusFrame converted;
+    QVERIFY(!PCanFrameConverter::fromCanFdMsg(fdMessage, 0, converted));
+}
+
+void PCanFrameTest::bench_dlcconversion()
+{
+    qint32 sizesSum = 0;
+
+    QBENCHMARK
+    {
+        for(qint32 size = 0; size <= PCanFrameDlc::MaxSize; ++size)
+        {
+            sizesSum += PCanFrameDlc::byteToSize(
+                                    PCanFrameDlc::toByte(PCanFrameDlc::parseFromSize(size)));
+        }
+    }
+
+    QVERIFY(sizesSum > 0);
+}
+
+void PCanFrameTest::bench_classicroundtrip()
+{
+    const QCanBusFrame frame(0x7DF, createPayload(8));
+    TPCANMsg message;
+    TPCANTimestamp timestamp = {};
+    QCanBusFrame converted;
+
+    QBENCHMARK
+    {
+        PCanFrameConverter::toCanMsg(frame, message);
+        converted = PCanFrameConverter::fromCanMsg(message, timestamp);
+    }
+
+    QCOMPARE(converted.payload(), frame.payload());
+}
+
+void PCanFrameTest::bench_fdroundtrip()
+{
+    QCanBusFrame frame(0x18DAF110, createPayload(64));
+    frame.setFlexibleDataRateFormat(true);
+    frame.setBitrateSwitch(true);
+
+    TPCANMsgFD message;
+    QCanBusFrame converted;
+
+    QBENCHMARK
+    {
+        PCanFrameConverter::toCanFdMsg(frame, message);
+        PCanFrameConverter::fromCanFdMsg(message, 0, converted);
+    }
+
+    QCOMPARE(converted.payload(), frame.payload());
+}
+
+QTEST_APPLESS_MAIN(PCanFrameTest)
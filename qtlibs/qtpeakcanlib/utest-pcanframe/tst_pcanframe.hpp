@@ -0,0 +1,32 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+
+/** @brief Tests the DLC tables and the frames conversion layer of the PEAK CAN lib
+    @note The benchmarks give the per-frame CPU cost of the conversions, run them with:
+          "utest-pcanframe -tickcounter bench_<name>" to get stable results */
+class PCanFrameTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        PCanFrameTest();
+        ~PCanFrameTest();
+
+    private slots:
+        void test_dlcsizes_data();
+        void test_dlcsizes();
+        void test_classicroundtrip_data();
+        void test_classicroundtrip();
+        void test_fdroundtrip_data();
+        void test_fdroundtrip();
+        void test_wrongsizes();
+        void bench_dlcconversion();
+        void bench_classicroundtrip();
+        void bench_fdroundtrip();
+};
@@ -0,0 +1,44 @@
+# SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+#
+# SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+QT += testlib
+QT += serialbus
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+CONFIG *= c++17
+
+TEMPLATE = app
+
+ROOT = $$absolute_path(../../..)
+LIB_PATH = $$absolute_path(..)
+TEST_ROOT = $$absolute_path(.)
+
+include($$ROOT/import-build-params.pri)
+
+!exists($$LIB_PATH/3rdparty/include/PCANBasic.h) {
+    error("To build the utest-pcanframe, you have to include the 3rd party of the qtpeakcanlib,\
+           see its README.md to more details")
+}
+
+DESTDIR = $$DESTDIR_LIBS
+
+INCLUDEPATH *= $$LIB_PATH
+INCLUDEPATH *= $$TEST_ROOT
+INCLUDEPATH *= "$$LIB_PATH/3rdparty/include"
+
+HEADERS *=  tst_pcanframe.hpp
+SOURCES *=  tst_pcanframe.cpp
+
+# The conversion layer doesn't call the PEAK CAN lib, only its header is needed
+HEADERS *= $$LIB_PATH/src/pcanapi/pcanframeconverter.hpp
+SOURCES *= $$LIB_PATH/src/pcanapi/pcanframeconverter.cpp
+HEADERS *= $$LIB_PATH/src/pcanapi/pcanframedlc.hpp
+
+unix {
+    target.path = /opt/utest
+    INSTALLS += target
+}
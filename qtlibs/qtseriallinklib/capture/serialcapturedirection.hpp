@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief The direction of a chunk captured on a serial link, see @ref SerialCaptureRecord */
+class SERIALLINK_EXPORT SerialCaptureDirection : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The capture directions */
+        enum Enum {
+            Tx,             //!< @brief The chunk has been written on the serial port
+            Rx,             //!< @brief The chunk has been received from the serial port
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+
+        /** @brief Parse the enum from its string representation
+            @param value The string to parse
+            @return The enum parsed, this returns Unknown if no match has been found */
+        static Enum parseFromString(const QString &value);
+};
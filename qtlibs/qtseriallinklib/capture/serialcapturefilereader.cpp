@@ -0,0 +1,162 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcapturefilereader.hpp"
+
+#include <QDebug>
+#include <QtEndian>
+
+#include <limits>
+
+#include "capture/serialcaptureformat.hpp"
+#include "capture/serialcapturerecord.hpp"
+
+
+SerialCaptureFileReader::SerialCaptureFileReader()
+{
+}
+
+SerialCaptureFileReader::~SerialCaptureFileReader()
+{
+    close();
+}
+
+bool SerialCaptureFileReader::open(const QString &filePath)
+{
+    if(_file.isOpen())
+    {
+        qWarning() << "The serial capture file: " << _file.fileName() << ", is already open";
+        return false;
+    }
+
+    _file.setFileName(filePath);
+    if(!_file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Can't open the serial capture file: " << filePath << ", error: "
+                   << _file.errorString();
+        return false;
+    }
+
+    const int fixedHeaderSize = SerialCaptureFormat::MagicSize + 1 +
+                                static_cast<int>(sizeof(quint16));
+    const QByteArray header = _file.read(fixedHeaderSize);
+
+    if(header.length() != fixedHeaderSize ||
+       !header.startsWith(QByteArray(SerialCaptureFormat::Magic, SerialCaptureFormat::MagicSize)))
+    {
+        qWarning() << "The file: " << filePath << ", isn't a serial capture file";
+        close();
+        return false;
+    }
+
+    const quint8 version = static_cast<quint8>(header.at(SerialCaptureFormat::MagicSize));
+    if(version != SerialCaptureFormat::Version)
+    {
+        qWarning() << "The version: " << version << ", of the serial capture file: " << filePath
+                   << ", isn't supported";
+        close();
+        return false;
+    }
+
+    const quint16 portNameLength = qFromBigEndian<quint16>(
+        header.constData() + SerialCaptureFormat::MagicSize + 1);
+    const QByteArray portName = _file.read(portNameLength);
+    if(portName.length() != portNameLength)
+    {
+        qWarning() << "The header of the serial capture file: " << filePath << ", is truncated";
+        close();
+        return false;
+    }
+
+    _portName = QString::fromUtf8(portName);
+    _lastTimestampInNs = 0;
+    _corrupted = false;
+    return true;
+}
+
+bool SerialCaptureFileReader::readNext(SerialCaptureRecord &record)
+{
+    char direction = 0;
+    if(!_file.isOpen() || !_file.getChar(&direction))
+    {
+        return false;
+    }
+
+    quint64 deltaInNs = 0;
+    quint64 length = 0;
+    if(!readVarint(deltaInNs) || !readVarint(length) ||
+       length > static_cast<quint64>(std::numeric_limits<int>::max()))
+    {
+        qWarning() << "A record of the serial capture file: " << _file.fileName()
+                   << ", is corrupted";
+        _corrupted = true;
+        return false;
+    }
+
+    const QByteArray data = _file.read(static_cast<qint64>(length));
+    if(data.length() != static_cast<int>(length))
+    {
+        qWarning() << "The last record of the serial capture file: " << _file.fileName()
+                   << ", is truncated";
+        _corrupted = true;
+        return false;
+    }
+
+    const quint8 directionValue = static_cast<quint8>(direction);
+    _lastTimestampInNs += static_cast<qint64>(deltaInNs);
+    record = SerialCaptureRecord(_lastTimestampInNs,
+                                 (directionValue < SerialCaptureDirection::Unknown) ?
+                                     static_cast<SerialCaptureDirection::Enum>(directionValue) :
+                                     SerialCaptureDirection::Unknown,
+                                 data);
+    return true;
+}
+
+bool SerialCaptureFileReader::readAll(QVector<SerialCaptureRecord> &records,
+                                      SerialCaptureDirection::Enum direction)
+{
+    SerialCaptureRecord record;
+    while(readNext(record))
+    {
+        if(direction == SerialCaptureDirection::Unknown || record.getDirection() == direction)
+        {
+            records.append(record);
+        }
+    }
+
+    return !_corrupted;
+}
+
+void SerialCaptureFileReader::close()
+{
+    if(_file.isOpen())
+    {
+        _file.close();
+    }
+}
+
+bool SerialCaptureFileReader::readVarint(quint64 &value)
+{
+    value = 0;
+
+    for(int idx = 0; idx < SerialCaptureFormat::VarintMaxBytesNb; ++idx)
+    {
+        char byte = 0;
+        if(!_file.getChar(&byte))
+        {
+            return false;
+        }
+
+        const quint8 byteValue = static_cast<quint8>(byte);
+        value |= static_cast<quint64>(byteValue & SerialCaptureFormat::VarintPayloadMask) <<
+                 (idx * SerialCaptureFormat::VarintBitsNb);
+
+        if((byteValue & SerialCaptureFormat::VarintContinueBit) == 0)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
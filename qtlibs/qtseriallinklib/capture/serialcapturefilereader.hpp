@@ -0,0 +1,64 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QFile>
+#include <QVector>
+
+#include "definesseriallink.hpp"
+#include "capture/serialcapturedirection.hpp"
+
+class SerialCaptureRecord;
+
+
+/** @brief Read the records of a serial capture file
+    @note See @ref SerialCaptureFormat for the file format */
+class SERIALLINK_EXPORT SerialCaptureFileReader
+{
+    public:
+        /** @brief Class constructor */
+        explicit SerialCaptureFileReader();
+
+        /** @brief Class destructor
+            @note The file is closed */
+        virtual ~SerialCaptureFileReader();
+
+    public:
+        /** @brief Open the capture file and read its header
+            @param filePath The path of the file to read
+            @return True if no problem occurred */
+        bool open(const QString &filePath);
+
+        /** @brief Get the name of the captured serial port, read in the file header */
+        const QString &getPortName() const { return _portName; }
+
+        /** @brief Read the next record of the file
+            @param record The record read
+            @return False if there is no more record or if the file is corrupted */
+        bool readNext(SerialCaptureRecord &record);
+
+        /** @brief Read all the remaining records of the file
+            @param records The records read are appended to this vector
+            @param direction Only the records of this direction are kept, Unknown to keep all of
+                             them
+            @return False if the file is corrupted */
+        bool readAll(QVector<SerialCaptureRecord> &records,
+                     SerialCaptureDirection::Enum direction = SerialCaptureDirection::Unknown);
+
+        /** @brief Close the capture file */
+        void close();
+
+    private:
+        /** @brief Read an unsigned LEB128 varint
+            @param value The value read
+            @return False if the file ends or if the varint is too long */
+        bool readVarint(quint64 &value);
+
+    private:
+        QFile _file;
+        QString _portName;
+        qint64 _lastTimestampInNs{0};
+        bool _corrupted{false};
+};
@@ -0,0 +1,117 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcapturefilewriter.hpp"
+
+#include <QDebug>
+#include <QtEndian>
+
+#include <limits>
+
+#include "capture/serialcaptureformat.hpp"
+#include "capture/serialcapturerecord.hpp"
+
+
+SerialCaptureFileWriter::SerialCaptureFileWriter()
+{
+}
+
+SerialCaptureFileWriter::~SerialCaptureFileWriter()
+{
+    close();
+}
+
+bool SerialCaptureFileWriter::open(const QString &filePath, const QString &portName)
+{
+    if(_file.isOpen())
+    {
+        qWarning() << "The serial capture file: " << _file.fileName() << ", is already open";
+        return false;
+    }
+
+    const QByteArray portNameUtf8 = portName.toUtf8();
+    if(portNameUtf8.length() > std::numeric_limits<quint16>::max())
+    {
+        qWarning() << "The port name is too long to be written in the capture file";
+        return false;
+    }
+
+    _file.setFileName(filePath);
+    if(!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Can't create the serial capture file: " << filePath << ", error: "
+                   << _file.errorString();
+        return false;
+    }
+
+    QByteArray header(SerialCaptureFormat::Magic, SerialCaptureFormat::MagicSize);
+    header.append(static_cast<char>(SerialCaptureFormat::Version));
+
+    QByteArray portNameLength(sizeof(quint16), Qt::Uninitialized);
+    qToBigEndian(static_cast<quint16>(portNameUtf8.length()), portNameLength.data());
+    header.append(portNameLength);
+    header.append(portNameUtf8);
+
+    if(_file.write(header) != header.length())
+    {
+        qWarning() << "Can't write the header of the serial capture file: " << filePath
+                   << ", error: " << _file.errorString();
+        _file.close();
+        return false;
+    }
+
+    _lastTimestampInNs = 0;
+    _recordsNb = 0;
+    return true;
+}
+
+bool SerialCaptureFileWriter::write(const SerialCaptureRecord &record)
+{
+    if(!_file.isOpen())
+    {
+        qWarning() << "Can't write the record, the serial capture file isn't open";
+        return false;
+    }
+
+    const qint64 deltaInNs = qMax(record.getTimestampInNs() - _lastTimestampInNs, qint64(0));
+    const QByteArray &data = record.getData();
+
+    QByteArray buffer;
+    buffer.reserve(1 + (2 * SerialCaptureFormat::VarintMaxBytesNb) + data.length());
+    buffer.append(static_cast<char>(record.getDirection()));
+    appendVarint(static_cast<quint64>(deltaInNs), buffer);
+    appendVarint(static_cast<quint64>(data.length()), buffer);
+    buffer.append(data);
+
+    if(_file.write(buffer) != buffer.length())
+    {
+        qWarning() << "Can't write a record in the serial capture file: " << _file.fileName()
+                   << ", error: " << _file.errorString();
+        return false;
+    }
+
+    _lastTimestampInNs += deltaInNs;
+    ++_recordsNb;
+    return true;
+}
+
+void SerialCaptureFileWriter::close()
+{
+    if(_file.isOpen())
+    {
+        _file.close();
+    }
+}
+
+void SerialCaptureFileWriter::appendVarint(quint64 value, QByteArray &buffer)
+{
+    while(value > SerialCaptureFormat::VarintPayloadMask)
+    {
+        buffer.append(static_cast<char>((value & SerialCaptureFormat::VarintPayloadMask) |
+                                        SerialCaptureFormat::VarintContinueBit));
+        value >>= SerialCaptureFormat::VarintBitsNb;
+    }
+
+    buffer.append(static_cast<char>(value));
+}
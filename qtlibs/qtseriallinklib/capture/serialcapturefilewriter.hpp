@@ -0,0 +1,59 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QFile>
+
+#include "definesseriallink.hpp"
+
+class SerialCaptureRecord;
+
+
+/** @brief Write the records of a serial capture in a file
+    @note See @ref SerialCaptureFormat for the file format */
+class SERIALLINK_EXPORT SerialCaptureFileWriter
+{
+    public:
+        /** @brief Class constructor */
+        explicit SerialCaptureFileWriter();
+
+        /** @brief Class destructor
+            @note The file is closed */
+        virtual ~SerialCaptureFileWriter();
+
+    public:
+        /** @brief Create the capture file and write its header
+            @note If the file already exists, it's overwritten
+            @param filePath The path of the file to create
+            @param portName The name of the captured serial port
+            @return True if no problem occurred */
+        bool open(const QString &filePath, const QString &portName);
+
+        /** @brief Test if the capture file is open */
+        bool isOpen() const { return _file.isOpen(); }
+
+        /** @brief Append a record to the file
+            @note The records have to be given in the capture order
+            @param record The record to write
+            @return True if no problem occurred */
+        bool write(const SerialCaptureRecord &record);
+
+        /** @brief Flush and close the capture file */
+        void close();
+
+        /** @brief Get the number of records written */
+        quint64 getRecordsNb() const { return _recordsNb; }
+
+    private:
+        /** @brief Append an unsigned LEB128 varint to the buffer given
+            @param value The value to append
+            @param buffer The buffer to complete */
+        static void appendVarint(quint64 value, QByteArray &buffer);
+
+    private:
+        QFile _file;
+        qint64 _lastTimestampInNs{0};
+        quint64 _recordsNb{0};
+};
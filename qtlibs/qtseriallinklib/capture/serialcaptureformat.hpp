@@ -0,0 +1,45 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+
+/** @brief This namespace describes the binary format of the serial capture files
+    @note The file begins with a header:
+          - the magic bytes: "SCAP",
+          - the format version: 1 byte,
+          - the port name length: 2 bytes in big endian,
+          - the port name, in UTF-8.
+    @note The header is followed by the records, each one contains:
+          - the direction: 1 byte, see @ref SerialCaptureDirection::Enum,
+          - the time elapsed since the previous record, in nanoseconds: unsigned LEB128 varint,
+          - the data length: unsigned LEB128 varint,
+          - the data.
+    @note With the varints, a small chunk received a few milliseconds after the previous one only
+          costs 5 or 6 bytes of overhead */
+namespace SerialCaptureFormat
+{
+    /** @brief The magic bytes at the beginning of the capture files */
+    const constexpr char Magic[] = "SCAP";
+
+    /** @brief The size of the magic bytes */
+    const constexpr int MagicSize = 4;
+
+    /** @brief The format version */
+    const constexpr quint8 Version = 1;
+
+    /** @brief The number of payload bits in each byte of a varint */
+    const constexpr int VarintBitsNb = 7;
+
+    /** @brief The mask of the payload bits in each byte of a varint */
+    const constexpr quint8 VarintPayloadMask = 0x7F;
+
+    /** @brief This bit is set in the varint bytes which are followed by another one */
+    const constexpr quint8 VarintContinueBit = 0x80;
+
+    /** @brief The max number of bytes of a 64 bits varint */
+    const constexpr int VarintMaxBytesNb = 10;
+}
@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcapturequeue.hpp"
+
+
+SerialCaptureQueue::SerialCaptureQueue(int capacity)
+{
+    quint32 powerOfTwo = 1;
+    while(powerOfTwo < static_cast<quint32>(qMax(capacity, 1)))
+    {
+        powerOfTwo <<= 1;
+    }
+
+    _records.resize(powerOfTwo);
+    _mask = powerOfTwo - 1;
+    _timer.start();
+}
+
+bool SerialCaptureQueue::capture(SerialCaptureDirection::Enum direction, const QByteArray &data)
+{
+    const quint32 tail = _tail.load(std::memory_order_relaxed);
+    const quint32 head = _head.load(std::memory_order_acquire);
+
+    if((tail - head) > _mask)
+    {
+        _droppedChunksNb.fetch_add(1, std::memory_order_relaxed);
+        return false;
+    }
+
+    _records[tail & _mask] = SerialCaptureRecord(_timer.nsecsElapsed(), direction, data);
+
+    // The record is published to the consumer with the tail
+    _tail.store(tail + 1, std::memory_order_release);
+    return true;
+}
+
+bool SerialCaptureQueue::pop(SerialCaptureRecord &record)
+{
+    const quint32 head = _head.load(std::memory_order_relaxed);
+    const quint32 tail = _tail.load(std::memory_order_acquire);
+
+    if(head == tail)
+    {
+        return false;
+    }
+
+    SerialCaptureRecord &slot = _records[head & _mask];
+    record = slot;
+
+    // The slot data is released here, not when the producer overwrites it
+    slot = SerialCaptureRecord();
+
+    _head.store(head + 1, std::memory_order_release);
+    return true;
+}
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+#include <QElapsedTimer>
+
+#include <atomic>
+#include <vector>
+
+#include "capture/serialcapturedirection.hpp"
+#include "capture/serialcapturerecord.hpp"
+
+
+/** @brief This is the lock-free hand-off of the captured chunks, between the serial link thread
+           and the capture thread which writes them in the file
+    @note There is one producer (the serial link thread) and one consumer (the capture thread): the
+          queue is a bounded ring whose head and tail are atomics, no mutex is taken and the serial
+          link thread never waits for the file writing.
+    @note When the ring is full, the new chunks are dropped and counted
+    @note The chunks are timestamped with a monotonic clock started at the queue creation */
+class SerialCaptureQueue
+{
+    public:
+        /** @brief Class constructor
+            @param capacity The max number of chunks waiting to be written, it's rounded up to a
+                            power of two */
+        explicit SerialCaptureQueue(int capacity = DefaultCapacity);
+
+    public:
+        /** @brief Timestamp and push a chunk
+            @note Only the producer thread (the serial link thread) can call this method
+            @param direction The direction of the chunk
+            @param data The bytes of the chunk
+            @return False if the queue is full, in that case the chunk is dropped */
+        bool capture(SerialCaptureDirection::Enum direction, const QByteArray &data);
+
+        /** @brief Pop the oldest chunk
+            @note Only the consumer thread (the capture thread) can call this method
+            @param record The chunk popped
+            @return False if the queue is empty */
+        bool pop(SerialCaptureRecord &record);
+
+        /** @brief Get the number of chunks dropped because the queue was full */
+        quint64 getDroppedChunksNb() const { return _droppedChunksNb; }
+
+    public:
+        /** @brief The default max number of chunks waiting to be written */
+        static const constexpr int DefaultCapacity = 4096;
+
+    private:
+        std::vector<SerialCaptureRecord> _records;
+        quint32 _mask{0};
+        QElapsedTimer _timer;
+
+        /** @brief The index of the next chunk to pop, only written by the consumer */
+        std::atomic<quint32> _head{0};
+
+        /** @brief The index of the next chunk to push, only written by the producer */
+        std::atomic<quint32> _tail{0};
+
+        std::atomic<quint64> _droppedChunksNb{0};
+};
@@ -0,0 +1,19 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcapturerecord.hpp"
+
+
+SerialCaptureRecord::SerialCaptureRecord()
+{
+}
+
+SerialCaptureRecord::SerialCaptureRecord(qint64 timestampInNs,
+                                         SerialCaptureDirection::Enum direction,
+                                         const QByteArray &data)
+    : _timestampInNs{timestampInNs},
+      _direction{direction},
+      _data{data}
+{
+}
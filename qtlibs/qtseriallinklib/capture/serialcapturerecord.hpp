@@ -0,0 +1,43 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+
+#include "definesseriallink.hpp"
+#include "capture/serialcapturedirection.hpp"
+
+
+/** @brief A chunk of bytes captured on a serial link, with the time it has been written or
+           received */
+class SERIALLINK_EXPORT SerialCaptureRecord
+{
+    public:
+        /** @brief Class constructor */
+        explicit SerialCaptureRecord();
+
+        /** @brief Class constructor
+            @param timestampInNs The monotonic time of the chunk, since the capture start
+            @param direction The direction of the chunk
+            @param data The bytes of the chunk */
+        explicit SerialCaptureRecord(qint64 timestampInNs,
+                                     SerialCaptureDirection::Enum direction,
+                                     const QByteArray &data);
+
+    public:
+        /** @brief Get the monotonic time of the chunk, since the capture start */
+        qint64 getTimestampInNs() const { return _timestampInNs; }
+
+        /** @brief Get the direction of the chunk */
+        SerialCaptureDirection::Enum getDirection() const { return _direction; }
+
+        /** @brief Get the bytes of the chunk */
+        const QByteArray &getData() const { return _data; }
+
+    private:
+        qint64 _timestampInNs{0};
+        SerialCaptureDirection::Enum _direction{SerialCaptureDirection::Unknown};
+        QByteArray _data;
+};
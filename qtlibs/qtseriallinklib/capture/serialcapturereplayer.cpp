@@ -0,0 +1,126 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcapturereplayer.hpp"
+
+#include <QDebug>
+
+#include "capture/serialcapturefilereader.hpp"
+#include "seriallibconstants.hpp"
+
+
+SerialCaptureReplayer::SerialCaptureReplayer(QObject *parent)
+    : QObject{parent}
+{
+    _timer.setSingleShot(true);
+    _timer.setTimerType(Qt::PreciseTimer);
+    connect(&_timer, &QTimer::timeout, this, &SerialCaptureReplayer::onReplayTimeout);
+}
+
+SerialCaptureReplayer::~SerialCaptureReplayer()
+{
+}
+
+bool SerialCaptureReplayer::loadCapture(const QString &filePath,
+                                        SerialCaptureDirection::Enum direction)
+{
+    if(isReplaying())
+    {
+        qWarning() << "Can't load a serial capture while a replay is in progress";
+        return false;
+    }
+
+    SerialCaptureFileReader reader;
+    if(!reader.open(filePath))
+    {
+        return false;
+    }
+
+    QVector<SerialCaptureRecord> records;
+    if(!reader.readAll(records, direction))
+    {
+        qWarning() << "The serial capture file: " << filePath << ", can't be fully read";
+        return false;
+    }
+
+    _records = records;
+    return true;
+}
+
+bool SerialCaptureReplayer::start(double speedFactor)
+{
+    if(isReplaying())
+    {
+        qWarning() << "A serial capture replay is already in progress";
+        return false;
+    }
+
+    if(speedFactor <= 0.0)
+    {
+        qWarning() << "The replay speed factor has to be positive: " << speedFactor;
+        return false;
+    }
+
+    if(_records.isEmpty())
+    {
+        qWarning() << "There is no chunk to replay";
+        return false;
+    }
+
+    _speedFactor = speedFactor;
+    _nextIdx = 0;
+    _elapsedTimer.start();
+    onReplayTimeout();
+    return true;
+}
+
+void SerialCaptureReplayer::stop()
+{
+    if(!isReplaying())
+    {
+        return;
+    }
+
+    _timer.stop();
+    _nextIdx = -1;
+    emit replayFinished(false);
+}
+
+void SerialCaptureReplayer::onReplayTimeout()
+{
+    const qint64 elapsedInNs = _elapsedTimer.nsecsElapsed();
+
+    // The chunks whose time has come are emitted together, a late timer doesn't shift the next
+    // ones
+    while(_nextIdx >= 0 && _nextIdx < _records.length() &&
+          getReplayTimeInNs(_nextIdx) <= elapsedInNs)
+    {
+        emit chunkReplayed(_records.at(_nextIdx).getData());
+        ++_nextIdx;
+    }
+
+    if(_nextIdx < 0)
+    {
+        // The replay has been stopped by a slot connected to chunkReplayed
+        return;
+    }
+
+    if(_nextIdx >= _records.length())
+    {
+        _nextIdx = -1;
+        emit replayFinished(true);
+        return;
+    }
+
+    const qint64 remainingInNs = getReplayTimeInNs(_nextIdx) - _elapsedTimer.nsecsElapsed();
+    const qint64 nsInMs = SerialLibConstants::Time::NsInMs;
+    _timer.start(static_cast<int>(qMax(qint64(0), (remainingInNs + nsInMs - 1) / nsInMs)));
+}
+
+qint64 SerialCaptureReplayer::getReplayTimeInNs(int idx) const
+{
+    const qint64 delayInNs = _records.at(idx).getTimestampInNs() -
+                             _records.first().getTimestampInNs();
+    return static_cast<qint64>(static_cast<double>(delayInNs) / _speedFactor);
+}
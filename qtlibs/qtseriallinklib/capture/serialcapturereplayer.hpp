@@ -0,0 +1,89 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QElapsedTimer>
+#include <QTimer>
+#include <QVector>
+
+#include "definesseriallink.hpp"
+#include "capture/serialcapturedirection.hpp"
+#include "capture/serialcapturerecord.hpp"
+
+
+/** @brief Replay the chunks of a serial capture file, with their original timing
+    @note The chunks are emitted with @ref chunkReplayed; to reproduce offline what a serial link
+          has received, connect the signal to:
+          - @ref SerialLinkIntf::injectReceivedData, the link processes the chunks as if they have
+            been received on its port,
+          - a device which writes on the other side of a pseudo terminal, the link opened on the
+            pseudo terminal receives the chunks through its port.
+    @note The replay is driven by the event loop of the replayer thread */
+class SERIALLINK_EXPORT SerialCaptureReplayer : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit SerialCaptureReplayer(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~SerialCaptureReplayer() override;
+
+    public:
+        /** @brief Load the chunks to replay from a capture file
+            @param filePath The path of the capture file
+            @param direction The direction of the chunks to replay, Rx to replay what the link has
+                             received
+            @return True if no problem occurred */
+        bool loadCapture(const QString &filePath,
+                         SerialCaptureDirection::Enum direction = SerialCaptureDirection::Rx);
+
+        /** @brief Get the number of chunks loaded */
+        int getChunksNb() const { return _records.length(); }
+
+        /** @brief Start to replay the chunks loaded
+            @note The first chunk is emitted at once, the next ones keep their original delay from
+                  the first one, divided by the speed factor
+            @param speedFactor The replay speed, 1.0 to keep the original timing
+            @return True if no problem occurred */
+        bool start(double speedFactor = 1.0);
+
+        /** @brief Stop the current replay
+            @note @ref replayFinished is emitted with completed equals to false */
+        void stop();
+
+        /** @brief Test if a replay is in progress */
+        bool isReplaying() const { return _nextIdx >= 0; }
+
+    signals:
+        /** @brief Emitted when it's time to replay a chunk
+            @param data The bytes of the chunk */
+        void chunkReplayed(const QByteArray &data);
+
+        /** @brief Emitted when the replay ends
+            @param completed True if all the chunks have been replayed */
+        void replayFinished(bool completed);
+
+    private slots:
+        /** @brief Emit the chunks whose time has come and schedule the next one */
+        void onReplayTimeout();
+
+    private:
+        /** @brief Get the replay time of a chunk, since the replay start
+            @param idx The index of the chunk
+            @return The replay time in nanoseconds */
+        qint64 getReplayTimeInNs(int idx) const;
+
+    private:
+        QVector<SerialCaptureRecord> _records;
+        QTimer _timer;
+        QElapsedTimer _elapsedTimer;
+        double _speedFactor{1.0};
+        int _nextIdx{-1};
+};
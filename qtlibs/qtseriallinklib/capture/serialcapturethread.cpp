@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcapturethread.hpp"
+
+#include "definesutility/definesutility.hpp"
+
+#include "capture/serialcapturequeue.hpp"
+#include "capture/serialcapturerecord.hpp"
+
+#include <QDebug>
+#include <QTimer>
+
+
+SerialCaptureThread::SerialCaptureThread(QObject *parent)
+    : BaseThread{parent},
+      _queue{new SerialCaptureQueue()}
+{
+}
+
+SerialCaptureThread::~SerialCaptureThread()
+{
+}
+
+bool SerialCaptureThread::initCapture(const QString &filePath, const QString &portName)
+{
+    RETURN_IF_FALSE(_fileWriter.open(filePath, portName));
+
+    if(!startThreadAndWaitToBeReady())
+    {
+        qWarning() << "The serial capture thread can't be started";
+        _fileWriter.close();
+        return false;
+    }
+
+    return true;
+}
+
+void SerialCaptureThread::run()
+{
+    QTimer drainTimer;
+    connect(&drainTimer, &QTimer::timeout, &drainTimer, [this]() { drainQueue(); });
+    drainTimer.start(DrainPeriodInMs);
+
+    BaseThread::run();
+
+    drainTimer.stop();
+    drainQueue();
+    _fileWriter.close();
+
+    if(_queue->getDroppedChunksNb() > 0)
+    {
+        qWarning() << "The serial capture has dropped: " << _queue->getDroppedChunksNb()
+                   << " chunks, because the capture queue was full";
+    }
+}
+
+void SerialCaptureThread::drainQueue()
+{
+    SerialCaptureRecord record;
+    while(_queue->pop(record))
+    {
+        _fileWriter.write(record);
+    }
+}
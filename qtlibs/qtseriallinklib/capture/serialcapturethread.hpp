@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+#include <QSharedPointer>
+
+#include "capture/serialcapturefilewriter.hpp"
+
+class SerialCaptureQueue;
+
+
+/** @brief This thread writes in a file the chunks captured on a serial link
+    @note The serial link thread pushes the chunks in a @ref SerialCaptureQueue without lock; this
+          thread periodically drains the queue and writes the records in the file. Therefore, the
+          file writing never slows down the serial link.
+    @note When the thread is stopped, the remaining chunks are written and the file is closed */
+class SerialCaptureThread : public BaseThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit SerialCaptureThread(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~SerialCaptureThread() override;
+
+    public:
+        /** @brief Create the capture file and start the thread
+            @param filePath The path of the capture file to create
+            @param portName The name of the captured serial port
+            @return True if no problem occurred */
+        bool initCapture(const QString &filePath, const QString &portName);
+
+        /** @brief Get the queue where the serial link has to push the captured chunks */
+        const QSharedPointer<SerialCaptureQueue> &getQueue() const { return _queue; }
+
+    protected:
+        /** @copydoc BaseThread::run */
+        virtual void run() override;
+
+    private:
+        /** @brief Write all the chunks waiting in the queue */
+        void drainQueue();
+
+    private:
+        /** @brief The period of the queue draining */
+        static const constexpr int DrainPeriodInMs = 20;
+
+    private:
+        QSharedPointer<SerialCaptureQueue> _queue;
+        SerialCaptureFileWriter _fileWriter;
+};
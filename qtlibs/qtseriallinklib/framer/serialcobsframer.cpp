@@ -0,0 +1,115 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialcobsframer.hpp"
+
+
+SerialCobsFramer::SerialCobsFramer(int maxBufferSize)
+    : SerialFramer{maxBufferSize}
+{
+}
+
+SerialCobsFramer::~SerialCobsFramer()
+{
+}
+
+void SerialCobsFramer::reset()
+{
+    SerialFramer::reset();
+    _scanPos = 0;
+}
+
+QByteArray SerialCobsFramer::encode(const QByteArray &payload)
+{
+    QByteArray frame;
+    frame.reserve(payload.length() + (payload.length() / (MaxCode - 1)) + 2);
+
+    // The code byte is written when the block length is known
+    int codeIdx = 0;
+    quint8 code = 1;
+    frame.append(static_cast<char>(Delimiter));
+
+    for(char byte : payload)
+    {
+        if(static_cast<quint8>(byte) != Delimiter)
+        {
+            frame.append(byte);
+            ++code;
+        }
+
+        if(static_cast<quint8>(byte) == Delimiter || code == MaxCode)
+        {
+            frame[codeIdx] = static_cast<char>(code);
+            codeIdx = frame.length();
+            code = 1;
+            frame.append(static_cast<char>(Delimiter));
+        }
+    }
+
+    frame[codeIdx] = static_cast<char>(code);
+    frame.append(static_cast<char>(Delimiter));
+    return frame;
+}
+
+bool SerialCobsFramer::extractFrame(SerialRingBuffer &buffer, QByteArray &frame)
+{
+    while(true)
+    {
+        const int idx = buffer.indexOf(Delimiter, _scanPos);
+
+        if(idx < 0)
+        {
+            _scanPos = buffer.getSize();
+            return false;
+        }
+
+        _scanPos = 0;
+
+        if(idx == 0)
+        {
+            buffer.discard(1);
+            continue;
+        }
+
+        const QByteArray encoded = buffer.read(idx);
+        buffer.discard(1);
+
+        if(!decode(encoded, frame))
+        {
+            frame.clear();
+        }
+
+        return true;
+    }
+}
+
+bool SerialCobsFramer::decode(const QByteArray &encoded, QByteArray &decoded)
+{
+    decoded.clear();
+    decoded.reserve(encoded.length());
+
+    const int length = encoded.length();
+    int idx = 0;
+
+    while(idx < length)
+    {
+        const quint8 code = static_cast<quint8>(encoded.at(idx));
+        const int blockEnd = idx + code;
+
+        if(code == Delimiter || blockEnd > length)
+        {
+            return false;
+        }
+
+        decoded.append(encoded.constData() + idx + 1, code - 1);
+        idx = blockEnd;
+
+        if(code != MaxCode && idx < length)
+        {
+            decoded.append(static_cast<char>(Delimiter));
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,54 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "framer/serialframer.hpp"
+
+
+/** @brief This framer decodes the COBS frames (Consistent Overhead Byte Stuffing)
+    @note Each frame ends with a 0x00 byte, the encoded payload doesn't contain any 0x00 byte. The
+          frames which can't be decoded are invalid.
+    @note The empty frames, between two consecutive 0x00 bytes, are ignored */
+class SERIALLINK_EXPORT SerialCobsFramer : public SerialFramer
+{
+    public:
+        /** @brief Class constructor
+            @param maxBufferSize The max number of bytes waiting to be framed */
+        explicit SerialCobsFramer(int maxBufferSize = SerialRingBuffer::DefaultMaxCapacity);
+
+        /** @brief Class destructor */
+        virtual ~SerialCobsFramer() override;
+
+    public:
+        /** @copydoc SerialFramer::reset */
+        virtual void reset() override;
+
+        /** @brief Build a COBS frame to send, with its ending 0x00 byte
+            @param payload The payload to send, with its CRC if one is expected
+            @return The frame built */
+        static QByteArray encode(const QByteArray &payload);
+
+    protected:
+        /** @copydoc SerialFramer::extractFrame */
+        virtual bool extractFrame(SerialRingBuffer &buffer, QByteArray &frame) override;
+
+    private:
+        /** @brief Decode a COBS frame
+            @param encoded The frame without its ending 0x00 byte
+            @param decoded The decoded frame
+            @return True if no problem occurred */
+        static bool decode(const QByteArray &encoded, QByteArray &decoded);
+
+    private:
+        /** @brief The byte which ends a frame */
+        static const constexpr quint8 Delimiter = 0x00;
+
+        /** @brief The max value of a code byte, it's followed by 254 non-zero bytes and isn't
+                   followed by a zero */
+        static const constexpr quint8 MaxCode = 0xFF;
+
+    private:
+        int _scanPos{0};
+};
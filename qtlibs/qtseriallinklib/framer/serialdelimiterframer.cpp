@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialdelimiterframer.hpp"
+
+
+SerialDelimiterFramer::SerialDelimiterFramer(const QByteArray &delimiter,
+                                             bool keepDelimiter,
+                                             int maxBufferSize)
+    : SerialFramer{maxBufferSize},
+    _delimiter{delimiter},
+    _keepDelimiter{keepDelimiter}
+{
+}
+
+SerialDelimiterFramer::~SerialDelimiterFramer()
+{
+}
+
+void SerialDelimiterFramer::reset()
+{
+    SerialFramer::reset();
+    _scanPos = 0;
+}
+
+bool SerialDelimiterFramer::extractFrame(SerialRingBuffer &buffer, QByteArray &frame)
+{
+    const int delimiterLength = _delimiter.length();
+
+    while(true)
+    {
+        const int idx = buffer.indexOf(_delimiter, _scanPos);
+
+        if(idx < 0)
+        {
+            // The last bytes may be the beginning of a delimiter, they are scanned again with the
+            // next received bytes
+            _scanPos = qMax(0, buffer.getSize() - delimiterLength + 1);
+            return false;
+        }
+
+        _scanPos = 0;
+
+        if(idx == 0)
+        {
+            buffer.discard(delimiterLength);
+            continue;
+        }
+
+        if(_keepDelimiter)
+        {
+            frame = buffer.read(idx + delimiterLength);
+        }
+        else
+        {
+            frame = buffer.read(idx);
+            buffer.discard(delimiterLength);
+        }
+
+        return true;
+    }
+}
@@ -0,0 +1,41 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "framer/serialframer.hpp"
+
+
+/** @brief This framer cuts the received bytes on a delimiter, for instance: "\r\n"
+    @note The empty frames, between two consecutive delimiters, are ignored */
+class SERIALLINK_EXPORT SerialDelimiterFramer : public SerialFramer
+{
+    public:
+        /** @brief Class constructor
+            @param delimiter The bytes sequence which ends each frame
+            @param keepDelimiter True to keep the delimiter at the end of the extracted frames
+            @param maxBufferSize The max number of bytes waiting to be framed */
+        explicit SerialDelimiterFramer(const QByteArray &delimiter,
+                                       bool keepDelimiter = false,
+                                       int maxBufferSize = SerialRingBuffer::DefaultMaxCapacity);
+
+        /** @brief Class destructor */
+        virtual ~SerialDelimiterFramer() override;
+
+    public:
+        /** @copydoc SerialFramer::isValid */
+        virtual bool isValid() const override { return !_delimiter.isEmpty(); }
+
+        /** @copydoc SerialFramer::reset */
+        virtual void reset() override;
+
+    protected:
+        /** @copydoc SerialFramer::extractFrame */
+        virtual bool extractFrame(SerialRingBuffer &buffer, QByteArray &frame) override;
+
+    private:
+        QByteArray _delimiter;
+        bool _keepDelimiter;
+        int _scanPos{0};
+};
@@ -0,0 +1,27 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialfixedlengthframer.hpp"
+
+
+SerialFixedLengthFramer::SerialFixedLengthFramer(int frameLength, int maxBufferSize)
+    : SerialFramer{maxBufferSize},
+    _frameLength{frameLength}
+{
+}
+
+SerialFixedLengthFramer::~SerialFixedLengthFramer()
+{
+}
+
+bool SerialFixedLengthFramer::extractFrame(SerialRingBuffer &buffer, QByteArray &frame)
+{
+    if(_frameLength <= 0 || buffer.getSize() < _frameLength)
+    {
+        return false;
+    }
+
+    frame = buffer.read(_frameLength);
+    return true;
+}
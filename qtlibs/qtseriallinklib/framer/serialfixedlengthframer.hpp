@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "framer/serialframer.hpp"
+
+
+/** @brief This framer cuts the received bytes in frames of a fixed length
+    @note If a CRC is checked, it's contained in the frame length */
+class SERIALLINK_EXPORT SerialFixedLengthFramer : public SerialFramer
+{
+    public:
+        /** @brief Class constructor
+            @param frameLength The length of each frame
+            @param maxBufferSize The max number of bytes waiting to be framed */
+        explicit SerialFixedLengthFramer(int frameLength,
+                                         int maxBufferSize = SerialRingBuffer::DefaultMaxCapacity);
+
+        /** @brief Class destructor */
+        virtual ~SerialFixedLengthFramer() override;
+
+    public:
+        /** @copydoc SerialFramer::isValid */
+        virtual bool isValid() const override { return _frameLength > 0; }
+
+    protected:
+        /** @copydoc SerialFramer::extractFrame */
+        virtual bool extractFrame(SerialRingBuffer &buffer, QByteArray &frame) override;
+
+    private:
+        int _frameLength;
+};
@@ -0,0 +1,48 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialframecrctype.hpp"
+
+#include <QMetaEnum>
+
+
+int SerialFrameCrcType::getSize(Enum value)
+{
+    switch(value)
+    {
+        case Crc16Mcrf4xx:
+            return Crc16Size;
+
+        case Crc32:
+            return Crc32Size;
+
+        case None:
+        case Unknown:
+            break;
+    }
+
+    return 0;
+}
+
+QString SerialFrameCrcType::toString(Enum value)
+{
+    return QString::fromLatin1(QMetaEnum::fromType<Enum>().valueToKey(value)).toLower();
+}
+
+SerialFrameCrcType::Enum SerialFrameCrcType::parseFromString(const QString &value)
+{
+    QMetaEnum metaEnum = QMetaEnum::fromType<Enum>();
+
+    for(int idx = 0; idx < metaEnum.keyCount(); idx++)
+    {
+        QString strValue(metaEnum.key(idx));
+
+        if(strValue.toLower() == value.toLower())
+        {
+            return static_cast<Enum>(metaEnum.value(idx));
+        }
+    }
+
+    return Unknown;
+}
@@ -0,0 +1,50 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief The CRC which can be checked at the end of the frames extracted by a
+           @ref SerialFramer */
+class SERIALLINK_EXPORT SerialFrameCrcType : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The CRC types */
+        enum Enum {
+            None,           //!< @brief There is no CRC at the end of the frames
+            Crc16Mcrf4xx,   //!< @brief The 16 bits CRC MCRF4XX
+            Crc32,          //!< @brief The 32 bits CRC of IEEE 802.3
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get the number of bytes of the CRC
+            @param value The CRC type
+            @return The CRC size, 0 if there is no CRC */
+        static int getSize(Enum value);
+
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+
+        /** @brief Parse the enum from its string representation
+            @param value The string to parse
+            @return The enum parsed, this returns Unknown if no match has been found */
+        static Enum parseFromString(const QString &value);
+
+    private:
+        /** @brief The number of bytes of a 16 bits CRC */
+        static const constexpr int Crc16Size = 2;
+
+        /** @brief The number of bytes of a 32 bits CRC */
+        static const constexpr int Crc32Size = 4;
+};
@@ -0,0 +1,127 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialframer.hpp"
+
+#include <QDebug>
+
+#include "crcutility/crchelper.hpp"
+
+
+SerialFramer::SerialFramer(int maxBufferSize)
+    : _buffer{maxBufferSize}
+{
+}
+
+SerialFramer::~SerialFramer()
+{
+}
+
+void SerialFramer::setCrcCheck(SerialFrameCrcType::Enum crcType, bool crcLittleEndian)
+{
+    _crcType = (crcType == SerialFrameCrcType::Unknown) ? SerialFrameCrcType::None : crcType;
+    _crcLittleEndian = crcLittleEndian;
+}
+
+void SerialFramer::appendCrc(QByteArray &payload) const
+{
+    const int crcSize = SerialFrameCrcType::getSize(_crcType);
+    const quint32 crc = calculateCrc(payload);
+
+    for(int idx = 0; idx < crcSize; ++idx)
+    {
+        const int byteIdx = _crcLittleEndian ? idx : (crcSize - 1 - idx);
+        payload.append(static_cast<char>((crc >> (byteIdx * BitsInByte)) & ByteMask));
+    }
+}
+
+bool SerialFramer::processData(const QByteArray &data, QVector<QByteArray> &frames)
+{
+    bool success = true;
+
+    if(!_buffer.append(data))
+    {
+        qWarning() << "The serial framer buffer has overflowed, the: " << _buffer.getSize()
+                   << " bytes waiting to be framed are dropped";
+        addDroppedBytes(_buffer.getSize());
+        reset();
+        success = false;
+
+        if(!_buffer.append(data))
+        {
+            // The data alone is bigger than the buffer
+            addDroppedBytes(data.length());
+            return false;
+        }
+    }
+
+    QByteArray frame;
+    while(extractFrame(_buffer, frame))
+    {
+        if(frame.isEmpty() || !checkAndRemoveCrc(frame))
+        {
+            ++_invalidFramesNb;
+            continue;
+        }
+
+        ++_framesNb;
+        frames.append(frame);
+    }
+
+    return success;
+}
+
+void SerialFramer::reset()
+{
+    _buffer.clear();
+}
+
+quint32 SerialFramer::calculateCrc(const QByteArray &data) const
+{
+    switch(_crcType)
+    {
+        case SerialFrameCrcType::Crc16Mcrf4xx:
+            return CrcHelper::calculateCrcMcrf4xx(data);
+
+        case SerialFrameCrcType::Crc32:
+            return CrcHelper::calculateCrc32(data,
+                                             CrcConstants::Crc32::reversedPolynom,
+                                             CrcConstants::Crc32::reversedInit);
+
+        case SerialFrameCrcType::None:
+        case SerialFrameCrcType::Unknown:
+            break;
+    }
+
+    return 0;
+}
+
+bool SerialFramer::checkAndRemoveCrc(QByteArray &frame) const
+{
+    const int crcSize = SerialFrameCrcType::getSize(_crcType);
+
+    if(crcSize == 0)
+    {
+        return true;
+    }
+
+    if(frame.length() <= crcSize)
+    {
+        return false;
+    }
+
+    const int payloadSize = frame.length() - crcSize;
+
+    quint32 receivedCrc = 0;
+    for(int idx = 0; idx < crcSize; ++idx)
+    {
+        const int byteIdx = _crcLittleEndian ? idx : (crcSize - 1 - idx);
+        receivedCrc |= (static_cast<quint32>(static_cast<quint8>(frame.at(payloadSize + idx))) <<
+                        (byteIdx * BitsInByte));
+    }
+
+    frame.truncate(payloadSize);
+
+    return (calculateCrc(frame) == receivedCrc);
+}
@@ -0,0 +1,114 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+#include <QVector>
+
+#include "definesseriallink.hpp"
+#include "framer/serialframecrctype.hpp"
+#include "framer/serialringbuffer.hpp"
+
+
+/** @brief This is the base class of the serial framers: a framer cuts the bytes received on a
+           serial link into complete frames
+    @note The received bytes are stored in a @ref SerialRingBuffer until they contain complete
+          frames. The derived classes remember where they stopped searching, in order to not scan
+          the same bytes again when new bytes are received: the framing cost only depends of the
+          number of received bytes.
+    @note A CRC can be checked at the end of each extracted frame. The frames with a wrong CRC are
+          dropped and the CRC bytes are removed from the valid frames.
+    @note Once given to a serial link, the framer is only used in the serial link thread */
+class SERIALLINK_EXPORT SerialFramer
+{
+    public:
+        /** @brief Class constructor
+            @param maxBufferSize The max number of bytes waiting to be framed, when it's reached
+                                 the waiting bytes are dropped */
+        explicit SerialFramer(int maxBufferSize = SerialRingBuffer::DefaultMaxCapacity);
+
+        /** @brief Class destructor */
+        virtual ~SerialFramer();
+
+    public:
+        /** @brief Test if the framer configuration is valid */
+        virtual bool isValid() const { return true; }
+
+        /** @brief Set the CRC to check at the end of each frame
+            @param crcType The CRC type, None to not check any CRC
+            @param crcLittleEndian True if the CRC is written in little endian at the end of the
+                                   frames */
+        void setCrcCheck(SerialFrameCrcType::Enum crcType, bool crcLittleEndian = true);
+
+        /** @brief Get the CRC type checked at the end of each frame */
+        SerialFrameCrcType::Enum getCrcType() const { return _crcType; }
+
+        /** @brief Append the configured CRC at the end of the payload given
+            @note This is useful to build the frames to send
+            @param payload The payload to complete */
+        void appendCrc(QByteArray &payload) const;
+
+        /** @brief Add received bytes and extract all the complete frames they contain
+            @param data The bytes received
+            @param frames The complete frames extracted are appended to this vector
+            @return False if the received bytes overflowed the buffer, in that case, the bytes
+                    waiting to be framed have been dropped */
+        bool processData(const QByteArray &data, QVector<QByteArray> &frames);
+
+        /** @brief Drop all the bytes waiting to be framed and reset the framing state */
+        virtual void reset();
+
+        /** @brief Get the number of valid frames extracted */
+        quint64 getFramesNb() const { return _framesNb; }
+
+        /** @brief Get the number of invalid frames dropped (wrong encoding, length or CRC) */
+        quint64 getInvalidFramesNb() const { return _invalidFramesNb; }
+
+        /** @brief Get the number of bytes dropped, because they weren't part of a frame or the
+                   buffer overflowed */
+        quint64 getDroppedBytesNb() const { return _droppedBytesNb; }
+
+    protected:
+        /** @brief Extract the first complete frame of the buffer
+            @note The method removes the frame bytes from the buffer; it also removes the bytes
+                  which can't be part of a frame
+            @param buffer The buffer containing the bytes waiting to be framed
+            @param frame The frame extracted, with its CRC if one is configured. If the frame is
+                         empty but the method returns true, the frame is considered as invalid
+            @return True if a frame has been extracted, false if the buffer doesn't contain a
+                    complete frame yet */
+        virtual bool extractFrame(SerialRingBuffer &buffer, QByteArray &frame) = 0;
+
+        /** @brief Count bytes dropped by the derived classes
+            @param bytesNb The number of dropped bytes */
+        void addDroppedBytes(int bytesNb) { _droppedBytesNb += static_cast<quint64>(bytesNb); }
+
+    private:
+        /** @brief Calculate the configured CRC of the data given
+            @param data The data to calculate the CRC from
+            @return The CRC calculated */
+        quint32 calculateCrc(const QByteArray &data) const;
+
+        /** @brief Check and remove the CRC at the end of the frame given
+            @param frame The frame to check
+            @return True if the CRC is valid */
+        bool checkAndRemoveCrc(QByteArray &frame) const;
+
+    private:
+        /** @brief The number of bits in a byte */
+        static const constexpr int BitsInByte = 8;
+
+        /** @brief The mask of a byte */
+        static const constexpr quint32 ByteMask = 0xFF;
+
+    private:
+        SerialRingBuffer _buffer;
+        SerialFrameCrcType::Enum _crcType{SerialFrameCrcType::None};
+        bool _crcLittleEndian{true};
+
+        quint64 _framesNb{0};
+        quint64 _invalidFramesNb{0};
+        quint64 _droppedBytesNb{0};
+};
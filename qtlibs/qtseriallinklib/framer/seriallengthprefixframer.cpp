@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "seriallengthprefixframer.hpp"
+
+
+SerialLengthPrefixFramer::SerialLengthPrefixFramer(int prefixSize,
+                                                   bool littleEndian,
+                                                   int lengthAdjustment,
+                                                   bool keepPrefix,
+                                                   int maxPayloadSize,
+                                                   int maxBufferSize)
+    : SerialFramer{maxBufferSize},
+    _prefixSize{prefixSize},
+    _littleEndian{littleEndian},
+    _lengthAdjustment{lengthAdjustment},
+    _keepPrefix{keepPrefix},
+    _maxPayloadSize{maxPayloadSize}
+{
+}
+
+SerialLengthPrefixFramer::~SerialLengthPrefixFramer()
+{
+}
+
+bool SerialLengthPrefixFramer::isValid() const
+{
+    return (_prefixSize == 1 || _prefixSize == 2 || _prefixSize == 4) && _maxPayloadSize > 0;
+}
+
+QByteArray SerialLengthPrefixFramer::encode(const QByteArray &payload) const
+{
+    const quint32 prefixValue = static_cast<quint32>(payload.length() - _lengthAdjustment);
+
+    QByteArray frame;
+    frame.reserve(_prefixSize + payload.length());
+
+    for(int idx = 0; idx < _prefixSize; ++idx)
+    {
+        const int byteIdx = _littleEndian ? idx : (_prefixSize - 1 - idx);
+        frame.append(static_cast<char>((prefixValue >> (byteIdx * BitsInByte)) & ByteMask));
+    }
+
+    frame.append(payload);
+    return frame;
+}
+
+bool SerialLengthPrefixFramer::extractFrame(SerialRingBuffer &buffer, QByteArray &frame)
+{
+    if(!isValid())
+    {
+        return false;
+    }
+
+    while(buffer.getSize() >= _prefixSize)
+    {
+        quint32 prefixValue = 0;
+        for(int idx = 0; idx < _prefixSize; ++idx)
+        {
+            const int byteIdx = _littleEndian ? idx : (_prefixSize - 1 - idx);
+            prefixValue |= (static_cast<quint32>(buffer.at(idx)) << (byteIdx * BitsInByte));
+        }
+
+        const qint64 payloadLength = static_cast<qint64>(prefixValue) + _lengthAdjustment;
+
+        if(payloadLength < 0 || payloadLength > _maxPayloadSize)
+        {
+            // The prefix isn't valid, we try to resynchronize on the next byte
+            buffer.discard(1);
+            addDroppedBytes(1);
+            continue;
+        }
+
+        const int frameLength = _prefixSize + static_cast<int>(payloadLength);
+
+        if(buffer.getSize() < frameLength)
+        {
+            return false;
+        }
+
+        if(payloadLength == 0 && !_keepPrefix)
+        {
+            // There is nothing to give
+            buffer.discard(_prefixSize);
+            continue;
+        }
+
+        if(_keepPrefix)
+        {
+            frame = buffer.read(frameLength);
+        }
+        else
+        {
+            buffer.discard(_prefixSize);
+            frame = buffer.read(static_cast<int>(payloadLength));
+        }
+
+        return true;
+    }
+
+    return false;
+}
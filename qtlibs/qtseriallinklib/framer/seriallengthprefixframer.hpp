@@ -0,0 +1,69 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "framer/serialframer.hpp"
+
+
+/** @brief This framer extracts frames which begin with their length
+    @note The length prefix is written on 1, 2 or 4 bytes, in little or big endian. The payload
+          length is equal to: prefix value + length adjustment; the adjustment is useful when the
+          prefix value also counts the prefix bytes or the CRC.
+    @note When the payload length read isn't valid, the first byte is dropped and the framer
+          tries to resynchronize on the next one
+    @note If a CRC is checked, it's contained in the payload */
+class SERIALLINK_EXPORT SerialLengthPrefixFramer : public SerialFramer
+{
+    public:
+        /** @brief Class constructor
+            @param prefixSize The number of bytes of the length prefix: 1, 2 or 4
+            @param littleEndian True if the prefix is written in little endian
+            @param lengthAdjustment The value to add to the prefix value to get the payload
+                                    length
+            @param keepPrefix True to keep the length prefix in the extracted frames
+            @param maxPayloadSize The max length of a payload, a longer one is considered as
+                                  invalid
+            @param maxBufferSize The max number of bytes waiting to be framed */
+        explicit SerialLengthPrefixFramer(int prefixSize,
+                                          bool littleEndian = false,
+                                          int lengthAdjustment = 0,
+                                          bool keepPrefix = false,
+                                          int maxPayloadSize = DefaultMaxPayloadSize,
+                                          int maxBufferSize = SerialRingBuffer::DefaultMaxCapacity);
+
+        /** @brief Class destructor */
+        virtual ~SerialLengthPrefixFramer() override;
+
+    public:
+        /** @copydoc SerialFramer::isValid */
+        virtual bool isValid() const override;
+
+        /** @brief Build a frame to send, by adding the length prefix before the payload
+            @param payload The payload to send, with its CRC if one is expected
+            @return The frame built */
+        QByteArray encode(const QByteArray &payload) const;
+
+    protected:
+        /** @copydoc SerialFramer::extractFrame */
+        virtual bool extractFrame(SerialRingBuffer &buffer, QByteArray &frame) override;
+
+    public:
+        /** @brief The default max length of a payload */
+        static const constexpr int DefaultMaxPayloadSize = 64 * 1024;
+
+    private:
+        /** @brief The number of bits in a byte */
+        static const constexpr int BitsInByte = 8;
+
+        /** @brief The mask of a byte */
+        static const constexpr quint32 ByteMask = 0xFF;
+
+    private:
+        int _prefixSize;
+        bool _littleEndian;
+        int _lengthAdjustment;
+        bool _keepPrefix;
+        int _maxPayloadSize;
+};
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialringbuffer.hpp"
+
+#include <cstring>
+
+
+SerialRingBuffer::SerialRingBuffer(int maxCapacity)
+    : _maxCapacity{toPowerOfTwo(qMax(maxCapacity, 1))}
+{
+}
+
+bool SerialRingBuffer::append(const QByteArray &data)
+{
+    const int length = data.length();
+
+    if(length == 0)
+    {
+        return true;
+    }
+
+    if(length > (_maxCapacity - _size))
+    {
+        return false;
+    }
+
+    if((_size + length) > _buffer.length())
+    {
+        grow(_size + length);
+    }
+
+    const int capacity = _buffer.length();
+    const int tail = (_head + _size) & _mask;
+    const int firstPartLength = qMin(length, capacity - tail);
+
+    char *buffer = _buffer.data();
+    memcpy(buffer + tail, data.constData(), static_cast<size_t>(firstPartLength));
+    memcpy(buffer,
+           data.constData() + firstPartLength,
+           static_cast<size_t>(length - firstPartLength));
+
+    _size += length;
+    return true;
+}
+
+int SerialRingBuffer::indexOf(quint8 byte, int from) const
+{
+    if(from < 0 || from >= _size)
+    {
+        return -1;
+    }
+
+    const int capacity = _buffer.length();
+    const int start = (_head + from) & _mask;
+    const int remaining = _size - from;
+    const int firstPartLength = qMin(remaining, capacity - start);
+    const char *buffer = _buffer.constData();
+
+    const void *found = memchr(buffer + start, byte, static_cast<size_t>(firstPartLength));
+    if(found != nullptr)
+    {
+        return from + static_cast<int>(static_cast<const char *>(found) - (buffer + start));
+    }
+
+    found = memchr(buffer, byte, static_cast<size_t>(remaining - firstPartLength));
+    if(found != nullptr)
+    {
+        return from + firstPartLength + static_cast<int>(static_cast<const char *>(found) - buffer);
+    }
+
+    return -1;
+}
+
+int SerialRingBuffer::indexOf(const QByteArray &pattern, int from) const
+{
+    if(pattern.isEmpty())
+    {
+        return -1;
+    }
+
+    const quint8 firstByte = static_cast<quint8>(pattern.at(0));
+    const int patternLength = pattern.length();
+
+    int idx = indexOf(firstByte, from);
+    while(idx >= 0 && (idx + patternLength) <= _size)
+    {
+        int patternIdx = 1;
+        while(patternIdx < patternLength &&
+              at(idx + patternIdx) == static_cast<quint8>(pattern.at(patternIdx)))
+        {
+            ++patternIdx;
+        }
+
+        if(patternIdx == patternLength)
+        {
+            return idx;
+        }
+
+        idx = indexOf(firstByte, idx + 1);
+    }
+
+    return -1;
+}
+
+QByteArray SerialRingBuffer::peek(int length) const
+{
+    const int peekLength = qBound(0, length, _size);
+
+    QByteArray data(peekLength, Qt::Uninitialized);
+
+    const int capacity = _buffer.length();
+    const int firstPartLength = qMin(peekLength, capacity - _head);
+    const char *buffer = _buffer.constData();
+
+    memcpy(data.data(), buffer + _head, static_cast<size_t>(firstPartLength));
+    memcpy(data.data() + firstPartLength,
+           buffer,
+           static_cast<size_t>(peekLength - firstPartLength));
+
+    return data;
+}
+
+QByteArray SerialRingBuffer::read(int length)
+{
+    const QByteArray data = peek(length);
+    discard(data.length());
+    return data;
+}
+
+void SerialRingBuffer::discard(int length)
+{
+    const int discardLength = qBound(0, length, _size);
+
+    _size -= discardLength;
+
+    if(_size == 0)
+    {
+        // Restart from the buffer beginning to keep the next bytes contiguous
+        _head = 0;
+        return;
+    }
+
+    _head = (_head + discardLength) & _mask;
+}
+
+void SerialRingBuffer::clear()
+{
+    _head = 0;
+    _size = 0;
+}
+
+void SerialRingBuffer::grow(int minCapacity)
+{
+    const int capacity = qMin(_maxCapacity, qMax(InitialCapacity, toPowerOfTwo(minCapacity)));
+
+    QByteArray buffer = peek(_size);
+    buffer.resize(capacity);
+
+    _buffer = buffer;
+    _mask = capacity - 1;
+    _head = 0;
+}
+
+int SerialRingBuffer::toPowerOfTwo(int value)
+{
+    int powerOfTwo = 1;
+    while(powerOfTwo < value)
+    {
+        powerOfTwo <<= 1;
+    }
+
+    return powerOfTwo;
+}
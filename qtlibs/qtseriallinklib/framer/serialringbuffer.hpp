@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+
+
+/** @brief This is a bytes ring buffer, used by the serial framers to store the received bytes
+           until they contain complete frames
+    @note The memory is reused between the readings: the bytes aren't moved when the first ones
+          are consumed. The capacity is a power of two and grows, when needed, until the max
+          capacity given.
+    @note The class isn't threadsafe, it's only used in the serial link thread */
+class SerialRingBuffer
+{
+    public:
+        /** @brief Class constructor
+            @param maxCapacity The max number of bytes the buffer can contain, it's rounded up to
+                               the next power of two */
+        explicit SerialRingBuffer(int maxCapacity = DefaultMaxCapacity);
+
+    public:
+        /** @brief Get the number of bytes stored in the buffer */
+        int getSize() const { return _size; }
+
+        /** @brief Test if the buffer is empty */
+        bool isEmpty() const { return _size == 0; }
+
+        /** @brief Get the max number of bytes the buffer can contain */
+        int getMaxCapacity() const { return _maxCapacity; }
+
+        /** @brief Get the byte at the index given
+            @warning The index isn't tested, it has to be lower than @ref getSize
+            @param idx The byte index, 0 is the oldest byte of the buffer */
+        quint8 at(int idx) const
+        {
+            return static_cast<quint8>(_buffer.at((_head + idx) & _mask));
+        }
+
+        /** @brief Append bytes at the end of the buffer
+            @param data The bytes to append
+            @return False if there isn't enough room in the buffer, in that case nothing is
+                    appended */
+        bool append(const QByteArray &data);
+
+        /** @brief Find the first occurrence of a byte in the buffer
+            @param byte The byte to find
+            @param from The index where the search starts
+            @return The index of the byte found or -1 if it hasn't been found */
+        int indexOf(quint8 byte, int from = 0) const;
+
+        /** @brief Find the first occurrence of a bytes sequence in the buffer
+            @param pattern The bytes sequence to find
+            @param from The index where the search starts
+            @return The index of the sequence found or -1 if it hasn't been found */
+        int indexOf(const QByteArray &pattern, int from = 0) const;
+
+        /** @brief Copy the oldest bytes of the buffer, without removing them
+            @param length The number of bytes to copy, it's limited to the buffer size
+            @return The bytes copied */
+        QByteArray peek(int length) const;
+
+        /** @brief Copy and remove the oldest bytes of the buffer
+            @param length The number of bytes to read, it's limited to the buffer size
+            @return The bytes read */
+        QByteArray read(int length);
+
+        /** @brief Remove the oldest bytes of the buffer
+            @param length The number of bytes to remove, it's limited to the buffer size */
+        void discard(int length);
+
+        /** @brief Remove all the bytes of the buffer
+            @note The memory allocated is kept */
+        void clear();
+
+    private:
+        /** @brief Grow the buffer to contain at least the number of bytes given
+            @param minCapacity The min capacity needed */
+        void grow(int minCapacity);
+
+        /** @brief Round up the value to the next power of two
+            @param value The value to round
+            @return The power of two */
+        static int toPowerOfTwo(int value);
+
+    public:
+        /** @brief The default max capacity of the buffer */
+        static const constexpr int DefaultMaxCapacity = 1024 * 1024;
+
+    private:
+        /** @brief The capacity of the buffer when the first bytes are appended */
+        static const constexpr int InitialCapacity = 1024;
+
+    private:
+        int _maxCapacity;
+        QByteArray _buffer;
+        int _mask{0};
+        int _head{0};
+        int _size{0};
+};
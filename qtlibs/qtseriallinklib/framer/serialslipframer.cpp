@@ -0,0 +1,124 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialslipframer.hpp"
+
+
+SerialSlipFramer::SerialSlipFramer(int maxBufferSize)
+    : SerialFramer{maxBufferSize}
+{
+}
+
+SerialSlipFramer::~SerialSlipFramer()
+{
+}
+
+void SerialSlipFramer::reset()
+{
+    SerialFramer::reset();
+    _scanPos = 0;
+}
+
+QByteArray SerialSlipFramer::encode(const QByteArray &payload)
+{
+    QByteArray frame;
+    frame.reserve((payload.length() * 2) + 2);
+
+    frame.append(static_cast<char>(End));
+
+    for(char byte : payload)
+    {
+        const quint8 value = static_cast<quint8>(byte);
+
+        if(value == End)
+        {
+            frame.append(static_cast<char>(Esc));
+            frame.append(static_cast<char>(EscEnd));
+        }
+        else if(value == Esc)
+        {
+            frame.append(static_cast<char>(Esc));
+            frame.append(static_cast<char>(EscEsc));
+        }
+        else
+        {
+            frame.append(byte);
+        }
+    }
+
+    frame.append(static_cast<char>(End));
+    return frame;
+}
+
+bool SerialSlipFramer::extractFrame(SerialRingBuffer &buffer, QByteArray &frame)
+{
+    while(true)
+    {
+        const int idx = buffer.indexOf(End, _scanPos);
+
+        if(idx < 0)
+        {
+            _scanPos = buffer.getSize();
+            return false;
+        }
+
+        _scanPos = 0;
+
+        if(idx == 0)
+        {
+            buffer.discard(1);
+            continue;
+        }
+
+        const QByteArray encoded = buffer.read(idx);
+        buffer.discard(1);
+
+        if(!decode(encoded, frame))
+        {
+            frame.clear();
+        }
+
+        return true;
+    }
+}
+
+bool SerialSlipFramer::decode(const QByteArray &encoded, QByteArray &decoded)
+{
+    decoded.clear();
+    decoded.reserve(encoded.length());
+
+    const int length = encoded.length();
+    for(int idx = 0; idx < length; ++idx)
+    {
+        const quint8 value = static_cast<quint8>(encoded.at(idx));
+
+        if(value != Esc)
+        {
+            decoded.append(static_cast<char>(value));
+            continue;
+        }
+
+        ++idx;
+        if(idx >= length)
+        {
+            return false;
+        }
+
+        const quint8 escaped = static_cast<quint8>(encoded.at(idx));
+        if(escaped == EscEnd)
+        {
+            decoded.append(static_cast<char>(End));
+        }
+        else if(escaped == EscEsc)
+        {
+            decoded.append(static_cast<char>(Esc));
+        }
+        else
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "framer/serialframer.hpp"
+
+
+/** @brief This framer decodes the SLIP frames (RFC 1055)
+    @note Each frame ends with an END byte, the END and ESC bytes contained in the payload are
+          escaped. The frames with a wrong escape sequence are invalid.
+    @note The empty frames, between two consecutive END bytes, are ignored */
+class SERIALLINK_EXPORT SerialSlipFramer : public SerialFramer
+{
+    public:
+        /** @brief Class constructor
+            @param maxBufferSize The max number of bytes waiting to be framed */
+        explicit SerialSlipFramer(int maxBufferSize = SerialRingBuffer::DefaultMaxCapacity);
+
+        /** @brief Class destructor */
+        virtual ~SerialSlipFramer() override;
+
+    public:
+        /** @copydoc SerialFramer::reset */
+        virtual void reset() override;
+
+        /** @brief Build a SLIP frame to send
+            @note An END byte is also added at the beginning of the frame, to flush the noise the
+                  receiver may have got
+            @param payload The payload to send, with its CRC if one is expected
+            @return The frame built */
+        static QByteArray encode(const QByteArray &payload);
+
+    protected:
+        /** @copydoc SerialFramer::extractFrame */
+        virtual bool extractFrame(SerialRingBuffer &buffer, QByteArray &frame) override;
+
+    private:
+        /** @brief Decode the escaped bytes of a SLIP frame
+            @param encoded The frame without its END byte
+            @param decoded The decoded frame
+            @return True if no problem occurred */
+        static bool decode(const QByteArray &encoded, QByteArray &decoded);
+
+    private:
+        /** @brief The byte which ends a frame */
+        static const constexpr quint8 End = 0xC0;
+
+        /** @brief The byte which begins an escape sequence */
+        static const constexpr quint8 Esc = 0xDB;
+
+        /** @brief The escaped value of the END byte */
+        static const constexpr quint8 EscEnd = 0xDC;
+
+        /** @brief The escaped value of the ESC byte */
+        static const constexpr quint8 EscEsc = 0xDD;
+
+    private:
+        int _scanPos{0};
+};
@@ -41,7 +41,50 @@ INCLUDEPATH *= $$LIB_PATH
 INCLUDEPATH *= $$QT_UTILITIES
 INCLUDEPATH *= $$ROOT
 
+HEADERS *= $$LIB_PATH/capture/serialcapturedirection.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturedirection.cpp
+HEADERS *= $$LIB_PATH/capture/serialcapturefilereader.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturefilereader.cpp
+HEADERS *= $$LIB_PATH/capture/serialcapturefilewriter.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturefilewriter.cpp
+HEADERS *= $$LIB_PATH/capture/serialcaptureformat.hpp
+HEADERS *= $$LIB_PATH/capture/serialcapturequeue.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturequeue.cpp
+HEADERS *= $$LIB_PATH/capture/serialcapturerecord.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturerecord.cpp
+HEADERS *= $$LIB_PATH/capture/serialcapturereplayer.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturereplayer.cpp
+HEADERS *= $$LIB_PATH/capture/serialcapturethread.hpp
+SOURCES *= $$LIB_PATH/capture/serialcapturethread.cpp
 HEADERS *= $$LIB_PATH/definesseriallink.hpp
+HEADERS *= $$LIB_PATH/framer/serialcobsframer.hpp
+SOURCES *= $$LIB_PATH/framer/serialcobsframer.cpp
+HEADERS *= $$LIB_PATH/framer/serialdelimiterframer.hpp
+SOURCES *= $$LIB_PATH/framer/serialdelimiterframer.cpp
+HEADERS *= $$LIB_PATH/framer/serialfixedlengthframer.hpp
+SOURCES *= $$LIB_PATH/framer/serialfixedlengthframer.cpp
+HEADERS *= $$LIB_PATH/framer/serialframecrctype.hpp
+SOURCES *= $$LIB_PATH/framer/serialframecrctype.cpp
+HEADERS *= $$LIB_PATH/framer/serialframer.hpp
+SOURCES *= $$LIB_PATH/framer/serialframer.cpp
+HEADERS *= $$LIB_PATH/framer/seriallengthprefixframer.hpp
+SOURCES *= $$LIB_PATH/framer/seriallengthprefixframer.cpp
+HEADERS *= $$LIB_PATH/framer/serialringbuffer.hpp
+SOURCES *= $$LIB_PATH/framer/serialringbuffer.cpp
+HEADERS *= $$LIB_PATH/framer/serialslipframer.hpp
+SOURCES *= $$LIB_PATH/framer/serialslipframer.cpp
+HEADERS *= $$LIB_PATH/requests/serialrequesthandle.hpp
+SOURCES *= $$LIB_PATH/requests/serialrequesthandle.cpp
+HEADERS *= $$LIB_PATH/requests/serialrequestpipeline.hpp
+SOURCES *= $$LIB_PATH/requests/serialrequestpipeline.cpp
+HEADERS *= $$LIB_PATH/requests/serialrequeststatus.hpp
+SOURCES *= $$LIB_PATH/requests/serialrequeststatus.cpp
+HEADERS *= $$LIB_PATH/requests/serialresponsematcher.hpp
+SOURCES *= $$LIB_PATH/requests/serialresponsematcher.cpp
+HEADERS *= $$LIB_PATH/requests/serialroundtripstats.hpp
+SOURCES *= $$LIB_PATH/requests/serialroundtripstats.cpp
+HEADERS *= $$LIB_PATH/seriallatencyprofile.hpp
+SOURCES *= $$LIB_PATH/seriallatencyprofile.cpp
 HEADERS *= $$LIB_PATH/seriallibconstants.hpp
 HEADERS *= $$LIB_PATH/seriallink.hpp
 SOURCES *= $$LIB_PATH/seriallink.cpp
@@ -49,10 +92,26 @@ HEADERS *= $$LIB_PATH/seriallinkintf.hpp
 SOURCES *= $$LIB_PATH/seriallinkintf.cpp
 HEADERS *= $$LIB_PATH/seriallinkmanager.hpp
 SOURCES *= $$LIB_PATH/seriallinkmanager.cpp
+HEADERS *= $$LIB_PATH/seriallinkreactor.hpp
+SOURCES *= $$LIB_PATH/seriallinkreactor.cpp
+HEADERS *= $$LIB_PATH/seriallinkreactorthread.hpp
+SOURCES *= $$LIB_PATH/seriallinkreactorthread.cpp
 HEADERS *= $$LIB_PATH/seriallinkthread.hpp
 SOURCES *= $$LIB_PATH/seriallinkthread.cpp
+HEADERS *= $$LIB_PATH/seriallinktxqueue.hpp
+SOURCES *= $$LIB_PATH/seriallinktxqueue.cpp
+HEADERS *= $$LIB_PATH/seriallinktxstats.hpp
+SOURCES *= $$LIB_PATH/seriallinktxstats.cpp
+HEADERS *= $$LIB_PATH/serialporttuning.hpp
+SOURCES *= $$LIB_PATH/serialporttuning.cpp
+HEADERS *= $$LIB_PATH/transfer/serialfiletransfer.hpp
+SOURCES *= $$LIB_PATH/transfer/serialfiletransfer.cpp
+HEADERS *= $$LIB_PATH/transfer/serialtransferprotocol.hpp
+SOURCES *= $$LIB_PATH/transfer/serialtransferprotocol.cpp
 
 include($$QT_UTILITIES/definesutility/definesutility.pri)
+include($$QT_UTILITIES/byteutility/byteutility.pri)
+include($$QT_UTILITIES/crcutility/crcutility.pri)
 include($$QT_UTILITIES/handlerutility/handlerutility.pri)
 include($$QT_UTILITIES/waitutility/waitutility.pri)
 include($$QT_UTILITIES/threadutility/threadutility.pri)
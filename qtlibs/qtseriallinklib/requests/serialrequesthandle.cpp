@@ -0,0 +1,97 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialrequesthandle.hpp"
+
+#include "waitutility/waithelper.hpp"
+
+
+SerialRequestHandle::SerialRequestHandle(quint64 requestId)
+    : _requestId{requestId},
+    _state{(requestId == 0) ? QSharedPointer<State>() : QSharedPointer<State>::create()}
+{
+}
+
+SerialRequestStatus::Enum SerialRequestHandle::getStatus() const
+{
+    if(_state.isNull())
+    {
+        return SerialRequestStatus::Unknown;
+    }
+
+    QMutexLocker locker(&_state->mutex);
+    return _state->status;
+}
+
+bool SerialRequestHandle::isFinished() const
+{
+    const SerialRequestStatus::Enum status = getStatus();
+    return (status != SerialRequestStatus::Pending);
+}
+
+QByteArray SerialRequestHandle::getResponse() const
+{
+    if(_state.isNull())
+    {
+        return QByteArray();
+    }
+
+    QMutexLocker locker(&_state->mutex);
+    return _state->response;
+}
+
+bool SerialRequestHandle::waitForFinished(int timeoutInMs) const
+{
+    if(_state.isNull())
+    {
+        return false;
+    }
+
+    WaitHelper::pseudoWait([this]() { return isFinished(); }, timeoutInMs);
+
+    return isAnswered();
+}
+
+bool SerialRequestHandle::waitForAll(const QVector<SerialRequestHandle> &handles, int timeoutInMs)
+{
+    WaitHelper::pseudoWait([&handles]()
+                           {
+                               for(auto citer = handles.cbegin(); citer != handles.cend(); ++citer)
+                               {
+                                   if(!citer->isFinished())
+                                   {
+                                       return false;
+                                   }
+                               }
+
+                               return true;
+                           },
+                           timeoutInMs);
+
+    bool allAnswered = true;
+    for(auto citer = handles.cbegin(); citer != handles.cend(); ++citer)
+    {
+        allAnswered &= citer->isAnswered();
+    }
+
+    return allAnswered;
+}
+
+void SerialRequestHandle::finish(SerialRequestStatus::Enum status, const QByteArray &response)
+{
+    if(_state.isNull())
+    {
+        return;
+    }
+
+    QMutexLocker locker(&_state->mutex);
+
+    if(_state->status != SerialRequestStatus::Pending)
+    {
+        return;
+    }
+
+    _state->status = status;
+    _state->response = response;
+}
@@ -0,0 +1,247 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialrequestpipeline.hpp"
+
+#include <QDebug>
+#include <QMutexLocker>
+#include <QTimer>
+
+#include <algorithm>
+
+#include "seriallibconstants.hpp"
+#include "seriallink.hpp"
+
+
+SerialRequestPipeline::SerialRequestPipeline(SerialLink &link, QObject *parent)
+    : QObject{parent},
+    _link{link},
+    _timeoutTimer{new QTimer(this)}
+{
+    _timeoutTimer->setSingleShot(true);
+    _timeoutTimer->setTimerType(Qt::PreciseTimer);
+    connect(_timeoutTimer, &QTimer::timeout, this, &SerialRequestPipeline::onTimeout);
+    connect(&_link, &SerialLink::framesReceived, this, &SerialRequestPipeline::onFramesReceived);
+    connect(&_link, &SerialLink::dataReceived, this, &SerialRequestPipeline::onDataReceived);
+
+    _clock.start();
+}
+
+SerialRequestPipeline::~SerialRequestPipeline()
+{
+    cancelAll();
+}
+
+void SerialRequestPipeline::enqueue(const SerialRequestHandle &handle,
+                                    const QByteArray &request,
+                                    const SerialResponseMatcher &matcher,
+                                    int timeoutInMs)
+{
+    Request pipelineRequest;
+    pipelineRequest.handle = handle;
+    pipelineRequest.matcher = matcher;
+    pipelineRequest.sentTimeInNs = _clock.nsecsElapsed();
+
+    if(!_link.send(request))
+    {
+        qWarning() << "A problem occurred when tried to write the serial request: "
+                   << handle.getRequestId();
+        finishRequest(pipelineRequest, SerialRequestStatus::WriteFailed);
+        return;
+    }
+
+    // The responses are processed in this thread, they can't be received before the request is
+    // added
+    pipelineRequest.deadlineInMs = (timeoutInMs < 0) ? -1 : (_clock.elapsed() + timeoutInMs);
+    _inFlightRequests.append(pipelineRequest);
+
+    scheduleTimeoutCheck();
+}
+
+void SerialRequestPipeline::cancelAll()
+{
+    _timeoutTimer->stop();
+
+    const QVector<Request> inFlightRequests = _inFlightRequests;
+    _inFlightRequests.clear();
+
+    for(auto citer = inFlightRequests.cbegin(); citer != inFlightRequests.cend(); ++citer)
+    {
+        finishRequest(*citer, SerialRequestStatus::Cancelled);
+    }
+}
+
+SerialRoundTripStats SerialRequestPipeline::getRoundTripStats() const
+{
+    QVector<qint64> lastRoundTripsInUs;
+    quint64 answeredNb = 0;
+    qint64 lastInUs = 0;
+    qint64 minInUs = 0;
+    qint64 maxInUs = 0;
+    qint64 sumInUs = 0;
+
+    {
+        QMutexLocker locker(&_statsMutex);
+        lastRoundTripsInUs = _lastRoundTripsInUs;
+        answeredNb = _answeredNb;
+        lastInUs = _lastRoundTripInUs;
+        minInUs = _minRoundTripInUs;
+        maxInUs = _maxRoundTripInUs;
+        sumInUs = _sumRoundTripsInUs;
+    }
+
+    // The sorting is done out of the lock, to not delay the serial link thread
+    std::sort(lastRoundTripsInUs.begin(), lastRoundTripsInUs.end());
+
+    const qint64 meanInUs = (answeredNb == 0) ? 0 :
+                                                (sumInUs / static_cast<qint64>(answeredNb));
+
+    return SerialRoundTripStats(answeredNb,
+                                lastInUs,
+                                minInUs,
+                                maxInUs,
+                                meanInUs,
+                                getPercentile(lastRoundTripsInUs, MedianPercentile),
+                                getPercentile(lastRoundTripsInUs, HighPercentile));
+}
+
+void SerialRequestPipeline::resetRoundTripStats()
+{
+    QMutexLocker locker(&_statsMutex);
+    _lastRoundTripsInUs.clear();
+    _nextRoundTripIdx = 0;
+    _answeredNb = 0;
+    _lastRoundTripInUs = 0;
+    _minRoundTripInUs = 0;
+    _maxRoundTripInUs = 0;
+    _sumRoundTripsInUs = 0;
+}
+
+void SerialRequestPipeline::onFramesReceived(const QVector<QByteArray> &frames)
+{
+    for(auto citer = frames.cbegin(); citer != frames.cend() && !_inFlightRequests.isEmpty();
+        ++citer)
+    {
+        processResponse(*citer);
+    }
+
+    scheduleTimeoutCheck();
+}
+
+void SerialRequestPipeline::onDataReceived(const QByteArray &data)
+{
+    if(_inFlightRequests.isEmpty() || _link.hasFramer())
+    {
+        return;
+    }
+
+    processResponse(data);
+    scheduleTimeoutCheck();
+}
+
+void SerialRequestPipeline::onTimeout()
+{
+    const qint64 nowInMs = _clock.elapsed();
+
+    for(int idx = _inFlightRequests.length() - 1; idx >= 0; --idx)
+    {
+        const qint64 deadlineInMs = _inFlightRequests.at(idx).deadlineInMs;
+        if(deadlineInMs >= 0 && deadlineInMs <= nowInMs)
+        {
+            qWarning() << "The serial request: " << _inFlightRequests.at(idx).handle.getRequestId()
+                       << ", hasn't been answered before its timeout";
+            finishRequest(_inFlightRequests.takeAt(idx), SerialRequestStatus::TimedOut);
+        }
+    }
+
+    scheduleTimeoutCheck();
+}
+
+void SerialRequestPipeline::processResponse(const QByteArray &response)
+{
+    // The requests in flight are sorted by writing order, the oldest matching one is answered
+    for(int idx = 0; idx < _inFlightRequests.length(); ++idx)
+    {
+        if(_inFlightRequests.at(idx).matcher.matches(response))
+        {
+            finishRequest(_inFlightRequests.takeAt(idx), SerialRequestStatus::Answered, response);
+            return;
+        }
+    }
+}
+
+void SerialRequestPipeline::finishRequest(Request request,
+                                          SerialRequestStatus::Enum status,
+                                          const QByteArray &response)
+{
+    if(status == SerialRequestStatus::Answered)
+    {
+        const qint64 roundTripInUs = (_clock.nsecsElapsed() - request.sentTimeInNs) /
+                                     SerialLibConstants::Time::NsInUs;
+        recordRoundTrip(roundTripInUs);
+        emit roundTripMeasured(request.handle.getRequestId(), roundTripInUs);
+    }
+
+    request.handle.finish(status, response);
+    emit requestFinished(request.handle.getRequestId(),
+                         (status == SerialRequestStatus::Answered));
+}
+
+void SerialRequestPipeline::scheduleTimeoutCheck()
+{
+    qint64 earliestDeadlineInMs = -1;
+
+    for(auto citer = _inFlightRequests.cbegin(); citer != _inFlightRequests.cend(); ++citer)
+    {
+        if(citer->deadlineInMs >= 0 &&
+           (earliestDeadlineInMs < 0 || citer->deadlineInMs < earliestDeadlineInMs))
+        {
+            earliestDeadlineInMs = citer->deadlineInMs;
+        }
+    }
+
+    if(earliestDeadlineInMs < 0)
+    {
+        _timeoutTimer->stop();
+        return;
+    }
+
+    const qint64 remainingInMs = qMax(static_cast<qint64>(0),
+                                      earliestDeadlineInMs - _clock.elapsed());
+    _timeoutTimer->start(static_cast<int>(remainingInMs));
+}
+
+void SerialRequestPipeline::recordRoundTrip(qint64 roundTripInUs)
+{
+    QMutexLocker locker(&_statsMutex);
+
+    if(_lastRoundTripsInUs.length() < RoundTripWindowSize)
+    {
+        _lastRoundTripsInUs.append(roundTripInUs);
+    }
+    else
+    {
+        _lastRoundTripsInUs[_nextRoundTripIdx] = roundTripInUs;
+    }
+
+    _nextRoundTripIdx = (_nextRoundTripIdx + 1) % RoundTripWindowSize;
+
+    _minRoundTripInUs = (_answeredNb == 0) ? roundTripInUs :
+                                             qMin(_minRoundTripInUs, roundTripInUs);
+    _maxRoundTripInUs = qMax(_maxRoundTripInUs, roundTripInUs);
+    _lastRoundTripInUs = roundTripInUs;
+    _sumRoundTripsInUs += roundTripInUs;
+    ++_answeredNb;
+}
+
+qint64 SerialRequestPipeline::getPercentile(const QVector<qint64> &sortedValues, int percentile)
+{
+    if(sortedValues.isEmpty())
+    {
+        return 0;
+    }
+
+    const int idx = ((sortedValues.length() - 1) * percentile) / MaxPercentile;
+    return sortedValues.at(idx);
+}
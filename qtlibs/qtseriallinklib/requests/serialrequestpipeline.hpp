@@ -0,0 +1,166 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QVector>
+
+#include "requests/serialrequesthandle.hpp"
+#include "requests/serialresponsematcher.hpp"
+#include "requests/serialroundtripstats.hpp"
+
+class SerialLink;
+class QTimer;
+
+
+/** @brief This class manages the requests of a serial link: several requests can wait for their
+           responses at the same time
+    @note The object lives in the serial link thread, it doesn't block the thread while waiting:
+          the responses are tested when they are received and the timeouts are managed with a
+          single timer on the earliest deadline.
+    @note The responses are correlated to the requests thanks to their
+          @ref SerialResponseMatcher: a received response finishes the oldest in flight request
+          it matches.
+    @note If a framer is set on the serial link, the responses are the frames it extracts;
+          otherwise, each chunk of received bytes is tested as a response.
+    @note The round-trip time of each answered request is measured, @ref getRoundTripStats and
+          @ref resetRoundTripStats can be called from any thread. */
+class SerialRequestPipeline : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief A request managed by the pipeline */
+        struct Request
+        {
+            /** @brief The handle to finish with the request result */
+            SerialRequestHandle handle{};
+
+            /** @brief The description of the expected response */
+            SerialResponseMatcher matcher{};
+
+            /** @brief The time when the request times out, relatively to the pipeline clock;
+                       -1 if it never times out */
+            qint64 deadlineInMs{-1};
+
+            /** @brief The time when the request has been written, relatively to the pipeline
+                       clock */
+            qint64 sentTimeInNs{0};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param link The serial link used to write the requests and to receive the responses
+            @param parent The class parent */
+        explicit SerialRequestPipeline(SerialLink &link, QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~SerialRequestPipeline() override;
+
+    public:
+        /** @brief Write a request and wait for its response
+            @note The request end is notified through its handle and with @ref requestFinished
+            @param handle The handle of the request
+            @param request The request bytes to write
+            @param matcher The description of the expected response
+            @param timeoutInMs The request timeout, it starts when the request is written; -1 to
+                               wait forever */
+        void enqueue(const SerialRequestHandle &handle,
+                     const QByteArray &request,
+                     const SerialResponseMatcher &matcher,
+                     int timeoutInMs);
+
+        /** @brief Cancel all the requests in flight */
+        void cancelAll();
+
+        /** @brief Get a snapshot of the round-trip times measured
+            @note The method is threadsafe */
+        SerialRoundTripStats getRoundTripStats() const;
+
+        /** @brief Reset the round-trip times measured
+            @note The method is threadsafe */
+        void resetRoundTripStats();
+
+    signals:
+        /** @brief Emitted when a request is finished
+            @param requestId The id of the request
+            @param success True if the request has been answered */
+        void requestFinished(quint64 requestId, bool success);
+
+        /** @brief Emitted when a request has been answered, with its round-trip time
+            @param requestId The id of the request
+            @param roundTripInUs The time elapsed between the request writing and the reception
+                                 of its response, in microseconds */
+        void roundTripMeasured(quint64 requestId, qint64 roundTripInUs);
+
+    private slots:
+        /** @brief Called when frames are extracted by the serial link framer
+            @param frames The frames received */
+        void onFramesReceived(const QVector<QByteArray> &frames);
+
+        /** @brief Called when bytes are received by the serial link
+            @note The bytes are only tested if no framer is set
+            @param data The bytes received */
+        void onDataReceived(const QByteArray &data);
+
+        /** @brief Called when the earliest request deadline is reached */
+        void onTimeout();
+
+    private:
+        /** @brief Finish the oldest request in flight which matches the response given
+            @param response The response received */
+        void processResponse(const QByteArray &response);
+
+        /** @brief Finish a request and emit @ref requestFinished
+            @param request The request to finish
+            @param status The final status of the request
+            @param response The response received, if the status is Answered */
+        void finishRequest(Request request,
+                           SerialRequestStatus::Enum status,
+                           const QByteArray &response = {});
+
+        /** @brief Restart the timer for the earliest deadline of the requests */
+        void scheduleTimeoutCheck();
+
+        /** @brief Add a round-trip time to the stats
+            @param roundTripInUs The round-trip time measured, in microseconds */
+        void recordRoundTrip(qint64 roundTripInUs);
+
+        /** @brief Get a percentile of the sorted values given
+            @param sortedValues The values to get the percentile from, sorted in ascending order
+            @param percentile The percentile to get, between 0 and 100
+            @return The percentile value, 0 if there is no value */
+        static qint64 getPercentile(const QVector<qint64> &sortedValues, int percentile);
+
+    private:
+        /** @brief The number of last round-trip times kept to calculate the percentiles */
+        static const constexpr int RoundTripWindowSize = 1024;
+
+        /** @brief The percentiles given in the round-trip stats */
+        static const constexpr int MedianPercentile = 50;
+        static const constexpr int HighPercentile = 99;
+        static const constexpr int MaxPercentile = 100;
+
+    private:
+        SerialLink &_link;
+
+        QVector<Request> _inFlightRequests;
+
+        QElapsedTimer _clock;
+        QTimer *_timeoutTimer{nullptr};
+
+        mutable QMutex _statsMutex;
+        QVector<qint64> _lastRoundTripsInUs;
+        int _nextRoundTripIdx{0};
+        quint64 _answeredNb{0};
+        qint64 _lastRoundTripInUs{0};
+        qint64 _minRoundTripInUs{0};
+        qint64 _maxRoundTripInUs{0};
+        qint64 _sumRoundTripsInUs{0};
+};
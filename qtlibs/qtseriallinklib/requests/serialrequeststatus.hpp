@@ -0,0 +1,34 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief Describes the status of a serial request, see @ref SerialRequestHandle */
+class SERIALLINK_EXPORT SerialRequestStatus : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The request status */
+        enum Enum {
+            Pending,        //!< @brief The request is waiting to be answered
+            Answered,       //!< @brief The expected response has been received
+            TimedOut,       //!< @brief The response hasn't been received before the timeout
+            WriteFailed,    //!< @brief The request couldn't be written
+            Cancelled,      //!< @brief The request has been cancelled, the link is stopped
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+};
@@ -0,0 +1,74 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialresponsematcher.hpp"
+
+#include <cstring>
+
+
+SerialResponseMatcher::SerialResponseMatcher()
+{
+}
+
+SerialResponseMatcher SerialResponseMatcher::fromPredicate(
+    const std::function<bool(const QByteArray &)> &predicate)
+{
+    SerialResponseMatcher matcher;
+    matcher._predicate = predicate;
+    return matcher;
+}
+
+SerialResponseMatcher SerialResponseMatcher::fromPrefix(const QByteArray &prefix)
+{
+    SerialResponseMatcher matcher;
+    matcher._prefix = prefix;
+    return matcher;
+}
+
+SerialResponseMatcher SerialResponseMatcher::fromRegExp(const QRegularExpression &regExp)
+{
+    SerialResponseMatcher matcher;
+    matcher._regExp = regExp;
+    return matcher;
+}
+
+SerialResponseMatcher &SerialResponseMatcher::requireBytesAt(int offset, const QByteArray &bytes)
+{
+    _requiredBytes.append({ offset, bytes });
+    return *this;
+}
+
+bool SerialResponseMatcher::matches(const QByteArray &response) const
+{
+    if(!_prefix.isEmpty() && !response.startsWith(_prefix))
+    {
+        return false;
+    }
+
+    for(auto citer = _requiredBytes.cbegin(); citer != _requiredBytes.cend(); ++citer)
+    {
+        const int offset = citer->first;
+        const QByteArray &bytes = citer->second;
+
+        if(offset < 0 || (offset + bytes.length()) > response.length() ||
+           memcmp(response.constData() + offset, bytes.constData(),
+                  static_cast<size_t>(bytes.length())) != 0)
+        {
+            return false;
+        }
+    }
+
+    if(!_regExp.pattern().isEmpty() &&
+       !_regExp.match(QString::fromLatin1(response)).hasMatch())
+    {
+        return false;
+    }
+
+    if(_predicate != nullptr && !_predicate(response))
+    {
+        return false;
+    }
+
+    return true;
+}
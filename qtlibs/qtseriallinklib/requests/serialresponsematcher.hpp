@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <functional>
+
+#include <QByteArray>
+#include <QPair>
+#include <QRegularExpression>
+#include <QVector>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief Describes the response expected by a serial request
+    @note The matcher is built from a predicate, a prefix or a regular expression; bytes can also
+          be required at fixed offsets. All the given conditions have to be true to match.
+    @note The required bytes are useful to correlate a response to its request, when the
+          protocol contains a sequence id: for instance, a matcher built with
+          fromPrefix("\x02").requireBytesAt(1, seqId) only matches the response with the
+          sequence id given. */
+class SERIALLINK_EXPORT SerialResponseMatcher
+{
+    public:
+        /** @brief Class constructor
+            @note The matcher built matches all the responses */
+        explicit SerialResponseMatcher();
+
+    public:
+        /** @brief Create a matcher which calls the predicate given
+            @note The predicate is called in the serial link thread
+            @param predicate The predicate to call, it returns true if the response is the
+                             expected one
+            @return The matcher created */
+        static SerialResponseMatcher fromPredicate(
+            const std::function<bool(const QByteArray &response)> &predicate);
+
+        /** @brief Create a matcher which tests the beginning of the responses
+            @param prefix The expected beginning of the response
+            @return The matcher created */
+        static SerialResponseMatcher fromPrefix(const QByteArray &prefix);
+
+        /** @brief Create a matcher which tests the responses with a regular expression
+            @note The response is converted from Latin1 before being tested
+            @param regExp The regular expression to test
+            @return The matcher created */
+        static SerialResponseMatcher fromRegExp(const QRegularExpression &regExp);
+
+    public:
+        /** @brief Require bytes at a fixed offset of the response
+            @param offset The offset of the bytes in the response
+            @param bytes The expected bytes
+            @return The matcher, to chain the calls */
+        SerialResponseMatcher &requireBytesAt(int offset, const QByteArray &bytes);
+
+        /** @brief Test if the response given matches the matcher
+            @param response The response to test
+            @return True if the response is the expected one */
+        bool matches(const QByteArray &response) const;
+
+    private:
+        std::function<bool(const QByteArray &response)> _predicate{nullptr};
+        QByteArray _prefix;
+        QRegularExpression _regExp;
+        QVector<QPair<int, QByteArray>> _requiredBytes;
+};
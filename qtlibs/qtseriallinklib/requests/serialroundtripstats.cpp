@@ -0,0 +1,38 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialroundtripstats.hpp"
+
+#include <QString>
+
+
+SerialRoundTripStats::SerialRoundTripStats(quint64 answeredNb,
+                                           qint64 lastInUs,
+                                           qint64 minInUs,
+                                           qint64 maxInUs,
+                                           qint64 meanInUs,
+                                           qint64 p50InUs,
+                                           qint64 p99InUs)
+    : _answeredNb{answeredNb},
+    _lastInUs{lastInUs},
+    _minInUs{minInUs},
+    _maxInUs{maxInUs},
+    _meanInUs{meanInUs},
+    _p50InUs{p50InUs},
+    _p99InUs{p99InUs}
+{
+}
+
+QString SerialRoundTripStats::toString() const
+{
+    return QString("answered: %1, round-trip (us) last: %2, min: %3, mean: %4, p50: %5, "
+                   "p99: %6, max: %7")
+        .arg(_answeredNb)
+        .arg(_lastInUs)
+        .arg(_minInUs)
+        .arg(_meanInUs)
+        .arg(_p50InUs)
+        .arg(_p99InUs)
+        .arg(_maxInUs);
+}
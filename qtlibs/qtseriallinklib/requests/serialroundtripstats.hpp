@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QString>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief This is a snapshot of the round-trip times measured by a @ref SerialRequestPipeline
+    @note A round-trip time is measured for each answered request: from the request writing to the
+          reception of its response
+    @note The counters are accumulated since the pipeline creation or since the last reset; the
+          percentiles are calculated on the last answered requests */
+class SERIALLINK_EXPORT SerialRoundTripStats
+{
+    public:
+        /** @brief Class constructor
+            @param answeredNb The number of answered requests
+            @param lastInUs The last round-trip time measured
+            @param minInUs The min round-trip time measured
+            @param maxInUs The max round-trip time measured
+            @param meanInUs The mean of the round-trip times measured
+            @param p50InUs The median of the last round-trip times measured
+            @param p99InUs The 99th percentile of the last round-trip times measured */
+        explicit SerialRoundTripStats(quint64 answeredNb = 0,
+                                      qint64 lastInUs = 0,
+                                      qint64 minInUs = 0,
+                                      qint64 maxInUs = 0,
+                                      qint64 meanInUs = 0,
+                                      qint64 p50InUs = 0,
+                                      qint64 p99InUs = 0);
+
+    public:
+        /** @brief Get the number of answered requests */
+        quint64 getAnsweredNb() const { return _answeredNb; }
+
+        /** @brief Get the last round-trip time measured, in microseconds */
+        qint64 getLastInUs() const { return _lastInUs; }
+
+        /** @brief Get the min round-trip time measured, in microseconds */
+        qint64 getMinInUs() const { return _minInUs; }
+
+        /** @brief Get the max round-trip time measured, in microseconds */
+        qint64 getMaxInUs() const { return _maxInUs; }
+
+        /** @brief Get the mean of the round-trip times measured, in microseconds */
+        qint64 getMeanInUs() const { return _meanInUs; }
+
+        /** @brief Get the median of the last round-trip times measured, in microseconds */
+        qint64 getP50InUs() const { return _p50InUs; }
+
+        /** @brief Get the 99th percentile of the last round-trip times measured, in
+                   microseconds */
+        qint64 getP99InUs() const { return _p99InUs; }
+
+        /** @brief Get a string representation of the stats, useful for logs */
+        QString toString() const;
+
+    private:
+        quint64 _answeredNb;
+        qint64 _lastInUs;
+        qint64 _minInUs;
+        qint64 _maxInUs;
+        qint64 _meanInUs;
+        qint64 _p50InUs;
+        qint64 _p99InUs;
+};
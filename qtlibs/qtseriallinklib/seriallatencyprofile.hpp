@@ -0,0 +1,39 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief The latency profiles which can be applied to a serial link, see
+           @ref SerialLinkIntf::setLatencyProfile */
+class SERIALLINK_EXPORT SerialLatencyProfile : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The latency profiles */
+        enum Enum {
+            Default,        //!< @brief The serial port and driver default behaviors
+            LowLatency,     //!< @brief Each write is pushed to the driver at once and the driver
+                            //!  is asked to not delay the received bytes (useful for small
+                            //!  request/response exchanges at high baudrates)
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+
+        /** @brief Parse the enum from its string representation
+            @param value The string to parse
+            @return The enum parsed, this returns Unknown if no match has been found */
+        static Enum parseFromString(const QString &value);
+};
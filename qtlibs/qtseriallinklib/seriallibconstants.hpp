@@ -4,6 +4,8 @@
 
 #pragma once
 
+#include <QtGlobal>
+
 /** @brief This namespace contains serial-link lib constants */
 namespace SerialLibConstants
 {
@@ -24,4 +26,13 @@ namespace SerialLibConstants
         /** @brief Timeout of the mutex used in the serial lib in milliseconds */
         const constexpr int MutexTimeoutInMs = 5000;
     }
+
+    namespace Time
+    {
+        /** @brief The number of nanoseconds in a microsecond */
+        constexpr const qint64 NsInUs = 1000;
+
+        /** @brief The number of nanoseconds in a millisecond */
+        constexpr const qint64 NsInMs = 1000 * NsInUs;
+    }
 }
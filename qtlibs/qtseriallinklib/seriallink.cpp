@@ -7,17 +7,29 @@
 
 #include <QByteArray>
 #include <QDebug>
-#include <QSerialPortInfo>
 
+#include "capture/serialcapturequeue.hpp"
+#include "framer/serialframer.hpp"
+#include "requests/serialrequestpipeline.hpp"
 #include "seriallibconstants.hpp"
+#include "seriallinktxqueue.hpp"
+#include "serialporttuning.hpp"
 
 
-SerialLink::SerialLink(const QSerialPortInfo &portInfo, QObject *parent) :
+SerialLink::SerialLink(const QString &portName, QObject *parent) :
     QObject(parent),
-    _serial(QSerialPort(portInfo))
+    _serial(portName),
+    _txQueue(new SerialLinkTxQueue(_serial, this)),
+    _requestPipeline(new SerialRequestPipeline(*this, this))
 {
     connect(&_serial, &QSerialPort::readyRead, this, &SerialLink::onReadyRead);
 
+    // The driver tuning is lost when the port is closed
+    connect(&_serial, &QSerialPort::aboutToClose, this, [this]() {
+        _lowLatency = false;
+        _txQueue->setFlushEachWrite(false);
+    });
+
     connect(&_serial,
             &QSerialPort::errorOccurred,
             this,
@@ -26,6 +38,9 @@ SerialLink::SerialLink(const QSerialPortInfo &portInfo, QObject *parent) :
 
 SerialLink::~SerialLink()
 {
+    // The pending requests are cancelled while the link is still complete
+    delete _requestPipeline;
+    _requestPipeline = nullptr;
 }
 
 const QSerialPort &SerialLink::getSerialPort() const
@@ -40,12 +55,15 @@ QSerialPort &SerialLink::accessSerialPort()
 
 bool SerialLink::send(const QByteArray &data, bool forceFlush)
 {
+    // The packets waiting in the transmit queue have been sent before this one
+    _txQueue->writePending();
+
     if(Q_UNLIKELY(SerialLibConstants::Debug::Stream))
     {
         qDebug() << _serial.portName() << " <<< " << data;
     }
 
-    const qint64 writtenBytes = _serial.write(data.constData());
+    const qint64 writtenBytes = _serial.write(data);
 
     if(Q_UNLIKELY(writtenBytes == -1))
     {
@@ -54,6 +72,14 @@ bool SerialLink::send(const QByteArray &data, bool forceFlush)
         return false;
     }
 
+    _txQueue->notifyDirectWrite(writtenBytes);
+
+    if(_captureQueue != nullptr && writtenBytes > 0)
+    {
+        _captureQueue->capture(SerialCaptureDirection::Tx,
+                               data.left(static_cast<int>(writtenBytes)));
+    }
+
     if(Q_UNLIKELY(writtenBytes != data.length()))
     {
         qWarning() << _serial.portName() << "Write fail:" << writtenBytes << "bytes written out of"
@@ -61,7 +87,7 @@ bool SerialLink::send(const QByteArray &data, bool forceFlush)
         return false;
     }
 
-    if(forceFlush && Q_UNLIKELY(!_serial.flush()))
+    if((forceFlush || _lowLatency) && Q_UNLIKELY(!_serial.flush()))
     {
         qWarning() << "Flush failed, when tried to send data on the serial port: "
                    << _serial.portName();
@@ -79,6 +105,76 @@ void SerialLink::flushRx()
     {
         qDebug() << _serial.portName() << " Flushed RX: " << rxData;
     }
+
+    if(_framer != nullptr)
+    {
+        _framer->reset();
+    }
+}
+
+bool SerialLink::setFramer(const QSharedPointer<SerialFramer> &framer)
+{
+    if(framer != nullptr && !framer->isValid())
+    {
+        qWarning() << "The framer given to the serial port: " << _serial.portName()
+                   << ", isn't valid";
+        return false;
+    }
+
+    _framer = framer;
+
+    if(_framer != nullptr)
+    {
+        _framer->reset();
+    }
+
+    return true;
+}
+
+void SerialLink::sendRequest(const SerialRequestHandle &handle,
+                             const QByteArray &request,
+                             const SerialResponseMatcher &matcher,
+                             int timeoutInMs)
+{
+    _requestPipeline->enqueue(handle, request, matcher, timeoutInMs);
+}
+
+void SerialLink::setCaptureQueue(const QSharedPointer<SerialCaptureQueue> &captureQueue)
+{
+    _captureQueue = captureQueue;
+    _txQueue->setCaptureQueue(captureQueue);
+}
+
+bool SerialLink::setLatencyProfile(SerialLatencyProfile::Enum profile)
+{
+    if(profile == SerialLatencyProfile::Unknown)
+    {
+        qWarning() << "Can't apply an unknown latency profile on the serial port: "
+                   << _serial.portName();
+        return false;
+    }
+
+    const bool lowLatency = (profile == SerialLatencyProfile::LowLatency);
+
+    if(!SerialPortTuning::setLowLatency(_serial, lowLatency))
+    {
+        qWarning() << "Can't apply the latency profile: " << SerialLatencyProfile::toString(profile)
+                   << ", on the serial port: " << _serial.portName();
+        return false;
+    }
+
+    _lowLatency = lowLatency;
+    _txQueue->setFlushEachWrite(lowLatency);
+
+    return true;
+}
+
+void SerialLink::injectReceivedData(const QByteArray &data)
+{
+    if(!data.isEmpty())
+    {
+        processReceivedData(data);
+    }
 }
 
 void SerialLink::onReadyRead()
@@ -91,6 +187,28 @@ void SerialLink::onReadyRead()
         {
             qDebug() << _serial.portName() << " >>> " << data;
         }
-        emit dataReceived(data);
+
+        if(_captureQueue != nullptr)
+        {
+            _captureQueue->capture(SerialCaptureDirection::Rx, data);
+        }
+
+        processReceivedData(data);
+    }
+}
+
+void SerialLink::processReceivedData(const QByteArray &data)
+{
+    emit dataReceived(data);
+
+    if(_framer != nullptr)
+    {
+        QVector<QByteArray> frames;
+        _framer->processData(data, frames);
+
+        if(!frames.isEmpty())
+        {
+            emit framesReceived(frames);
+        }
     }
 }
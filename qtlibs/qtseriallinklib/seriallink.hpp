@@ -8,8 +8,17 @@
 #include <QObject>
 
 #include <QSerialPort>
+#include <QSharedPointer>
+#include <QVector>
 
-class QSerialPortInfo;
+#include "requests/serialrequesthandle.hpp"
+#include "requests/serialresponsematcher.hpp"
+#include "seriallatencyprofile.hpp"
+
+class SerialCaptureQueue;
+class SerialFramer;
+class SerialLinkTxQueue;
+class SerialRequestPipeline;
 
 
 /** @brief This class holds a single serial line with a few dedicated helpers */
@@ -19,9 +28,9 @@ class SerialLink : public QObject
 
     public:
         /** @brief Create an instance
-            @param portInfo Details of serial port to wrap
+            @param portName The name or the system location of the serial port to wrap
             @param parent Optional Qt parentship */
-        explicit SerialLink(const QSerialPortInfo &portInfo, QObject *parent = nullptr);
+        explicit SerialLink(const QString &portName, QObject *parent = nullptr);
 
         /** @brief Class destructor */
         virtual ~SerialLink() override;
@@ -35,28 +44,105 @@ class SerialLink : public QObject
             @return wrapped serial port */
         QSerialPort &accessSerialPort();
 
+        /** @brief Access the asynchronous transmit queue of the serial link */
+        SerialLinkTxQueue *accessTxQueue() const { return _txQueue; }
+
+        /** @brief Access the requests pipeline of the serial link */
+        SerialRequestPipeline *accessRequestPipeline() const { return _requestPipeline; }
+
+        /** @brief Test if a framer is set on the serial link */
+        bool hasFramer() const { return !_framer.isNull(); }
+
     public slots:
         /** @brief Send data to serial port (asynchronously)
             @note This method ensure thread uncoupling but requires an event loop
+            @note The packets waiting in the transmit queue are written before, to keep the order
             @param data Data to send
             @param forceFlush If true force the immediate flush of data into the serial link
             @return False upon error */
         bool send(const QByteArray &data, bool forceFlush = false);
 
-        /** @brief Trash RX buffer (asynchronously) */
+        /** @brief Trash RX buffer (asynchronously)
+            @note The bytes waiting in the framer are also dropped */
         void flushRx();
 
+        /** @brief Set the framer which cuts the received bytes into frames
+            @note When a framer is set, @ref framesReceived is emitted with the complete frames
+                  contained in each reading; @ref dataReceived is still emitted with the raw
+                  bytes
+            @param framer The framer to use, nullptr to remove the current framer
+            @return False if the framer configuration isn't valid */
+        bool setFramer(const QSharedPointer<SerialFramer> &framer);
+
+        /** @brief Write a request and wait for its response, without blocking the thread
+            @note The request end is notified through its handle and with
+                  @ref SerialRequestPipeline::requestFinished
+            @param handle The handle of the request
+            @param request The request bytes to write
+            @param matcher The description of the expected response
+            @param timeoutInMs The request timeout; -1 to wait forever */
+        void sendRequest(const SerialRequestHandle &handle,
+                         const QByteArray &request,
+                         const SerialResponseMatcher &matcher,
+                         int timeoutInMs);
+
+        /** @brief Set the queue where the written and received bytes are captured
+            @param captureQueue The capture queue, nullptr to stop capturing */
+        void setCaptureQueue(const QSharedPointer<SerialCaptureQueue> &captureQueue);
+
+        /** @brief Set the latency profile of the serial link
+            @note This has to be called after the serial port opening, the profile is lost when
+                  the port is closed
+            @note In @ref SerialLatencyProfile::LowLatency, the serial port is flushed after each
+                  write (the written bytes aren't delayed to the next event loop iteration) and
+                  the driver is tuned to not delay the received bytes, see
+                  @ref SerialPortTuning::setLowLatency
+            @param profile The profile to apply
+            @return False if the profile couldn't be applied */
+        bool setLatencyProfile(SerialLatencyProfile::Enum profile);
+
+        /** @brief Process bytes as if they have been received on the serial port
+            @note This is useful to replay a capture, see @ref SerialCaptureReplayer. The injected
+                  bytes aren't captured.
+            @param data The bytes to process */
+        void injectReceivedData(const QByteArray &data);
+
     private slots:
         /** @brief React on serial port ready-read event */
         void onReadyRead();
 
+    private:
+        /** @brief Emit the received bytes and give them to the framer
+            @param data The bytes received */
+        void processReceivedData(const QByteArray &data);
+
     signals:
         /** @brief Signal fired whenever data is received from serial port
             @param data Received data chunk
             @note This signal only fires when serial port is opened. */
         void dataReceived(const QByteArray &data);
 
+        /** @brief Signal fired when complete frames have been extracted by the framer
+            @note The frames extracted from the same reading are emitted together
+            @param frames The frames received, in the receiving order */
+        void framesReceived(const QVector<QByteArray> &frames);
+
     private:
         /** @brief Encapsulated serial port */
         QSerialPort _serial;
+
+        /** @brief The asynchronous transmit queue, it writes on @ref _serial */
+        SerialLinkTxQueue *_txQueue{nullptr};
+
+        /** @brief The framer of the received bytes, it may be null */
+        QSharedPointer<SerialFramer> _framer;
+
+        /** @brief The pipeline of the requests waiting for their responses */
+        SerialRequestPipeline *_requestPipeline{nullptr};
+
+        /** @brief The queue where the traffic is captured, it may be null */
+        QSharedPointer<SerialCaptureQueue> _captureQueue;
+
+        /** @brief True if the serial port is flushed after each write */
+        bool _lowLatency{false};
 };
@@ -7,44 +7,140 @@
 #include "definesutility/definesutility.hpp"
 #include "threadutility/concurrent/threadconcurrentrun.hpp"
 
+#include "capture/serialcapturequeue.hpp"
+#include "capture/serialcapturethread.hpp"
+#include "framer/serialframer.hpp"
+#include "requests/serialrequestpipeline.hpp"
+#include "requests/serialroundtripstats.hpp"
 #include "seriallink.hpp"
+#include "seriallinkreactorthread.hpp"
 #include "seriallinkthread.hpp"
+#include "seriallinktxqueue.hpp"
+#include "seriallinktxstats.hpp"
 
 #include <QDebug>
+#include <QEventLoop>
+#include <QSerialPortInfo>
 
 
 SerialLinkIntf::SerialLinkIntf(const QString &interfaceName, QObject *parent)
     : QObject{parent},
-      _serialLinkThread(new SerialLinkThread()),
       _interfaceName(interfaceName)
 {
 }
 
 SerialLinkIntf::~SerialLinkIntf()
 {
-    _serialLinkThread->stopAndDeleteThread();
+    if(isCapturing())
+    {
+        stopCapture();
+    }
+
+    if(_serialLinkThread != nullptr)
+    {
+        _serialLinkThread->stopAndDeleteThread();
+    }
+    else if(_reactorThread != nullptr)
+    {
+        _reactorThread->deleteSerialLink(_serialLink);
+    }
+
+    _serialLink = nullptr;
 }
 
 bool SerialLinkIntf::initSerialLink(const QSerialPortInfo &serialPortInfo)
 {
-    RETURN_IF_FALSE(_serialLinkThread->initSerialLink(serialPortInfo));
+    return initSerialLink(serialPortInfo.systemLocation());
+}
 
-    connect(_serialLinkThread->accessSerialLink(),  &SerialLink::dataReceived,
-            this,                                   &SerialLinkIntf::dataReceived);
+bool SerialLinkIntf::initSerialLink(const QString &portName)
+{
+    if(_serialLink != nullptr || _serialLinkThread != nullptr)
+    {
+        qWarning() << "The serial link: " << _interfaceName << ", has already been initialized";
+        return false;
+    }
+
+    _serialLinkThread = new SerialLinkThread();
+
+    RETURN_IF_FALSE(_serialLinkThread->initSerialLink(portName));
+
+    _serialLink = _serialLinkThread->accessSerialLink();
+
+    connectSerialLink();
 
     return true;
 }
 
+bool SerialLinkIntf::initSerialLink(const QString &portName,
+                                    SerialLinkReactorThread &reactorThread)
+{
+    if(_serialLink != nullptr || _serialLinkThread != nullptr)
+    {
+        qWarning() << "The serial link: " << _interfaceName << ", has already been initialized";
+        return false;
+    }
+
+    _serialLink = reactorThread.createSerialLink(portName);
+    if(_serialLink == nullptr)
+    {
+        qWarning() << "The serial link: " << _interfaceName << ", can't be created in the reactor "
+                   << "thread";
+        return false;
+    }
+
+    _reactorThread = &reactorThread;
+
+    connectSerialLink();
+
+    return true;
+}
+
+bool SerialLinkIntf::isLinkValid() const
+{
+    if(_serialLink == nullptr)
+    {
+        return false;
+    }
+
+    if(_serialLinkThread != nullptr)
+    {
+        return _serialLinkThread->isValid();
+    }
+
+    return (_reactorThread != nullptr) && _reactorThread->isValid();
+}
+
+void SerialLinkIntf::connectSerialLink()
+{
+    connect(_serialLink,  &SerialLink::dataReceived,
+            this,         &SerialLinkIntf::dataReceived);
+    connect(_serialLink,  &SerialLink::framesReceived,
+            this,         &SerialLinkIntf::framesReceived);
+    connect(_serialLink->accessTxQueue(),
+            &SerialLinkTxQueue::sendFinished,
+            this,
+            &SerialLinkIntf::sendFinished);
+    connect(_serialLink->accessRequestPipeline(),
+            &SerialRequestPipeline::requestFinished,
+            this,
+            &SerialLinkIntf::requestFinished);
+    connect(_serialLink->accessRequestPipeline(),
+            &SerialRequestPipeline::roundTripMeasured,
+            this,
+            &SerialLinkIntf::roundTripMeasured);
+}
+
 bool SerialLinkIntf::send(const QByteArray &data, bool forceFlush)
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't send data, the serial link thread: " << _interfaceName
                    << ", isn't valid, may be the thread hasn't be initialized or it's stopped";
         return false;
     }
 
-    return ThreadConcurrentRun::run(*_serialLinkThread->accessSerialLink(),
+    return ThreadConcurrentRun::run(*_serialLink,
                                     &SerialLink::send,
                                     data,
                                     forceFlush);
@@ -53,59 +149,302 @@ bool SerialLinkIntf::send(const QByteArray &data, bool forceFlush)
 
 void SerialLinkIntf::flushRx()
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't flush RX, the serial link thread: " << _interfaceName
                    << " isn't valid, may be the thread hasn't be initialized or it's stopped";
         return;
     }
 
-    ThreadConcurrentRun::run(*_serialLinkThread->accessSerialLink(), &SerialLink::flushRx);
+    ThreadConcurrentRun::run(*_serialLink, &SerialLink::flushRx);
+}
+
+bool SerialLinkIntf::setFramer(const QSharedPointer<SerialFramer> &framer)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't set the framer, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*_serialLink,
+                                    &SerialLink::setFramer,
+                                    framer);
+}
+
+SerialRequestHandle SerialLinkIntf::sendRequest(const QByteArray &request,
+                                                const SerialResponseMatcher &matcher,
+                                                int timeoutInMs)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't send a request, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return SerialRequestHandle();
+    }
+
+    SerialLink *serialLink = _serialLink;
+    const SerialRequestHandle handle(_nextRequestId++);
+
+    // We don't wait for the serial link thread: the response is given through the handle
+    QMetaObject::invokeMethod(serialLink,
+                              [serialLink, handle, request, matcher, timeoutInMs]()
+                              {
+                                  serialLink->sendRequest(handle, request, matcher, timeoutInMs);
+                              },
+                              Qt::QueuedConnection);
+
+    return handle;
+}
+
+bool SerialLinkIntf::sendRequestAndWait(const QByteArray &request,
+                                        const SerialResponseMatcher &matcher,
+                                        QByteArray &response,
+                                        int timeoutInMs)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't send a request and wait its response, the serial link thread: "
+                   << _interfaceName << " isn't valid, may be the thread hasn't be initialized or "
+                   << "it's stopped";
+        return false;
+    }
+
+    QEventLoop loop;
+    quint64 requestId = 0;
+
+    // The loop is connected before sending the request to not miss its end; the timeout is
+    // managed by the request pipeline, which always finishes the request
+    connect(_serialLink->accessRequestPipeline(),
+            &SerialRequestPipeline::requestFinished,
+            &loop,
+            [&loop, &requestId](quint64 finishedRequestId, bool /*success*/)
+            {
+                if(finishedRequestId == requestId)
+                {
+                    loop.quit();
+                }
+            },
+            Qt::QueuedConnection);
+
+    const SerialRequestHandle handle = sendRequest(request, matcher, timeoutInMs);
+    if(!handle.isValid())
+    {
+        return false;
+    }
+
+    requestId = handle.getRequestId();
+
+    if(!handle.isFinished())
+    {
+        loop.exec(QEventLoop::ExcludeUserInputEvents);
+    }
+
+    if(!handle.isAnswered())
+    {
+        qWarning() << "The request on the serial link: " << _interfaceName << ", hasn't been "
+                   << "answered: " << SerialRequestStatus::toString(handle.getStatus());
+        return false;
+    }
+
+    response = handle.getResponse();
+    return true;
+}
+
+bool SerialLinkIntf::getRoundTripStats(SerialRoundTripStats &stats) const
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't get the round-trip stats, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return false;
+    }
+
+    stats = _serialLink->accessRequestPipeline()->getRoundTripStats();
+    return true;
+}
+
+bool SerialLinkIntf::resetRoundTripStats()
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't reset the round-trip stats, the serial link thread: "
+                   << _interfaceName << " isn't valid, may be the thread hasn't be initialized or "
+                   << "it's stopped";
+        return false;
+    }
+
+    _serialLink->accessRequestPipeline()->resetRoundTripStats();
+    return true;
+}
+
+quint64 SerialLinkIntf::sendAsync(const QByteArray &data)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't send data asynchronously, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return 0;
+    }
+
+    return _serialLink->accessTxQueue()->enqueue(data);
+}
+
+void SerialLinkIntf::clearTxQueue()
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't clear the TX queue, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return;
+    }
+
+    ThreadConcurrentRun::run(*_serialLink->accessTxQueue(),
+                             &SerialLinkTxQueue::clear);
+}
+
+bool SerialLinkIntf::getTxStats(SerialLinkTxStats &stats) const
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't get the TX stats, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return false;
+    }
+
+    stats = _serialLink->accessTxQueue()->getStats();
+    return true;
+}
+
+bool SerialLinkIntf::resetTxStats()
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't reset the TX stats, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return false;
+    }
+
+    _serialLink->accessTxQueue()->resetStats();
+    return true;
+}
+
+bool SerialLinkIntf::startCapture(const QString &filePath)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't start the capture, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return false;
+    }
+
+    if(isCapturing())
+    {
+        qWarning() << "A capture is already in progress on the serial link: " << _interfaceName;
+        return false;
+    }
+
+    SerialCaptureThread *captureThread = new SerialCaptureThread();
+    if(!captureThread->initCapture(filePath, _interfaceName))
+    {
+        captureThread->stopAndDeleteThread();
+        return false;
+    }
+
+    _captureThread = captureThread;
+
+    ThreadConcurrentRun::run(*_serialLink,
+                             &SerialLink::setCaptureQueue,
+                             _captureThread->getQueue());
+
+    return true;
+}
+
+bool SerialLinkIntf::stopCapture()
+{
+    if(!isCapturing())
+    {
+        qWarning() << "There is no capture in progress on the serial link: " << _interfaceName;
+        return false;
+    }
+
+    if(isLinkValid())
+    {
+        // When the method returns, the serial link thread doesn't push in the queue anymore
+        ThreadConcurrentRun::run(*_serialLink,
+                                 &SerialLink::setCaptureQueue,
+                                 QSharedPointer<SerialCaptureQueue>());
+    }
+
+    // The capture thread writes the remaining chunks before finishing; we directly quit its
+    // event loop to not depend on the event loop of this thread
+    _captureThread->quit();
+    _captureThread->wait();
+    delete _captureThread;
+    _captureThread = nullptr;
+
+    return true;
+}
+
+void SerialLinkIntf::injectReceivedData(const QByteArray &data)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't inject received data, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return;
+    }
+
+    SerialLink *serialLink = _serialLink;
+    QMetaObject::invokeMethod(serialLink,
+                              [serialLink, data]() { serialLink->injectReceivedData(data); },
+                              Qt::QueuedConnection);
 }
 
 bool SerialLinkIntf::open(QIODevice::OpenMode mode)
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't open the serial port, the serial link thread: " << _interfaceName
                    << " isn't valid, may be the thread hasn't be initialized or it's stopped";
         return false;
     }
 
-    return ThreadConcurrentRun::run(_serialLinkThread->accessSerialLink()->accessSerialPort(),
+    return ThreadConcurrentRun::run(_serialLink->accessSerialPort(),
                                     &QSerialPort::open,
                                     mode);
 }
 
 bool SerialLinkIntf::isOpen() const
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't test if serial port is open, the serial link: " << _interfaceName
                    << " thread isn't valid, may be the thread hasn't be initialized or it's stopped";
         return false;
     }
 
-    return ThreadConcurrentRun::run(_serialLinkThread->accessSerialLink()->accessSerialPort(),
+    return ThreadConcurrentRun::run(_serialLink->accessSerialPort(),
                                     &QSerialPort::isOpen);
 }
 
 void SerialLinkIntf::close()
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't close the serial port, the serial link thread: " << _interfaceName
                    << " isn't valid, may be the thread hasn't be initialized or it's stopped";
         return;
     }
 
-    ThreadConcurrentRun::run(_serialLinkThread->accessSerialLink()->accessSerialPort(),
+    ThreadConcurrentRun::run(_serialLink->accessSerialPort(),
                              &QSerialPort::close);
 }
 
 bool SerialLinkIntf::setFlowControl(QSerialPort::FlowControl flowControl)
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't set the flow control of the serial port, the serial link thread: "
                    << _interfaceName << " isn't valid, may be the thread hasn't be initialized or "
@@ -113,14 +452,14 @@ bool SerialLinkIntf::setFlowControl(QSerialPort::FlowControl flowControl)
         return false;
     }
 
-    return ThreadConcurrentRun::run(_serialLinkThread->accessSerialLink()->accessSerialPort(),
+    return ThreadConcurrentRun::run(_serialLink->accessSerialPort(),
                                     &QSerialPort::setFlowControl,
                                     flowControl);
 }
 
 bool SerialLinkIntf::setBaudRate(qint32 baudRate, QSerialPort::Directions directions)
 {
-    if(!_serialLinkThread->isValid())
+    if(!isLinkValid())
     {
         qWarning() << "Can't set the baudrate of the serial port, the serial link thread: "
                    << _interfaceName << " isn't valid, may be the thread hasn't be initialized or "
@@ -128,8 +467,38 @@ bool SerialLinkIntf::setBaudRate(qint32 baudRate, QSerialPort::Directions direct
         return false;
     }
 
-    return ThreadConcurrentRun::run(_serialLinkThread->accessSerialLink()->accessSerialPort(),
+    return ThreadConcurrentRun::run(_serialLink->accessSerialPort(),
                                     &QSerialPort::setBaudRate,
                                     baudRate,
                                     directions);
 }
+
+bool SerialLinkIntf::setLatencyProfile(SerialLatencyProfile::Enum profile)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't set the latency profile, the serial link thread: " << _interfaceName
+                   << " isn't valid, may be the thread hasn't be initialized or it's stopped";
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*_serialLink,
+                                    &SerialLink::setLatencyProfile,
+                                    profile);
+}
+
+bool SerialLinkIntf::setReadBufferSize(qint64 size)
+{
+    if(!isLinkValid())
+    {
+        qWarning() << "Can't set the read buffer size of the serial port, the serial link thread: "
+                   << _interfaceName << " isn't valid, may be the thread hasn't be initialized or "
+                   << "it's stopped";
+        return false;
+    }
+
+    ThreadConcurrentRun::run(_serialLink->accessSerialPort(),
+                             &QSerialPort::setReadBufferSize,
+                             size);
+    return true;
+}
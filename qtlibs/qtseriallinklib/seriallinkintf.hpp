@@ -8,9 +8,23 @@
 
 #include "definesseriallink.hpp"
 
+#include <atomic>
+
 #include <QSerialPort>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "requests/serialrequesthandle.hpp"
+#include "requests/serialresponsematcher.hpp"
+#include "seriallatencyprofile.hpp"
 
+class SerialCaptureThread;
+class SerialFramer;
+class SerialLink;
+class SerialLinkReactorThread;
 class SerialLinkThread;
+class SerialLinkTxStats;
+class SerialRoundTripStats;
 
 
 /** @brief Interface to communicate with the serial link contains in the worker thread
@@ -36,6 +50,22 @@ class SERIALLINK_EXPORT SerialLinkIntf : public QObject
             @return True if no problem occurred */
         bool initSerialLink(const QSerialPortInfo &serialPortInfo);
 
+        /** @brief Init the serial link
+            @note This is useful to open serial ports which aren't listed by
+                  @ref QSerialPortInfo::availablePorts, as the pseudo terminals
+            @param portName The name or the system location of the serial port
+                            (ex: "ttyUSB0", "/dev/pts/3" or "COM1")
+            @return True if no problem occurred */
+        bool initSerialLink(const QString &portName);
+
+        /** @brief Init the serial link in a reactor thread shared with other serial links
+            @note The interface methods behave the same way as with a dedicated thread
+            @param portName The name or the system location of the serial port
+            @param reactorThread The reactor thread which hosts the serial link, it has to be
+                                 initialized and to live longer than the interface
+            @return True if no problem occurred */
+        bool initSerialLink(const QString &portName, SerialLinkReactorThread &reactorThread);
+
         /** @brief Get interface name */
         const QString &getIntfName() const { return _interfaceName; }
 
@@ -56,6 +86,115 @@ class SERIALLINK_EXPORT SerialLinkIntf : public QObject
                      caller thread is processing while the method is called. */
         void flushRx();
 
+    public:
+        /** @brief Set the framer which cuts the received bytes into frames
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @warning Once given, the framer is used in the serial link thread and mustn't be used
+                     anymore by the caller
+            @note When a framer is set, @ref framesReceived is emitted with the complete frames
+            @param framer The framer to use, nullptr to remove the current framer
+            @return True if no problem occurred */
+        bool setFramer(const QSharedPointer<SerialFramer> &framer);
+
+        /** @brief Write a request and return at once, the response is waited in the serial link
+                   thread
+            @note Several requests can wait for their responses at the same time. A received
+                  response finishes the oldest request it matches; to correlate a response to its
+                  request, the matcher can require the sequence id of the protocol, see
+                  @ref SerialResponseMatcher::requireBytesAt
+            @note The responses are the frames extracted by the framer, if one is set; otherwise,
+                  each chunk of received bytes is tested
+            @note The method is threadsafe and doesn't wait for the serial link thread
+            @param request The request bytes to write
+            @param matcher The description of the expected response
+            @param timeoutInMs The request timeout; -1 to wait forever
+            @return The handle of the request, invalid if a problem occurred */
+        SerialRequestHandle sendRequest(const QByteArray &request,
+                                        const SerialResponseMatcher &matcher,
+                                        int timeoutInMs);
+
+        /** @brief Write a request and wait for its response
+            @note The method returns as soon as the serial link thread has received the response
+                  or the timeout has raised: the waiting isn't paced by a polling period
+            @note The event loop of the caller thread is processed while waiting
+            @param request The request bytes to write
+            @param matcher The description of the expected response
+            @param response The response received
+            @param timeoutInMs The request timeout; -1 to wait forever
+            @return True if the response has been received */
+        bool sendRequestAndWait(const QByteArray &request,
+                                const SerialResponseMatcher &matcher,
+                                QByteArray &response,
+                                int timeoutInMs = -1);
+
+        /** @brief Get a snapshot of the round-trip times of the requests sent with
+                   @ref sendRequest
+            @note The method is threadsafe and doesn't wait for the serial link thread
+            @param stats The statistics got
+            @return True if no problem occurred */
+        bool getRoundTripStats(SerialRoundTripStats &stats) const;
+
+        /** @brief Reset the round-trip times of the requests
+            @note The method is threadsafe and doesn't wait for the serial link thread
+            @return True if no problem occurred */
+        bool resetRoundTripStats();
+
+        /** @brief Send data to serial port through the link transmit queue
+            @note The method is threadsafe and doesn't wait for the serial link thread: the data is
+                  queued and the end of its writing is notified with @ref sendFinished.
+                  Therefore, the id returned is only known to be valid
+            @note The packets queued together are coalesced in large writes by the serial link
+                  thread
+            @note The data are binary-safe
+            @param data Data to send
+            @return The id of the packet, 0 if a problem occurred */
+        quint64 sendAsync(const QByteArray &data);
+
+        /** @brief Abandon all the packets waiting in the link transmit queue
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note @ref sendFinished is emitted with a failure for each abandoned packet */
+        void clearTxQueue();
+
+        /** @brief Get a snapshot of the link transmit queue statistics
+            @note The method is threadsafe and doesn't wait for the serial link thread
+            @param stats The statistics got
+            @return True if no problem occurred */
+        bool getTxStats(SerialLinkTxStats &stats) const;
+
+        /** @brief Reset the link transmit queue statistics counters
+            @note The method is threadsafe and doesn't wait for the serial link thread
+            @return True if no problem occurred */
+        bool resetTxStats();
+
+        /** @brief Start to capture the traffic of the serial link in a file
+            @note The written and received chunks are recorded with a monotonic timestamp. The
+                  serial link thread hands the chunks off without lock to a capture thread, which
+                  writes them in the file; see @ref SerialCaptureFormat for the file format.
+            @note The capture can be replayed with @ref SerialCaptureReplayer
+            @param filePath The path of the capture file to create
+            @return True if no problem occurred */
+        bool startCapture(const QString &filePath);
+
+        /** @brief Stop the current capture
+            @note The method returns when all the captured chunks have been written in the file
+            @return True if no problem occurred */
+        bool stopCapture();
+
+        /** @brief Test if the traffic of the serial link is captured */
+        bool isCapturing() const { return _captureThread != nullptr; }
+
+        /** @brief Process bytes as if they have been received on the serial port
+            @note This is useful to replay a capture: connect
+                  @ref SerialCaptureReplayer::chunkReplayed to this method
+            @note The method is threadsafe and doesn't wait for the serial link thread; the bytes
+                  are processed in the order they have been injected
+            @param data The bytes to process */
+        void injectReceivedData(const QByteArray &data);
+
     public:
         /** @brief This method calls the @ref QSerialPort:open
             @note The method is threadsafe
@@ -96,13 +235,70 @@ class SERIALLINK_EXPORT SerialLinkIntf : public QObject
         bool setBaudRate(qint32 baudRate,
                          QSerialPort::Directions directions = QSerialPort::AllDirections);
 
+        /** @brief Set the latency profile of the serial link
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note The serial port has to be open; the profile is lost when the port is closed
+            @note In @ref SerialLatencyProfile::LowLatency, the written bytes are given to the
+                  driver at once (instead of waiting the next event loop iteration) and the driver
+                  is asked to not delay the received bytes. It's useful for the small
+                  request/response exchanges, see @ref getRoundTripStats to measure the gain
+            @param profile The profile to apply
+            @return True if no problem occurred */
+        bool setLatencyProfile(SerialLatencyProfile::Enum profile);
+
+        /** @brief This method calls the @ref QSerialPort:setReadBufferSize
+            @note The method is threadsafe
+            @warning The method is called in another thread, it means that the event loop of the
+                     caller thread is processing while the method is called.
+            @note When the buffer is full, the serial port stops reading the driver until bytes
+                  are read. A small buffer bounds the received bytes processed at once, 0 means
+                  no limit
+            @param size The size of the read buffer, in bytes
+            @return True if no problem occurred */
+        bool setReadBufferSize(qint64 size);
+
     signals:
          /** @brief Signal fired whenever data is received from serial port
              @param data Received data chunk
              @note This signal only fires when serial port is opened. */
          void dataReceived(const QByteArray &data);
 
+         /** @brief Emitted when the writing of a packet sent with @ref sendAsync is finished
+             @param sendId The id of the packet, returned by @ref sendAsync
+             @param success True if all the packet bytes have been written */
+         void sendFinished(quint64 sendId, bool success);
+
+         /** @brief Signal fired when complete frames have been extracted by the framer
+             @note The frames extracted from the same reading are emitted together
+             @param frames The frames received, in the receiving order */
+         void framesReceived(const QVector<QByteArray> &frames);
+
+         /** @brief Emitted when a request sent with @ref sendRequest is finished
+             @param requestId The id of the request
+             @param success True if the request has been answered */
+         void requestFinished(quint64 requestId, bool success);
+
+         /** @brief Emitted when a request sent with @ref sendRequest has been answered, with its
+                    round-trip time
+             @param requestId The id of the request
+             @param roundTripInUs The time elapsed between the request writing and the reception
+                                  of its response, in microseconds */
+         void roundTripMeasured(quint64 requestId, qint64 roundTripInUs);
+
+    private:
+        /** @brief Test if the serial link has been created and if its thread is running */
+        bool isLinkValid() const;
+
+        /** @brief Connect the serial link signals to the interface ones */
+        void connectSerialLink();
+
     private:
          SerialLinkThread *_serialLinkThread{nullptr};
+         SerialLinkReactorThread *_reactorThread{nullptr};
+         SerialLink *_serialLink{nullptr};
+         SerialCaptureThread *_captureThread{nullptr};
          QString _interfaceName;
+         std::atomic<quint64> _nextRequestId{1};
 };
@@ -6,11 +6,13 @@
 
 #include <QDebug>
 #include <QMutex>
+#include <QSerialPort>
 #include <QSerialPortInfo>
 
 #include "threadutility/concurrent/threadconcurrentrun.hpp"
 
 #include "seriallinkintf.hpp"
+#include "seriallinkreactorthread.hpp"
 
 SerialLinkManager* SerialLinkManager::_instance = nullptr;
 
@@ -22,6 +24,10 @@ SerialLinkManager::SerialLinkManager(QObject *parent)
 
 SerialLinkManager::~SerialLinkManager()
 {
+    for(auto citer = _reactorThreads.cbegin(); citer != _reactorThreads.cend(); ++citer)
+    {
+        (*citer)->stopAndDeleteThread();
+    }
 }
 
 SerialLinkManager &SerialLinkManager::getInstance()
@@ -42,7 +48,24 @@ QSharedPointer<SerialLinkIntf> SerialLinkManager::getSerialLink(const QString &i
 QSharedPointer<SerialLinkIntf> SerialLinkManager::createOrGetSerialLink(
                                                                     const QSerialPortInfo &portInfo)
 {
-    return ThreadConcurrentRun::run(*this, &SerialLinkManager::createOrGetSerialLinkPriv, portInfo);
+    return createOrGetSerialLink(portInfo.systemLocation());
+}
+
+QSharedPointer<SerialLinkIntf> SerialLinkManager::createOrGetSerialLink(const QString &portName)
+{
+    return ThreadConcurrentRun::run(*this, &SerialLinkManager::createOrGetSerialLinkPriv, portName);
+}
+
+bool SerialLinkManager::setReactorThreadsNb(int reactorThreadsNb)
+{
+    if(reactorThreadsNb < 0)
+    {
+        qWarning() << "The number of reactor threads can't be negative: " << reactorThreadsNb;
+        return false;
+    }
+
+    _reactorThreadsNb = reactorThreadsNb;
+    return true;
 }
 
 QSharedPointer<SerialLinkIntf> SerialLinkManager::getSerialLinkPriv(const QString &interfaceName)
@@ -51,15 +74,28 @@ QSharedPointer<SerialLinkIntf> SerialLinkManager::getSerialLinkPriv(const QStrin
 }
 
 QSharedPointer<SerialLinkIntf> SerialLinkManager::createOrGetSerialLinkPriv(
-    const QSerialPortInfo &portInfo)
+    const QString &portName)
 {
-    const QString interfaceName = portInfo.portName();
+    if(portName.isEmpty())
+    {
+        qWarning() << "Can't create a serial link without port name";
+        return {};
+    }
+
+    // The serial port strips the system prefix of the location given, this is the same name as
+    // the one returned by QSerialPortInfo::portName for the listed ports
+    const QString interfaceName = QSerialPort(portName).portName();
 
-    auto createCanIntf = [&portInfo](const QString &key)
+    auto createCanIntf = [this, &portName](const QString &key)
     {
         SerialLinkIntf *serialLinkIntf = new SerialLinkIntf(key);
+        SerialLinkReactorThread *reactorThread = getLeastLoadedReactorThread();
 
-        if(!serialLinkIntf->initSerialLink(portInfo))
+        const bool success = (reactorThread != nullptr) ?
+                                 serialLinkIntf->initSerialLink(portName, *reactorThread) :
+                                 serialLinkIntf->initSerialLink(portName);
+
+        if(!success)
         {
             qWarning() << "A problem occurred when tried to initialize the serial link: " << key;
             delete serialLinkIntf;
@@ -74,6 +110,44 @@ QSharedPointer<SerialLinkIntf> SerialLinkManager::createOrGetSerialLinkPriv(
     return createOrGetHandler(interfaceName, createCanIntf);
 }
 
+SerialLinkReactorThread *SerialLinkManager::getLeastLoadedReactorThread()
+{
+    const int reactorThreadsNb = _reactorThreadsNb;
+    if(reactorThreadsNb == 0)
+    {
+        return nullptr;
+    }
+
+    SerialLinkReactorThread *leastLoaded = nullptr;
+    for(int idx = 0; idx < qMin(reactorThreadsNb, _reactorThreads.length()); ++idx)
+    {
+        SerialLinkReactorThread *reactorThread = _reactorThreads.at(idx);
+        if(leastLoaded == nullptr ||
+           reactorThread->getSerialLinksNb() < leastLoaded->getSerialLinksNb())
+        {
+            leastLoaded = reactorThread;
+        }
+    }
+
+    if(_reactorThreads.length() < reactorThreadsNb &&
+       (leastLoaded == nullptr || leastLoaded->getSerialLinksNb() > 0))
+    {
+        // All the reactor threads started serve links, we start a new one
+        SerialLinkReactorThread *reactorThread = new SerialLinkReactorThread();
+        if(!reactorThread->initReactor())
+        {
+            qWarning() << "A problem occurred when tried to start a serial link reactor thread";
+            reactorThread->stopAndDeleteThread();
+            return leastLoaded;
+        }
+
+        _reactorThreads.append(reactorThread);
+        leastLoaded = reactorThread;
+    }
+
+    return leastLoaded;
+}
+
 QVector<QSerialPortInfo> SerialLinkManager::findAllSerialPort(const QString &portName,
                                                               const QString &serialNumber,
                                                               quint16 usbVID,
@@ -7,11 +7,16 @@
 #include <QObject>
 #include "handlerutility/handlerclassmembersmixin.hpp"
 
+#include <atomic>
+
+#include <QVector>
+
 #include "definesseriallink.hpp"
 
 class QMutex;
 class QSerialPortInfo;
 class SerialLinkIntf;
+class SerialLinkReactorThread;
 
 
 /** @brief This class manages the serial link creation and getting */
@@ -52,6 +57,33 @@ class SERIALLINK_EXPORT SerialLinkManager : public QObject,
             @return The serial port created or a nullptr */
         QSharedPointer<SerialLinkIntf> createOrGetSerialLink(const QSerialPortInfo& portInfo);
 
+        /** @brief Create or get a serial link thanks to the serial port name given
+            @note If the interface already exists, it returns the serial port interface
+            @note This is useful to open serial ports which aren't listed by
+                  @ref QSerialPortInfo::availablePorts, as the pseudo terminals
+            @note This method is thread safe but required an event loop in the caller method
+            @param portName The name or the system location of the serial port
+                            (ex: "ttyUSB0", "/dev/pts/3" or "COM1")
+            @return The serial port created or a nullptr */
+        QSharedPointer<SerialLinkIntf> createOrGetSerialLink(const QString &portName);
+
+        /** @brief Set the number of reactor threads shared by the serial links created afterwards
+            @note By default (0), each serial link has its own thread. When a lot of ports are
+                  opened, the serial links can be hosted by a few reactor threads instead: each
+                  reactor serves all its ports with a single event loop. A new serial link is
+                  hosted by the reactor thread which has the fewest links.
+            @note The serial links already created keep their thread. The API of the
+                  @ref SerialLinkIntf is the same in the both modes.
+            @note This method is thread safe
+            @param reactorThreadsNb The number of reactor threads, 0 to give a dedicated thread to
+                                    each serial link
+            @return True if no problem occurred */
+        bool setReactorThreadsNb(int reactorThreadsNb);
+
+        /** @brief Get the number of reactor threads shared by the serial links
+            @note 0 means that each serial link has its own thread */
+        int getReactorThreadsNb() const { return _reactorThreadsNb; }
+
     private:
         /** @brief Get a serial link thanks to its interface name
             @note The interface has to be created before to be got by this method
@@ -60,11 +92,20 @@ class SERIALLINK_EXPORT SerialLinkManager : public QObject,
             @return Get the serial link found or a nullptr */
         QSharedPointer<SerialLinkIntf> getSerialLinkPriv(const QString &interfaceName);
 
-        /** @brief Create or get a serial link thanks to the serial port info given
+        /** @brief Create or get a serial link thanks to the serial port name given
             @note If the interface already exists, it returns the serial port interface
-            @param portInfo The interface port info to create the serial link interface
+            @note The interface name is the port name without the system prefix (ex: "ttyUSB0"
+                  for "/dev/ttyUSB0"), therefore the same link is got with the port name or its
+                  system location
+            @param portName The name or the system location of the serial port
             @return The serial port created or a nullptr */
-        QSharedPointer<SerialLinkIntf> createOrGetSerialLinkPriv(const QSerialPortInfo& portInfo);
+        QSharedPointer<SerialLinkIntf> createOrGetSerialLinkPriv(const QString &portName);
+
+        /** @brief Get the reactor thread which has to host the next serial link created
+            @note The reactor threads are started on demand
+            @return The reactor thread which has the fewest links, or nullptr if the links have to
+                    get a dedicated thread (or if a problem occurred) */
+        SerialLinkReactorThread *getLeastLoadedReactorThread();
 
     public:
         /** @brief Find all the serial ports matching all non-empty rules
@@ -88,4 +129,8 @@ class SERIALLINK_EXPORT SerialLinkManager : public QObject,
 
     private:
         static SerialLinkManager *_instance;
+
+    private:
+        std::atomic_int _reactorThreadsNb{0};
+        QVector<SerialLinkReactorThread *> _reactorThreads;
 };
@@ -0,0 +1,22 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "seriallinkreactor.hpp"
+
+#include "seriallink.hpp"
+
+
+SerialLinkReactor::SerialLinkReactor(QObject *parent)
+    : QObject{parent}
+{
+}
+
+SerialLinkReactor::~SerialLinkReactor()
+{
+}
+
+SerialLink *SerialLinkReactor::createSerialLink(const QString &portName)
+{
+    return new SerialLink(portName, this);
+}
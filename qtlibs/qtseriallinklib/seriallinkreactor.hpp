@@ -0,0 +1,36 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+class SerialLink;
+
+
+/** @brief This object lives in a @ref SerialLinkReactorThread and hosts all the serial links the
+           thread serves
+    @note The hosted links share the event loop of the thread: the event dispatcher waits for the
+          readiness of all their ports with a single poll, and each port reads its bytes in its own
+          buffer. This avoids to have one idle thread by port when a lot of ports are opened. */
+class SerialLinkReactor : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit SerialLinkReactor(QObject *parent = nullptr);
+
+        /** @brief Class destructor
+            @note The serial links still hosted are deleted with the reactor */
+        virtual ~SerialLinkReactor() override;
+
+    public:
+        /** @brief Create a serial link hosted by the reactor
+            @note The method has to be called in the reactor thread
+            @param portName The name or the system location of the serial port to wrap
+            @return The serial link created */
+        SerialLink *createSerialLink(const QString &portName);
+};
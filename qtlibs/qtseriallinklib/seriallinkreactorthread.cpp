@@ -0,0 +1,103 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "seriallinkreactorthread.hpp"
+
+#include "definesutility/definesutility.hpp"
+#include "threadutility/concurrent/threadconcurrentrun.hpp"
+
+#include "seriallink.hpp"
+#include "seriallinkreactor.hpp"
+
+#include <QDebug>
+#include <QTimer>
+
+
+SerialLinkReactorThread::SerialLinkReactorThread(QObject *parent)
+    : BaseThread{parent},
+      _reactor{new SerialLinkReactor()}
+{
+    _reactor->moveToThread(this);
+}
+
+SerialLinkReactorThread::~SerialLinkReactorThread()
+{
+    // If the thread has never been started, the reactor hasn't been deleted
+    delete _reactor;
+}
+
+bool SerialLinkReactorThread::initReactor()
+{
+    if(_valid)
+    {
+        qInfo() << "The serial link reactor has already been initialized, do nothing";
+        return true;
+    }
+
+    if(_reactor == nullptr)
+    {
+        qWarning() << "The serial link reactor thread has been stopped, it can't be restarted";
+        return false;
+    }
+
+    RETURN_IF_FALSE(startThreadAndWaitToBeReady());
+
+    _valid = true;
+
+    return true;
+}
+
+SerialLink *SerialLinkReactorThread::createSerialLink(const QString &portName)
+{
+    if(!_valid)
+    {
+        qWarning() << "Can't create the serial link: " << portName << ", the reactor thread isn't "
+                   << "valid, may be the thread hasn't be initialized or it's stopped";
+        return nullptr;
+    }
+
+    SerialLink *serialLink = ThreadConcurrentRun::run(*_reactor,
+                                                      &SerialLinkReactor::createSerialLink,
+                                                      portName);
+    if(serialLink != nullptr)
+    {
+        ++_serialLinksNb;
+    }
+
+    return serialLink;
+}
+
+void SerialLinkReactorThread::deleteSerialLink(SerialLink *serialLink)
+{
+    if(serialLink == nullptr || !_valid)
+    {
+        // When the thread is stopped, the links have been deleted with the reactor
+        return;
+    }
+
+    QTimer::singleShot(0, serialLink, &SerialLink::deleteLater);
+    --_serialLinksNb;
+}
+
+bool SerialLinkReactorThread::stopThread()
+{
+    _valid = false;
+
+    if(_reactor != nullptr)
+    {
+        if(isRunning())
+        {
+            QTimer::singleShot(0, _reactor, &SerialLinkReactor::deleteLater);
+        }
+        else
+        {
+            delete _reactor;
+        }
+
+        _reactor = nullptr;
+        _serialLinksNb = 0;
+    }
+
+    return BaseThread::stopThread();
+}
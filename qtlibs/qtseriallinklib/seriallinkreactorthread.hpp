@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+#include <atomic>
+
+class SerialLink;
+class SerialLinkReactor;
+
+
+/** @brief This thread serves several serial links with a single event loop
+    @note By default, each serial link has its own @ref SerialLinkThread. When a lot of mostly idle
+          ports are opened, the threads and their context switches cost more than the links
+          themselves; in that case, the @ref SerialLinkManager can share a few reactor threads
+          between all the links, see @ref SerialLinkManager::setReactorThreadsNb
+    @note The calls of the methods are thread safe */
+class SerialLinkReactorThread : public BaseThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit SerialLinkReactorThread(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~SerialLinkReactorThread() override;
+
+    public:
+        /** @brief Start the thread and wait for it to be ready to host serial links
+            @return True if no problem occurred */
+        bool initReactor();
+
+        /** @brief Create a serial link hosted by the thread
+            @note The method waits for the serial link creation in the reactor thread
+            @param portName The name or the system location of the serial port to wrap
+            @return The serial link created or nullptr if a problem occurred */
+        SerialLink *createSerialLink(const QString &portName);
+
+        /** @brief Delete a serial link hosted by the thread
+            @note The link is deleted later in the reactor thread, the method doesn't wait for it
+            @param serialLink The serial link to delete */
+        void deleteSerialLink(SerialLink *serialLink);
+
+        /** @brief Get the number of serial links hosted by the thread */
+        int getSerialLinksNb() const { return _serialLinksNb; }
+
+        /** @brief Test if the thread is valid (if it's started and not stopped)
+            @return True if the object is valid */
+        bool isValid() const { return _valid; }
+
+    public slots:
+        /** @brief Call to stop the thread
+            @note The serial links still hosted are deleted
+            @return True if no problem occurs */
+        virtual bool stopThread() override;
+
+    private:
+        SerialLinkReactor *_reactor{nullptr};
+        std::atomic_int _serialLinksNb{0};
+        std::atomic_bool _valid{false};
+};
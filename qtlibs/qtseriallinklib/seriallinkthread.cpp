@@ -9,7 +9,6 @@
 #include "definesutility/definesutility.hpp"
 
 #include <QDebug>
-#include <QSerialPortInfo>
 #include <QTimer>
 
 
@@ -22,7 +21,7 @@ SerialLinkThread::~SerialLinkThread()
 {
 }
 
-bool SerialLinkThread::initSerialLink(const QSerialPortInfo &serialPortInfo)
+bool SerialLinkThread::initSerialLink(const QString &portName)
 {
     if(_valid)
     {
@@ -30,13 +29,19 @@ bool SerialLinkThread::initSerialLink(const QSerialPortInfo &serialPortInfo)
         return true;
     }
 
-    if(!_serialPortInfo.isNull())
+    if(!_portName.isEmpty())
     {
         qWarning() << "The serial link thread has already been initialized";
         return false;
     }
 
-    _serialPortInfo = serialPortInfo;
+    if(portName.isEmpty())
+    {
+        qWarning() << "Can't initialize a serial link without port name";
+        return false;
+    }
+
+    _portName = portName;
 
     RETURN_IF_FALSE(startThreadAndWaitToBeReady());
 
@@ -60,7 +65,7 @@ bool SerialLinkThread::stopThread()
 
 void SerialLinkThread::run()
 {
-    _serialLink = new SerialLink(_serialPortInfo);
+    _serialLink = new SerialLink(_portName);
 
     BaseThread::run();
 }
@@ -6,7 +6,7 @@
 
 #include "threadutility/basethread.hpp"
 
-#include <QSerialPortInfo>
+#include <QString>
 
 class SerialLink;
 
@@ -28,9 +28,10 @@ class SerialLinkThread : public BaseThread
 
     public:
         /** @brief Initialize the serial link to work
-            @param serialPortInfo The information needed to create the serial port
+            @param portName The name or the system location of the serial port to create
+                            (ex: "ttyUSB0", "/dev/pts/3" or "COM1")
             @return True if no problem occurred */
-        bool initSerialLink(const QSerialPortInfo &serialPortInfo);
+        bool initSerialLink(const QString &portName);
 
         /** @brief Access the serial link created in the thread
             @warning The serial link is created in the run of this thread; therefore, the caller of
@@ -53,6 +54,6 @@ class SerialLinkThread : public BaseThread
 
     private:
         SerialLink *_serialLink{nullptr};
-        QSerialPortInfo _serialPortInfo;
+        QString _portName;
         bool _valid{false};
 };
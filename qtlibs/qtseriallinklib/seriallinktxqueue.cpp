@@ -0,0 +1,315 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "seriallinktxqueue.hpp"
+
+#include <QDebug>
+#include <QMutexLocker>
+
+#include "capture/serialcapturequeue.hpp"
+#include "seriallibconstants.hpp"
+
+
+SerialLinkTxQueue::SerialLinkTxQueue(QSerialPort &serial, QObject *parent)
+    : QObject{parent},
+    _serial{serial}
+{
+    connect(&_serial, &QSerialPort::bytesWritten, this, &SerialLinkTxQueue::onBytesWritten);
+    connect(&_serial, &QSerialPort::errorOccurred, this, &SerialLinkTxQueue::onErrorOccurred);
+
+    _statsTimer.start();
+}
+
+SerialLinkTxQueue::~SerialLinkTxQueue()
+{
+}
+
+quint64 SerialLinkTxQueue::enqueue(const QByteArray &data)
+{
+    if(data.isEmpty())
+    {
+        qWarning() << "We can't send an empty packet on the serial port";
+        return 0;
+    }
+
+    QMutexLocker locker(&_mutex);
+
+    PendingPacket packet;
+    packet.id = _nextSendId++;
+    packet.data = data;
+
+    _pendingPackets.append(packet);
+    _queuedBytesNb += data.length();
+    _highWaterMarkBytesNb = qMax(_highWaterMarkBytesNb, _queuedBytesNb + _inFlightBytesNb);
+
+    if(!_writeScheduled)
+    {
+        // All the packets enqueued until the serial link thread runs are written together
+        _writeScheduled = true;
+        QMetaObject::invokeMethod(this, [this]() { writePending(); }, Qt::QueuedConnection);
+    }
+
+    return packet.id;
+}
+
+void SerialLinkTxQueue::writePending()
+{
+    QVector<PendingPacket> packets;
+
+    {
+        QMutexLocker locker(&_mutex);
+        packets.swap(_pendingPackets);
+        _queuedBytesNb = 0;
+        _writeScheduled = false;
+    }
+
+    int firstIdx = 0;
+    int packetsNb = 0;
+    qint64 bytesNb = 0;
+
+    for(int idx = 0; idx < packets.length(); ++idx)
+    {
+        const qint64 packetSize = packets.at(idx).data.length();
+
+        if(packetsNb > 0 && (bytesNb + packetSize) > MaxCoalescedBytesNb)
+        {
+            writeCoalesced(packets, firstIdx, packetsNb, bytesNb);
+            firstIdx = idx;
+            packetsNb = 0;
+            bytesNb = 0;
+        }
+
+        ++packetsNb;
+        bytesNb += packetSize;
+    }
+
+    if(packetsNb > 0)
+    {
+        writeCoalesced(packets, firstIdx, packetsNb, bytesNb);
+    }
+}
+
+void SerialLinkTxQueue::notifyDirectWrite(qint64 bytesNb)
+{
+    if(bytesNb <= 0)
+    {
+        return;
+    }
+
+    InFlightPacket packet;
+    packet.id = DirectWriteId;
+    packet.remainingBytesNb = bytesNb;
+    _inFlightPackets.enqueue(packet);
+
+    QMutexLocker locker(&_mutex);
+    _inFlightBytesNb += bytesNb;
+}
+
+void SerialLinkTxQueue::clear()
+{
+    QVector<PendingPacket> packets;
+
+    {
+        QMutexLocker locker(&_mutex);
+        packets.swap(_pendingPackets);
+        _queuedBytesNb = 0;
+        _failedPacketsNb += static_cast<quint64>(packets.length());
+    }
+
+    for(auto citer = packets.cbegin(); citer != packets.cend(); ++citer)
+    {
+        emit sendFinished(citer->id, false);
+    }
+
+    if(_serial.isOpen())
+    {
+        // The in flight packets may still be in the serial port buffer
+        _serial.clear(QSerialPort::Output);
+    }
+
+    failInFlightPackets();
+}
+
+SerialLinkTxStats SerialLinkTxQueue::getStats() const
+{
+    QMutexLocker locker(&_mutex);
+
+    return SerialLinkTxStats(_pendingPackets.length() + _inFlightPacketsNb,
+                             _queuedBytesNb + _inFlightBytesNb,
+                             _highWaterMarkBytesNb,
+                             _sentPacketsNb,
+                             _failedPacketsNb,
+                             _writtenBytesNb,
+                             _writeCallsNb,
+                             _statsTimer.elapsed());
+}
+
+void SerialLinkTxQueue::resetStats()
+{
+    QMutexLocker locker(&_mutex);
+
+    _highWaterMarkBytesNb = _queuedBytesNb + _inFlightBytesNb;
+    _sentPacketsNb = 0;
+    _failedPacketsNb = 0;
+    _writtenBytesNb = 0;
+    _writeCallsNb = 0;
+    _statsTimer.restart();
+}
+
+void SerialLinkTxQueue::setCaptureQueue(const QSharedPointer<SerialCaptureQueue> &captureQueue)
+{
+    _captureQueue = captureQueue;
+}
+
+void SerialLinkTxQueue::onBytesWritten(qint64 bytesNb)
+{
+    QVector<quint64> sentIds;
+    qint64 remainingBytesNb = bytesNb;
+
+    while(remainingBytesNb > 0 && !_inFlightPackets.isEmpty())
+    {
+        InFlightPacket &packet = _inFlightPackets.head();
+        const qint64 consumedBytesNb = qMin(packet.remainingBytesNb, remainingBytesNb);
+
+        packet.remainingBytesNb -= consumedBytesNb;
+        remainingBytesNb -= consumedBytesNb;
+
+        if(packet.remainingBytesNb == 0)
+        {
+            const quint64 sentId = _inFlightPackets.dequeue().id;
+
+            if(sentId != DirectWriteId)
+            {
+                sentIds.append(sentId);
+            }
+        }
+    }
+
+    {
+        QMutexLocker locker(&_mutex);
+        _inFlightPacketsNb -= sentIds.length();
+        _inFlightBytesNb = qMax(static_cast<qint64>(0), _inFlightBytesNb - bytesNb);
+        _writtenBytesNb += static_cast<quint64>(bytesNb);
+        _sentPacketsNb += static_cast<quint64>(sentIds.length());
+    }
+
+    for(auto citer = sentIds.cbegin(); citer != sentIds.cend(); ++citer)
+    {
+        emit sendFinished(*citer, true);
+    }
+}
+
+void SerialLinkTxQueue::onErrorOccurred(QSerialPort::SerialPortError error)
+{
+    if(error != QSerialPort::WriteError && error != QSerialPort::ResourceError)
+    {
+        return;
+    }
+
+    qWarning() << "A write error occurred on the serial port: " << _serial.portName()
+               << ", the in flight packets are abandoned, error: " << _serial.errorString();
+
+    failInFlightPackets();
+}
+
+void SerialLinkTxQueue::writeCoalesced(const QVector<PendingPacket> &packets,
+                                       int firstIdx,
+                                       int packetsNb,
+                                       qint64 bytesNb)
+{
+    const int lastIdx = firstIdx + packetsNb;
+
+    QByteArray buffer;
+    if(packetsNb == 1)
+    {
+        // No copy is needed for a lonely packet
+        buffer = packets.at(firstIdx).data;
+    }
+    else
+    {
+        buffer.reserve(static_cast<int>(bytesNb));
+        for(int idx = firstIdx; idx < lastIdx; ++idx)
+        {
+            buffer.append(packets.at(idx).data);
+        }
+    }
+
+    if(Q_UNLIKELY(SerialLibConstants::Debug::Stream))
+    {
+        qDebug() << _serial.portName() << " <<< " << buffer;
+    }
+
+    const qint64 writtenBytes = _serial.write(buffer);
+
+    if(_captureQueue != nullptr && writtenBytes > 0)
+    {
+        _captureQueue->capture(SerialCaptureDirection::Tx,
+                               buffer.left(static_cast<int>(writtenBytes)));
+    }
+
+    if(Q_UNLIKELY(writtenBytes != buffer.length()))
+    {
+        qWarning() << "An error occurred with the serial port: " << _serial.portName() << ", when "
+                   << "trying to write: " << packetsNb << " packets, " << writtenBytes
+                   << " bytes written out of " << buffer.length() << ". The error is: "
+                   << _serial.errorString();
+
+        {
+            QMutexLocker locker(&_mutex);
+            ++_writeCallsNb;
+            _failedPacketsNb += static_cast<quint64>(packetsNb);
+        }
+
+        for(int idx = firstIdx; idx < lastIdx; ++idx)
+        {
+            emit sendFinished(packets.at(idx).id, false);
+        }
+
+        return;
+    }
+
+    for(int idx = firstIdx; idx < lastIdx; ++idx)
+    {
+        InFlightPacket packet;
+        packet.id = packets.at(idx).id;
+        packet.remainingBytesNb = packets.at(idx).data.length();
+        _inFlightPackets.enqueue(packet);
+    }
+
+    {
+        QMutexLocker locker(&_mutex);
+        ++_writeCallsNb;
+        _inFlightPacketsNb += packetsNb;
+        _inFlightBytesNb += bytesNb;
+    }
+
+    // The flush is done after the in flight packets registering, because the serial port may
+    // notify the written bytes while flushing
+    if(_flushEachWrite && Q_UNLIKELY(!_serial.flush()))
+    {
+        qWarning() << "Flush failed, when tried to send data on the serial port: "
+                   << _serial.portName();
+    }
+}
+
+void SerialLinkTxQueue::failInFlightPackets()
+{
+    const QQueue<InFlightPacket> packets = _inFlightPackets;
+    _inFlightPackets.clear();
+
+    {
+        QMutexLocker locker(&_mutex);
+        _failedPacketsNb += static_cast<quint64>(_inFlightPacketsNb);
+        _inFlightPacketsNb = 0;
+        _inFlightBytesNb = 0;
+    }
+
+    for(auto citer = packets.cbegin(); citer != packets.cend(); ++citer)
+    {
+        if(citer->id != DirectWriteId)
+        {
+            emit sendFinished(citer->id, false);
+        }
+    }
+}
@@ -0,0 +1,175 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+#include <QQueue>
+#include <QSerialPort>
+#include <QSharedPointer>
+#include <QVector>
+
+#include "seriallinktxstats.hpp"
+
+class SerialCaptureQueue;
+
+
+/** @brief This is the asynchronous transmit queue of a serial link
+    @note The object lives in the serial link thread but @ref enqueue, @ref getStats and
+          @ref resetStats can be called from any thread: the packets are stored under a mutex and
+          the serial link thread is woken up once for all the packets enqueued before it runs.
+    @note When the serial link thread processes the queue, the waiting packets are coalesced in a
+          few large binary-safe writes (of @ref MaxCoalescedBytesNb bytes at most), instead of one
+          write by packet.
+    @note A packet is considered as sent when the serial port notifies, with
+          @ref QSerialPort::bytesWritten, that all its bytes have been written. */
+class SerialLinkTxQueue : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief A packet waiting to be given to the serial port */
+        struct PendingPacket
+        {
+            /** @brief The packet id, given back with @ref sendFinished */
+            quint64 id{0};
+
+            /** @brief The packet data */
+            QByteArray data{};
+        };
+
+        /** @brief A packet given to the serial port and waiting to be written */
+        struct InFlightPacket
+        {
+            /** @brief The packet id, given back with @ref sendFinished
+                @note The id is equal to @ref DirectWriteId for bytes directly written on the
+                      serial port */
+            quint64 id{0};
+
+            /** @brief The number of bytes of the packet not yet written by the serial port */
+            qint64 remainingBytesNb{0};
+        };
+
+    public:
+        /** @brief Class constructor
+            @param serial The serial port where the packets are written
+            @param parent The class parent */
+        explicit SerialLinkTxQueue(QSerialPort &serial, QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~SerialLinkTxQueue() override;
+
+    public:
+        /** @brief Add a packet to write
+            @note The method is threadsafe and doesn't wait for the writing
+            @note The end of the packet writing is notified with @ref sendFinished
+            @param data The packet to write
+            @return The packet id, 0 if the packet is empty */
+        quint64 enqueue(const QByteArray &data);
+
+        /** @brief Give all the waiting packets to the serial port
+            @note This has to be called in the serial link thread
+            @note This is useful to keep the packets order, before writing directly on the serial
+                  port */
+        void writePending();
+
+        /** @brief Notify the queue that bytes have been directly written on the serial port,
+                   without the queue
+            @note This has to be called in the serial link thread
+            @note This keeps the link between the written bytes, notified by the serial port, and
+                  the queued packets
+            @param bytesNb The number of bytes directly written */
+        void notifyDirectWrite(qint64 bytesNb);
+
+        /** @brief Abandon all the waiting and in flight packets
+            @note This has to be called in the serial link thread
+            @note @ref sendFinished is emitted with a failure for each abandoned packet */
+        void clear();
+
+        /** @brief Get a snapshot of the queue statistics
+            @note The method is threadsafe */
+        SerialLinkTxStats getStats() const;
+
+        /** @brief Reset the queue statistics counters
+            @note The method is threadsafe
+            @note The pending packets and bytes aren't counters and so aren't reset */
+        void resetStats();
+
+        /** @brief Set the queue where the written bytes are captured
+            @note This has to be called in the serial link thread
+            @param captureQueue The capture queue, nullptr to stop capturing */
+        void setCaptureQueue(const QSharedPointer<SerialCaptureQueue> &captureQueue);
+
+        /** @brief Set if the serial port is flushed after each coalesced write
+            @note This has to be called in the serial link thread
+            @note By default, the serial port writes the bytes given at the next event loop
+                  iteration; flushing gives them to the driver at once, which reduces the latency
+                  but prevents the serial port from grouping several writes
+            @param flushEachWrite True to flush the serial port after each write */
+        void setFlushEachWrite(bool flushEachWrite) { _flushEachWrite = flushEachWrite; }
+
+    signals:
+        /** @brief Emitted when a packet writing is finished
+            @param sendId The id of the packet, returned by @ref enqueue
+            @param success True if all the packet bytes have been written */
+        void sendFinished(quint64 sendId, bool success);
+
+    private slots:
+        /** @brief Called when the serial port has written bytes
+            @param bytesNb The number of bytes written */
+        void onBytesWritten(qint64 bytesNb);
+
+        /** @brief Called when an error occurred on the serial port
+            @param error The error which occurred */
+        void onErrorOccurred(QSerialPort::SerialPortError error);
+
+    private:
+        /** @brief Write the packets given in one write call
+            @param packets The packets to write
+            @param firstIdx The index of the first packet to write
+            @param packetsNb The number of packets to write
+            @param bytesNb The sum of the packets sizes */
+        void writeCoalesced(const QVector<PendingPacket> &packets,
+                            int firstIdx,
+                            int packetsNb,
+                            qint64 bytesNb);
+
+        /** @brief Abandon all the in flight packets and emit @ref sendFinished for each of them */
+        void failInFlightPackets();
+
+    private:
+        /** @brief The max number of bytes given to the serial port in one write call
+            @note A packet bigger than this value is written alone */
+        static const constexpr qint64 MaxCoalescedBytesNb = 64 * 1024;
+
+        /** @brief The in flight packet id used for the bytes directly written on the serial port
+            @note The ids returned by @ref enqueue start at 1 */
+        static const constexpr quint64 DirectWriteId = 0;
+
+    private:
+        QSerialPort &_serial;
+
+        mutable QMutex _mutex;
+        QVector<PendingPacket> _pendingPackets;
+        bool _writeScheduled{false};
+        quint64 _nextSendId{1};
+        qint64 _queuedBytesNb{0};
+        int _inFlightPacketsNb{0};
+        qint64 _inFlightBytesNb{0};
+        qint64 _highWaterMarkBytesNb{0};
+        quint64 _sentPacketsNb{0};
+        quint64 _failedPacketsNb{0};
+        quint64 _writtenBytesNb{0};
+        quint64 _writeCallsNb{0};
+        QElapsedTimer _statsTimer;
+
+        QQueue<InFlightPacket> _inFlightPackets;
+
+        QSharedPointer<SerialCaptureQueue> _captureQueue;
+        bool _flushEachWrite{false};
+};
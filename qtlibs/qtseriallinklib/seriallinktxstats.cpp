@@ -0,0 +1,63 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "seriallinktxstats.hpp"
+
+#include <QString>
+
+
+SerialLinkTxStats::SerialLinkTxStats(int pendingPacketsNb,
+                                     qint64 pendingBytesNb,
+                                     qint64 highWaterMarkBytesNb,
+                                     quint64 sentPacketsNb,
+                                     quint64 failedPacketsNb,
+                                     quint64 writtenBytesNb,
+                                     quint64 writeCallsNb,
+                                     qint64 elapsedTimeInMs)
+    : _pendingPacketsNb{pendingPacketsNb},
+    _pendingBytesNb{pendingBytesNb},
+    _highWaterMarkBytesNb{highWaterMarkBytesNb},
+    _sentPacketsNb{sentPacketsNb},
+    _failedPacketsNb{failedPacketsNb},
+    _writtenBytesNb{writtenBytesNb},
+    _writeCallsNb{writeCallsNb},
+    _elapsedTimeInMs{elapsedTimeInMs}
+{
+}
+
+double SerialLinkTxStats::getAveragePacketsByWrite() const
+{
+    if(_writeCallsNb == 0)
+    {
+        return 0.0;
+    }
+
+    return static_cast<double>(_sentPacketsNb + _failedPacketsNb) /
+           static_cast<double>(_writeCallsNb);
+}
+
+double SerialLinkTxStats::getThroughputInBytesPerSec() const
+{
+    if(_elapsedTimeInMs <= 0)
+    {
+        return 0.0;
+    }
+
+    return (static_cast<double>(_writtenBytesNb) * MsInSecond) /
+           static_cast<double>(_elapsedTimeInMs);
+}
+
+QString SerialLinkTxStats::toString() const
+{
+    return QString("pending: %1 packets (%2 bytes), high water mark: %3 bytes, sent: %4, "
+                   "failed: %5, written: %6 bytes in %7 writes, throughput: %8 B/s")
+        .arg(_pendingPacketsNb)
+        .arg(_pendingBytesNb)
+        .arg(_highWaterMarkBytesNb)
+        .arg(_sentPacketsNb)
+        .arg(_failedPacketsNb)
+        .arg(_writtenBytesNb)
+        .arg(_writeCallsNb)
+        .arg(getThroughputInBytesPerSec(), 0, 'f', 1);
+}
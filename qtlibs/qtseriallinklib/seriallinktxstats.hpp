@@ -0,0 +1,84 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QString>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief This is a snapshot of the statistics of a @ref SerialLinkTxQueue
+    @note The counters are accumulated since the queue creation or since the last reset */
+class SERIALLINK_EXPORT SerialLinkTxStats
+{
+    public:
+        /** @brief Class constructor
+            @param pendingPacketsNb The number of packets waiting to be written
+            @param pendingBytesNb The number of bytes waiting to be written
+            @param highWaterMarkBytesNb The max number of bytes which has been waiting
+            @param sentPacketsNb The number of packets entirely written on the serial port
+            @param failedPacketsNb The number of packets which failed to be written
+            @param writtenBytesNb The number of bytes written on the serial port
+            @param writeCallsNb The number of write calls done on the serial port, a write call
+                                may contain several coalesced packets
+            @param elapsedTimeInMs The time elapsed since the counters start */
+        explicit SerialLinkTxStats(int pendingPacketsNb = 0,
+                                   qint64 pendingBytesNb = 0,
+                                   qint64 highWaterMarkBytesNb = 0,
+                                   quint64 sentPacketsNb = 0,
+                                   quint64 failedPacketsNb = 0,
+                                   quint64 writtenBytesNb = 0,
+                                   quint64 writeCallsNb = 0,
+                                   qint64 elapsedTimeInMs = 0);
+
+    public:
+        /** @brief Get the number of packets waiting to be written, when the snapshot was taken
+            @note It contains the packets given to the serial port and not yet written */
+        int getPendingPacketsNb() const { return _pendingPacketsNb; }
+
+        /** @brief Get the number of bytes waiting to be written, when the snapshot was taken */
+        qint64 getPendingBytesNb() const { return _pendingBytesNb; }
+
+        /** @brief Get the max number of bytes which has been waiting to be written */
+        qint64 getHighWaterMarkBytesNb() const { return _highWaterMarkBytesNb; }
+
+        /** @brief Get the number of packets entirely written on the serial port */
+        quint64 getSentPacketsNb() const { return _sentPacketsNb; }
+
+        /** @brief Get the number of packets which failed to be written */
+        quint64 getFailedPacketsNb() const { return _failedPacketsNb; }
+
+        /** @brief Get the number of bytes written on the serial port */
+        quint64 getWrittenBytesNb() const { return _writtenBytesNb; }
+
+        /** @brief Get the number of write calls done on the serial port */
+        quint64 getWriteCallsNb() const { return _writeCallsNb; }
+
+        /** @brief Get the time elapsed since the counters start */
+        qint64 getElapsedTimeInMs() const { return _elapsedTimeInMs; }
+
+        /** @brief Get the average number of packets coalesced in a write call */
+        double getAveragePacketsByWrite() const;
+
+        /** @brief Get the average throughput since the counters start, in bytes per second */
+        double getThroughputInBytesPerSec() const;
+
+        /** @brief Get a string representation of the stats, useful for logs */
+        QString toString() const;
+
+    private:
+        /** @brief The number of milliseconds in a second */
+        static const constexpr double MsInSecond = 1000.0;
+
+    private:
+        int _pendingPacketsNb;
+        qint64 _pendingBytesNb;
+        qint64 _highWaterMarkBytesNb;
+        quint64 _sentPacketsNb;
+        quint64 _failedPacketsNb;
+        quint64 _writtenBytesNb;
+        quint64 _writeCallsNb;
+        qint64 _elapsedTimeInMs;
+};
@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialporttuning.hpp"
+
+#include <QDebug>
+#include <QSerialPort>
+
+#ifdef Q_OS_LINUX
+#include <cerrno>
+#include <cstring>
+#include <linux/serial.h>
+#include <sys/ioctl.h>
+#endif
+
+
+bool SerialPortTuning::setLowLatency(QSerialPort &serialPort, bool lowLatency)
+{
+    if(!serialPort.isOpen())
+    {
+        qWarning() << "Can't tune the latency of the serial port: " << serialPort.portName()
+                   << ", it isn't open";
+        return false;
+    }
+
+#ifdef Q_OS_LINUX
+    const int descriptor = static_cast<int>(serialPort.handle());
+
+    serial_struct serialInfo;
+    if(ioctl(descriptor, TIOCGSERIAL, &serialInfo) != 0)
+    {
+        qInfo() << "The driver of the serial port: " << serialPort.portName() << ", doesn't "
+                << "manage the low latency flag, it isn't tuned";
+        return true;
+    }
+
+    if(lowLatency)
+    {
+        serialInfo.flags |= ASYNC_LOW_LATENCY;
+    }
+    else
+    {
+        serialInfo.flags &= ~ASYNC_LOW_LATENCY;
+    }
+
+    if(ioctl(descriptor, TIOCSSERIAL, &serialInfo) != 0)
+    {
+        qWarning() << "Can't set the low latency flag of the serial port: "
+                   << serialPort.portName() << ", error: " << strerror(errno);
+        return false;
+    }
+#else
+    Q_UNUSED(lowLatency)
+#endif
+
+    return true;
+}
@@ -0,0 +1,30 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QtGlobal>
+
+class QSerialPort;
+
+
+/** @brief Contains the system specific tunings of the serial ports, which aren't managed by
+           @ref QSerialPort */
+class SerialPortTuning
+{
+    public:
+        /** @brief Ask the driver of the serial port to not delay the received bytes
+            @note On Linux, this sets or clears the ASYNC_LOW_LATENCY flag of the driver: the
+                  flushing of the received bytes isn't delayed by the driver anymore
+            @note The VMIN/VTIME terminal settings aren't changed: @ref QSerialPort reads a non
+                  blocking file descriptor, they have no effect on it
+            @note The drivers which don't manage the ASYNC_LOW_LATENCY flag (as the pseudo
+                  terminals) aren't tuned; it's not considered as an error
+            @note On the other systems, the method does nothing
+            @param serialPort The serial port to tune, it has to be open
+            @param lowLatency True to enable the low latency, false to restore the default
+                              behavior
+            @return True if no problem occurred */
+        static bool setLowLatency(QSerialPort &serialPort, bool lowLatency);
+};
@@ -0,0 +1,568 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialfiletransfer.hpp"
+
+#include <QDebug>
+#include <QEventLoop>
+#include <QTimer>
+
+#include "crcutility/crchelper.hpp"
+
+#include "seriallinkintf.hpp"
+
+
+SerialFileTransfer::SerialFileTransfer(SerialLinkIntf &link, QObject *parent)
+    : QObject{parent},
+    _link{link},
+    _timer{new QTimer(this)}
+{
+    _timer->setSingleShot(true);
+    connect(_timer, &QTimer::timeout, this, &SerialFileTransfer::onTimeout);
+    connect(&_link, &SerialLinkIntf::dataReceived, this, &SerialFileTransfer::onDataReceived);
+}
+
+SerialFileTransfer::~SerialFileTransfer()
+{
+    if(isRunning())
+    {
+        finish(false, true);
+    }
+}
+
+void SerialFileTransfer::setProtocol(SerialTransferProtocol::Enum protocol)
+{
+    if(isRunning() || protocol == SerialTransferProtocol::Unknown)
+    {
+        qWarning() << "Can't set the file transfer protocol: "
+                   << SerialTransferProtocol::toString(protocol);
+        return;
+    }
+
+    _protocol = protocol;
+}
+
+void SerialFileTransfer::setWindowSize(int windowSize)
+{
+    if(isRunning() || windowSize < 1 || windowSize > MaxWindowSize)
+    {
+        qWarning() << "Can't set the file transfer window size: " << windowSize;
+        return;
+    }
+
+    _windowSize = windowSize;
+}
+
+void SerialFileTransfer::setTimeouts(int startTimeoutInMs, int answerTimeoutInMs)
+{
+    _startTimeoutInMs = startTimeoutInMs;
+    _answerTimeoutInMs = answerTimeoutInMs;
+}
+
+bool SerialFileTransfer::start(const QByteArray &image, const QString &fileName, qint64 startOffset)
+{
+    if(isRunning())
+    {
+        qWarning() << "Can't start the file transfer, a transfer is already in progress";
+        return false;
+    }
+
+    if(startOffset < 0 || startOffset > image.length() || (startOffset % BlockSize) != 0)
+    {
+        qWarning() << "Can't start the file transfer, the start offset: " << startOffset
+                   << ", isn't a block boundary of the image";
+        return false;
+    }
+
+    _image = image;
+    _fileName = fileName;
+
+    if(SerialTransferProtocol::hasHeaderBlock(_protocol) &&
+       createHeader(false).length() > BlockSize)
+    {
+        qWarning() << "Can't start the file transfer, the file name: " << fileName
+                   << ", is too long for the header block";
+        _image.clear();
+        return false;
+    }
+
+    _ackedOffset = startOffset;
+    _nextOffset = startOffset;
+    _retriesNb = 0;
+    _success = false;
+    _answers.clear();
+    _state = State::WaitingStart;
+    _elapsedTimer.start();
+
+    restartTimer(_startTimeoutInMs);
+
+    return true;
+}
+
+void SerialFileTransfer::cancel()
+{
+    if(!isRunning())
+    {
+        return;
+    }
+
+    finish(false, true);
+}
+
+bool SerialFileTransfer::waitForFinished()
+{
+    if(!isRunning())
+    {
+        return _success;
+    }
+
+    QEventLoop loop;
+    connect(this, &SerialFileTransfer::finished, &loop, &QEventLoop::quit);
+    loop.exec(QEventLoop::ExcludeUserInputEvents);
+
+    return _success;
+}
+
+qint64 SerialFileTransfer::getElapsedTimeInMs() const
+{
+    return _elapsedTimer.isValid() ? _elapsedTimer.elapsed() : 0;
+}
+
+void SerialFileTransfer::onDataReceived(const QByteArray &data)
+{
+    if(!isRunning())
+    {
+        return;
+    }
+
+    _answers.append(data);
+    processAnswers();
+}
+
+void SerialFileTransfer::onTimeout()
+{
+    switch(_state)
+    {
+        case State::WaitingStart:
+            qWarning() << "The receiver hasn't started the file transfer in time";
+            finish(false, true);
+            break;
+
+        case State::WaitingHeaderAck:
+            if(countRetry())
+            {
+                sendHeaderBlock(false);
+            }
+            break;
+
+        case State::WaitingDataStart:
+        case State::WaitingEndStart:
+            if(countRetry())
+            {
+                restartTimer(_answerTimeoutInMs);
+            }
+            break;
+
+        case State::SendingData:
+            // The unanswered blocks are written again
+            goBackToBlock(-1);
+            break;
+
+        case State::WaitingEotAck:
+            if(countRetry())
+            {
+                sendControl(Eot);
+            }
+            break;
+
+        case State::WaitingEndHeaderAck:
+            if(countRetry())
+            {
+                sendHeaderBlock(true);
+            }
+            break;
+
+        case State::Idle:
+            break;
+    }
+}
+
+void SerialFileTransfer::processAnswers()
+{
+    while(!_answers.isEmpty() && isRunning())
+    {
+        const quint8 answer = static_cast<quint8>(_answers.at(0));
+
+        if(answer == Can)
+        {
+            // A lonely CAN may be line noise, the receiver cancels with several CAN
+            if(_answers.length() < CancelBytesNb)
+            {
+                return;
+            }
+
+            if(static_cast<quint8>(_answers.at(1)) == Can)
+            {
+                qWarning() << "The file transfer has been cancelled by the receiver";
+                finish(false);
+                return;
+            }
+
+            _answers.remove(0, 1);
+            continue;
+        }
+
+        if(_state == State::SendingData)
+        {
+            if(answer != Ack && answer != Nak)
+            {
+                // The receiver may have sent several 'C' before receiving the first block
+                _answers.remove(0, 1);
+            }
+            else if(!processDataAnswer(answer))
+            {
+                return;
+            }
+
+            continue;
+        }
+
+        _answers.remove(0, 1);
+
+        switch(_state)
+        {
+            case State::WaitingStart:
+                if(answer != CrcRequest)
+                {
+                    break;
+                }
+
+                if(SerialTransferProtocol::hasHeaderBlock(_protocol))
+                {
+                    _state = State::WaitingHeaderAck;
+                    sendHeaderBlock(false);
+                }
+                else
+                {
+                    _state = State::SendingData;
+                    fillWindow();
+                }
+                break;
+
+            case State::WaitingHeaderAck:
+                if(answer == Ack)
+                {
+                    _retriesNb = 0;
+                    _state = State::WaitingDataStart;
+                    restartTimer(_answerTimeoutInMs);
+                }
+                else if(answer == Nak && countRetry())
+                {
+                    sendHeaderBlock(false);
+                }
+                break;
+
+            case State::WaitingDataStart:
+                if(answer == CrcRequest)
+                {
+                    _state = State::SendingData;
+                    fillWindow();
+                }
+                break;
+
+            case State::WaitingEotAck:
+                if(answer == Ack)
+                {
+                    _retriesNb = 0;
+
+                    if(!SerialTransferProtocol::hasHeaderBlock(_protocol))
+                    {
+                        finish(true);
+                        break;
+                    }
+
+                    _state = State::WaitingEndStart;
+                    restartTimer(_answerTimeoutInMs);
+                }
+                else if(answer == Nak && countRetry())
+                {
+                    // The YMODEM receivers answer NAK to the first EOT
+                    sendControl(Eot);
+                }
+                break;
+
+            case State::WaitingEndStart:
+                if(answer == CrcRequest)
+                {
+                    _state = State::WaitingEndHeaderAck;
+                    sendHeaderBlock(true);
+                }
+                break;
+
+            case State::WaitingEndHeaderAck:
+                if(answer == Ack)
+                {
+                    finish(true);
+                }
+                else if(answer == Nak && countRetry())
+                {
+                    sendHeaderBlock(true);
+                }
+                break;
+
+            case State::SendingData:
+            case State::Idle:
+                break;
+        }
+    }
+}
+
+bool SerialFileTransfer::processDataAnswer(quint8 answer)
+{
+    int blockNb = -1;
+
+    if(_windowSize > 1)
+    {
+        // In the streaming variant, the answer is followed by a block number
+        if(_answers.length() < 2)
+        {
+            return false;
+        }
+
+        blockNb = static_cast<quint8>(_answers.at(1));
+        _answers.remove(0, 2);
+    }
+    else
+    {
+        _answers.remove(0, 1);
+    }
+
+    if(answer == Ack)
+    {
+        acknowledgeBlocks(blockNb);
+    }
+    else
+    {
+        goBackToBlock(blockNb);
+    }
+
+    return true;
+}
+
+void SerialFileTransfer::acknowledgeBlocks(int blockNb)
+{
+    qint64 offset = -1;
+
+    if(blockNb >= 0)
+    {
+        offset = findInFlightBlock(blockNb);
+    }
+    else if(_nextOffset > _ackedOffset)
+    {
+        offset = _ackedOffset;
+    }
+
+    if(offset < 0)
+    {
+        // This is the late answer of a block already acknowledged
+        return;
+    }
+
+    _ackedOffset = qMin(offset + BlockSize, static_cast<qint64>(_image.length()));
+    _retriesNb = 0;
+
+    emit progress(_ackedOffset, _image.length());
+
+    fillWindow();
+}
+
+void SerialFileTransfer::goBackToBlock(int blockNb)
+{
+    const qint64 offset = (blockNb >= 0) ? findInFlightBlock(blockNb) : _ackedOffset;
+
+    if(offset < 0 || !countRetry())
+    {
+        return;
+    }
+
+    if(offset > _ackedOffset)
+    {
+        // The blocks before the expected one have been received
+        _ackedOffset = offset;
+        emit progress(_ackedOffset, _image.length());
+    }
+
+    _nextOffset = offset;
+
+    fillWindow();
+}
+
+qint64 SerialFileTransfer::findInFlightBlock(int blockNb) const
+{
+    for(qint64 offset = _ackedOffset; offset < _nextOffset; offset += BlockSize)
+    {
+        if(getBlockNb(offset) == blockNb)
+        {
+            return offset;
+        }
+    }
+
+    return -1;
+}
+
+void SerialFileTransfer::fillWindow()
+{
+    if(_state != State::SendingData)
+    {
+        return;
+    }
+
+    const qint64 imageSize = _image.length();
+    const qint64 windowBytesNb = static_cast<qint64>(_windowSize) * BlockSize;
+
+    while(_nextOffset < imageSize && (_nextOffset - _ackedOffset) < windowBytesNb)
+    {
+        sendDataBlock(_nextOffset);
+
+        if(!isRunning())
+        {
+            return;
+        }
+
+        _nextOffset = qMin(_nextOffset + BlockSize, imageSize);
+    }
+
+    if(_ackedOffset >= imageSize)
+    {
+        _state = State::WaitingEotAck;
+        sendControl(Eot);
+        return;
+    }
+
+    restartTimer(_answerTimeoutInMs);
+}
+
+void SerialFileTransfer::sendDataBlock(qint64 offset)
+{
+    const int length = static_cast<int>(qMin(static_cast<qint64>(BlockSize),
+                                             _image.length() - offset));
+
+    // The block content isn't copied from the image
+    sendBlock(getBlockNb(offset),
+              QByteArray::fromRawData(_image.constData() + offset, length),
+              static_cast<char>(Sub));
+}
+
+QByteArray SerialFileTransfer::createHeader(bool nullHeader) const
+{
+    QByteArray header;
+
+    if(nullHeader)
+    {
+        return header;
+    }
+
+    header.append(_fileName.toLatin1());
+    header.append('\0');
+    header.append(QByteArray::number(_image.length()));
+    header.append('\0');
+
+    return header;
+}
+
+void SerialFileTransfer::sendHeaderBlock(bool nullHeader)
+{
+    if(sendBlock(0, createHeader(nullHeader), '\0'))
+    {
+        restartTimer(_answerTimeoutInMs);
+    }
+}
+
+bool SerialFileTransfer::sendBlock(quint8 blockNb, const QByteArray &data, char padding)
+{
+    const int blockSize = (data.length() <= SmallBlockSize) ? SmallBlockSize : BlockSize;
+
+    QByteArray block;
+    block.reserve(BlockHeaderSize + blockSize + CrcSize);
+    block.append(static_cast<char>((blockSize == SmallBlockSize) ? Soh : Stx));
+    block.append(static_cast<char>(blockNb));
+    block.append(static_cast<char>(~blockNb));
+    block.append(data);
+    block.append(blockSize - data.length(), padding);
+
+    const quint16 crc = CrcHelper::calculateCrc16Xmodem(
+        QByteArray::fromRawData(block.constData() + BlockHeaderSize, blockSize));
+    block.append(static_cast<char>(crc >> 8));
+    block.append(static_cast<char>(crc));
+
+    if(_link.sendAsync(block) == 0)
+    {
+        qWarning() << "Can't write the block: " << blockNb << ", of the file transfer";
+        finish(false);
+        return false;
+    }
+
+    return true;
+}
+
+void SerialFileTransfer::sendControl(quint8 controlByte)
+{
+    if(_link.sendAsync(QByteArray(1, static_cast<char>(controlByte))) == 0)
+    {
+        qWarning() << "Can't write the control byte: " << controlByte
+                   << ", of the file transfer";
+        finish(false);
+        return;
+    }
+
+    restartTimer(_answerTimeoutInMs);
+}
+
+bool SerialFileTransfer::countRetry()
+{
+    ++_retriesNb;
+
+    if(_retriesNb > _maxRetriesNb)
+    {
+        qWarning() << "The file transfer has failed after: " << _maxRetriesNb << " retries, "
+                   << _ackedOffset << " bytes have been acknowledged";
+        finish(false, true);
+        return false;
+    }
+
+    return true;
+}
+
+void SerialFileTransfer::restartTimer(int timeoutInMs)
+{
+    if(timeoutInMs < 0)
+    {
+        _timer->stop();
+        return;
+    }
+
+    _timer->start(timeoutInMs);
+}
+
+void SerialFileTransfer::finish(bool success, bool notifyReceiver)
+{
+    if(notifyReceiver)
+    {
+        _link.sendAsync(QByteArray(CancelBytesNb, static_cast<char>(Can)));
+    }
+
+    _timer->stop();
+    _state = State::Idle;
+    _success = success;
+    _answers.clear();
+    _image.clear();
+
+    emit finished(success);
+}
+
+quint8 SerialFileTransfer::getBlockNb(qint64 offset)
+{
+    // The block numbers start at 1 and wrap around after 255
+    return static_cast<quint8>((offset / BlockSize) + 1);
+}
@@ -0,0 +1,277 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QElapsedTimer>
+
+#include "definesseriallink.hpp"
+#include "transfer/serialtransferprotocol.hpp"
+
+class QTimer;
+class SerialLinkIntf;
+
+
+/** @brief Sends a memory image through a serial link with the XMODEM-1K or YMODEM protocol
+    @note The object lives in the caller thread and doesn't block it: the blocks are given to the
+          link transmit queue and the receiver answers are processed when they are received. Use
+          @ref waitForFinished to wait for the transfer end.
+    @note The image is implicitly shared and never copied: each block is read in place and only
+          the block being written is built.
+    @note The CRC-16 variant of the protocols is used: the transfer starts when the receiver sends
+          'C'. The blocks contain 1024 bytes, the last one is padded with SUB bytes; if 128 bytes
+          are enough, a 128 bytes block is sent instead.
+    @note With a window size of 1 (the default), the protocols are the standard stop-and-wait
+          ones: each block waits for its ACK before sending the next one.
+    @note With a bigger window size, up to this number of data blocks are written without waiting,
+          to keep the line saturated. The receiver has to support this streaming variant: it
+          answers each data block with ACK or NAK followed by a block number:
+          - "ACK n" means that all the blocks up to the block n have been received;
+          - "NAK n" means that the block n is expected, the sender goes back to it. After a NAK,
+            the receiver silently drops the blocks until the block n is received again;
+          - a block already received is answered with the ACK of the last block received.
+          The header blocks and EOT are still answered with a lonely ACK or NAK.
+    @note The transfer can be resumed from a block boundary already received by the receiver, see
+          @ref getAcknowledgedBytesNb; the receiver has to keep the blocks already received */
+class SERIALLINK_EXPORT SerialFileTransfer : public QObject
+{
+    Q_OBJECT
+
+    private:
+        /** @brief The transfer states */
+        enum class State {
+            Idle,                   //!< @brief No transfer in progress
+            WaitingStart,           //!< @brief Waiting for the receiver 'C'
+            WaitingHeaderAck,       //!< @brief The header block has been sent (YMODEM)
+            WaitingDataStart,       //!< @brief Waiting for the 'C' before the data (YMODEM)
+            SendingData,            //!< @brief The data blocks are sent
+            WaitingEotAck,          //!< @brief EOT has been sent
+            WaitingEndStart,        //!< @brief Waiting for the 'C' before the null header
+            WaitingEndHeaderAck     //!< @brief The null header block has been sent (YMODEM)
+        };
+
+    public:
+        /** @brief Class constructor
+            @param link The serial link to send the image through, it has to be initialized and
+                        open, and to live longer than the transfer
+            @param parent The class parent */
+        explicit SerialFileTransfer(SerialLinkIntf &link, QObject *parent = nullptr);
+
+        /** @brief Class destructor
+            @note A transfer in progress is cancelled */
+        virtual ~SerialFileTransfer() override;
+
+    public:
+        /** @brief Set the protocol to use, it's XMODEM-1K by default
+            @note The method has no effect while a transfer is in progress
+            @param protocol The protocol to use */
+        void setProtocol(SerialTransferProtocol::Enum protocol);
+
+        /** @brief Get the protocol used */
+        SerialTransferProtocol::Enum getProtocol() const { return _protocol; }
+
+        /** @brief Set the max number of data blocks written without waiting for their ACK
+            @note The method has no effect while a transfer is in progress
+            @note A window size bigger than 1 requires a receiver which supports the streaming
+                  variant, see the class description
+            @param windowSize The window size, between 1 and @ref MaxWindowSize */
+        void setWindowSize(int windowSize);
+
+        /** @brief Get the max number of data blocks written without waiting for their ACK */
+        int getWindowSize() const { return _windowSize; }
+
+        /** @brief Set the timeouts of the transfer
+            @param startTimeoutInMs The max time to wait for the receiver to start the transfer
+            @param answerTimeoutInMs The max time to wait for an answer of the receiver, when it's
+                                     reached the unanswered blocks are written again */
+        void setTimeouts(int startTimeoutInMs, int answerTimeoutInMs);
+
+        /** @brief Set the max number of times a block is written again, before failing
+            @param maxRetriesNb The max number of retries */
+        void setMaxRetriesNb(int maxRetriesNb) { _maxRetriesNb = maxRetriesNb; }
+
+        /** @brief Start the transfer
+            @note The method returns at once, the transfer end is notified with @ref finished
+            @param image The image to send, it's implicitly shared and mustn't be modified by the
+                         caller during the transfer
+            @param fileName The file name sent in the YMODEM header block, unused with XMODEM
+            @param startOffset The offset in the image to resume the transfer from, it has to be
+                               a multiple of @ref BlockSize. 0 to send all the image
+            @return False if the transfer can't be started */
+        bool start(const QByteArray &image, const QString &fileName = {}, qint64 startOffset = 0);
+
+        /** @brief Cancel the transfer in progress
+            @note The receiver is notified with CAN bytes and @ref finished is emitted with a
+                  failure */
+        void cancel();
+
+        /** @brief Test if a transfer is in progress */
+        bool isRunning() const { return _state != State::Idle; }
+
+        /** @brief Wait for the end of the transfer in progress
+            @note The event loop of the caller thread is processed while waiting
+            @return True if the transfer has succeeded */
+        bool waitForFinished();
+
+        /** @brief Get the number of image bytes acknowledged by the receiver
+            @note The bytes before the start offset are counted: after a failure, this is the
+                  offset to resume the transfer from */
+        qint64 getAcknowledgedBytesNb() const { return _ackedOffset; }
+
+        /** @brief Get the time elapsed since the transfer start */
+        qint64 getElapsedTimeInMs() const;
+
+    signals:
+        /** @brief Emitted each time data blocks are acknowledged by the receiver
+            @param acknowledgedBytesNb The number of image bytes acknowledged
+            @param totalBytesNb The image size */
+        void progress(qint64 acknowledgedBytesNb, qint64 totalBytesNb);
+
+        /** @brief Emitted when the transfer is finished
+            @param success True if all the image has been acknowledged by the receiver */
+        void finished(bool success);
+
+    private slots:
+        /** @brief Called when bytes are received on the serial link
+            @param data The bytes received */
+        void onDataReceived(const QByteArray &data);
+
+        /** @brief Called when the receiver hasn't answered in time */
+        void onTimeout();
+
+    private:
+        /** @brief Process the receiver answers waiting in the buffer */
+        void processAnswers();
+
+        /** @brief Process an answer to the data blocks
+            @param answer The answer received: ACK or NAK
+            @return False if the answer isn't complete yet (the block number is missing) */
+        bool processDataAnswer(quint8 answer);
+
+        /** @brief Acknowledge the data blocks up to the block number given
+            @param blockNb The number of the last block received, -1 to acknowledge the oldest
+                           block in flight */
+        void acknowledgeBlocks(int blockNb);
+
+        /** @brief Go back to the block number given and write it again
+            @param blockNb The number of the block expected by the receiver, -1 to go back to the
+                           oldest block in flight */
+        void goBackToBlock(int blockNb);
+
+        /** @brief Find the offset of the in flight block with the number given
+            @param blockNb The number of the block to find
+            @return The block offset in the image, -1 if no block in flight has this number */
+        qint64 findInFlightBlock(int blockNb) const;
+
+        /** @brief Write data blocks until the window is full, and EOT when all the blocks have
+                   been acknowledged */
+        void fillWindow();
+
+        /** @brief Write the data block which starts at the offset given
+            @param offset The block offset in the image */
+        void sendDataBlock(qint64 offset);
+
+        /** @brief Create the content of a YMODEM header block: the file name and size
+            @param nullHeader True to create the null header which ends the session
+            @return The header content, not padded */
+        QByteArray createHeader(bool nullHeader) const;
+
+        /** @brief Write a YMODEM header block
+            @param nullHeader True to write the null header which ends the session */
+        void sendHeaderBlock(bool nullHeader);
+
+        /** @brief Write a block
+            @note The transfer fails if the block can't be written
+            @param blockNb The block number
+            @param data The block content, it's padded to the block size
+            @param padding The byte used to pad the block content
+            @return True if no problem occurred */
+        bool sendBlock(quint8 blockNb, const QByteArray &data, char padding);
+
+        /** @brief Write a control byte
+            @note The transfer fails if the byte can't be written
+            @param controlByte The byte to write */
+        void sendControl(quint8 controlByte);
+
+        /** @brief Count a retry and test if the max number of retries is reached
+            @note The transfer fails if the max number of retries is reached
+            @return True if the transfer can go on */
+        bool countRetry();
+
+        /** @brief Restart the answer timer
+            @param timeoutInMs The timeout to wait */
+        void restartTimer(int timeoutInMs);
+
+        /** @brief Finish the transfer and emit @ref finished
+            @param success True if the transfer has succeeded
+            @param notifyReceiver True to send the CAN bytes to the receiver */
+        void finish(bool success, bool notifyReceiver = false);
+
+        /** @brief Get the number of the data block which starts at the offset given */
+        static quint8 getBlockNb(qint64 offset);
+
+    public:
+        /** @brief The size of a data block */
+        static const constexpr int BlockSize = 1024;
+
+        /** @brief The size of a small block, used when the remaining data fit in it */
+        static const constexpr int SmallBlockSize = 128;
+
+        /** @brief The max window size; it's less than the half of the block numbers range, to not
+                   confuse the block numbers of the window */
+        static const constexpr int MaxWindowSize = 64;
+
+    private:
+        /** @brief The protocol control bytes */
+        static const constexpr quint8 Soh = 0x01;
+        static const constexpr quint8 Stx = 0x02;
+        static const constexpr quint8 Eot = 0x04;
+        static const constexpr quint8 Ack = 0x06;
+        static const constexpr quint8 Nak = 0x15;
+        static const constexpr quint8 Can = 0x18;
+        static const constexpr quint8 Sub = 0x1A;
+        static const constexpr quint8 CrcRequest = 'C';
+
+        /** @brief The size of the block header: the start byte and the block number, direct and
+                   complemented */
+        static const constexpr int BlockHeaderSize = 3;
+
+        /** @brief The size of the block CRC */
+        static const constexpr int CrcSize = 2;
+
+        /** @brief The number of CAN bytes sent to cancel a transfer, and needed to consider that
+                   the receiver has cancelled it */
+        static const constexpr int CancelBytesNb = 2;
+
+        /** @brief The default max time to wait for the receiver to start the transfer */
+        static const constexpr int DefaultStartTimeoutInMs = 60000;
+
+        /** @brief The default max time to wait for an answer of the receiver */
+        static const constexpr int DefaultAnswerTimeoutInMs = 3000;
+
+        /** @brief The default max number of retries */
+        static const constexpr int DefaultMaxRetriesNb = 10;
+
+    private:
+        SerialLinkIntf &_link;
+        SerialTransferProtocol::Enum _protocol{SerialTransferProtocol::Xmodem1k};
+        int _windowSize{1};
+        int _startTimeoutInMs{DefaultStartTimeoutInMs};
+        int _answerTimeoutInMs{DefaultAnswerTimeoutInMs};
+        int _maxRetriesNb{DefaultMaxRetriesNb};
+
+        State _state{State::Idle};
+        QByteArray _image;
+        QString _fileName;
+        qint64 _ackedOffset{0};
+        qint64 _nextOffset{0};
+        int _retriesNb{0};
+        bool _success{false};
+        QByteArray _answers;
+        QElapsedTimer _elapsedTimer;
+        QTimer *_timer{nullptr};
+};
@@ -0,0 +1,35 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "serialtransferprotocol.hpp"
+
+#include <QMetaEnum>
+
+
+bool SerialTransferProtocol::hasHeaderBlock(Enum value)
+{
+    return (value == Ymodem);
+}
+
+QString SerialTransferProtocol::toString(Enum value)
+{
+    return QString::fromLatin1(QMetaEnum::fromType<Enum>().valueToKey(value)).toLower();
+}
+
+SerialTransferProtocol::Enum SerialTransferProtocol::parseFromString(const QString &value)
+{
+    QMetaEnum metaEnum = QMetaEnum::fromType<Enum>();
+
+    for(int idx = 0; idx < metaEnum.keyCount(); idx++)
+    {
+        QString strValue(metaEnum.key(idx));
+
+        if(strValue.toLower() == value.toLower())
+        {
+            return static_cast<Enum>(metaEnum.value(idx));
+        }
+    }
+
+    return Unknown;
+}
@@ -0,0 +1,42 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include "definesseriallink.hpp"
+
+
+/** @brief The file transfer protocols managed by @ref SerialFileTransfer */
+class SERIALLINK_EXPORT SerialTransferProtocol : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief The file transfer protocols */
+        enum Enum {
+            Xmodem1k,   //!< @brief XMODEM with blocks of 1024 bytes and a CRC-16
+            Ymodem,     //!< @brief YMODEM: XMODEM-1K with a header block, which contains the file
+                        //!  name and size, and an ending null header block
+            Unknown
+        };
+        Q_ENUM(Enum)
+
+    public:
+        /** @brief Test if the protocol sends a header block with the file information
+            @param value The protocol to test
+            @return True if the protocol sends a header block */
+        static bool hasHeaderBlock(Enum value);
+
+        /** @brief Get a string representation of the enum
+            @param value The value to stringify
+            @return The string representation */
+        static QString toString(Enum value);
+
+        /** @brief Parse the enum from its string representation
+            @param value The string to parse
+            @return The enum parsed, this returns Unknown if no match has been found */
+        static Enum parseFromString(const QString &value);
+};
@@ -0,0 +1,164 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "ptyechopeer.hpp"
+
+#include <QDebug>
+
+#include <cerrno>
+#include <cstring>
+#include <poll.h>
+#include <pty.h>
+#include <termios.h>
+#include <unistd.h>
+
+
+PtyEchoPeer::PtyEchoPeer(QObject *parent)
+    : QThread{parent}
+{
+}
+
+PtyEchoPeer::~PtyEchoPeer()
+{
+    stopAndWait();
+    closePty();
+}
+
+bool PtyEchoPeer::openPty()
+{
+    if(_masterFd >= 0)
+    {
+        qWarning() << "The pseudo terminal pair has already been opened";
+        return false;
+    }
+
+    if(openpty(&_masterFd, &_slaveFd, nullptr, nullptr, nullptr) != 0)
+    {
+        qWarning() << "Can't open a pseudo terminal pair: " << strerror(errno);
+        return false;
+    }
+
+    // The echo peer mustn't transform the bytes it receives
+    termios attributes;
+    if(tcgetattr(_slaveFd, &attributes) == 0)
+    {
+        cfmakeraw(&attributes);
+        tcsetattr(_slaveFd, TCSANOW, &attributes);
+    }
+
+    const char *slavePath = ttyname(_slaveFd);
+    if(slavePath == nullptr)
+    {
+        qWarning() << "Can't get the name of the pseudo terminal slave side: " << strerror(errno);
+        closePty();
+        return false;
+    }
+
+    _slavePath = QString::fromLocal8Bit(slavePath);
+    return true;
+}
+
+void PtyEchoPeer::stopAndWait()
+{
+    _stopRequested = true;
+    wait();
+}
+
+void PtyEchoPeer::run()
+{
+    char buffer[ReadBufferSize];
+
+    pollfd pollFd;
+    pollFd.fd = _masterFd;
+    pollFd.events = POLLIN;
+
+    while(!_stopRequested)
+    {
+        pollFd.revents = 0;
+        const int result = poll(&pollFd, 1, PollTimeoutInMs);
+
+        if(result < 0 && errno != EINTR)
+        {
+            qWarning() << "A problem occurred when waiting for the pseudo terminal: "
+                       << strerror(errno);
+            return;
+        }
+
+        if(result == 0)
+        {
+            processIdle();
+            continue;
+        }
+
+        if(result < 0 || (pollFd.revents & POLLIN) == 0)
+        {
+            continue;
+        }
+
+        const ssize_t readNb = read(_masterFd, buffer, ReadBufferSize);
+        if(readNb <= 0)
+        {
+            continue;
+        }
+
+        if(!processReceivedBytes(buffer, readNb))
+        {
+            return;
+        }
+    }
+}
+
+bool PtyEchoPeer::processReceivedBytes(const char *data, qint64 length)
+{
+    if(!writeAll(data, length))
+    {
+        return false;
+    }
+
+    _echoedBytesNb += static_cast<quint64>(length);
+    return true;
+}
+
+bool PtyEchoPeer::writeAll(const char *data, qint64 length)
+{
+    qint64 writtenNb = 0;
+
+    while(writtenNb < length)
+    {
+        const ssize_t result = write(_masterFd,
+                                     data + writtenNb,
+                                     static_cast<size_t>(length - writtenNb));
+
+        if(result < 0)
+        {
+            if(errno == EINTR || errno == EAGAIN)
+            {
+                continue;
+            }
+
+            qWarning() << "A problem occurred when echoing to the pseudo terminal: "
+                       << strerror(errno);
+            return false;
+        }
+
+        writtenNb += result;
+    }
+
+    return true;
+}
+
+void PtyEchoPeer::closePty()
+{
+    if(_slaveFd >= 0)
+    {
+        close(_slaveFd);
+        _slaveFd = -1;
+    }
+
+    if(_masterFd >= 0)
+    {
+        close(_masterFd);
+        _masterFd = -1;
+    }
+}
@@ -0,0 +1,87 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QThread>
+
+#include <atomic>
+
+
+/** @brief Drives the master side of a pseudo terminal pair, it writes back all the bytes it
+           receives
+    @note The slave side of the pair is opened by the serial link to test: the echo peer acts as
+          the device connected to the serial port
+    @note The peer reads and writes in its own thread, to not share the event loop of the test
+    @note The derived classes can answer the received bytes differently, see
+          @ref processReceivedBytes */
+class PtyEchoPeer : public QThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit PtyEchoPeer(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~PtyEchoPeer() override;
+
+    public:
+        /** @brief Create the pseudo terminal pair
+            @note The slave side is kept open by the peer, otherwise the master side is hung up
+                  each time the serial link closes its port
+            @return True if no problem occurred */
+        bool openPty();
+
+        /** @brief Get the system location of the pseudo terminal slave side (ex: "/dev/pts/3")
+            @note This is the port to open with the serial link */
+        const QString &getSlavePath() const { return _slavePath; }
+
+        /** @brief Get the number of bytes written back by the peer */
+        quint64 getEchoedBytesNb() const { return _echoedBytesNb; }
+
+        /** @brief Stop the echo loop and wait for the end of the thread */
+        void stopAndWait();
+
+    protected:
+        /** @brief Read loop of the peer thread */
+        virtual void run() override;
+
+        /** @brief Called in the peer thread with the bytes read, the default implementation
+                   writes them back
+            @param data The bytes read
+            @param length The number of bytes read
+            @return False to stop the peer thread */
+        virtual bool processReceivedBytes(const char *data, qint64 length);
+
+        /** @brief Called in the peer thread when nothing has been read during
+                   @ref PollTimeoutInMs */
+        virtual void processIdle() {}
+
+        /** @brief Write all the bytes given to the pseudo terminal master side
+            @param data The bytes to write
+            @param length The number of bytes to write
+            @return True if no problem occurred */
+        bool writeAll(const char *data, qint64 length);
+
+    private:
+
+        /** @brief Close the pseudo terminal file descriptors */
+        void closePty();
+
+    private:
+        /** @brief The period to test if the peer has to stop */
+        static const constexpr int PollTimeoutInMs = 20;
+
+        /** @brief The size of the read buffer, it's the max size of a chunk echoed */
+        static const constexpr int ReadBufferSize = 4096;
+
+    private:
+        int _masterFd{-1};
+        int _slaveFd{-1};
+        QString _slavePath;
+        std::atomic_bool _stopRequested{false};
+        std::atomic<quint64> _echoedBytesNb{0};
+};
@@ -0,0 +1,248 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "ptymodemreceiver.hpp"
+
+#include <QMutexLocker>
+
+#include "crcutility/crchelper.hpp"
+
+
+PtyModemReceiver::PtyModemReceiver(bool withHeader, bool streaming, QObject *parent)
+    : PtyEchoPeer{parent},
+    _withHeader{withHeader},
+    _streaming{streaming},
+    _state{withHeader ? State::WaitingHeader : State::WaitingStart}
+{
+}
+
+bool PtyModemReceiver::isFinished() const
+{
+    QMutexLocker locker(&_mutex);
+    return _finished;
+}
+
+QByteArray PtyModemReceiver::getReceivedData() const
+{
+    QMutexLocker locker(&_mutex);
+
+    if(_fileSize >= 0)
+    {
+        return _received.left(static_cast<int>(_fileSize));
+    }
+
+    return _received;
+}
+
+QString PtyModemReceiver::getFileName() const
+{
+    QMutexLocker locker(&_mutex);
+    return _fileName;
+}
+
+bool PtyModemReceiver::processReceivedBytes(const char *data, qint64 length)
+{
+    if(_state == State::Cancelled)
+    {
+        _startRequestTimer.start();
+        return true;
+    }
+
+    _buffer.append(data, static_cast<int>(length));
+
+    while(!_buffer.isEmpty())
+    {
+        const quint8 startByte = static_cast<quint8>(_buffer.at(0));
+
+        if(startByte == Eot)
+        {
+            _buffer.remove(0, 1);
+
+            if(_withHeader && !_eotNakSent)
+            {
+                // As the YMODEM receivers, the first EOT is answered with NAK
+                _eotNakSent = true;
+                sendControl(Nak);
+                continue;
+            }
+
+            sendControl(Ack);
+
+            if(_withHeader)
+            {
+                _state = State::WaitingEndHeader;
+                sendControl(CrcRequest);
+                continue;
+            }
+
+            _state = State::Finished;
+            QMutexLocker locker(&_mutex);
+            _finished = true;
+            continue;
+        }
+
+        if(startByte != Soh && startByte != Stx)
+        {
+            // The CAN bytes of the sender, or noise
+            _buffer.remove(0, 1);
+            continue;
+        }
+
+        const int blockSize = (startByte == Soh) ? SmallBlockSize : BlockSize;
+        if(_buffer.length() < (BlockHeaderSize + blockSize + CrcSize))
+        {
+            break;
+        }
+
+        const quint8 blockNb = static_cast<quint8>(_buffer.at(1));
+        const quint8 complementedBlockNb = static_cast<quint8>(_buffer.at(2));
+        const QByteArray content = _buffer.mid(BlockHeaderSize, blockSize);
+        const quint16 crc = static_cast<quint16>(
+            (static_cast<quint8>(_buffer.at(BlockHeaderSize + blockSize)) << 8) |
+            static_cast<quint8>(_buffer.at(BlockHeaderSize + blockSize + 1)));
+        _buffer.remove(0, BlockHeaderSize + blockSize + CrcSize);
+
+        bool valid = (static_cast<quint8>(blockNb ^ complementedBlockNb) == 0xFF) &&
+                     (CrcHelper::calculateCrc16Xmodem(content) == crc);
+
+        if(valid && _corruptedBlockNb == blockNb && _state == State::ReceivingData)
+        {
+            _corruptedBlockNb = -1;
+            valid = false;
+        }
+
+        processBlock(blockNb, valid, content);
+    }
+
+    return true;
+}
+
+void PtyModemReceiver::processIdle()
+{
+    if(_state == State::Cancelled && _startRequestTimer.elapsed() >= PurgeDelayInMs)
+    {
+        _state = _withHeader ? State::WaitingHeader : State::WaitingStart;
+        _startRequestTimer.invalidate();
+    }
+
+    if(_state != State::WaitingStart && _state != State::WaitingHeader)
+    {
+        return;
+    }
+
+    if(_startRequestTimer.isValid() && _startRequestTimer.elapsed() < StartRequestPeriodInMs)
+    {
+        return;
+    }
+
+    _startRequestTimer.start();
+    sendControl(CrcRequest);
+}
+
+void PtyModemReceiver::processBlock(quint8 blockNb, bool valid, const QByteArray &content)
+{
+    if(_state == State::WaitingHeader || _state == State::WaitingEndHeader)
+    {
+        if(!valid || blockNb != 0)
+        {
+            sendControl(Nak);
+            return;
+        }
+
+        sendControl(Ack);
+
+        if(_state == State::WaitingEndHeader)
+        {
+            _state = State::Finished;
+            QMutexLocker locker(&_mutex);
+            _finished = true;
+            return;
+        }
+
+        processHeader(content);
+        _state = State::ReceivingData;
+        sendControl(CrcRequest);
+        return;
+    }
+
+    if(_state == State::WaitingStart)
+    {
+        _state = State::ReceivingData;
+    }
+
+    if(_state != State::ReceivingData)
+    {
+        return;
+    }
+
+    const quint8 previousBlockNb = static_cast<quint8>(_expectedBlockNb - 1);
+
+    if(!valid || (blockNb != _expectedBlockNb && blockNb != previousBlockNb))
+    {
+        // In the streaming variant, the blocks following the error are silently dropped
+        if(!_streaming || !_nakSent)
+        {
+            _nakSent = true;
+            sendAnswer(Nak, _expectedBlockNb);
+        }
+        return;
+    }
+
+    if(blockNb != _expectedBlockNb)
+    {
+        // Already received, the ACK has been lost
+        sendAnswer(Ack, blockNb);
+        return;
+    }
+
+    {
+        QMutexLocker locker(&_mutex);
+        _received.append(content);
+    }
+
+    ++_expectedBlockNb;
+    ++_blocksNb;
+    _nakSent = false;
+    sendAnswer(Ack, blockNb);
+
+    if(_blocksNb == _cancelAfterBlocksNb)
+    {
+        _cancelAfterBlocksNb = -1;
+        sendControl(Can);
+        sendControl(Can);
+
+        // The received blocks are kept, the transfer can be resumed
+        _state = State::Cancelled;
+        _buffer.clear();
+        _startRequestTimer.start();
+    }
+}
+
+void PtyModemReceiver::processHeader(const QByteArray &content)
+{
+    const int nameEnd = content.indexOf('\0');
+    const int sizeEnd = content.indexOf('\0', nameEnd + 1);
+
+    QMutexLocker locker(&_mutex);
+    _fileName = QString::fromLatin1(content.left(nameEnd));
+    _fileSize = content.mid(nameEnd + 1, sizeEnd - nameEnd - 1).toLongLong();
+}
+
+void PtyModemReceiver::sendAnswer(quint8 answer, quint8 blockNb)
+{
+    QByteArray bytes(1, static_cast<char>(answer));
+
+    if(_streaming)
+    {
+        bytes.append(static_cast<char>(blockNb));
+    }
+
+    writeAll(bytes.constData(), bytes.length());
+}
+
+void PtyModemReceiver::sendControl(quint8 controlByte)
+{
+    const char byte = static_cast<char>(controlByte);
+    writeAll(&byte, 1);
+}
@@ -0,0 +1,134 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "ptyechopeer.hpp"
+
+#include <QByteArray>
+#include <QElapsedTimer>
+#include <QMutex>
+
+
+/** @brief Drives the master side of a pseudo terminal pair as an XMODEM-1K or YMODEM receiver
+    @note The receiver also manages the streaming variant of @ref SerialFileTransfer, where each
+          answer is followed by a block number
+    @note The received blocks are kept when the transfer is cancelled, to test the resuming */
+class PtyModemReceiver : public PtyEchoPeer
+{
+    Q_OBJECT
+
+    private:
+        /** @brief The receiver states */
+        enum class State {
+            WaitingStart,       //!< @brief 'C' is sent until the first block is received
+            WaitingHeader,      //!< @brief Same as WaitingStart, but the header block is expected
+            ReceivingData,      //!< @brief The data blocks are received
+            WaitingEndHeader,   //!< @brief The null header block is expected (YMODEM)
+            Cancelled,          //!< @brief The transfer has been cancelled, the line is purged
+                                //!  before waiting for the transfer to be resumed
+            Finished            //!< @brief The transfer is finished
+        };
+
+    public:
+        /** @brief Class constructor
+            @param withHeader True to expect the YMODEM header blocks
+            @param streaming True to follow the answers with the block number
+            @param parent The parent instance */
+        explicit PtyModemReceiver(bool withHeader, bool streaming, QObject *parent = nullptr);
+
+    public:
+        /** @brief Set a block to corrupt the first time it's received, to test the retries
+            @note This has to be called before starting the thread
+            @param blockNb The block number to corrupt, -1 to not corrupt any block */
+        void setCorruptedBlockNb(int blockNb) { _corruptedBlockNb = blockNb; }
+
+        /** @brief Set the number of data blocks after which the receiver cancels the transfer
+            @note This has to be called before starting the thread. The receiver cancels once,
+                  then it waits for the transfer to be resumed
+            @param blocksNb The number of blocks, -1 to not cancel */
+        void setCancelAfterBlocksNb(int blocksNb) { _cancelAfterBlocksNb = blocksNb; }
+
+        /** @brief Test if the transfer is finished */
+        bool isFinished() const;
+
+        /** @brief Get the data received, the padding of the last block is removed if the file size
+                   has been given in the header */
+        QByteArray getReceivedData() const;
+
+        /** @brief Get the file name received in the header block */
+        QString getFileName() const;
+
+    protected:
+        /** @copydoc PtyEchoPeer::processReceivedBytes */
+        virtual bool processReceivedBytes(const char *data, qint64 length) override;
+
+        /** @copydoc PtyEchoPeer::processIdle */
+        virtual void processIdle() override;
+
+    private:
+        /** @brief Process a complete block
+            @param blockNb The block number
+            @param valid False if the block has been corrupted
+            @param content The block content */
+        void processBlock(quint8 blockNb, bool valid, const QByteArray &content);
+
+        /** @brief Process the header block
+            @param content The header block content */
+        void processHeader(const QByteArray &content);
+
+        /** @brief Write an answer, followed by the block number in the streaming variant
+            @param answer The answer to write
+            @param blockNb The block number of the answer */
+        void sendAnswer(quint8 answer, quint8 blockNb);
+
+        /** @brief Write a control byte
+            @param controlByte The byte to write */
+        void sendControl(quint8 controlByte);
+
+    private:
+        /** @brief The period of the 'C' sent while waiting for the transfer start */
+        static const constexpr int StartRequestPeriodInMs = 100;
+
+        /** @brief The silence to wait after a cancel, before waiting for the transfer to be
+                   resumed: the blocks written before the cancel are dropped */
+        static const constexpr int PurgeDelayInMs = 200;
+
+        /** @brief The protocol control bytes */
+        static const constexpr quint8 Soh = 0x01;
+        static const constexpr quint8 Stx = 0x02;
+        static const constexpr quint8 Eot = 0x04;
+        static const constexpr quint8 Ack = 0x06;
+        static const constexpr quint8 Nak = 0x15;
+        static const constexpr quint8 Can = 0x18;
+        static const constexpr quint8 CrcRequest = 'C';
+
+        /** @brief The size of a block header and CRC */
+        static const constexpr int BlockHeaderSize = 3;
+        static const constexpr int CrcSize = 2;
+
+        /** @brief The size of the blocks */
+        static const constexpr int SmallBlockSize = 128;
+        static const constexpr int BlockSize = 1024;
+
+    private:
+        const bool _withHeader;
+        const bool _streaming;
+        int _corruptedBlockNb{-1};
+        int _cancelAfterBlocksNb{-1};
+
+        State _state;
+        QByteArray _buffer;
+        quint8 _expectedBlockNb{1};
+        bool _nakSent{false};
+        bool _eotNakSent{false};
+        int _blocksNb{0};
+        qint64 _fileSize{-1};
+        QElapsedTimer _startRequestTimer;
+
+        mutable QMutex _mutex;
+        QByteArray _received;
+        QString _fileName;
+        bool _finished{false};
+};
@@ -0,0 +1,929 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tst_serialloopback.hpp"
+
+#include <QElapsedTimer>
+#include <QEventLoop>
+#include <QHash>
+#include <QTemporaryDir>
+#include <QTimer>
+#include <QtEndian>
+#include <QtTest>
+
+#include <algorithm>
+
+#include "capture/serialcapturefilereader.hpp"
+#include "capture/serialcapturerecord.hpp"
+#include "capture/serialcapturereplayer.hpp"
+#include "framer/serialcobsframer.hpp"
+#include "framer/seriallengthprefixframer.hpp"
+#include "framer/serialslipframer.hpp"
+#include "requests/serialrequesthandle.hpp"
+#include "requests/serialresponsematcher.hpp"
+#include "requests/serialroundtripstats.hpp"
+#include "seriallatencyprofile.hpp"
+#include "seriallinkintf.hpp"
+#include "seriallinkmanager.hpp"
+#include "transfer/serialfiletransfer.hpp"
+
+#include "ptyechopeer.hpp"
+#include "ptymodemreceiver.hpp"
+
+
+/** @brief The timeout to wait for the echo of all the sent bytes */
+static const constexpr int EchoTimeoutInMs = 10000;
+
+/** @brief The timeout of each request sent */
+static const constexpr int RequestTimeoutInMs = 2000;
+
+/** @brief The number of bytes sent by each throughput benchmark, the number of messages depends of
+           their size */
+static const constexpr int ThroughputBytesNb = 1024 * 1024;
+
+/** @brief The min number of messages sent by a throughput benchmark */
+static const constexpr int ThroughputMinMessagesNb = 200;
+
+/** @brief The max number of messages sent by a throughput benchmark */
+static const constexpr int ThroughputMaxMessagesNb = 5000;
+
+/** @brief The number of requests sent by a latency benchmark */
+static const constexpr int LatencyRequestsNb = 500;
+
+/** @brief The number of requests in flight when the requests are pipelined */
+static const constexpr int PipelineWindowSize = 8;
+
+/** @brief The timeout of the receiver answers during a file transfer */
+static const constexpr int TransferAnswerTimeoutInMs = 1000;
+
+/** @brief The size of the image sent by each file transfer benchmark */
+static const constexpr int TransferBenchImageSize = 256 * 1024;
+
+/** @brief The size of the sequence id at the beginning of each request */
+static const constexpr int SequenceIdSize = 4;
+
+/** @brief The number of nanoseconds in a microsecond */
+static const constexpr double NsInUs = 1000.0;
+
+/** @brief The number of nanoseconds in a millisecond */
+static const constexpr double NsInMs = 1000000.0;
+
+/** @brief The number of nanoseconds in a second */
+static const constexpr double NsInS = 1000000000.0;
+
+
+/** @brief Create a payload of the size given, filled with a counter; the payload contains null
+           bytes, to test that the sending is binary-safe */
+static QByteArray createPayload(int size, int seed = 0)
+{
+    QByteArray payload(size, 0x00);
+    for(int idx = 0; idx < size; ++idx)
+    {
+        payload[idx] = static_cast<char>(idx + seed);
+    }
+
+    return payload;
+}
+
+/** @brief Get the big endian bytes of the sequence id given */
+static QByteArray createSequenceId(quint32 sequenceId)
+{
+    QByteArray bytes(SequenceIdSize, Qt::Uninitialized);
+    qToBigEndian(sequenceId, bytes.data());
+    return bytes;
+}
+
+/** @brief Create a request payload: the sequence id followed by a payload of the size given */
+static QByteArray createRequest(quint32 sequenceId, int payloadSize)
+{
+    return createSequenceId(sequenceId) + createPayload(payloadSize, static_cast<int>(sequenceId));
+}
+
+/** @brief Get the percentile of latencies, the latencies have to be sorted */
+static qint64 getPercentile(const QVector<qint64> &sortedLatencies, int percent)
+{
+    if(sortedLatencies.isEmpty())
+    {
+        return 0;
+    }
+
+    const int rank = ((sortedLatencies.length() * percent) + 99) / 100;
+    return sortedLatencies.at(qBound(0, rank - 1, sortedLatencies.length() - 1));
+}
+
+
+SerialLoopbackTest::SerialLoopbackTest()
+{
+}
+
+SerialLoopbackTest::~SerialLoopbackTest()
+{
+}
+
+void SerialLoopbackTest::initTestCase()
+{
+    _peer = new PtyEchoPeer(this);
+    QVERIFY(_peer->openPty());
+    _peer->start();
+
+    // The pseudo terminals aren't listed by QSerialPortInfo, the link is created from the path
+    _link = SerialLinkManager::getInstance().createOrGetSerialLink(_peer->getSlavePath());
+    QVERIFY(!_link.isNull());
+    QVERIFY(_link->open(QIODevice::ReadWrite));
+}
+
+void SerialLoopbackTest::cleanupTestCase()
+{
+    if(!_link.isNull())
+    {
+        _link->close();
+        _link.clear();
+    }
+
+    if(_peer != nullptr)
+    {
+        _peer->stopAndWait();
+        delete _peer;
+        _peer = nullptr;
+    }
+}
+
+void SerialLoopbackTest::init()
+{
+    QVERIFY(_link->setFramer({}));
+    QVERIFY(_link->setLatencyProfile(SerialLatencyProfile::Default));
+    _link->flushRx();
+}
+
+void SerialLoopbackTest::test_binaryroundtrip_data()
+{
+    QTest::addColumn<bool>("sendAsync");
+
+    QTest::newRow("send") << false;
+    QTest::newRow("sendAsync") << true;
+}
+
+void SerialLoopbackTest::test_binaryroundtrip()
+{
+    QFETCH(bool, sendAsync);
+
+    const QVector<QByteArray> messages = { createPayload(1),
+                                           createPayload(7, 250),
+                                           createPayload(64),
+                                           createPayload(1000, 3) };
+
+    QByteArray expected;
+    for(const QByteArray &message : messages)
+    {
+        expected.append(message);
+    }
+
+    QByteArray received;
+    qint64 elapsedInNs = 0;
+    QVERIFY(sendAndWaitEcho(messages, sendAsync, received, elapsedInNs));
+    QCOMPARE(received, expected);
+}
+
+void SerialLoopbackTest::test_framedroundtrip_data()
+{
+    QTest::addColumn<QString>("framerType");
+
+    QTest::newRow("slip") << "slip";
+    QTest::newRow("cobs") << "cobs";
+    QTest::newRow("length prefix") << "lengthprefix";
+    QTest::newRow("length prefix with crc") << "lengthprefixcrc";
+}
+
+void SerialLoopbackTest::test_framedroundtrip()
+{
+    QFETCH(QString, framerType);
+
+    const QVector<QByteArray> payloads = { createPayload(1, 1),
+                                           createPayload(16),
+                                           createPayload(300, 7),
+                                           createPayload(2048, 192) };
+
+    // The encoder is a distinct instance, because the framer set is used in the link thread
+    QSharedPointer<SerialFramer> framer;
+    SerialLengthPrefixFramer encoder(2);
+    if(framerType == "slip")
+    {
+        framer.reset(new SerialSlipFramer());
+    }
+    else if(framerType == "cobs")
+    {
+        framer.reset(new SerialCobsFramer());
+    }
+    else
+    {
+        framer.reset(new SerialLengthPrefixFramer(2));
+
+        if(framerType == "lengthprefixcrc")
+        {
+            framer->setCrcCheck(SerialFrameCrcType::Crc16Mcrf4xx);
+            encoder.setCrcCheck(SerialFrameCrcType::Crc16Mcrf4xx);
+        }
+    }
+
+    QVERIFY(_link->setFramer(framer));
+
+    QVector<QByteArray> received;
+    QEventLoop loop;
+    connect(_link.data(), &SerialLinkIntf::framesReceived, &loop,
+            [&received, &loop, &payloads](const QVector<QByteArray> &frames)
+    {
+        received.append(frames);
+        if(received.length() >= payloads.length())
+        {
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(EchoTimeoutInMs, &loop, &QEventLoop::quit);
+
+    for(const QByteArray &payload : payloads)
+    {
+        QByteArray frame;
+        if(framerType == "slip")
+        {
+            frame = SerialSlipFramer::encode(payload);
+        }
+        else if(framerType == "cobs")
+        {
+            frame = SerialCobsFramer::encode(payload);
+        }
+        else
+        {
+            QByteArray payloadWithCrc = payload;
+            encoder.appendCrc(payloadWithCrc);
+            frame = encoder.encode(payloadWithCrc);
+        }
+
+        QVERIFY(_link->sendAsync(frame) != 0);
+    }
+
+    if(received.length() < payloads.length())
+    {
+        loop.exec();
+    }
+
+    QCOMPARE(received, payloads);
+}
+
+void SerialLoopbackTest::test_requestresponse()
+{
+    const SerialLengthPrefixFramer encoder(2);
+    QVERIFY(_link->setFramer(QSharedPointer<SerialFramer>(new SerialLengthPrefixFramer(2))));
+
+    // Pipelined requests: each one has to get its own response
+    QVector<SerialRequestHandle> handles;
+    for(quint32 sequenceId = 1; sequenceId <= PipelineWindowSize; ++sequenceId)
+    {
+        const SerialResponseMatcher matcher = SerialResponseMatcher().requireBytesAt(
+            0, createSequenceId(sequenceId));
+
+        handles.append(_link->sendRequest(encoder.encode(createRequest(sequenceId, 32)),
+                                          matcher,
+                                          RequestTimeoutInMs));
+        QVERIFY(handles.last().isValid());
+    }
+
+    QVERIFY(SerialRequestHandle::waitForAll(handles));
+
+    for(int idx = 0; idx < handles.length(); ++idx)
+    {
+        QCOMPARE(handles.at(idx).getResponse(), createRequest(static_cast<quint32>(idx + 1), 32));
+    }
+
+    // Synchronous request
+    const QByteArray request = createRequest(PipelineWindowSize + 1, 100);
+    QByteArray response;
+    QVERIFY(_link->sendRequestAndWait(
+        encoder.encode(request),
+        SerialResponseMatcher().requireBytesAt(0, createSequenceId(PipelineWindowSize + 1)),
+        response,
+        RequestTimeoutInMs));
+    QCOMPARE(response, request);
+}
+
+void SerialLoopbackTest::test_requesttimeout()
+{
+    const int timeoutInMs = 50;
+    const SerialLengthPrefixFramer encoder(2);
+    QVERIFY(_link->setFramer(QSharedPointer<SerialFramer>(new SerialLengthPrefixFramer(2))));
+
+    // The echoed response doesn't have the sequence id expected
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray response;
+    QVERIFY(!_link->sendRequestAndWait(encoder.encode(createRequest(1, 8)),
+                                       SerialResponseMatcher().requireBytesAt(
+                                           0, createSequenceId(2)),
+                                       response,
+                                       timeoutInMs));
+    QVERIFY(timer.elapsed() >= timeoutInMs);
+    QVERIFY(response.isEmpty());
+}
+
+void SerialLoopbackTest::test_reactorroundtrip()
+{
+    const int linksNb = 3;
+
+    // The links created from now share a single reactor thread
+    QVERIFY(SerialLinkManager::getInstance().setReactorThreadsNb(1));
+
+    QVector<QSharedPointer<PtyEchoPeer>> peers;
+    QVector<QSharedPointer<SerialLinkIntf>> links;
+    for(int idx = 0; idx < linksNb; ++idx)
+    {
+        QSharedPointer<PtyEchoPeer> peer(new PtyEchoPeer());
+        QVERIFY(peer->openPty());
+        peer->start();
+        peers.append(peer);
+
+        QSharedPointer<SerialLinkIntf> link =
+            SerialLinkManager::getInstance().createOrGetSerialLink(peer->getSlavePath());
+        QVERIFY(!link.isNull());
+        QVERIFY(link->open(QIODevice::ReadWrite));
+        links.append(link);
+    }
+
+    QVERIFY(SerialLinkManager::getInstance().setReactorThreadsNb(0));
+
+    QVector<QByteArray> received(linksNb);
+    QObject context;
+    for(int idx = 0; idx < linksNb; ++idx)
+    {
+        connect(links.at(idx).data(), &SerialLinkIntf::dataReceived, &context,
+                [&received, idx](const QByteArray &data) { received[idx].append(data); });
+    }
+
+    // Each link receives its own echo, even if they all are served by the same thread
+    for(int idx = 0; idx < linksNb; ++idx)
+    {
+        QVERIFY(links.at(idx)->sendAsync(createPayload(100, idx)) != 0);
+    }
+
+    QTRY_VERIFY_WITH_TIMEOUT(std::all_of(received.cbegin(), received.cend(),
+                                         [](const QByteArray &data)
+                                         { return data.length() >= 100; }),
+                             EchoTimeoutInMs);
+
+    for(int idx = 0; idx < linksNb; ++idx)
+    {
+        QCOMPARE(received.at(idx), createPayload(100, idx));
+        links.at(idx)->close();
+    }
+}
+
+void SerialLoopbackTest::test_captureandreplay()
+{
+    const int delayInMs = 50;
+
+    QTemporaryDir tempDir;
+    QVERIFY(tempDir.isValid());
+    const QString capturePath = tempDir.filePath("loopback.scap");
+
+    // Capture two exchanges separated by a delay
+    QVERIFY(_link->startCapture(capturePath));
+    QVERIFY(_link->isCapturing());
+
+    QByteArray received;
+    qint64 elapsedInNs = 0;
+    QVERIFY(sendAndWaitEcho({ createPayload(10) }, false, received, elapsedInNs));
+    QTest::qWait(delayInMs);
+    QVERIFY(sendAndWaitEcho({ createPayload(20, 5) }, true, received, elapsedInNs));
+
+    QVERIFY(_link->stopCapture());
+    QVERIFY(!_link->isCapturing());
+
+    // Each direction contains the bytes exchanged, with increasing timestamps
+    SerialCaptureFileReader reader;
+    QVERIFY(reader.open(capturePath));
+    QCOMPARE(reader.getPortName(), _link->getIntfName());
+
+    QVector<SerialCaptureRecord> records;
+    QVERIFY(reader.readAll(records));
+
+    QByteArray txBytes;
+    QByteArray rxBytes;
+    qint64 lastTimestampInNs = 0;
+    for(const SerialCaptureRecord &record : records)
+    {
+        QVERIFY(record.getTimestampInNs() >= lastTimestampInNs);
+        lastTimestampInNs = record.getTimestampInNs();
+
+        QByteArray &bytes = (record.getDirection() == SerialCaptureDirection::Tx) ? txBytes :
+                                                                                    rxBytes;
+        bytes.append(record.getData());
+    }
+
+    const QByteArray expected = createPayload(10) + createPayload(20, 5);
+    QCOMPARE(txBytes, expected);
+    QCOMPARE(rxBytes, expected);
+
+    // The received chunks are replayed into the link, with their original timing
+    SerialCaptureReplayer replayer;
+    QVERIFY(replayer.loadCapture(capturePath));
+    QVERIFY(replayer.getChunksNb() >= 2);
+
+    QByteArray replayed;
+    connect(_link.data(), &SerialLinkIntf::dataReceived, &replayer,
+            [&replayed](const QByteArray &data) { replayed.append(data); });
+    connect(&replayer, &SerialCaptureReplayer::chunkReplayed,
+            _link.data(), &SerialLinkIntf::injectReceivedData);
+
+    bool completed = false;
+    connect(&replayer, &SerialCaptureReplayer::replayFinished,
+            &replayer, [&completed](bool replayCompleted) { completed = replayCompleted; });
+
+    QElapsedTimer timer;
+    timer.start();
+    QVERIFY(replayer.start());
+
+    QTRY_VERIFY_WITH_TIMEOUT(replayed.length() >= expected.length(), EchoTimeoutInMs);
+    QVERIFY(completed);
+    QVERIFY(timer.elapsed() >= delayInMs);
+    QCOMPARE(replayed, expected);
+}
+
+void SerialLoopbackTest::test_latencyprofile()
+{
+    const SerialLengthPrefixFramer encoder(2);
+    QVERIFY(_link->setFramer(QSharedPointer<SerialFramer>(new SerialLengthPrefixFramer(2))));
+    QVERIFY(!_link->setLatencyProfile(SerialLatencyProfile::Unknown));
+
+    // The pseudo terminals don't manage the driver low latency flag, it's not an error
+    QVERIFY(_link->setLatencyProfile(SerialLatencyProfile::LowLatency));
+    QVERIFY(_link->setReadBufferSize(256));
+    QVERIFY(_link->resetRoundTripStats());
+
+    QVector<qint64> measuredRoundTripsInUs;
+    connect(_link.data(), &SerialLinkIntf::roundTripMeasured, this,
+            [&measuredRoundTripsInUs](quint64 /*requestId*/, qint64 roundTripInUs)
+            {
+                measuredRoundTripsInUs.append(roundTripInUs);
+            });
+
+    // The synchronous and asynchronous writings are both flushed at once
+    const constexpr int requestsNb = 10;
+    for(quint32 sequenceId = 1; sequenceId <= requestsNb; ++sequenceId)
+    {
+        const QByteArray request = createRequest(sequenceId, 16);
+        QByteArray response;
+        QVERIFY(_link->sendRequestAndWait(
+            encoder.encode(request),
+            SerialResponseMatcher().requireBytesAt(0, createSequenceId(sequenceId)),
+            response,
+            RequestTimeoutInMs));
+        QCOMPARE(response, request);
+    }
+
+    QByteArray received;
+    qint64 elapsedInNs = 0;
+    const QByteArray asyncMessage = encoder.encode(createPayload(300));
+    QVERIFY(sendAndWaitEcho({ asyncMessage }, true, received, elapsedInNs));
+    QCOMPARE(received, asyncMessage);
+
+    // Each answered request has a round-trip time
+    QTRY_COMPARE_WITH_TIMEOUT(measuredRoundTripsInUs.length(), requestsNb, EchoTimeoutInMs);
+
+    SerialRoundTripStats stats;
+    QVERIFY(_link->getRoundTripStats(stats));
+    QCOMPARE(stats.getAnsweredNb(), static_cast<quint64>(requestsNb));
+    QCOMPARE(stats.getLastInUs(), measuredRoundTripsInUs.last());
+    QCOMPARE(stats.getMinInUs(),
+             *std::min_element(measuredRoundTripsInUs.cbegin(), measuredRoundTripsInUs.cend()));
+    QCOMPARE(stats.getMaxInUs(),
+             *std::max_element(measuredRoundTripsInUs.cbegin(), measuredRoundTripsInUs.cend()));
+    QVERIFY(stats.getMinInUs() <= stats.getP50InUs());
+    QVERIFY(stats.getP50InUs() <= stats.getP99InUs());
+    QVERIFY(stats.getP99InUs() <= stats.getMaxInUs());
+    QVERIFY(stats.getMinInUs() <= stats.getMeanInUs());
+    QVERIFY(stats.getMeanInUs() <= stats.getMaxInUs());
+
+    QVERIFY(_link->resetRoundTripStats());
+    QVERIFY(_link->getRoundTripStats(stats));
+    QCOMPARE(stats.getAnsweredNb(), static_cast<quint64>(0));
+
+    QVERIFY(_link->setReadBufferSize(0));
+}
+
+void SerialLoopbackTest::test_filetransfer_data()
+{
+    QTest::addColumn<bool>("ymodem");
+    QTest::addColumn<int>("windowSize");
+    QTest::addColumn<int>("imageSize");
+    QTest::addColumn<int>("corruptedBlockNb");
+
+    // The last block is a small one with 10340 bytes, and a padded large one with 5620 bytes
+    QTest::newRow("xmodem-1k") << false << 1 << 10340 << -1;
+    QTest::newRow("xmodem-1k - corrupted block") << false << 1 << 5620 << 3;
+    QTest::newRow("xmodem-1k - streaming") << false << 8 << 10340 << -1;
+    QTest::newRow("xmodem-1k - streaming - corrupted block") << false << 8 << 10340 << 4;
+    QTest::newRow("ymodem") << true << 1 << 5620 << -1;
+    QTest::newRow("ymodem - streaming - corrupted block") << true << 8 << 10340 << 2;
+}
+
+void SerialLoopbackTest::test_filetransfer()
+{
+    QFETCH(bool, ymodem);
+    QFETCH(int, windowSize);
+    QFETCH(int, imageSize);
+    QFETCH(int, corruptedBlockNb);
+
+    PtyModemReceiver receiver(ymodem, windowSize > 1);
+    receiver.setCorruptedBlockNb(corruptedBlockNb);
+    QVERIFY(receiver.openPty());
+    receiver.start();
+
+    QSharedPointer<SerialLinkIntf> link =
+        SerialLinkManager::getInstance().createOrGetSerialLink(receiver.getSlavePath());
+    QVERIFY(!link.isNull());
+    QVERIFY(link->open(QIODevice::ReadWrite));
+
+    const QByteArray image = createPayload(imageSize);
+
+    SerialFileTransfer transfer(*link);
+    transfer.setProtocol(ymodem ? SerialTransferProtocol::Ymodem :
+                                  SerialTransferProtocol::Xmodem1k);
+    transfer.setWindowSize(windowSize);
+    transfer.setTimeouts(EchoTimeoutInMs, TransferAnswerTimeoutInMs);
+
+    qint64 lastProgress = 0;
+    bool progressValid = true;
+    connect(&transfer, &SerialFileTransfer::progress, &transfer,
+            [&lastProgress, &progressValid, &image](qint64 acknowledgedBytesNb,
+                                                    qint64 totalBytesNb)
+            {
+                progressValid = progressValid && (acknowledgedBytesNb >= lastProgress) &&
+                                (totalBytesNb == image.length());
+                lastProgress = acknowledgedBytesNb;
+            });
+
+    QVERIFY(transfer.start(image, "firmware.bin"));
+    QVERIFY(transfer.waitForFinished());
+    QVERIFY(progressValid);
+    QCOMPARE(lastProgress, static_cast<qint64>(image.length()));
+    QCOMPARE(transfer.getAcknowledgedBytesNb(), static_cast<qint64>(image.length()));
+
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.isFinished(), EchoTimeoutInMs);
+
+    const QByteArray received = receiver.getReceivedData();
+    if(ymodem)
+    {
+        // The YMODEM receiver knows the file size and removes the padding
+        QCOMPARE(received, image);
+        QCOMPARE(receiver.getFileName(), QString("firmware.bin"));
+    }
+    else
+    {
+        const int paddingSize = received.length() - image.length();
+        QCOMPARE(received.left(image.length()), image);
+        QCOMPARE(received.right(paddingSize), QByteArray(paddingSize, 0x1A));
+    }
+
+    link->close();
+    receiver.stopAndWait();
+}
+
+void SerialLoopbackTest::test_filetransferresume()
+{
+    const int blocksNbBeforeCancel = 3;
+
+    PtyModemReceiver receiver(false, true);
+    receiver.setCancelAfterBlocksNb(blocksNbBeforeCancel);
+    QVERIFY(receiver.openPty());
+    receiver.start();
+
+    QSharedPointer<SerialLinkIntf> link =
+        SerialLinkManager::getInstance().createOrGetSerialLink(receiver.getSlavePath());
+    QVERIFY(!link.isNull());
+    QVERIFY(link->open(QIODevice::ReadWrite));
+
+    const QByteArray image = createPayload(10 * SerialFileTransfer::BlockSize, 7);
+
+    SerialFileTransfer transfer(*link);
+    transfer.setWindowSize(4);
+    transfer.setTimeouts(EchoTimeoutInMs, TransferAnswerTimeoutInMs);
+
+    // The receiver cancels the transfer, the acknowledged bytes are the resume point
+    QVERIFY(transfer.start(image));
+    QVERIFY(!transfer.waitForFinished());
+
+    const qint64 resumeOffset = transfer.getAcknowledgedBytesNb();
+    QCOMPARE(resumeOffset,
+             static_cast<qint64>(blocksNbBeforeCancel * SerialFileTransfer::BlockSize));
+
+    QVERIFY(!transfer.start(image, {}, resumeOffset + 1));
+    QVERIFY(transfer.start(image, {}, resumeOffset));
+    QVERIFY(transfer.waitForFinished());
+
+    QTRY_VERIFY_WITH_TIMEOUT(receiver.isFinished(), EchoTimeoutInMs);
+    QCOMPARE(receiver.getReceivedData(), image);
+
+    link->close();
+    receiver.stopAndWait();
+}
+
+void SerialLoopbackTest::bench_throughput_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("sendAsync");
+
+    const QVector<int> sizes = { 8, 64, 512, 4096 };
+    for(int size : sizes)
+    {
+        QTest::addRow("%d bytes - send", size) << size << false;
+        QTest::addRow("%d bytes - sendAsync", size) << size << true;
+    }
+}
+
+void SerialLoopbackTest::bench_throughput()
+{
+    QFETCH(int, size);
+    QFETCH(bool, sendAsync);
+
+    const int messagesNb = qBound(ThroughputMinMessagesNb,
+                                  ThroughputBytesNb / size,
+                                  ThroughputMaxMessagesNb);
+
+    QVector<QByteArray> messages;
+    messages.reserve(messagesNb);
+    for(int idx = 0; idx < messagesNb; ++idx)
+    {
+        messages.append(createPayload(size, idx));
+    }
+
+    QByteArray received;
+    qint64 elapsedInNs = 0;
+    QVERIFY(sendAndWaitEcho(messages, sendAsync, received, elapsedInNs));
+    QCOMPARE(received.length(), messagesNb * size);
+
+    const double elapsedInS = qMax(elapsedInNs, qint64(1)) / NsInS;
+    const double messagesBySec = messagesNb / elapsedInS;
+    const double bytesBySec = received.length() / elapsedInS;
+
+    qInfo().noquote() << QString("throughput; size: %1 B; mode: %2; messages: %3; %4 msg/s; "
+                                 "%5 B/s")
+                             .arg(size)
+                             .arg(sendAsync ? "sendAsync" : "send")
+                             .arg(messagesNb)
+                             .arg(messagesBySec, 0, 'f', 0)
+                             .arg(bytesBySec, 0, 'f', 0);
+
+    QTest::setBenchmarkResult(bytesBySec, QTest::BytesPerSecond);
+}
+
+void SerialLoopbackTest::bench_requestlatency_data()
+{
+    QTest::addColumn<int>("size");
+    QTest::addColumn<bool>("pipelined");
+    QTest::addColumn<bool>("lowLatency");
+
+    const QVector<int> sizes = { 8, 64, 512, 4096 };
+    for(int size : sizes)
+    {
+        QTest::addRow("%d bytes - sequential", size) << size << false << false;
+        QTest::addRow("%d bytes - sequential - low latency", size) << size << false << true;
+        QTest::addRow("%d bytes - pipelined", size) << size << true << false;
+        QTest::addRow("%d bytes - pipelined - low latency", size) << size << true << true;
+    }
+}
+
+void SerialLoopbackTest::bench_requestlatency()
+{
+    QFETCH(int, size);
+    QFETCH(bool, pipelined);
+    QFETCH(bool, lowLatency);
+
+    const SerialLengthPrefixFramer encoder(2);
+    QVERIFY(_link->setFramer(QSharedPointer<SerialFramer>(new SerialLengthPrefixFramer(2))));
+    QVERIFY(_link->setLatencyProfile(lowLatency ? SerialLatencyProfile::LowLatency :
+                                                  SerialLatencyProfile::Default));
+
+    QVector<QByteArray> requests;
+    QVector<SerialResponseMatcher> matchers;
+    requests.reserve(LatencyRequestsNb);
+    matchers.reserve(LatencyRequestsNb);
+    for(quint32 sequenceId = 0; sequenceId < LatencyRequestsNb; ++sequenceId)
+    {
+        requests.append(encoder.encode(createRequest(sequenceId, size)));
+        matchers.append(SerialResponseMatcher().requireBytesAt(0, createSequenceId(sequenceId)));
+    }
+
+    QVector<qint64> latencies;
+    latencies.reserve(LatencyRequestsNb);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    if(!pipelined)
+    {
+        // Each request waits for its response, this is the latency seen by a synchronous caller
+        for(int idx = 0; idx < LatencyRequestsNb; ++idx)
+        {
+            QByteArray response;
+            const qint64 startInNs = timer.nsecsElapsed();
+            QVERIFY(_link->sendRequestAndWait(requests.at(idx),
+                                              matchers.at(idx),
+                                              response,
+                                              RequestTimeoutInMs));
+            latencies.append(timer.nsecsElapsed() - startInNs);
+        }
+    }
+    else
+    {
+        // A new request is sent each time one is finished, to keep the window full
+        QHash<quint64, qint64> sentTimesInNs;
+        int sentNb = 0;
+        bool allAnswered = true;
+        QEventLoop loop;
+
+        auto sendNext = [&]()
+        {
+            const SerialRequestHandle handle = _link->sendRequest(requests.at(sentNb),
+                                                                  matchers.at(sentNb),
+                                                                  RequestTimeoutInMs);
+            ++sentNb;
+
+            if(!handle.isValid())
+            {
+                allAnswered = false;
+                loop.quit();
+                return;
+            }
+
+            sentTimesInNs.insert(handle.getRequestId(), timer.nsecsElapsed());
+        };
+
+        connect(_link.data(), &SerialLinkIntf::requestFinished, &loop,
+                [&](quint64 requestId, bool success)
+        {
+            auto iter = sentTimesInNs.find(requestId);
+            if(iter == sentTimesInNs.end())
+            {
+                return;
+            }
+
+            latencies.append(timer.nsecsElapsed() - iter.value());
+            sentTimesInNs.erase(iter);
+            allAnswered = allAnswered && success;
+
+            if(sentNb < LatencyRequestsNb)
+            {
+                sendNext();
+            }
+            else if(sentTimesInNs.isEmpty())
+            {
+                loop.quit();
+            }
+        });
+        QTimer::singleShot(EchoTimeoutInMs, &loop, &QEventLoop::quit);
+
+        for(int idx = 0; idx < PipelineWindowSize; ++idx)
+        {
+            sendNext();
+        }
+
+        loop.exec();
+
+        QVERIFY(allAnswered);
+        QCOMPARE(latencies.length(), LatencyRequestsNb);
+    }
+
+    const double elapsedInS = qMax(timer.nsecsElapsed(), qint64(1)) / NsInS;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    qInfo().noquote() << QString("request latency; size: %1 B; mode: %2; profile: %9; "
+                                 "requests: %3; %4 req/s; p50: %5 us; p90: %6 us; p99: %7 us; "
+                                 "max: %8 us")
+                             .arg(size)
+                             .arg(pipelined ? "pipelined" : "sequential")
+                             .arg(LatencyRequestsNb)
+                             .arg(LatencyRequestsNb / elapsedInS, 0, 'f', 0)
+                             .arg(getPercentile(latencies, 50) / NsInUs, 0, 'f', 1)
+                             .arg(getPercentile(latencies, 90) / NsInUs, 0, 'f', 1)
+                             .arg(getPercentile(latencies, 99) / NsInUs, 0, 'f', 1)
+                             .arg(latencies.last() / NsInUs, 0, 'f', 1)
+                             .arg(SerialLatencyProfile::toString(
+                                 lowLatency ? SerialLatencyProfile::LowLatency :
+                                              SerialLatencyProfile::Default));
+
+    QTest::setBenchmarkResult(getPercentile(latencies, 50) / NsInMs,
+                              QTest::WalltimeMilliseconds);
+}
+
+void SerialLoopbackTest::bench_filetransfer_data()
+{
+    QTest::addColumn<int>("windowSize");
+
+    const QVector<int> windowSizes = { 1, 4, 16, 32 };
+    for(int windowSize : windowSizes)
+    {
+        QTest::addRow("window of %d blocks", windowSize) << windowSize;
+    }
+}
+
+void SerialLoopbackTest::bench_filetransfer()
+{
+    QFETCH(int, windowSize);
+
+    PtyModemReceiver receiver(false, windowSize > 1);
+    QVERIFY(receiver.openPty());
+    receiver.start();
+
+    QSharedPointer<SerialLinkIntf> link =
+        SerialLinkManager::getInstance().createOrGetSerialLink(receiver.getSlavePath());
+    QVERIFY(!link.isNull());
+    QVERIFY(link->open(QIODevice::ReadWrite));
+
+    const QByteArray image = createPayload(TransferBenchImageSize);
+
+    SerialFileTransfer transfer(*link);
+    transfer.setWindowSize(windowSize);
+    transfer.setTimeouts(EchoTimeoutInMs, TransferAnswerTimeoutInMs);
+
+    QElapsedTimer timer;
+    QVERIFY(transfer.start(image));
+
+    // The time to wait for the receiver first 'C' isn't part of the transfer
+    connect(&transfer, &SerialFileTransfer::progress, &transfer, [&timer]()
+    {
+        if(!timer.isValid())
+        {
+            timer.start();
+        }
+    });
+
+    QVERIFY(transfer.waitForFinished());
+
+    const double elapsedInS = qMax(timer.nsecsElapsed(), qint64(1)) / NsInS;
+    const double bytesBySec = (image.length() - SerialFileTransfer::BlockSize) / elapsedInS;
+
+    qInfo().noquote() << QString("file transfer; window: %1 blocks; image: %2 B; %3 B/s")
+                             .arg(windowSize)
+                             .arg(image.length())
+                             .arg(bytesBySec, 0, 'f', 0);
+
+    QTest::setBenchmarkResult(bytesBySec, QTest::BytesPerSecond);
+
+    link->close();
+    receiver.stopAndWait();
+}
+
+bool SerialLoopbackTest::sendAndWaitEcho(const QVector<QByteArray> &messages,
+                                         bool sendAsync,
+                                         QByteArray &received,
+                                         qint64 &elapsedInNs)
+{
+    int expectedLength = 0;
+    for(const QByteArray &message : messages)
+    {
+        expectedLength += message.length();
+    }
+
+    received.clear();
+    received.reserve(expectedLength);
+    elapsedInNs = -1;
+
+    QElapsedTimer timer;
+    QEventLoop loop;
+
+    // The time is taken when the last byte is received, not when the event loop is left
+    connect(_link.data(), &SerialLinkIntf::dataReceived, &loop,
+            [&received, &loop, &timer, &elapsedInNs, expectedLength](const QByteArray &data)
+    {
+        received.append(data);
+        if(received.length() >= expectedLength && elapsedInNs < 0)
+        {
+            elapsedInNs = timer.nsecsElapsed();
+            loop.quit();
+        }
+    });
+    QTimer::singleShot(EchoTimeoutInMs, &loop, &QEventLoop::quit);
+
+    timer.start();
+
+    for(const QByteArray &message : messages)
+    {
+        // The synchronous sending processes the event loop, the echo can already be received
+        const bool success = sendAsync ? (_link->sendAsync(message) != 0) : _link->send(message);
+        if(!success)
+        {
+            qWarning() << "A problem occurred when sending a message on the loopback";
+            return false;
+        }
+    }
+
+    if(elapsedInNs < 0)
+    {
+        loop.exec();
+    }
+
+    return (received.length() == expectedLength);
+}
+
+QTEST_GUILESS_MAIN(SerialLoopbackTest)
@@ -0,0 +1,68 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QSharedPointer>
+
+class PtyEchoPeer;
+class SerialLinkIntf;
+
+
+/** @brief Tests the serial link through a pseudo terminal pair, whose other side echoes all the
+           bytes received
+    @note The benchmarks give the messages and bytes throughputs of each sending mode, the
+          latency percentiles of the requests with each latency profile and the file transfer
+          throughput with each window size. They are printed in the
+          test logs to be compared from one version to another; run them with:
+          "utest-serialloopback bench_<name>" */
+class SerialLoopbackTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        SerialLoopbackTest();
+        ~SerialLoopbackTest();
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void init();
+        void test_binaryroundtrip_data();
+        void test_binaryroundtrip();
+        void test_framedroundtrip_data();
+        void test_framedroundtrip();
+        void test_requestresponse();
+        void test_requesttimeout();
+        void test_reactorroundtrip();
+        void test_captureandreplay();
+        void test_latencyprofile();
+        void test_filetransfer_data();
+        void test_filetransfer();
+        void test_filetransferresume();
+        void bench_throughput_data();
+        void bench_throughput();
+        void bench_requestlatency_data();
+        void bench_requestlatency();
+        void bench_filetransfer_data();
+        void bench_filetransfer();
+
+    private:
+        /** @brief Send the messages given and wait for all their bytes to be echoed
+            @param messages The messages to send
+            @param sendAsync True to send with the transmit queue, false to send synchronously
+            @param received The bytes received
+            @param elapsedInNs The time between the first sending and the last byte received
+            @return True if all the bytes have been received before the timeout */
+        bool sendAndWaitEcho(const QVector<QByteArray> &messages,
+                             bool sendAsync,
+                             QByteArray &received,
+                             qint64 &elapsedInNs);
+
+    private:
+        PtyEchoPeer *_peer{nullptr};
+        QSharedPointer<SerialLinkIntf> _link;
+};
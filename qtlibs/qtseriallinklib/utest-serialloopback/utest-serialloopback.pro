@@ -0,0 +1,50 @@
+# SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+#
+# SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+QT += testlib
+QT += serialport
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+CONFIG *= c++17
+
+TEMPLATE = app
+
+ROOT = $$absolute_path(../../..)
+QT_LIBS = $$absolute_path($$ROOT/qtlibs)
+QT_UTILITIES = $$absolute_path($$ROOT/qtutilities)
+TEST_ROOT = $$absolute_path(.)
+
+include($$ROOT/import-build-params.pri)
+
+# The test uses the pseudo terminals of the system: on the other platforms, nothing is built
+# but the project stays in the tree
+!unix {
+    TEMPLATE = aux
+}
+
+DESTDIR = $$DESTDIR_LIBS
+
+INCLUDEPATH *= $$ROOT
+INCLUDEPATH *= $$QT_UTILITIES
+INCLUDEPATH *= $$TEST_ROOT
+
+unix {
+    HEADERS *=  ptyechopeer.hpp \
+                ptymodemreceiver.hpp \
+                tst_serialloopback.hpp
+    SOURCES *=  ptyechopeer.cpp \
+                ptymodemreceiver.cpp \
+                tst_serialloopback.cpp
+
+    include($$QT_LIBS/import-qtseriallinklib.pri)
+
+    # openpty is provided by the libutil
+    LIBS *= -lutil
+
+    target.path = /opt/utest
+    INSTALLS += target
+}
@@ -10,15 +10,10 @@ VERSION = 1.0.0
 BASENAME = $${basename(_PRO_FILE_)}
 FILENAME = $$section(BASENAME, '.', 0, 0)
 
-!win32-msvc* {
-    message("For now, the library can only be built with MSVC")
-    message("Therefore this lib is unavailabe for other systems or compiler")
-    warning("$${FILENAME} lib can't be build with different compiler than MSVC")
-}
-
 TARGET = $$qtLibraryTarget($${FILENAME})
 
 QT -= gui
+QT *= network
 
 TEMPLATE = lib
 DEFINES += QTVISACOMLIB
@@ -32,14 +27,6 @@ QT_UTILITIES = $$absolute_path($$ROOT/qtutilities)
 
 include($$ROOT/import-build-params.pri)
 
-!exists($$LIB_PATH/3rdparty/include/visa.h) {
-    error("To build the qtvisacomlib, you have to include the 3rd party, see README.md to more\
-           details")
-}
-
-INCLUDEPATH += "$$LIB_PATH/3rdparty/include"
-DEPENDPATH += "$$LIB_PATH/3rdparty/include"
-
 DESTDIR = $$DESTDIR_LIBS
 
 INCLUDEPATH *= $$LIB_PATH
@@ -47,8 +34,47 @@ INCLUDEPATH *= $$QT_UTILITIES
 INCLUDEPATH *= $$ROOT
 
 win32-msvc* {
-
     TARGET_EXT =.dll
+}
+
+# Src elements which don't need visa
+HEADERS *= $$LIB_PATH/src/avisacom.hpp
+SOURCES *= $$LIB_PATH/src/avisacom.cpp
+HEADERS *= $$LIB_PATH/src/avisacomaccesskey.hpp
+HEADERS *= $$LIB_PATH/src/visacommanager.hpp
+SOURCES *= $$LIB_PATH/src/visacommanager.cpp
+HEADERS *= $$LIB_PATH/src/visacomglobal.hpp
+
+HEADERS *= $$LIB_PATH/src/visaasyncmanager.hpp
+SOURCES *= $$LIB_PATH/src/visaasyncmanager.cpp
+HEADERS *= $$LIB_PATH/src/visaasyncthread.hpp
+SOURCES *= $$LIB_PATH/src/visaasyncthread.cpp
+
+# TCPIP socket elements
+HEADERS *= $$LIB_PATH/src/tcpip/tcpsocketsession.hpp
+SOURCES *= $$LIB_PATH/src/tcpip/tcpsocketsession.cpp
+HEADERS *= $$LIB_PATH/src/tcpip/tcpsocketthread.hpp
+SOURCES *= $$LIB_PATH/src/tcpip/tcpsocketthread.cpp
+HEADERS *= $$LIB_PATH/src/tcpip/visacomtcpsocket.hpp
+SOURCES *= $$LIB_PATH/src/tcpip/visacomtcpsocket.cpp
+
+# SCPI simulator elements
+HEADERS *= $$LIB_PATH/src/simulator/scpisimulator.hpp
+SOURCES *= $$LIB_PATH/src/simulator/scpisimulator.cpp
+HEADERS *= $$LIB_PATH/src/simulator/scpisimulatorserver.hpp
+SOURCES *= $$LIB_PATH/src/simulator/scpisimulatorserver.cpp
+
+# The visa elements can only be built with MSVC and the 3rd party, see README.md for more details.
+# Without them, the library is built without visa: only the TCPIP socket and the simulator can be
+# used
+!win32-msvc* | !exists($$LIB_PATH/3rdparty/include/visa.h) {
+    message("$${FILENAME} lib is built without visa, it needs MSVC and the 3rd party, see\
+             README.md to more details")
+
+    DEFINES *= QTVISACOMLIB_NO_VISA
+} else {
+    INCLUDEPATH += "$$LIB_PATH/3rdparty/include"
+    DEPENDPATH += "$$LIB_PATH/3rdparty/include"
 
     contains(QT_ARCH, x86_64) {
         LIBS += -L"$$LIB_PATH/3rdparty/lib_x64" -lvisa64
@@ -61,23 +87,12 @@ win32-msvc* {
     #DEFINES += QT_DISABLE_DEPRECATED_BEFORE=0x060000    # disables all the APIs deprecated before Qt 6.0.0
 
     # Src elements
-    HEADERS *= $$LIB_PATH/src/avisacom.hpp
-    SOURCES *= $$LIB_PATH/src/avisacom.cpp
-    HEADERS *= $$LIB_PATH/src/avisacomaccesskey.hpp
     HEADERS *= $$LIB_PATH/src/visacomasrl.hpp
     SOURCES *= $$LIB_PATH/src/visacomasrl.cpp
     HEADERS *= $$LIB_PATH/src/visacomgpib.hpp
     SOURCES *= $$LIB_PATH/src/visacomgpib.cpp
-    HEADERS *= $$LIB_PATH/src/visacommanager.hpp
-    SOURCES *= $$LIB_PATH/src/visacommanager.cpp
     HEADERS *= $$LIB_PATH/src/visacomusb.hpp
     SOURCES *= $$LIB_PATH/src/visacomusb.cpp
-    HEADERS *= $$LIB_PATH/src/visacomglobal.hpp
-
-    HEADERS *= $$LIB_PATH/src/visaasyncmanager.hpp
-    SOURCES *= $$LIB_PATH/src/visaasyncmanager.cpp
-    HEADERS *= $$LIB_PATH/src/visaasyncthread.hpp
-    SOURCES *= $$LIB_PATH/src/visaasyncthread.cpp
 
     HEADERS *= $$LIB_PATH/src/visacomgpib4881.hpp
     SOURCES *= $$LIB_PATH/src/visacomgpib4881.cpp
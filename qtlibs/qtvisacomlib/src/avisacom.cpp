@@ -5,10 +5,16 @@
 
 #include "avisacom.hpp"
 
+#include <QIODevice>
+
 #include <array>
-#include "visa.h"
+#include <limits>
 #include "definesutility.hpp"
 
+#ifndef QTVISACOMLIB_NO_VISA
+#include "visa.h"
+#endif
+
 #include "avisacomaccesskey.hpp"
 #include "visacommanager.hpp"
 #include "visaasyncthread.hpp"
@@ -48,6 +54,10 @@ bool AVisacom::open()
         return true;
     }
 
+#ifdef QTVISACOMLIB_NO_VISA
+    qWarning() << noVisaSupport;
+    return false;
+#else
     _status = viOpen(_defaultRM, const_cast<ViRsrc>(_interfaceId.toStdString().c_str())
                      , VI_NULL, VI_NULL, &_instr);
 
@@ -65,6 +75,7 @@ bool AVisacom::open()
     _isOpen = true;
 
     return true;
+#endif
 }
 
 bool AVisacom::lockMutex()
@@ -91,6 +102,11 @@ bool AVisacom::writePriv(const QByteArray &command)
         return false;
     }
 
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(command)
+    qWarning() << noVisaSupport;
+    return false;
+#else
     ViUInt32 retCount;
     ViUInt32 cmdLenght = static_cast<ViUInt32>(command.length());
     const unsigned char* castCmd= reinterpret_cast<const unsigned char *>(command.data());
@@ -114,6 +130,7 @@ bool AVisacom::writePriv(const QByteArray &command)
     }
 
     return true;
+#endif
 }
 
 bool AVisacom::readPriv(QByteArray &outputBuffer)
@@ -124,10 +141,53 @@ bool AVisacom::readPriv(QByteArray &outputBuffer)
         return false;
     }
 
-    ViUInt32 retCount;
-    outputBuffer.resize(bufferSize);
+    outputBuffer.clear();
+
+    const qint64 chunkSize = static_cast<qint64>(bufferSize);
+    bool endReached = false;
+    qint64 readSize = chunkSize;
+
+    // A message longer than the buffer is read in several times, until the END indicator or the
+    // termination character
+    while(!endReached && readSize == chunkSize && !outputBuffer.endsWith(lineFeed))
+    {
+        const int offset = outputBuffer.length();
+        outputBuffer.resize(offset + static_cast<int>(chunkSize));
+
+        if(!readRawPriv(outputBuffer.data() + offset, chunkSize, readSize, endReached))
+        {
+            outputBuffer.clear();
+            return false;
+        }
 
-    _status = viRead(_instr, reinterpret_cast<ViPBuf>(outputBuffer.data()), bufferSize, &retCount);
+        outputBuffer.resize(offset + static_cast<int>(readSize));
+    }
+
+    return true;
+}
+
+bool AVisacom::readRawPriv(char *data, qint64 maxSize, qint64 &readSize, bool &endReached)
+{
+    if(!_isOpen)
+    {
+        qWarning() << "Instrument session must be opened before read !";
+        return false;
+    }
+
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(data)
+    Q_UNUSED(maxSize)
+    Q_UNUSED(readSize)
+    Q_UNUSED(endReached)
+    qWarning() << noVisaSupport;
+    return false;
+#else
+    ViUInt32 retCount = 0;
+
+    _status = viRead(_instr,
+                     reinterpret_cast<ViPBuf>(data),
+                     static_cast<ViUInt32>(maxSize),
+                     &retCount);
     if (_status < VI_SUCCESS)
     {
         std::array<ViChar, descriptionBufferSize> desc{};
@@ -137,7 +197,137 @@ bool AVisacom::readPriv(QByteArray &outputBuffer)
         return false;
     }
 
-    outputBuffer.resize(retCount);
+    readSize = static_cast<qint64>(retCount);
+
+    // VI_SUCCESS_MAX_CNT: other bytes are waiting, VI_SUCCESS_TERM_CHAR: the termination
+    // character has been read
+    endReached = (_status == VI_SUCCESS);
+
+    return true;
+#endif
+}
+
+bool AVisacom::tuneReadBufferPriv(quint32 chunkSize)
+{
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(chunkSize)
+    qWarning() << noVisaSupport;
+    return false;
+#else
+    _status = viSetBuf(_instr, VI_READ_BUF, chunkSize);
+    if (_status < VI_SUCCESS)
+    {
+        std::array<ViChar, descriptionBufferSize> desc{};
+        viStatusDesc(_instr, _status, desc._Elems);
+        qWarning() << "An error occurred setting the read buffer size: " << desc._Elems;
+
+        return false;
+    }
+
+    quint32 readBufferSize = 0;
+    RETURN_IF_FALSE(getAttribute(VI_ATTR_RD_BUF_SIZE, readBufferSize));
+
+    if(readBufferSize != chunkSize)
+    {
+        qWarning() << "The visa read buffer size is: " << readBufferSize << ", instead of: "
+                   << chunkSize;
+    }
+
+    return true;
+#endif
+}
+
+bool AVisacom::readBlockHeaderPriv(qint64 &blockSize, bool &endReached)
+{
+    std::array<char, blockPrefixSize + blockMaxDigitsNb> header{};
+
+    RETURN_IF_FALSE(readExactPriv(header.data(), blockPrefixSize, endReached));
+
+    const int digitsNb = header.at(1) - '0';
+
+    if(header.at(0) != blockStart || digitsNb < 0 || digitsNb > blockMaxDigitsNb)
+    {
+        qWarning() << "The answer doesn't begin with a definite length block header: "
+                   << QByteArray(header.data(), blockPrefixSize);
+        return false;
+    }
+
+    if(digitsNb == 0)
+    {
+        qWarning() << "The indefinite length blocks can't be read as block, use read instead";
+        return false;
+    }
+
+    if(endReached)
+    {
+        qWarning() << "The message ended in the block header";
+        return false;
+    }
+
+    RETURN_IF_FALSE(readExactPriv(header.data() + blockPrefixSize, digitsNb, endReached));
+
+    bool ok = false;
+    blockSize = QByteArray(header.data() + blockPrefixSize, digitsNb).toLongLong(&ok);
+
+    if(!ok || blockSize < 0)
+    {
+        qWarning() << "The block length isn't valid: "
+                   << QByteArray(header.data(), blockPrefixSize + digitsNb);
+        return false;
+    }
+
+    if(endReached && blockSize > 0)
+    {
+        qWarning() << "The message ended in the block header";
+        return false;
+    }
+
+    return true;
+}
+
+bool AVisacom::readExactPriv(char *data, qint64 size, bool &endReached)
+{
+    qint64 offset = 0;
+    endReached = false;
+
+    while(offset < size)
+    {
+        if(endReached)
+        {
+            qWarning() << "The message ended after: " << offset << " bytes, instead of: "
+                       << size;
+            return false;
+        }
+
+        qint64 readSize = 0;
+        RETURN_IF_FALSE(readRawPriv(data + offset,
+                                    qMin(size - offset, static_cast<qint64>(_readChunkSize)),
+                                    readSize,
+                                    endReached));
+        offset += readSize;
+    }
+
+    return true;
+}
+
+bool AVisacom::readBlockEndPriv(bool endReached)
+{
+    if(endReached)
+    {
+        // The instrument has ended the message with the last block byte
+        return true;
+    }
+
+    char terminator = 0;
+    qint64 readSize = 0;
+
+    RETURN_IF_FALSE(readRawPriv(&terminator, 1, readSize, endReached));
+
+    if(readSize != 1 || terminator != *lineFeed)
+    {
+        qWarning() << "The block isn't followed by the message terminator";
+        return false;
+    }
 
     return true;
 }
@@ -219,6 +409,113 @@ bool AVisacom::read(QString &outputBuffer)
     return true;
 }
 
+bool AVisacom::readBlock(QByteArray &outputBlock)
+{
+    RETURN_IF_FALSE(lockMutex());
+
+    qint64 blockSize = 0;
+    bool endReached = false;
+    bool success = readBlockHeaderPriv(blockSize, endReached);
+
+    if(success && blockSize > std::numeric_limits<int>::max())
+    {
+        qWarning() << "The block of: " << blockSize << " bytes is too big for a byte array, "
+                   << "stream it to a device instead";
+        clear();
+        success = false;
+    }
+
+    if(success)
+    {
+        // The only allocation: the data are then read in place
+        outputBlock.resize(static_cast<int>(blockSize));
+        success = (blockSize == 0 || readExactPriv(outputBlock.data(), blockSize, endReached)) &&
+                  readBlockEndPriv(endReached);
+    }
+
+    if(!success)
+    {
+        outputBlock.clear();
+    }
+
+    unlockMutex();
+
+    return success;
+}
+
+bool AVisacom::readBlock(QIODevice &device)
+{
+    if(!device.isWritable())
+    {
+        qWarning() << "The device must be opened in write mode before reading a block in it";
+        return false;
+    }
+
+    return readBlock([&device](const char *data, qint64 size) {
+        return (device.write(data, size) == size);
+    });
+}
+
+bool AVisacom::readBlock(const BlockChunkCallback &chunkCallback)
+{
+    RETURN_IF_FALSE(lockMutex());
+
+    qint64 blockSize = 0;
+    bool endReached = false;
+    bool success = readBlockHeaderPriv(blockSize, endReached);
+
+    if(success)
+    {
+        // The same chunk buffer is used for all the block
+        QByteArray chunk(static_cast<int>(qMin(blockSize, static_cast<qint64>(_readChunkSize))),
+                         Qt::Uninitialized);
+        qint64 remaining = blockSize;
+
+        while(success && remaining > 0)
+        {
+            const qint64 size = qMin(remaining, static_cast<qint64>(chunk.length()));
+
+            success = readExactPriv(chunk.data(), size, endReached);
+
+            if(success && !chunkCallback(chunk.constData(), size))
+            {
+                qWarning() << "The block reading has been stopped, the rest of the block is "
+                           << "dropped";
+                clear();
+                unlockMutex();
+                return false;
+            }
+
+            remaining -= size;
+        }
+
+        success = success && readBlockEndPriv(endReached);
+    }
+
+    unlockMutex();
+
+    return success;
+}
+
+bool AVisacom::setReadChunkSize(quint32 chunkSize)
+{
+    if(chunkSize == 0)
+    {
+        qWarning() << "The read chunk size can't be null";
+        return false;
+    }
+
+    RETURN_IF_FALSE(lockMutex());
+
+    _readChunkSize = chunkSize;
+
+    const bool success = !_isOpen || tuneReadBufferPriv(chunkSize);
+
+    unlockMutex();
+
+    return success;
+}
+
 bool AVisacom::close()
 {
     if(!_isOpen)
@@ -227,6 +524,10 @@ bool AVisacom::close()
         return true;
     }
 
+#ifdef QTVISACOMLIB_NO_VISA
+    qWarning() << noVisaSupport;
+    return false;
+#else
     _status = viClose(_instr);
 
     if (_status < VI_SUCCESS)
@@ -240,6 +541,7 @@ bool AVisacom::close()
     _isOpen = false;
 
     return true;
+#endif
 }
 
 bool AVisacom::clear()
@@ -250,6 +552,10 @@ bool AVisacom::clear()
         return false;
     }
 
+#ifdef QTVISACOMLIB_NO_VISA
+    qWarning() << noVisaSupport;
+    return false;
+#else
     _status = viClear(_instr);
     if (_status < VI_SUCCESS)
     {
@@ -261,20 +567,32 @@ bool AVisacom::clear()
     }
 
     return true;
+#endif
 }
 
 bool AVisacom::setTimeout(qint32 timeout)
 {
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(timeout)
+    qWarning() << noVisaSupport;
+    return false;
+#else
     if(timeout < 0)
     {
         return setAttribute(VI_ATTR_TMO_VALUE, static_cast<quint32>(VI_TMO_INFINITE));
     }
 
     return setAttribute(VI_ATTR_TMO_VALUE, timeout);
+#endif
 }
 
 bool AVisacom::getTimeout(quint32 &timeout)
 {
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(timeout)
+    qWarning() << noVisaSupport;
+    return false;
+#else
     ViUInt32 tmo;
 
     _status = viGetAttribute (_instr, VI_ATTR_TMO_VALUE, &tmo);
@@ -290,6 +608,7 @@ bool AVisacom::getTimeout(quint32 &timeout)
     timeout = static_cast<quint32>(tmo);
 
     return true;
+#endif
 }
 
 unsigned long AVisacom::getInstrumentSession()
@@ -308,6 +627,12 @@ bool AVisacom::setAttribute(quint32 attr, quint64 value)
         return false;
     }
 
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(attr)
+    Q_UNUSED(value)
+    qWarning() << noVisaSupport;
+    return false;
+#else
     _status = viSetAttribute(_instr, attr, value);
     if (_status < VI_SUCCESS)
     {
@@ -319,6 +644,7 @@ bool AVisacom::setAttribute(quint32 attr, quint64 value)
     }
 
     return true;
+#endif
 }
 
 bool AVisacom::setAttribute(quint32 attr, qint32 value)
@@ -359,7 +685,13 @@ bool AVisacom::getAttributePriv(quint32 attr, void *output)
         return false;
     }
 
-    _status = viGetAttribute(_instr, attr, &output);
+#ifdef QTVISACOMLIB_NO_VISA
+    Q_UNUSED(attr)
+    Q_UNUSED(output)
+    qWarning() << noVisaSupport;
+    return false;
+#else
+    _status = viGetAttribute(_instr, attr, output);
 
     if (_status < VI_SUCCESS)
     {
@@ -371,6 +703,7 @@ bool AVisacom::getAttributePriv(quint32 attr, void *output)
     }
 
     return true;
+#endif
 }
 
 bool AVisacom::getAttribute(quint32 attr, quint64 &outputAttr)
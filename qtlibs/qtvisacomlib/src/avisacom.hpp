@@ -11,16 +11,30 @@
 #include <QTimer>
 #include <QMutex>
 
+#include <functional>
+
 #include "visacomglobal.hpp"
 
+class QIODevice;
 class VisacomManager;
 class VisaAsyncThread;
 
-/** @brief Useful class used to manage multiprotocol communication such as Gpib / Serial / USB */
+/** @brief Useful class used to manage multiprotocol communication such as Gpib / Serial / USB
+    @note The class communicates through a visa session. A derived class can use another transport
+          by overriding the open, close, clear, timeout, @ref writePriv, @ref readPriv and
+          @ref readRawPriv methods; see @ref VisacomTcpSocket */
 class VISACOM_EXPORT AVisacom: public QObject
 {
     Q_OBJECT
 
+    public:
+        /** @brief Called with each chunk of a block read
+            @note The data pointer is only valid during the call
+            @param data The chunk bytes
+            @param size The chunk size
+            @return False to stop the reading */
+        using BlockChunkCallback = std::function<bool(const char *data, qint64 size)>;
+
     public:
         /** @brief Class constructor
             @param interface the interface needed to address the correct instrument
@@ -70,13 +84,54 @@ class VISACOM_EXPORT AVisacom: public QObject
             @return return a boolean value. if false => An error occured */
         virtual bool read(QByteArray &outputBuffer);
 
+        /** @brief Read an IEEE 488.2 definite length block answer: "#<n><length><data>" followed
+                   by the message terminator
+            @note The header is parsed first, the output buffer is then allocated once and the
+                  data are read directly into it by chunks of @ref getReadChunkSize bytes
+            @note The timeout applies to each chunk read, use setTimeout() to define it
+            @note The indefinite length blocks ("#0") aren't supported, use @ref read for them
+            @param outputBlock The block data, without the header and the terminator
+            @return return a boolean value. if false => An error occured */
+        bool readBlock(QByteArray &outputBlock);
+
+        /** @brief Read an IEEE 488.2 definite length block answer and stream its data to a device
+            @note The data are given to the device by chunks of @ref getReadChunkSize bytes,
+                  without keeping the whole block in memory: useful for the large screenshots or
+                  waveforms to store in a file
+            @note If the device can't write a chunk, the rest of the block is dropped with
+                  @ref clear
+            @param device The opened device to write the block data to
+            @return return a boolean value. if false => An error occured */
+        bool readBlock(QIODevice &device);
+
+        /** @brief Read an IEEE 488.2 definite length block answer and give its data chunk by
+                   chunk to a callback
+            @note If the callback returns false, the rest of the block is dropped with
+                  @ref clear and the method returns false
+            @param chunkCallback The callback called with each chunk of @ref getReadChunkSize
+                                 bytes (the last one may be smaller)
+            @return return a boolean value. if false => An error occured */
+        bool readBlock(const BlockChunkCallback &chunkCallback);
+
+        /** @brief Set the max number of bytes read at once by the block reads
+            @note Large chunks reduce the number of transfers; the timeout applies to each chunk
+                  so it has to be long enough to receive one of them
+            @note With visa and an open session, the session read buffer is also resized with
+                  viSetBuf; its size is then given by the VI_ATTR_RD_BUF_SIZE attribute
+            @param chunkSize The chunk size in bytes, it can't be null
+            @return return a boolean value. if false => An error occured */
+        bool setReadChunkSize(quint32 chunkSize);
+
+        /** @brief Get the max number of bytes read at once by the block reads */
+        quint32 getReadChunkSize() const { return _readChunkSize; }
+
         /** @brief Close visa instrument session
             @return return a boolean value. if false => An error occured */
         virtual bool close();
 
         /** @brief Clear visa instrument session (reset read & write buffer)
             @return return a boolean value. if false => An error occured */
-        bool clear();
+        virtual bool clear();
 
         /** @brief Set the timeout value for visa communication
 
@@ -90,7 +145,7 @@ class VISACOM_EXPORT AVisacom: public QObject
             @note If setTimeout() Note used, default timeout = 2000ms
             @param timeout the timeout value
             @return return a boolean value. if false => An error occured */
-        bool getTimeout(quint32 &timeout);
+        virtual bool getTimeout(quint32 &timeout);
 
         /** @brief return if a session is currently open */
         bool isOpen() const { return _isOpen; }
@@ -189,20 +244,60 @@ class VISACOM_EXPORT AVisacom: public QObject
             @return return a boolean value. if false => An error occured */
         bool getAttributePriv(quint32 attr, void *output);
 
+        /** @brief Read the header of a definite length block: "#<n><length>"
+            @note This function doesn't use mutex
+            @param blockSize The length of the block data
+            @param endReached Set to true if the message ends with the header (empty block)
+            @return return a boolean value. if false => An error occured */
+        bool readBlockHeaderPriv(qint64 &blockSize, bool &endReached);
+
+        /** @brief Read exactly the given number of bytes, by chunks of @ref getReadChunkSize bytes
+            @note This function doesn't use mutex
+            @param data The buffer to read into, it has to contain at least size bytes
+            @param size The number of bytes to read
+            @param endReached Set to true if the last byte read ends the message
+            @return return a boolean value. if false => An error occured */
+        bool readExactPriv(char *data, qint64 size, bool &endReached);
+
+        /** @brief Read the message terminator after the block data
+            @note This function doesn't use mutex
+            @param endReached True if the message has already ended with the block data
+            @return return a boolean value. if false => An error occured */
+        bool readBlockEndPriv(bool endReached);
+
     protected:
         /** @brief Write and send message to instrument using visa.
             @note Use setTimeout() to define a new timeout value, otherwise the timeout = 2000ms
             @note This function is a generic write function and don't uses mutex.
             @param command the message to send to the instrument.
             @return return a boolean value. if false => An error occured */
-        bool writePriv(const QByteArray &command);
+        virtual bool writePriv(const QByteArray &command);
 
         /** @brief Read message from instrument using visa
             @note Use setTimeout() to define a new timeout value, otherwise the timeout = 2000ms
             @note This function is a generic read function and don't uses mutex.
             @param outputBuffer the buffer to read / store the instrument message
             @return return a boolean value. if false => An error occured */
-        bool readPriv(QByteArray &outputBuffer);
+        virtual bool readPriv(QByteArray &outputBuffer);
+
+        /** @brief Read the bytes sent by the instrument, directly into the given buffer
+            @note Use setTimeout() to define a new timeout value, otherwise the timeout = 2000ms
+            @note This function is a generic read function and don't uses mutex.
+            @note Less bytes than asked may be read, even if the message isn't ended
+            @param data The buffer to read into, it has to contain at least maxSize bytes
+            @param maxSize The max number of bytes to read
+            @param readSize The number of bytes read
+            @param endReached Set to true if the instrument has ended the message with the last
+                              byte read (END indicator). The termination character doesn't end
+                              the message here: it may be a block byte
+            @return return a boolean value. if false => An error occured */
+        virtual bool readRawPriv(char *data, qint64 maxSize, qint64 &readSize, bool &endReached);
+
+        /** @brief Tune the transport read buffer for the given block read chunk size
+            @note This function doesn't use mutex and is only called when the session is open
+            @param chunkSize The chunk size in bytes
+            @return return a boolean value. if false => An error occured */
+        virtual bool tuneReadBufferPriv(quint32 chunkSize);
 
         /** @brief Lock mutex before write or read function
             @note Must be used in public write / read functions
@@ -213,6 +308,11 @@ class VISACOM_EXPORT AVisacom: public QObject
             @note Must be used in public write / read functions */
         void unlockMutex();
 
+        /** @brief Set the session open flag
+            @note Useful for the derived classes which don't use a visa session to communicate
+            @param isOpen True if the session is open */
+        void setOpen(bool isOpen) { _isOpen = isOpen; }
+
     signals:
         /** @brief Emitted when a new message is received from device
             @param buffer the buffer containing the message */
@@ -231,6 +331,20 @@ class VISACOM_EXPORT AVisacom: public QObject
 
         static const constexpr qint32 mutexTimeout = 5000;
 
+        static const constexpr quint32 defaultReadChunkSize = 256 * 1024;
+
+        static const constexpr char blockStart = '#';
+
+        /** @brief The size of the block header before the length digits: '#' and the digits
+                   number */
+        static const constexpr int blockPrefixSize = 2;
+
+        static const constexpr int blockMaxDigitsNb = 9;
+
+        static const constexpr char *noVisaSupport = "The library has been built without visa, "
+                                                     "only the derived classes which don't use "
+                                                     "visa can communicate";
+
     private:
         /** @brief VisacomManager instance */
         VisacomManager &_visaManager;
@@ -250,6 +364,9 @@ class VISACOM_EXPORT AVisacom: public QObject
         /** @brief Interface ID used as token and used to open instrument session */
         QString _interfaceId;
 
+        /** @brief Max number of bytes read at once by the block reads */
+        quint32 _readChunkSize{defaultReadChunkSize};
+
         /** @brief Mutex used to manage access to write and read function */
         QMutex _mutex;
 
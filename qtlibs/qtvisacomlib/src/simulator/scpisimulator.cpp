@@ -0,0 +1,322 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "scpisimulator.hpp"
+
+#include <cstring>
+
+#include <QDebug>
+#include <QFile>
+#include <QMutexLocker>
+#include <QTextStream>
+#include <QTimer>
+
+#include "definesutility.hpp"
+#include "concurrent/threadconcurrentrun.hpp"
+
+#include "scpisimulatorserver.hpp"
+
+
+ScpiSimulator::ScpiSimulator(QObject *parent)
+    : BaseThread{parent},
+    _errorQueuePattern{QRegularExpression::anchoredPattern(ErrorQueuePattern),
+                       QRegularExpression::CaseInsensitiveOption}
+{
+    addDefaultRules();
+}
+
+ScpiSimulator::~ScpiSimulator()
+{
+    if(isRunning())
+    {
+        stopThread();
+
+        // The thread object lives in the caller thread, its event loop can't be used here
+        quit();
+        wait();
+    }
+}
+
+bool ScpiSimulator::startSimulator(quint16 port)
+{
+    if(_port != 0)
+    {
+        qInfo() << "The simulator is already listening to the port: " << _port << ", do nothing";
+        return true;
+    }
+
+    RETURN_IF_FALSE(startThreadAndWaitToBeReady());
+
+    if(!ThreadConcurrentRun::run(*_server, &ScpiSimulatorServer::listen, port))
+    {
+        qWarning() << "The simulator can't listen to the port: " << port;
+        return false;
+    }
+
+    _port = ThreadConcurrentRun::run(*_server, &ScpiSimulatorServer::getPort);
+
+    return true;
+}
+
+void ScpiSimulator::addRule(const QString &command, const QByteArray &answer)
+{
+    addRule(createCommandPattern(command), answer);
+}
+
+void ScpiSimulator::addRule(const QRegularExpression &pattern, const QByteArray &answer)
+{
+    if(answer.isEmpty() || answer.endsWith(LineFeed))
+    {
+        addRulePriv(pattern, answer);
+        return;
+    }
+
+    addRulePriv(pattern, answer + LineFeed);
+}
+
+void ScpiSimulator::addBlockRule(const QString &command, qint64 blockSize)
+{
+    addRulePriv(createCommandPattern(command), createBlockAnswer(blockSize));
+}
+
+void ScpiSimulator::clearRules()
+{
+    QMutexLocker locker(&_mutex);
+    _rules.clear();
+    _errors.clear();
+}
+
+bool ScpiSimulator::loadScript(const QString &filePath)
+{
+    QFile file(filePath);
+
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "Can't open the simulator script: " << filePath;
+        return false;
+    }
+
+    QTextStream stream(&file);
+    int lineNb = 0;
+
+    while(!stream.atEnd())
+    {
+        const QString line = stream.readLine().trimmed();
+        ++lineNb;
+
+        if(line.isEmpty() || line.startsWith(ScriptComment))
+        {
+            continue;
+        }
+
+        if(line.startsWith(ScriptLatency))
+        {
+            bool ok = false;
+            const int latencyInMs = line.mid(QString(ScriptLatency).length()).trimmed().toInt(&ok);
+
+            if(!ok || latencyInMs < 0)
+            {
+                qWarning() << "Invalid latency in the simulator script: " << filePath << ", at "
+                           << "line: " << lineNb;
+                return false;
+            }
+
+            setLatencyInMs(latencyInMs);
+            continue;
+        }
+
+        const int separatorIdx = line.indexOf(ScriptSeparator);
+
+        if(separatorIdx < 0)
+        {
+            qWarning() << "The rule separator is missing in the simulator script: " << filePath
+                       << ", at line: " << lineNb;
+            return false;
+        }
+
+        const QString command = line.left(separatorIdx).trimmed();
+        const QString answer = line.mid(separatorIdx + QString(ScriptSeparator).length()).trimmed();
+
+        QRegularExpression pattern = createCommandPattern(command);
+
+        if(command.length() > 2 &&
+           command.startsWith(ScriptRegExpDelimiter) &&
+           command.endsWith(ScriptRegExpDelimiter))
+        {
+            pattern = QRegularExpression(command.mid(1, command.length() - 2),
+                                         QRegularExpression::CaseInsensitiveOption);
+        }
+
+        if(command.isEmpty() || !pattern.isValid())
+        {
+            qWarning() << "Invalid command in the simulator script: " << filePath << ", at line: "
+                       << lineNb;
+            return false;
+        }
+
+        if(!answer.startsWith(ScriptBlock))
+        {
+            addRule(pattern, answer.toLatin1());
+            continue;
+        }
+
+        bool ok = false;
+        const qint64 blockSize = answer.mid(QString(ScriptBlock).length()).trimmed()
+                                       .toLongLong(&ok);
+
+        if(!ok || blockSize < 0)
+        {
+            qWarning() << "Invalid block size in the simulator script: " << filePath << ", at "
+                       << "line: " << lineNb;
+            return false;
+        }
+
+        addRulePriv(pattern, createBlockAnswer(blockSize));
+    }
+
+    return true;
+}
+
+void ScpiSimulator::setLatencyInMs(int latencyInMs)
+{
+    QMutexLocker locker(&_mutex);
+    _latencyInMs = latencyInMs;
+}
+
+int ScpiSimulator::getLatencyInMs() const
+{
+    QMutexLocker locker(&_mutex);
+    return _latencyInMs;
+}
+
+quint64 ScpiSimulator::getCommandsNb() const
+{
+    QMutexLocker locker(&_mutex);
+    return _commandsNb;
+}
+
+QByteArray ScpiSimulator::getLastCommand() const
+{
+    QMutexLocker locker(&_mutex);
+    return _lastCommand;
+}
+
+QByteArray ScpiSimulator::createBlockAnswer(qint64 blockSize)
+{
+    const QByteArray length = QByteArray::number(blockSize);
+    const QByteArray header = QByteArray(1, '#') + QByteArray::number(length.length()) + length;
+
+    QByteArray answer(static_cast<int>(header.length() + blockSize + 1), Qt::Uninitialized);
+    char *data = answer.data();
+
+    memcpy(data, header.constData(), static_cast<size_t>(header.length()));
+    data += header.length();
+
+    for(qint64 idx = 0; idx < blockSize; ++idx)
+    {
+        data[idx] = static_cast<char>(idx & 0xFF);
+    }
+
+    data[blockSize] = LineFeed;
+
+    return answer;
+}
+
+void ScpiSimulator::processCommand(const QByteArray &command, QByteArray &answer, int &latencyInMs)
+{
+    const QByteArray trimmedCommand = command.trimmed();
+    const QString commandStr = QString::fromLatin1(trimmedCommand);
+
+    answer.clear();
+
+    QMutexLocker locker(&_mutex);
+
+    latencyInMs = _latencyInMs;
+
+    if(trimmedCommand.isEmpty())
+    {
+        return;
+    }
+
+    ++_commandsNb;
+    _lastCommand = trimmedCommand;
+
+    // The last rules added are the first tested; therefore, they can override the previous ones
+    for(auto citer = _rules.crbegin(); citer != _rules.crend(); ++citer)
+    {
+        if(citer->pattern.match(commandStr).hasMatch())
+        {
+            answer = citer->answer;
+            return;
+        }
+    }
+
+    if(_errorQueuePattern.match(commandStr).hasMatch())
+    {
+        answer = (_errors.isEmpty() ? QByteArray(NoError) : _errors.dequeue()) + LineFeed;
+        return;
+    }
+
+    if(trimmedCommand.compare(ClearStatusCommand, Qt::CaseInsensitive) == 0)
+    {
+        _errors.clear();
+        return;
+    }
+
+    qWarning() << "The simulator doesn't know the command: " << trimmedCommand;
+
+    if(_errors.length() >= MaxErrorsNb)
+    {
+        _errors.removeLast();
+    }
+
+    _errors.enqueue(UndefinedHeaderError);
+}
+
+bool ScpiSimulator::stopThread()
+{
+    if(_server != nullptr)
+    {
+        QTimer::singleShot(0, _server, &ScpiSimulatorServer::deleteLater);
+        _server = nullptr;
+    }
+
+    _port = 0;
+
+    return BaseThread::stopThread();
+}
+
+void ScpiSimulator::run()
+{
+    _server = new ScpiSimulatorServer(*this);
+
+    BaseThread::run();
+}
+
+void ScpiSimulator::addDefaultRules()
+{
+    addRule(QStringLiteral("*IDN?"), DefaultIdn);
+    addRule(QStringLiteral("*RST"));
+    addRule(QStringLiteral("*OPC?"), "1");
+}
+
+void ScpiSimulator::addRulePriv(const QRegularExpression &pattern, const QByteArray &answer)
+{
+    Rule rule;
+    rule.pattern = QRegularExpression(QRegularExpression::anchoredPattern(pattern.pattern()),
+                                      pattern.patternOptions());
+    rule.answer = answer;
+
+    // Compile the pattern now, and not while answering
+    rule.pattern.optimize();
+
+    QMutexLocker locker(&_mutex);
+    _rules.append(rule);
+}
+
+QRegularExpression ScpiSimulator::createCommandPattern(const QString &command)
+{
+    return QRegularExpression(QRegularExpression::escape(command),
+                              QRegularExpression::CaseInsensitiveOption);
+}
@@ -0,0 +1,187 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+#include <QByteArray>
+#include <QMutex>
+#include <QQueue>
+#include <QRegularExpression>
+#include <QVector>
+
+#include "src/visacomglobal.hpp"
+
+class ScpiSimulatorServer;
+
+
+/** @brief A software SCPI instrument, reached through a raw TCP socket as the real instruments on
+           the port 5025
+    @note The simulator is useful to test and measure the full query path without hardware, with
+          @ref VisacomTcpSocket
+    @note The simulator is scriptable: each command received is compared to the rules, the last
+          rule added which matches the command gives the answer. A rule without answer is a
+          command; an unknown command is added to the error queue, which is read with
+          "SYST:ERR?" and emptied with "*CLS", as a real instrument does.
+    @note The rules can be loaded from a script file, one rule by line:
+          @code
+          # Comment line
+          @latency 2
+          *IDN? => ACME,DMM1000,1234,1.0
+          MEAS:VOLT:DC? => +1.234567E+00
+          /CONF:VOLT:(AC|DC)/ =>
+          WAV:DATA? => @block 4194304
+          @endcode
+          The command is compared without case; between slashes, it's a regular expression. An
+          "@block <size>" answer is an IEEE 488.2 definite length block of this size. "@latency"
+          sets the delay before each answer.
+    @note The server lives in this thread, whereas the rules can be modified from any thread */
+class VISACOM_EXPORT ScpiSimulator : public BaseThread
+{
+    Q_OBJECT
+
+    private:
+        /** @brief A command rule */
+        struct Rule
+        {
+            QRegularExpression pattern;
+            QByteArray answer;
+        };
+
+    public:
+        /** @brief Class constructor
+            @note The simulator has default rules for "*IDN?", "*RST" and "*OPC?"
+            @param parent The parent instance */
+        explicit ScpiSimulator(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~ScpiSimulator() override;
+
+    public:
+        /** @brief Start the thread and listen for the connections on the local host
+            @param port The port to listen to, 0 to choose a free port; see @ref getPort
+            @return True if no problem occurred */
+        bool startSimulator(quint16 port = 0);
+
+        /** @brief Get the port listened to, 0 if the simulator isn't started */
+        quint16 getPort() const { return _port; }
+
+        /** @brief Add a rule which matches a command
+            @param command The command to match, compared without case
+            @param answer The answer to send back, empty if the command has no answer. The line
+                          feed is added if the answer doesn't end with it */
+        void addRule(const QString &command, const QByteArray &answer = {});
+
+        /** @brief Add a rule which matches the commands with a regular expression
+            @param pattern The pattern which has to match all the command
+            @param answer The answer to send back, empty if the command has no answer. The line
+                          feed is added if the answer doesn't end with it */
+        void addRule(const QRegularExpression &pattern, const QByteArray &answer = {});
+
+        /** @brief Add a rule which answers a command with a definite length block
+            @note The block is built once and shared by all the answers; its bytes are the indexes
+                  of the bytes modulo 256
+            @param command The command to match, compared without case
+            @param blockSize The size of the block data */
+        void addBlockRule(const QString &command, qint64 blockSize);
+
+        /** @brief Remove all the rules, included the default rules, and empty the error queue
+            @note "SYST:ERR?" and "*CLS" are still managed */
+        void clearRules();
+
+        /** @brief Load the rules from a script file, see the class description
+            @param filePath The script file path
+            @return True if no problem occurred */
+        bool loadScript(const QString &filePath);
+
+        /** @brief Set the delay before each answer
+            @param latencyInMs The delay */
+        void setLatencyInMs(int latencyInMs);
+
+        /** @brief Get the delay before each answer */
+        int getLatencyInMs() const;
+
+        /** @brief Get the number of commands received */
+        quint64 getCommandsNb() const;
+
+        /** @brief Get the last command received */
+        QByteArray getLastCommand() const;
+
+        /** @brief Build a IEEE 488.2 definite length block answer
+            @note The block bytes are the indexes of the bytes modulo 256
+            @param blockSize The size of the block data
+            @return The block with its header and its final line feed */
+        static QByteArray createBlockAnswer(qint64 blockSize);
+
+    public:
+        /** @brief Process a command received by the server
+            @note The method is thread safe
+            @param command The command received, without line feed
+            @param answer The answer to send back, empty if there is nothing to send
+            @param latencyInMs The delay before sending the answer */
+        void processCommand(const QByteArray &command, QByteArray &answer, int &latencyInMs);
+
+    public slots:
+        /** @copydoc BaseThread::stopThread */
+        virtual bool stopThread() override;
+
+    protected:
+        /** @see BaseThread::run */
+        virtual void run() override;
+
+    private:
+        /** @brief Add the default rules */
+        void addDefaultRules();
+
+        /** @brief Add a rule
+            @param pattern The pattern which has to match all the command
+            @param answer The answer to send back, empty if the command has no answer */
+        void addRulePriv(const QRegularExpression &pattern, const QByteArray &answer);
+
+        /** @brief Create the regular expression which matches a command without case
+            @param command The command to match */
+        static QRegularExpression createCommandPattern(const QString &command);
+
+    private:
+        /** @brief The default identification answer */
+        static const constexpr char *DefaultIdn = "ALLCircuits,ScpiSimulator,0,1.0";
+
+        /** @brief The answer to "SYST:ERR?" when the error queue is empty */
+        static const constexpr char *NoError = "0,\"No error\"";
+
+        /** @brief The error queue commands */
+        static const constexpr char *ErrorQueuePattern = "SYST(EM)?:ERR(OR)?(:NEXT)?\\?";
+        static const constexpr char *ClearStatusCommand = "*CLS";
+
+        /** @brief The error added to the queue when a command is unknown */
+        static const constexpr char *UndefinedHeaderError = "-113,\"Undefined header\"";
+
+        /** @brief The max number of errors in the queue, as the real instruments the last one is
+                   replaced when the queue is full */
+        static const constexpr int MaxErrorsNb = 20;
+
+        /** @brief The script syntax */
+        static const constexpr char *ScriptComment = "#";
+        static const constexpr char *ScriptSeparator = "=>";
+        static const constexpr char *ScriptLatency = "@latency";
+        static const constexpr char *ScriptBlock = "@block";
+        static const constexpr char ScriptRegExpDelimiter = '/';
+
+        /** @brief The IEEE 488.2 message terminator */
+        static const constexpr char LineFeed = '\n';
+
+    private:
+        ScpiSimulatorServer *_server{nullptr};
+        quint16 _port{0};
+
+        const QRegularExpression _errorQueuePattern;
+
+        mutable QMutex _mutex;
+        QVector<Rule> _rules;
+        QQueue<QByteArray> _errors;
+        int _latencyInMs{0};
+        quint64 _commandsNb{0};
+        QByteArray _lastCommand;
+};
@@ -0,0 +1,125 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "scpisimulatorserver.hpp"
+
+#include <QDebug>
+#include <QTcpServer>
+#include <QTcpSocket>
+#include <QTimer>
+
+#include "scpisimulator.hpp"
+
+
+ScpiSimulatorServer::ScpiSimulatorServer(ScpiSimulator &simulator, QObject *parent)
+    : QObject{parent},
+    _simulator{simulator},
+    _server{new QTcpServer(this)}
+{
+    connect(_server, &QTcpServer::newConnection, this, &ScpiSimulatorServer::onNewConnection);
+}
+
+ScpiSimulatorServer::~ScpiSimulatorServer()
+{
+    _server->close();
+}
+
+bool ScpiSimulatorServer::listen(quint16 port)
+{
+    if(!_server->listen(QHostAddress::LocalHost, port))
+    {
+        qWarning() << "The simulator server can't listen: " << _server->errorString();
+        return false;
+    }
+
+    return true;
+}
+
+quint16 ScpiSimulatorServer::getPort() const
+{
+    return _server->serverPort();
+}
+
+void ScpiSimulatorServer::onNewConnection()
+{
+    while(_server->hasPendingConnections())
+    {
+        QTcpSocket *client = _server->nextPendingConnection();
+
+        // The answers are sent as soon as they are ready, as an instrument does
+        client->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+        _buffers.insert(client, {});
+
+        connect(client, &QTcpSocket::readyRead, this, &ScpiSimulatorServer::onReadyRead);
+        connect(client, &QTcpSocket::disconnected, this, &ScpiSimulatorServer::onDisconnected);
+    }
+}
+
+void ScpiSimulatorServer::onReadyRead()
+{
+    QTcpSocket *client = qobject_cast<QTcpSocket*>(sender());
+
+    if(client == nullptr || !_buffers.contains(client))
+    {
+        return;
+    }
+
+    QByteArray &buffer = _buffers[client];
+    buffer.append(client->readAll());
+
+    int lineFeedIdx = buffer.indexOf(LineFeed);
+    int commandStart = 0;
+
+    while(lineFeedIdx >= 0)
+    {
+        QByteArray answer;
+        int latencyInMs = 0;
+
+        _simulator.processCommand(buffer.mid(commandStart, lineFeedIdx - commandStart),
+                                  answer,
+                                  latencyInMs);
+
+        if(!answer.isEmpty())
+        {
+            if(latencyInMs <= 0)
+            {
+                sendAnswer(client, answer);
+            }
+            else
+            {
+                // The client is the context: the answer is dropped if it's disconnected before
+                QTimer::singleShot(latencyInMs, client, [client, answer]() {
+                    sendAnswer(client, answer);
+                });
+            }
+        }
+
+        commandStart = lineFeedIdx + 1;
+        lineFeedIdx = buffer.indexOf(LineFeed, commandStart);
+    }
+
+    buffer.remove(0, commandStart);
+}
+
+void ScpiSimulatorServer::onDisconnected()
+{
+    QTcpSocket *client = qobject_cast<QTcpSocket*>(sender());
+
+    if(client == nullptr)
+    {
+        return;
+    }
+
+    _buffers.remove(client);
+    client->deleteLater();
+}
+
+void ScpiSimulatorServer::sendAnswer(QTcpSocket *client, const QByteArray &answer)
+{
+    if(client->write(answer) != answer.length())
+    {
+        qWarning() << "The simulator server can't send the answer: " << client->errorString();
+    }
+}
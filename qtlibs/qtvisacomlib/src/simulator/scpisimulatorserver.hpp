@@ -0,0 +1,66 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QHash>
+
+class QTcpServer;
+class QTcpSocket;
+class ScpiSimulator;
+
+
+/** @brief The TCP server of the @ref ScpiSimulator
+    @note The object lives in the simulator thread. Each client is served independently: its
+          commands are split on the line feeds and answered in order */
+class ScpiSimulatorServer : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param simulator The simulator which processes the commands
+            @param parent The parent instance */
+        explicit ScpiSimulatorServer(ScpiSimulator &simulator, QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~ScpiSimulatorServer() override;
+
+    public:
+        /** @brief Listen for the connections on the local host
+            @param port The port to listen to, 0 to choose a free port
+            @return True if no problem occurred */
+        bool listen(quint16 port);
+
+        /** @brief Get the port listened to */
+        quint16 getPort() const;
+
+    private slots:
+        /** @brief Called when new clients are connected */
+        void onNewConnection();
+
+        /** @brief Called when a client has sent bytes */
+        void onReadyRead();
+
+        /** @brief Called when a client is disconnected */
+        void onDisconnected();
+
+    private:
+        /** @brief Send an answer to a client
+            @param client The client to answer
+            @param answer The answer to send */
+        static void sendAnswer(QTcpSocket *client, const QByteArray &answer);
+
+    private:
+        /** @brief The IEEE 488.2 message terminator */
+        static const constexpr char LineFeed = '\n';
+
+    private:
+        ScpiSimulator &_simulator;
+        QTcpServer *_server{nullptr};
+        QHash<QTcpSocket*, QByteArray> _buffers;
+};
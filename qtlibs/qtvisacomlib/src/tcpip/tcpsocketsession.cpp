@@ -0,0 +1,238 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tcpsocketsession.hpp"
+
+#include <QDebug>
+#include <QElapsedTimer>
+#include <QTcpSocket>
+
+#include <cstring>
+
+
+TcpSocketSession::TcpSocketSession(QObject *parent)
+    : QObject{parent},
+    _socket{new QTcpSocket(this)}
+{
+}
+
+TcpSocketSession::~TcpSocketSession()
+{
+    disconnectFromInstrument();
+}
+
+bool TcpSocketSession::connectToInstrument(const QString &host, quint16 port, int timeoutInMs)
+{
+    if(isConnected())
+    {
+        // Already connected, do nothing
+        return true;
+    }
+
+    _buffer.clear();
+    _socket->connectToHost(host, port);
+
+    if(!_socket->waitForConnected(timeoutInMs))
+    {
+        qWarning() << "Can't connect to the instrument: " << host << ":" << port << " => "
+                   << _socket->errorString();
+        _socket->abort();
+        return false;
+    }
+
+    // The SCPI messages are small and each query waits for its answer: the Nagle algorithm only
+    // adds latency
+    _socket->setSocketOption(QAbstractSocket::LowDelayOption, 1);
+
+    return true;
+}
+
+bool TcpSocketSession::disconnectFromInstrument()
+{
+    _buffer.clear();
+
+    if(_socket->state() == QAbstractSocket::UnconnectedState)
+    {
+        return true;
+    }
+
+    _socket->disconnectFromHost();
+
+    if(_socket->state() != QAbstractSocket::UnconnectedState)
+    {
+        _socket->abort();
+    }
+
+    return true;
+}
+
+bool TcpSocketSession::isConnected() const
+{
+    return _socket->state() == QAbstractSocket::ConnectedState;
+}
+
+bool TcpSocketSession::write(const QByteArray &data, int timeoutInMs)
+{
+    if(!isConnected())
+    {
+        qWarning() << "The socket must be connected before write !";
+        return false;
+    }
+
+    if(_socket->write(data) != data.length())
+    {
+        qWarning() << "Write error with command: " << data << " => " << _socket->errorString();
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    while(_socket->bytesToWrite() > 0)
+    {
+        const int remainingInMs = getRemainingTime(timeoutInMs, timer.elapsed());
+
+        if(remainingInMs == 0 || !_socket->waitForBytesWritten(remainingInMs))
+        {
+            qWarning() << "Write error with command: " << data << " => "
+                       << _socket->errorString();
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool TcpSocketSession::read(QByteArray *outputBuffer, int timeoutInMs)
+{
+    if(!isConnected() && _socket->bytesAvailable() == 0 && _buffer.isEmpty())
+    {
+        qWarning() << "The socket must be connected before read !";
+        return false;
+    }
+
+    QElapsedTimer timer;
+    timer.start();
+
+    _buffer.append(_socket->readAll());
+
+    qint64 messageLength = findMessageLength();
+
+    while(messageLength < 0)
+    {
+        const int remainingInMs = getRemainingTime(timeoutInMs, timer.elapsed());
+
+        if(remainingInMs == 0 || !_socket->waitForReadyRead(remainingInMs))
+        {
+            qWarning() << "Read error: " << _socket->errorString();
+            return false;
+        }
+
+        _buffer.append(_socket->readAll());
+        messageLength = findMessageLength();
+    }
+
+    if(messageLength == _buffer.length())
+    {
+        // Most of the time, the buffer only contains the message: give it without copy
+        outputBuffer->swap(_buffer);
+        _buffer.clear();
+        return true;
+    }
+
+    *outputBuffer = _buffer.left(static_cast<int>(messageLength));
+    _buffer.remove(0, static_cast<int>(messageLength));
+
+    return true;
+}
+
+bool TcpSocketSession::readRaw(char *data, qint64 maxSize, qint64 *readSize, int timeoutInMs)
+{
+    if(!_buffer.isEmpty())
+    {
+        const int size = static_cast<int>(qMin(maxSize, static_cast<qint64>(_buffer.length())));
+        std::memcpy(data, _buffer.constData(), static_cast<size_t>(size));
+        _buffer.remove(0, size);
+        *readSize = size;
+        return true;
+    }
+
+    if(!isConnected() && _socket->bytesAvailable() == 0)
+    {
+        qWarning() << "The socket must be connected before read !";
+        return false;
+    }
+
+    if(_socket->bytesAvailable() == 0 && !_socket->waitForReadyRead(timeoutInMs))
+    {
+        qWarning() << "Read error: " << _socket->errorString();
+        return false;
+    }
+
+    *readSize = _socket->read(data, maxSize);
+
+    if(*readSize < 0)
+    {
+        qWarning() << "Read error: " << _socket->errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool TcpSocketSession::clear()
+{
+    _buffer.clear();
+    _socket->readAll();
+
+    return true;
+}
+
+qint64 TcpSocketSession::findMessageLength()
+{
+    if(_buffer.length() >= BlockPrefixSize && _buffer.at(0) == BlockStart)
+    {
+        const int digitsNb = _buffer.at(1) - '0';
+
+        // "#0" begins an indefinite length block, which ends with the line feed
+        if(digitsNb > 0 && digitsNb <= 9)
+        {
+            if(_buffer.length() < BlockPrefixSize + digitsNb)
+            {
+                return -1;
+            }
+
+            bool ok = false;
+            const qint64 dataLength = _buffer.mid(BlockPrefixSize, digitsNb).toLongLong(&ok);
+
+            if(ok)
+            {
+                const qint64 messageLength = BlockPrefixSize + digitsNb + dataLength + 1;
+
+                if(_buffer.length() < messageLength)
+                {
+                    // Prepare the buffer to receive all the block at once
+                    _buffer.reserve(static_cast<int>(messageLength));
+                    return -1;
+                }
+
+                return messageLength;
+            }
+        }
+    }
+
+    const int lineFeedIdx = _buffer.indexOf(LineFeed);
+
+    return (lineFeedIdx < 0) ? -1 : (lineFeedIdx + 1);
+}
+
+int TcpSocketSession::getRemainingTime(int timeoutInMs, qint64 elapsedInMs)
+{
+    if(timeoutInMs < 0)
+    {
+        return -1;
+    }
+
+    return static_cast<int>(qMax(static_cast<qint64>(0), timeoutInMs - elapsedInMs));
+}
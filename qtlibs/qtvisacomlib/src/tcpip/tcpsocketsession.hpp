@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QByteArray>
+#include <QString>
+
+class QTcpSocket;
+
+
+/** @brief Owns the TCP socket connected to an instrument and exchanges the SCPI messages with it
+    @note The object lives in the @ref TcpSocketThread, all its methods have to be called in this
+          thread
+    @note A message ends with a line feed. If it begins with an IEEE 488.2 definite length block
+          header ("#<n><length>"), the block bytes are read whatever they contain, and the line
+          feed is expected after them */
+class TcpSocketSession : public QObject
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit TcpSocketSession(QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~TcpSocketSession() override;
+
+    public:
+        /** @brief Connect to the instrument
+            @param host The host name or address of the instrument
+            @param port The instrument port
+            @param timeoutInMs The max time to wait for the connection, -1 to wait forever
+            @return True if no problem occurred */
+        bool connectToInstrument(const QString &host, quint16 port, int timeoutInMs);
+
+        /** @brief Disconnect from the instrument
+            @return True if no problem occurred */
+        bool disconnectFromInstrument();
+
+        /** @brief Test if the socket is connected to the instrument */
+        bool isConnected() const;
+
+        /** @brief Write bytes to the instrument and wait for them to be written
+            @param data The bytes to write
+            @param timeoutInMs The max time to wait for the bytes to be written, -1 to wait forever
+            @return True if no problem occurred */
+        bool write(const QByteArray &data, int timeoutInMs);
+
+        /** @brief Read the next message sent by the instrument
+            @note The returned message contains its final line feed, as visa does
+            @param outputBuffer The message read
+            @param timeoutInMs The max time to wait for the whole message, -1 to wait forever
+            @return True if no problem occurred */
+        bool read(QByteArray *outputBuffer, int timeoutInMs);
+
+        /** @brief Read the bytes sent by the instrument, directly into the given buffer
+            @note The bytes already received by @ref read and not given yet are read first,
+                  otherwise the method waits for new bytes and reads them without intermediate
+                  copy
+            @param data The buffer to read into, it has to contain at least maxSize bytes
+            @param maxSize The max number of bytes to read
+            @param readSize The number of bytes read, at least one if no problem occurred
+            @param timeoutInMs The max time to wait for bytes, -1 to wait forever
+            @return True if no problem occurred */
+        bool readRaw(char *data, qint64 maxSize, qint64 *readSize, int timeoutInMs);
+
+        /** @brief Drop the bytes received and not read yet
+            @return True if no problem occurred */
+        bool clear();
+
+    private:
+        /** @brief Find the length of the first message in the received bytes
+            @note When a definite length block is found, the buffer is reserved to receive it
+            @return The message length with its line feed, -1 if the message isn't complete */
+        qint64 findMessageLength();
+
+        /** @brief Get the time remaining before the timeout given
+            @param timeoutInMs The timeout, -1 means infinite
+            @param elapsedInMs The time already elapsed
+            @return The remaining time, -1 if infinite and 0 if the timeout is reached */
+        static int getRemainingTime(int timeoutInMs, qint64 elapsedInMs);
+
+    private:
+        /** @brief The IEEE 488.2 message terminator */
+        static const constexpr char LineFeed = '\n';
+
+        /** @brief The first character of an IEEE 488.2 block */
+        static const constexpr char BlockStart = '#';
+
+        /** @brief The size of the block header before the length digits: '#' and the digits
+                   number */
+        static const constexpr int BlockPrefixSize = 2;
+
+    private:
+        QTcpSocket *_socket{nullptr};
+        QByteArray _buffer;
+};
@@ -0,0 +1,37 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tcpsocketthread.hpp"
+
+#include <QTimer>
+
+#include "tcpsocketsession.hpp"
+
+
+TcpSocketThread::TcpSocketThread(QObject *parent)
+    : BaseThread{parent}
+{
+}
+
+TcpSocketThread::~TcpSocketThread()
+{
+}
+
+bool TcpSocketThread::stopThread()
+{
+    if(_session != nullptr)
+    {
+        QTimer::singleShot(0, _session, &TcpSocketSession::deleteLater);
+        _session = nullptr;
+    }
+
+    return BaseThread::stopThread();
+}
+
+void TcpSocketThread::run()
+{
+    _session = new TcpSocketSession();
+
+    BaseThread::run();
+}
@@ -0,0 +1,46 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "threadutility/basethread.hpp"
+
+class TcpSocketSession;
+
+
+/** @brief The thread linked to a TCP socket session
+    @note A QTcpSocket can only be used in its thread, whereas the @ref AVisacom methods are called
+          from the caller thread and the asynchronous thread. Each socket has its own thread, the
+          calls are forwarded to it */
+class TcpSocketThread : public BaseThread
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param parent The parent instance */
+        explicit TcpSocketThread(QObject *parent = nullptr);
+
+        /** @brief The class destructor */
+        virtual ~TcpSocketThread() override;
+
+    public:
+        /** @brief Access the session created in the thread
+            @warning The session is created in the run of this thread; therefore, the caller of
+                     this method and the object pointer you got with this method aren't in the same
+                     thread */
+        TcpSocketSession *accessSession() const { return _session; }
+
+    public slots:
+        /** @brief Call to stop the thread
+            @return True if no problem occurs */
+        virtual bool stopThread() override;
+
+    protected:
+        /** @see BaseThread::run */
+        virtual void run() override;
+
+    private:
+        TcpSocketSession *_session{nullptr};
+};
@@ -0,0 +1,223 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "visacomtcpsocket.hpp"
+
+#include "definesutility.hpp"
+#include "concurrent/threadconcurrentrun.hpp"
+
+#include "tcpsocketsession.hpp"
+#include "tcpsocketthread.hpp"
+
+
+VisacomTcpSocket::VisacomTcpSocket(const QString &interfaceId,
+                                   VisacomManager &visaManager,
+                                   QObject *parent) :
+    AVisacom(interfaceId, visaManager, parent)
+{
+}
+
+VisacomTcpSocket::~VisacomTcpSocket()
+{
+    if(!close())
+    {
+        qWarning() << "Close session failed";
+    }
+
+    if(_socketThread != nullptr)
+    {
+        _socketThread->stopThread();
+
+        // The session is deleted when the thread finishes; the thread object lives in the caller
+        // thread, its event loop can't be used here
+        _socketThread->quit();
+        _socketThread->wait();
+        delete _socketThread;
+        _socketThread = nullptr;
+    }
+}
+
+bool VisacomTcpSocket::open()
+{
+    if(isOpen())
+    {
+        //Already open, do nothing
+        return true;
+    }
+
+    RETURN_IF_FALSE(parseInterfaceId());
+
+    if(_socketThread == nullptr)
+    {
+        _socketThread = new TcpSocketThread();
+
+        if(!_socketThread->startThreadAndWaitToBeReady())
+        {
+            qWarning() << "A problem occured when waiting for the socket thread to start";
+            return false;
+        }
+    }
+
+    if(!ThreadConcurrentRun::run(*_socketThread->accessSession(),
+                                 &TcpSocketSession::connectToInstrument,
+                                 _host,
+                                 _port,
+                                 _timeoutInMs))
+    {
+        qWarning() << "An error occurred opening session to " << getInterfaceId();
+        return false;
+    }
+
+    setOpen(true);
+
+    return true;
+}
+
+bool VisacomTcpSocket::close()
+{
+    if(!isOpen())
+    {
+        // If no sessions are open => close() return true
+        return true;
+    }
+
+    setOpen(false);
+
+    return ThreadConcurrentRun::run(*_socketThread->accessSession(),
+                                    &TcpSocketSession::disconnectFromInstrument);
+}
+
+bool VisacomTcpSocket::clear()
+{
+    if(!isOpen())
+    {
+        qWarning() << "Instrument session must be opened before clear !";
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*_socketThread->accessSession(), &TcpSocketSession::clear);
+}
+
+bool VisacomTcpSocket::setTimeout(qint32 timeout)
+{
+    _timeoutInMs = (timeout < 0) ? -1 : timeout;
+    return true;
+}
+
+bool VisacomTcpSocket::getTimeout(quint32 &timeout)
+{
+    timeout = static_cast<quint32>(_timeoutInMs);
+    return true;
+}
+
+bool VisacomTcpSocket::writePriv(const QByteArray &command)
+{
+    if(!isOpen())
+    {
+        qWarning() << "Instrument session must be opened before write !";
+        return false;
+    }
+
+    if(command.endsWith(lineFeed))
+    {
+        return ThreadConcurrentRun::run(*_socketThread->accessSession(),
+                                        &TcpSocketSession::write,
+                                        command,
+                                        _timeoutInMs);
+    }
+
+    return ThreadConcurrentRun::run(*_socketThread->accessSession(),
+                                    &TcpSocketSession::write,
+                                    command + lineFeed,
+                                    _timeoutInMs);
+}
+
+bool VisacomTcpSocket::readPriv(QByteArray &outputBuffer)
+{
+    if(!isOpen())
+    {
+        qWarning() << "Instrument session must be opened before read !";
+        return false;
+    }
+
+    return ThreadConcurrentRun::run(*_socketThread->accessSession(),
+                                    &TcpSocketSession::read,
+                                    &outputBuffer,
+                                    _timeoutInMs);
+}
+
+bool VisacomTcpSocket::readRawPriv(char *data, qint64 maxSize, qint64 &readSize, bool &endReached)
+{
+    if(!isOpen())
+    {
+        qWarning() << "Instrument session must be opened before read !";
+        return false;
+    }
+
+    endReached = false;
+
+    return ThreadConcurrentRun::run(*_socketThread->accessSession(),
+                                    &TcpSocketSession::readRaw,
+                                    data,
+                                    maxSize,
+                                    &readSize,
+                                    _timeoutInMs);
+}
+
+bool VisacomTcpSocket::tuneReadBufferPriv(quint32 chunkSize)
+{
+    Q_UNUSED(chunkSize)
+    return true;
+}
+
+bool VisacomTcpSocket::parseInterfaceId()
+{
+    const QString &interfaceId = getInterfaceId();
+
+    if(!interfaceId.startsWith(tcpipPrefix, Qt::CaseInsensitive) ||
+       !interfaceId.endsWith(socketSuffix, Qt::CaseInsensitive))
+    {
+        qWarning() << "The interface id: " << interfaceId << ", isn't a TCPIP socket resource";
+        return false;
+    }
+
+    // Ex: "TCPIP0::192.168.1.10::5025"
+    const QString resource = interfaceId.left(interfaceId.length() -
+                                              QString(socketSuffix).length());
+    const int separatorLength = QString(itfSeparator).length();
+    const int hostIdx = resource.indexOf(itfSeparator);
+    const int portIdx = resource.lastIndexOf(itfSeparator);
+
+    bool ok = false;
+
+    if(hostIdx >= 0 && portIdx > hostIdx)
+    {
+        _host = resource.mid(hostIdx + separatorLength, portIdx - hostIdx - separatorLength);
+        _port = resource.mid(portIdx + separatorLength).toUShort(&ok);
+    }
+
+    // IPv6 addresses are given between brackets, because they contain the separator
+    if(_host.startsWith('[') && _host.endsWith(']'))
+    {
+        _host = _host.mid(1, _host.length() - 2);
+    }
+
+    if(!ok || _host.isEmpty())
+    {
+        qWarning() << "The interface id: " << interfaceId << ", has no valid host or port";
+        return false;
+    }
+
+    return true;
+}
+
+QString VisacomTcpSocket::generateInterfaceId(const QString &host, quint16 port)
+{
+    if(host.contains(':'))
+    {
+        return QString(tcpSocketItf).arg(QString("[%1]").arg(host)).arg(port);
+    }
+
+    return QString(tcpSocketItf).arg(host).arg(port);
+}
@@ -0,0 +1,113 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include "src/avisacom.hpp"
+
+#include <QString>
+
+class TcpSocketThread;
+
+
+/** @brief Useful class used to manage raw SCPI communication over a TCP socket
+    @note Many instruments accept raw SCPI on the TCP port 5025. The class talks to them through a
+          native socket, without visa: it can be used even if the library has been built without
+          visa.
+    @note The interface id has the same format as the visa TCPIP socket resources:
+          "TCPIP0::[host]::[port]::SOCKET"
+    @note The socket lives in its own thread, see @ref TcpSocketThread. The messages end with a
+          line feed, which is added when writing a command without it; a definite length block
+          answer is read whatever it contains, as a message with @ref read or streamed with
+          @ref readBlock */
+class VISACOM_EXPORT VisacomTcpSocket : public AVisacom
+{
+    Q_OBJECT
+
+    public:
+        /** @brief Class constructor
+            @param interfaceId the interface needed to address the correct instrument
+            @param visaManager The visa com manager
+            @param parent The parent class */
+        explicit VisacomTcpSocket(const QString &interfaceId,
+                                  VisacomManager &visaManager,
+                                  QObject *parent = nullptr);
+
+        /** @brief Class destructor */
+        virtual ~VisacomTcpSocket() override;
+
+        /** @brief Connect to the instrument
+            @return return a boolean value. if false => An error occured */
+        virtual bool open() override;
+
+        /** @brief Disconnect from the instrument
+            @return return a boolean value. if false => An error occured */
+        virtual bool close() override;
+
+        /** @brief Drop the bytes received from the instrument and not read yet
+            @return return a boolean value. if false => An error occured */
+        virtual bool clear() override;
+
+        /** @copydoc AVisacom::setTimeout
+            @note A negative value means an infinite timeout */
+        virtual bool setTimeout(qint32 timeout) override;
+
+        /** @copydoc AVisacom::getTimeout */
+        virtual bool getTimeout(quint32 &timeout) override;
+
+        /** @brief Get the host name or address of the instrument */
+        const QString &getHost() const { return _host; }
+
+        /** @brief Get the instrument port */
+        quint16 getPort() const { return _port; }
+
+        /** @brief generate a interface id for session creation
+            @param host The host name or address of the instrument
+            @param port The instrument port
+            @return TCPIP socket interface id with QString format */
+        static QString generateInterfaceId(const QString &host, quint16 port = DefaultPort);
+
+    protected:
+        /** @copydoc AVisacom::writePriv */
+        virtual bool writePriv(const QByteArray &command) override;
+
+        /** @copydoc AVisacom::readPriv */
+        virtual bool readPriv(QByteArray &outputBuffer) override;
+
+        /** @copydoc AVisacom::readRawPriv
+            @note The socket has no END indicator: endReached is always false */
+        virtual bool readRawPriv(char *data,
+                                 qint64 maxSize,
+                                 qint64 &readSize,
+                                 bool &endReached) override;
+
+        /** @copydoc AVisacom::tuneReadBufferPriv
+            @note The socket reads directly into the destination, there is nothing to tune */
+        virtual bool tuneReadBufferPriv(quint32 chunkSize) override;
+
+    private:
+        /** @brief Parse the host and the port from the interface id
+            @return True if the interface id is valid */
+        bool parseInterfaceId();
+
+    public:
+        /** @brief The usual raw SCPI port */
+        static const constexpr quint16 DefaultPort = 5025;
+
+    private:
+        static const constexpr char *tcpSocketItf = "TCPIP0::%1::%2::SOCKET";
+        static const constexpr char *tcpipPrefix = "TCPIP";
+        static const constexpr char *socketSuffix = "::SOCKET";
+        static const constexpr char *itfSeparator = "::";
+
+        static const constexpr char lineFeed = '\n';
+
+        static const constexpr qint32 defaultTimeoutInMs = 2000;
+
+    private:
+        TcpSocketThread *_socketThread{nullptr};
+        QString _host;
+        quint16 _port{DefaultPort};
+        qint32 _timeoutInMs{defaultTimeoutInMs};
+};
@@ -6,20 +6,26 @@
 #include "visacommanager.hpp"
 
 #include <array>
-#include "visa.h"
 
 #include "avisacomaccesskey.hpp"
 #include "avisacom.hpp"
+#include "tcpip/visacomtcpsocket.hpp"
+
+#ifndef QTVISACOMLIB_NO_VISA
+#include "visa.h"
+
 #include "visacomasrl.hpp"
 #include "visacomgpib.hpp"
 #include "visacomusb.hpp"
 #include "visacomgpib4881.hpp"
+#endif
 
 VisacomManager* VisacomManager::_instance = nullptr;
 
 
 VisacomManager::VisacomManager(QObject *parent) : QObject(parent)
 {
+#ifndef QTVISACOMLIB_NO_VISA
     _status = viOpenDefaultRM(&_defaultRM);
     if(_status < VI_SUCCESS)
     {
@@ -28,6 +34,7 @@ VisacomManager::VisacomManager(QObject *parent) : QObject(parent)
         viStatusDesc(_defaultRM, _status, desc._Elems);
         qWarning() << "Could not open session to the VISA Resource Manager. " << desc._Elems;
     }
+#endif
 }
 
 VisacomManager::~VisacomManager()
@@ -35,6 +42,7 @@ VisacomManager::~VisacomManager()
     // Clear all current instance, which will fire there destructions
     _visaComInstances.clear();
 
+#ifndef QTVISACOMLIB_NO_VISA
     _status = viClose(_defaultRM);
 
     if (_status < VI_SUCCESS)
@@ -43,6 +51,7 @@ VisacomManager::~VisacomManager()
         viStatusDesc(_defaultRM, _status, desc._Elems);
         qWarning() << "Could not close session to the VISA Resource Manager. " << desc._Elems;
     }
+#endif
 }
 
 VisacomManager &VisacomManager::getInstance()
@@ -55,6 +64,7 @@ VisacomManager &VisacomManager::getInstance()
     return *_instance;
 }
 
+#ifndef QTVISACOMLIB_NO_VISA
 QSharedPointer<VisacomGpib> VisacomManager::createAndOpenGpib(quint16 gpibNumber, quint16 address)
 {
     auto itfIdGenerate = [&gpibNumber, &address]() {
@@ -112,6 +122,21 @@ QSharedPointer<VisacomUsb> VisacomManager::createAndOpenUsb(quint16 usbNumber,
 
     return qSharedPointerCast<VisacomUsb>(createAndOpenVisacom(itfIdGenerate, factory));
 }
+#endif
+
+QSharedPointer<VisacomTcpSocket> VisacomManager::createAndOpenTcpSocket(const QString &host,
+                                                                        quint16 port)
+{
+    auto itfIdGenerate = [&host, &port]() {
+        return VisacomTcpSocket::generateInterfaceId(host, port);
+    };
+
+    auto factory = [this](const QString &interfaceId) {
+        return new VisacomTcpSocket(interfaceId, *this);
+    };
+
+    return qSharedPointerCast<VisacomTcpSocket>(createAndOpenVisacom(itfIdGenerate, factory));
+}
 
 void VisacomManager::freeAVisacom(const AVisacomAccessKey &key, const QString &interfaceId)
 {
@@ -123,10 +148,12 @@ QSharedPointer<AVisacom> VisacomManager::createAndOpenVisacom(
                                         std::function<QString ()> generateItfId,
                                         std::function<AVisacom *(const QString &)> factoryVisacom)
 {
+#ifndef QTVISACOMLIB_NO_VISA
     if(_status < VI_SUCCESS){
         qWarning() << "Visa Ressource Manager error, open visa session impossible !";
         return nullptr;
     }
+#endif
 
     if(!_mutex.tryLock(mutexTimeout))
     {
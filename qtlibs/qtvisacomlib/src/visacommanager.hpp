@@ -17,6 +17,7 @@ class AVisacom;
 class AVisacomAccessKey;
 class VisacomGpib;
 class VisacomAsrl;
+class VisacomTcpSocket;
 class VisacomUsb;
 class VisacomGpib4881;
 
@@ -53,6 +54,7 @@ class VISACOM_EXPORT VisacomManager : public QObject
         template<class T>
         QSharedPointer<T> getVisaComExt(const QString &interfaceId);
 
+#ifndef QTVISACOMLIB_NO_VISA
         /** @brief Generate VisaComGpib instance and open Instrument session
             @param gpibNumber define the gpib board/controller used
             @param address the gpib address defined on the instrument
@@ -87,6 +89,16 @@ class VISACOM_EXPORT VisacomManager : public QObject
                                                     quint32 pid,
                                                     const QString &serialNumber,
                                                     quint16 interfaceNumber);
+#endif
+
+        /** @brief Generate VisacomTcpSocket instance and open the connection to the instrument
+            @note The instrument is reached through a raw TCP socket, without visa. This method is
+                  available even if the library has been built without visa
+            @param host The host name or address of the instrument
+            @param port The instrument port, the raw SCPI port is commonly 5025
+            @note Interface: [  TCPIP0::[host]::[port]::SOCKET   ]
+            @return A pointer to VisacomTcpSocket instance */
+        QSharedPointer<VisacomTcpSocket> createAndOpenTcpSocket(const QString &host, quint16 port);
 
         /** @brief Return the resource manager session */
         unsigned long getDefaultRm() const { return _defaultRM; }
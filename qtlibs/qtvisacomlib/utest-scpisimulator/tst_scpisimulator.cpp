@@ -0,0 +1,509 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tst_scpisimulator.hpp"
+
+#include <QBuffer>
+#include <QElapsedTimer>
+#include <QFile>
+#include <QRegularExpression>
+#include <QSignalSpy>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <algorithm>
+
+#include "src/simulator/scpisimulator.hpp"
+#include "src/tcpip/visacomtcpsocket.hpp"
+#include "src/visacommanager.hpp"
+
+
+/** @brief The timeout of each query */
+static const constexpr int QueryTimeoutInMs = 5000;
+
+/** @brief The block read chunk size set before each test */
+static const constexpr quint32 ReadChunkSizeForTests = 256 * 1024;
+
+/** @brief The latency set in the simulator to test it */
+static const constexpr int SimulatorLatencyInMs = 100;
+
+/** @brief The number of queries sent by a latency benchmark with a small answer */
+static const constexpr int LatencyQueriesNb = 500;
+
+/** @brief The number of answer bytes received by a latency benchmark with a block answer, the
+           number of queries depends of the block size */
+static const constexpr qint64 BenchBlockBytesNb = 64 * 1024 * 1024;
+
+/** @brief The number of block bytes read by a block read benchmark */
+static const constexpr qint64 BenchReadBlockBytesNb = 256 * 1024 * 1024;
+
+/** @brief The min number of queries sent by a latency benchmark */
+static const constexpr int LatencyMinQueriesNb = 20;
+
+/** @brief The number of nanoseconds in a microsecond */
+static const constexpr double NsInUs = 1000.0;
+
+/** @brief The number of nanoseconds in a millisecond */
+static const constexpr double NsInMs = 1000000.0;
+
+/** @brief The number of nanoseconds in a second */
+static const constexpr double NsInS = 1000000000.0;
+
+
+/** @brief Get the percentile of latencies, the latencies have to be sorted */
+static qint64 getPercentile(const QVector<qint64> &sortedLatencies, int percent)
+{
+    if(sortedLatencies.isEmpty())
+    {
+        return 0;
+    }
+
+    const int rank = ((sortedLatencies.length() * percent) + 99) / 100;
+    return sortedLatencies.at(qBound(0, rank - 1, sortedLatencies.length() - 1));
+}
+
+
+ScpiSimulatorTest::ScpiSimulatorTest()
+{
+}
+
+ScpiSimulatorTest::~ScpiSimulatorTest()
+{
+}
+
+void ScpiSimulatorTest::initTestCase()
+{
+    _simulator = new ScpiSimulator();
+    QVERIFY(_simulator->startSimulator());
+    QVERIFY(_simulator->getPort() != 0);
+
+    _visacom = VisacomManager::getInstance().createAndOpenTcpSocket(QStringLiteral("127.0.0.1"),
+                                                                     _simulator->getPort());
+    QVERIFY(!_visacom.isNull());
+    QVERIFY(_visacom->isOpen());
+    QCOMPARE(_visacom->getHost(), QStringLiteral("127.0.0.1"));
+    QCOMPARE(_visacom->getPort(), _simulator->getPort());
+}
+
+void ScpiSimulatorTest::cleanupTestCase()
+{
+    if(!_visacom.isNull())
+    {
+        _visacom->close();
+        _visacom.clear();
+    }
+
+    delete _simulator;
+    _simulator = nullptr;
+}
+
+void ScpiSimulatorTest::init()
+{
+    _simulator->setLatencyInMs(0);
+    QVERIFY(_visacom->setTimeout(QueryTimeoutInMs));
+    QVERIFY(_visacom->setReadChunkSize(ReadChunkSizeForTests));
+    QVERIFY(_visacom->clear());
+}
+
+void ScpiSimulatorTest::test_interfaceid_data()
+{
+    QTest::addColumn<QString>("host");
+    QTest::addColumn<quint16>("port");
+    QTest::addColumn<QString>("interfaceId");
+
+    QTest::newRow("IPv4") << QStringLiteral("192.168.1.10") << quint16(5025)
+                          << QStringLiteral("TCPIP0::192.168.1.10::5025::SOCKET");
+    QTest::newRow("host name") << QStringLiteral("dmm.local") << quint16(5555)
+                               << QStringLiteral("TCPIP0::dmm.local::5555::SOCKET");
+    QTest::newRow("IPv6") << QStringLiteral("fe80::1") << quint16(5025)
+                          << QStringLiteral("TCPIP0::[fe80::1]::5025::SOCKET");
+}
+
+void ScpiSimulatorTest::test_interfaceid()
+{
+    QFETCH(QString, host);
+    QFETCH(quint16, port);
+    QFETCH(QString, interfaceId);
+
+    QCOMPARE(VisacomTcpSocket::generateInterfaceId(host, port), interfaceId);
+}
+
+void ScpiSimulatorTest::test_identification()
+{
+    QByteArray answer;
+    QVERIFY(query("*IDN?", answer));
+    QCOMPARE(answer, QByteArray("ALLCircuits,ScpiSimulator,0,1.0\n"));
+
+    // The string methods of AVisacom give the same answer
+    QString answerStr;
+    QVERIFY(_visacom->write(QStringLiteral("*IDN?")));
+    QVERIFY(_visacom->read(answerStr));
+    QCOMPARE(answerStr, QString::fromLatin1(answer));
+}
+
+void ScpiSimulatorTest::test_rules()
+{
+    const quint64 commandsNb = _simulator->getCommandsNb();
+
+    _simulator->addRule(QStringLiteral("MEAS:VOLT:DC?"), "+1.234567E+00");
+    _simulator->addRule(QRegularExpression(QStringLiteral("CONF:VOLT:(AC|DC)")));
+
+    QByteArray answer;
+    QVERIFY(query("meas:volt:dc?", answer));
+    QCOMPARE(answer, QByteArray("+1.234567E+00\n"));
+
+    QVERIFY(_visacom->write(QByteArray("CONF:VOLT:AC")));
+    QVERIFY(query("SYST:ERR?", answer));
+    QCOMPARE(answer, QByteArray("0,\"No error\"\n"));
+
+    // The last rule added overrides the previous ones
+    _simulator->addRule(QStringLiteral("MEAS:VOLT:DC?"), "+2.000000E+00\n");
+    QVERIFY(query("MEAS:VOLT:DC?", answer));
+    QCOMPARE(answer, QByteArray("+2.000000E+00\n"));
+
+    QCOMPARE(_simulator->getCommandsNb(), commandsNb + 4);
+    QCOMPARE(_simulator->getLastCommand(), QByteArray("MEAS:VOLT:DC?"));
+}
+
+void ScpiSimulatorTest::test_errorqueue()
+{
+    QVERIFY(_visacom->write(QByteArray("*CLS")));
+    QVERIFY(_visacom->write(QByteArray("UNKNOWN:COMMAND 12")));
+
+    QByteArray answer;
+    QVERIFY(query("SYSTem:ERRor:NEXT?", answer));
+    QCOMPARE(answer, QByteArray("-113,\"Undefined header\"\n"));
+
+    QVERIFY(query("SYST:ERR?", answer));
+    QCOMPARE(answer, QByteArray("0,\"No error\"\n"));
+}
+
+void ScpiSimulatorTest::test_blockanswer_data()
+{
+    QTest::addColumn<qint64>("blockSize");
+
+    const QVector<qint64> blockSizes = { 0, 1, 10, 1000, 65536, 4 * 1024 * 1024 };
+    for(qint64 blockSize : blockSizes)
+    {
+        QTest::addRow("%lld bytes", blockSize) << blockSize;
+    }
+}
+
+void ScpiSimulatorTest::test_blockanswer()
+{
+    QFETCH(qint64, blockSize);
+
+    const QByteArray command = QString("TEST:BLOCK%1?").arg(blockSize).toLatin1();
+    _simulator->addBlockRule(QString::fromLatin1(command), blockSize);
+
+    // The block contains line feeds, they mustn't end the reading
+    QByteArray answer;
+    QVERIFY(query(command, answer));
+    QCOMPARE(answer.length(), ScpiSimulator::createBlockAnswer(blockSize).length());
+    QVERIFY(answer == ScpiSimulator::createBlockAnswer(blockSize));
+
+    // The next answer isn't mixed with the block
+    QVERIFY(query("*OPC?", answer));
+    QCOMPARE(answer, QByteArray("1\n"));
+}
+
+void ScpiSimulatorTest::test_readblock_data()
+{
+    QTest::addColumn<qint64>("blockSize");
+    QTest::addColumn<quint32>("chunkSize");
+
+    const QVector<qint64> blockSizes = { 0, 1, 1000, 65536, 4 * 1024 * 1024 + 3 };
+    const QVector<quint32> chunkSizes = { 1, 4096, 1024 * 1024 };
+    for(qint64 blockSize : blockSizes)
+    {
+        for(quint32 chunkSize : chunkSizes)
+        {
+            // A byte by byte read of a big block would take too long
+            if(chunkSize > 1 || blockSize <= 65536)
+            {
+                QTest::addRow("%lld bytes, chunk %u", blockSize, chunkSize) << blockSize
+                                                                            << chunkSize;
+            }
+        }
+    }
+}
+
+void ScpiSimulatorTest::test_readblock()
+{
+    QFETCH(qint64, blockSize);
+    QFETCH(quint32, chunkSize);
+
+    const QByteArray command = QString("TEST:READBLOCK%1?").arg(blockSize).toLatin1();
+    _simulator->addBlockRule(QString::fromLatin1(command), blockSize);
+
+    const QByteArray answer = ScpiSimulator::createBlockAnswer(blockSize);
+    const QByteArray expectedData = answer.mid(answer.length() - 1 - static_cast<int>(blockSize),
+                                               static_cast<int>(blockSize));
+
+    QVERIFY(_visacom->setReadChunkSize(chunkSize));
+    QCOMPARE(_visacom->getReadChunkSize(), chunkSize);
+
+    // In a byte array
+    QByteArray data;
+    QVERIFY(_visacom->write(command));
+    QVERIFY(_visacom->readBlock(data));
+    QVERIFY(data == expectedData);
+
+    // In a device
+    QBuffer buffer;
+    QVERIFY(buffer.open(QIODevice::WriteOnly));
+    QVERIFY(_visacom->write(command));
+    QVERIFY(_visacom->readBlock(buffer));
+    QVERIFY(buffer.data() == expectedData);
+
+    // Chunk by chunk
+    QByteArray chunks;
+    qint64 maxChunkSize = 0;
+    QVERIFY(_visacom->write(command));
+    QVERIFY(_visacom->readBlock([&chunks, &maxChunkSize](const char *chunk, qint64 size) {
+        chunks.append(chunk, static_cast<int>(size));
+        maxChunkSize = qMax(maxChunkSize, size);
+        return true;
+    }));
+    QVERIFY(chunks == expectedData);
+    QVERIFY(maxChunkSize <= chunkSize);
+
+    // The terminator has been read with the block: the next answer isn't mixed with it
+    QByteArray opcAnswer;
+    QVERIFY(query("*OPC?", opcAnswer));
+    QCOMPARE(opcAnswer, QByteArray("1\n"));
+}
+
+void ScpiSimulatorTest::test_readblock_stop()
+{
+    const qint64 blockSize = 1024 * 1024;
+    _simulator->addBlockRule(QStringLiteral("TEST:STOPBLOCK?"), blockSize);
+
+    QVERIFY(!_visacom->setReadChunkSize(0));
+
+    // Stopped by the callback
+    int chunksNb = 0;
+    QVERIFY(_visacom->write(QByteArray("TEST:STOPBLOCK?")));
+    QVERIFY(!_visacom->readBlock([&chunksNb](const char *chunk, qint64 size) {
+        Q_UNUSED(chunk)
+        Q_UNUSED(size)
+        ++chunksNb;
+        return false;
+    }));
+    QCOMPARE(chunksNb, 1);
+
+    // The rest of the block may still be received after the clear
+    QTest::qWait(SimulatorLatencyInMs);
+    QVERIFY(_visacom->clear());
+
+    // A message which isn't a block
+    QVERIFY(_visacom->write(QByteArray("*IDN?")));
+    QByteArray data;
+    QVERIFY(!_visacom->readBlock(data));
+    QVERIFY(data.isEmpty());
+    QVERIFY(_visacom->clear());
+
+    // The session still works
+    QByteArray answer;
+    QVERIFY(query("*OPC?", answer));
+    QCOMPARE(answer, QByteArray("1\n"));
+}
+
+void ScpiSimulatorTest::test_latency()
+{
+    _simulator->setLatencyInMs(SimulatorLatencyInMs);
+
+    QElapsedTimer timer;
+    timer.start();
+
+    QByteArray answer;
+    QVERIFY(query("*OPC?", answer));
+    QCOMPARE(answer, QByteArray("1\n"));
+
+    // The coarse timers may fire a few percents before the expected time
+    QVERIFY(timer.elapsed() >= ((SimulatorLatencyInMs * 9) / 10));
+
+    // The read timeout is reached before the answer
+    QVERIFY(_visacom->setTimeout(SimulatorLatencyInMs / 4));
+    QVERIFY(!query("*OPC?", answer));
+
+    QTest::qWait(SimulatorLatencyInMs * 2);
+    QVERIFY(_visacom->clear());
+}
+
+void ScpiSimulatorTest::test_script()
+{
+    QTemporaryDir dir;
+    QVERIFY(dir.isValid());
+
+    const QString scriptPath = dir.filePath(QStringLiteral("simulator.txt"));
+    QFile script(scriptPath);
+    QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Text));
+    script.write("# Script of the test\n"
+                 "@latency 0\n"
+                 "SCRIPT:IDN? => ACME,DMM1000,1234,1.0\n"
+                 "/SCRIPT:RANG [0-9]+/ =>\n"
+                 "SCRIPT:DATA? => @block 2048\n");
+    script.close();
+
+    QVERIFY(_simulator->loadScript(scriptPath));
+
+    QByteArray answer;
+    QVERIFY(query("SCRIPT:IDN?", answer));
+    QCOMPARE(answer, QByteArray("ACME,DMM1000,1234,1.0\n"));
+
+    QVERIFY(_visacom->write(QByteArray("SCRIPT:RANG 10")));
+    QVERIFY(query("SYST:ERR?", answer));
+    QCOMPARE(answer, QByteArray("0,\"No error\"\n"));
+
+    QVERIFY(query("SCRIPT:DATA?", answer));
+    QVERIFY(answer == ScpiSimulator::createBlockAnswer(2048));
+
+    // An invalid script is refused
+    QVERIFY(script.open(QIODevice::WriteOnly | QIODevice::Text));
+    script.write("SCRIPT:WRONG? ACME\n");
+    script.close();
+
+    QVERIFY(!_simulator->loadScript(scriptPath));
+}
+
+void ScpiSimulatorTest::test_asyncquery()
+{
+    QSignalSpy spy(_visacom.data(), &AVisacom::messageReceived);
+
+    QVERIFY(_visacom->asyncQuery(QByteArray("*IDN?")));
+    QVERIFY(spy.wait(QueryTimeoutInMs));
+
+    QCOMPARE(spy.count(), 1);
+    QCOMPARE(spy.at(0).at(0).toByteArray(), QByteArray("ALLCircuits,ScpiSimulator,0,1.0\n"));
+}
+
+void ScpiSimulatorTest::bench_querylatency_data()
+{
+    QTest::addColumn<qint64>("blockSize");
+
+    QTest::newRow("small answer") << qint64(-1);
+
+    const QVector<qint64> blockSizes = { 4 * 1024, 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+    for(qint64 blockSize : blockSizes)
+    {
+        QTest::addRow("block of %lld bytes", blockSize) << blockSize;
+    }
+}
+
+void ScpiSimulatorTest::bench_querylatency()
+{
+    QFETCH(qint64, blockSize);
+
+    QByteArray command("*OPC?");
+    int queriesNb = LatencyQueriesNb;
+
+    if(blockSize >= 0)
+    {
+        command = QString("BENCH:BLOCK%1?").arg(blockSize).toLatin1();
+        _simulator->addBlockRule(QString::fromLatin1(command), blockSize);
+        queriesNb = static_cast<int>(qBound(static_cast<qint64>(LatencyMinQueriesNb),
+                                            BenchBlockBytesNb / blockSize,
+                                            static_cast<qint64>(LatencyQueriesNb)));
+    }
+
+    QVector<qint64> latencies;
+    latencies.reserve(queriesNb);
+    qint64 answerBytesNb = 0;
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int idx = 0; idx < queriesNb; ++idx)
+    {
+        QByteArray answer;
+        const qint64 startInNs = timer.nsecsElapsed();
+        QVERIFY(query(command, answer));
+        latencies.append(timer.nsecsElapsed() - startInNs);
+        answerBytesNb += answer.length();
+    }
+
+    const double elapsedInS = qMax(timer.nsecsElapsed(), qint64(1)) / NsInS;
+
+    std::sort(latencies.begin(), latencies.end());
+
+    qInfo().noquote() << QString("query latency; answer: %1 B; queries: %2; %3 query/s; "
+                                 "%4 B/s; p50: %5 us; p90: %6 us; p99: %7 us; max: %8 us")
+                             .arg(answerBytesNb / queriesNb)
+                             .arg(queriesNb)
+                             .arg(queriesNb / elapsedInS, 0, 'f', 0)
+                             .arg(answerBytesNb / elapsedInS, 0, 'f', 0)
+                             .arg(getPercentile(latencies, 50) / NsInUs, 0, 'f', 1)
+                             .arg(getPercentile(latencies, 90) / NsInUs, 0, 'f', 1)
+                             .arg(getPercentile(latencies, 99) / NsInUs, 0, 'f', 1)
+                             .arg(latencies.last() / NsInUs, 0, 'f', 1);
+
+    QTest::setBenchmarkResult(getPercentile(latencies, 50) / NsInMs,
+                              QTest::WalltimeMilliseconds);
+}
+
+void ScpiSimulatorTest::bench_readblock_data()
+{
+    QTest::addColumn<qint64>("blockSize");
+    QTest::addColumn<bool>("streamed");
+
+    const QVector<qint64> blockSizes = { 64 * 1024, 1024 * 1024, 16 * 1024 * 1024 };
+    for(qint64 blockSize : blockSizes)
+    {
+        QTest::addRow("message %lld bytes", blockSize) << blockSize << false;
+        QTest::addRow("block %lld bytes", blockSize) << blockSize << true;
+    }
+}
+
+void ScpiSimulatorTest::bench_readblock()
+{
+    QFETCH(qint64, blockSize);
+    QFETCH(bool, streamed);
+
+    const QByteArray command = QString("BENCH:READBLOCK%1?").arg(blockSize).toLatin1();
+    _simulator->addBlockRule(QString::fromLatin1(command), blockSize);
+
+    const int queriesNb = static_cast<int>(qMax(static_cast<qint64>(LatencyMinQueriesNb),
+                                                BenchReadBlockBytesNb / blockSize));
+
+    QElapsedTimer timer;
+    timer.start();
+
+    for(int idx = 0; idx < queriesNb; ++idx)
+    {
+        QByteArray data;
+        QVERIFY(_visacom->write(command));
+
+        if(streamed)
+        {
+            QVERIFY(_visacom->readBlock(data));
+        }
+        else
+        {
+            QVERIFY(_visacom->read(data));
+        }
+    }
+
+    const double elapsedInS = qMax(timer.nsecsElapsed(), qint64(1)) / NsInS;
+
+    qInfo().noquote() << QString("block read; %1; block: %2 B; queries: %3; %4 B/s")
+                             .arg(streamed ? "readBlock" : "read")
+                             .arg(blockSize)
+                             .arg(queriesNb)
+                             .arg((blockSize * queriesNb) / elapsedInS, 0, 'f', 0);
+
+    QTest::setBenchmarkResult((elapsedInS * 1000.0) / queriesNb, QTest::WalltimeMilliseconds);
+}
+
+bool ScpiSimulatorTest::query(const QByteArray &command, QByteArray &answer)
+{
+    if(!_visacom->write(command))
+    {
+        return false;
+    }
+
+    return _visacom->read(answer);
+}
+
+QTEST_GUILESS_MAIN(ScpiSimulatorTest)
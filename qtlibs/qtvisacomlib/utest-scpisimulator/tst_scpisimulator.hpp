@@ -0,0 +1,60 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QSharedPointer>
+
+class ScpiSimulator;
+class VisacomTcpSocket;
+
+
+/** @brief Tests the TCPIP socket visa com against the software SCPI simulator, without hardware
+    @note The benchmarks give the latency percentiles of the full query path (write, then read of
+          the answer) and the throughput of the block answers. They are printed in the test logs
+          to be compared from one version to another; run them with:
+          "utest-scpisimulator bench_<name>" */
+class ScpiSimulatorTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        ScpiSimulatorTest();
+        ~ScpiSimulatorTest();
+
+    private slots:
+        void initTestCase();
+        void cleanupTestCase();
+        void init();
+        void test_interfaceid_data();
+        void test_interfaceid();
+        void test_identification();
+        void test_rules();
+        void test_errorqueue();
+        void test_blockanswer_data();
+        void test_blockanswer();
+        void test_readblock_data();
+        void test_readblock();
+        void test_readblock_stop();
+        void test_latency();
+        void test_script();
+        void test_asyncquery();
+        void bench_querylatency_data();
+        void bench_querylatency();
+        void bench_readblock_data();
+        void bench_readblock();
+
+    private:
+        /** @brief Write a command and read its answer
+            @param command The command to write
+            @param answer The answer read, with its line feed
+            @return True if no problem occurred */
+        bool query(const QByteArray &command, QByteArray &answer);
+
+    private:
+        ScpiSimulator *_simulator{nullptr};
+        QSharedPointer<VisacomTcpSocket> _visacom;
+};
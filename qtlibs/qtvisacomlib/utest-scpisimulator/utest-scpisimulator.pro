@@ -0,0 +1,38 @@
+# SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+#
+# SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+QT += testlib
+QT += network
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+CONFIG *= c++17
+
+TEMPLATE = app
+
+ROOT = $$absolute_path(../../..)
+QT_LIBS = $$absolute_path($$ROOT/qtlibs)
+QT_UTILITIES = $$absolute_path($$ROOT/qtutilities)
+TEST_ROOT = $$absolute_path(.)
+
+include($$ROOT/import-build-params.pri)
+
+DESTDIR = $$DESTDIR_LIBS
+
+INCLUDEPATH *= $$ROOT
+INCLUDEPATH *= $$QT_UTILITIES
+INCLUDEPATH *= $$TEST_ROOT
+
+HEADERS *=  tst_scpisimulator.hpp
+SOURCES *=  tst_scpisimulator.cpp
+
+# The TCPIP socket and the simulator don't need visa, the test can be built without it
+include($$QT_LIBS/import-qtvisacomlib.pri)
+
+unix {
+    target.path = /opt/utest
+    INSTALLS += target
+}
@@ -7,7 +7,7 @@
 #include <QCanBusFrame>
 #include <QDebug>
 
-#include "byteutility/bytearrayhelper.hpp"
+#include "textcodec/canframetextcodec.hpp"
 
 
 CanBusFrameHelper::CanBusFrameHelper()
@@ -16,71 +16,22 @@ CanBusFrameHelper::CanBusFrameHelper()
 
 QString CanBusFrameHelper::stringifyFrame(const QCanBusFrame &frame)
 {
-    QString id = QString::number(frame.frameId(), 16).toUpper();
-    QString length = QString::number(frame.payload().size());
-
-    QString payload;
-    ByteArrayHelper::convertToStringHex(frame.payload(), payload, false);
-
-    return QString(CanBusFormat).arg(id, length, payload);
+    QByteArray text;
+    CanFrameTextCodec::appendFrame(frame, text);
+    return QString::fromLatin1(text);
 }
 
 bool CanBusFrameHelper::parseStrFrame(const QString &strFrame, QCanBusFrame &frame)
 {
-    const QStringList frameParts = strFrame.split(StrSeparator);
-
-    if(frameParts.length() != PartsNb)
-    {
-        qWarning() << "We were trying to parse the stringified CAN frame: " << strFrame << ", but "
-                   << "the parts number of the frame doesn't match the expected one: " << PartsNb;
-        return false;
-    }
-
-    QByteArray hexId;
-    if(!ByteArrayHelper::parseFromHex(frameParts[IdPartIdx], hexId))
-    {
-        qWarning() << "We were trying to parse the stringified CAN frame: " << strFrame << ", but "
-                   << "the id part can't be parsed";
-        return false;
-    }
-
-    quint32 id;
-    if(!ByteArrayHelper::toUintHex(hexId, id))
-    {
-        qWarning() << "We were trying to parse the stringified CAN frame: " << strFrame << ", but "
-                   << "the id part can't be converted to a quint32";
-        return false;
-    }
-
-    frame.setFrameId(id);
-
-    bool ok = false;
-    const int payloadSize = frameParts[LengthPartIdx].toInt(&ok);
+    const QByteArray text = strFrame.toLatin1();
 
-    if(!ok)
+    if(!CanFrameTextCodec::parseFrame(text.constData(), text.constData() + text.size(), frame))
     {
         qWarning() << "We were trying to parse the stringified CAN frame: " << strFrame << ", but "
-                   << "the length part can't be converted to a qint32";
+                   << "it doesn't match the expected format: id/length/payload";
         return false;
     }
 
-    QByteArray payload(payloadSize, 0x00);
-    if(!ByteArrayHelper::parseFromHex(frameParts[PayloadPartIdx], payload))
-    {
-        qWarning() << "We were trying to parse the stringified CAN frame: " << strFrame << ", but "
-                   << "the payload part can't be parsed";
-        return false;
-    }
-
-    if(payload.size() != payloadSize)
-    {
-        qWarning() << "We were trying to parse the stringified CAN frame: " << strFrame << ", but "
-                   << "the payload size isn't the expecting one";
-        return false;
-    }
-
-    frame.setPayload(payload);
-
     return true;
 }
 
@@ -20,7 +20,8 @@ class CanBusFrameHelper
         /** @brief Stringiy a QCanBusFrame
             @note Only the frame id, the payload and its length are written in the string (not
                   the options)
-            @note To separate the elements, the separator: @ref StrSeparator is used
+            @note To separate the elements, the separator: @ref CanFrameTextCodec::Separator is
+                  used
             @warning The cmd id and payload are written in base 16 and the payload size is written
                      in base 10
             @param frame The frame to stringify
@@ -30,6 +31,7 @@ class CanBusFrameHelper
         /** @brief Parse a stringified frame to a @ref QCanBusFrame
             @note The @ref strFrame must have the same format as the string returned by the method
                   @ref stringifyFrame
+            @note To parse whole files of stringified frames, use @ref CanFrameTextReader
             @param strFrame The frame representation to parse
             @param frame The frame parsed
             @return True if no problem occurred */
@@ -42,23 +44,4 @@ class CanBusFrameHelper
             @param source The CAN bus frame to copy
             @param target The CAN bus frame to fill with the @ref source information */
         static void copyCanBusFrame(const QCanBusFrame &source, QCanBusFrame &target);
-
-    private:
-        /** @brief The number of expected elements in the stringified frame */
-        static const constexpr int PartsNb = 3;
-
-        /** @brief The index of the frame id in the stringified frame */
-        static const constexpr int IdPartIdx = 0;
-
-        /** @brief The index of the frame length in the stringified frame */
-        static const constexpr int LengthPartIdx = 1;
-
-        /** @brief The index of the payload in the stringified frame */
-        static const constexpr int PayloadPartIdx = 2;
-
-        /** @brief The separator character in the stringified frame */
-        static const constexpr char StrSeparator = '/';
-
-        /** @brief The format used to represent the stringified frame */
-        static const constexpr char* CanBusFormat = "%1/%2/%3";
 };
@@ -10,6 +10,7 @@ c++1* | c++2* {
 }
 
 !contains(DEFINES, BYTE_BMS_LIB) : error("$${TARGET} (CAN_BMS_LIB) requires BYTE_BMS_LIB")
+!contains(DEFINES, NUMBER_BMS_LIB) : error("$${TARGET} (CAN_BMS_LIB) requires NUMBER_BMS_LIB")
 !qtHaveModule(serialbus) : error("$${TARGET} (CAN_BMS_LIB) requires to have serialbus QT module")
 
 DEFINES *= CAN_BMS_LIB
@@ -21,3 +22,21 @@ INCLUDEPATH *= $$CAN_BMS_LIB
 # API
 HEADERS *= $$CAN_BMS_LIB/canbusframehelper.hpp
 SOURCES *= $$CAN_BMS_LIB/canbusframehelper.cpp
+## DBC
+HEADERS *= $$CAN_BMS_LIB/dbc/dbcbatchdecoder.hpp
+SOURCES *= $$CAN_BMS_LIB/dbc/dbcbatchdecoder.cpp
+HEADERS *= $$CAN_BMS_LIB/dbc/dbcdatabase.hpp
+SOURCES *= $$CAN_BMS_LIB/dbc/dbcdatabase.cpp
+HEADERS *= $$CAN_BMS_LIB/dbc/dbcmessage.hpp
+SOURCES *= $$CAN_BMS_LIB/dbc/dbcmessage.cpp
+HEADERS *= $$CAN_BMS_LIB/dbc/dbcmessagecolumns.hpp
+SOURCES *= $$CAN_BMS_LIB/dbc/dbcmessagecolumns.cpp
+HEADERS *= $$CAN_BMS_LIB/dbc/dbcsignal.hpp
+SOURCES *= $$CAN_BMS_LIB/dbc/dbcsignal.cpp
+## Text codec
+HEADERS *= $$CAN_BMS_LIB/textcodec/canframetextcodec.hpp
+SOURCES *= $$CAN_BMS_LIB/textcodec/canframetextcodec.cpp
+HEADERS *= $$CAN_BMS_LIB/textcodec/canframetextreader.hpp
+SOURCES *= $$CAN_BMS_LIB/textcodec/canframetextreader.cpp
+HEADERS *= $$CAN_BMS_LIB/textcodec/canframetextwriter.hpp
+SOURCES *= $$CAN_BMS_LIB/textcodec/canframetextwriter.cpp
@@ -0,0 +1,92 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "dbcbatchdecoder.hpp"
+
+#include <QCanBusFrame>
+#include <QtNumeric>
+
+
+DbcBatchDecoder::DbcBatchDecoder(const DbcDatabase &database, bool exactValuesEnabled)
+    : _database{database},
+    _exactValuesEnabled{exactValuesEnabled}
+{
+}
+
+int DbcBatchDecoder::decode(const QVector<QCanBusFrame> &frames,
+                            QHash<quint32, DbcMessageColumns> &columnsById) const
+{
+    int decodedNb = 0;
+
+    for(auto frameIter = frames.cbegin(); frameIter != frames.cend(); ++frameIter)
+    {
+        if(frameIter->frameType() != QCanBusFrame::DataFrame)
+        {
+            continue;
+        }
+
+        const quint32 frameId = frameIter->frameId();
+        const bool extendedFrameFormat = frameIter->hasExtendedFrameFormat();
+        const DbcMessage *message = _database.getMessage(frameId, extendedFrameFormat);
+        if(message == nullptr)
+        {
+            continue;
+        }
+
+        const quint32 messageKey = DbcDatabase::getMessageKey(frameId, extendedFrameFormat);
+        auto columnsIter = columnsById.find(messageKey);
+        if(columnsIter == columnsById.end())
+        {
+            columnsIter = columnsById.insert(messageKey, DbcMessageColumns(*message));
+        }
+
+        DbcMessageColumns &columns = columnsIter.value();
+
+        const QByteArray payload = frameIter->payload();
+        const quint8 *data = reinterpret_cast<const quint8 *>(payload.constData());
+        const int dataSize = payload.size();
+
+        const QVector<DbcSignal> &dbcSignals = message->getSignals();
+
+        // The multiplexor is extracted first to know which multiplexed signals are present
+        bool multiplexorPresent = false;
+        qint64 multiplexValue = -1;
+        const int multiplexorIdx = message->getMultiplexorIdx();
+        if(multiplexorIdx >= 0)
+        {
+            quint64 rawValue = 0;
+            multiplexorPresent = dbcSignals.at(multiplexorIdx).extractRaw(data, dataSize, rawValue);
+            multiplexValue = static_cast<qint64>(rawValue);
+        }
+
+        const QCanBusFrame::TimeStamp timeStamp = frameIter->timeStamp();
+        columns._timestampsInUs.append((timeStamp.seconds() * 1000000) +
+                                       timeStamp.microSeconds());
+
+        for(int signalIdx = 0; signalIdx < dbcSignals.length(); ++signalIdx)
+        {
+            const DbcSignal &dbcSignal = dbcSignals.at(signalIdx);
+            const qint64 signalMultiplexValue = dbcSignal.getMultiplexValue();
+
+            // The extraction fails, and the signal is skipped, if the signal extends past the
+            // frame payload
+            quint64 rawValue = 0;
+            const bool present = (signalMultiplexValue < 0 ||
+                                  (multiplexorPresent && signalMultiplexValue == multiplexValue)) &&
+                                 dbcSignal.extractRaw(data, dataSize, rawValue);
+
+            columns._values[signalIdx].append(present ? dbcSignal.toPhysical(rawValue) : qQNaN());
+
+            if(_exactValuesEnabled)
+            {
+                columns._exactValues[signalIdx].append(
+                    present ? dbcSignal.toExactPhysical(rawValue) : Number());
+            }
+        }
+
+        ++decodedNb;
+    }
+
+    return decodedNb;
+}
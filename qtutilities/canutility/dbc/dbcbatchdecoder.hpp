@@ -0,0 +1,58 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QHash>
+#include <QVector>
+
+#include "dbc/dbcdatabase.hpp"
+#include "dbc/dbcmessagecolumns.hpp"
+
+class QCanBusFrame;
+
+
+/** @brief Decodes batches of CAN frames to columns of physical values, thanks to the compiled
+           signals of a DBC database
+    @note The decoding is table driven: for each frame, the message is found by its id and each
+          of its signals is extracted with its precomputed byte chunks.
+    @note The exact values (@ref Number) are slower to compute than the double ones, they are
+          only computed if asked */
+class DbcBatchDecoder
+{
+    public:
+        /** @brief Class constructor
+            @param database The database which describes the messages to decode
+            @param exactValuesEnabled True to also compute the exact physical values */
+        explicit DbcBatchDecoder(const DbcDatabase &database, bool exactValuesEnabled = false);
+
+    public:
+        /** @brief Get the database used to decode */
+        const DbcDatabase &getDatabase() const { return _database; }
+
+        /** @brief Test if the exact physical values are computed */
+        bool isExactValuesEnabled() const { return _exactValuesEnabled; }
+
+        /** @brief Set if the exact physical values are computed */
+        void setExactValuesEnabled(bool enabled) { _exactValuesEnabled = enabled; }
+
+        /** @brief Decode a batch of frames and append their values to the messages columns
+            @note The frames which aren't data frames, or which aren't described in the database,
+                  are skipped
+            @note The signals which extend past the frame payload (shorter than the DBC data
+                  length) are skipped: their values are NaN, as the absent multiplexed signals
+            @note The columns of a message are created the first time one of its frames is
+                  decoded. To reuse the columns memory between two batches, call
+                  @ref DbcMessageColumns::clearRows instead of clearing the hash.
+            @param frames The frames to decode
+            @param columnsById The messages columns, indexed by message key (see
+                               @ref DbcDatabase::getMessageKey)
+            @return The number of frames decoded */
+        int decode(const QVector<QCanBusFrame> &frames,
+                   QHash<quint32, DbcMessageColumns> &columnsById) const;
+
+    private:
+        DbcDatabase _database;
+        bool _exactValuesEnabled;
+};
@@ -0,0 +1,252 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "dbcdatabase.hpp"
+
+#include <limits>
+
+#include <QDebug>
+#include <QFile>
+#include <QRegularExpression>
+#include <QTextStream>
+
+
+DbcDatabase::DbcDatabase()
+{
+}
+
+const DbcMessage *DbcDatabase::getMessage(quint32 frameId, bool extendedFrameFormat) const
+{
+    auto citer = _messagesById.constFind(getMessageKey(frameId, extendedFrameFormat));
+    if(citer == _messagesById.cend())
+    {
+        return nullptr;
+    }
+
+    return &citer.value();
+}
+
+bool DbcDatabase::loadFromFile(const QString &filePath, DbcDatabase &database)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly | QIODevice::Text))
+    {
+        qWarning() << "Can't open the DBC file: " << filePath << ", error: "
+                   << file.errorString();
+        return false;
+    }
+
+    QTextStream stream(&file);
+    const QString content = stream.readAll();
+    file.close();
+
+    if(!parse(content, database))
+    {
+        qWarning() << "A problem occurred when tried to parse the DBC file: " << filePath;
+        return false;
+    }
+
+    return true;
+}
+
+bool DbcDatabase::parse(const QString &content, DbcDatabase &database)
+{
+    QHash<quint32, DbcMessage> messagesById;
+
+    DbcMessage currentMessage;
+    bool inMessage = false;
+    bool ignoreSignals = false;
+
+    const auto storeCurrentMessage = [&messagesById, &currentMessage, &inMessage]()
+    {
+        if(!inMessage)
+        {
+            return true;
+        }
+
+        inMessage = false;
+
+        const quint32 messageKey = getMessageKey(currentMessage.getFrameId(),
+                                                 currentMessage.hasExtendedFrameFormat());
+        if(messagesById.contains(messageKey))
+        {
+            qWarning() << "The DBC message: " << currentMessage.getName() << ", has the same "
+                       << "frame id as the message: " << messagesById.value(messageKey).getName();
+            return false;
+        }
+
+        messagesById.insert(messageKey, currentMessage);
+        return true;
+    };
+
+    const QStringList lines = content.split('\n');
+
+    for(int lineIdx = 0; lineIdx < lines.length(); ++lineIdx)
+    {
+        const QString line = lines.at(lineIdx).trimmed();
+
+        if(line.startsWith(MessageKeyword))
+        {
+            if(!storeCurrentMessage())
+            {
+                return false;
+            }
+
+            if(!parseMessageLine(line, currentMessage))
+            {
+                qWarning() << "The DBC message line: " << (lineIdx + 1) << ", isn't valid";
+                return false;
+            }
+
+            // The pseudo message of the independent signals has no extractable signals
+            ignoreSignals = (currentMessage.getFrameId() == IndependentSignalsMsgId);
+            inMessage = !ignoreSignals;
+            continue;
+        }
+
+        if(line.startsWith(SignalKeyword))
+        {
+            if(ignoreSignals)
+            {
+                continue;
+            }
+
+            if(!inMessage)
+            {
+                qWarning() << "The DBC signal line: " << (lineIdx + 1) << ", isn't linked to a "
+                           << "message";
+                return false;
+            }
+
+            DbcSignal dbcSignal;
+            if(!parseSignalLine(line, dbcSignal) || !currentMessage.addSignal(dbcSignal))
+            {
+                qWarning() << "The DBC signal line: " << (lineIdx + 1) << ", isn't valid";
+                return false;
+            }
+
+            continue;
+        }
+
+        if(!line.isEmpty())
+        {
+            // The message signals are always written just after the message line
+            if(!storeCurrentMessage())
+            {
+                return false;
+            }
+
+            ignoreSignals = false;
+        }
+    }
+
+    if(!storeCurrentMessage())
+    {
+        return false;
+    }
+
+    database._messagesById = messagesById;
+    return true;
+}
+
+bool DbcDatabase::parseMessageLine(const QString &line, DbcMessage &message)
+{
+    static const QRegularExpression regExp(MessageRegExp);
+
+    const QRegularExpressionMatch match = regExp.match(line);
+    if(!match.hasMatch())
+    {
+        return false;
+    }
+
+    bool idOk = false;
+    bool lengthOk = false;
+    const quint32 dbcId = match.captured(1).toUInt(&idOk);
+    const int dataLength = match.captured(3).toInt(&lengthOk);
+
+    if(!idOk || !lengthOk)
+    {
+        return false;
+    }
+
+    if(dbcId == IndependentSignalsMsgId)
+    {
+        message = DbcMessage(dbcId, true, match.captured(2), dataLength);
+        return true;
+    }
+
+    const bool extendedFrameFormat = ((dbcId & ExtendedIdFlag) != 0);
+    const quint32 frameId = extendedFrameFormat ? (dbcId & ExtendedIdMask) : dbcId;
+
+    message = DbcMessage(frameId, extendedFrameFormat, match.captured(2), dataLength);
+    return true;
+}
+
+bool DbcDatabase::parseSignalLine(const QString &line, DbcSignal &dbcSignal)
+{
+    static const QRegularExpression regExp(SignalRegExp);
+
+    const QRegularExpressionMatch match = regExp.match(line);
+    if(!match.hasMatch())
+    {
+        return false;
+    }
+
+    dbcSignal.setName(match.captured(1));
+
+    const QString multiplexing = match.captured(2);
+    if(multiplexing == "M")
+    {
+        dbcSignal.setMultiplexor(true);
+    }
+    else if(multiplexing.startsWith('m'))
+    {
+        // The extended multiplexing (m<value>M) is managed as a simple multiplexed signal
+        bool ok = false;
+        const qint64 multiplexValue = multiplexing.mid(1).remove('M').toLongLong(&ok);
+        if(!ok)
+        {
+            return false;
+        }
+
+        dbcSignal.setMultiplexValue(multiplexValue);
+    }
+
+    bool startBitOk = false;
+    bool lengthOk = false;
+    const uint startBit = match.captured(3).toUInt(&startBitOk);
+    const uint bitsLength = match.captured(4).toUInt(&lengthOk);
+
+    if(!startBitOk || !lengthOk ||
+       startBit > std::numeric_limits<quint16>::max() ||
+       bitsLength > std::numeric_limits<quint8>::max())
+    {
+        return false;
+    }
+
+    dbcSignal.setStartBit(static_cast<quint16>(startBit));
+    dbcSignal.setBitsLength(static_cast<quint8>(bitsLength));
+    dbcSignal.setIntel(match.captured(5) == "1");
+    dbcSignal.setSigned(match.captured(6) == "-");
+
+    if(!dbcSignal.setScaling(match.captured(7), match.captured(8)))
+    {
+        return false;
+    }
+
+    bool minOk = false;
+    bool maxOk = false;
+    const double minimum = match.captured(9).toDouble(&minOk);
+    const double maximum = match.captured(10).toDouble(&maxOk);
+
+    if(!minOk || !maxOk)
+    {
+        return false;
+    }
+
+    dbcSignal.setRange(minimum, maximum);
+    dbcSignal.setUnit(match.captured(11));
+
+    return true;
+}
@@ -0,0 +1,106 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QHash>
+#include <QString>
+
+#include "dbc/dbcmessage.hpp"
+
+
+/** @brief Contains the messages loaded from a DBC file, with their compiled signals
+    @note Only the messages (BO_) and the signals (SG_) are parsed, the other DBC sections
+          (comments, values tables, attributes, etc.) are ignored.
+    @note The messages are indexed by their key: the frame id with the extended flag of the DBC
+          file (bit 31) set for the extended frames, see @ref getMessageKey. Therefore, a standard
+          and an extended frames with the same id value have their own messages. */
+class DbcDatabase
+{
+    public:
+        /** @brief Class constructor
+            @note The database is empty */
+        explicit DbcDatabase();
+
+    public:
+        /** @brief Get the message linked to the frame id given
+            @param frameId The CAN frame id of the message
+            @param extendedFrameFormat True if the frame id is a 29 bits one
+            @return The message found or nullptr if the frame id isn't known */
+        const DbcMessage *getMessage(quint32 frameId, bool extendedFrameFormat = false) const;
+
+        /** @brief Get all the messages of the database, indexed by message key */
+        const QHash<quint32, DbcMessage> &getMessages() const { return _messagesById; }
+
+        /** @brief Test if the database contains no message */
+        bool isEmpty() const { return _messagesById.isEmpty(); }
+
+        /** @brief Remove all the messages of the database */
+        void clear() { _messagesById.clear(); }
+
+    public:
+        /** @brief Get the key of a message in the database
+            @param frameId The CAN frame id of the message
+            @param extendedFrameFormat True if the frame id is a 29 bits one
+            @return The message key, it's the message id written in the DBC file */
+        static quint32 getMessageKey(quint32 frameId, bool extendedFrameFormat)
+        { return extendedFrameFormat ? (frameId | ExtendedIdFlag) : frameId; }
+
+        /** @brief Load a DBC file
+            @param filePath The path of the DBC file to load
+            @param database The database filled with the file messages
+            @return True if no problem occurred */
+        static bool loadFromFile(const QString &filePath, DbcDatabase &database);
+
+        /** @brief Parse a DBC file content
+            @param content The DBC content to parse
+            @param database The database filled with the parsed messages
+            @return True if no problem occurred */
+        static bool parse(const QString &content, DbcDatabase &database);
+
+    private:
+        /** @brief Parse a message (BO_) line
+            @param line The line to parse
+            @param message The message parsed
+            @return True if no problem occurred */
+        static bool parseMessageLine(const QString &line, DbcMessage &message);
+
+        /** @brief Parse a signal (SG_) line
+            @param line The line to parse
+            @param dbcSignal The signal parsed
+            @return True if no problem occurred */
+        static bool parseSignalLine(const QString &line, DbcSignal &dbcSignal);
+
+    private:
+        /** @brief The keyword of the message lines */
+        static const constexpr char *MessageKeyword = "BO_ ";
+
+        /** @brief The keyword of the signal lines */
+        static const constexpr char *SignalKeyword = "SG_ ";
+
+        /** @brief The regular expression of a message line
+            @example BO_ 2364540158 EEC1: 8 Vector__XXX */
+        static const constexpr char *MessageRegExp =
+            R"(^BO_\s+(\d+)\s+(\w+)\s*:\s*(\d+)\s*\S*\s*$)";
+
+        /** @brief The regular expression of a signal line
+            @example SG_ EngineSpeed : 24|16@1+ (0.125,0) [0|8031.875] "rpm" Vector__XXX */
+        static const constexpr char *SignalRegExp =
+            R"(^SG_\s+(\w+)\s*(M|m\d+M?)?\s*:\s*(\d+)\|(\d+)@([01])([+-])\s*)"
+            R"(\(\s*([^,\s]+)\s*,\s*([^)\s]+)\s*\)\s*)"
+            R"(\[\s*([^|\s]+)\s*\|\s*([^\]\s]+)\s*\]\s*"([^"]*)")";
+
+        /** @brief The flag set in the DBC message id when the frame id is an extended one */
+        static const constexpr quint32 ExtendedIdFlag = 0x80000000;
+
+        /** @brief The mask of an extended frame id */
+        static const constexpr quint32 ExtendedIdMask = 0x1FFFFFFF;
+
+        /** @brief The id of the pseudo message which contains the signals not linked to a
+                   message, it's ignored */
+        static const constexpr quint32 IndependentSignalsMsgId = 0xC0000000;
+
+    private:
+        QHash<quint32, DbcMessage> _messagesById;
+};
@@ -0,0 +1,65 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "dbcmessage.hpp"
+
+#include <QDebug>
+
+
+DbcMessage::DbcMessage(quint32 frameId,
+                       bool extendedFrameFormat,
+                       const QString &name,
+                       int dataLength)
+    : _frameId{frameId},
+    _extendedFrameFormat{extendedFrameFormat},
+    _name{name},
+    _dataLength{dataLength}
+{
+}
+
+int DbcMessage::getSignalIdx(const QString &signalName) const
+{
+    for(int idx = 0; idx < _signals.length(); ++idx)
+    {
+        if(_signals.at(idx).getName() == signalName)
+        {
+            return idx;
+        }
+    }
+
+    return -1;
+}
+
+bool DbcMessage::addSignal(const DbcSignal &dbcSignal)
+{
+    DbcSignal compiled = dbcSignal;
+    if(!compiled.compile(_name))
+    {
+        qWarning() << "The signal: " << dbcSignal.getName() << ", of the DBC message: " << _name
+                   << ", can't be compiled";
+        return false;
+    }
+
+    if(compiled.getMinPayloadSize() > _dataLength)
+    {
+        qWarning() << "The signal: " << dbcSignal.getName() << ", of the DBC message: " << _name
+                   << ", overflows the message data length: " << _dataLength;
+        return false;
+    }
+
+    if(compiled.isMultiplexor())
+    {
+        if(_multiplexorIdx >= 0)
+        {
+            qWarning() << "The DBC message: " << _name << ", has more than one multiplexor "
+                       << "signal, this isn't managed";
+            return false;
+        }
+
+        _multiplexorIdx = _signals.length();
+    }
+
+    _signals.append(compiled);
+    return true;
+}
@@ -0,0 +1,61 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "dbc/dbcsignal.hpp"
+
+
+/** @brief Represents a message described in a DBC file, with its signals */
+class DbcMessage
+{
+    public:
+        /** @brief Class constructor
+            @param frameId The CAN frame id of the message (without the DBC extended flag)
+            @param extendedFrameFormat True if the frame id is a 29 bits one
+            @param name The message name
+            @param dataLength The length of the message payload */
+        explicit DbcMessage(quint32 frameId = 0,
+                            bool extendedFrameFormat = false,
+                            const QString &name = {},
+                            int dataLength = 0);
+
+    public:
+        /** @brief Get the CAN frame id of the message */
+        quint32 getFrameId() const { return _frameId; }
+
+        /** @brief Test if the frame id is a 29 bits one */
+        bool hasExtendedFrameFormat() const { return _extendedFrameFormat; }
+
+        /** @brief Get the message name */
+        const QString &getName() const { return _name; }
+
+        /** @brief Get the length of the message payload */
+        int getDataLength() const { return _dataLength; }
+
+        /** @brief Get the message signals */
+        const QVector<DbcSignal> &getSignals() const { return _signals; }
+
+        /** @brief Get the index of the signal given, -1 if the signal isn't in the message */
+        int getSignalIdx(const QString &signalName) const;
+
+        /** @brief Get the index of the multiplexor signal, -1 if the message isn't multiplexed */
+        int getMultiplexorIdx() const { return _multiplexorIdx; }
+
+        /** @brief Compile and add a signal to the message
+            @param dbcSignal The signal to add
+            @return True if no problem occurred */
+        bool addSignal(const DbcSignal &dbcSignal);
+
+    private:
+        quint32 _frameId;
+        bool _extendedFrameFormat;
+        QString _name;
+        int _dataLength;
+        QVector<DbcSignal> _signals;
+        int _multiplexorIdx{-1};
+};
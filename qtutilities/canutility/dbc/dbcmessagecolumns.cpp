@@ -0,0 +1,70 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "dbcmessagecolumns.hpp"
+
+#include "dbc/dbcmessage.hpp"
+
+
+DbcMessageColumns::DbcMessageColumns()
+{
+}
+
+DbcMessageColumns::DbcMessageColumns(const DbcMessage &message)
+{
+    const QVector<DbcSignal> &dbcSignals = message.getSignals();
+
+    for(auto citer = dbcSignals.cbegin(); citer != dbcSignals.cend(); ++citer)
+    {
+        _signalsNames.append(citer->getName());
+    }
+
+    _values.resize(dbcSignals.length());
+    _exactValues.resize(dbcSignals.length());
+}
+
+int DbcMessageColumns::getSignalIdx(const QString &signalName) const
+{
+    return _signalsNames.indexOf(signalName);
+}
+
+const QVector<double> &DbcMessageColumns::getValues(int signalIdx) const
+{
+    static const QVector<double> emptyValues;
+
+    if(signalIdx < 0 || signalIdx >= _values.length())
+    {
+        return emptyValues;
+    }
+
+    return _values.at(signalIdx);
+}
+
+const QVector<Number> &DbcMessageColumns::getExactValues(int signalIdx) const
+{
+    static const QVector<Number> emptyValues;
+
+    if(signalIdx < 0 || signalIdx >= _exactValues.length())
+    {
+        return emptyValues;
+    }
+
+    return _exactValues.at(signalIdx);
+}
+
+void DbcMessageColumns::clearRows()
+{
+    // Resizing to 0 keeps the capacity of the vectors
+    _timestampsInUs.resize(0);
+
+    for(auto iter = _values.begin(); iter != _values.end(); ++iter)
+    {
+        iter->resize(0);
+    }
+
+    for(auto iter = _exactValues.begin(); iter != _exactValues.end(); ++iter)
+    {
+        iter->resize(0);
+    }
+}
@@ -0,0 +1,67 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QStringList>
+#include <QVector>
+
+#include "numberutility/number.hpp"
+
+class DbcMessage;
+
+
+/** @brief Contains the decoded values of a DBC message, stored in columns: one column for the
+           frames timestamps and one column by signal
+    @note All the columns have the same rows number: the row n of each column is linked to the
+          n-th decoded frame.
+    @note When a multiplexed signal isn't present in a frame, its physical value is NaN and its
+          exact value is invalid */
+class DbcMessageColumns
+{
+    friend class DbcBatchDecoder;
+
+    public:
+        /** @brief Class constructor
+            @note The columns are empty */
+        explicit DbcMessageColumns();
+
+        /** @brief Class constructor
+            @param message The message to create the columns for */
+        explicit DbcMessageColumns(const DbcMessage &message);
+
+    public:
+        /** @brief Get the number of decoded frames */
+        int getRowsNb() const { return _timestampsInUs.length(); }
+
+        /** @brief Get the names of the signals, in the columns order */
+        const QStringList &getSignalsNames() const { return _signalsNames; }
+
+        /** @brief Get the column index of the signal given, -1 if the signal is unknown */
+        int getSignalIdx(const QString &signalName) const;
+
+        /** @brief Get the timestamps of the decoded frames in microseconds */
+        const QVector<qint64> &getTimestampsInUs() const { return _timestampsInUs; }
+
+        /** @brief Get the physical values of a signal
+            @param signalIdx The column index of the signal
+            @return The physical values, empty if the index isn't valid */
+        const QVector<double> &getValues(int signalIdx) const;
+
+        /** @brief Get the exact physical values of a signal
+            @note The column is empty if the exact values haven't been asked to the decoder
+            @param signalIdx The column index of the signal
+            @return The exact physical values, empty if the index isn't valid */
+        const QVector<Number> &getExactValues(int signalIdx) const;
+
+        /** @brief Remove all the rows of the columns
+            @note The memory allocated is kept to be reused by the next decoding */
+        void clearRows();
+
+    private:
+        QStringList _signalsNames;
+        QVector<qint64> _timestampsInUs;
+        QVector<QVector<double>> _values;
+        QVector<QVector<Number>> _exactValues;
+};
@@ -0,0 +1,153 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "dbcsignal.hpp"
+
+#include <QDebug>
+
+
+DbcSignal::DbcSignal()
+{
+}
+
+bool DbcSignal::setScaling(const QString &factor, const QString &offset)
+{
+    double factorValue = 0.0;
+    double offsetValue = 0.0;
+    Number exactFactor;
+    Number exactOffset;
+
+    if(!parseScalingValue(factor, factorValue, exactFactor) ||
+       !parseScalingValue(offset, offsetValue, exactOffset))
+    {
+        qWarning() << "The scaling of the DBC signal: " << _name << ", isn't valid: (" << factor
+                   << ", " << offset << ")";
+        return false;
+    }
+
+    _factor = factorValue;
+    _offset = offsetValue;
+    _exactFactor = exactFactor;
+    _exactOffset = exactOffset;
+
+    return true;
+}
+
+bool DbcSignal::compile(const QString &messageName)
+{
+    _chunks.clear();
+    _minPayloadSize = 0;
+
+    if(_bitsLength == 0 || _bitsLength > MaxBitsLength)
+    {
+        qWarning() << "The DBC signal: " << _name << ", of the message: " << messageName
+                   << ", has a wrong bits length: " << _bitsLength;
+        return false;
+    }
+
+    if(_startBit >= (MaxPayloadSize * BitsInByte))
+    {
+        qWarning() << "The DBC signal: " << _name << ", of the message: " << messageName
+                   << ", has a wrong start bit: " << _startBit;
+        return false;
+    }
+
+    if(_intel)
+    {
+        // The start bit is the LSB position, the following bits are in the upper positions
+        int bitIdx = 0;
+        while(bitIdx < _bitsLength)
+        {
+            const int position = _startBit + bitIdx;
+            const int bitInByte = position % BitsInByte;
+            const int bitsNb = qMin(BitsInByte - bitInByte, _bitsLength - bitIdx);
+
+            Chunk chunk;
+            chunk.byteIdx = static_cast<quint8>(position / BitsInByte);
+            chunk.rightShift = static_cast<quint8>(bitInByte);
+            chunk.mask = static_cast<quint8>((1U << bitsNb) - 1U);
+            chunk.leftShift = static_cast<quint8>(bitIdx);
+            _chunks.append(chunk);
+
+            bitIdx += bitsNb;
+        }
+    }
+    else
+    {
+        // The start bit is the MSB position, the following bits go down in the same byte and
+        // then continue from the MSB of the next byte
+        int position = _startBit;
+        int remainingBitsNb = _bitsLength;
+        while(remainingBitsNb > 0)
+        {
+            const int byteIdx = position / BitsInByte;
+            const int bitInByte = position % BitsInByte;
+            const int bitsNb = qMin(bitInByte + 1, remainingBitsNb);
+
+            remainingBitsNb -= bitsNb;
+
+            Chunk chunk;
+            chunk.byteIdx = static_cast<quint8>(byteIdx);
+            chunk.rightShift = static_cast<quint8>(bitInByte - bitsNb + 1);
+            chunk.mask = static_cast<quint8>((1U << bitsNb) - 1U);
+            chunk.leftShift = static_cast<quint8>(remainingBitsNb);
+            _chunks.append(chunk);
+
+            position = ((byteIdx + 1) * BitsInByte) + (BitsInByte - 1);
+        }
+    }
+
+    for(auto citer = _chunks.cbegin(); citer != _chunks.cend(); ++citer)
+    {
+        _minPayloadSize = qMax(_minPayloadSize, citer->byteIdx + 1);
+    }
+
+    if(_minPayloadSize > MaxPayloadSize)
+    {
+        // The signal ends after the last bit of a CAN FD payload: its chunks would read out of
+        // the payload
+        qWarning() << "The DBC signal: " << _name << ", of the message: " << messageName
+                   << ", ends out of the max payload size: " << MaxPayloadSize << " bytes";
+        _chunks.clear();
+        _minPayloadSize = 0;
+        return false;
+    }
+
+    _signBitMask = (static_cast<quint64>(1) << (_bitsLength - 1));
+    _signExtensionMask = (_bitsLength == MaxBitsLength) ?
+                             0 :
+                             ~((static_cast<quint64>(1) << _bitsLength) - 1);
+
+    return true;
+}
+
+Number DbcSignal::toExactPhysical(quint64 rawValue) const
+{
+    const Number value = _signed ? Number::fromInt64(static_cast<qint64>(rawValue)) :
+                                   Number::fromUInt64(rawValue);
+    return (value * _exactFactor) + _exactOffset;
+}
+
+bool DbcSignal::parseScalingValue(const QString &strValue, double &value, Number &exactValue)
+{
+    bool ok = false;
+    const QString trimmed = strValue.trimmed();
+    const double parsed = trimmed.toDouble(&ok);
+
+    if(!ok)
+    {
+        return false;
+    }
+
+    // The DBC files may use the exponent notation, which isn't managed by Number
+    Number exact = Number::fromString(trimmed);
+    if(!exact.isValid())
+    {
+        exact = Number::fromDouble(parsed);
+    }
+
+    value = parsed;
+    exactValue = exact;
+    return true;
+}
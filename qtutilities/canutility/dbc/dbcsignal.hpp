@@ -0,0 +1,221 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QString>
+#include <QVector>
+
+#include "numberutility/number.hpp"
+
+
+/** @brief Represents a signal of a DBC message and its compiled extractor
+    @note When the signal is compiled (see @ref compile), the bits layout (start bit, length and
+          byte order) is transformed to a list of byte chunks. Extracting the raw value of the
+          signal is then a loop on those chunks, without any bit per bit computation.
+    @note The signals with float values (SIG_VALTYPE_) aren't managed, their raw values are
+          decoded as integers */
+class DbcSignal
+{
+    private:
+        /** @brief A chunk of the signal bits contained in one byte of the payload */
+        struct Chunk
+        {
+            /** @brief The index of the payload byte */
+            quint8 byteIdx{0};
+
+            /** @brief The right shift to apply on the byte to get the chunk bits */
+            quint8 rightShift{0};
+
+            /** @brief The mask to apply on the shifted byte */
+            quint8 mask{0};
+
+            /** @brief The left shift to place the chunk bits in the raw value */
+            quint8 leftShift{0};
+        };
+
+    public:
+        /** @brief Class constructor
+            @note The signal isn't compiled */
+        explicit DbcSignal();
+
+    public:
+        /** @brief Get the signal name */
+        const QString &getName() const { return _name; }
+
+        /** @brief Set the signal name */
+        void setName(const QString &name) { _name = name; }
+
+        /** @brief Get the start bit of the signal, as written in the DBC file
+            @note For the Intel byte order, it's the position of the LSB; for the Motorola byte
+                  order, it's the position of the MSB */
+        quint16 getStartBit() const { return _startBit; }
+
+        /** @brief Set the start bit of the signal, as written in the DBC file */
+        void setStartBit(quint16 startBit) { _startBit = startBit; }
+
+        /** @brief Get the signal length in bits */
+        quint8 getBitsLength() const { return _bitsLength; }
+
+        /** @brief Set the signal length in bits */
+        void setBitsLength(quint8 bitsLength) { _bitsLength = bitsLength; }
+
+        /** @brief Test if the signal is in Intel byte order (little endian), if false it's in
+                   Motorola byte order (big endian) */
+        bool isIntel() const { return _intel; }
+
+        /** @brief Set the signal byte order */
+        void setIntel(bool intel) { _intel = intel; }
+
+        /** @brief Test if the signal raw value is signed (two's complement) */
+        bool isSigned() const { return _signed; }
+
+        /** @brief Set if the signal raw value is signed */
+        void setSigned(bool isSigned) { _signed = isSigned; }
+
+        /** @brief Get the factor to apply on the raw value */
+        double getFactor() const { return _factor; }
+
+        /** @brief Get the offset to add to the scaled raw value */
+        double getOffset() const { return _offset; }
+
+        /** @brief Set the factor and the offset of the signal
+            @note The values are parsed from their string representation to keep the exact
+                  decimal values, for the @ref Number conversion
+            @param factor The factor string representation
+            @param offset The offset string representation
+            @return True if no problem occurred */
+        bool setScaling(const QString &factor, const QString &offset);
+
+        /** @brief Get the minimum physical value of the signal */
+        double getMinimum() const { return _minimum; }
+
+        /** @brief Get the maximum physical value of the signal */
+        double getMaximum() const { return _maximum; }
+
+        /** @brief Set the physical values range of the signal */
+        void setRange(double minimum, double maximum) { _minimum = minimum; _maximum = maximum; }
+
+        /** @brief Get the signal unit */
+        const QString &getUnit() const { return _unit; }
+
+        /** @brief Set the signal unit */
+        void setUnit(const QString &unit) { _unit = unit; }
+
+        /** @brief Test if the signal is the multiplexor of its message */
+        bool isMultiplexor() const { return _multiplexor; }
+
+        /** @brief Set if the signal is the multiplexor of its message */
+        void setMultiplexor(bool multiplexor) { _multiplexor = multiplexor; }
+
+        /** @brief Get the multiplexor value for which the signal is present, -1 if the signal
+                   isn't multiplexed */
+        qint64 getMultiplexValue() const { return _multiplexValue; }
+
+        /** @brief Set the multiplexor value for which the signal is present, -1 if the signal
+                   isn't multiplexed */
+        void setMultiplexValue(qint64 multiplexValue) { _multiplexValue = multiplexValue; }
+
+        /** @brief Compile the signal bits layout to the list of byte chunks used by the
+                   extraction
+            @note The signal is rejected if one of its bits is out of the max payload size
+            @param messageName The name of the message which contains the signal, for the logs
+            @return True if no problem occurred */
+        bool compile(const QString &messageName);
+
+        /** @brief Test if the signal has been compiled */
+        bool isCompiled() const { return !_chunks.isEmpty(); }
+
+        /** @brief Get the minimum payload size needed to extract the signal */
+        int getMinPayloadSize() const { return _minPayloadSize; }
+
+        /** @brief Extract the raw value of the signal from the payload given
+            @note The signed raw values are sign-extended to 64 bits
+            @param payload The frame payload
+            @param payloadSize The size of the payload
+            @param rawValue The raw value extracted (to cast to qint64 if the signal is signed)
+            @return False if the payload is too short for the signal */
+        inline bool extractRaw(const quint8 *payload, int payloadSize, quint64 &rawValue) const;
+
+        /** @brief Convert a raw value to its physical value
+            @param rawValue The raw value returned by @ref extractRaw
+            @return The physical value */
+        inline double toPhysical(quint64 rawValue) const;
+
+        /** @brief Convert a raw value to its exact physical value
+            @note The scaling is done with decimal numbers, there is no floating point rounding
+            @param rawValue The raw value returned by @ref extractRaw
+            @return The physical value, invalid if a problem occurred */
+        Number toExactPhysical(quint64 rawValue) const;
+
+    private:
+        /** @brief Parse a scaling value from its string representation
+            @param strValue The value to parse
+            @param value The value parsed
+            @param exactValue The exact value parsed
+            @return True if no problem occurred */
+        static bool parseScalingValue(const QString &strValue, double &value, Number &exactValue);
+
+    private:
+        /** @brief The max length of a signal in bits */
+        static const constexpr int MaxBitsLength = 64;
+
+        /** @brief The max size of a CAN frame payload (CAN FD) */
+        static const constexpr int MaxPayloadSize = 64;
+
+        /** @brief The number of bits in a byte */
+        static const constexpr int BitsInByte = 8;
+
+    private:
+        QString _name;
+        quint16 _startBit{0};
+        quint8 _bitsLength{0};
+        bool _intel{true};
+        bool _signed{false};
+        double _factor{1.0};
+        double _offset{0.0};
+        Number _exactFactor{Number(1)};
+        Number _exactOffset{Number::zero()};
+        double _minimum{0.0};
+        double _maximum{0.0};
+        QString _unit;
+        bool _multiplexor{false};
+        qint64 _multiplexValue{-1};
+
+        QVector<Chunk> _chunks;
+        int _minPayloadSize{0};
+        quint64 _signBitMask{0};
+        quint64 _signExtensionMask{0};
+};
+
+inline bool DbcSignal::extractRaw(const quint8 *payload, int payloadSize, quint64 &rawValue) const
+{
+    if(payloadSize < _minPayloadSize)
+    {
+        return false;
+    }
+
+    quint64 value = 0;
+
+    for(auto citer = _chunks.cbegin(); citer != _chunks.cend(); ++citer)
+    {
+        value |= static_cast<quint64>((payload[citer->byteIdx] >> citer->rightShift) &
+                                      citer->mask) << citer->leftShift;
+    }
+
+    if(_signed && (value & _signBitMask) != 0)
+    {
+        value |= _signExtensionMask;
+    }
+
+    rawValue = value;
+    return true;
+}
+
+inline double DbcSignal::toPhysical(quint64 rawValue) const
+{
+    const double value = _signed ? static_cast<double>(static_cast<qint64>(rawValue)) :
+                                   static_cast<double>(rawValue);
+    return (value * _factor) + _offset;
+}
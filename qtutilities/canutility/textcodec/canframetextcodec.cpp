@@ -0,0 +1,262 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canframetextcodec.hpp"
+
+#include <cstring>
+
+#include <QCanBusFrame>
+
+
+constexpr std::array<qint8, 256> CanFrameTextCodec::buildHexDigitValues()
+{
+    std::array<qint8, 256> values{};
+
+    for(std::size_t idx = 0; idx < values.size(); ++idx)
+    {
+        values[idx] = -1;
+    }
+
+    for(int digit = 0; digit < 10; ++digit)
+    {
+        values[static_cast<std::size_t>('0' + digit)] = static_cast<qint8>(digit);
+    }
+
+    for(int digit = 0; digit < 6; ++digit)
+    {
+        values[static_cast<std::size_t>('a' + digit)] = static_cast<qint8>(10 + digit);
+        values[static_cast<std::size_t>('A' + digit)] = static_cast<qint8>(10 + digit);
+    }
+
+    return values;
+}
+
+const std::array<qint8, 256> CanFrameTextCodec::HexDigitValues =
+                                                        CanFrameTextCodec::buildHexDigitValues();
+
+
+CanFrameTextCodec::CanFrameTextCodec()
+{
+}
+
+bool CanFrameTextCodec::parseFrame(const char *begin, const char *end, QCanBusFrame &frame)
+{
+    if(begin != end && *(end - 1) == '\r')
+    {
+        --end;
+    }
+
+    const char *firstSeparator = static_cast<const char *>(
+                                                    memchr(begin, Separator, end - begin));
+    if(firstSeparator == nullptr)
+    {
+        return false;
+    }
+
+    const char *secondSeparator = static_cast<const char *>(
+                                memchr(firstSeparator + 1, Separator, end - firstSeparator - 1));
+    if(secondSeparator == nullptr ||
+       memchr(secondSeparator + 1, Separator, end - secondSeparator - 1) != nullptr)
+    {
+        return false;
+    }
+
+    quint32 id = 0;
+    int length = 0;
+    char payload[MaxPayloadSize];
+
+    if(!parseId(begin, firstSeparator, id) ||
+       !parseLength(firstSeparator + 1, secondSeparator, length) ||
+       !parsePayload(secondSeparator + 1, end, length, payload))
+    {
+        return false;
+    }
+
+    frame.setFrameId(id);
+    frame.setPayload(QByteArray(payload, length));
+    return true;
+}
+
+void CanFrameTextCodec::appendFrame(const QCanBusFrame &frame, QByteArray &buffer)
+{
+    const QByteArray payload = frame.payload();
+    const int payloadSize = payload.size();
+
+    char text[MaxFrameTextSize + 1];
+    int size = 0;
+
+    // The id is written without the leading zeros
+    const quint32 id = frame.frameId();
+    int shift = (MaxIdDigitsNb - 1) * HexDigitBitsNb;
+    while(shift > 0 && ((id >> shift) & 0x0F) == 0)
+    {
+        shift -= HexDigitBitsNb;
+    }
+
+    for(; shift >= 0; shift -= HexDigitBitsNb)
+    {
+        text[size++] = UpperHexDigits[(id >> shift) & 0x0F];
+    }
+
+    text[size++] = Separator;
+
+    if(payloadSize >= 10)
+    {
+        text[size++] = static_cast<char>('0' + ((payloadSize / 10) % 10));
+    }
+
+    text[size++] = static_cast<char>('0' + (payloadSize % 10));
+    text[size++] = Separator;
+
+    buffer.reserve(buffer.size() + size + (2 * payloadSize));
+    buffer.append(text, size);
+
+    const char *payloadData = payload.constData();
+    for(int idx = 0; idx < payloadSize; ++idx)
+    {
+        const quint8 byte = static_cast<quint8>(payloadData[idx]);
+        buffer.append(LowerHexDigits[byte >> HexDigitBitsNb]);
+        buffer.append(LowerHexDigits[byte & 0x0F]);
+    }
+}
+
+bool CanFrameTextCodec::isBlankLine(const char *begin, const char *end)
+{
+    for(const char *current = begin; current != end; ++current)
+    {
+        if(*current != ' ' && *current != '\t' && *current != '\r')
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+void CanFrameTextCodec::trim(const char *&begin, const char *&end)
+{
+    while(begin != end && (*begin == ' ' || *begin == '\t'))
+    {
+        ++begin;
+    }
+
+    while(begin != end && (*(end - 1) == ' ' || *(end - 1) == '\t'))
+    {
+        --end;
+    }
+}
+
+void CanFrameTextCodec::removeHexMarkers(const char *&begin, const char *&end)
+{
+    trim(begin, end);
+
+    if((end - begin) >= 2 && begin[0] == '0' &&
+       (begin[1] == 'x' || begin[1] == 'X' || begin[1] == 'h' || begin[1] == 'H'))
+    {
+        begin += 2;
+    }
+    else if(begin != end && (*(end - 1) == 'h' || *(end - 1) == 'H'))
+    {
+        --end;
+    }
+}
+
+bool CanFrameTextCodec::parseId(const char *begin, const char *end, quint32 &id)
+{
+    removeHexMarkers(begin, end);
+
+    const int digitsNb = static_cast<int>(end - begin);
+    if(digitsNb == 0 || digitsNb > MaxIdDigitsNb)
+    {
+        return false;
+    }
+
+    quint32 value = 0;
+    for(const char *current = begin; current != end; ++current)
+    {
+        const qint8 digit = HexDigitValues[static_cast<quint8>(*current)];
+        if(digit < 0)
+        {
+            return false;
+        }
+
+        value = (value << HexDigitBitsNb) | static_cast<quint32>(digit);
+    }
+
+    id = value;
+    return true;
+}
+
+bool CanFrameTextCodec::parseLength(const char *begin, const char *end, int &length)
+{
+    trim(begin, end);
+
+    const int digitsNb = static_cast<int>(end - begin);
+    if(digitsNb == 0 || digitsNb > MaxLengthDigitsNb)
+    {
+        return false;
+    }
+
+    int value = 0;
+    for(const char *current = begin; current != end; ++current)
+    {
+        if(*current < '0' || *current > '9')
+        {
+            return false;
+        }
+
+        value = (value * 10) + (*current - '0');
+    }
+
+    if(value > MaxPayloadSize)
+    {
+        return false;
+    }
+
+    length = value;
+    return true;
+}
+
+bool CanFrameTextCodec::parsePayload(const char *begin,
+                                     const char *end,
+                                     int expectedLength,
+                                     char *payload)
+{
+    removeHexMarkers(begin, end);
+
+    const int digitsNb = static_cast<int>(end - begin);
+    if(((digitsNb + 1) / 2) != expectedLength)
+    {
+        return false;
+    }
+
+    const char *current = begin;
+    int byteIdx = 0;
+
+    if((digitsNb % 2) != 0)
+    {
+        const qint8 digit = HexDigitValues[static_cast<quint8>(*current)];
+        if(digit < 0)
+        {
+            return false;
+        }
+
+        payload[byteIdx++] = static_cast<char>(digit);
+        ++current;
+    }
+
+    for(; current != end; current += 2)
+    {
+        const qint8 highDigit = HexDigitValues[static_cast<quint8>(current[0])];
+        const qint8 lowDigit = HexDigitValues[static_cast<quint8>(current[1])];
+        if((highDigit | lowDigit) < 0)
+        {
+            return false;
+        }
+
+        payload[byteIdx++] = static_cast<char>((highDigit << HexDigitBitsNb) | lowDigit);
+    }
+
+    return true;
+}
@@ -0,0 +1,123 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <array>
+
+#include <QByteArray>
+
+class QCanBusFrame;
+
+
+/** @brief This is the core of the "id/length/payload" text format of the CAN frames, it works on
+           raw bytes
+    @note The format is: the frame id in base 16, the payload length in base 10 and the payload in
+          base 16, separated by @ref Separator. For instance: "7DF/3/0a0b0c".
+    @note The hexadecimal parts may have a "0x" or "0h" prefix or a "h" suffix, and the parts may
+          be surrounded by spaces or tabs.
+    @note The hexadecimal digits are decoded with a lookup table and nothing is allocated, except
+          the payload of the frame parsed. The methods don't log anything: they are called for
+          each line of big files; it's up to the caller to log the problems.
+    @note The class contains static methods to call */
+class CanFrameTextCodec
+{
+    private:
+        /** @brief Private constructor */
+        explicit CanFrameTextCodec();
+
+    public:
+        /** @brief Parse a frame written in the text format
+            @param begin The beginning of the text to parse
+            @param end The end of the text to parse (excluded), a final carriage return is ignored
+            @param frame The frame parsed, only its id and payload are set
+            @return True if no problem occurred */
+        static bool parseFrame(const char *begin, const char *end, QCanBusFrame &frame);
+
+        /** @brief Write a frame in the text format
+            @note Only the frame id, the payload and its length are written (not the options)
+            @param frame The frame to write
+            @param buffer The text of the frame is appended to this buffer, no line end is
+                          added */
+        static void appendFrame(const QCanBusFrame &frame, QByteArray &buffer);
+
+        /** @brief Test if the line given is blank: empty or only made of spaces, tabs and carriage
+                   returns
+            @param begin The beginning of the line
+            @param end The end of the line (excluded) */
+        static bool isBlankLine(const char *begin, const char *end);
+
+    public:
+        /** @brief The separator between the parts of a frame */
+        static const constexpr char Separator = '/';
+
+        /** @brief The max length of a frame payload */
+        static const constexpr int MaxPayloadSize = 64;
+
+        /** @brief The max length of a frame written in the text format:
+                   "<8 digits id>/<2 digits length>/<128 digits payload>" */
+        static const constexpr int MaxFrameTextSize = 8 + 1 + 2 + 1 + (2 * MaxPayloadSize);
+
+    private:
+        /** @brief Remove the spaces and tabs around the part given
+            @param begin The beginning of the part, it's moved after the leading spaces
+            @param end The end of the part, it's moved before the trailing spaces */
+        static void trim(const char *&begin, const char *&end);
+
+        /** @brief Remove the hexadecimal prefix ("0x", "0h") or suffix ("h") of the part given
+            @param begin The beginning of the part, it's moved after the prefix
+            @param end The end of the part, it's moved before the suffix */
+        static void removeHexMarkers(const char *&begin, const char *&end);
+
+        /** @brief Parse the frame id
+            @param begin The beginning of the hexadecimal id
+            @param end The end of the hexadecimal id
+            @param id The id parsed
+            @return True if no problem occurred */
+        static bool parseId(const char *begin, const char *end, quint32 &id);
+
+        /** @brief Parse the payload length
+            @param begin The beginning of the decimal length
+            @param end The end of the decimal length
+            @param length The length parsed
+            @return True if no problem occurred */
+        static bool parseLength(const char *begin, const char *end, int &length);
+
+        /** @brief Parse the payload
+            @note As QByteArray::fromHex, if the digits number is odd, the first digit is a byte
+            @param begin The beginning of the hexadecimal payload
+            @param end The end of the hexadecimal payload
+            @param expectedLength The expected payload length
+            @param payload The bytes parsed, it has to contain @ref MaxPayloadSize bytes
+            @return True if no problem occurred */
+        static bool parsePayload(const char *begin,
+                                 const char *end,
+                                 int expectedLength,
+                                 char *payload);
+
+        /** @brief Build the table which gives the value of an hexadecimal digit, or -1 if the
+                   character isn't an hexadecimal digit */
+        static constexpr std::array<qint8, 256> buildHexDigitValues();
+
+    private:
+        /** @brief The max number of digits of the frame id */
+        static const constexpr int MaxIdDigitsNb = 8;
+
+        /** @brief The max number of digits of the payload length */
+        static const constexpr int MaxLengthDigitsNb = 2;
+
+        /** @brief The number of bits in an hexadecimal digit */
+        static const constexpr int HexDigitBitsNb = 4;
+
+        /** @brief The digits used to write the frame id */
+        static const constexpr char* UpperHexDigits = "0123456789ABCDEF";
+
+        /** @brief The digits used to write the payload */
+        static const constexpr char* LowerHexDigits = "0123456789abcdef";
+
+    private:
+        /** @brief Gives the value of an hexadecimal digit, or -1 if the character isn't an
+                   hexadecimal digit */
+        static const std::array<qint8, 256> HexDigitValues;
+};
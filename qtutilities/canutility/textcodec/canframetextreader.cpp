@@ -0,0 +1,244 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canframetextreader.hpp"
+
+#include <cstring>
+#include <limits>
+#include <memory>
+#include <vector>
+
+#include <QCanBusFrame>
+#include <QDebug>
+#include <QFile>
+#include <QThread>
+
+#include "textcodec/canframetextcodec.hpp"
+
+
+CanFrameTextReader::CanFrameTextReader()
+{
+}
+
+bool CanFrameTextReader::readFile(const QString &filePath,
+                                  QVector<QCanBusFrame> &frames,
+                                  int threadsNb)
+{
+    QFile file(filePath);
+    if(!file.open(QIODevice::ReadOnly))
+    {
+        qWarning() << "Can't open the CAN frames file: " << filePath << ", error: "
+                   << file.errorString();
+        return false;
+    }
+
+    bool success = false;
+    const uchar *mapped = nullptr;
+    qint64 size = 0;
+
+    // The sequential devices (for instance: pipes) have no size and can't be mapped
+    if(!file.isSequential())
+    {
+        size = file.size();
+        if(size == 0)
+        {
+            frames.clear();
+            return true;
+        }
+
+        mapped = file.map(0, size);
+    }
+
+    if(mapped == nullptr)
+    {
+        // The file is read in memory
+        const QByteArray content = file.readAll();
+        success = parse(content.constData(), content.size(), frames, threadsNb);
+    }
+    else
+    {
+        success = parse(reinterpret_cast<const char *>(mapped), size, frames, threadsNb);
+        file.unmap(const_cast<uchar *>(mapped));
+    }
+
+    if(!success)
+    {
+        qWarning() << "A problem occurred when tried to parse the CAN frames file: " << filePath;
+    }
+
+    return success;
+}
+
+bool CanFrameTextReader::parse(const char *data,
+                               qint64 size,
+                               QVector<QCanBusFrame> &frames,
+                               int threadsNb)
+{
+    if(threadsNb <= 0)
+    {
+        threadsNb = qMax(1, QThread::idealThreadCount());
+    }
+
+    QVector<Chunk> chunks = splitInChunks(data, size, threadsNb);
+
+    runOnChunks(chunks, &CanFrameTextReader::countFrames);
+
+    qint64 framesNb = 0;
+    for(auto iter = chunks.begin(); iter != chunks.end(); ++iter)
+    {
+        iter->firstFrameIdx = static_cast<int>(framesNb);
+        framesNb += iter->framesNb;
+    }
+
+    if(framesNb > std::numeric_limits<int>::max())
+    {
+        qWarning() << "There are too many CAN frames to parse: " << framesNb;
+        return false;
+    }
+
+    frames.resize(static_cast<int>(framesNb));
+    QCanBusFrame *framesData = frames.data();
+
+    runOnChunks(chunks, [framesData](Chunk &chunk)
+                {
+                    parseFrames(chunk, framesData + chunk.firstFrameIdx);
+                });
+
+    for(auto citer = chunks.cbegin(); citer != chunks.cend(); ++citer)
+    {
+        if(citer->errorLine == nullptr)
+        {
+            continue;
+        }
+
+        const char *errorLine = citer->errorLine;
+        const char *lineEnd = static_cast<const char *>(
+                                                memchr(errorLine, '\n', citer->end - errorLine));
+        const char *errorLineEnd = (lineEnd == nullptr) ? citer->end : lineEnd;
+        const int lineLength = static_cast<int>(errorLineEnd - errorLine);
+
+        qWarning() << "The stringified CAN frame: "
+                   << QString::fromLatin1(errorLine, qMin(lineLength, MaxLoggedLineLength))
+                   << ", can't be parsed";
+        frames.clear();
+        return false;
+    }
+
+    return true;
+}
+
+QVector<CanFrameTextReader::Chunk> CanFrameTextReader::splitInChunks(const char *data,
+                                                                     qint64 size,
+                                                                     int chunksNb)
+{
+    const qint64 realChunksNb = qBound(static_cast<qint64>(1),
+                                       size / MinChunkSize,
+                                       static_cast<qint64>(chunksNb));
+
+    QVector<Chunk> chunks;
+    chunks.reserve(static_cast<int>(realChunksNb));
+
+    const char *end = data + size;
+    const char *chunkBegin = data;
+
+    for(qint64 idx = 1; idx <= realChunksNb && chunkBegin != end; ++idx)
+    {
+        const char *chunkEnd = end;
+
+        if(idx < realChunksNb)
+        {
+            // The chunk ends just after the first line end found from its theoretical end
+            const char *theoreticalEnd = qMax(chunkBegin, data + ((size * idx) / realChunksNb));
+            const char *lineEnd = static_cast<const char *>(
+                                                memchr(theoreticalEnd, '\n', end - theoreticalEnd));
+            chunkEnd = (lineEnd == nullptr) ? end : (lineEnd + 1);
+        }
+
+        Chunk chunk;
+        chunk.begin = chunkBegin;
+        chunk.end = chunkEnd;
+        chunks.append(chunk);
+
+        chunkBegin = chunkEnd;
+    }
+
+    return chunks;
+}
+
+void CanFrameTextReader::countFrames(Chunk &chunk)
+{
+    int framesNb = 0;
+    const char *lineBegin = chunk.begin;
+
+    while(lineBegin != chunk.end)
+    {
+        const char *lineEnd = static_cast<const char *>(
+                                                memchr(lineBegin, '\n', chunk.end - lineBegin));
+        const char *nextLine = (lineEnd == nullptr) ? chunk.end : (lineEnd + 1);
+
+        if(!CanFrameTextCodec::isBlankLine(lineBegin, (lineEnd == nullptr) ? chunk.end : lineEnd))
+        {
+            ++framesNb;
+        }
+
+        lineBegin = nextLine;
+    }
+
+    chunk.framesNb = framesNb;
+}
+
+void CanFrameTextReader::parseFrames(Chunk &chunk, QCanBusFrame *frames)
+{
+    int frameIdx = 0;
+    const char *lineBegin = chunk.begin;
+
+    while(lineBegin != chunk.end)
+    {
+        const char *lineEnd = static_cast<const char *>(
+                                                memchr(lineBegin, '\n', chunk.end - lineBegin));
+        if(lineEnd == nullptr)
+        {
+            lineEnd = chunk.end;
+        }
+
+        if(!CanFrameTextCodec::isBlankLine(lineBegin, lineEnd))
+        {
+            if(!CanFrameTextCodec::parseFrame(lineBegin, lineEnd, frames[frameIdx]))
+            {
+                chunk.errorLine = lineBegin;
+                return;
+            }
+
+            ++frameIdx;
+        }
+
+        lineBegin = (lineEnd == chunk.end) ? chunk.end : (lineEnd + 1);
+    }
+}
+
+void CanFrameTextReader::runOnChunks(QVector<Chunk> &chunks,
+                                     const std::function<void(Chunk &)> &function)
+{
+    if(chunks.isEmpty())
+    {
+        return;
+    }
+
+    std::vector<std::unique_ptr<QThread>> threads;
+    threads.reserve(static_cast<std::size_t>(chunks.length() - 1));
+
+    for(int idx = 1; idx < chunks.length(); ++idx)
+    {
+        Chunk *chunk = &chunks[idx];
+        threads.emplace_back(QThread::create([&function, chunk]() { function(*chunk); }));
+        threads.back()->start();
+    }
+
+    function(chunks.first());
+
+    for(auto iter = threads.begin(); iter != threads.end(); ++iter)
+    {
+        (*iter)->wait();
+    }
+}
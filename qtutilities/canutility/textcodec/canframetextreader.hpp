@@ -0,0 +1,102 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <functional>
+
+#include <QString>
+#include <QVector>
+
+class QCanBusFrame;
+
+
+/** @brief Reads big files of CAN frames written in the "id/length/payload" text format, see
+           @ref CanFrameTextCodec
+    @note The file is memory-mapped and parsed from its raw bytes. The text is split in chunks,
+          at lines ends, and the chunks are parsed in parallel: a first pass counts the frames of
+          each chunk, the frames vector is then allocated once and each chunk parses its lines
+          directly into its own range of the vector.
+    @note The blank lines are ignored.
+    @note The class contains static methods to call */
+class CanFrameTextReader
+{
+    private:
+        /** @brief Private constructor */
+        explicit CanFrameTextReader();
+
+    public:
+        /** @brief Read all the frames of a text file
+            @param filePath The path of the file to read
+            @param frames The frames read, in the file order
+            @param threadsNb The number of threads used to parse the file, if -1 the ideal number
+                             of threads of the system is used
+            @return True if no problem occurred */
+        static bool readFile(const QString &filePath,
+                             QVector<QCanBusFrame> &frames,
+                             int threadsNb = -1);
+
+        /** @brief Parse all the frames of a text buffer
+            @param data The text to parse
+            @param size The size of the text
+            @param frames The frames parsed, in the text order
+            @param threadsNb The number of threads used to parse the text, if -1 the ideal number
+                             of threads of the system is used
+            @return True if no problem occurred */
+        static bool parse(const char *data,
+                          qint64 size,
+                          QVector<QCanBusFrame> &frames,
+                          int threadsNb = -1);
+
+    private:
+        /** @brief This is a part of the text, parsed by one thread */
+        struct Chunk
+        {
+            /** @brief The beginning of the chunk, it's the beginning of a line */
+            const char *begin{nullptr};
+
+            /** @brief The end of the chunk (excluded), it's just after a line end */
+            const char *end{nullptr};
+
+            /** @brief The number of frames in the chunk */
+            int framesNb{0};
+
+            /** @brief The index of the first frame of the chunk in the frames vector */
+            int firstFrameIdx{0};
+
+            /** @brief The beginning of the first line which can't be parsed, or nullptr */
+            const char *errorLine{nullptr};
+        };
+
+    private:
+        /** @brief Split the text in chunks, at lines ends
+            @param data The text to split
+            @param size The size of the text
+            @param chunksNb The wanted number of chunks
+            @return The chunks, there may be less chunks than asked for little texts */
+        static QVector<Chunk> splitInChunks(const char *data, qint64 size, int chunksNb);
+
+        /** @brief Count the frames of a chunk
+            @param chunk The chunk to count the frames of, its frames number is set */
+        static void countFrames(Chunk &chunk);
+
+        /** @brief Parse the frames of a chunk
+            @param chunk The chunk to parse, its error line is set if a line can't be parsed
+            @param frames The first frame of the chunk range, in the frames vector */
+        static void parseFrames(Chunk &chunk, QCanBusFrame *frames);
+
+        /** @brief Call the function given on each chunk: the first chunk is processed in the
+                   current thread and the others in dedicated threads
+            @param chunks The chunks to process
+            @param function The function to call */
+        static void runOnChunks(QVector<Chunk> &chunks,
+                                const std::function<void(Chunk &)> &function);
+
+    private:
+        /** @brief The minimal size of a chunk, smaller texts aren't split */
+        static const constexpr qint64 MinChunkSize = 1024 * 1024;
+
+        /** @brief The max length of a line displayed in logs */
+        static const constexpr int MaxLoggedLineLength = 80;
+};
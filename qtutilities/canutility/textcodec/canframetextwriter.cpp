@@ -0,0 +1,120 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "canframetextwriter.hpp"
+
+#include <QCanBusFrame>
+#include <QDebug>
+
+#include "textcodec/canframetextcodec.hpp"
+
+
+CanFrameTextWriter::CanFrameTextWriter(int bufferSize)
+    : _bufferSize{qMax(bufferSize, CanFrameTextCodec::MaxFrameTextSize + 1)}
+{
+}
+
+CanFrameTextWriter::~CanFrameTextWriter()
+{
+    close();
+}
+
+bool CanFrameTextWriter::open(const QString &filePath)
+{
+    if(isOpen())
+    {
+        qWarning() << "The CAN frames file: " << _file.fileName() << ", is already open, close "
+                   << "it before opening a new one";
+        return false;
+    }
+
+    _file.setFileName(filePath);
+    if(!_file.open(QIODevice::WriteOnly | QIODevice::Truncate))
+    {
+        qWarning() << "Can't open the CAN frames file: " << filePath << ", error: "
+                   << _file.errorString();
+        return false;
+    }
+
+    _buffer.clear();
+    _buffer.reserve(_bufferSize);
+    return true;
+}
+
+bool CanFrameTextWriter::writeFrame(const QCanBusFrame &frame)
+{
+    if(!isOpen())
+    {
+        qWarning() << "Can't write the CAN frame, no file is open";
+        return false;
+    }
+
+    if((_buffer.size() + CanFrameTextCodec::MaxFrameTextSize + 1) > _bufferSize && !flush())
+    {
+        return false;
+    }
+
+    CanFrameTextCodec::appendFrame(frame, _buffer);
+    _buffer.append(LineEnd);
+    return true;
+}
+
+bool CanFrameTextWriter::writeFrames(const QVector<QCanBusFrame> &frames)
+{
+    for(auto citer = frames.cbegin(); citer != frames.cend(); ++citer)
+    {
+        if(!writeFrame(*citer))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+bool CanFrameTextWriter::flush()
+{
+    if(_buffer.isEmpty())
+    {
+        return true;
+    }
+
+    const qint64 bufferedSize = _buffer.size();
+    const qint64 writtenSize = _file.write(_buffer);
+
+    // The memory of the buffer is kept to be reused
+    _buffer.resize(0);
+
+    if(writtenSize != bufferedSize)
+    {
+        qWarning() << "A problem occurred when tried to write the CAN frames file: "
+                   << _file.fileName() << ", error: " << _file.errorString();
+        return false;
+    }
+
+    return true;
+}
+
+bool CanFrameTextWriter::close()
+{
+    if(!isOpen())
+    {
+        return true;
+    }
+
+    const bool success = flush();
+    _file.close();
+    return success;
+}
+
+bool CanFrameTextWriter::writeFile(const QString &filePath, const QVector<QCanBusFrame> &frames)
+{
+    CanFrameTextWriter writer;
+    if(!writer.open(filePath) || !writer.writeFrames(frames))
+    {
+        return false;
+    }
+
+    return writer.close();
+}
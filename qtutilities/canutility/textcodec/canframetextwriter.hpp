@@ -0,0 +1,77 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QByteArray>
+#include <QFile>
+#include <QVector>
+
+class QCanBusFrame;
+
+
+/** @brief Writes CAN frames in a text file, with the "id/length/payload" text format, see
+           @ref CanFrameTextCodec
+    @note The frames are written in a buffer, which is written in the file when it's full: the
+          frames may be given by batches without writing the file for each frame.
+    @note One frame is written by line */
+class CanFrameTextWriter
+{
+    public:
+        /** @brief Class constructor
+            @param bufferSize The size of the buffer written in the file when it's full */
+        explicit CanFrameTextWriter(int bufferSize = DefaultBufferSize);
+
+        /** @brief Class destructor
+            @note The file is closed, the frames buffered are written before */
+        virtual ~CanFrameTextWriter();
+
+    public:
+        /** @brief Open the file to write the frames in
+            @note If the file already exists, it's truncated
+            @param filePath The path of the file
+            @return True if no problem occurred */
+        bool open(const QString &filePath);
+
+        /** @brief Test if the file is open */
+        bool isOpen() const { return _file.isOpen(); }
+
+        /** @brief Write a frame
+            @param frame The frame to write
+            @return True if no problem occurred */
+        bool writeFrame(const QCanBusFrame &frame);
+
+        /** @brief Write frames
+            @param frames The frames to write
+            @return True if no problem occurred */
+        bool writeFrames(const QVector<QCanBusFrame> &frames);
+
+        /** @brief Write the frames buffered in the file
+            @return True if no problem occurred */
+        bool flush();
+
+        /** @brief Close the file, the frames buffered are written before
+            @return True if no problem occurred */
+        bool close();
+
+    public:
+        /** @brief Write all the frames given in a text file
+            @param filePath The path of the file to write
+            @param frames The frames to write
+            @return True if no problem occurred */
+        static bool writeFile(const QString &filePath, const QVector<QCanBusFrame> &frames);
+
+    public:
+        /** @brief The default size of the buffer */
+        static const constexpr int DefaultBufferSize = 1024 * 1024;
+
+    private:
+        /** @brief The line end written after each frame */
+        static const constexpr char LineEnd = '\n';
+
+    private:
+        int _bufferSize;
+        QByteArray _buffer;
+        QFile _file;
+};
@@ -0,0 +1,353 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tst_canframetext.hpp"
+
+#include <QCanBusFrame>
+#include <QFile>
+#include <QTemporaryDir>
+#include <QtTest>
+
+#include <thread>
+
+#ifdef Q_OS_UNIX
+#include <sys/stat.h>
+#endif
+
+#include "canbusframehelper.hpp"
+#include "textcodec/canframetextcodec.hpp"
+#include "textcodec/canframetextreader.hpp"
+
+
+/** @brief The number of frames written in the file read by the tests, the file is big enough to
+           be split in several chunks */
+static const constexpr int FileFramesNb = 80000;
+
+/** @brief The min size of the file read by the tests: several chunks of the reader */
+static const constexpr int MinFileSize = 4 * 1024 * 1024;
+
+/** @brief The number of threads used to read the file */
+static const constexpr int ReaderThreadsNb = 4;
+
+
+CanFrameTextTest::CanFrameTextTest()
+{
+}
+
+CanFrameTextTest::~CanFrameTextTest()
+{
+}
+
+void CanFrameTextTest::test_stringify_data()
+{
+    QTest::addColumn<quint32>("frameId");
+    QTest::addColumn<QByteArray>("payload");
+    QTest::addColumn<QString>("expected");
+
+    // The expected strings have the format of the former implementation: upper case id without
+    // leading zeros, decimal length and lower case payload
+    QTest::newRow("empty payload") << quint32(0x7DF) << QByteArray()
+                                   << QStringLiteral("7DF/0/");
+    QTest::newRow("null id") << quint32(0) << QByteArray::fromHex("00")
+                             << QStringLiteral("0/1/00");
+    QTest::newRow("classic") << quint32(0x18DAF110) << QByteArray::fromHex("0102030a0b0cfeff")
+                             << QStringLiteral("18DAF110/8/0102030a0b0cfeff");
+    QTest::newRow("FD 64 bytes") << quint32(0x1FFFFFFF) << createPayload(64, 3)
+                                 << QStringLiteral("1FFFFFFF/64/%1")
+                                        .arg(QString::fromLatin1(createPayload(64, 3).toHex()));
+}
+
+void CanFrameTextTest::test_stringify()
+{
+    QFETCH(quint32, frameId);
+    QFETCH(QByteArray, payload);
+    QFETCH(QString, expected);
+
+    QCOMPARE(CanBusFrameHelper::stringifyFrame(QCanBusFrame(frameId, payload)), expected);
+}
+
+void CanFrameTextTest::test_roundtrip_data()
+{
+    QTest::addColumn<quint32>("frameId");
+    QTest::addColumn<QByteArray>("payload");
+
+    QTest::newRow("empty payload") << quint32(0x123) << QByteArray();
+    QTest::newRow("classic 1 byte") << quint32(0x7FF) << createPayload(1, 1);
+    QTest::newRow("classic 8 bytes") << quint32(0x7E8) << createPayload(8, 2);
+    QTest::newRow("FD 12 bytes") << quint32(0x1ABCDE) << createPayload(12, 3);
+    QTest::newRow("FD 48 bytes") << quint32(0x10) << createPayload(48, 4);
+    QTest::newRow("FD 64 bytes") << quint32(0x1FFFFFFF) << createPayload(64, 5);
+}
+
+void CanFrameTextTest::test_roundtrip()
+{
+    QFETCH(quint32, frameId);
+    QFETCH(QByteArray, payload);
+
+    const QCanBusFrame frame(frameId, payload);
+    const QString strFrame = CanBusFrameHelper::stringifyFrame(frame);
+
+    QCanBusFrame parsed;
+    QVERIFY(CanBusFrameHelper::parseStrFrame(strFrame, parsed));
+    QCOMPARE(parsed.frameId(), frameId);
+    QCOMPARE(parsed.payload(), payload);
+
+    // The codec gives the same text as the helper
+    QByteArray text;
+    CanFrameTextCodec::appendFrame(frame, text);
+    QCOMPARE(QString::fromLatin1(text), strFrame);
+}
+
+void CanFrameTextTest::test_parsevalid_data()
+{
+    QTest::addColumn<QString>("strFrame");
+    QTest::addColumn<quint32>("frameId");
+    QTest::addColumn<QByteArray>("payload");
+
+    const QByteArray payload = QByteArray::fromHex("0a0b0c");
+
+    QTest::newRow("plain") << QStringLiteral("7DF/3/0a0b0c") << quint32(0x7DF) << payload;
+    QTest::newRow("lower case id") << QStringLiteral("7df/3/0A0B0C") << quint32(0x7DF) << payload;
+    QTest::newRow("0x prefixes") << QStringLiteral("0x7DF/3/0x0a0b0c") << quint32(0x7DF)
+                                 << payload;
+    QTest::newRow("0h prefixes") << QStringLiteral("0h7DF/3/0H0a0b0c") << quint32(0x7DF)
+                                 << payload;
+    QTest::newRow("h suffixes") << QStringLiteral("7DFh/3/0a0b0cH") << quint32(0x7DF) << payload;
+    QTest::newRow("surrounding spaces") << QStringLiteral(" 7DF / 3\t/ 0a0b0c ")
+                                        << quint32(0x7DF) << payload;
+    QTest::newRow("marker and spaces") << QStringLiteral(" 0x7DF /3/ 0a0b0ch ")
+                                       << quint32(0x7DF) << payload;
+    QTest::newRow("odd digits number") << QStringLiteral("7DF/2/abc") << quint32(0x7DF)
+                                       << QByteArray::fromHex("0abc");
+    QTest::newRow("odd single digit") << QStringLiteral("7DF/1/f") << quint32(0x7DF)
+                                      << QByteArray::fromHex("0f");
+    QTest::newRow("empty payload") << QStringLiteral("7DF/0/") << quint32(0x7DF) << QByteArray();
+    QTest::newRow("max extended id") << QStringLiteral("1FFFFFFF/1/ff") << quint32(0x1FFFFFFF)
+                                     << QByteArray::fromHex("ff");
+    QTest::newRow("final carriage return") << QStringLiteral("7DF/3/0a0b0c\r") << quint32(0x7DF)
+                                           << payload;
+}
+
+void CanFrameTextTest::test_parsevalid()
+{
+    QFETCH(QString, strFrame);
+    QFETCH(quint32, frameId);
+    QFETCH(QByteArray, payload);
+
+    QCanBusFrame frame;
+    QVERIFY(CanBusFrameHelper::parseStrFrame(strFrame, frame));
+    QCOMPARE(frame.frameId(), frameId);
+    QCOMPARE(frame.payload(), payload);
+}
+
+void CanFrameTextTest::test_parsemalformed_data()
+{
+    QTest::addColumn<QString>("strFrame");
+
+    QTest::newRow("empty") << QString();
+    QTest::newRow("blank") << QStringLiteral("   ");
+    QTest::newRow("missing payload part") << QStringLiteral("7DF/3");
+    QTest::newRow("too many parts") << QStringLiteral("7DF/3/0a0b0c/");
+    QTest::newRow("empty id") << QStringLiteral("/1/00");
+    QTest::newRow("marker only id") << QStringLiteral("0x/1/00");
+    QTest::newRow("wrong id digit") << QStringLiteral("7DG/1/00");
+    QTest::newRow("id too long") << QStringLiteral("123456789/1/00");
+    QTest::newRow("empty length") << QStringLiteral("7DF//00");
+    QTest::newRow("hexadecimal length") << QStringLiteral("7DF/a/00");
+    QTest::newRow("length too long") << QStringLiteral("7DF/65/00");
+    QTest::newRow("payload shorter") << QStringLiteral("7DF/4/0a0b0c");
+    QTest::newRow("payload longer") << QStringLiteral("7DF/2/0a0b0c");
+    QTest::newRow("wrong payload digit") << QStringLiteral("7DF/2/0a0g");
+    QTest::newRow("space in payload") << QStringLiteral("7DF/3/0a 0b0c");
+    QTest::newRow("two markers") << QStringLiteral("7DF/3/0x0a0b0ch");
+}
+
+void CanFrameTextTest::test_parsemalformed()
+{
+    QFETCH(QString, strFrame);
+
+    QCanBusFrame frame;
+    QVERIFY(!CanBusFrameHelper::parseStrFrame(strFrame, frame));
+}
+
+void CanFrameTextTest::test_readfile()
+{
+    QVector<QCanBusFrame> expected;
+    expected.reserve(FileFramesNb);
+
+    // The file mixes the line ends and contains blank lines, which may be at the chunks limits
+    QByteArray text;
+    for(int idx = 0; idx < FileFramesNb; ++idx)
+    {
+        const QCanBusFrame frame((static_cast<quint32>(idx) * 0x9E37U) & 0x1FFFFFFFU,
+                                 createPayload(idx % (CanFrameTextCodec::MaxPayloadSize + 1), idx));
+        expected.append(frame);
+
+        CanFrameTextCodec::appendFrame(frame, text);
+        text.append(((idx % 7) == 0) ? "\r\n" : "\n");
+
+        if((idx % 11) == 0)
+        {
+            text.append(((idx % 2) == 0) ? "\n" : " \t\r\n");
+        }
+    }
+
+    // The last line has no line end
+    const QCanBusFrame lastFrame(0x7DF, createPayload(CanFrameTextCodec::MaxPayloadSize, 7));
+    expected.append(lastFrame);
+    CanFrameTextCodec::appendFrame(lastFrame, text);
+
+    QVERIFY(text.size() > MinFileSize);
+
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+
+    const QString filePath = tmpDir.filePath(QStringLiteral("frames.txt"));
+    QFile file(filePath);
+    QVERIFY(file.open(QIODevice::WriteOnly));
+    QCOMPARE(file.write(text), static_cast<qint64>(text.size()));
+    file.close();
+
+    QVector<QCanBusFrame> lineByLineFrames;
+    QVERIFY(parseLineByLine(text, lineByLineFrames));
+    QCOMPARE(lineByLineFrames.length(), expected.length());
+
+    QVector<QCanBusFrame> singleThreadFrames;
+    QVERIFY(CanFrameTextReader::readFile(filePath, singleThreadFrames, 1));
+
+    QVector<QCanBusFrame> multiThreadFrames;
+    QVERIFY(CanFrameTextReader::readFile(filePath, multiThreadFrames, ReaderThreadsNb));
+
+    QCOMPARE(singleThreadFrames.length(), expected.length());
+    QCOMPARE(multiThreadFrames.length(), expected.length());
+
+    for(int idx = 0; idx < expected.length(); ++idx)
+    {
+        const QCanBusFrame &frame = expected.at(idx);
+
+        if(!isSameFrame(lineByLineFrames.at(idx), frame) ||
+           !isSameFrame(singleThreadFrames.at(idx), frame) ||
+           !isSameFrame(multiThreadFrames.at(idx), frame))
+        {
+            QFAIL(qPrintable(QString("The frame: %1, isn't the expected one: %2")
+                                 .arg(idx)
+                                 .arg(CanBusFrameHelper::stringifyFrame(frame))));
+        }
+    }
+}
+
+void CanFrameTextTest::test_readfile_error()
+{
+    QByteArray text;
+    for(int idx = 0; idx < FileFramesNb; ++idx)
+    {
+        CanFrameTextCodec::appendFrame(QCanBusFrame(0x123, createPayload(32, idx)), text);
+        text.append('\n');
+
+        // A malformed line in the middle of the file, out of the first chunk
+        if(idx == ((FileFramesNb * 2) / 3))
+        {
+            text.append("7DF/4/0a0b0c\n");
+        }
+    }
+
+    QVERIFY(text.size() > MinFileSize);
+
+    QVector<QCanBusFrame> frames = { QCanBusFrame(0x1, QByteArray()) };
+    QVERIFY(!CanFrameTextReader::parse(text.constData(), text.size(), frames, ReaderThreadsNb));
+    QVERIFY(frames.isEmpty());
+
+    QVector<QCanBusFrame> lineByLineFrames;
+    QVERIFY(!parseLineByLine(text, lineByLineFrames));
+}
+
+void CanFrameTextTest::test_readfile_pipe()
+{
+#ifdef Q_OS_UNIX
+    QTemporaryDir tmpDir;
+    QVERIFY(tmpDir.isValid());
+
+    const QString pipePath = tmpDir.filePath(QStringLiteral("frames.fifo"));
+    QCOMPARE(mkfifo(QFile::encodeName(pipePath).constData(), 0600), 0);
+
+    QVector<QCanBusFrame> expected;
+    QByteArray text;
+    for(int idx = 0; idx < 100; ++idx)
+    {
+        const QCanBusFrame frame(static_cast<quint32>(0x100 + idx), createPayload(idx % 9, idx));
+        expected.append(frame);
+
+        CanFrameTextCodec::appendFrame(frame, text);
+        text.append('\n');
+    }
+
+    // The pipe opening blocks until the reader opens it too
+    std::thread writer([&pipePath, &text]()
+                       {
+                           QFile pipe(pipePath);
+                           if(pipe.open(QIODevice::WriteOnly))
+                           {
+                               pipe.write(text);
+                           }
+                       });
+
+    QVector<QCanBusFrame> frames;
+    const bool success = CanFrameTextReader::readFile(pipePath, frames, ReaderThreadsNb);
+    writer.join();
+
+    QVERIFY(success);
+    QCOMPARE(frames.length(), expected.length());
+
+    for(int idx = 0; idx < expected.length(); ++idx)
+    {
+        QVERIFY(isSameFrame(frames.at(idx), expected.at(idx)));
+    }
+#else
+    QSKIP("The named pipes are only tested on unix");
+#endif
+}
+
+QByteArray CanFrameTextTest::createPayload(int size, int seed)
+{
+    QByteArray payload(size, Qt::Uninitialized);
+
+    for(int idx = 0; idx < size; ++idx)
+    {
+        payload[idx] = static_cast<char>((seed * 31) + (idx * 7));
+    }
+
+    return payload;
+}
+
+bool CanFrameTextTest::parseLineByLine(const QByteArray &text, QVector<QCanBusFrame> &frames)
+{
+    frames.clear();
+
+    const QList<QByteArray> lines = text.split('\n');
+    for(const QByteArray &line : lines)
+    {
+        if(line.trimmed().isEmpty())
+        {
+            continue;
+        }
+
+        QCanBusFrame frame;
+        if(!CanBusFrameHelper::parseStrFrame(QString::fromLatin1(line), frame))
+        {
+            return false;
+        }
+
+        frames.append(frame);
+    }
+
+    return true;
+}
+
+bool CanFrameTextTest::isSameFrame(const QCanBusFrame &frame, const QCanBusFrame &otherFrame)
+{
+    return (frame.frameId() == otherFrame.frameId()) &&
+           (frame.payload() == otherFrame.payload());
+}
+
+QTEST_GUILESS_MAIN(CanFrameTextTest)
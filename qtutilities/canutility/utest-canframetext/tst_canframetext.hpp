@@ -0,0 +1,52 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QVector>
+
+class QCanBusFrame;
+
+
+/** @brief Tests the "id/length/payload" text format of the CAN frames: the helper methods, the
+           codec and the parallel reader of files */
+class CanFrameTextTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        CanFrameTextTest();
+        ~CanFrameTextTest();
+
+    private slots:
+        void test_stringify_data();
+        void test_stringify();
+        void test_roundtrip_data();
+        void test_roundtrip();
+        void test_parsevalid_data();
+        void test_parsevalid();
+        void test_parsemalformed_data();
+        void test_parsemalformed();
+        void test_readfile();
+        void test_readfile_error();
+        void test_readfile_pipe();
+
+    private:
+        /** @brief Create a payload whose bytes depend of their index and of a seed
+            @param size The payload size
+            @param seed The seed of the bytes values
+            @return The payload created */
+        static QByteArray createPayload(int size, int seed);
+
+        /** @brief Parse a text, line by line, in the current thread with the helper
+            @param text The text to parse
+            @param frames The frames parsed
+            @return True if no problem occurred */
+        static bool parseLineByLine(const QByteArray &text, QVector<QCanBusFrame> &frames);
+
+        /** @brief Test if two frames have the same id and payload */
+        static bool isSameFrame(const QCanBusFrame &frame, const QCanBusFrame &otherFrame);
+};
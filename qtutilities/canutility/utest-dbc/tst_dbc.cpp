@@ -0,0 +1,350 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#include "tst_dbc.hpp"
+
+#include <QCanBusFrame>
+#include <QtTest>
+
+#include "dbc/dbcbatchdecoder.hpp"
+
+
+/** @brief The DBC used by the tests
+    @note The payloads of the tests are chosen so that the signals cross the bytes boundaries */
+static const constexpr char *TestDbc = R"(VERSION ""
+
+NS_ :
+    CM_
+
+BS_:
+
+BU_: Ecu
+
+BO_ 100 IntelMsg: 8 Ecu
+ SG_ Cross : 4|12@1+ (1,0) [0|4095] "" Vector__XXX
+ SG_ Temp : 16|16@1- (0.1,-40) [-3316.8|3236.7] "degC" Vector__XXX
+
+BO_ 200 MotorolaMsg: 8 Ecu
+ SG_ Cross : 3|12@0+ (1,0) [0|4095] "" Vector__XXX
+ SG_ Speed : 23|16@0- (0.5,10) [-16374|16393.5] "km/h" Vector__XXX
+
+BO_ 300 MuxMsg: 8 Ecu
+ SG_ Selector M : 0|8@1+ (1,0) [0|255] "" Vector__XXX
+ SG_ ValueA m1 : 8|16@1+ (0.01,0) [0|655.35] "V" Vector__XXX
+ SG_ ValueB m2 : 8|16@1- (1,0) [-32768|32767] "A" Vector__XXX
+
+BO_ 2149235934 ExtendedMsg: 8 Ecu
+ SG_ Counter : 0|8@1+ (1,0) [0|255] "" Vector__XXX
+
+BO_ 3221225472 VECTOR__INDEPENDENT_SIG_MSG: 0 Vector__XXX
+ SG_ Orphan : 0|8@1+ (1,0) [0|255] "" Vector__XXX
+
+CM_ SG_ 100 Temp "The temperature";
+)";
+
+/** @brief The frame id of the Intel message */
+static const constexpr quint32 IntelMsgId = 100;
+
+/** @brief The frame id of the Motorola message */
+static const constexpr quint32 MotorolaMsgId = 200;
+
+/** @brief The frame id of the multiplexed message */
+static const constexpr quint32 MuxMsgId = 300;
+
+/** @brief The frame id of the extended message */
+static const constexpr quint32 ExtendedMsgId = 0x1ABCDE;
+
+
+DbcTest::DbcTest()
+{
+}
+
+DbcTest::~DbcTest()
+{
+}
+
+void DbcTest::initTestCase()
+{
+    QVERIFY(DbcDatabase::parse(QString::fromLatin1(TestDbc), _database));
+}
+
+void DbcTest::test_parse()
+{
+    QCOMPARE(_database.getMessages().count(), 4);
+
+    const DbcMessage *intelMsg = _database.getMessage(IntelMsgId);
+    QVERIFY(intelMsg != nullptr);
+    QCOMPARE(intelMsg->getName(), QStringLiteral("IntelMsg"));
+    QCOMPARE(intelMsg->getDataLength(), 8);
+    QVERIFY(!intelMsg->hasExtendedFrameFormat());
+    QCOMPARE(intelMsg->getSignals().length(), 2);
+
+    const DbcSignal &temp = intelMsg->getSignals().at(intelMsg->getSignalIdx("Temp"));
+    QCOMPARE(temp.getStartBit(), quint16(16));
+    QCOMPARE(temp.getBitsLength(), quint8(16));
+    QVERIFY(temp.isIntel());
+    QVERIFY(temp.isSigned());
+    QCOMPARE(temp.getFactor(), 0.1);
+    QCOMPARE(temp.getOffset(), -40.0);
+    QCOMPARE(temp.getUnit(), QStringLiteral("degC"));
+    QVERIFY(temp.isCompiled());
+
+    const DbcMessage *muxMsg = _database.getMessage(MuxMsgId);
+    QVERIFY(muxMsg != nullptr);
+    QCOMPARE(muxMsg->getMultiplexorIdx(), muxMsg->getSignalIdx("Selector"));
+    QCOMPARE(muxMsg->getSignals().at(muxMsg->getSignalIdx("ValueB")).getMultiplexValue(),
+             qint64(2));
+
+    const DbcMessage *extendedMsg = _database.getMessage(ExtendedMsgId, true);
+    QVERIFY(extendedMsg != nullptr);
+    QVERIFY(extendedMsg->hasExtendedFrameFormat());
+    QVERIFY(_database.getMessage(ExtendedMsgId) == nullptr);
+    QVERIFY(_database.getMessage(IntelMsgId, true) == nullptr);
+
+    // The independent signals pseudo message is ignored
+    QVERIFY(_database.getMessage(0xC0000000) == nullptr);
+}
+
+void DbcTest::test_intel()
+{
+    // Cross: bits 4 to 15 => 0x3CA; Temp: 0xFFFD => -3 => -3 * 0.1 - 40
+    const QCanBusFrame frame(IntelMsgId, QByteArray::fromHex("A53CFDFF00000000"));
+
+    const QHash<quint32, DbcMessageColumns> columnsById = decode({ frame });
+    QVERIFY(columnsById.contains(IntelMsgId));
+
+    const DbcMessageColumns &columns = columnsById.value(IntelMsgId);
+    QCOMPARE(columns.getRowsNb(), 1);
+    QCOMPARE(getValue(columns, "Cross"), 970.0);
+    QVERIFY(qFuzzyCompare(getValue(columns, "Temp"), -40.3));
+}
+
+void DbcTest::test_motorola()
+{
+    // Cross: byte 0 bits 3 to 0 then byte 1 => 0x53C; Speed: 0xFF38 => -200 => -200 * 0.5 + 10
+    const QCanBusFrame frame(MotorolaMsgId, QByteArray::fromHex("A53CFF3800000000"));
+
+    const QHash<quint32, DbcMessageColumns> columnsById = decode({ frame });
+    QVERIFY(columnsById.contains(MotorolaMsgId));
+
+    const DbcMessageColumns &columns = columnsById.value(MotorolaMsgId);
+    QCOMPARE(getValue(columns, "Cross"), 1340.0);
+    QCOMPARE(getValue(columns, "Speed"), -90.0);
+}
+
+void DbcTest::test_multiplexed()
+{
+    const QVector<QCanBusFrame> frames = {
+        QCanBusFrame(MuxMsgId, QByteArray::fromHex("01D2040000000000")),
+        QCanBusFrame(MuxMsgId, QByteArray::fromHex("0218FC0000000000")),
+        QCanBusFrame(MuxMsgId, QByteArray::fromHex("0318FC0000000000")),
+    };
+
+    const QHash<quint32, DbcMessageColumns> columnsById = decode(frames);
+    QVERIFY(columnsById.contains(MuxMsgId));
+
+    const DbcMessageColumns &columns = columnsById.value(MuxMsgId);
+    QCOMPARE(columns.getRowsNb(), 3);
+
+    // Mux value 1: only ValueA is present
+    QCOMPARE(getValue(columns, "Selector", 0), 1.0);
+    QVERIFY(qFuzzyCompare(getValue(columns, "ValueA", 0), 12.34));
+    QVERIFY(qIsNaN(getValue(columns, "ValueB", 0)));
+
+    // Mux value 2: only ValueB is present
+    QCOMPARE(getValue(columns, "Selector", 1), 2.0);
+    QVERIFY(qIsNaN(getValue(columns, "ValueA", 1)));
+    QCOMPARE(getValue(columns, "ValueB", 1), -1000.0);
+
+    // Mux value 3: no multiplexed signal is present
+    QCOMPARE(getValue(columns, "Selector", 2), 3.0);
+    QVERIFY(qIsNaN(getValue(columns, "ValueA", 2)));
+    QVERIFY(qIsNaN(getValue(columns, "ValueB", 2)));
+}
+
+void DbcTest::test_shortpayload()
+{
+    // Temp extends past the payload: it's skipped, Cross is still decoded
+    const QVector<QCanBusFrame> frames = {
+        QCanBusFrame(IntelMsgId, QByteArray::fromHex("A53C")),
+        QCanBusFrame(MotorolaMsgId, QByteArray()),
+    };
+
+    const QHash<quint32, DbcMessageColumns> columnsById = decode(frames);
+
+    const DbcMessageColumns &intelColumns = columnsById.value(IntelMsgId);
+    QCOMPARE(intelColumns.getRowsNb(), 1);
+    QCOMPARE(getValue(intelColumns, "Cross"), 970.0);
+    QVERIFY(qIsNaN(getValue(intelColumns, "Temp")));
+
+    const DbcMessageColumns &motorolaColumns = columnsById.value(MotorolaMsgId);
+    QCOMPARE(motorolaColumns.getRowsNb(), 1);
+    QVERIFY(qIsNaN(getValue(motorolaColumns, "Cross")));
+    QVERIFY(qIsNaN(getValue(motorolaColumns, "Speed")));
+}
+
+void DbcTest::test_exactvalues()
+{
+    QCanBusFrame extendedFrame(ExtendedMsgId, QByteArray::fromHex("2A00000000000000"));
+    extendedFrame.setExtendedFrameFormat(true);
+
+    const QVector<QCanBusFrame> frames = {
+        QCanBusFrame(IntelMsgId, QByteArray::fromHex("A53CFDFF00000000")),
+        QCanBusFrame(MotorolaMsgId, QByteArray::fromHex("A53CFF3800000000")),
+        QCanBusFrame(MuxMsgId, QByteArray::fromHex("01D2040000000000")),
+        extendedFrame,
+    };
+
+    // The exact values aren't computed if not asked
+    const QHash<quint32, DbcMessageColumns> doubleColumnsById = decode(frames);
+    const DbcMessageColumns &doubleColumns = doubleColumnsById.value(IntelMsgId);
+    QVERIFY(doubleColumns.getExactValues(doubleColumns.getSignalIdx("Temp")).isEmpty());
+
+    const QHash<quint32, DbcMessageColumns> columnsById = decode(frames, true);
+    QCOMPARE(columnsById.count(), 4);
+
+    // The decimal scaling has no floating point rounding: -3 * 0.1 - 40 is exactly -40.3
+    const DbcMessageColumns &intelColumns = columnsById.value(IntelMsgId);
+    const QVector<Number> &temps = intelColumns.getExactValues(intelColumns.getSignalIdx("Temp"));
+    QCOMPARE(temps.length(), 1);
+    QVERIFY(temps.first() == Number(403, 1, false));
+
+    const QVector<Number> &crosses =
+        intelColumns.getExactValues(intelColumns.getSignalIdx("Cross"));
+    QVERIFY(crosses.first() == Number::fromUInt64(970));
+
+    const DbcMessageColumns &motorolaColumns = columnsById.value(MotorolaMsgId);
+    const QVector<Number> &speeds =
+        motorolaColumns.getExactValues(motorolaColumns.getSignalIdx("Speed"));
+    QVERIFY(speeds.first() == Number::fromInt64(-90));
+
+    // The absent multiplexed signals have an invalid exact value
+    const DbcMessageColumns &muxColumns = columnsById.value(MuxMsgId);
+    QVERIFY(muxColumns.getExactValues(muxColumns.getSignalIdx("ValueA")).first() ==
+            Number(1234, 2, true));
+    QVERIFY(!muxColumns.getExactValues(muxColumns.getSignalIdx("ValueB")).first().isValid());
+
+    const DbcMessageColumns &extendedColumns =
+        columnsById.value(DbcDatabase::getMessageKey(ExtendedMsgId, true));
+    QVERIFY(extendedColumns.getExactValues(0).first() == Number::fromUInt64(42));
+}
+
+void DbcTest::test_sameid()
+{
+    // A standard and an extended messages with the same id value, but different layouts
+    DbcDatabase database;
+    QVERIFY(DbcDatabase::parse(QStringLiteral(
+                                   "BO_ 100 StdMsg: 8 Ecu\n"
+                                   " SG_ Low : 0|8@1+ (1,0) [0|255] \"\" Ecu\n"
+                                   "\n"
+                                   "BO_ 2147483748 ExtMsg: 8 Ecu\n"
+                                   " SG_ High : 8|8@1+ (2,0) [0|510] \"\" Ecu\n"),
+                               database));
+    QCOMPARE(database.getMessages().count(), 2);
+    QCOMPARE(database.getMessage(100)->getName(), QStringLiteral("StdMsg"));
+    QCOMPARE(database.getMessage(100, true)->getName(), QStringLiteral("ExtMsg"));
+
+    QCanBusFrame extendedFrame(100, QByteArray::fromHex("0A14"));
+    extendedFrame.setExtendedFrameFormat(true);
+
+    const DbcBatchDecoder decoder(database);
+    QHash<quint32, DbcMessageColumns> columnsById;
+    QCOMPARE(decoder.decode({ QCanBusFrame(100, QByteArray::fromHex("0A14")), extendedFrame },
+                            columnsById),
+             2);
+    QCOMPARE(columnsById.count(), 2);
+
+    const DbcMessageColumns &stdColumns = columnsById.value(DbcDatabase::getMessageKey(100, false));
+    QCOMPARE(stdColumns.getRowsNb(), 1);
+    QCOMPARE(getValue(stdColumns, "Low"), 10.0);
+
+    const DbcMessageColumns &extColumns = columnsById.value(DbcDatabase::getMessageKey(100, true));
+    QCOMPARE(extColumns.getRowsNb(), 1);
+    QCOMPARE(getValue(extColumns, "High"), 40.0);
+}
+
+void DbcTest::test_malformed_data()
+{
+    QTest::addColumn<QString>("content");
+
+    QTest::newRow("message id not a number")
+        << QStringLiteral("BO_ abc Msg: 8 Ecu\n");
+    QTest::newRow("message without colon")
+        << QStringLiteral("BO_ 100 Msg 8 Ecu\n");
+    QTest::newRow("message without length")
+        << QStringLiteral("BO_ 100 Msg: Ecu\n");
+    QTest::newRow("signal without message")
+        << QStringLiteral(" SG_ Sig : 0|8@1+ (1,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("signal wrong byte order")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n SG_ Sig : 0|8@2+ (1,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("signal without scaling")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n SG_ Sig : 0|8@1+ [0|255] \"\" Ecu\n");
+    QTest::newRow("signal wrong factor")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n SG_ Sig : 0|8@1+ (a,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("signal null length")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n SG_ Sig : 0|0@1+ (1,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("signal too long")
+        << QStringLiteral("BO_ 100 Msg: 64 Ecu\n SG_ Sig : 0|65@1+ (1,0) [0|1] \"\" Ecu\n");
+    QTest::newRow("signal out of the message length")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n SG_ Sig : 60|8@1+ (1,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("Intel signal out of the max payload")
+        << QStringLiteral("BO_ 100 Msg: 64 Ecu\n SG_ Sig : 508|8@1+ (1,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("Motorola signal out of the max payload")
+        << QStringLiteral("BO_ 100 Msg: 64 Ecu\n SG_ Sig : 505|8@0+ (1,0) [0|255] \"\" Ecu\n");
+    QTest::newRow("start bit out of the max payload")
+        << QStringLiteral("BO_ 100 Msg: 64 Ecu\n SG_ Sig : 512|1@1+ (1,0) [0|1] \"\" Ecu\n");
+    QTest::newRow("message described twice")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n\nBO_ 100 OtherMsg: 8 Ecu\n");
+    QTest::newRow("two multiplexors")
+        << QStringLiteral("BO_ 100 Msg: 8 Ecu\n"
+                          " SG_ Mux1 M : 0|8@1+ (1,0) [0|255] \"\" Ecu\n"
+                          " SG_ Mux2 M : 8|8@1+ (1,0) [0|255] \"\" Ecu\n");
+}
+
+void DbcTest::test_malformed()
+{
+    QFETCH(QString, content);
+
+    DbcDatabase database;
+    QVERIFY(DbcDatabase::parse(QStringLiteral("BO_ 1 Previous: 8 Ecu\n"), database));
+    QVERIFY(!database.isEmpty());
+
+    QVERIFY(!DbcDatabase::parse(content, database));
+
+    // The database isn't modified when the parsing fails
+    QVERIFY(database.getMessage(1) != nullptr);
+    QVERIFY(database.getMessage(100) == nullptr);
+}
+
+QHash<quint32, DbcMessageColumns> DbcTest::decode(const QVector<QCanBusFrame> &frames,
+                                                  bool exactValuesEnabled) const
+{
+    const DbcBatchDecoder decoder(_database, exactValuesEnabled);
+    QHash<quint32, DbcMessageColumns> columnsById;
+
+    const int decodedNb = decoder.decode(frames, columnsById);
+    if(decodedNb != frames.length())
+    {
+        qWarning() << "Only: " << decodedNb << " frames have been decoded, instead of: "
+                   << frames.length();
+    }
+
+    return columnsById;
+}
+
+double DbcTest::getValue(const DbcMessageColumns &columns,
+                         const QString &signalName,
+                         int rowIdx)
+{
+    const QVector<double> &values = columns.getValues(columns.getSignalIdx(signalName));
+
+    if(rowIdx < 0 || rowIdx >= values.length())
+    {
+        return qQNaN();
+    }
+
+    return values.at(rowIdx);
+}
+
+QTEST_GUILESS_MAIN(DbcTest)
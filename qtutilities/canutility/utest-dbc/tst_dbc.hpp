@@ -0,0 +1,57 @@
+// SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+//
+// SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+#pragma once
+
+#include <QObject>
+
+#include <QHash>
+
+#include "dbc/dbcdatabase.hpp"
+#include "dbc/dbcmessagecolumns.hpp"
+
+class QCanBusFrame;
+
+
+/** @brief Tests the DBC parsing and the decoding of the frames with the compiled signals */
+class DbcTest : public QObject
+{
+    Q_OBJECT
+
+    public:
+        DbcTest();
+        ~DbcTest();
+
+    private slots:
+        void initTestCase();
+        void test_parse();
+        void test_intel();
+        void test_motorola();
+        void test_multiplexed();
+        void test_shortpayload();
+        void test_exactvalues();
+        void test_sameid();
+        void test_malformed_data();
+        void test_malformed();
+
+    private:
+        /** @brief Decode frames with the test database
+            @param frames The frames to decode
+            @param exactValuesEnabled True to also compute the exact physical values
+            @return The columns of the decoded messages, indexed by message key */
+        QHash<quint32, DbcMessageColumns> decode(const QVector<QCanBusFrame> &frames,
+                                                 bool exactValuesEnabled = false) const;
+
+        /** @brief Get the physical value of a signal in decoded columns
+            @param columns The decoded columns of the message
+            @param signalName The signal name
+            @param rowIdx The row of the value
+            @return The value, NaN if it's not found */
+        static double getValue(const DbcMessageColumns &columns,
+                               const QString &signalName,
+                               int rowIdx = 0);
+
+    private:
+        DbcDatabase _database;
+};
@@ -0,0 +1,39 @@
+# SPDX-FileCopyrightText: 2024 Benoit Rolandeau <benoit.rolandeau@allcircuits.com>
+#
+# SPDX-License-Identifier: LicenseRef-ALLCircuits-ACT-1.1
+
+QT += testlib
+QT += serialbus
+QT -= gui
+
+CONFIG += qt console warn_on depend_includepath testcase
+CONFIG -= app_bundle
+
+CONFIG *= c++17
+
+TEMPLATE = app
+
+ROOT = $$absolute_path(../../..)
+QT_UTILITIES = $$absolute_path($$ROOT/qtutilities)
+TEST_ROOT = $$absolute_path(.)
+
+include($$ROOT/import-build-params.pri)
+
+DESTDIR = $$DESTDIR_LIBS
+
+INCLUDEPATH *= $$ROOT
+INCLUDEPATH *= $$QT_UTILITIES
+INCLUDEPATH *= $$TEST_ROOT
+
+HEADERS *=  tst_dbc.hpp
+SOURCES *=  tst_dbc.cpp
+
+include($$QT_UTILITIES/definesutility/definesutility.pri)
+include($$QT_UTILITIES/byteutility/byteutility.pri)
+include($$QT_UTILITIES/numberutility/numberutility.pri)
+include($$QT_UTILITIES/canutility/canutility.pri)
+
+unix {
+    target.path = /opt/utest
+    INSTALLS += target
+}
@@ -45,4 +45,16 @@ namespace CrcConstants
     {
         constexpr const quint16 defaultInit = 0xFFFF;
     }
+
+    namespace Crc16Xmodem
+    {
+        /** @brief Init value for CRC16 XMODEM */
+        constexpr const quint16 defaultInit = 0x0000;
+
+        /** @brief CRC16 XMODEM polynom (CCITT) */
+        constexpr const quint16 polynom = 0x1021;
+
+        /** @brief Size of the CRC16 XMODEM table */
+        constexpr const int tableSize = 256;
+    }
 }
@@ -9,6 +9,8 @@
 
 #include "crchelper.hpp"
 
+#include <QMutexLocker>
+
 #include <endianesshelper.hpp>
 
 
@@ -48,9 +50,30 @@ quint16 CrcHelper::calculateCrcMcrf4xx(const QByteArray &data, quint16 init)
     return crc;
 }
 
+quint16 CrcHelper::calculateCrc16Xmodem(const QByteArray &data, quint16 init)
+{
+    // The table is only created once, the static initialization is threadsafe
+    static const QVector<quint16> crc16XmodemTable = createCrc16XmodemTable();
+    const quint16 *table = crc16XmodemTable.constData();
+
+    quint16 crc = init;
+
+    for(int idx = 0; idx < data.length(); idx++)
+    {
+        const quint8 tableIndex = static_cast<quint8>((crc >> 8) ^
+                                                      static_cast<quint8>(data.at(idx)));
+
+        crc = static_cast<quint16>((crc << 8) ^ table[tableIndex]);
+    }
+
+    return crc;
+}
+
 quint32 CrcHelper::calculateCrc32(const QByteArray &data, quint32 polynom, quint32 init)
 {
-    getInstance().createCrc32Table(polynom);
+    // The table is implicitly shared, the copy is cheap
+    const QVector<quint32> crc32Table = getInstance().getCrc32Table(polynom);
+    const quint32 *table = crc32Table.constData();
 
     quint32 crc = init;
 
@@ -58,21 +81,31 @@ quint32 CrcHelper::calculateCrc32(const QByteArray &data, quint32 polynom, quint
     {
         quint8 tableIndex = ((static_cast<quint8>(data.at(idx)) ^ crc) & 0xFF);
 
-        crc = (crc >> 8) ^ getInstance()._crc32Table[tableIndex];
+        crc = (crc >> 8) ^ table[tableIndex];
     }
 
     return ~crc;
 }
 
-void CrcHelper::createCrc32Table(quint32 polynom)
+QVector<quint32> CrcHelper::getCrc32Table(quint32 polynom)
 {
-    if(_crc32Table != nullptr)
+    QMutexLocker locker(&_crc32TablesMutex);
+
+    auto citer = _crc32Tables.constFind(polynom);
+    if(citer != _crc32Tables.cend())
     {
         // Table already created
-        return;
+        return citer.value();
     }
 
-    _crc32Table = new quint32[CrcConstants::Crc32::tableSize]();
+    const QVector<quint32> table = createCrc32Table(polynom);
+    _crc32Tables.insert(polynom, table);
+    return table;
+}
+
+QVector<quint32> CrcHelper::createCrc32Table(quint32 polynom)
+{
+    QVector<quint32> table(CrcConstants::Crc32::tableSize);
 
     quint32 element = 0;
 
@@ -93,6 +126,35 @@ void CrcHelper::createCrc32Table(quint32 polynom)
             }
         }
 
-        _crc32Table[idxTab] = element;
+        table[static_cast<int>(idxTab)] = element;
     }
+
+    return table;
+}
+
+QVector<quint16> CrcHelper::createCrc16XmodemTable()
+{
+    QVector<quint16> table(CrcConstants::Crc16Xmodem::tableSize);
+
+    for(int idxTab = 0; idxTab < CrcConstants::Crc16Xmodem::tableSize; idxTab++)
+    {
+        quint16 element = static_cast<quint16>(idxTab << 8);
+
+        for(int idxBit = 0; idxBit < 8; idxBit++)
+        {
+            if((element & 0x8000) == 0x8000)
+            {
+                element = static_cast<quint16>((element << 1) ^
+                                               CrcConstants::Crc16Xmodem::polynom);
+            }
+            else
+            {
+                element = static_cast<quint16>(element << 1);
+            }
+        }
+
+        table[idxTab] = element;
+    }
+
+    return table;
 }
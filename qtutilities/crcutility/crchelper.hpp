@@ -9,6 +9,10 @@
 
 #pragma once
 
+#include <QHash>
+#include <QMutex>
+#include <QVector>
+
 #include "crcutility/crcconstants.hpp"
 
 
@@ -26,6 +30,16 @@ class CrcHelper
         static quint16 calculateCrcMcrf4xx(const QByteArray &data,
                                            quint16 init = CrcConstants::Crc16Mcrf4xx::defaultInit);
 
+        /** @brief Calculate the 16bits CRC used by the XMODEM and YMODEM protocols (CRC-16/CCITT
+                   without final xor)
+            @note The CRC can be calculated in several parts: give the CRC of the previous parts
+                  as init value
+            @param data Calculate the CRC from those data
+            @param init The init value of the CRC
+            @return The CRC calculated */
+        static quint16 calculateCrc16Xmodem(const QByteArray &data,
+                                            quint16 init = CrcConstants::Crc16Xmodem::defaultInit);
+
         /** @brief Calculate the 32bits CRC
             @param data Calculate the CRC from those data
             @return The CRC calculated */
@@ -34,8 +48,20 @@ class CrcHelper
                                       quint32 init = CrcConstants::Crc32::defaultInit);
 
     private:
-        /** @brief Create Crc32 table if not already done */
-        void createCrc32Table(quint32 polynom);
+        /** @brief Get the Crc32 table of the polynom given, create it if not already done
+            @note The method is threadsafe
+            @param polynom The polynom of the table
+            @return The table */
+        QVector<quint32> getCrc32Table(quint32 polynom);
+
+        /** @brief Create the Crc32 table of the polynom given
+            @param polynom The polynom of the table
+            @return The table created */
+        static QVector<quint32> createCrc32Table(quint32 polynom);
+
+        /** @brief Create the CRC16 XMODEM table
+            @return The table created */
+        static QVector<quint16> createCrc16XmodemTable();
 
     private:
         /** @brief Get Class instance */
@@ -45,5 +71,6 @@ class CrcHelper
         static CrcHelper *_instance;
 
     private:
-        quint32 *_crc32Table = nullptr;
+        QMutex _crc32TablesMutex;
+        QHash<quint32, QVector<quint32>> _crc32Tables;
 };